@@ -75,14 +75,20 @@ IF (CFG_KERNEL_STACK_KERNEL_MODULE)
     SET(CFG_POWERLINK_EDRV "82573" CACHE STRING
         "Valid drivers are 8139, 82573, 8255x, Fec")
     SET_PROPERTY(CACHE CFG_POWERLINK_EDRV PROPERTY STRINGS 8139 82573 8255x Fec)
+    UNSET (CFG_POWERLINK_EDRV_SIM CACHE)
 
 ELSE (CFG_KERNEL_STACK_KERNEL_MODULE)
 
     UNSET (CFG_KERNEL_DIR CACHE)
     UNSET (CFG_POWERLINK_EDRV CACHE)
+    OPTION (CFG_POWERLINK_EDRV_SIM
+            "Use simulated Ethernet driver instead of pcap (device name selects the simulated segment)" OFF)
 
 ENDIF (CFG_KERNEL_STACK_KERNEL_MODULE)
 
+OPTION (CFG_TRACE_RING
+        "Record debug traces in per-thread binary rings instead of printing them synchronously" OFF)
+
 # setup libraries and daemons to compile
 IF (CFG_KERNEL_STACK_DIRECTLINK)
 
@@ -0,0 +1,106 @@
+/**
+********************************************************************************
+\file   EdrvPcapFilter.h
+
+\brief  Interface of the receive filter of the pcap Ethernet driver
+
+The pcap Ethernet driver translates the Rx filter entries of the DLL and the
+multicast entries into a pcap filter expression. The expression is compiled
+into a BPF program and installed in the kernel, so that frames which are not
+needed by the DLL are dropped before they are copied to the application.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, SYSTEC electronic GmbH
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_EdrvPcapFilter_H_
+#define _INC_EdrvPcapFilter_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <edrv.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef EDRVPCAP_MAX_FILTERS
+#define EDRVPCAP_MAX_FILTERS        64          ///< Maximum number of Rx filter entries
+#endif
+
+#ifndef EDRVPCAP_MAX_MULTICAST
+#define EDRVPCAP_MAX_MULTICAST      16          ///< Maximum number of multicast MAC entries
+#endif
+
+/// Size of a buffer which is able to hold the expression of any filter set
+#define EDRVPCAP_FILTER_EXPR_SIZE   (256 + (EDRVPCAP_MAX_FILTERS * 300) + \
+                                     (EDRVPCAP_MAX_MULTICAST * 40))
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  Receive filter set of the pcap Ethernet driver
+
+The structure contains all information which determines the frames passed
+to the DLL. The filter entries are a copy of the entries set by the DLL
+with EdrvChangeFilter(), the multicast entries are set with
+EdrvDefineRxMacAddrEntry().
+*/
+typedef struct
+{
+    BYTE            abMyMacAddr[6];                             ///< Own MAC address
+    tEdrvFilter     aFilter[EDRVPCAP_MAX_FILTERS];              ///< Rx filter entries of the DLL
+    UINT            filterCount;                                ///< Number of valid Rx filter entries
+    BOOL            fFilterOverflow;                            ///< The DLL set more filter entries than supported
+    BYTE            aabMulticastMac[EDRVPCAP_MAX_MULTICAST][6]; ///< Multicast MAC entries
+    UINT            multicastCount;                             ///< Number of valid multicast MAC entries
+} tEdrvPcapFilterSet;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+tEplKernel EdrvPcapSetFilterEntries(tEdrvPcapFilterSet* pFilterSet_p,
+                                    tEdrvFilter* pFilter_p, UINT count_p);
+tEplKernel EdrvPcapAddMulticast(tEdrvPcapFilterSet* pFilterSet_p, BYTE* pbMacAddr_p);
+tEplKernel EdrvPcapRemoveMulticast(tEdrvPcapFilterSet* pFilterSet_p, BYTE* pbMacAddr_p);
+tEplKernel EdrvPcapBuildFilterExpr(tEdrvPcapFilterSet* pFilterSet_p,
+                                   char* pszExpr_p, size_t size_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_EdrvPcapFilter_H_ */
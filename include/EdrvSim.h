@@ -1,3 +1,23 @@
+/**
+********************************************************************************
+\file   EdrvSim.h
+
+\brief  Interface of the simulated Ethernet driver
+
+The simulated Ethernet driver (edrv-sim) implements the Edrv interface on top
+of an in-memory Ethernet segment. A segment is a POSIX shared memory object
+which contains one receive queue per attached port. Every frame sent by a port
+is copied into the receive queues of all other ports of the segment, therefore
+one MN and several CN stack instances running in different processes on the
+same host are able to communicate with each other.
+
+Besides the Edrv interface used by the stack, the driver offers additional
+ports which can be attached to a segment by the application. These ports are
+intended to implement lightweight responders (e.g. simulated CNs) within the
+same process as a stack instance.
+
+*******************************************************************************/
+
 /****************************************************************************
 
   (c) SYSTEC electronic GmbH, D-07973 Greiz, August-Bebel-Str. 29
@@ -68,27 +88,91 @@
 
 ****************************************************************************/
 
-#ifndef _EDRVSIM_H_
-#define _EDRVSIM_H_
+#ifndef _INC_EdrvSim_H_
+#define _INC_EdrvSim_H_
 
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <edrv.h>
 
-//---------------------------------------------------------------------------
+//------------------------------------------------------------------------------
 // const defines
-//---------------------------------------------------------------------------
-
-//---------------------------------------------------------------------------
-// types
-//---------------------------------------------------------------------------
-
-
-//---------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef EDRVSIM_MAX_PORTS
+#define EDRVSIM_MAX_PORTS           254         ///< Maximum number of ports of one segment
+#endif
+
+#ifndef EDRVSIM_RX_QUEUE_SIZE
+#define EDRVSIM_RX_QUEUE_SIZE       64          ///< Number of frames a receive queue is able to hold
+#endif
+
+#define EDRVSIM_MAX_FRAME_SIZE      0x600       ///< Maximum size of a frame on a simulated segment
+
+#define EDRVSIM_LOSS_PPM_MAX        1000000     ///< Loss rate at which every frame is lost
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/// Handle of a port attached to a simulated segment
+typedef struct sEdrvSimPort tEdrvSimPort;
+
+/**
+\brief  Receive handler of a simulated port
+
+The handler is called in the context of the worker thread of the port for
+every frame delivered to the port. The frame buffer is valid until the
+handler returns.
+*/
+typedef void (*tEdrvSimRxHandler)(tEdrvSimPort* pPort_p, void* pArg_p,
+                                  BYTE* pbFrame_p, UINT frameLen_p);
+
+/**
+\brief  Link parameters of a simulated segment
+
+The link parameters apply to every frame transmitted on the segment. The
+initial values are taken from the environment variables EDRVSIM_LATENCY_NS,
+EDRVSIM_LOSS_PPM and EDRVSIM_SEED when the segment is created.
+*/
+typedef struct
+{
+    UINT32              latencyNs;          ///< Delay between transmission and delivery of a frame
+    UINT32              lossPpm;            ///< Probability of a frame loss per receiver (parts per million)
+    UINT32              seed;               ///< Seed of the loss generator, 0 keeps the current state
+} tEdrvSimLinkParam;
+
+/// Statistics of a simulated port
+typedef struct
+{
+    ULONGLONG           txFrameCount;       ///< Number of frames transmitted by the port
+    ULONGLONG           rxFrameCount;       ///< Number of frames delivered to the port
+    ULONGLONG           lossCount;          ///< Number of frames for the port dropped by the loss generator
+    ULONGLONG           overflowCount;      ///< Number of frames for the port dropped due to a full receive queue
+} tEdrvSimStatistics;
+
+//------------------------------------------------------------------------------
 // function prototypes
-//---------------------------------------------------------------------------
-
-void EdrvRxInterruptHandler (BYTE bBufferInFrame_p, BYTE * pbEthernetData_p, WORD wDataLen_p);
+//------------------------------------------------------------------------------
 
+#ifdef __cplusplus
+extern "C" {
+#endif
 
+tEplKernel EdrvSimSetLinkParam(const char* pszSegment_p, const tEdrvSimLinkParam* pLinkParam_p);
+tEplKernel EdrvSimGetLinkParam(const char* pszSegment_p, tEdrvSimLinkParam* pLinkParam_p);
+tEplKernel EdrvSimAttachPort(const char* pszSegment_p, BYTE* pbMacAddr_p,
+                             tEdrvSimRxHandler pfnRxHandler_p, void* pArg_p,
+                             tEdrvSimPort** ppPort_p);
+tEplKernel EdrvSimDetachPort(tEdrvSimPort* pPort_p);
+tEplKernel EdrvSimSendFrame(tEdrvSimPort* pPort_p, BYTE* pbFrame_p, UINT frameLen_p);
+tEplKernel EdrvSimGetStatistics(tEdrvSimPort* pPort_p, tEdrvSimStatistics* pStatistics_p);
+tEdrvSimPort* EdrvSimGetEdrvPort(void);
 
-#endif  // #ifndef _EDRVSIM_H_
+void EdrvRxInterruptHandler(BYTE bBufferInFrame_p, BYTE* pbEthernetData_p, WORD wDataLen_p);
 
+#ifdef __cplusplus
+}
+#endif
 
+#endif /* _INC_EdrvSim_H_ */
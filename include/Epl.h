@@ -85,6 +85,13 @@
 // const defines
 //---------------------------------------------------------------------------
 
+// size of a node bitmap in bytes (one bit per node ID 0 - 255)
+#define EPL_API_NODE_BITMAP_SIZE        ((EPL_C_ADR_BROADCAST + 1) / 8)
+
+#define EPL_API_NODE_BITMAP_SET(pBitmap_p, nodeId_p) \
+            ((pBitmap_p)[(nodeId_p) >> 3] |= (BYTE)(1 << ((nodeId_p) & 7)))
+#define EPL_API_NODE_BITMAP_TEST(pBitmap_p, nodeId_p) \
+            (((pBitmap_p)[(nodeId_p) >> 3] & (1 << ((nodeId_p) & 7))) != 0)
 
 //---------------------------------------------------------------------------
 // typedef
@@ -153,6 +160,8 @@ typedef enum
     kEplApiEventNode           = 0x20,    // m_Node
     kEplApiEventBoot           = 0x21,    // m_Boot
     kEplApiEventSdo            = 0x62,    // m_Sdo
+    kEplApiEventSdoBatchItem   = 0x63,    // m_pSdoBatchItem
+    kEplApiEventSdoBatch       = 0x64,    // m_pSdoBatch
     kEplApiEventObdAccess      = 0x69,    // m_ObdCbParam
     kEplApiEventLed            = 0x70,    // m_Led
     kEplApiEventCfmProgress    = 0x71,    // m_CfmProgress
@@ -167,6 +176,8 @@ typedef union
     tEventNmtStateChange    m_NmtStateChange;
     tEplEventError          m_InternalError;
     tSdoComFinished         m_Sdo;
+    tSdoBatchItem*          m_pSdoBatchItem;
+    tSdoBatch*              m_pSdoBatch;
     tObdCbParam             m_ObdCbParam;
     tEplApiEventNode        m_Node;
     tEplApiEventBoot        m_Boot;
@@ -258,6 +269,9 @@ typedef struct
     unsigned int        m_uiSyncNodeId;     // after PRes from CN with this node-ID (0 = SoC, 255 = SoA)
     BOOL                m_fSyncOnPrcNode;   // TRUE: CN is PRes chained; FALSE: conventional CN (PReq/PRes)
 
+    // CPU affinity and scheduling of the stack threads (Linux userspace only)
+    tEplThreadConfig    m_ThreadConfig;
+
 } tEplApiInitParam;
 
 
@@ -329,6 +343,8 @@ EPLDLLEXPORT tEplKernel oplk_readObject(tSdoComConHdl* pSdoComConHdl_p, UINT  no
 EPLDLLEXPORT tEplKernel oplk_writeObject(tSdoComConHdl* pSdoComConHdl_p, UINT nodeId_p, UINT index_p,
                                          UINT subindex_p, void* pSrcData_le_p, UINT size_p,
                                          tSdoType sdoType_p, void* pUserArg_p);
+EPLDLLEXPORT tEplKernel oplk_startSdoBatch(tSdoBatch* pSdoBatch_p);
+EPLDLLEXPORT tEplKernel oplk_abortSdoBatch(tSdoBatch* pSdoBatch_p);
 EPLDLLEXPORT tEplKernel oplk_freeSdoChannel(tSdoComConHdl sdoComConHdl_p);
 EPLDLLEXPORT tEplKernel oplk_abortSdo(tSdoComConHdl sdoComConHdl_p, UINT32 abortCode_p);
 EPLDLLEXPORT tEplKernel oplk_readLocalObject(UINT index_p, UINT subindex_p, void* pDstData_p, UINT* pSize_p);
@@ -339,10 +355,16 @@ EPLDLLEXPORT tEplKernel oplk_postUserEvent(void* pUserArg_p);
 EPLDLLEXPORT tEplKernel oplk_triggerMnStateChange(UINT nodeId_p, tNmtNodeCommand nodeCommand_p);
 EPLDLLEXPORT tEplKernel oplk_setCdcBuffer(BYTE* pbCdc_p, UINT cdcSize_p);
 EPLDLLEXPORT tEplKernel oplk_setCdcFilename(char* pszCdcFilename_p);
+EPLDLLEXPORT tEplKernel oplk_setOdStorePath(char* pszStorePath_p);
 EPLDLLEXPORT tEplKernel oplk_process(void);
 EPLDLLEXPORT tEplKernel oplk_getIdentResponse(UINT nodeId_p, tEplIdentResponse** ppIdentResponse_p);
+EPLDLLEXPORT tEplKernel oplk_getBootTimeline(tNmtBootTimeline* pTimeline_p);
+EPLDLLEXPORT tEplKernel oplk_writeBootTimelineCsv(char* pszFileName_p);
 EPLDLLEXPORT BOOL       oplk_checkKernelStack(void);
 EPLDLLEXPORT tEplKernel oplk_waitSyncEvent(ULONG timeout_p);
+EPLDLLEXPORT tEplKernel oplk_getMissedSyncCount(UINT32* pCount_p);
+EPLDLLEXPORT tEplKernel oplk_setErrHistoryCoalesceWindow(UINT32 cycles_p);
+EPLDLLEXPORT tEplKernel oplk_getErrHistoryStats(UINT32* pPostedCnt_p, UINT32* pSuppressedCnt_p);
 
 // Process image API functions
 EPLDLLEXPORT tEplKernel oplk_allocProcessImage(UINT sizeProcessImageIn_p, UINT sizeProcessImageOut_p);
@@ -351,6 +373,9 @@ EPLDLLEXPORT tEplKernel oplk_linkProcessImageObject(UINT objIndex_p, UINT firstS
                                                     BOOL fOutputPI_p, tObdSize entrySize_p, UINT* pVarEntries_p);
 EPLDLLEXPORT tEplKernel oplk_exchangeProcessImageIn(void);
 EPLDLLEXPORT tEplKernel oplk_exchangeProcessImageOut(void);
+EPLDLLEXPORT tEplKernel oplk_exchangeProcessImageOutChanged(BYTE* pChangedNodes_p);
+EPLDLLEXPORT tEplKernel oplk_exchangeProcessImageInNodes(BYTE* pNodes_p);
+EPLDLLEXPORT tEplKernel oplk_exchangeProcessImageOutNodes(BYTE* pNodes_p);
 EPLDLLEXPORT void*      oplk_getProcessImageIn(void);
 EPLDLLEXPORT void*      oplk_getProcessImageOut(void);
 
@@ -376,6 +401,7 @@ EPLDLLEXPORT tEplKernel target_cleanup(void);
 EPLDLLEXPORT void target_msleep(UINT32 milliSeconds_p);
 EPLDLLEXPORT tEplKernel target_setIpAdrs(char* ifName_p, UINT32 ipAddress_p, UINT32 subnetMask_p, UINT16 mtu_p);
 EPLDLLEXPORT tEplKernel target_setDefaultGateway(UINT32 defaultGateway_p);
+EPLDLLEXPORT void target_setThreadConfig(tEplThreadConfig* pThreadConfig_p);
 
 #ifdef __cplusplus
     }
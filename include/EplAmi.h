@@ -375,6 +375,52 @@ void PUBLIC AmiSetTimeOfDay (void FAR* pAddr_p, tTimeOfDay FAR* pTimeOfDay_p);
 
 void PUBLIC AmiGetTimeOfDay (void FAR* pAddr_p, tTimeOfDay FAR* pTimeOfDay_p);
 
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiSetXXXArrayToBe() / AmiSetXXXArrayToLe()
+//
+// Description: writes an array of values to a buffer in big endian or
+//              little endian
+//
+// Parameters:  pAddr_p         = pointer to destination buffer
+//              pxXXXVal_p      = pointer to array of values
+//              uiCount_p       = number of values
+//
+// Return:      void
+//
+//---------------------------------------------------------------------------
+
+void PUBLIC AmiSetWordArrayToBe  (void FAR* pAddr_p, const WORD FAR* pwWordVal_p, unsigned int uiCount_p);
+void PUBLIC AmiSetWordArrayToLe  (void FAR* pAddr_p, const WORD FAR* pwWordVal_p, unsigned int uiCount_p);
+void PUBLIC AmiSetDwordArrayToBe (void FAR* pAddr_p, const DWORD FAR* pdwDwordVal_p, unsigned int uiCount_p);
+void PUBLIC AmiSetDwordArrayToLe (void FAR* pAddr_p, const DWORD FAR* pdwDwordVal_p, unsigned int uiCount_p);
+void PUBLIC AmiSetQwordArrayToBe (void FAR* pAddr_p, const QWORD FAR* pqwQwordVal_p, unsigned int uiCount_p);
+void PUBLIC AmiSetQwordArrayToLe (void FAR* pAddr_p, const QWORD FAR* pqwQwordVal_p, unsigned int uiCount_p);
+
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiGetXXXArrayFromBe() / AmiGetXXXArrayFromLe()
+//
+// Description: reads an array of values from a buffer in big endian or
+//              little endian
+//
+// Parameters:  pxXXXVal_p      = pointer to destination array
+//              pAddr_p         = pointer to source buffer
+//              uiCount_p       = number of values
+//
+// Return:      void
+//
+//---------------------------------------------------------------------------
+
+void PUBLIC AmiGetWordArrayFromBe  (WORD FAR* pwWordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p);
+void PUBLIC AmiGetWordArrayFromLe  (WORD FAR* pwWordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p);
+void PUBLIC AmiGetDwordArrayFromBe (DWORD FAR* pdwDwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p);
+void PUBLIC AmiGetDwordArrayFromLe (DWORD FAR* pdwDwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p);
+void PUBLIC AmiGetQwordArrayFromBe (QWORD FAR* pqwQwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p);
+void PUBLIC AmiGetQwordArrayFromLe (QWORD FAR* pqwQwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p);
+
 #endif
 
 
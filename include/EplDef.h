@@ -241,6 +241,10 @@
 #define EPL_NMTMNU_PRC_NODE_ADD_MAX_NUM EPL_D_NMT_MaxCNNumber_U8
 #endif
 
+#ifndef EPL_NMTMNU_BOOT_TIMELINE
+#define EPL_NMTMNU_BOOT_TIMELINE        FALSE   // record timestamps of the MN boot process
+#endif
+
 // defines for EPL API layer static process image
 #ifndef EPL_API_PROCESS_IMAGE_SIZE_IN
 #define EPL_API_PROCESS_IMAGE_SIZE_IN   0
@@ -267,6 +271,14 @@
 #define CONFIG_OBD_USE_STORE_RESTORE           FALSE
 #endif
 
+#ifndef CONFIG_OBD_DEF_STORE_PATH
+#define CONFIG_OBD_DEF_STORE_PATH              "."
+#endif
+
+#ifndef CONFIG_OBD_USE_RESET_SNAPSHOT
+#define CONFIG_OBD_USE_RESET_SNAPSHOT          FALSE
+#endif
+
 #ifndef CONFIG_OBD_USE_LOAD_CONCISEDCF
 #define CONFIG_OBD_USE_LOAD_CONCISEDCF         FALSE
 #endif
@@ -325,6 +337,17 @@
 #define EDRV_AUTO_RESPONSE_DELAY            FALSE
 #endif
 
+// window in cycles in which repeated error history entries of the same error
+// code and node are coalesced into one event (0 = post every entry)
+#ifndef CONFIG_ERRHND_HISTORY_COALESCE_WINDOW
+#define CONFIG_ERRHND_HISTORY_COALESCE_WINDOW   1000
+#endif
+
+// number of error code/node pairs which can be coalesced at the same time
+#ifndef CONFIG_ERRHND_HISTORY_COALESCE_ENTRIES
+#define CONFIG_ERRHND_HISTORY_COALESCE_ENTRIES  16
+#endif
+
 
 // definitions for usage of circular buffer library
 
@@ -338,8 +361,6 @@
 #define CIRCBUF_DLLCAL_TXSYNC           6
 #define CIRCBUF_DLLCAL_CN_REQ_NMT       7
 #define CIRCBUF_DLLCAL_CN_REQ_GEN       8
-#define CIRCBUF_DLLCAL_CN_REQ_IDENT     9
-#define CIRCBUF_DLLCAL_CN_REQ_STATUS    10
 
 #ifndef EVENT_SIZE_CIRCBUF_KERNEL_TO_USER
 #define EVENT_SIZE_CIRCBUF_KERNEL_TO_USER   32768   // default: 32 kByte
@@ -365,14 +386,6 @@
 #define DLLCAL_SIZE_CIRCBUF_CN_REQ_GEN      2048
 #endif
 
-#ifndef DLLCAL_SIZE_CIRCBUF_REQ_IDENT
-#define DLLCAL_SIZE_CIRCBUF_REQ_IDENT       256
-#endif
-
-#ifndef DLLCAL_SIZE_CIRCBUF_REQ_STATUS
-#define DLLCAL_SIZE_CIRCBUF_REQ_STATUS      256
-#endif
-
 /*
 #define EPL_D_CFG_ConfigManager_BOOL        // Ability of a MN node to perform Configuration Manager functions BOOLEAN O - N -
 #define EPL_D_CFM_VerifyConf_BOOL           // Support of objects CFM_VerifyConfiguration_REC, CFM_ExpConfDateList_AU32, CFM_ExpConfTimeList_AU32 BOOLEAN O O N N
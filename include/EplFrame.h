@@ -103,6 +103,10 @@
 #define EPL_ERR_ENTRYTYPE_PROF_EPL      0x0002
 #define EPL_ERR_ENTRYTYPE_PROF_MASK     0x0FFF
 
+// offset of the occurrence count (UNSIGNED32) in the additional information
+// of history entries which are coalesced by the stack
+#define EPL_ERR_ADDINFO_OCCURRENCE_CNT  4
+
 // defines for EPL version / PDO version
 #define EPL_VERSION_SUB             0x0F  // sub version
 #define EPL_VERSION_MAIN            0xF0  // main version
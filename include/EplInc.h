@@ -172,6 +172,51 @@ typedef struct
 } tEplHwParam;
 
 
+// identifiers of the threads created by the stack
+typedef enum
+{
+    kEplThreadEdrvRx        = 0,    // Ethernet driver receive thread
+    kEplThreadEventKernel   = 1,    // kernel event thread
+    kEplThreadEventUser     = 2,    // user event thread
+    kEplThreadHrTimer       = 3,    // high-resolution timer thread(s)
+    kEplThreadTimerUser     = 4,    // user timer thread
+    kEplThreadVeth          = 5,    // virtual Ethernet receive thread
+    kEplThreadSyncUser      = 6,    // application sync thread
+    kEplThreadCount         = 7     // number of thread identifiers
+
+} tEplThreadId;
+
+
+// scheduling policy of a stack thread
+typedef enum
+{
+    kEplThreadPolicyDefault = 0,    // use the policy chosen by the module
+    kEplThreadPolicyOther   = 1,    // normal time-sharing scheduling
+    kEplThreadPolicyFifo    = 2,    // real-time first-in first-out scheduling
+    kEplThreadPolicyRr      = 3     // real-time round-robin scheduling
+
+} tEplThreadPolicy;
+
+
+// scheduling parameters of a stack thread
+// (all members 0 = keep the default of the module)
+typedef struct
+{
+    DWORD               m_dwCpuMask;    // CPUs the thread may run on (bit 0 = CPU 0)
+    tEplThreadPolicy    m_Policy;       // scheduling policy
+    unsigned int        m_uiPriority;   // real-time priority (FIFO and RR only)
+
+} tEplThreadParam;
+
+
+// scheduling parameters of all stack threads
+typedef struct
+{
+    tEplThreadParam     m_aThread[kEplThreadCount];
+
+} tEplThreadConfig;
+
+
 // user argument union
 typedef union
 {
@@ -201,6 +201,7 @@
         #include <stdlib.h>
         #include <stdio.h>
         #include <string.h>
+        #include <pthread.h>
     #else
 //        #include <linux/config.h>
         #include <linux/module.h>
@@ -285,6 +286,7 @@ DWORD PUBLIC EplTgtGetTickCountMs(void);
 void PUBLIC EplTgtEnableGlobalInterrupt(BYTE fEnable_p);
 
 unsigned long long PUBLIC EplTgtGetTimeStampNs(void);
+void PUBLIC EplTgtGetNetTime(tEplNetTime* pNetTime_p);
 
 // functions for ethernet driver
 tEplKernel PUBLIC TgtInitEthIsr(void);
@@ -300,6 +302,12 @@ void  PUBLIC EplTgtTimeStampCopy       (tEplTgtTimeStamp* pTimeStampDest_p,
 void  PUBLIC EplTgtTimeStampFree       (tEplTgtTimeStamp* pTimeStamp_p);
 tEplTgtTimeStamp* PUBLIC EplTgtTimeStampAlloc (void);
 
+#if (TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__)
+// function for applying the thread configuration
+int target_setThreadSchedParam(pthread_t thread_p, tEplThreadId threadId_p,
+                               int defaultPolicy_p, int defaultPriority_p);
+#endif
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
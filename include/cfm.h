@@ -66,6 +66,7 @@ typedef struct
     tEplKernel          error;                  ///< Error which occured
     UINT32              totalNumberOfBytes;     ///< Total number of bytes to transfer
     UINT32              bytesDownloaded;        ///< Number of already downloaded bytes
+    UINT32              entriesSkipped;         ///< Number of unchanged entries which were not downloaded
 } tCfmEventCnProgress;
 
 //------------------------------------------------------------------------------
@@ -164,6 +164,8 @@ struct _tEdrvTxBuffer
     BYTE*           m_pbBuffer;             // OUT: pointer to the buffer, set by ethernetdriver
     // ----------------------
     unsigned int    m_uiMaxBufferLen;       // IN/OUT: maximum length of the buffer
+    tEplTgtTimeStamp* m_pTgtTimeStamp;      // OUT: pointer to time stamp of transmission (valid in Tx handler,
+                                            //      NULL if not supported by the ethernetdriver)
 
 };
 
@@ -50,6 +50,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define ERRHND_SHB_ID   "shberrhnd"                     ///< ID for shared buffer implementation
 
+/**
+Macro returns the number of cycles a decaying threshold counter has to be
+decremented by, if it was valid at cycle count refCycleCnt_p and the current
+cycle count is cycleCnt_p. A reference cycle count in the future yields zero.
+*/
+#define ERRHND_GET_DECAY(cycleCnt_p, refCycleCnt_p) \
+    (((INT32)((UINT32)(cycleCnt_p) - (UINT32)(refCycleCnt_p)) > 0) ? \
+     ((UINT32)(cycleCnt_p) - (UINT32)(refCycleCnt_p)) : 0)
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -61,15 +70,46 @@ typedef struct
     UINT32              threshold;                  ///< Threshold, stored in subindex 3
 } tErrorObject;
 
+/**
+\brief  Decay state of a threshold counter
+
+The threshold counter of an error object which is decremented every cycle
+is not updated cyclically. Instead, it is stored as the value valid at cycle
+count refCycleCnt and the decrements are applied on demand, i.e. if an error
+occurs or the counter is read.
+*/
+typedef struct
+{
+    UINT32              refCycleCnt;                ///< Cycle count at which the stored threshold counter was valid
+    UINT32              fDecay;                     ///< Threshold counter is decremented each cycle after refCycleCnt
+} tErrorDecay;
+
+/**
+\brief  Coalescing state of error history entries
+
+Repeated history entries with the same error code and node ID are coalesced
+by the kernel error handler. The window is configured by the user layer, the
+statistics are written by the kernel layer.
+*/
+typedef struct
+{
+    UINT32              window;                     ///< Coalescing window in cycles (0 = disabled)
+    UINT32              postedCnt;                  ///< Number of posted history entry events
+    UINT32              suppressedCnt;              ///< Number of occurrences which were not posted as an own event
+} tErrHistoryCoalesce;
+
 typedef struct
 {
     tErrorObject        cnLossSoc;                                        // object 0x1C0B
     tErrorObject        cnLossPreq;                                       // object 0x1C0D
     tErrorObject        cnCrcErr;                                         // object 0x1C0F
+    tErrHistoryCoalesce historyCoalesce;                                  // coalescing of history entries
 #if (((EPL_MODULE_INTEGRATION) & (EPL_MODULE_NMT_MN)) != 0)
     tErrorObject        mnCrcErr;                                         // object 0x1C00
     tErrorObject        mnCycTimeExceed;                                  // object 0x1C02
     tErrorObject        aMnCnLossPres[NUM_DLL_MNCN_LOSSPRES_OBJS];        // objects 0x1C07,0x1C08,0x1C09
+    UINT32              mnCycleCnt;                                       // number of finished cycles (time base of decay)
+    tErrorDecay         aMnCnLossPresDecay[NUM_DLL_MNCN_LOSSPRES_OBJS];   // decay state of threshold counters 0x1C08
 #endif
 } tErrHndObjects;
 
@@ -51,11 +51,47 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 
+// NMT events generated by the DLL receive path (kNmtEventDllCeSoc .. kNmtEventDllCeSoa)
+#define DLLK_NMTEVENT_COUNT         4
+#define DLLK_NMTEVENT_SOC           (1 << (kNmtEventDllCeSoc - kNmtEventDllCeSoc))
+#define DLLK_NMTEVENT_PREQ          (1 << (kNmtEventDllCePreq - kNmtEventDllCeSoc))
+#define DLLK_NMTEVENT_PRES          (1 << (kNmtEventDllCePres - kNmtEventDllCeSoc))
+#define DLLK_NMTEVENT_SOA           (1 << (kNmtEventDllCeSoa - kNmtEventDllCeSoc))
+#define DLLK_NMTEVENT_NONE          0
+#define DLLK_NMTEVENT_ALL           (DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_PREQ | \
+                                     DLLK_NMTEVENT_PRES | DLLK_NMTEVENT_SOA)
+
+// bins of the PRes response time histogram, bin 0 counts response times below
+// 2^DLLK_RESPTIME_HIST_SHIFT ns, each further bin doubles the upper limit and
+// the last bin counts all remaining response times
+#ifndef DLLK_RESPTIME_HIST_BINS
+#define DLLK_RESPTIME_HIST_BINS     16
+#endif
+#define DLLK_RESPTIME_HIST_SHIFT    10
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
 typedef tEplKernel (* tEplDllkCbAsync) (tFrameInfo * pFrameInfo_p);
 
+// statistics of NMT events generated by the DLL receive path
+typedef struct
+{
+    UINT32              postedCount;                            // events posted to the NMT state machine
+    UINT32              aSuppressedCount[DLLK_NMTEVENT_COUNT];  // suppressed SoC, PReq, PRes and SoA events
+} tDllkNmtEventStatistics;
+
+// histogram of the time between the transmission of a PReq and the reception
+// of the corresponding PRes, minimum and maximum are valid if count != 0
+typedef struct
+{
+    UINT32              count;                                  // number of response times
+    UINT32              minNs;                                  // shortest response time
+    UINT32              maxNs;                                  // longest response time
+    UINT64              sumNs;                                  // sum of all response times
+    UINT32              aBin[DLLK_RESPTIME_HIST_BINS];          // log2 bins of response times
+} tDllkResponseTimeHist;
+
 typedef struct
 {
     UINT8               aLocalMac[6];
@@ -80,6 +116,9 @@ struct _tDllkNodeInfo
     UINT32                      presTimeoutNs;          // object 0x1F92: NMT_MNCNPResTimeout_AU32
     struct _tEdrvTxBuffer*      pPreqTxBuffer;
     struct _tDllkNodeInfo*      pNextNodeInfo;
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+    tDllkResponseTimeHist       responseTimeHist;       // PRes response times of this CN
+#endif
 #endif
 
 };
@@ -131,10 +170,17 @@ tEplKernel dllk_setAsndServiceIdFilter(tDllAsndServiceId ServiceId_p, tDllAsndFi
 void       dllk_regRpdoHandler(tDllkCbProcessRpdo pfnDllkCbProcessRpdo_p);
 void       dllk_regTpdoHandler(tDllkCbProcessTpdo pfnDllkCbProcessTpdo_p);
 tEplSyncCb dllk_regSyncHandler(tEplSyncCb pfnCbSync_p);
+void       dllk_setNmtEventMask(UINT nmtEventMask_p);
+void       dllk_getNmtEventStatistics(tDllkNmtEventStatistics* pStatistics_p);
 #if EPL_DLL_DISABLE_DEFERRED_RXFRAME_RELEASE == FALSE
 tEplKernel dllk_releaseRxFrame(tEplFrame* pFrame_p, UINT uiFrameSize_p);
 #endif
 
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+void       dllk_resetResponseTimeHist(tDllkResponseTimeHist* pHist_p);
+void       dllk_updateResponseTimeHist(tDllkResponseTimeHist* pHist_p, UINT32 responseTimeNs_p);
+#endif
+
 #if EPL_NMT_MAX_NODE_ID > 0
 tEplKernel dllk_configNode(tDllNodeInfo* pNodeInfo_p);
 tEplKernel dllk_addNode(tDllNodeOpParam* pNodeOpParam_p);
@@ -143,7 +189,10 @@ tEplKernel dllk_deleteNode(tDllNodeOpParam* pNodeOpParam_p);
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
 tEplKernel dllk_setFlag1OfNode(UINT nodeId_p, UINT8 soaFlag1_p);
-void       dllk_getCurrentCnNodeIdList(BYTE** ppbCnNodeIdList_p);
+void       dllk_getCurrentCnNodeIdList(BYTE** ppbCnNodeIdList_p, UINT* pGeneration_p);
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+tEplKernel dllk_getResponseTimeHist(UINT nodeId_p, tDllkResponseTimeHist* pHist_p);
+#endif
 
 #if EPL_DLL_PRES_CHAINING_MN != FALSE
 tEplKernel dllk_getCnMacAddress(UINT nodeId_p, UINT8* pCnMacAddress_p);
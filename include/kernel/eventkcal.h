@@ -72,7 +72,8 @@ tEplKernel eventkcal_rxHandler (tEplEvent *pEvent_p);
 
 /* functions used in eventkcal-linuxkernel.c */
 int        eventkcal_postEventFromUser (unsigned long arg);
-int        eventkcal_getEventForUser(unsigned long arg);
+int        eventkcal_waitEventForUser(void);
+BYTE*      eventkcal_getEventRingMem(size_t* pSize_p);
 
 #ifdef __cplusplus
 }
@@ -60,6 +60,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NMT_TYPE_MS                 0x0200  // MS type of NMT state
 #define NMT_TYPE_MASK               0x0300  // mask to select type of NMT state (i.e. CS or MS)
 
+#define NMT_BOOT_TIMELINE_NODE_COUNT    254         // number of nodes in the boot timeline
+#define NMT_BOOT_TIME_INVALID           0xFFFFFFFF  // boot phase or node event not reached
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -229,6 +232,51 @@ typedef enum
     kNmtBootEventError              = 0x05,     ///< boot process halted because of an error
 } tNmtBootEvent;
 
+/**
+* \brief MN boot phases
+*
+* This enumeration lists the phases of the MN boot process which are recorded
+* in the boot timeline.
+*/
+typedef enum
+{
+    kNmtBootPhasePreOp1             = 0x00,     ///< MN entered PreOperational1 and reset the CNs
+    kNmtBootPhaseBootStep1          = 0x01,     ///< MN started the network scan (IdentRequests)
+    kNmtBootPhaseBootStep2          = 0x02,     ///< MN entered PreOperational2 (EnableReadyToOp)
+    kNmtBootPhaseCheckCom           = 0x03,     ///< MN entered ReadyToOperate and checks the communication
+    kNmtBootPhaseStartNodes         = 0x04,     ///< MN entered Operational and starts the CNs
+    kNmtBootPhaseCount              = 0x05,     ///< number of boot phases
+} tNmtBootPhase;
+
+/**
+* \brief CN boot milestones
+*
+* This enumeration lists the milestones of a CN which are recorded in the boot
+* timeline.
+*/
+typedef enum
+{
+    kNmtBootNodeEventIdentResponse  = 0x00,     ///< first IdentResponse received
+    kNmtBootNodeEventConfigured     = 0x01,     ///< CN completed BootStep1 (configuration done)
+    kNmtBootNodeEventStatusResponse = 0x02,     ///< first StatusResponse received
+    kNmtBootNodeEventOperational    = 0x03,     ///< CN reached Operational
+    kNmtBootNodeEventCount          = 0x04,     ///< number of CN milestones
+} tNmtBootNodeEvent;
+
+/**
+* \brief MN boot timeline
+*
+* The structure contains the timestamps of the last MN boot process. All times
+* are in milliseconds relative to the entry of PreOperational1 of the MN. Phases
+* and milestones which were not reached are set to NMT_BOOT_TIME_INVALID.
+*/
+typedef struct
+{
+    UINT32      aPhaseTime[kNmtBootPhaseCount];     ///< Start times of the boot phases
+    UINT32      aaNodeTime[NMT_BOOT_TIMELINE_NODE_COUNT][kNmtBootNodeEventCount];
+                                                    ///< Milestone times of the CNs, index is node ID - 1
+} tNmtBootTimeline;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
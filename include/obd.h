@@ -414,6 +414,8 @@ typedef struct
 {
     tObdCommand         command;
     tObdPart            currentOdPart;
+    UINT                index;          ///< Index of the object to be stored/loaded
+    UINT                subIndex;       ///< Sub-index of the object to be stored/loaded
     void MEM*           pData;
     tObdSize            objSize;
 } tObdCbStoreParam;
@@ -63,11 +63,22 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define PLK_CMD_CTRL_GET_STATUS                 _IOR (PLK_IOC_MAGIC, 3, UINT16)
 #define PLK_CMD_CTRL_GET_HEARTBEAT              _IOR (PLK_IOC_MAGIC, 4, UINT16)
 #define PLK_CMD_POST_EVENT                      _IOW (PLK_IOC_MAGIC, 5, tEplEvent)
-#define PLK_CMD_GET_EVENT                       _IOR (PLK_IOC_MAGIC, 6, tEplEvent)
 #define PLK_CMD_DLLCAL_ASYNCSEND                _IO  (PLK_IOC_MAGIC, 7)
 #define PLK_CMD_ERRHND_WRITE                    _IOW (PLK_IOC_MAGIC, 8, tErrHndIoctl)
 #define PLK_CMD_ERRHND_READ                     _IOR (PLK_IOC_MAGIC, 9, tErrHndIoctl)
 #define PLK_CMD_PDO_SYNC                        _IO  (PLK_IOC_MAGIC, 10)
+#define PLK_CMD_WAIT_EVENT                      _IO  (PLK_IOC_MAGIC, 11)
+#define PLK_CMD_DLLCAL_ASYNCRING_SIGNAL         _IO  (PLK_IOC_MAGIC, 12)
+
+//------------------------------------------------------------------------------
+//  Memory regions for <mmap>
+//------------------------------------------------------------------------------
+#define PLK_MMAP_OFFSET_PDO                     0x00000000  ///< PDO memory
+#define PLK_MMAP_OFFSET_EVENT_RING              0x01000000  ///< Kernel to user event ring
+#define PLK_MMAP_OFFSET_ASYNC_RING              0x02000000  ///< Asynchronous TX frame ring
+
+#define PLK_EVENT_RING_SIZE                     0x10000     ///< Size of the event ring (64 kByte)
+#define PLK_ASYNC_RING_SIZE                     0x10000     ///< Size of the asynchronous TX frame ring (64 kByte)
 
 //------------------------------------------------------------------------------
 // typedef
@@ -85,6 +96,18 @@ typedef struct
     size_t                  size;
 } tIoctlBufInfo;
 
+/**
+\brief Header of an entry of the asynchronous TX frame ring
+
+Each entry of the asynchronous TX frame ring consists of this header followed
+by the frame.
+*/
+typedef struct
+{
+    UINT32                  queue;              ///< DLL CAL queue of the frame (tDllCalQueue)
+    UINT32                  reserved;
+} tAsyncRingEntryHdr;
+
 typedef struct
 {
     UINT32                  offset;
@@ -48,10 +48,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// default segment size of the command layer, it fits into the minimum IP MTU
+// (C_IP_MIN_MTU) and is used if the MTU of the peer is unknown
+#define SDO_DEFAULT_SEGMENT_SIZE    256
+
+// maximum segment size of the command layer, determines the size of the send
+// buffers and of the history of the sequence layer
 #ifndef SDO_MAX_SEGMENT_SIZE
-#define SDO_MAX_SEGMENT_SIZE        256
+#define SDO_MAX_SEGMENT_SIZE        SDO_DEFAULT_SEGMENT_SIZE
 #endif
 
+// size of the headers in front of a command layer segment within the MTU
+// (IP and UDP header, ASnd header, sequence and command layer header)
+#define SDO_SEGMENT_HEADER_SIZE     44
+
 // handle between Protocol Abstraction Layer and asynchronous SDO Sequence Layer
 #define SDO_UDP_HANDLE              0x8000
 #define SDO_ASND_HANDLE             0x4000
@@ -69,7 +79,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SEQ_NUM_MASK                0xFC
 
 // size for send buffer and history
-#define SDO_MAX_FRAME_SIZE          EPL_C_IP_MIN_MTU
+#define SDO_MAX_FRAME_SIZE          (SDO_MAX_SEGMENT_SIZE + SDO_SEGMENT_HEADER_SIZE)
 // size for receive frame
 // -> needed because SND-Kit sends up to 1518 Byte
 //    without Sdo-Command: Maximum Segment Size
@@ -230,6 +240,50 @@ typedef struct
     void*               pUserArg;               ///< User definable argument pointer
 } tSdoComTransParamByIndex;
 
+typedef struct sSdoBatch tSdoBatch;
+typedef struct sSdoBatchItem tSdoBatchItem;
+
+/**
+\brief Structure for a single object access of an SDO batch
+
+This structure describes one Read or Write by Index access of an SDO batch.
+The members marked as result are written by the stack when the access is
+finished. The remaining members must not be changed while the batch is active.
+*/
+struct sSdoBatchItem
+{
+    UINT                nodeId;                 ///< Node ID of the target, 0 addresses the local OD
+    UINT                index;                  ///< Index to read/write
+    UINT                subindex;               ///< Sub-index to read/write
+    void*               pData;                  ///< Pointer to the data in little endian byte order
+    UINT                size;                   ///< Size of the buffer (read) or of the data (write), result: number of bytes transferred
+    tSdoAccessType      sdoAccessType;          ///< The SDO access type (Read or Write) of the item
+    tEplKernel          ret;                    ///< Result: error which prevented the transfer
+    tSdoComConState     sdoComConState;         ///< Result: state of the finished transfer
+    UINT32              abortCode;              ///< Result: SDO abort code
+    tSdoBatchItem*      pNext;                  ///< Internal: next item in the queue of the node
+    tSdoBatch*          pBatch;                 ///< Internal: batch the item belongs to
+};
+
+/**
+\brief Structure for an SDO batch
+
+This structure describes a list of object accesses which are queued per node
+and transferred back-to-back over one SDO connection per node. The batch and
+its items must remain valid until the batch is finished.
+*/
+struct sSdoBatch
+{
+    tSdoBatchItem*      pItems;                 ///< Pointer to the array of items
+    UINT                itemCount;              ///< Number of items in the array
+    tSdoType            sdoType;                ///< The type of the SDO transfers (SDO over ASnd, UDP or PDO)
+    BOOL                fItemEvents;            ///< Report every finished remote item, not only the finished batch
+    void*               pUserArg;               ///< User definable argument pointer
+    UINT                finishedCount;          ///< Result: number of finished items
+    UINT                errorCount;             ///< Result: number of failed items
+    BOOL                fActive;                ///< Internal: batch is being processed
+};
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
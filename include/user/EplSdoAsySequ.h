@@ -114,6 +114,9 @@ tEplKernel PUBLIC EplSdoAsySeqDelCon(tSdoSeqConHdl SdoSeqConHdl_p);
 
 tEplKernel PUBLIC EplSdoAsySeqSetTimeout( DWORD Timeout_p );
 
+tEplKernel PUBLIC EplSdoAsySeqGetProtType(tSdoSeqConHdl SdoSeqConHdl_p,
+                                    tSdoType* pSdoType_p);
+
 
 
 
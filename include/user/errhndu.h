@@ -69,6 +69,10 @@ tEplKernel errhndu_exit(void);
 tEplKernel errhndu_cbObdAccess(tObdCbParam MEM* pParam_p);
 tEplKernel errhndu_mnCnLossPresCbObdAccess(tObdCbParam MEM* pParam_p);
 
+// coalescing of error history entries
+tEplKernel errhndu_setHistoryCoalesceWindow(UINT32 window_p);
+tEplKernel errhndu_getHistoryCoalesceStats(UINT32* pPostedCnt_p, UINT32* pSuppressedCnt_p);
+
 #ifdef __cplusplus
 }
 #endif
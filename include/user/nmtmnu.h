@@ -86,11 +86,18 @@ tEplKernel nmtmnu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p);
 tEplKernel nmtmnu_cbCheckEvent(tNmtEvent NmtEvent_p);
 tEplKernel nmtmnu_getDiagnosticInfo(UINT* pMandatorySlaveCount_p, UINT* pSignalSlaveCount_p,
                                     UINT16* pflags_p);
+tEplKernel nmtmnu_updateNodeAssignment(UINT nodeId_p, UINT32 nodeCfg_p);
 
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
 tEplKernel nmtmnu_configPrc(tEplNmtMnuConfigParam* pConfigParam_p);
 #endif
 
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+tEplKernel nmtmnu_getBootTimeline(tNmtBootTimeline* pTimeline_p);
+tEplKernel nmtmnu_writeBootTimelineCsv(const tNmtBootTimeline* pTimeline_p, UINT mnNodeId_p,
+                                       const char* pszFileName_p);
+#endif
+
 #endif
 
 #ifdef __cplusplus
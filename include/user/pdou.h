@@ -72,7 +72,10 @@ EPLDLLEXPORT tEplKernel PUBLIC pdou_cbObdAccess(tObdCbParam MEM* pParam_p);
 tEplKernel PUBLIC pdou_cbNmtStateChange(tEventNmtStateChange NmtStateChange_p);
 
 tEplKernel pdou_copyRxPdoToPi (void);
+tEplKernel pdou_copyRxPdoToPiNodes(BYTE* pNodes_p);
+tEplKernel pdou_copyChangedRxPdoToPi(BYTE* pChangedNodes_p);
 tEplKernel pdou_copyTxPdoFromPi (void);
+tEplKernel pdou_copyTxPdoFromPiNodes(BYTE* pNodes_p);
 
 #ifdef __cplusplus
 }
@@ -86,6 +86,7 @@ tEplKernel pdoucal_initSync(tEplSyncCb pfnSyncCb_p);
 void       pdoucal_exitSync(void);
 tEplKernel pdoucal_waitSyncEvent(ULONG timeout_p);
 tEplKernel pdoucal_callSyncCb(void);
+tEplKernel pdoucal_getMissedSyncCount(UINT32* pCount_p);
 
 #ifdef __cplusplus
 }
@@ -1013,6 +1013,180 @@ INLINE_FUNCTION void PUBLIC AmiGetTimeOfDay (void FAR* pAddr_p, tTimeOfDay FAR*
 }
 
 
+//---------------------------------------------------------------------------
+//
+// Function:    AmiSetXXXArrayToBe() / AmiSetXXXArrayToLe()
+//
+// Description: writes an array of values to a buffer in big endian or
+//              little endian
+//
+// Parameters:  pAddr_p         = pointer to destination buffer
+//              pxXXXVal_p      = pointer to array of values
+//              uiCount_p       = number of values
+//
+// Return:      void
+//
+//---------------------------------------------------------------------------
+
+INLINE_FUNCTION void PUBLIC AmiSetWordArrayToBe (void FAR* pAddr_p, const WORD FAR* pwWordVal_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        AmiSetWordToBe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (WORD)), pwWordVal_p[uiIndex]);
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetDwordArrayToBe (void FAR* pAddr_p, const DWORD FAR* pdwDwordVal_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        AmiSetDwordToBe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (DWORD)), pdwDwordVal_p[uiIndex]);
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetQwordArrayToBe (void FAR* pAddr_p, const QWORD FAR* pqwQwordVal_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        AmiSetQword64ToBe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (QWORD)), pqwQwordVal_p[uiIndex]);
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetWordArrayToLe (void FAR* pAddr_p, const WORD FAR* pwWordVal_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        AmiSetWordToLe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (WORD)), pwWordVal_p[uiIndex]);
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetDwordArrayToLe (void FAR* pAddr_p, const DWORD FAR* pdwDwordVal_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        AmiSetDwordToLe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (DWORD)), pdwDwordVal_p[uiIndex]);
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetQwordArrayToLe (void FAR* pAddr_p, const QWORD FAR* pqwQwordVal_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        AmiSetQword64ToLe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (QWORD)), pqwQwordVal_p[uiIndex]);
+    }
+
+}
+
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiGetXXXArrayFromBe() / AmiGetXXXArrayFromLe()
+//
+// Description: reads an array of values from a buffer in big endian or
+//              little endian
+//
+// Parameters:  pxXXXVal_p      = pointer to destination array
+//              pAddr_p         = pointer to source buffer
+//              uiCount_p       = number of values
+//
+// Return:      void
+//
+//---------------------------------------------------------------------------
+
+INLINE_FUNCTION void PUBLIC AmiGetWordArrayFromBe (WORD FAR* pwWordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        pwWordVal_p[uiIndex] = AmiGetWordFromBe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (WORD)));
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetDwordArrayFromBe (DWORD FAR* pdwDwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        pdwDwordVal_p[uiIndex] = AmiGetDwordFromBe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (DWORD)));
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetQwordArrayFromBe (QWORD FAR* pqwQwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        pqwQwordVal_p[uiIndex] = AmiGetQword64FromBe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (QWORD)));
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetWordArrayFromLe (WORD FAR* pwWordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        pwWordVal_p[uiIndex] = AmiGetWordFromLe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (WORD)));
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetDwordArrayFromLe (DWORD FAR* pdwDwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        pdwDwordVal_p[uiIndex] = AmiGetDwordFromLe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (DWORD)));
+    }
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetQwordArrayFromLe (QWORD FAR* pqwQwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+unsigned int    uiIndex;
+
+    for (uiIndex = 0; uiIndex < uiCount_p; uiIndex++)
+    {
+        pqwQwordVal_p[uiIndex] = AmiGetQword64FromLe (((BYTE FAR*) pAddr_p) + (uiIndex * sizeof (QWORD)));
+    }
+
+}
+
+
 #endif
 
 
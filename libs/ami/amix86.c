@@ -76,6 +76,41 @@
 
 #if (!defined(EPL_AMI_INLINED)) || defined(INLINE_ENABLED)
 
+// the array functions use SSSE3/AVX2 shuffles if the compiler targets them,
+// vector registers must not be used in the Linux kernel
+#if !defined(__KERNEL__) && (defined(__SSSE3__) || defined(__AVX2__))
+#include <immintrin.h>
+#define AMI_USE_SSSE3
+#if defined(__AVX2__)
+#define AMI_USE_AVX2
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+//---------------------------------------------------------------------------
+// const defines
+//---------------------------------------------------------------------------
+
+// byte swap of single values
+#if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8))))
+#define AMI_BSWAP16(w)      __builtin_bswap16(w)
+#define AMI_BSWAP32(dw)     __builtin_bswap32(dw)
+#define AMI_BSWAP64(qw)     __builtin_bswap64(qw)
+#elif defined(_MSC_VER)
+#define AMI_BSWAP16(w)      _byteswap_ushort(w)
+#define AMI_BSWAP32(dw)     _byteswap_ulong(dw)
+#define AMI_BSWAP64(qw)     _byteswap_uint64(qw)
+#else
+#define AMI_BSWAP16(w)      ((WORD)((((w) & 0x00FF) << 8) | (((w) & 0xFF00) >> 8)))
+#define AMI_BSWAP32(dw)     ((((dw) & 0x000000FF) << 24) | (((dw) & 0x0000FF00) << 8) | \
+                             (((dw) & 0x00FF0000) >> 8)  | (((dw) & 0xFF000000) >> 24))
+#define AMI_BSWAP64(qw)     (((QWORD)AMI_BSWAP32((DWORD)(qw)) << 32) | \
+                             (QWORD)AMI_BSWAP32((DWORD)((unsigned long long)(qw) >> 32)))
+#endif
+
 //---------------------------------------------------------------------------
 // typedef
 //---------------------------------------------------------------------------
@@ -99,6 +134,35 @@ typedef struct
 } tqwStruct;
 
 
+//---------------------------------------------------------------------------
+// local vars
+//---------------------------------------------------------------------------
+
+#if defined(AMI_USE_SSSE3)
+// shuffle masks which reverse the bytes of each value in a 16 byte vector
+static const BYTE abSwapMaskWord_l[16]  = { 1,  0,  3,  2,  5,  4,  7,  6,
+                                            9,  8, 11, 10, 13, 12, 15, 14};
+static const BYTE abSwapMaskDword_l[16] = { 3,  2,  1,  0,  7,  6,  5,  4,
+                                           11, 10,  9,  8, 15, 14, 13, 12};
+static const BYTE abSwapMaskQword_l[16] = { 7,  6,  5,  4,  3,  2,  1,  0,
+                                           15, 14, 13, 12, 11, 10,  9,  8};
+#endif
+
+
+//---------------------------------------------------------------------------
+// local function prototypes
+//---------------------------------------------------------------------------
+
+static void AmiSwapWordArray  (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiCount_p);
+static void AmiSwapDwordArray (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiCount_p);
+static void AmiSwapQwordArray (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiCount_p);
+static void AmiCopyArray      (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiSize_p);
+#if defined(AMI_USE_SSSE3)
+static unsigned int AmiSwapVectors (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p,
+                                    unsigned int uiSize_p, const BYTE* pabMask_p);
+#endif
+
+
 //=========================================================================//
 //                                                                         //
 //          P U B L I C   F U N C T I O N S                                //
@@ -934,6 +998,324 @@ INLINE_FUNCTION void PUBLIC AmiGetTimeOfDay (void FAR* pAddr_p, tTimeOfDay FAR*
 }
 
 
+//---------------------------------------------------------------------------
+//
+// Function:    AmiSetXXXArrayToBe()
+//
+// Description: writes an array of values to a buffer in big endian
+//              The buffer need not be aligned. Source and destination may
+//              be identical, but they must not overlap otherwise.
+//
+// Parameters:  pAddr_p                 = pointer to destination buffer
+//              pxXXXVal_p              = pointer to array of values
+//              uiCount_p               = number of values
+//
+// Returns:     (none)
+//
+//---------------------------------------------------------------------------
+
+INLINE_FUNCTION void PUBLIC AmiSetWordArrayToBe (void FAR* pAddr_p, const WORD FAR* pwWordVal_p, unsigned int uiCount_p)
+{
+
+    AmiSwapWordArray((BYTE FAR*) pAddr_p, (const BYTE FAR*) pwWordVal_p, uiCount_p);
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetDwordArrayToBe (void FAR* pAddr_p, const DWORD FAR* pdwDwordVal_p, unsigned int uiCount_p)
+{
+
+    AmiSwapDwordArray((BYTE FAR*) pAddr_p, (const BYTE FAR*) pdwDwordVal_p, uiCount_p);
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetQwordArrayToBe (void FAR* pAddr_p, const QWORD FAR* pqwQwordVal_p, unsigned int uiCount_p)
+{
+
+    AmiSwapQwordArray((BYTE FAR*) pAddr_p, (const BYTE FAR*) pqwQwordVal_p, uiCount_p);
+
+}
+
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiSetXXXArrayToLe()
+//
+// Description: writes an array of values to a buffer in little endian
+//
+// Parameters:  pAddr_p                 = pointer to destination buffer
+//              pxXXXVal_p              = pointer to array of values
+//              uiCount_p               = number of values
+//
+// Returns:     (none)
+//
+//---------------------------------------------------------------------------
+
+INLINE_FUNCTION void PUBLIC AmiSetWordArrayToLe (void FAR* pAddr_p, const WORD FAR* pwWordVal_p, unsigned int uiCount_p)
+{
+
+    AmiCopyArray((BYTE FAR*) pAddr_p, (const BYTE FAR*) pwWordVal_p, uiCount_p * sizeof (WORD));
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetDwordArrayToLe (void FAR* pAddr_p, const DWORD FAR* pdwDwordVal_p, unsigned int uiCount_p)
+{
+
+    AmiCopyArray((BYTE FAR*) pAddr_p, (const BYTE FAR*) pdwDwordVal_p, uiCount_p * sizeof (DWORD));
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiSetQwordArrayToLe (void FAR* pAddr_p, const QWORD FAR* pqwQwordVal_p, unsigned int uiCount_p)
+{
+
+    AmiCopyArray((BYTE FAR*) pAddr_p, (const BYTE FAR*) pqwQwordVal_p, uiCount_p * sizeof (QWORD));
+
+}
+
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiGetXXXArrayFromBe()
+//
+// Description: reads an array of values from a buffer in big endian
+//              The buffer need not be aligned. Source and destination may
+//              be identical, but they must not overlap otherwise.
+//
+// Parameters:  pxXXXVal_p              = pointer to destination array
+//              pAddr_p                 = pointer to source buffer
+//              uiCount_p               = number of values
+//
+// Returns:     (none)
+//
+//---------------------------------------------------------------------------
+
+INLINE_FUNCTION void PUBLIC AmiGetWordArrayFromBe (WORD FAR* pwWordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+
+    AmiSwapWordArray((BYTE FAR*) pwWordVal_p, (const BYTE FAR*) pAddr_p, uiCount_p);
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetDwordArrayFromBe (DWORD FAR* pdwDwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+
+    AmiSwapDwordArray((BYTE FAR*) pdwDwordVal_p, (const BYTE FAR*) pAddr_p, uiCount_p);
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetQwordArrayFromBe (QWORD FAR* pqwQwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+
+    AmiSwapQwordArray((BYTE FAR*) pqwQwordVal_p, (const BYTE FAR*) pAddr_p, uiCount_p);
+
+}
+
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiGetXXXArrayFromLe()
+//
+// Description: reads an array of values from a buffer in little endian
+//
+// Parameters:  pxXXXVal_p              = pointer to destination array
+//              pAddr_p                 = pointer to source buffer
+//              uiCount_p               = number of values
+//
+// Returns:     (none)
+//
+//---------------------------------------------------------------------------
+
+INLINE_FUNCTION void PUBLIC AmiGetWordArrayFromLe (WORD FAR* pwWordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+
+    AmiCopyArray((BYTE FAR*) pwWordVal_p, (const BYTE FAR*) pAddr_p, uiCount_p * sizeof (WORD));
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetDwordArrayFromLe (DWORD FAR* pdwDwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+
+    AmiCopyArray((BYTE FAR*) pdwDwordVal_p, (const BYTE FAR*) pAddr_p, uiCount_p * sizeof (DWORD));
+
+}
+
+
+INLINE_FUNCTION void PUBLIC AmiGetQwordArrayFromLe (QWORD FAR* pqwQwordVal_p, const void FAR* pAddr_p, unsigned int uiCount_p)
+{
+
+    AmiCopyArray((BYTE FAR*) pqwQwordVal_p, (const BYTE FAR*) pAddr_p, uiCount_p * sizeof (QWORD));
+
+}
+
+
+//=========================================================================//
+//                                                                         //
+//          P R I V A T E   F U N C T I O N S                              //
+//                                                                         //
+//=========================================================================//
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiSwapXXXArray()
+//
+// Description: copies an array of values and reverses the byte order of
+//              each value
+//              Whole vectors are swapped with SSSE3/AVX2 shuffles if
+//              available, the remaining values with the byte swap builtins
+//              of the compiler. Each value is copied via a local variable,
+//              so neither buffer needs to be aligned.
+//
+// Parameters:  pbDst_p                 = pointer to destination buffer
+//              pbSrc_p                 = pointer to source buffer
+//              uiCount_p               = number of values
+//
+// Returns:     (none)
+//
+//---------------------------------------------------------------------------
+
+static void AmiSwapWordArray (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiCount_p)
+{
+unsigned int    uiOffset = 0;
+unsigned int    uiSize = uiCount_p * sizeof (WORD);
+WORD            wValue;
+
+#if defined(AMI_USE_SSSE3)
+    uiOffset = AmiSwapVectors(pbDst_p, pbSrc_p, uiSize, abSwapMaskWord_l);
+#endif
+
+    for (; uiOffset < uiSize; uiOffset += sizeof (WORD))
+    {
+        EPL_MEMCPY(&wValue, pbSrc_p + uiOffset, sizeof (WORD));
+        wValue = AMI_BSWAP16(wValue);
+        EPL_MEMCPY(pbDst_p + uiOffset, &wValue, sizeof (WORD));
+    }
+
+}
+
+
+static void AmiSwapDwordArray (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiCount_p)
+{
+unsigned int    uiOffset = 0;
+unsigned int    uiSize = uiCount_p * sizeof (DWORD);
+DWORD           dwValue;
+
+#if defined(AMI_USE_SSSE3)
+    uiOffset = AmiSwapVectors(pbDst_p, pbSrc_p, uiSize, abSwapMaskDword_l);
+#endif
+
+    for (; uiOffset < uiSize; uiOffset += sizeof (DWORD))
+    {
+        EPL_MEMCPY(&dwValue, pbSrc_p + uiOffset, sizeof (DWORD));
+        dwValue = AMI_BSWAP32(dwValue);
+        EPL_MEMCPY(pbDst_p + uiOffset, &dwValue, sizeof (DWORD));
+    }
+
+}
+
+
+static void AmiSwapQwordArray (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiCount_p)
+{
+unsigned int    uiOffset = 0;
+unsigned int    uiSize = uiCount_p * sizeof (QWORD);
+QWORD           qwValue;
+
+#if defined(AMI_USE_SSSE3)
+    uiOffset = AmiSwapVectors(pbDst_p, pbSrc_p, uiSize, abSwapMaskQword_l);
+#endif
+
+    for (; uiOffset < uiSize; uiOffset += sizeof (QWORD))
+    {
+        EPL_MEMCPY(&qwValue, pbSrc_p + uiOffset, sizeof (QWORD));
+        qwValue = (QWORD) AMI_BSWAP64(qwValue);
+        EPL_MEMCPY(pbDst_p + uiOffset, &qwValue, sizeof (QWORD));
+    }
+
+}
+
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiSwapVectors()
+//
+// Description: reverses the byte order of the values in all whole 32 byte
+//              (AVX2) and 16 byte (SSSE3) vectors of the source buffer
+//
+// Parameters:  pbDst_p                 = pointer to destination buffer
+//              pbSrc_p                 = pointer to source buffer
+//              uiSize_p                = size of the buffers in bytes
+//              pabMask_p               = shuffle mask for a 16 byte vector
+//
+// Returns:     unsigned int            = number of processed bytes
+//
+//---------------------------------------------------------------------------
+
+#if defined(AMI_USE_SSSE3)
+static unsigned int AmiSwapVectors (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p,
+                                    unsigned int uiSize_p, const BYTE* pabMask_p)
+{
+unsigned int    uiOffset = 0;
+__m128i         mask128;
+__m128i         value128;
+#if defined(AMI_USE_AVX2)
+__m256i         mask256;
+__m256i         value256;
+#endif
+
+    mask128 = _mm_loadu_si128((const __m128i*) pabMask_p);
+
+#if defined(AMI_USE_AVX2)
+    // the shuffle operates on each 128 bit lane separately
+    mask256 = _mm256_broadcastsi128_si256(mask128);
+    for (; uiOffset + 32 <= uiSize_p; uiOffset += 32)
+    {
+        value256 = _mm256_loadu_si256((const __m256i*) (pbSrc_p + uiOffset));
+        _mm256_storeu_si256((__m256i*) (pbDst_p + uiOffset), _mm256_shuffle_epi8(value256, mask256));
+    }
+#endif
+
+    for (; uiOffset + 16 <= uiSize_p; uiOffset += 16)
+    {
+        value128 = _mm_loadu_si128((const __m128i*) (pbSrc_p + uiOffset));
+        _mm_storeu_si128((__m128i*) (pbDst_p + uiOffset), _mm_shuffle_epi8(value128, mask128));
+    }
+
+    return uiOffset;
+
+}
+#endif
+
+
+//---------------------------------------------------------------------------
+//
+// Function:    AmiCopyArray()
+//
+// Description: copies an array without changing the byte order
+//
+// Parameters:  pbDst_p                 = pointer to destination buffer
+//              pbSrc_p                 = pointer to source buffer
+//              uiSize_p                = size of the buffers in bytes
+//
+// Returns:     (none)
+//
+//---------------------------------------------------------------------------
+
+static void AmiCopyArray (BYTE FAR* pbDst_p, const BYTE FAR* pbSrc_p, unsigned int uiSize_p)
+{
+
+    if (pbDst_p != pbSrc_p)
+    {
+        EPL_MEMCPY(pbDst_p, pbSrc_p, uiSize_p);
+    }
+
+}
+
+
 #endif
 
 
@@ -0,0 +1,384 @@
+/**
+********************************************************************************
+\file   circbuf-posixlocal.c
+
+\brief  Circular buffer implementation for a single Posix process
+
+This file contains the architecture specific circular buffer functions for
+systems where all users of a circular buffer run in the same process, e.g.
+the single-process Linux library. The buffers are allocated on the heap and
+locked with a pthread mutex. Thus, no shared memory objects and no named
+semaphores are needed and nothing is left in the file system if the process
+terminates unexpectedly.
+
+\ingroup module_lib_circbuf
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <Epl.h>
+#include <global.h>
+#include <EplTarget.h>
+
+#include "circbuf-arch.h"
+
+#include <pthread.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Process-local circular buffer
+
+The structure contains the memory and the lock of a circular buffer. It is
+shared by all instances accessing the buffer with the same ID. If the buffer
+is freed while instances are still connected, the memory is released when the
+last instance disconnects.
+*/
+typedef struct
+{
+    tCircBufHeader*     pHeader;        ///< Pointer to the buffer memory, starting with the header
+    pthread_mutex_t     lockMutex;      ///< Mutex used for locking
+    BOOL                fAllocated;     ///< Buffer is allocated and not yet freed
+    UINT                connectCount;   ///< Number of connected instances
+} tCircBufLocalBuffer;
+
+/** \brief Architecture specific part of circular buffer instance */
+typedef struct
+{
+    tCircBufLocalBuffer*    pBuffer;    ///< Pointer to the process-local buffer
+} tCircBufArchInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tCircBufLocalBuffer  aBuffer_l[NR_OF_CIRC_BUFFERS];
+static pthread_mutex_t      tableMutex_l = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void releaseBuffer(tCircBufLocalBuffer* pBuffer_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create circular buffer instance
+
+The function allocates the memory needed for the circular buffer instance.
+
+\param  id_p                ID of the circular buffer.
+
+\return The function returns the pointer to the buffer instance or NULL on error.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+tCircBufInstance* circbuf_createInstance(UINT8 id_p)
+{
+    tCircBufInstance*           pInstance;
+    tCircBufArchInstance*       pArch;
+
+    if ((pInstance = EPL_MALLOC(sizeof(tCircBufInstance) +
+                                sizeof(tCircBufArchInstance))) == NULL)
+    {
+        TRACE("%s() malloc failed!\n", __func__);
+        return NULL;
+    }
+    EPL_MEMSET(pInstance, 0, sizeof(tCircBufInstance) + sizeof(tCircBufArchInstance));
+    pInstance->pCircBufArchInstance = (BYTE*)pInstance + sizeof(tCircBufInstance);
+    pInstance->bufferId = id_p;
+
+    pArch = (tCircBufArchInstance*)pInstance->pCircBufArchInstance;
+    pArch->pBuffer = &aBuffer_l[id_p];
+
+    return pInstance;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free circular buffer instance
+
+The function frees the allocated memory used by the circular buffer instance.
+
+\param  pInstance_p         Pointer to circular buffer instance.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+void circbuf_freeInstance(tCircBufInstance* pInstance_p)
+{
+    EPL_FREE(pInstance_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate memory for circular buffer
+
+The function allocates the memory needed for the circular buffer.
+
+\param  pInstance_p         Pointer to the circular buffer instance.
+\param  size_p              Size of memory to allocate.
+
+\return The function returns a tCircBuf Error code.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+tCircBufError circbuf_allocBuffer(tCircBufInstance* pInstance_p, size_t size_p)
+{
+    tCircBufArchInstance*       pArch;
+    tCircBufLocalBuffer*        pBuffer;
+    tCircBufError               ret = kCircBufOk;
+
+    pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
+    pBuffer = pArch->pBuffer;
+
+    pthread_mutex_lock(&tableMutex_l);
+
+    if (pBuffer->pHeader != NULL)
+    {   // buffer is allocated or still used by connected instances
+        TRACE("%s() buffer %d already allocated!\n", __func__, pInstance_p->bufferId);
+        ret = kCircBufNoResource;
+        goto Exit;
+    }
+
+    if (pthread_mutex_init(&pBuffer->lockMutex, NULL) != 0)
+    {
+        TRACE("%s() mutex init failed!\n", __func__);
+        ret = kCircBufNoResource;
+        goto Exit;
+    }
+
+    pBuffer->pHeader = EPL_MALLOC(sizeof(tCircBufHeader) + size_p);
+    if (pBuffer->pHeader == NULL)
+    {
+        TRACE("%s() malloc failed!\n", __func__);
+        pthread_mutex_destroy(&pBuffer->lockMutex);
+        ret = kCircBufNoResource;
+        goto Exit;
+    }
+    pBuffer->fAllocated = TRUE;
+    pBuffer->connectCount = 0;
+
+    pInstance_p->pCircBufHeader = pBuffer->pHeader;
+    pInstance_p->pCircBuf = (BYTE*)pBuffer->pHeader + sizeof(tCircBufHeader);
+
+Exit:
+    pthread_mutex_unlock(&tableMutex_l);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free memory used by circular buffer
+
+The function frees the allocated memory used by the circular buffer.
+
+\param  pInstance_p         Pointer to circular buffer instance.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+void circbuf_freeBuffer(tCircBufInstance* pInstance_p)
+{
+    tCircBufArchInstance*       pArch;
+    tCircBufLocalBuffer*        pBuffer;
+
+    pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
+    pBuffer = pArch->pBuffer;
+
+    pthread_mutex_lock(&tableMutex_l);
+
+    pBuffer->fAllocated = FALSE;
+    if (pBuffer->connectCount == 0)
+        releaseBuffer(pBuffer);
+
+    pthread_mutex_unlock(&tableMutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Connect to circular buffer
+
+The function connects the calling thread to the circular buffer.
+
+\param  pInstance_p         Pointer to circular buffer instance.
+
+\return The function returns a tCircBuf Error code.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+tCircBufError circbuf_connectBuffer(tCircBufInstance* pInstance_p)
+{
+    tCircBufArchInstance*       pArch;
+    tCircBufLocalBuffer*        pBuffer;
+    tCircBufError               ret = kCircBufOk;
+
+    pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
+    pBuffer = pArch->pBuffer;
+
+    pthread_mutex_lock(&tableMutex_l);
+
+    if (!pBuffer->fAllocated)
+    {
+        ret = kCircBufNoResource;
+    }
+    else
+    {
+        pBuffer->connectCount++;
+        pInstance_p->pCircBufHeader = pBuffer->pHeader;
+        pInstance_p->pCircBuf = (BYTE*)pBuffer->pHeader + sizeof(tCircBufHeader);
+    }
+
+    pthread_mutex_unlock(&tableMutex_l);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Disconnect from circular buffer
+
+The function disconnects the calling thread from the circular buffer.
+
+\param  pInstance_p         Pointer to circular buffer instance.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+void circbuf_disconnectBuffer(tCircBufInstance* pInstance_p)
+{
+    tCircBufArchInstance*       pArch;
+    tCircBufLocalBuffer*        pBuffer;
+
+    pArch = (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
+    pBuffer = pArch->pBuffer;
+
+    pthread_mutex_lock(&tableMutex_l);
+
+    if (pBuffer->connectCount > 0)
+        pBuffer->connectCount--;
+
+    if ((pBuffer->connectCount == 0) && !pBuffer->fAllocated && (pBuffer->pHeader != NULL))
+        releaseBuffer(pBuffer);
+
+    pthread_mutex_unlock(&tableMutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Lock circular buffer
+
+The function enters a locked section of the circular buffer.
+
+\param  pInstance_p         Pointer to circular buffer instance.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+void circbuf_lock(tCircBufInstance* pInstance_p)
+{
+    tCircBufArchInstance* pArchInstance =
+                              (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
+    pthread_mutex_lock(&pArchInstance->pBuffer->lockMutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unlock circular buffer
+
+The function leaves a locked section of the circular buffer.
+
+\param  pInstance_p         Pointer to circular buffer instance.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+void circbuf_unlock(tCircBufInstance* pInstance_p)
+{
+    tCircBufArchInstance* pArchInstance =
+                              (tCircBufArchInstance*)pInstance_p->pCircBufArchInstance;
+    pthread_mutex_unlock(&pArchInstance->pBuffer->lockMutex);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release buffer memory
+
+The function releases the memory and the lock of a process-local buffer. The
+table mutex must be locked by the caller.
+
+\param  pBuffer_p           Pointer to the process-local buffer.
+*/
+//------------------------------------------------------------------------------
+static void releaseBuffer(tCircBufLocalBuffer* pBuffer_p)
+{
+    pthread_mutex_destroy(&pBuffer_p->lockMutex);
+    EPL_FREE(pBuffer_p->pHeader);
+    pBuffer_p->pHeader = NULL;
+}
+
+///\}
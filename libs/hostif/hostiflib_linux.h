@@ -0,0 +1,120 @@
+/**
+********************************************************************************
+\file   hostiflib_linux.h
+
+\brief  Host Interface Library - For Linux host memory
+
+This header file provides specific macros for placing the host interface
+queues in the memory of a Linux process. It doesn't provide access to a host
+interface hardware, hence only the lock-free queue (lfqueue.c) can be built
+for this target. It is used to test and benchmark the queue without the FPGA.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_HOSTIF_LINUX_H_
+#define _INC_HOSTIF_LINUX_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+/// cache
+#define HOSTIF_MAKE_NONCACHEABLE(ptr)   (void*)(ptr)
+
+#define HOSTIF_UNCACHED_MALLOC(size)    malloc(size)
+#define HOSTIF_UNCACHED_FREE(ptr)       free(ptr)
+
+/// sleep
+#define HOSTIF_USLEEP(x)                usleep((useconds_t)x)
+
+/// memory access, the barriers order the queue data and the queue indices
+#define HOSTIF_RD32(base, offset)       hostif_linuxRd32((void*)(base), offset)
+#define HOSTIF_RD16(base, offset)       hostif_linuxRd16((void*)(base), offset)
+#define HOSTIF_RD8(base, offset)        hostif_linuxRd8((void*)(base), offset)
+
+#define HOSTIF_WR32(base, offset, dword)                                    \
+    do {                                                                    \
+        __sync_synchronize();                                               \
+        *(volatile uint32_t*)((uint8_t*)(base) + (offset)) = (dword);       \
+    } while (0)
+#define HOSTIF_WR16(base, offset, word)                                     \
+    do {                                                                    \
+        __sync_synchronize();                                               \
+        *(volatile uint16_t*)((uint8_t*)(base) + (offset)) = (word);        \
+    } while (0)
+#define HOSTIF_WR8(base, offset, byte)                                      \
+    do {                                                                    \
+        __sync_synchronize();                                               \
+        *(volatile uint8_t*)((uint8_t*)(base) + (offset)) = (byte);         \
+    } while (0)
+
+#define HOSTIF_INLINE inline
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+static inline uint32_t hostif_linuxRd32(void* pBase_p, size_t offset_p)
+{
+    uint32_t    val = *(volatile uint32_t*)((uint8_t*)pBase_p + offset_p);
+
+    __sync_synchronize();
+    return val;
+}
+
+static inline uint16_t hostif_linuxRd16(void* pBase_p, size_t offset_p)
+{
+    uint16_t    val = *(volatile uint16_t*)((uint8_t*)pBase_p + offset_p);
+
+    __sync_synchronize();
+    return val;
+}
+
+static inline uint8_t hostif_linuxRd8(void* pBase_p, size_t offset_p)
+{
+    uint8_t     val = *(volatile uint8_t*)((uint8_t*)pBase_p + offset_p);
+
+    __sync_synchronize();
+    return val;
+}
+
+#endif /* _INC_HOSTIF_LINUX_H_ */
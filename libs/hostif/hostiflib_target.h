@@ -52,6 +52,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #error "Microblaze not yet supported!"
 
+#elif defined(__linux__) && !defined(__KERNEL__)
+
+#include "hostiflib_linux.h"
+
 #else
 
 #error "Target is not supported! Please revise hostiflib_target.h"
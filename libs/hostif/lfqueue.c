@@ -73,7 +73,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define ALIGN32(ptr)        (((UINT32)(ptr) + 3U) & 0xFFFFFFFCU)
                                     ///< aligns the pointer to UINT32 (4 byte)
-#define UNALIGNED32(ptr)    ((UINT32)(ptr) & 3U)
+#define UNALIGNED32(ptr)    ((UINT32)(size_t)(ptr) & 3U)
                                     ///< checks if the pointer is UINT32-aligned
 
 //------------------------------------------------------------------------------
@@ -234,6 +234,12 @@ HOSTIF_INLINE static BOOL checkMagicValid (tEntryHeader *pHeader_p);
 HOSTIF_INLINE static BOOL checkPayloadFitable (tQueue *pQueue_p, UINT16 payloadSize_p);
 HOSTIF_INLINE static BOOL checkQueueEmpty (tQueue *pQueue_p);
 
+HOSTIF_INLINE static tQueueReturn checkEnqueueState (tQueue *pQueue_p);
+HOSTIF_INLINE static tQueueReturn writeEntry (tQueue *pQueue_p, UINT8 *pData_p,
+        UINT16 size_p);
+HOSTIF_INLINE static tQueueReturn readEntry (tQueue *pQueue_p, UINT8 *pData_p,
+        UINT16 *pSize_p);
+
 HOSTIF_INLINE static void writeHeader (tQueue *pQueue_p, tEntryHeader *pHeader_p);
 HOSTIF_INLINE static void writeData (tQueue *pQueue_p, UINT8 *pData_p, UINT16 size_p);
 HOSTIF_INLINE static void writeCirMemory (tQueue *pQueue_p, UINT16 offset_p,
@@ -543,46 +549,23 @@ tQueueReturn lfq_entryEnqueue (tQueueInstance pInstance_p,
         UINT8 *pData_p, UINT16 size_p)
 {
     tQueue *pQueue = (tQueue*)pInstance_p;
-    UINT16 entryPayloadSize;
-    tEntryHeader entryHeader;
+    tQueueReturn ret;
 
     if(pQueue == NULL || pData_p == NULL || size_p > QUEUE_MAX_PAYLOAD)
         return kQueueInvalidParameter;
 
-    switch(getHwQueueState(pQueue))
-    {
-        case kQueueStateOperational:
-            break;
-        case kQueueStateReset:
-            /// queue was reset by consumer, producer reactivates queue
-            setHwQueueState(pQueue, kQueueStateOperational);
-            break;
-        default:
-        case kQueueStateInvalid:
-            return kQueueHwError;
-    }
+    ret = checkEnqueueState(pQueue);
+    if(ret != kQueueSuccessful)
+        return ret;
 
     if(UNALIGNED32(pData_p))
         return kQueueAlignment;
 
     getHwQueueBufferHeader(pQueue);
 
-    entryPayloadSize = ALIGN32(size_p);
-
-    if(!checkPayloadFitable(pQueue, entryPayloadSize))
-        return kQueueFull;
-
-    /// prepare header
-    entryHeader.magic = QUEUE_MAGIC;
-    entryHeader.payloadSize = entryPayloadSize;
-    memset(entryHeader.aReserved, 0, sizeof(entryHeader.aReserved));
-
-    writeHeader(pQueue, &entryHeader);
-
-    writeData(pQueue, pData_p, entryPayloadSize);
-
-    /// new element is written
-    pQueue->local.entryIndices.write += 1;
+    ret = writeEntry(pQueue, pData_p, size_p);
+    if(ret != kQueueSuccessful)
+        return ret;
 
     /// the new indices are written to hw only if the queue is still operational
     if(getHwQueueState(pQueue) != kQueueStateOperational)
@@ -622,10 +605,9 @@ tQueueReturn lfq_entryDequeue (tQueueInstance pInstance_p,
         UINT8 *pData_p, UINT16 *pSize_p)
 {
     tQueue *pQueue = (tQueue*)pInstance_p;
-    tEntryHeader EntryHeader;
-    UINT16 size;
+    tQueueReturn ret;
 
-    if(pQueue == NULL || pData_p == NULL)
+    if(pQueue == NULL || pData_p == NULL || pSize_p == NULL)
         return kQueueInvalidParameter;
 
     /// not operational queues are empty for the consumer
@@ -637,28 +619,165 @@ tQueueReturn lfq_entryDequeue (tQueueInstance pInstance_p,
 
     getHwQueueBufferHeader(pQueue);
 
-    if(checkQueueEmpty(pQueue))
-        return kQueueEmpty;
+    ret = readEntry(pQueue, pData_p, pSize_p);
+    if(ret != kQueueSuccessful)
+        return ret;
 
-    readHeader(pQueue, &EntryHeader);
+    setHwQueueRead(pQueue);
 
-    if(!checkMagicValid(&EntryHeader))
-        return kQueueInvalidEntry;
+    return kQueueSuccessful;
+}
 
-    size = ALIGN32(EntryHeader.payloadSize);
+//------------------------------------------------------------------------------
+/**
+\brief    Enqueue multiple entries into the queue instance
 
-    if(size > *pSize_p)
-        return kQueueNoResource;
+This function enqueues the entries given by the arrays apData_p and aSize_p
+into the queue instance. The entries are enqueued in array order until an
+entry doesn't fit into the queue. The queue indices are written to the shared
+memory once for all enqueued entries. Hence, the consumer sees the complete
+batch at once.
 
-    readData(pQueue, pData_p, size);
+\param  pInstance_p             The queue instance of interest
+\param  apData_p                Array of pointers to the data to be inserted
+\param  aSize_p                 Array of the sizes of the data to be inserted
+\param  count_p                 Number of entries in the arrays
+\param  pEnqueued_p             Returns the number of enqueued entries
 
-    /// element is read
-    pQueue->local.entryIndices.read += 1;
+\return tQueueReturn
+\retval kQueueSuccessful        At least one entry is enqueued successfully
+\retval kQueueInvalidParamter   If the parameter pointers are NULL or an entry
+                                size exceeds QUEUE_MAX_PAYLOAD
+\retval kQueueAlignment         An entry is not UINT32 aligned
+\retval kQueueFull              The queue instance is full
+\retval kQueueHwError           Queue invalid
 
-    setHwQueueRead(pQueue);
+\ingroup module_hostiflib
+*/
+//------------------------------------------------------------------------------
+tQueueReturn lfq_entryEnqueueMultiple (tQueueInstance pInstance_p,
+        UINT8 **apData_p, UINT16 *aSize_p, UINT16 count_p,
+        UINT16 *pEnqueued_p)
+{
+    tQueue *pQueue = (tQueue*)pInstance_p;
+    tQueueReturn ret;
+    UINT16 i;
 
-    /// return entry size
-    *pSize_p = size;
+    if(pQueue == NULL || apData_p == NULL || aSize_p == NULL ||
+       pEnqueued_p == NULL || count_p == 0)
+        return kQueueInvalidParameter;
+
+    *pEnqueued_p = 0;
+
+    /// check all entries before anything is written
+    for(i = 0; i < count_p; i++)
+    {
+        if(apData_p[i] == NULL || aSize_p[i] > QUEUE_MAX_PAYLOAD)
+            return kQueueInvalidParameter;
+
+        if(UNALIGNED32(apData_p[i]))
+            return kQueueAlignment;
+    }
+
+    ret = checkEnqueueState(pQueue);
+    if(ret != kQueueSuccessful)
+        return ret;
+
+    getHwQueueBufferHeader(pQueue);
+
+    for(i = 0; i < count_p; i++)
+    {
+        if(writeEntry(pQueue, apData_p[i], aSize_p[i]) != kQueueSuccessful)
+            break;
+    }
+
+    if(i == 0)
+        return kQueueFull;
+
+    *pEnqueued_p = i;
+
+    /// the new indices are written to hw only if the queue is still operational
+    if(getHwQueueState(pQueue) != kQueueStateOperational)
+        return kQueueSuccessful;
+
+    setHwQueueWrite(pQueue);
+
+    return kQueueSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Dequeue multiple entries from the queue instance
+
+This function dequeues up to count_p entries from the queue instance into the
+buffers given by the arrays apData_p and aSize_p. The entries are read until
+the queue is empty, all buffers are filled or an entry can't be read. The
+queue indices are written to the shared memory once for all dequeued entries.
+If an error occurs after at least one entry is dequeued, the dequeued entries
+are returned and the error is reported by the next call.
+
+\param  pInstance_p             The queue instance of interest
+\param  apData_p                Array of pointers to the buffers to be used for
+                                extracting the entries
+\param  aSize_p                 Array of the buffer sizes, returns the actual
+                                sizes of the dequeued entries
+\param  count_p                 Number of entries in the arrays
+\param  pDequeued_p             Returns the number of dequeued entries
+
+\return tQueueReturn
+\retval kQueueSuccessful        At least one entry is dequeued successfully
+\retval kQueueInvalidParamter   If the parameter pointers are NULL
+\retval kQueueAlignment         An entry buffer is not UINT32 aligned
+\retval kQueueEmpty             The queue instance is empty
+\retval kQueueInvalidEntry      The read entry of the queue instance is
+                                invalid (magic queue word is wrong!)
+\retval kQueueNoResource        The provided entry buffer is too small
+
+\ingroup module_hostiflib
+*/
+//------------------------------------------------------------------------------
+tQueueReturn lfq_entryDequeueMultiple (tQueueInstance pInstance_p,
+        UINT8 **apData_p, UINT16 *aSize_p, UINT16 count_p,
+        UINT16 *pDequeued_p)
+{
+    tQueue *pQueue = (tQueue*)pInstance_p;
+    tQueueReturn ret = kQueueSuccessful;
+    UINT16 i;
+
+    if(pQueue == NULL || apData_p == NULL || aSize_p == NULL ||
+       pDequeued_p == NULL || count_p == 0)
+        return kQueueInvalidParameter;
+
+    *pDequeued_p = 0;
+
+    for(i = 0; i < count_p; i++)
+    {
+        if(apData_p[i] == NULL)
+            return kQueueInvalidParameter;
+
+        if(UNALIGNED32(apData_p[i]))
+            return kQueueAlignment;
+    }
+
+    /// not operational queues are empty for the consumer
+    if(getHwQueueState(pQueue) != kQueueStateOperational)
+        return kQueueEmpty;
+
+    getHwQueueBufferHeader(pQueue);
+
+    for(i = 0; i < count_p; i++)
+    {
+        ret = readEntry(pQueue, apData_p[i], &aSize_p[i]);
+        if(ret != kQueueSuccessful)
+            break;
+    }
+
+    if(i == 0)
+        return ret;
+
+    *pDequeued_p = i;
+
+    setHwQueueRead(pQueue);
 
     return kQueueSuccessful;
 }
@@ -884,6 +1003,133 @@ static BOOL checkQueueEmpty (tQueue *pQueue_p)
     return (pQueue_p->local.usedSpace == 0);
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Check the queue state before enqueuing
+
+If the queue was reset by the consumer, the producer reactivates the queue.
+
+\param  pQueue_p                Queue instance of interest
+
+\return The function returns kQueueSuccessful if entries can be enqueued,
+        otherwise kQueueHwError.
+*/
+//------------------------------------------------------------------------------
+static tQueueReturn checkEnqueueState (tQueue *pQueue_p)
+{
+    switch(getHwQueueState(pQueue_p))
+    {
+        case kQueueStateOperational:
+            break;
+        case kQueueStateReset:
+            /// queue was reset by consumer, producer reactivates queue
+            setHwQueueState(pQueue_p, kQueueStateOperational);
+            break;
+        default:
+        case kQueueStateInvalid:
+            return kQueueHwError;
+    }
+
+    return kQueueSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Write a queue entry to queue instance
+
+This function writes the entry header and payload and updates the local
+indices. The indices in the shared memory are not written, the caller has to
+call setHwQueueWrite().
+
+\param  pQueue_p                Queue instance of interest
+\param  pData_p                 Payload data to be written
+\param  size_p                  Size of payload data to be written
+
+\return The function returns kQueueSuccessful if the entry is written or
+        kQueueFull if the entry doesn't fit into the queue.
+*/
+//------------------------------------------------------------------------------
+static tQueueReturn writeEntry (tQueue *pQueue_p, UINT8 *pData_p, UINT16 size_p)
+{
+    UINT16 entryPayloadSize = ALIGN32(size_p);
+    tEntryHeader entryHeader;
+
+    if(!checkPayloadFitable(pQueue_p, entryPayloadSize))
+        return kQueueFull;
+
+    /// prepare header
+    entryHeader.magic = QUEUE_MAGIC;
+    entryHeader.payloadSize = entryPayloadSize;
+    memset(entryHeader.aReserved, 0, sizeof(entryHeader.aReserved));
+
+    writeHeader(pQueue_p, &entryHeader);
+
+    writeData(pQueue_p, pData_p, entryPayloadSize);
+
+    /// new element is written
+    pQueue_p->local.entryIndices.write += 1;
+    pQueue_p->local.freeSpace -= (sizeof(tEntryHeader) + entryPayloadSize) /
+            ENTRY_MIN_SIZE;
+
+    return kQueueSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Read a queue entry from queue instance
+
+This function reads the entry header and payload and updates the local
+indices. The indices in the shared memory are not written, the caller has to
+call setHwQueueRead().
+
+\param  pQueue_p                Queue instance of interest
+\param  pData_p                 Buffer to be filled with the payload
+\param  pSize_p                 Size of the buffer, returns the actual size of
+                                the entry
+
+\return The function returns a tQueueReturn error code.
+*/
+//------------------------------------------------------------------------------
+static tQueueReturn readEntry (tQueue *pQueue_p, UINT8 *pData_p, UINT16 *pSize_p)
+{
+    tEntryHeader entryHeader;
+    UINT16 readIndex;
+    UINT16 size;
+
+    if(checkQueueEmpty(pQueue_p))
+        return kQueueEmpty;
+
+    /// the header is only consumed if the whole entry can be read
+    readIndex = pQueue_p->local.spaceIndices.read;
+
+    readHeader(pQueue_p, &entryHeader);
+
+    if(!checkMagicValid(&entryHeader))
+    {
+        pQueue_p->local.spaceIndices.read = readIndex;
+        return kQueueInvalidEntry;
+    }
+
+    size = ALIGN32(entryHeader.payloadSize);
+
+    if(size > *pSize_p)
+    {
+        pQueue_p->local.spaceIndices.read = readIndex;
+        return kQueueNoResource;
+    }
+
+    readData(pQueue_p, pData_p, size);
+
+    /// element is read
+    pQueue_p->local.entryIndices.read += 1;
+    pQueue_p->local.usedSpace -= (sizeof(tEntryHeader) + size) / ENTRY_MIN_SIZE;
+
+    /// return entry size
+    *pSize_p = size;
+
+    return kQueueSuccessful;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief    Write queue entry header to queue instance
@@ -937,7 +1183,7 @@ This function writes data from a source to a circular memory.
 static void writeCirMemory (tQueue *pQueue_p, UINT16 offset_p,
         UINT8 *pSrc_p, UINT16 srcSpan_p)
 {
-    UINT8 *pDst = (UINT8*)(&pQueue_p->pQueueBuffer->data);
+    UINT8 *pDst = (UINT8*)pQueue_p->pQueueBuffer + offsetof(tQueueBuffer, data);
     UINT16 part;
 
     if(offset_p + srcSpan_p <= pQueue_p->queueBufferSpan)
@@ -1012,7 +1258,7 @@ This function reads data from a circular memory.
 static void readCirMemory (tQueue *pQueue_p, UINT16 offset_p,
         UINT8 *pDst_p, UINT16 dstSpan_p)
 {
-    UINT8 *pSrc = (UINT8*)(&pQueue_p->pQueueBuffer->data);
+    UINT8 *pSrc = (UINT8*)pQueue_p->pQueueBuffer + offsetof(tQueueBuffer, data);
     UINT16 part;
 
     if(offset_p + dstSpan_p <= pQueue_p->queueBufferSpan)
@@ -130,6 +130,13 @@ tQueueReturn lfq_entryEnqueue (tQueueInstance pInstance_p,
 tQueueReturn lfq_entryDequeue (tQueueInstance pInstance_p,
         UINT8 *pData_p, UINT16 *pSize_p);
 
+tQueueReturn lfq_entryEnqueueMultiple (tQueueInstance pInstance_p,
+        UINT8 **apData_p, UINT16 *aSize_p, UINT16 count_p,
+        UINT16 *pEnqueued_p);
+tQueueReturn lfq_entryDequeueMultiple (tQueueInstance pInstance_p,
+        UINT8 **apData_p, UINT16 *aSize_p, UINT16 count_p,
+        UINT16 *pDequeued_p);
+
 #ifdef __cplusplus
 }
 #endif
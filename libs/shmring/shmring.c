@@ -0,0 +1,553 @@
+/**
+********************************************************************************
+\file   shmring.c
+
+\brief  Shared memory ring library
+
+This file contains the implementation of the shared memory ring library.
+
+\ingroup module_lib_shmring
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+/**
+********************************************************************************
+
+\defgroup   module_lib_shmring    Shared Memory Ring Library
+\ingroup    libraries
+
+The shared memory ring library implements a lock-free ring of variable sized
+entries for exactly one producer and one consumer. The whole state of a ring is
+located in a single memory block (header and data area), therefore a ring can
+be placed in memory which is mapped into different address spaces, e.g. memory
+of the openPOWERLINK kernel module mapped into the user application.
+
+The producer only changes the write offset and the consumer only changes the
+read offset. Memory barriers ensure that an entry is completely written before
+it becomes visible to the consumer and that it is completely read before the
+producer is allowed to overwrite it. Several producers or consumers on the same
+side of a ring must be serialized by the caller.
+
+An entry is never split at the end of the data area. If it does not fit into
+the remaining space, a wrap marker is written and the entry is stored at the
+beginning of the data area. This allows the consumer to access an entry in place
+by shmring_peekData() and shmring_releaseData().
+
+The signal pending flag in the header can be used to coalesce notifications of
+the consumer: The producer calls shmring_setSignalPending() after writing an
+entry and signals the consumer only if the flag was not already set. The
+consumer calls shmring_clearSignalPending() before it reads all available
+entries.
+*******************************************************************************/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "shmring.h"
+
+#if defined(__KERNEL__)
+#include <asm/atomic.h>
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SHMRING_WRAP_MARKER             0xFFFFFFFF
+#define SHMRING_ENTRY_HEADER_SIZE       sizeof(UINT32)
+#define SHMRING_ALIGN(size)             (((size) + (SHMRING_BLOCK_ALIGNMENT - 1)) & \
+                                         ~(SHMRING_BLOCK_ALIGNMENT - 1))
+
+#if defined(__KERNEL__)
+#define SHMRING_MB()                    smp_mb()
+#define SHMRING_XCHG(pVal, val)         xchg(pVal, val)
+#elif defined(__GNUC__)
+#define SHMRING_MB()                    __sync_synchronize()
+#define SHMRING_XCHG(pVal, val)         __sync_lock_test_and_set(pVal, val)
+#else
+#error "Memory barriers are not defined for this target!"
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tShmRingError getEntry(tShmRingInstance* pInstance_p, UINT32* pOffset_p,
+                              UINT32* pSize_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize a ring
+
+The function initializes a ring in the given memory block. It must be called
+once by the owner of the memory before producer and consumer access the ring.
+The data area occupies the memory following the header.
+
+\param  pInstance_p             Pointer to the ring instance to initialize.
+\param  pMem_p                  Pointer to the memory block of the ring.
+\param  memSize_p               Size of the memory block.
+
+\return The function returns a tShmRingError error code.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+tShmRingError shmring_init(tShmRingInstance* pInstance_p, void* pMem_p, size_t memSize_p)
+{
+    tShmRingHeader*     pHeader = (tShmRingHeader*)pMem_p;
+
+    if ((pInstance_p == NULL) || (pMem_p == NULL) ||
+        (memSize_p < sizeof(tShmRingHeader) + 2 * SHMRING_BLOCK_ALIGNMENT))
+        return kShmRingInvalidArg;
+
+    EPL_MEMSET(pHeader, 0, sizeof(tShmRingHeader));
+    pHeader->dataSize = (UINT32)(memSize_p - sizeof(tShmRingHeader)) &
+                        ~(SHMRING_BLOCK_ALIGNMENT - 1);
+    SHMRING_MB();
+    pHeader->magic = SHMRING_MAGIC;
+
+    return shmring_connect(pInstance_p, pMem_p, memSize_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Connect to a ring
+
+The function connects to a ring which was initialized by shmring_init(),
+possibly in another address space.
+
+\param  pInstance_p             Pointer to the ring instance to set up.
+\param  pMem_p                  Pointer to the memory block of the ring.
+\param  memSize_p               Size of the memory block.
+
+\return The function returns a tShmRingError error code.
+\retval kShmRingCorrupted       The memory block does not contain a valid ring.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+tShmRingError shmring_connect(tShmRingInstance* pInstance_p, void* pMem_p, size_t memSize_p)
+{
+    tShmRingHeader*     pHeader = (tShmRingHeader*)pMem_p;
+
+    if ((pInstance_p == NULL) || (pMem_p == NULL) || (memSize_p < sizeof(tShmRingHeader)))
+        return kShmRingInvalidArg;
+
+    if ((pHeader->magic != SHMRING_MAGIC) ||
+        (pHeader->dataSize > memSize_p - sizeof(tShmRingHeader)) ||
+        ((pHeader->dataSize & (SHMRING_BLOCK_ALIGNMENT - 1)) != 0))
+        return kShmRingCorrupted;
+
+    pInstance_p->pHeader = pHeader;
+    pInstance_p->pData = (BYTE*)pMem_p + sizeof(tShmRingHeader);
+    pInstance_p->dataSize = pHeader->dataSize;
+
+    return kShmRingOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset a ring
+
+The function discards all entries of a ring. It must not be called while the
+producer or the consumer is accessing the ring.
+
+\param  pInstance_p             Pointer to the ring instance.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+void shmring_reset(tShmRingInstance* pInstance_p)
+{
+    pInstance_p->pHeader->writeOffset = 0;
+    pInstance_p->pHeader->readOffset = 0;
+    pInstance_p->pHeader->signalPending = 0;
+    SHMRING_MB();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to a ring
+
+The function writes a data block as one entry into a ring. It must only be
+called by the producer.
+
+\param  pInstance_p             Pointer to the ring instance.
+\param  pData_p                 Pointer to the data block to write.
+\param  size_p                  Size of the data block.
+
+\return The function returns a tShmRingError error code.
+\retval kShmRingBufferFull      There is not enough free space for the entry.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+tShmRingError shmring_writeData(tShmRingInstance* pInstance_p, const void* pData_p, size_t size_p)
+{
+    return shmring_writeMultipleData(pInstance_p, pData_p, size_p, NULL, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write multiple data blocks to a ring
+
+The function writes two data blocks as one entry into a ring. It must only be
+called by the producer.
+
+\param  pInstance_p             Pointer to the ring instance.
+\param  pData_p                 Pointer to the first data block to write.
+\param  size_p                  Size of the first data block.
+\param  pData2_p                Pointer to the second data block to write.
+\param  size2_p                 Size of the second data block.
+
+\return The function returns a tShmRingError error code.
+\retval kShmRingBufferFull      There is not enough free space for the entry.
+\retval kShmRingExceedDataSizeLimit The entry is larger than the ring.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+tShmRingError shmring_writeMultipleData(tShmRingInstance* pInstance_p, const void* pData_p, size_t size_p,
+                                        const void* pData2_p, size_t size2_p)
+{
+    tShmRingHeader*     pHeader = pInstance_p->pHeader;
+    UINT32              dataSize = pInstance_p->dataSize;
+    UINT32              entrySize;
+    UINT32              writeOffset;
+    UINT32              readOffset;
+    UINT32              usedSize;
+    UINT32              requiredSize;
+    UINT32              entryOffset;
+    BYTE*               pEntry;
+
+    if (size_p + size2_p + SHMRING_ENTRY_HEADER_SIZE + SHMRING_BLOCK_ALIGNMENT > dataSize)
+        return kShmRingExceedDataSizeLimit;
+
+    entrySize = SHMRING_ALIGN((UINT32)(SHMRING_ENTRY_HEADER_SIZE + size_p + size2_p));
+
+    writeOffset = pHeader->writeOffset;
+    readOffset = pHeader->readOffset;
+    // the read offset has to be fetched before the released entries are overwritten
+    SHMRING_MB();
+
+    if ((writeOffset >= dataSize) || (readOffset >= dataSize))
+        return kShmRingCorrupted;
+
+    if (writeOffset >= readOffset)
+        usedSize = writeOffset - readOffset;
+    else
+        usedSize = dataSize - readOffset + writeOffset;
+
+    if (entrySize <= dataSize - writeOffset)
+    {
+        entryOffset = writeOffset;
+        requiredSize = entrySize;
+    }
+    else
+    {   // entry doesn't fit into the remaining space, skip it
+        entryOffset = 0;
+        requiredSize = dataSize - writeOffset + entrySize;
+    }
+
+    // one block always stays free to distinguish a full from an empty ring
+    if (requiredSize > dataSize - usedSize - SHMRING_BLOCK_ALIGNMENT)
+        return kShmRingBufferFull;
+
+    if (entryOffset != writeOffset)
+        *(UINT32*)(pInstance_p->pData + writeOffset) = SHMRING_WRAP_MARKER;
+
+    pEntry = pInstance_p->pData + entryOffset;
+    *(UINT32*)pEntry = (UINT32)(size_p + size2_p);
+    if (size_p != 0)
+        EPL_MEMCPY(pEntry + SHMRING_ENTRY_HEADER_SIZE, pData_p, size_p);
+    if (size2_p != 0)
+        EPL_MEMCPY(pEntry + SHMRING_ENTRY_HEADER_SIZE + size_p, pData2_p, size2_p);
+
+    writeOffset = entryOffset + entrySize;
+    if (writeOffset == dataSize)
+        writeOffset = 0;
+
+    // the entry has to be visible before the write offset is published
+    SHMRING_MB();
+    pHeader->writeOffset = writeOffset;
+
+    return kShmRingOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read data from a ring
+
+The function copies the oldest entry of a ring into the given buffer and
+removes it from the ring. It must only be called by the consumer.
+
+\param  pInstance_p             Pointer to the ring instance.
+\param  pData_p                 Pointer to the buffer for the entry.
+\param  size_p                  Size of the buffer.
+\param  pDataBlockSize_p        Pointer to store the size of the entry.
+
+\return The function returns a tShmRingError error code.
+\retval kShmRingNoReadableData  The ring is empty.
+\retval kShmRingReadsizeTooSmall The buffer is too small for the entry. The
+                                entry stays in the ring.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+tShmRingError shmring_readData(tShmRingInstance* pInstance_p, void* pData_p,
+                               size_t size_p, size_t* pDataBlockSize_p)
+{
+    tShmRingError       ret;
+    void*               pEntryData;
+    size_t              entrySize;
+
+    ret = shmring_peekData(pInstance_p, &pEntryData, &entrySize);
+    if (ret != kShmRingOk)
+        return ret;
+
+    if (entrySize > size_p)
+        return kShmRingReadsizeTooSmall;
+
+    EPL_MEMCPY(pData_p, pEntryData, entrySize);
+    *pDataBlockSize_p = entrySize;
+
+    shmring_releaseData(pInstance_p);
+
+    return kShmRingOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the oldest entry of a ring
+
+The function provides access to the oldest entry of a ring without copying it.
+The entry stays valid until it is released by shmring_releaseData(). The
+function must only be called by the consumer.
+
+\param  pInstance_p             Pointer to the ring instance.
+\param  ppData_p                Pointer to store the pointer to the entry.
+\param  pDataBlockSize_p        Pointer to store the size of the entry.
+
+\return The function returns a tShmRingError error code.
+\retval kShmRingNoReadableData  The ring is empty.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+tShmRingError shmring_peekData(tShmRingInstance* pInstance_p, void** ppData_p, size_t* pDataBlockSize_p)
+{
+    tShmRingError       ret;
+    UINT32              entryOffset;
+    UINT32              size;
+
+    ret = getEntry(pInstance_p, &entryOffset, &size);
+    if (ret != kShmRingOk)
+        return ret;
+
+    *ppData_p = pInstance_p->pData + entryOffset + SHMRING_ENTRY_HEADER_SIZE;
+    *pDataBlockSize_p = size;
+
+    return kShmRingOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release the oldest entry of a ring
+
+The function removes the entry obtained by shmring_peekData() from the ring.
+The memory of the entry must not be accessed afterwards.
+
+\param  pInstance_p             Pointer to the ring instance.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+void shmring_releaseData(tShmRingInstance* pInstance_p)
+{
+    UINT32              entryOffset;
+    UINT32              size;
+    UINT32              readOffset;
+
+    if (getEntry(pInstance_p, &entryOffset, &size) != kShmRingOk)
+        return;
+
+    readOffset = entryOffset + SHMRING_ALIGN(SHMRING_ENTRY_HEADER_SIZE + size);
+    if (readOffset == pInstance_p->dataSize)
+        readOffset = 0;
+
+    // the entry has to be completely read before it is released to the producer
+    SHMRING_MB();
+    pInstance_p->pHeader->readOffset = readOffset;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a ring is empty
+
+\param  pInstance_p             Pointer to the ring instance.
+
+\return The function returns TRUE if the ring contains no entry.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+BOOL shmring_isEmpty(tShmRingInstance* pInstance_p)
+{
+    return (pInstance_p->pHeader->readOffset == pInstance_p->pHeader->writeOffset);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Mark a signal of the consumer as pending
+
+The function is called by the producer after writing entries. It sets the
+signal pending flag of the ring.
+
+\param  pInstance_p             Pointer to the ring instance.
+
+\return The function returns TRUE if the flag was not set before, i.e. the
+        producer has to signal the consumer.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+BOOL shmring_setSignalPending(tShmRingInstance* pInstance_p)
+{
+    // the written entries have to be visible before the flag is set
+    SHMRING_MB();
+    return (SHMRING_XCHG(&pInstance_p->pHeader->signalPending, 1) == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear the signal pending flag
+
+The function is called by the consumer before it reads the available entries.
+Entries written after the flag was cleared will be signaled again.
+
+\param  pInstance_p             Pointer to the ring instance.
+
+\ingroup module_lib_shmring
+*/
+//------------------------------------------------------------------------------
+void shmring_clearSignalPending(tShmRingInstance* pInstance_p)
+{
+    SHMRING_XCHG(&pInstance_p->pHeader->signalPending, 0);
+    SHMRING_MB();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Locate the oldest entry of a ring
+
+The function determines the offset and size of the oldest entry of a ring and
+skips a wrap marker.
+
+\param  pInstance_p             Pointer to the ring instance.
+\param  pOffset_p               Pointer to store the offset of the entry.
+\param  pSize_p                 Pointer to store the data size of the entry.
+
+\return The function returns a tShmRingError error code.
+*/
+//------------------------------------------------------------------------------
+static tShmRingError getEntry(tShmRingInstance* pInstance_p, UINT32* pOffset_p,
+                              UINT32* pSize_p)
+{
+    UINT32              dataSize = pInstance_p->dataSize;
+    UINT32              readOffset;
+    UINT32              writeOffset;
+    UINT32              size;
+
+    readOffset = pInstance_p->pHeader->readOffset;
+    writeOffset = pInstance_p->pHeader->writeOffset;
+    // the entries have to be read after the write offset
+    SHMRING_MB();
+
+    if (readOffset == writeOffset)
+        return kShmRingNoReadableData;
+
+    if ((readOffset >= dataSize) || (writeOffset >= dataSize))
+        return kShmRingCorrupted;
+
+    size = *(UINT32*)(pInstance_p->pData + readOffset);
+    if (size == SHMRING_WRAP_MARKER)
+    {
+        readOffset = 0;
+        if (readOffset == writeOffset)
+            return kShmRingCorrupted;
+        size = *(UINT32*)pInstance_p->pData;
+    }
+
+    if ((size > dataSize) ||
+        (SHMRING_ALIGN(SHMRING_ENTRY_HEADER_SIZE + size) > dataSize - readOffset))
+        return kShmRingCorrupted;
+
+    *pOffset_p = readOffset;
+    *pSize_p = size;
+
+    return kShmRingOk;
+}
+
+/// \}
@@ -0,0 +1,123 @@
+/**
+********************************************************************************
+\file   shmring.h
+
+\brief  Definitions for shared memory ring library
+
+This file contains the definitions for the shared memory ring library.
+*******************************************************************************/
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_shmring_H_
+#define _INC_shmring_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SHMRING_MAGIC                   0x474E5253      ///< Magic of an initialized ring ("SRNG")
+#define SHMRING_BLOCK_ALIGNMENT         8               ///< Alignment of the entries in the data area
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+typedef enum
+{
+    kShmRingOk                          =  0,
+    kShmRingNoReadableData              =  1,
+    kShmRingReadsizeTooSmall            =  2,
+    kShmRingBufferFull                  =  3,
+    kShmRingInvalidArg                  =  9,
+    kShmRingCorrupted                   = 10,
+    kShmRingExceedDataSizeLimit         = 14
+} tShmRingError;
+
+/**
+\brief Header of a shared memory ring
+
+The header is located at the beginning of the memory block of a ring and is
+followed by the data area. It contains only fixed size members, therefore the
+layout is identical for all processors accessing the memory (e.g. a 64 bit
+kernel and a 32 bit user application). The offsets written by the producer and
+by the consumer are placed in separate cache lines.
+*/
+typedef struct
+{
+    UINT32              magic;              ///< Magic of an initialized ring
+    UINT32              dataSize;           ///< Size of the data area following the header
+    UINT32              signalPending;      ///< Set by the producer if the consumer has to be signaled
+    UINT32              aReserved1[13];
+    volatile UINT32     writeOffset;        ///< Offset of the next entry to write, only changed by the producer
+    UINT32              aReserved2[15];
+    volatile UINT32     readOffset;         ///< Offset of the next entry to read, only changed by the consumer
+    UINT32              aReserved3[15];
+} tShmRingHeader;
+
+/**
+\brief Shared memory ring instance
+
+The structure describes the view of one side (producer or consumer) on a ring.
+*/
+typedef struct
+{
+    tShmRingHeader*     pHeader;            ///< Pointer to the header of the ring
+    BYTE*               pData;              ///< Pointer to the data area of the ring
+    UINT32              dataSize;           ///< Size of the data area
+} tShmRingInstance;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+tShmRingError shmring_init(tShmRingInstance* pInstance_p, void* pMem_p, size_t memSize_p);
+tShmRingError shmring_connect(tShmRingInstance* pInstance_p, void* pMem_p, size_t memSize_p);
+void          shmring_reset(tShmRingInstance* pInstance_p);
+tShmRingError shmring_writeData(tShmRingInstance* pInstance_p, const void* pData_p, size_t size_p);
+tShmRingError shmring_writeMultipleData(tShmRingInstance* pInstance_p, const void* pData_p, size_t size_p,
+                                        const void* pData2_p, size_t size2_p);
+tShmRingError shmring_readData(tShmRingInstance* pInstance_p, void* pData_p,
+                               size_t size_p, size_t* pDataBlockSize_p);
+tShmRingError shmring_peekData(tShmRingInstance* pInstance_p, void** ppData_p, size_t* pDataBlockSize_p);
+void          shmring_releaseData(tShmRingInstance* pInstance_p);
+BOOL          shmring_isEmpty(tShmRingInstance* pInstance_p);
+BOOL          shmring_setSignalPending(tShmRingInstance* pInstance_p);
+void          shmring_clearSignalPending(tShmRingInstance* pInstance_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_shmring_H_ */
@@ -0,0 +1,1001 @@
+/**
+********************************************************************************
+\file   trace-ring.c
+
+\brief  Trace function using per-thread binary rings
+
+The trace function doesn't format the message. It only records a time stamp,
+the pointer of the format string and the arguments in a ring of the calling
+thread. Each thread owns its own ring, therefore the trace function needs no
+lock and only the calling thread writes to the ring. A reader thread drains
+the rings periodically, formats the messages in the order of their time stamps
+and writes them to the output stream (stderr by default).
+
+String arguments are copied into the ring entry, all other arguments are
+stored by value. Therefore the format string must be a string constant, which
+is true for all trace messages of the stack. If a ring is full, the message is
+dropped and counted.
+
+\ingroup module_lib_trace
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "trace-ring.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#if ((TRACE_RING_ENTRY_COUNT & (TRACE_RING_ENTRY_COUNT - 1)) != 0)
+#error "TRACE_RING_ENTRY_COUNT must be a power of 2!"
+#endif
+
+#define TRACE_RING_INDEX_MASK           (TRACE_RING_ENTRY_COUNT - 1)
+#define TRACE_RING_MAX_SPEC_SIZE        64      // size of a rebuilt conversion specification
+#define TRACE_RING_MAX_MESSAGE_SIZE     1024    // size of a formatted message
+
+#if defined(__GNUC__)
+#define TRACE_RING_MB()                 __sync_synchronize()
+#else
+#error "Memory barriers are not defined for this target!"
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Argument types of conversion specifications
+*/
+typedef enum
+{
+    kTraceArgNone = 0,                      ///< No argument ("%%" or invalid specification)
+    kTraceArgInt,                           ///< int (also char and short, which are promoted)
+    kTraceArgLong,                          ///< long
+    kTraceArgLongLong,                      ///< long long
+    kTraceArgIntMax,                        ///< intmax_t
+    kTraceArgSize,                          ///< size_t
+    kTraceArgPtrDiff,                       ///< ptrdiff_t
+    kTraceArgPointer,                       ///< void*
+    kTraceArgDouble,                        ///< double
+    kTraceArgLongDouble,                    ///< long double
+    kTraceArgString,                        ///< char*, copied into the entry
+    kTraceArgSkip                           ///< Unsupported pointer argument, not printed
+} tTraceArgType;
+
+/**
+\brief  Parsed conversion specification
+*/
+typedef struct
+{
+    tTraceArgType       argType;            ///< Type of the argument
+    UINT                starCount;          ///< Number of int arguments for '*' width and precision
+    char                conversion;         ///< Conversion character
+} tTraceSpec;
+
+/**
+\brief  Trace ring of a thread
+
+Only the owning thread writes entries and the write index, only the reader
+changes the read index. The indices are placed in separate cache lines.
+*/
+typedef struct sTraceRing
+{
+    struct sTraceRing*  pNext;              ///< Next ring in the list of rings
+    volatile BOOL       fOrphaned;          ///< The owning thread has terminated
+    volatile ULONG      dropCount;          ///< Number of dropped messages, only changed by the owner
+    BYTE                abReserved1[64];
+    volatile UINT32     writeIndex;         ///< Index of the next entry to write
+    BYTE                abReserved2[64];
+    volatile UINT32     readIndex;          ///< Index of the next entry to read
+    BYTE                abReserved3[64];
+    tTraceRingEntry     aEntry[TRACE_RING_ENTRY_COUNT];
+} tTraceRing;
+
+/**
+\brief  Output buffer of the formatter
+*/
+typedef struct
+{
+    char*               pszBuffer;          ///< Buffer for the formatted message
+    size_t              size;               ///< Size of the buffer
+    size_t              len;                ///< Current length of the message
+} tTraceOutput;
+
+/**
+\brief  Instance of the trace ring library
+*/
+typedef struct
+{
+    BOOL                fInitialized;       ///< The library is initialized
+    pthread_key_t       threadKey;          ///< Key of the ring of a thread
+    pthread_mutex_t     listMutex;          ///< Protects the modification of the ring list
+    pthread_mutex_t     drainMutex;         ///< Serializes the readers
+    tTraceRing* volatile pFirstRing;        ///< List of rings
+    FILE*               pOutput;            ///< Output stream of the formatted messages
+    ULONG               freedDropCount;     ///< Dropped messages of freed rings
+    ULONG               reportedDropCount;  ///< Dropped messages already reported in the output
+} tTraceRingInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static pthread_once_t       initOnce_l = PTHREAD_ONCE_INIT;
+static tTraceRingInstance   instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void         initTraceRing(void);
+static BOOL         ensureInit(void);
+static tTraceRing*  getThreadRing(void);
+static void         releaseThreadRing(void* pRing_p);
+static void*        readerThread(void* pArg_p);
+static void         drainRings(void);
+static void         freeOrphanedRings(void);
+static void         recordArgs(tTraceRingEntry* pEntry_p, const char* pszFormat_p, va_list argList_p);
+static const char*  parseSpec(const char* pszSpec_p, tTraceSpec* pSpec_p);
+static void         appendText(tTraceOutput* pOutput_p, const char* pszFormat_p, ...);
+static void         appendArg(tTraceOutput* pOutput_p, const char* pszSpec_p,
+                              tTraceArgType argType_p, const tTraceRingEntry* pEntry_p,
+                              const tTraceRingArg* pArg_p);
+static UINT64       getTimeNs(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record debug trace message
+
+The function records a debug trace message in the ring of the calling thread.
+The ring is created on the first call of a thread.
+
+\param  fmt         Format string
+\param  ...         Arguments to print
+*/
+//------------------------------------------------------------------------------
+void trace (const char *fmt, ...)
+{
+    tTraceRing*         pRing;
+    tTraceRingEntry*    pEntry;
+    UINT32              writeIndex;
+    va_list             argptr;
+
+    pRing = getThreadRing();
+    if (pRing == NULL)
+        return;
+
+    writeIndex = pRing->writeIndex;
+    if ((writeIndex - pRing->readIndex) >= TRACE_RING_ENTRY_COUNT)
+    {
+        pRing->dropCount++;
+        return;
+    }
+
+    pEntry = &pRing->aEntry[writeIndex & TRACE_RING_INDEX_MASK];
+    pEntry->timeStamp = getTimeNs();
+    pEntry->pszFormat = fmt;
+
+    va_start(argptr, fmt);
+    recordArgs(pEntry, fmt, argptr);
+    va_end(argptr);
+
+    // entry must be complete before it is visible to the reader
+    TRACE_RING_MB();
+    pRing->writeIndex = writeIndex + 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set output stream
+
+The function sets the stream the reader writes the formatted messages to.
+
+\param  pOutput_p           Output stream.
+
+\ingroup module_lib_trace
+*/
+//------------------------------------------------------------------------------
+void tracering_setOutput(FILE* pOutput_p)
+{
+    if (!ensureInit())
+        return;
+
+    pthread_mutex_lock(&instance_l.drainMutex);
+    instance_l.pOutput = pOutput_p;
+    pthread_mutex_unlock(&instance_l.drainMutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Flush trace rings
+
+The function formats all recorded messages of all threads and writes them to
+the output stream. It is called periodically by the reader thread and at
+process exit, but it can also be called by the application.
+
+\ingroup module_lib_trace
+*/
+//------------------------------------------------------------------------------
+void tracering_flush(void)
+{
+    if (!ensureInit())
+        return;
+
+    pthread_mutex_lock(&instance_l.drainMutex);
+    drainRings();
+    pthread_mutex_unlock(&instance_l.drainMutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get number of dropped messages
+
+\return The function returns the number of messages which were dropped because
+        the ring of the thread was full.
+
+\ingroup module_lib_trace
+*/
+//------------------------------------------------------------------------------
+ULONG tracering_getDropCount(void)
+{
+    tTraceRing*     pRing;
+    ULONG           dropCount;
+
+    if (!ensureInit())
+        return 0;
+
+    pthread_mutex_lock(&instance_l.listMutex);
+    dropCount = instance_l.freedDropCount;
+    for (pRing = instance_l.pFirstRing; pRing != NULL; pRing = pRing->pNext)
+    {
+        dropCount += pRing->dropCount;
+    }
+    pthread_mutex_unlock(&instance_l.listMutex);
+
+    return dropCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Format trace ring entry
+
+The function formats the message of a trace ring entry. Conversion
+specifications without recorded argument are copied unchanged. The message is
+truncated if the buffer is too small.
+
+\param  pEntry_p            Pointer to the trace ring entry.
+\param  pszBuffer_p         Buffer for the formatted message.
+\param  size_p              Size of the buffer.
+
+\return The function returns the length of the formatted message.
+
+\ingroup module_lib_trace
+*/
+//------------------------------------------------------------------------------
+int tracering_formatEntry(const tTraceRingEntry* pEntry_p, char* pszBuffer_p, size_t size_p)
+{
+    tTraceOutput    output;
+    tTraceSpec      spec;
+    const char*     pszFormat = pEntry_p->pszFormat;
+    const char*     pszSpecStart;
+    char            szSpec[TRACE_RING_MAX_SPEC_SIZE];
+    size_t          specLen;
+    UINT            argIndex = 0;
+
+    if (size_p == 0)
+        return 0;
+
+    output.pszBuffer = pszBuffer_p;
+    output.size = size_p;
+    output.len = 0;
+    pszBuffer_p[0] = '\0';
+
+    while (*pszFormat != '\0')
+    {
+        if (*pszFormat != '%')
+        {
+            specLen = strcspn(pszFormat, "%");
+            appendText(&output, "%.*s", (int)specLen, pszFormat);
+            pszFormat += specLen;
+            continue;
+        }
+
+        pszSpecStart = pszFormat;
+        pszFormat = parseSpec(pszFormat + 1, &spec);
+        specLen = pszFormat - pszSpecStart;
+
+        if ((spec.argType == kTraceArgNone) ||
+            ((argIndex + spec.starCount) >= pEntry_p->argCount) ||
+            (specLen >= (TRACE_RING_MAX_SPEC_SIZE - (spec.starCount * 12))))
+        {   // no argument was recorded for this specification
+            if (spec.conversion == '%')
+                appendText(&output, "%%");
+            else
+                appendText(&output, "%.*s", (int)specLen, pszSpecStart);
+            continue;
+        }
+
+        // rebuild the specification with the recorded '*' arguments
+        specLen = 0;
+        for (; pszSpecStart < pszFormat; pszSpecStart++)
+        {
+            if (*pszSpecStart == '*')
+            {
+                specLen += sprintf(&szSpec[specLen], "%d", (int)pEntry_p->aArg[argIndex].value);
+                argIndex++;
+            }
+            else
+            {
+                szSpec[specLen++] = *pszSpecStart;
+            }
+        }
+        szSpec[specLen] = '\0';
+
+        appendArg(&output, szSpec, spec.argType, pEntry_p, &pEntry_p->aArg[argIndex]);
+        argIndex++;
+    }
+
+    return (int)output.len;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize trace ring library
+
+The function creates the key of the thread rings and starts the reader thread.
+It is called once by the first user of the library.
+*/
+//------------------------------------------------------------------------------
+static void initTraceRing(void)
+{
+    pthread_t       thread;
+
+    instance_l.pOutput = stderr;
+
+    if (pthread_key_create(&instance_l.threadKey, releaseThreadRing) != 0)
+        return;
+
+    pthread_mutex_init(&instance_l.listMutex, NULL);
+    pthread_mutex_init(&instance_l.drainMutex, NULL);
+
+    if (pthread_create(&thread, NULL, readerThread, NULL) == 0)
+        pthread_detach(thread);
+
+    instance_l.fInitialized = TRUE;
+
+    // messages recorded before the process terminates shall not get lost
+    atexit(tracering_flush);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize trace ring library if necessary
+
+\return The function returns TRUE if the library is initialized.
+*/
+//------------------------------------------------------------------------------
+static BOOL ensureInit(void)
+{
+    pthread_once(&initOnce_l, initTraceRing);
+    return instance_l.fInitialized;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get ring of the calling thread
+
+The function returns the ring of the calling thread. If the thread has no ring
+yet, a ring is allocated and inserted in the list of rings.
+
+\return The function returns a pointer to the ring or NULL if no ring could be
+        allocated.
+*/
+//------------------------------------------------------------------------------
+static tTraceRing* getThreadRing(void)
+{
+    tTraceRing*     pRing;
+
+    if (!ensureInit())
+        return NULL;
+
+    pRing = (tTraceRing*)pthread_getspecific(instance_l.threadKey);
+    if (pRing != NULL)
+        return pRing;
+
+    pRing = (tTraceRing*)EPL_MALLOC(sizeof(tTraceRing));
+    if (pRing == NULL)
+        return NULL;
+
+    EPL_MEMSET(pRing, 0, sizeof(tTraceRing));
+    if (pthread_setspecific(instance_l.threadKey, pRing) != 0)
+    {
+        EPL_FREE(pRing);
+        return NULL;
+    }
+
+    // the reader walks the list without lock, so the ring must be complete
+    // before it is inserted
+    pthread_mutex_lock(&instance_l.listMutex);
+    pRing->pNext = instance_l.pFirstRing;
+    TRACE_RING_MB();
+    instance_l.pFirstRing = pRing;
+    pthread_mutex_unlock(&instance_l.listMutex);
+
+    return pRing;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release ring of a terminated thread
+
+The function is called when a thread terminates. It marks the ring of the
+thread as orphaned, it is freed by the reader after its entries are drained.
+
+\param  pRing_p             Pointer to the ring of the thread.
+*/
+//------------------------------------------------------------------------------
+static void releaseThreadRing(void* pRing_p)
+{
+    TRACE_RING_MB();
+    ((tTraceRing*)pRing_p)->fOrphaned = TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reader thread
+
+The thread drains the rings periodically.
+
+\param  pArg_p              Thread argument (unused).
+
+\return The function returns always NULL.
+*/
+//------------------------------------------------------------------------------
+static void* readerThread(void* pArg_p)
+{
+    struct timespec     interval;
+
+    UNUSED_PARAMETER(pArg_p);
+
+    interval.tv_sec = TRACE_RING_DRAIN_INTERVAL_MS / 1000;
+    interval.tv_nsec = (TRACE_RING_DRAIN_INTERVAL_MS % 1000) * 1000000L;
+
+    for (;;)
+    {
+        nanosleep(&interval, NULL);
+        tracering_flush();
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Drain all rings
+
+The function formats the recorded messages of all rings in the order of their
+time stamps and writes them to the output stream. The drain mutex must be
+locked.
+*/
+//------------------------------------------------------------------------------
+static void drainRings(void)
+{
+    tTraceRing*         pRing;
+    tTraceRing*         pOldestRing;
+    tTraceRingEntry*    pEntry;
+    tTraceRingEntry*    pOldestEntry;
+    char                szMessage[TRACE_RING_MAX_MESSAGE_SIZE];
+    ULONG               dropCount;
+    BOOL                fWritten = FALSE;
+
+    for (;;)
+    {
+        pOldestRing = NULL;
+        pOldestEntry = NULL;
+        for (pRing = instance_l.pFirstRing; pRing != NULL; pRing = pRing->pNext)
+        {
+            if (pRing->readIndex == pRing->writeIndex)
+                continue;
+
+            // read the entry only after the write index
+            TRACE_RING_MB();
+            pEntry = &pRing->aEntry[pRing->readIndex & TRACE_RING_INDEX_MASK];
+            if ((pOldestEntry == NULL) || (pEntry->timeStamp < pOldestEntry->timeStamp))
+            {
+                pOldestRing = pRing;
+                pOldestEntry = pEntry;
+            }
+        }
+
+        if (pOldestRing == NULL)
+            break;
+
+        tracering_formatEntry(pOldestEntry, szMessage, sizeof(szMessage));
+        fputs(szMessage, instance_l.pOutput);
+        fWritten = TRUE;
+
+        // the entry must be read completely before it is released
+        TRACE_RING_MB();
+        pOldestRing->readIndex++;
+    }
+
+    freeOrphanedRings();
+
+    dropCount = tracering_getDropCount();
+    if (dropCount != instance_l.reportedDropCount)
+    {
+        fprintf(instance_l.pOutput, "trace: %lu messages dropped\n",
+                dropCount - instance_l.reportedDropCount);
+        instance_l.reportedDropCount = dropCount;
+        fWritten = TRUE;
+    }
+
+    if (fWritten)
+        fflush(instance_l.pOutput);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free orphaned rings
+
+The function frees all empty rings of terminated threads. The drain mutex must
+be locked.
+*/
+//------------------------------------------------------------------------------
+static void freeOrphanedRings(void)
+{
+    tTraceRing**    ppRing;
+    tTraceRing*     pRing;
+
+    pthread_mutex_lock(&instance_l.listMutex);
+    ppRing = (tTraceRing**)&instance_l.pFirstRing;
+    while (*ppRing != NULL)
+    {
+        pRing = *ppRing;
+        if (pRing->fOrphaned && (pRing->readIndex == pRing->writeIndex))
+        {
+            *ppRing = pRing->pNext;
+            instance_l.freedDropCount += pRing->dropCount;
+            EPL_FREE(pRing);
+        }
+        else
+        {
+            ppRing = &pRing->pNext;
+        }
+    }
+    pthread_mutex_unlock(&instance_l.listMutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record arguments of a message
+
+The function parses the format string and stores the arguments in the entry.
+Strings are copied into the string area of the entry and truncated if it is
+full. If the message has more than TRACE_RING_MAX_ARGS arguments, the
+remaining ones are not recorded.
+
+\param  pEntry_p            Pointer to the entry.
+\param  pszFormat_p         Format string of the message.
+\param  argList_p           Arguments of the message.
+*/
+//------------------------------------------------------------------------------
+static void recordArgs(tTraceRingEntry* pEntry_p, const char* pszFormat_p, va_list argList_p)
+{
+    tTraceSpec      spec;
+    tTraceRingArg*  pArg;
+    const char*     pszFormat = pszFormat_p;
+    const char*     pszString;
+    UINT            argCount = 0;
+    UINT            stringSize = 0;
+    size_t          len;
+    UINT            i;
+
+    while ((pszFormat = strchr(pszFormat, '%')) != NULL)
+    {
+        pszFormat = parseSpec(pszFormat + 1, &spec);
+        if (spec.argType == kTraceArgNone)
+            continue;
+
+        if ((argCount + spec.starCount) >= TRACE_RING_MAX_ARGS)
+            break;
+
+        for (i = 0; i < spec.starCount; i++)
+        {
+            pEntry_p->aArg[argCount++].value = (UINT64)(INT64)va_arg(argList_p, int);
+        }
+
+        pArg = &pEntry_p->aArg[argCount++];
+        switch (spec.argType)
+        {
+            case kTraceArgInt:
+                pArg->value = (UINT64)(INT64)va_arg(argList_p, int);
+                break;
+
+            case kTraceArgLong:
+                pArg->value = (UINT64)(INT64)va_arg(argList_p, long);
+                break;
+
+            case kTraceArgLongLong:
+                pArg->value = (UINT64)va_arg(argList_p, long long);
+                break;
+
+            case kTraceArgIntMax:
+                pArg->value = (UINT64)va_arg(argList_p, intmax_t);
+                break;
+
+            case kTraceArgSize:
+                pArg->value = (UINT64)va_arg(argList_p, size_t);
+                break;
+
+            case kTraceArgPtrDiff:
+                pArg->value = (UINT64)va_arg(argList_p, ptrdiff_t);
+                break;
+
+            case kTraceArgDouble:
+                pArg->fValue = va_arg(argList_p, double);
+                break;
+
+            case kTraceArgLongDouble:
+                pArg->fValue = (double)va_arg(argList_p, long double);
+                break;
+
+            case kTraceArgString:
+                pszString = va_arg(argList_p, const char*);
+                if (pszString == NULL)
+                    pszString = "(null)";
+
+                if (stringSize >= TRACE_RING_STRING_SIZE)
+                {   // string area is full, use the terminator of the last string
+                    pArg->value = TRACE_RING_STRING_SIZE - 1;
+                    break;
+                }
+
+                len = strnlen(pszString, TRACE_RING_STRING_SIZE - stringSize - 1);
+                EPL_MEMCPY(&pEntry_p->achStrings[stringSize], pszString, len);
+                pEntry_p->achStrings[stringSize + len] = '\0';
+                pArg->value = stringSize;
+                stringSize += len + 1;
+                break;
+
+            case kTraceArgPointer:
+            case kTraceArgSkip:
+            default:
+                pArg->value = (UINT64)(size_t)va_arg(argList_p, void*);
+                break;
+        }
+    }
+
+    pEntry_p->argCount = argCount;
+    pEntry_p->stringSize = stringSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse conversion specification
+
+The function parses a printf() conversion specification and determines the
+type of its argument.
+
+\param  pszSpec_p           Pointer to the character following the '%'.
+\param  pSpec_p             Pointer to store the parsed specification.
+
+\return The function returns a pointer to the character following the
+        specification.
+*/
+//------------------------------------------------------------------------------
+static const char* parseSpec(const char* pszSpec_p, tTraceSpec* pSpec_p)
+{
+    tTraceArgType   intType = kTraceArgInt;
+    BOOL            fLongDouble = FALSE;
+    BOOL            fLong = FALSE;
+
+    pSpec_p->argType = kTraceArgNone;
+    pSpec_p->starCount = 0;
+    pSpec_p->conversion = '\0';
+
+    // flags
+    while ((*pszSpec_p != '\0') && (strchr("-+ #0'", *pszSpec_p) != NULL))
+        pszSpec_p++;
+
+    // width
+    if (*pszSpec_p == '*')
+    {
+        pSpec_p->starCount++;
+        pszSpec_p++;
+    }
+    while ((*pszSpec_p >= '0') && (*pszSpec_p <= '9'))
+        pszSpec_p++;
+
+    // precision
+    if (*pszSpec_p == '.')
+    {
+        pszSpec_p++;
+        if (*pszSpec_p == '*')
+        {
+            pSpec_p->starCount++;
+            pszSpec_p++;
+        }
+        while ((*pszSpec_p >= '0') && (*pszSpec_p <= '9'))
+            pszSpec_p++;
+    }
+
+    // length modifier
+    switch (*pszSpec_p)
+    {
+        case 'h':
+            pszSpec_p++;
+            if (*pszSpec_p == 'h')
+                pszSpec_p++;
+            break;
+
+        case 'l':
+            pszSpec_p++;
+            if (*pszSpec_p == 'l')
+            {
+                pszSpec_p++;
+                intType = kTraceArgLongLong;
+            }
+            else
+            {
+                intType = kTraceArgLong;
+                fLong = TRUE;
+            }
+            break;
+
+        case 'q':
+            pszSpec_p++;
+            intType = kTraceArgLongLong;
+            break;
+
+        case 'L':
+            pszSpec_p++;
+            intType = kTraceArgLongLong;
+            fLongDouble = TRUE;
+            break;
+
+        case 'j':
+            pszSpec_p++;
+            intType = kTraceArgIntMax;
+            break;
+
+        case 'z':
+            pszSpec_p++;
+            intType = kTraceArgSize;
+            break;
+
+        case 't':
+            pszSpec_p++;
+            intType = kTraceArgPtrDiff;
+            break;
+
+        default:
+            break;
+    }
+
+    pSpec_p->conversion = *pszSpec_p;
+    if (*pszSpec_p == '\0')
+    {   // incomplete specification at the end of the format string
+        pSpec_p->starCount = 0;
+        return pszSpec_p;
+    }
+    pszSpec_p++;
+
+    switch (pSpec_p->conversion)
+    {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            pSpec_p->argType = intType;
+            break;
+
+        case 'c':
+            // wint_t is promoted like int
+            pSpec_p->argType = kTraceArgInt;
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            pSpec_p->argType = fLongDouble ? kTraceArgLongDouble : kTraceArgDouble;
+            break;
+
+        case 's':
+            // wide strings are not supported
+            pSpec_p->argType = fLong ? kTraceArgSkip : kTraceArgString;
+            break;
+
+        case 'p':
+            pSpec_p->argType = kTraceArgPointer;
+            break;
+
+        case 'n':
+            pSpec_p->argType = kTraceArgSkip;
+            break;
+
+        default:
+            // "%%" or invalid conversion, no argument is consumed
+            pSpec_p->starCount = 0;
+            break;
+    }
+
+    return pszSpec_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Append text to formatted message
+
+\param  pOutput_p           Pointer to the output buffer.
+\param  pszFormat_p         printf() format string of the text.
+*/
+//------------------------------------------------------------------------------
+static void appendText(tTraceOutput* pOutput_p, const char* pszFormat_p, ...)
+{
+    va_list     argList;
+    int         len;
+
+    if (pOutput_p->len >= (pOutput_p->size - 1))
+        return;
+
+    va_start(argList, pszFormat_p);
+    len = vsnprintf(pOutput_p->pszBuffer + pOutput_p->len,
+                    pOutput_p->size - pOutput_p->len, pszFormat_p, argList);
+    va_end(argList);
+
+    if (len < 0)
+        return;
+
+    pOutput_p->len += len;
+    if (pOutput_p->len >= pOutput_p->size)
+        pOutput_p->len = pOutput_p->size - 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Append argument to formatted message
+
+\param  pOutput_p           Pointer to the output buffer.
+\param  pszSpec_p           Conversion specification of the argument.
+\param  argType_p           Type of the argument.
+\param  pEntry_p            Pointer to the trace ring entry.
+\param  pArg_p              Pointer to the recorded argument.
+*/
+//------------------------------------------------------------------------------
+static void appendArg(tTraceOutput* pOutput_p, const char* pszSpec_p,
+                      tTraceArgType argType_p, const tTraceRingEntry* pEntry_p,
+                      const tTraceRingArg* pArg_p)
+{
+    switch (argType_p)
+    {
+        case kTraceArgInt:
+            appendText(pOutput_p, pszSpec_p, (int)pArg_p->value);
+            break;
+
+        case kTraceArgLong:
+            appendText(pOutput_p, pszSpec_p, (long)pArg_p->value);
+            break;
+
+        case kTraceArgLongLong:
+            appendText(pOutput_p, pszSpec_p, (long long)pArg_p->value);
+            break;
+
+        case kTraceArgIntMax:
+            appendText(pOutput_p, pszSpec_p, (intmax_t)pArg_p->value);
+            break;
+
+        case kTraceArgSize:
+            appendText(pOutput_p, pszSpec_p, (size_t)pArg_p->value);
+            break;
+
+        case kTraceArgPtrDiff:
+            appendText(pOutput_p, pszSpec_p, (ptrdiff_t)pArg_p->value);
+            break;
+
+        case kTraceArgPointer:
+            appendText(pOutput_p, pszSpec_p, (void*)(size_t)pArg_p->value);
+            break;
+
+        case kTraceArgDouble:
+            appendText(pOutput_p, pszSpec_p, pArg_p->fValue);
+            break;
+
+        case kTraceArgLongDouble:
+            appendText(pOutput_p, pszSpec_p, (long double)pArg_p->fValue);
+            break;
+
+        case kTraceArgString:
+            appendText(pOutput_p, pszSpec_p, &pEntry_p->achStrings[pArg_p->value]);
+            break;
+
+        case kTraceArgSkip:
+        default:
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
@@ -0,0 +1,110 @@
+/**
+********************************************************************************
+\file   trace-ring.h
+
+\brief  Definitions for trace ring library
+
+This file contains the definitions for the trace ring library which records
+debug trace messages in binary form.
+*******************************************************************************/
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_trace_ring_H_
+#define _INC_trace_ring_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+
+#include <EplInc.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef TRACE_RING_ENTRY_COUNT
+#define TRACE_RING_ENTRY_COUNT          256     ///< Number of entries of a ring (power of 2)
+#endif
+
+#ifndef TRACE_RING_DRAIN_INTERVAL_MS
+#define TRACE_RING_DRAIN_INTERVAL_MS    10      ///< Interval in which the reader thread drains the rings
+#endif
+
+#define TRACE_RING_MAX_ARGS             12      ///< Maximum number of arguments of a message
+#define TRACE_RING_STRING_SIZE          136     ///< Size of the string area of an entry
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  Argument of a trace message
+
+String arguments are stored as offset into the string area of the entry.
+*/
+typedef union
+{
+    UINT64              value;              ///< Integer, pointer or string offset
+    double              fValue;             ///< Floating point value
+} tTraceRingArg;
+
+/**
+\brief  Trace ring entry
+
+The entry contains a trace message in binary form. It is formatted by the
+reader with the format string and the recorded arguments.
+*/
+typedef struct
+{
+    UINT64              timeStamp;                          ///< CLOCK_MONOTONIC time of the message in ns
+    const char*         pszFormat;                          ///< Format string of the message
+    UINT32              argCount;                           ///< Number of recorded arguments
+    UINT32              stringSize;                         ///< Used size of the string area
+    tTraceRingArg       aArg[TRACE_RING_MAX_ARGS];          ///< Arguments of the message
+    char                achStrings[TRACE_RING_STRING_SIZE]; ///< Copies of the string arguments
+} tTraceRingEntry;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void  trace(const char* fmt, ...);
+void  tracering_setOutput(FILE* pOutput_p);
+void  tracering_flush(void);
+ULONG tracering_getDropCount(void);
+int   tracering_formatEntry(const tTraceRingEntry* pEntry_p, char* pszBuffer_p, size_t size_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_trace_ring_H_ */
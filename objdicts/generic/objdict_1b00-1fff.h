@@ -91,7 +91,7 @@ area from 0x1B00 - 0x1FFF.
 
 #if EPL_NMT_MAX_NODE_ID > 0
         // Object 1F81h: NMT_NodeAssignment_AU32
-        OBD_RAM_INDEX_RAM_ARRAY(0x1F81, EPL_NMT_MAX_NODE_ID, NULL, kObdTypeUInt32, kObdAccSRW, tObdUnsigned32, NMT_NodeAssignment_AU32, 0)
+        OBD_RAM_INDEX_RAM_ARRAY(0x1F81, EPL_NMT_MAX_NODE_ID, ctrlu_cbObdAccess, kObdTypeUInt32, kObdAccSRW, tObdUnsigned32, NMT_NodeAssignment_AU32, 0)
 #endif
 
         // Object 1F82h: NMT_FeatureFlags_U32
@@ -48,6 +48,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <linux/errno.h>
 #include <linux/version.h>
 #include <linux/mm.h>
+#include <linux/mutex.h>
 #include <asm/page.h>
 #include <asm/uaccess.h>
 #include <asm/page.h>
@@ -66,6 +67,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/eventk.h>
 #include <kernel/eventkcal.h>
 #include <errhndkcal.h>
+#include <shmring.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -114,9 +116,25 @@ atomic_t                openCount_g;
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief Asynchronous TX frame ring
+
+The structure contains the ring which is mapped into the user application for
+transferring asynchronous frames to the DLL without copying them through the
+ioctl interface.
+*/
+typedef struct
+{
+    BYTE*               pMem;               ///< Memory of the ring
+    BYTE*               pFrameBuf;          ///< Kernel copy of the current frame
+    tShmRingInstance    ring;               ///< Ring instance (consumer side)
+    struct mutex        mutex;              ///< Serializes concurrent signal ioctls
+} tAsyncRing;
+
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static tAsyncRing       asyncRing_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -145,6 +163,9 @@ static int      storeInitParam(unsigned long arg);
 static int      getStatus(unsigned long arg);
 static int      getHeartbeat(unsigned long arg);
 static int      sendAsyncFrame(unsigned long arg);
+static int      processAsyncRing(void);
+static int      initAsyncRing(void);
+static void     exitAsyncRing(void);
 static int      writeErrorObject(unsigned long arg);
 static int      readErrorObject(unsigned long arg);
 
@@ -284,6 +305,12 @@ static int powerlinkOpen(struct inode* pDeviceFile_p, struct file* pInstance_p)
         return -EIO;
     }
 
+    if (initAsyncRing() != 0)
+    {
+        ctrlk_exit();
+        return -ENOMEM;
+    }
+
     startHeartbeatTimer(20);
 
     EPL_DBGLVL_ALWAYS_TRACE("PLK: + powerlinkOpen - OK\n");
@@ -306,6 +333,7 @@ static int  powerlinkRelease (struct inode* pDeviceFile_p, struct file* pInstanc
 
     stopHeartbeatTimer();
     ctrlk_exit();
+    exitAsyncRing();
     atomic_dec(&openCount_g);
     EPL_DBGLVL_ALWAYS_TRACE("PLK: + powerlinkRelease - OK\n");
     return 0;
@@ -406,14 +434,18 @@ static int  powerlinkIoctl (struct inode* dev, struct file* filp,
             ret = eventkcal_postEventFromUser(arg);
             break;
 
-        case PLK_CMD_GET_EVENT:
-            ret = eventkcal_getEventForUser(arg);
+        case PLK_CMD_WAIT_EVENT:
+            ret = eventkcal_waitEventForUser();
             break;
 
         case PLK_CMD_DLLCAL_ASYNCSEND:
             ret = sendAsyncFrame(arg);
             break;
 
+        case PLK_CMD_DLLCAL_ASYNCRING_SIGNAL:
+            ret = processAsyncRing();
+            break;
+
         case PLK_CMD_ERRHND_WRITE:
             ret = writeErrorObject(arg);
             break;
@@ -444,14 +476,17 @@ static int  powerlinkIoctl (struct inode* dev, struct file* filp,
 /**
 \brief  openPOWERLINK driver mmap function
 
-The function implements openPOWERLINK kernel module mmap function.
+The function implements openPOWERLINK kernel module mmap function. The offset
+selects the mapped memory region: PDO memory, event ring or asynchronous TX
+frame ring.
 
 \ingroup module_driver_linux_kernel
 */
 //------------------------------------------------------------------------------
 static int powerlinkMmap(struct file *filp, struct vm_area_struct *vma)
 {
-    BYTE*       pPdoMem;
+    BYTE*       pMem;
+    size_t      memSize;
 
     EPL_DBGLVL_ALWAYS_TRACE("%s() vma: vm_start:%lX vm_end:%lX vm_pgoff:%lX\n",
           __func__, vma->vm_start, vma->vm_end, vma->vm_pgoff);
@@ -459,13 +494,40 @@ static int powerlinkMmap(struct file *filp, struct vm_area_struct *vma)
     vma->vm_flags |= VM_RESERVED;
     vma->vm_ops = &powerlinkVmOps;
 
-    if ((pPdoMem = pdokcal_getPdoMemRegion()) == NULL)
+    switch (vma->vm_pgoff << PAGE_SHIFT)
+    {
+        case PLK_MMAP_OFFSET_PDO:
+            pMem = pdokcal_getPdoMemRegion();
+            memSize = vma->vm_end - vma->vm_start;
+            break;
+
+        case PLK_MMAP_OFFSET_EVENT_RING:
+            pMem = eventkcal_getEventRingMem(&memSize);
+            break;
+
+        case PLK_MMAP_OFFSET_ASYNC_RING:
+            pMem = asyncRing_l.pMem;
+            memSize = PLK_ASYNC_RING_SIZE;
+            break;
+
+        default:
+            EPL_DBGLVL_ERROR_TRACE ("%s() invalid offset!\n", __func__);
+            return -EINVAL;
+    }
+
+    if (pMem == NULL)
     {
-        EPL_DBGLVL_ERROR_TRACE ("%s() no pdo memory allocated!\n", __func__);
+        EPL_DBGLVL_ERROR_TRACE ("%s() no memory allocated!\n", __func__);
         return -ENOMEM;
     }
 
-    if (remap_pfn_range(vma, vma->vm_start, (__pa(pPdoMem) >> PAGE_SHIFT),
+    if (vma->vm_end - vma->vm_start > PAGE_ALIGN(memSize))
+    {
+        EPL_DBGLVL_ERROR_TRACE ("%s() mapping exceeds memory region!\n", __func__);
+        return -EINVAL;
+    }
+
+    if (remap_pfn_range(vma, vma->vm_start, (__pa(pMem) >> PAGE_SHIFT),
                     vma->vm_end - vma->vm_start, vma->vm_page_prot))
     {
         EPL_DBGLVL_ERROR_TRACE("%s() remap_pfn_range failed\n", __func__);
@@ -666,6 +728,129 @@ static int sendAsyncFrame(unsigned long arg)
     return 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process asynchronous TX frame ring ioctl
+
+The function implements the ioctl which is used by the user layer to signal
+new frames in the asynchronous TX frame ring. All frames of the ring are
+forwarded to the DLL. The signal pending flag of the ring is cleared before,
+so that frames written afterwards are signaled again by the user layer.
+
+The ring is writable by the user application at any time. Therefore, the
+header and the frame of each entry are copied once into kernel memory and only
+the copy is checked and passed to the DLL. Entries with an invalid queue or
+an oversized frame are dropped.
+
+\ingroup module_driver_linux_kernel
+*/
+//------------------------------------------------------------------------------
+static int processAsyncRing(void)
+{
+    BYTE*               pEntry;
+    size_t              entrySize;
+    tAsyncRingEntryHdr  entryHdr;
+    tFrameInfo          frameInfo;
+
+    if (asyncRing_l.pMem == NULL)
+        return -EIO;
+
+    mutex_lock(&asyncRing_l.mutex);
+
+    shmring_clearSignalPending(&asyncRing_l.ring);
+    while (shmring_peekData(&asyncRing_l.ring, (void**)&pEntry, &entrySize) == kShmRingOk)
+    {
+        if ((entrySize > sizeof(tAsyncRingEntryHdr)) &&
+            ((entrySize - sizeof(tAsyncRingEntryHdr)) <= EPL_C_IP_MAX_MTU))
+        {
+            frameInfo.frameSize = entrySize - sizeof(tAsyncRingEntryHdr);
+            EPL_MEMCPY(&entryHdr, pEntry, sizeof(tAsyncRingEntryHdr));
+            EPL_MEMCPY(asyncRing_l.pFrameBuf, pEntry + sizeof(tAsyncRingEntryHdr),
+                       frameInfo.frameSize);
+
+            switch (entryHdr.queue)
+            {
+                case kDllCalQueueTxNmt:
+                case kDllCalQueueTxGen:
+                case kDllCalQueueTxSync:
+                    frameInfo.pFrame = (tEplFrame *)asyncRing_l.pFrameBuf;
+                    dllkcal_writeAsyncFrame(&frameInfo, (tDllCalQueue)entryHdr.queue);
+                    break;
+
+                default:
+                    // invalid queue, drop frame
+                    break;
+            }
+        }
+        shmring_releaseData(&asyncRing_l.ring);
+    }
+
+    mutex_unlock(&asyncRing_l.mutex);
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize asynchronous TX frame ring
+
+The function allocates and initializes the asynchronous TX frame ring.
+
+\return The function returns 0 or a Linux error code.
+
+\ingroup module_driver_linux_kernel
+*/
+//------------------------------------------------------------------------------
+static int initAsyncRing(void)
+{
+    mutex_init(&asyncRing_l.mutex);
+
+    asyncRing_l.pMem = (BYTE*)__get_free_pages(GFP_KERNEL | __GFP_ZERO,
+                                               get_order(PLK_ASYNC_RING_SIZE));
+    if (asyncRing_l.pMem == NULL)
+        return -ENOMEM;
+
+    asyncRing_l.pFrameBuf = (BYTE*)__get_free_pages(GFP_KERNEL,
+                                                    get_order(EPL_C_IP_MAX_MTU));
+    if (asyncRing_l.pFrameBuf == NULL)
+    {
+        exitAsyncRing();
+        return -ENOMEM;
+    }
+
+    if (shmring_init(&asyncRing_l.ring, asyncRing_l.pMem, PLK_ASYNC_RING_SIZE) != kShmRingOk)
+    {
+        exitAsyncRing();
+        return -EIO;
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cleanup asynchronous TX frame ring
+
+The function frees the memory of the asynchronous TX frame ring.
+
+\ingroup module_driver_linux_kernel
+*/
+//------------------------------------------------------------------------------
+static void exitAsyncRing(void)
+{
+    if (asyncRing_l.pMem != NULL)
+    {
+        free_pages((ULONG)asyncRing_l.pMem, get_order(PLK_ASYNC_RING_SIZE));
+        asyncRing_l.pMem = NULL;
+    }
+
+    if (asyncRing_l.pFrameBuf != NULL)
+    {
+        free_pages((ULONG)asyncRing_l.pFrameBuf, get_order(EPL_C_IP_MAX_MTU));
+        asyncRing_l.pFrameBuf = NULL;
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Write error object ioctl
@@ -32,11 +32,16 @@
 ADD_DEFINITIONS(-Wall -Wextra -pedantic -std=c99 -pthread -D_GNU_SOURCE
                 -D_POSIX_C_SOURCE=200112L -fno-strict-aliasing)
 
+# the MN collects PRes response time histograms from the frame time stamps
+ADD_DEFINITIONS(-DCONFIG_DLL_RESPONSE_TIME_HIST)
+
+# kernel events and SoC frames are stamped with the net time of timestamp-linuxuser.c
+ADD_DEFINITIONS(-DCONFIG_TARGET_NETTIME)
+INCLUDE_DIRECTORIES(${STACK_INCLUDE_DIR}/target/linux)
+
 SET (DAEMON_ARCH_SOURCES
      ${LIB_SOURCE_DIR}/console/console-linux.c
      ${ARCH_SOURCE_DIR}/linux/target-linux.c
-     ${LIB_SOURCE_DIR}/trace/trace-printf.c
-     ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
      ${KERNEL_SOURCE_DIR}/pdo/pdokcalmem-posixshm.c
      ${KERNEL_SOURCE_DIR}/pdo/pdokcalsync-bsdsem.c
      ${KERNEL_SOURCE_DIR}/hrtimer/hrtimer-posix.c
@@ -46,6 +51,21 @@ SET (DAEMON_ARCH_SOURCES
      ${COMMON_SOURCE_DIR}/ctrl/ctrlcal-posixshm.c
      ${LIB_SOURCE_DIR}/circbuf/circbuf-posixshm.c
      ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
+     ${KERNEL_SOURCE_DIR}/timestamp/timestamp-linuxuser.c
+     ${KERNEL_SOURCE_DIR}/dll/dllkresptime.c
      )
 
-SET (ARCH_LIBRARIES pcap pthread rt)
+IF (CFG_TRACE_RING)
+    SET (DAEMON_ARCH_SOURCES ${DAEMON_ARCH_SOURCES} ${LIB_SOURCE_DIR}/trace/trace-ring.c)
+ELSE (CFG_TRACE_RING)
+    SET (DAEMON_ARCH_SOURCES ${DAEMON_ARCH_SOURCES} ${LIB_SOURCE_DIR}/trace/trace-printf.c)
+ENDIF (CFG_TRACE_RING)
+
+IF (CFG_POWERLINK_EDRV_SIM)
+    SET (DAEMON_ARCH_SOURCES ${DAEMON_ARCH_SOURCES} ${EDRV_SOURCE_DIR}/edrv-sim.c)
+    SET (ARCH_LIBRARIES pthread rt)
+ELSE (CFG_POWERLINK_EDRV_SIM)
+    SET (DAEMON_ARCH_SOURCES ${DAEMON_ARCH_SOURCES} ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
+                             ${EDRV_SOURCE_DIR}/edrv-pcapfilter.c)
+    SET (ARCH_LIBRARIES pcap pthread rt)
+ENDIF (CFG_POWERLINK_EDRV_SIM)
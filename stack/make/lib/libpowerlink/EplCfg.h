@@ -245,6 +245,20 @@
 // callback function (called event kObdEvWrStringDomain)
 #define CONFIG_OBD_USE_STRING_DOMAIN_IN_RAM    TRUE
 
+// set this define to TRUE if the default values of the OD shall be restored
+// from a snapshot of each OD part on NMT resets instead of walking through
+// all objects
+#define CONFIG_OBD_USE_RESET_SNAPSHOT          TRUE
+
+// set this define to TRUE if objects with the store attribute shall be stored
+// in non-volatile memory by writing object 0x1010 and loaded on reset. It is
+// enabled if the target provides an OBD store module (see obdstore.h).
+#ifdef CONFIG_OBD_STORE
+#define CONFIG_OBD_USE_STORE_RESTORE           TRUE
+#else
+#define CONFIG_OBD_USE_STORE_RESTORE           FALSE
+#endif
+
 #ifdef CONFIG_CFM
 
 #define CONFIG_OBD_USE_LOAD_CONCISEDCF         TRUE
@@ -268,6 +282,13 @@
 
 #endif // CONFIG_CFM
 
+// =========================================================================
+// NMT MN specific defines
+// =========================================================================
+
+// record the timeline of the MN boot process (see oplk_getBootTimeline())
+#define EPL_NMTMNU_BOOT_TIMELINE            TRUE
+
 // =========================================================================
 // Timer module specific defines
 // =========================================================================
@@ -279,6 +300,8 @@
 // SDO module specific defines
 // =========================================================================
 
+// allow SDO segments up to the Ethernet MTU (C_DLL_MAX_ASYNC_MTU)
+#define SDO_MAX_SEGMENT_SIZE                1456
 
 #ifdef CONFIG_MN
 
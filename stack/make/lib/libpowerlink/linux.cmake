@@ -31,20 +31,45 @@
 ADD_DEFINITIONS(-Wall -Wextra -pedantic -std=c99 -pthread -D_GNU_SOURCE
                 -D_POSIX_C_SOURCE=200112L -fno-strict-aliasing)
 
+# the MN collects PRes response time histograms from the frame time stamps
+ADD_DEFINITIONS(-DCONFIG_DLL_RESPONSE_TIME_HIST)
+
+# kernel events and SoC frames are stamped with the net time of timestamp-linuxuser.c
+ADD_DEFINITIONS(-DCONFIG_TARGET_NETTIME)
+INCLUDE_DIRECTORIES(${STACK_INCLUDE_DIR}/target/linux)
+
+# objects with the store attribute are stored by the OBD store module
+ADD_DEFINITIONS(-DCONFIG_OBD_STORE)
+
 SET (LIB_ARCH_SOURCES
      ${LIB_ARCH_SOURCES}
-     ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
      ${USER_SOURCE_DIR}/sdo/sdo-udpu.c
      ${COMMON_SOURCE_DIR}/timer/timer-linuxuser.c
      ${KERNEL_SOURCE_DIR}/hrtimer/hrtimer-posix.c
-     ${LIB_SOURCE_DIR}/circbuf/circbuf-posixshm.c
+     ${LIB_SOURCE_DIR}/circbuf/circbuf-posixlocal.c
      ${ARCH_SOURCE_DIR}/linux/ftrace-debug.c
      ${ARCH_SOURCE_DIR}/linux/target-linux.c
-     ${LIB_SOURCE_DIR}/trace/trace-printf.c
      ${USER_SOURCE_DIR}/event/eventucal-linux.c
      ${USER_SOURCE_DIR}/event/eventucalintf-circbuf.c
+     ${USER_SOURCE_DIR}/pdo/pdoucalsync-local.c
+     ${USER_SOURCE_DIR}/obd/obdstore-linux.c
      ${KERNEL_SOURCE_DIR}/event/eventkcal-linux.c
      ${KERNEL_SOURCE_DIR}/event/eventkcalintf-circbuf.c
      ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
+     ${KERNEL_SOURCE_DIR}/timestamp/timestamp-linuxuser.c
+     ${KERNEL_SOURCE_DIR}/dll/dllkresptime.c
      )
 
+IF (CFG_TRACE_RING)
+    SET (LIB_ARCH_SOURCES ${LIB_ARCH_SOURCES} ${LIB_SOURCE_DIR}/trace/trace-ring.c)
+ELSE (CFG_TRACE_RING)
+    SET (LIB_ARCH_SOURCES ${LIB_ARCH_SOURCES} ${LIB_SOURCE_DIR}/trace/trace-printf.c)
+ENDIF (CFG_TRACE_RING)
+
+
+IF (CFG_POWERLINK_EDRV_SIM)
+    SET (LIB_ARCH_SOURCES ${LIB_ARCH_SOURCES} ${EDRV_SOURCE_DIR}/edrv-sim.c)
+ELSE (CFG_POWERLINK_EDRV_SIM)
+    SET (LIB_ARCH_SOURCES ${LIB_ARCH_SOURCES} ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
+                          ${EDRV_SOURCE_DIR}/edrv-pcapfilter.c)
+ENDIF (CFG_POWERLINK_EDRV_SIM)
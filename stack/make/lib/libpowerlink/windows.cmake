@@ -48,6 +48,7 @@ SET (LIB_ARCH_SOURCES
      ${ARCH_SOURCE_DIR}/windows/target-windows.c
      ${USER_SOURCE_DIR}/event/eventucal-win32.c
      ${USER_SOURCE_DIR}/event/eventucalintf-circbuf.c
+     ${USER_SOURCE_DIR}/pdo/pdoucalsync-null.c
      ${KERNEL_SOURCE_DIR}/event/eventkcal-win32.c
      ${KERNEL_SOURCE_DIR}/event/eventkcalintf-circbuf.c
      )
@@ -32,14 +32,23 @@
 ADD_DEFINITIONS(-Wall -Wextra -pedantic -std=c99 -pthread -D_GNU_SOURCE -D_POSIX_C_SOURCE=200112L
                 -fno-strict-aliasing)
 
+# objects with the store attribute are stored by the OBD store module
+ADD_DEFINITIONS(-DCONFIG_OBD_STORE)
+
 SET(LIB_ARCH_SOURCES 
      ${USER_SOURCE_DIR}/sdo/sdo-udpu.c
+     ${USER_SOURCE_DIR}/obd/obdstore-linux.c
      ${COMMON_SOURCE_DIR}/timer/timer-linuxuser.c
      ${ARCH_SOURCE_DIR}/linux/ftrace-debug.c
      ${ARCH_SOURCE_DIR}/linux/target-linux.c
-     ${LIB_SOURCE_DIR}/trace/trace-printf.c
      )
 
+IF (CFG_TRACE_RING)
+    SET (LIB_ARCH_SOURCES ${LIB_ARCH_SOURCES} ${LIB_SOURCE_DIR}/trace/trace-ring.c)
+ELSE (CFG_TRACE_RING)
+    SET (LIB_ARCH_SOURCES ${LIB_ARCH_SOURCES} ${LIB_SOURCE_DIR}/trace/trace-printf.c)
+ENDIF (CFG_TRACE_RING)
+
 IF (CFG_KERNEL_STACK_KERNEL_MODULE)
 ADD_DEFINITIONS(-DCONFIG_USE_KERNEL_MODULE)
 SET (LIB_ARCH_SOURCES
@@ -50,6 +59,7 @@ SET (LIB_ARCH_SOURCES
      ${USER_SOURCE_DIR}/ctrl/ctrlucal-ioctl.c
      ${USER_SOURCE_DIR}/event/eventucal-linuxioctl.c
      ${USER_SOURCE_DIR}/errhnd/errhnducal-ioctl.c
+     ${LIB_SOURCE_DIR}/shmring/shmring.c
      )
 ELSE (CFG_KERNEL_STACK_KERNEL_MODULE)
 SET (LIB_ARCH_SOURCES
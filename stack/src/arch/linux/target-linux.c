@@ -42,8 +42,68 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unistd.h>
 #include <fcntl.h>
 #include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <sched.h>
+#include <pthread.h>
 #include <Epl.h>
 
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TARGET_THREAD_ENV_PREFIX    "POWERLINK_THREAD_"
+#define TARGET_THREAD_MAX_CPUS      32
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEplThreadConfig     threadConfig_l;                     ///< Thread configuration set by the application
+static tEplThreadParam      aEnvThreadParam_l[kEplThreadCount]; ///< Thread configuration read from the environment
+static BOOL                 fEnvThreadParamRead_l = FALSE;      ///< Environment has been read
+
+/// Names of the stack threads used in the environment variables and for logging
+static const char*          aThreadName_l[kEplThreadCount] =
+{
+    "EDRV_RX",
+    "EVENT_KERNEL",
+    "EVENT_USER",
+    "HRTIMER",
+    "TIMER_USER",
+    "VETH",
+    "SYNC_USER"
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void readEnvThreadConfig(void);
+static BOOL parseThreadParam(const char* pszValue_p, tEplThreadParam* pParam_p);
+static const char* getPolicyName(int policy_p);
+
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
 //============================================================================//
@@ -137,6 +197,26 @@ void target_msleep(UINT32 milliSeconds_p)
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get tick count
+
+The function returns the current tick count in milliseconds. The tick count
+is monotonic and starts at an undefined point of time.
+
+\return The function returns the tick count in milliseconds.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+DWORD PUBLIC EplTgtGetTickCountMs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return (DWORD)((curTime.tv_sec * 1000UL) + (curTime.tv_nsec / 1000000UL));
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Set IP address of specified Ethernet interface
@@ -223,3 +303,317 @@ tEplKernel target_setDefaultGateway(UINT32 defaultGateway_p)
     }
     return ret;
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set thread configuration
+
+The function stores the CPU affinity and scheduling configuration of the stack
+threads. It must be called before the stack modules are initialized, because
+the configuration is applied when a thread is created.
+
+The configuration can be overridden by the environment variables
+POWERLINK_THREAD_<name> where <name> is EDRV_RX, EVENT_KERNEL, EVENT_USER,
+HRTIMER, TIMER_USER, VETH or SYNC_USER. The value has the format
+"<cpu list>:<policy>:<priority>", e.g. "2,3:fifo:80" or "1-2". The CPU list
+contains CPU numbers and ranges, the policy is "other", "fifo" or "rr". Empty
+fields keep the value of the configuration. This allows to change the
+configuration of the userspace daemon, which doesn't get the init parameters
+of the application.
+
+\param  pThreadConfig_p         Pointer to the thread configuration. If NULL,
+                                the default configuration is used.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_setThreadConfig(tEplThreadConfig* pThreadConfig_p)
+{
+    if (pThreadConfig_p == NULL)
+        EPL_MEMSET(&threadConfig_l, 0, sizeof(tEplThreadConfig));
+    else
+        EPL_MEMCPY(&threadConfig_l, pThreadConfig_p, sizeof(tEplThreadConfig));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Apply thread configuration to a thread
+
+The function sets the scheduling policy, priority and CPU affinity of a stack
+thread according to the thread configuration. Parameters which are not
+configured are set to the defaults given by the calling module. The applied
+settings are logged.
+
+\param  thread_p                Handle of the thread.
+\param  threadId_p              Identifier of the thread in the configuration.
+\param  defaultPolicy_p         Scheduling policy used if no policy is
+                                configured (SCHED_xxx). If -1, the inherited
+                                scheduling is kept.
+\param  defaultPriority_p       Priority used if no priority is configured.
+
+\return The function returns 0 on success or the error code of the failed
+        pthread function.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+int target_setThreadSchedParam(pthread_t thread_p, tEplThreadId threadId_p,
+                               int defaultPolicy_p, int defaultPriority_p)
+{
+    tEplThreadParam     param;
+    tEplThreadParam*    pEnvParam;
+    struct sched_param  schedParam;
+    cpu_set_t           cpuSet;
+    int                 policy;
+    int                 priority;
+    int                 ret;
+    UINT                cpu;
+
+    if ((UINT)threadId_p >= kEplThreadCount)
+        return EINVAL;
+
+    readEnvThreadConfig();
+
+    // settings of the environment take precedence over the application
+    param = threadConfig_l.m_aThread[threadId_p];
+    pEnvParam = &aEnvThreadParam_l[threadId_p];
+    if (pEnvParam->m_dwCpuMask != 0)
+        param.m_dwCpuMask = pEnvParam->m_dwCpuMask;
+    if (pEnvParam->m_Policy != kEplThreadPolicyDefault)
+        param.m_Policy = pEnvParam->m_Policy;
+    if (pEnvParam->m_uiPriority != 0)
+        param.m_uiPriority = pEnvParam->m_uiPriority;
+
+    switch (param.m_Policy)
+    {
+        case kEplThreadPolicyOther:
+            policy = SCHED_OTHER;
+            break;
+
+        case kEplThreadPolicyFifo:
+            policy = SCHED_FIFO;
+            break;
+
+        case kEplThreadPolicyRr:
+            policy = SCHED_RR;
+            break;
+
+        default:
+            policy = defaultPolicy_p;
+            break;
+    }
+
+    if ((policy == SCHED_FIFO) || (policy == SCHED_RR))
+    {
+        priority = (param.m_uiPriority != 0) ? (int)param.m_uiPriority : defaultPriority_p;
+        if (priority < sched_get_priority_min(policy))
+            priority = sched_get_priority_min(policy);
+        if (priority > sched_get_priority_max(policy))
+            priority = sched_get_priority_max(policy);
+    }
+    else
+    {
+        priority = 0;
+    }
+
+    if (policy >= 0)
+    {
+        schedParam.sched_priority = priority;
+        ret = pthread_setschedparam(thread_p, policy, &schedParam);
+        if (ret != 0)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() couldn't set scheduling of thread %s (%s/%d): %d\n",
+                                   __func__, aThreadName_l[threadId_p],
+                                   getPolicyName(policy), priority, ret);
+            return ret;
+        }
+    }
+
+    if (param.m_dwCpuMask != 0)
+    {
+        CPU_ZERO(&cpuSet);
+        for (cpu = 0; cpu < TARGET_THREAD_MAX_CPUS; cpu++)
+        {
+            if (param.m_dwCpuMask & (1UL << cpu))
+                CPU_SET(cpu, &cpuSet);
+        }
+
+        ret = pthread_setaffinity_np(thread_p, sizeof(cpu_set_t), &cpuSet);
+        if (ret != 0)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() couldn't set CPU affinity of thread %s (0x%08lX): %d\n",
+                                   __func__, aThreadName_l[threadId_p],
+                                   (ULONG)param.m_dwCpuMask, ret);
+            return ret;
+        }
+    }
+
+    if (policy >= 0)
+    {
+        PRINTF("Thread %s: policy %s, priority %d, CPU mask 0x%08lX\n",
+               aThreadName_l[threadId_p], getPolicyName(policy),
+               priority, (ULONG)param.m_dwCpuMask);
+    }
+    else
+    {
+        PRINTF("Thread %s: inherited scheduling, CPU mask 0x%08lX\n",
+               aThreadName_l[threadId_p], (ULONG)param.m_dwCpuMask);
+    }
+
+    return 0;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read thread configuration from the environment
+
+The function reads the thread configuration from the environment variables
+POWERLINK_THREAD_<name>. The environment is only read once. Invalid values are
+reported and ignored.
+*/
+//------------------------------------------------------------------------------
+static void readEnvThreadConfig(void)
+{
+    char        szEnvName[64];
+    const char* pszValue;
+    UINT        threadId;
+
+    if (fEnvThreadParamRead_l)
+        return;
+
+    fEnvThreadParamRead_l = TRUE;
+
+    for (threadId = 0; threadId < kEplThreadCount; threadId++)
+    {
+        snprintf(szEnvName, sizeof(szEnvName), "%s%s", TARGET_THREAD_ENV_PREFIX,
+                 aThreadName_l[threadId]);
+        pszValue = getenv(szEnvName);
+        if (pszValue == NULL)
+            continue;
+
+        if (!parseThreadParam(pszValue, &aEnvThreadParam_l[threadId]))
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() invalid value \"%s\" of %s ignored\n",
+                                   __func__, pszValue, szEnvName);
+            EPL_MEMSET(&aEnvThreadParam_l[threadId], 0, sizeof(tEplThreadParam));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse thread parameters
+
+The function parses a thread configuration string in the format
+"<cpu list>:<policy>:<priority>". Each field may be empty.
+
+\param  pszValue_p              String to be parsed.
+\param  pParam_p                Pointer to store the thread parameters.
+
+\return The function returns TRUE if the string is valid, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL parseThreadParam(const char* pszValue_p, tEplThreadParam* pParam_p)
+{
+    const char*     pszPos = pszValue_p;
+    char*           pszEnd;
+    unsigned long   first;
+    unsigned long   last;
+    size_t          len;
+
+    EPL_MEMSET(pParam_p, 0, sizeof(tEplThreadParam));
+
+    // CPU list, e.g. "1,3" or "0-2"
+    while ((*pszPos != ':') && (*pszPos != '\0'))
+    {
+        first = strtoul(pszPos, &pszEnd, 10);
+        if (pszEnd == pszPos)
+            return FALSE;
+
+        last = first;
+        if (*pszEnd == '-')
+        {
+            pszPos = pszEnd + 1;
+            last = strtoul(pszPos, &pszEnd, 10);
+            if (pszEnd == pszPos)
+                return FALSE;
+        }
+
+        if ((first > last) || (last >= TARGET_THREAD_MAX_CPUS))
+            return FALSE;
+
+        for (; first <= last; first++)
+            pParam_p->m_dwCpuMask |= (1UL << first);
+
+        pszPos = pszEnd;
+        if (*pszPos == ',')
+            pszPos++;
+        else if ((*pszPos != ':') && (*pszPos != '\0'))
+            return FALSE;
+    }
+
+    if (*pszPos == '\0')
+        return TRUE;
+
+    // scheduling policy
+    pszPos++;
+    len = strcspn(pszPos, ":");
+    if ((len == 5) && (strncmp(pszPos, "other", len) == 0))
+        pParam_p->m_Policy = kEplThreadPolicyOther;
+    else if ((len == 4) && (strncmp(pszPos, "fifo", len) == 0))
+        pParam_p->m_Policy = kEplThreadPolicyFifo;
+    else if ((len == 2) && (strncmp(pszPos, "rr", len) == 0))
+        pParam_p->m_Policy = kEplThreadPolicyRr;
+    else if (len != 0)
+        return FALSE;
+
+    pszPos += len;
+    if (*pszPos == '\0')
+        return TRUE;
+
+    // priority
+    pszPos++;
+    if (*pszPos == '\0')
+        return TRUE;
+
+    pParam_p->m_uiPriority = (unsigned int)strtoul(pszPos, &pszEnd, 10);
+    if ((pszEnd == pszPos) || (*pszEnd != '\0'))
+        return FALSE;
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get name of scheduling policy
+
+\param  policy_p                Scheduling policy (SCHED_xxx).
+
+\return The function returns the name of the policy.
+*/
+//------------------------------------------------------------------------------
+static const char* getPolicyName(int policy_p)
+{
+    switch (policy_p)
+    {
+        case SCHED_OTHER:
+            return "other";
+
+        case SCHED_FIFO:
+            return "fifo";
+
+        case SCHED_RR:
+            return "rr";
+
+        default:
+            return "unknown";
+    }
+}
+
+/// \}
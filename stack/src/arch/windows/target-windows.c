@@ -74,6 +74,23 @@ tEplKernel target_cleanup(void)
     return kEplSuccessful;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get tick count
+
+The function returns the current tick count in milliseconds. The tick count
+is monotonic and starts at an undefined point of time.
+
+\return The function returns the tick count in milliseconds.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+DWORD PUBLIC EplTgtGetTickCountMs(void)
+{
+    return GetTickCount();
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief Sleep for the specified number of milliseconds
@@ -288,6 +288,8 @@ static tApiEventInfo ApiEventInfo_g[] =
     { kEplApiEventNode,             "Node event"                        },
     { kEplApiEventBoot,             "Boot event"                        },
     { kEplApiEventSdo,              "SDO event"                         },
+    { kEplApiEventSdoBatchItem,     "SDO batch item"                    },
+    { kEplApiEventSdoBatch,         "SDO batch finished"                },
     { kEplApiEventObdAccess,        "OBD access"                        },
     { kEplApiEventLed,              "LED event"                         },
     { kEplApiEventCfmProgress,      "CFM progress"                      },
@@ -157,7 +157,6 @@ tEplKernel PUBLIC EplTimeruInit()
 tEplKernel PUBLIC EplTimeruAddInstance()
 {
     tEplKernel                  Ret;
-    struct sched_param          schedParam;
     INT                         iRetVal;
 
     // reset instance structure
@@ -182,9 +181,8 @@ tEplKernel PUBLIC EplTimeruAddInstance()
         goto Exit;
     }
 
-    schedParam.__sched_priority = EPL_THREAD_PRIORITY_LOW;
-    if (pthread_setschedparam(EplTimeruInstance_g.m_hProcessThread, SCHED_RR,
-                              &schedParam) != 0)
+    if (target_setThreadSchedParam(EplTimeruInstance_g.m_hProcessThread, kEplThreadTimerUser,
+                                   SCHED_RR, EPL_THREAD_PRIORITY_LOW) != 0)
     {
         EPL_DBGLVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n",
                                 __func__);
@@ -211,6 +211,7 @@ typedef struct
 #if defined(CONFIG_INCLUDE_NMT_MN)
     tDllkNodeInfo*          pFirstNodeInfo;
     UINT8                   aCnNodeIdList[2][EPL_NMT_MAX_NODE_ID];
+    UINT                    aCnNodeIdListGen[2];            // generation of node-ID list, changes with its content
     UINT8                   curNodeIndex;
     tEdrvTxBuffer**         ppTxBufferList;
     UINT8                   syncLastSoaReq;
@@ -232,8 +233,15 @@ typedef struct
 #endif
 
     UINT                    cycleCount;                     // cycle counter (needed for multiplexed cycle support)
+    UINT                    nmtEventMask;                   // DLLK_NMTEVENT_xxx the NMT state machine is interested in
+    tDllkNmtEventStatistics nmtEventStatistics;             // statistics of posted and suppressed NMT events
     UINT64                  frameTimeout;                   // frame timeout (cycle length + loss of frame tolerance)
 
+#if defined(CONFIG_INCLUDE_NMT_MN) && defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+    UINT                    preqPrevNodeId;                 // destination of the last time stamped PReq
+    tEplTgtTimeStamp*       pPreqPrevTimeStamp;             // transmission time of the last PReq
+#endif
+
 #if EPL_DLL_PRES_CHAINING_CN != FALSE
     UINT                    syncReqPrevNodeId;
     tEplTgtTimeStamp*       pSyncReqPrevTimeStamp;
@@ -265,6 +273,9 @@ void       dllk_processTransmittedNonEpl(tEdrvTxBuffer * pTxBuffer_p);
 #if defined(CONFIG_INCLUDE_NMT_MN)
 void       dllk_processTransmittedSoc(tEdrvTxBuffer * pTxBuffer_p);
 void       dllk_processTransmittedSoa(tEdrvTxBuffer * pTxBuffer_p);
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+void       dllk_processTransmittedPreq(tEdrvTxBuffer * pTxBuffer_p);
+#endif
 #endif
 tEplKernel dllk_updateFrameIdentRes(tEdrvTxBuffer* pTxBuffer_p, tNmtState nmtState_p);
 tEplKernel dllk_updateFrameStatusRes(tEdrvTxBuffer* pTxBuffer_p, tNmtState NmtState_p);
@@ -107,6 +107,9 @@ tEplKernel dllk_addInstance(tDllkInitParam* pInitParam_p)
     // reset instance structure
     EPL_MEMSET(&dllkInstance_g, 0, sizeof (dllkInstance_g));
 
+    // post all NMT events until the NMT state machine sets its mask
+    dllkInstance_g.nmtEventMask = DLLK_NMTEVENT_ALL;
+
     //jba able to work without hresk?
 #if EPL_TIMER_USE_HIGHRES != FALSE
     if ((ret = EplTimerHighReskInit()) != kEplSuccessful)
@@ -178,6 +181,12 @@ tEplKernel dllk_addInstance(tDllkInitParam* pInitParam_p)
     dllkInstance_g.pSyncReqPrevTimeStamp = EplTgtTimeStampAlloc();
 #endif
 
+#if defined(CONFIG_INCLUDE_NMT_MN) && defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+    dllkInstance_g.pPreqPrevTimeStamp = EplTgtTimeStampAlloc();
+    if (dllkInstance_g.pPreqPrevTimeStamp == NULL)
+        return kEplDllOutOfMemory;
+#endif
+
     return ret;
 }
 
@@ -214,6 +223,11 @@ tEplKernel dllk_delInstance(void)
 #if EPL_DLL_PRES_CHAINING_CN != FALSE
     EplTgtTimeStampFree(dllkInstance_g.pSyncReqPrevTimeStamp);
 #endif
+
+#if defined(CONFIG_INCLUDE_NMT_MN) && defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+    EplTgtTimeStampFree(dllkInstance_g.pPreqPrevTimeStamp);
+    dllkInstance_g.pPreqPrevTimeStamp = NULL;
+#endif
     ret = EdrvShutdown();
     return ret;
 }
@@ -391,6 +405,47 @@ tEplSyncCb dllk_regSyncHandler(tEplSyncCb pfnCbSync_p)
     return pfnCbOld;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set mask of NMT events needed by the NMT state machine
+
+The function sets the NMT events generated by received frames which are
+processed by the NMT state machine in its current state. Received frames only
+generate NMT events which are contained in this mask. The NMT kernel module
+updates the mask on every state change.
+
+\param  nmtEventMask_p      Mask of DLLK_NMTEVENT_xxx flags.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_setNmtEventMask(UINT nmtEventMask_p)
+{
+    dllkInstance_g.nmtEventMask = nmtEventMask_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get statistics of NMT events generated by received frames
+
+The function returns the number of NMT events which have been posted to the
+NMT state machine and the number of events which have been suppressed because
+the current NMT state does not process them.
+
+\param  pStatistics_p       Pointer to store the statistics.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_getNmtEventStatistics(tDllkNmtEventStatistics* pStatistics_p)
+{
+    TGT_DLLK_DECLARE_FLAGS;
+
+    TGT_DLLK_ENTER_CRITICAL_SECTION();
+    *pStatistics_p = dllkInstance_g.nmtEventStatistics;
+    TGT_DLLK_LEAVE_CRITICAL_SECTION();
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Register handler for RPDO frames
@@ -539,6 +594,9 @@ tEplKernel dllk_configNode(tDllNodeInfo * pNodeInfo_p)
     pIntNodeInfo->fSoftDelete = FALSE;
     pIntNodeInfo->dllErrorEvents = 0L;
     pIntNodeInfo->nmtState = kNmtCsNotActive;
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+    dllk_resetResponseTimeHist(&pIntNodeInfo->responseTimeHist);
+#endif
 #endif
 
     return ret;
@@ -728,14 +786,56 @@ It is only useful for kernel error handler module.
 
 \param  ppbCnNodeIdList_p       Pointer to array of bytes with node-ID list.
                                 Array is terminated by value 0.
+\param  pGeneration_p           Pointer to store the generation of the node-ID
+                                list. It only changes if the content of the
+                                list differs from the previous cycle.
 
 \ingroup module_dllk
 */
 //------------------------------------------------------------------------------
-void dllk_getCurrentCnNodeIdList(BYTE** ppbCnNodeIdList_p)
+void dllk_getCurrentCnNodeIdList(BYTE** ppbCnNodeIdList_p, UINT* pGeneration_p)
 {
     *ppbCnNodeIdList_p = &dllkInstance_g.aCnNodeIdList[dllkInstance_g.curTxBufferOffsetCycle ^ 1][0];
+    *pGeneration_p = dllkInstance_g.aCnNodeIdListGen[dllkInstance_g.curTxBufferOffsetCycle ^ 1];
+}
+
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+//------------------------------------------------------------------------------
+/**
+\brief  Get PRes response time histogram of the specified node
+
+The function returns a copy of the response time histogram of the specified
+CN. The histogram is only filled if the Ethernet driver provides time stamps
+for transmitted PReq and received PRes frames.
+
+\param  nodeId_p                Node ID of the CN.
+\param  pHist_p                 Pointer to store the histogram.
+
+\return The function returns a tEplKernel error code.
+\retval kEplSuccessful          If the histogram is successfully read.
+\retval kEplDllNoNodeInfo       If node is not found.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+tEplKernel dllk_getResponseTimeHist(UINT nodeId_p, tDllkResponseTimeHist* pHist_p)
+{
+    tDllkNodeInfo*   pNodeInfo;
+    TGT_DLLK_DECLARE_FLAGS;
+
+    pNodeInfo = dllk_getNodeInfo(nodeId_p);
+    if (pNodeInfo == NULL)
+    {   // no node info structure available
+        return kEplDllNoNodeInfo;
+    }
+
+    TGT_DLLK_ENTER_CRITICAL_SECTION();
+    *pHist_p = pNodeInfo->responseTimeHist;
+    TGT_DLLK_LEAVE_CRITICAL_SECTION();
+
+    return kEplSuccessful;
 }
+#endif
 
 #if (EPL_DLL_PRES_CHAINING_MN == TRUE)
 //------------------------------------------------------------------------------
@@ -1281,6 +1381,11 @@ tEplKernel dllk_setupLocalNodeMn(void)
             if (ret != kEplSuccessful)
                 return ret;
             pIntNodeInfo->pPreqTxBuffer = &dllkInstance_g.pTxBuffer[handle];
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+            // the transmission time of the PReq is the start of the response time
+            dllkInstance_g.pTxBuffer[handle].m_pfnTxHandler = dllk_processTransmittedPreq;
+            dllkInstance_g.pTxBuffer[handle + 1].m_pfnTxHandler = dllk_processTransmittedPreq;
+#endif
         }
     }
 
@@ -2040,6 +2145,7 @@ tEplKernel dllk_setupSyncPhase(tNmtState nmtState_p, BOOL fReadyFlag_p,
     tFrameInfo          FrameInfo;
     tDllkNodeInfo*      pIntNodeInfo;
     BYTE                flag1;
+    UINT                listLen;
 
     // calculate WaitSoCPReq delay
     if (dllkInstance_g.dllConfigParam.waitSocPreq != 0)
@@ -2132,6 +2238,21 @@ tEplKernel dllk_setupSyncPhase(tNmtState nmtState_p, BOOL fReadyFlag_p,
     }
     *pCnNodeId = EPL_C_ADR_INVALID;    // mark last entry in node-ID list
 
+    // advance generation only if the node-ID list differs from the previous one
+    pCnNodeId++;
+    listLen = (UINT)(pCnNodeId - &dllkInstance_g.aCnNodeIdList[nextTxBufferOffset_p][0]);
+    if (EPL_MEMCMP(&dllkInstance_g.aCnNodeIdList[nextTxBufferOffset_p][0],
+                   &dllkInstance_g.aCnNodeIdList[nextTxBufferOffset_p ^ 1][0], listLen) != 0)
+    {
+        dllkInstance_g.aCnNodeIdListGen[nextTxBufferOffset_p] =
+                        dllkInstance_g.aCnNodeIdListGen[nextTxBufferOffset_p ^ 1] + 1;
+    }
+    else
+    {
+        dllkInstance_g.aCnNodeIdListGen[nextTxBufferOffset_p] =
+                        dllkInstance_g.aCnNodeIdListGen[nextTxBufferOffset_p ^ 1];
+    }
+
     return ret;
 }
 #endif
@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <dllcal.h>
 #include <kernel/dllkcal.h>
 #include <kernel/dllk.h>
+#include <kernel/dllktgt.h>
 
 #include <kernel/eventk.h>
 
@@ -83,9 +84,26 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define EPL_DLLKCAL_MAX_QUEUES  5   // CnGenReq, CnNmtReq, {MnGenReq, MnNmtReq}, MnIdentReq, MnStatusReq
 #endif
 
+#define DLLKCAL_REQ_BITMAP_WORDS    ((EPL_C_ADR_BROADCAST + 1) / 32)
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Pending request bitmap
+
+The structure contains the nodes with a pending IdentRequest or StatusRequest.
+Each node is represented by one bit, therefore a node is only requested once
+regardless how often the request is issued. The cursor points to the node
+which is checked first for the next request, so that all nodes are served in
+round-robin order.
+*/
+typedef struct
+{
+    UINT32                  aPending[DLLKCAL_REQ_BITMAP_WORDS]; ///< Bit n is set if node n has a pending request
+    UINT                    cursor;                            ///< Node ID to start the next search
+} tDllkCalReqBitmap;
+
 typedef struct
 {
     tDllCalQueueInstance    dllCalQueueTxNmt;       ///< Dll Cal Queue instance for NMT priority
@@ -101,12 +119,8 @@ typedef struct
     tDllkCalStatistics      statistics;
 
 #if (((EPL_MODULE_INTEGRATION) & (EPL_MODULE_NMT_MN)) != 0)
-    // IdentRequest queue with CN node IDs
-
-    tCircBufInstance*       pQueueIdentReq;
-
-    // StatusRequest queue with CN node IDs
-    tCircBufInstance*       pQueueStatusReq;
+    tDllkCalReqBitmap       identReq;               ///< Nodes with pending IdentRequest
+    tDllkCalReqBitmap       statusReq;              ///< Nodes with pending StatusRequest
 
     tCircBufInstance*       pQueueCnRequestNmt;
     UINT                    aCnRequestCntNmt[254];
@@ -122,6 +136,7 @@ typedef struct
 //------------------------------------------------------------------------------
 static tDllkCalInstance     instance_l;
 
+TGT_DLLK_DECLARE_CRITICAL_SECTION
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -132,6 +147,9 @@ static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
 static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
+static void setReqBitmapNode(tDllkCalReqBitmap* pBitmap_p, UINT nodeId_p);
+static BOOL getReqBitmapNode(tDllkCalReqBitmap* pBitmap_p, UINT* pNodeId_p);
+static UINT findFirstBit(UINT32 word_p);
 
 #if (EPL_DLL_PRES_CHAINING_MN != FALSE)
 static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p,
@@ -212,22 +230,6 @@ tEplKernel dllkcal_init(void)
         EPL_DBGLVL_ERROR_TRACE("%s() Allocate CIRCBUF_ASYNC_SCHED_GEN failed\n", __func__);
         goto Exit;
     }
-
-    circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_IDENT, DLLCAL_SIZE_CIRCBUF_REQ_IDENT,
-            &instance_l.pQueueIdentReq);
-    if(circErr != kCircBufOk)
-    {
-        EPL_DBGLVL_ERROR_TRACE("%s() Allocate CIRCBUF_DLLCAL_CN_REQ_IDENT failed\n", __func__);
-        goto Exit;
-    }
-
-    circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_STATUS, DLLCAL_SIZE_CIRCBUF_REQ_STATUS,
-            &instance_l.pQueueStatusReq);
-    if(circErr != kCircBufOk)
-    {
-        EPL_DBGLVL_ERROR_TRACE("%s() Allocate CIRCBUF_DLLCAL_CN_REQ_STATUS failed\n", __func__);
-        goto Exit;
-    }
 #endif
 
 Exit:
@@ -252,8 +254,6 @@ tEplKernel dllkcal_exit(void)
 #ifdef CONFIG_INCLUDE_NMT_MN
     circbuf_free(instance_l.pQueueCnRequestGen);
     circbuf_free(instance_l.pQueueCnRequestNmt);
-    circbuf_free(instance_l.pQueueIdentReq);
-    circbuf_free(instance_l.pQueueStatusReq);
 #endif
 
     instance_l.pTxNmtFuncs->pfnDelInstance(instance_l.dllCalQueueTxNmt);
@@ -645,8 +645,8 @@ tEplKernel dllkcal_clearAsyncQueues(void)
 
     circbuf_reset(instance_l.pQueueCnRequestGen);
     circbuf_reset(instance_l.pQueueCnRequestNmt);
-    circbuf_reset(instance_l.pQueueIdentReq);
-    circbuf_reset(instance_l.pQueueStatusReq);
+    EPL_MEMSET(&instance_l.identReq, 0, sizeof(tDllkCalReqBitmap));
+    EPL_MEMSET(&instance_l.statusReq, 0, sizeof(tDllkCalReqBitmap));
 
     return ret;
 }
@@ -688,6 +688,8 @@ tEplKernel dllkcal_getStatistics(tDllkCalStatistics** ppStatistics)
 \brief	Issue a StatusRequest or IdentRequest
 
 The function issues a StatusRequest or an IdentRequest to the specified node.
+The node is marked in the pending request bitmap of the service. If a request
+for the node is already pending, it is not issued a second time.
 
 \param  service_p               Service ID of request.
 \param  nodeId_p                Node ID to which the request should be sent.
@@ -703,7 +705,12 @@ tEplKernel dllkcal_issueRequest(tDllReqServiceId service_p, UINT nodeId_p,
                                   BYTE soaFlag1_p)
 {
     tEplKernel      ret = kEplSuccessful;
-    tCircBufError   err;
+
+    if ((nodeId_p == EPL_C_ADR_INVALID) || (nodeId_p >= EPL_C_ADR_BROADCAST))
+    {
+        ret = kEplDllInvalidParam;
+        goto Exit;
+    }
 
     if (soaFlag1_p != 0xFF)
     {
@@ -718,21 +725,11 @@ tEplKernel dllkcal_issueRequest(tDllReqServiceId service_p, UINT nodeId_p,
     switch (service_p)
     {
         case kDllReqServiceIdent:
-            err = circbuf_writeData(instance_l.pQueueIdentReq, &nodeId_p, sizeof(nodeId_p));
-            if(err != kCircBufOk)
-            {   // queue is full
-                ret = kEplDllAsyncTxBufferFull;
-                goto Exit;
-            }
+            setReqBitmapNode(&instance_l.identReq, nodeId_p);
             break;
 
         case kDllReqServiceStatus:
-            err = circbuf_writeData(instance_l.pQueueStatusReq, &nodeId_p, sizeof(nodeId_p));
-            if(err != kCircBufOk)
-            {   // queue is full
-                ret = kEplDllAsyncTxBufferFull;
-                goto Exit;
-            }
+            setReqBitmapNode(&instance_l.statusReq, nodeId_p);
             break;
 
         default:
@@ -1017,18 +1014,11 @@ The function returns the next MN ident request.
 //------------------------------------------------------------------------------
 static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
-
     // next queue will be MnStatusReq queue
     instance_l.nextRequestQueue = 4;
 
-    err = circbuf_readData(instance_l.pQueueIdentReq, &rxNodeId, size, &size);
-
-    if(err == kCircBufOk)
-    {   // queue is not empty
-        *pNodeId_p = rxNodeId;
+    if (getReqBitmapNode(&instance_l.identReq, pNodeId_p))
+    {
         *pReqServiceId_p = kDllReqServiceIdent;
         return TRUE;
     }
@@ -1052,9 +1042,6 @@ The function returns the next MN status request.
 //------------------------------------------------------------------------------
 static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
 #if EPL_DLL_PRES_CHAINING_MN != FALSE
     // next queue will be MnSyncReq queue
     instance_l.nextRequestQueue = 5;
@@ -1062,18 +1049,128 @@ static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_
     // next queue will be CnGenReq queue
     instance_l.nextRequestQueue = 0;
 #endif
-    err = circbuf_readData(instance_l.pQueueStatusReq, &rxNodeId, size, &size);
 
-    if(err == kCircBufOk)
-    {   // queue is not empty
-        *pNodeId_p = rxNodeId;
+    if (getReqBitmapNode(&instance_l.statusReq, pNodeId_p))
+    {
         *pReqServiceId_p = kDllReqServiceStatus;
         return TRUE;
     }
     return FALSE;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set node in pending request bitmap
+
+The function marks a node in the specified pending request bitmap. Setting an
+already pending node has no effect. The bitmap is read by the DLL within its
+critical section, therefore it is modified within the same section.
 
+\param  pBitmap_p               Pointer to the pending request bitmap.
+\param  nodeId_p                Node ID to be marked.
+*/
+//------------------------------------------------------------------------------
+static void setReqBitmapNode(tDllkCalReqBitmap* pBitmap_p, UINT nodeId_p)
+{
+    TGT_DLLK_DECLARE_FLAGS
+
+    TGT_DLLK_ENTER_CRITICAL_SECTION()
+    pBitmap_p->aPending[nodeId_p >> 5] |= (UINT32)1 << (nodeId_p & 0x1F);
+    TGT_DLLK_LEAVE_CRITICAL_SECTION()
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get next node from pending request bitmap
+
+The function searches the first pending node starting at the cursor of the
+bitmap and wraps around at the end of the bitmap. The found node is removed
+from the bitmap and the cursor is moved behind it. Thus, a node which is
+requested permanently cannot starve the other nodes.
+
+\param  pBitmap_p               Pointer to the pending request bitmap.
+\param  pNodeId_p               Pointer to store the found node ID.
+
+\return Returns if a pending node was found
+\retval TRUE        A pending node was found
+\retval FALSE       No node is pending
+*/
+//------------------------------------------------------------------------------
+static BOOL getReqBitmapNode(tDllkCalReqBitmap* pBitmap_p, UINT* pNodeId_p)
+{
+    UINT        wordIndex;
+    UINT        count;
+    UINT32      word;
+    UINT        nodeId;
+
+    wordIndex = pBitmap_p->cursor >> 5;
+    // ignore the nodes before the cursor in the first word, they are
+    // checked at last after wrap around
+    word = pBitmap_p->aPending[wordIndex] & ~(((UINT32)1 << (pBitmap_p->cursor & 0x1F)) - 1);
+
+    for (count = DLLKCAL_REQ_BITMAP_WORDS + 1; count > 0; count--)
+    {
+        if (word != 0)
+        {
+            nodeId = (wordIndex << 5) + findFirstBit(word);
+            pBitmap_p->aPending[wordIndex] &= ~((UINT32)1 << (nodeId & 0x1F));
+            pBitmap_p->cursor = (nodeId + 1) % (DLLKCAL_REQ_BITMAP_WORDS * 32);
+            *pNodeId_p = nodeId;
+            return TRUE;
+        }
+
+        wordIndex = (wordIndex + 1) % DLLKCAL_REQ_BITMAP_WORDS;
+        word = pBitmap_p->aPending[wordIndex];
+    }
+
+    return FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Find first set bit
+
+The function returns the index of the least significant set bit of a word.
+
+\param  word_p                  Word to be searched. It must not be 0.
+
+\return The function returns the bit index.
+*/
+//------------------------------------------------------------------------------
+static UINT findFirstBit(UINT32 word_p)
+{
+#if defined(__GNUC__)
+    return (UINT)__builtin_ctz(word_p);
+#else
+    UINT        bit = 0;
+
+    if ((word_p & 0x0000FFFF) == 0)
+    {
+        bit += 16;
+        word_p >>= 16;
+    }
+    if ((word_p & 0x000000FF) == 0)
+    {
+        bit += 8;
+        word_p >>= 8;
+    }
+    if ((word_p & 0x0000000F) == 0)
+    {
+        bit += 4;
+        word_p >>= 4;
+    }
+    if ((word_p & 0x00000003) == 0)
+    {
+        bit += 2;
+        word_p >>= 2;
+    }
+    if ((word_p & 0x00000001) == 0)
+    {
+        bit += 1;
+    }
+    return bit;
+#endif
+}
 
 #if EPL_DLL_PRES_CHAINING_MN != FALSE
 //------------------------------------------------------------------------------
@@ -208,7 +208,7 @@ tEplKernel dllk_issueLossOfPres(UINT nodeId_p)
 
             event.m_EventSink = kEplEventSinkDllkCal;
             event.m_EventType = kEplEventTypeDllkDelNode;
-            // $$$ d.k. set Event.m_NetTime to current time
+            EPL_MEMSET(&event.m_NetTime, 0x00, sizeof(event.m_NetTime));
             event.m_uiSize = sizeof (nodeOpParam);
             event.m_pArg = &nodeOpParam;
             eventk_postEvent(&event);
@@ -938,6 +938,23 @@ static tEplKernel processSyncMn(tNmtState nmtState_p, BOOL fReadyFlag_p)
     AmiSetQword64ToLe( &pTxFrame->m_Data.m_Soc.m_le_RelativeTime, dllkInstance_g.relativeTime);
     dllkInstance_g.relativeTime += dllkInstance_g.dllConfigParam.cycleLen;
 
+#if defined(CONFIG_TARGET_NETTIME)
+    {
+        tEplNetTime     netTime;
+        UINT64          nanoSec;
+
+        // Set SoC net time
+        // the SoC is prepared one cycle in advance, so the start of the
+        // next cycle is estimated by adding the cycle length (in us)
+        EplTgtGetNetTime(&netTime);
+        nanoSec = (UINT64) netTime.m_dwNanoSec + ((UINT64) dllkInstance_g.dllConfigParam.cycleLen * 1000);
+        netTime.m_dwSec += (DWORD) (nanoSec / 1000000000);
+        netTime.m_dwNanoSec = (DWORD) (nanoSec % 1000000000);
+        AmiSetDwordToLe(&pTxFrame->m_Data.m_Soc.m_le_NetTime.m_dwSec, netTime.m_dwSec);
+        AmiSetDwordToLe(&pTxFrame->m_Data.m_Soc.m_le_NetTime.m_dwNanoSec, netTime.m_dwNanoSec);
+    }
+#endif
+
     if (dllkInstance_g.ppTxBufferList == NULL)
         return ret;
 
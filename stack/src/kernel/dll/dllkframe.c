@@ -80,8 +80,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 static tEplKernel processReceivedPreq(tFrameInfo* pFrameInfo_p, tNmtState nmtState_p,
                                       tEdrvReleaseRxBuffer* pReleaseRxBuffer_p);
-static tEplKernel processReceivedPres(tFrameInfo* pFrameInfo_p, tNmtState nmtState_p,
-                                      tNmtEvent* pNmtEvent_p, tEdrvReleaseRxBuffer* pReleaseRxBuffer_p);
+static tEplKernel processReceivedPres(tFrameInfo* pFrameInfo_p, tEdrvRxBuffer* pRxBuffer_p,
+                                      tNmtState nmtState_p, tNmtEvent* pNmtEvent_p,
+                                      tEdrvReleaseRxBuffer* pReleaseRxBuffer_p);
 static tEplKernel processReceivedSoc(tEdrvRxBuffer* pRxBuffer_p, tNmtState nmtState_p);
 static tEplKernel processReceivedSoa(tEdrvRxBuffer* pRxBuffer_p, tNmtState nmtState_p);
 static tEplKernel processReceivedAsnd(tFrameInfo* pFrameInfo_p, tEdrvRxBuffer* pRxBuffer_p,
@@ -209,7 +210,7 @@ tEdrvReleaseRxBuffer dllk_processFrameReceived(tEdrvRxBuffer * pRxBuffer_p)
             break;
 
         case kEplMsgTypePres:
-            ret = processReceivedPres(&frameInfo, nmtState, &nmtEvent, &releaseRxBuffer);
+            ret = processReceivedPres(&frameInfo, pRxBuffer_p, nmtState, &nmtEvent, &releaseRxBuffer);
             if (ret != kEplSuccessful)
                 goto Exit;
             break;
@@ -248,12 +249,19 @@ tEdrvReleaseRxBuffer dllk_processFrameReceived(tEdrvRxBuffer * pRxBuffer_p)
         if ((nmtEvent != kNmtEventDllCeAsnd) &&
             ((nmtState <= kNmtCsPreOperational1) || (nmtEvent != kNmtEventDllCePres)))
         {   // NMT state machine is not interested in ASnd frames and PRes frames when not CsNotActive or CsPreOp1
-            // inform NMT module
-            event.m_EventSink = kEplEventSinkNmtk;
-            event.m_EventType = kEplEventTypeNmtEvent;
-            event.m_uiSize = sizeof (nmtEvent);
-            event.m_pArg = &nmtEvent;
-            ret = eventk_postEvent(&event);
+            if ((dllkInstance_g.nmtEventMask & (1 << (nmtEvent - kNmtEventDllCeSoc))) != 0)
+            {   // inform NMT module
+                event.m_EventSink = kEplEventSinkNmtk;
+                event.m_EventType = kEplEventTypeNmtEvent;
+                event.m_uiSize = sizeof (nmtEvent);
+                event.m_pArg = &nmtEvent;
+                ret = eventk_postEvent(&event);
+                dllkInstance_g.nmtEventStatistics.postedCount++;
+            }
+            else
+            {   // NMT state machine ignores this event in its current state
+                dllkInstance_g.nmtEventStatistics.aSuppressedCount[nmtEvent - kNmtEventDllCeSoc]++;
+            }
         }
     }
 
@@ -592,6 +600,38 @@ Exit:
     TGT_DLLK_LEAVE_CRITICAL_SECTION()
     return;
 }
+
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+//------------------------------------------------------------------------------
+/**
+\brief  Process transmitted PReq frame
+
+The function is called by the Ethernet driver when a PReq frame has been
+transmitted. It saves the transmission time as start of the response time
+of the addressed CN.
+
+\param  pTxBuffer_p         Pointer to TxBuffer structure of transmitted frame.
+*/
+//------------------------------------------------------------------------------
+void dllk_processTransmittedPreq(tEdrvTxBuffer * pTxBuffer_p)
+{
+    tEplFrame*      pTxFrame;
+    TGT_DLLK_DECLARE_FLAGS
+
+    if (pTxBuffer_p->m_pTgtTimeStamp == NULL)
+    {   // Ethernet driver does not provide time stamps
+        return;
+    }
+
+    TGT_DLLK_ENTER_CRITICAL_SECTION()
+
+    pTxFrame = (tEplFrame *) pTxBuffer_p->m_pbBuffer;
+    dllkInstance_g.preqPrevNodeId = AmiGetByteFromLe(&pTxFrame->m_le_bDstNodeId);
+    EplTgtTimeStampCopy(dllkInstance_g.pPreqPrevTimeStamp, pTxBuffer_p->m_pTgtTimeStamp);
+
+    TGT_DLLK_LEAVE_CRITICAL_SECTION()
+}
+#endif
 #endif
 
 //------------------------------------------------------------------------------
@@ -1423,6 +1463,7 @@ Exit:
 The function processes a received PRes frame.
 
 \param  pFrameInfo_p        Pointer to frame information.
+\param  pRxBuffer_p         Pointer to RxBuffer structure of received frame.
 \param  nmtState_p          NMT state of the local node.
 \param  pNmtEvent_p         Pointer to store NMT event.
 \param  pReleaseRxBuffer_p  Pointer to buffer release flag. The function must
@@ -1432,8 +1473,9 @@ The function processes a received PRes frame.
 \return The function returns a tEplKernel error code.
 */
 //------------------------------------------------------------------------------
-static tEplKernel processReceivedPres(tFrameInfo* pFrameInfo_p, tNmtState nmtState_p,
-                                      tNmtEvent* pNmtEvent_p, tEdrvReleaseRxBuffer* pReleaseRxBuffer_p)
+static tEplKernel processReceivedPres(tFrameInfo* pFrameInfo_p, tEdrvRxBuffer* pRxBuffer_p,
+                                      tNmtState nmtState_p, tNmtEvent* pNmtEvent_p,
+                                      tEdrvReleaseRxBuffer* pReleaseRxBuffer_p)
 {
     tEplKernel      ret = kEplSuccessful;
     tEplFrame*      pFrame;
@@ -1443,6 +1485,8 @@ static tEplKernel processReceivedPres(tFrameInfo* pFrameInfo_p, tNmtState nmtSta
     tDllkNodeInfo*  pIntNodeInfo = NULL;
 #endif
 
+    UNUSED_PARAMETER(pRxBuffer_p);
+
     pFrame = pFrameInfo_p->pFrame;
     nodeId = AmiGetByteFromLe(&pFrame->m_le_bSrcNodeId);
 
@@ -1514,6 +1558,16 @@ static tEplKernel processReceivedPres(tFrameInfo* pFrameInfo_p, tNmtState nmtSta
             goto Exit;
         }
 
+#if defined(CONFIG_DLL_RESPONSE_TIME_HIST)
+        if ((pRxBuffer_p->m_pTgtTimeStamp != NULL) && (dllkInstance_g.preqPrevNodeId == nodeId))
+        {   // PReq to this CN was time stamped -> account response time
+            dllk_updateResponseTimeHist(&pIntNodeInfo->responseTimeHist,
+                                        EplTgtTimeStampTimeDiffNs(dllkInstance_g.pPreqPrevTimeStamp,
+                                                                  pRxBuffer_p->m_pTgtTimeStamp));
+            dllkInstance_g.preqPrevNodeId = EPL_C_ADR_INVALID;
+        }
+#endif
+
 #if EPL_DLL_PRES_CHAINING_MN != FALSE
         if (fPrcSlotFinished != FALSE)
         {
@@ -1576,7 +1630,7 @@ static tEplKernel processReceivedPres(tFrameInfo* pFrameInfo_p, tNmtState nmtSta
 
                 event.m_EventSink = kEplEventSinkDllkCal;
                 event.m_EventType = kEplEventTypeDllkDelNode;
-                // $$$ d.k. set Event.m_NetTime to current time
+                EPL_MEMSET(&event.m_NetTime, 0x00, sizeof(event.m_NetTime));
                 event.m_uiSize = sizeof (nodeOpParam);
                 event.m_pArg = &nodeOpParam;
             }
@@ -0,0 +1,143 @@
+/**
+********************************************************************************
+\file   dllkresptime.c
+
+\brief  PRes response time histograms of the DLL
+
+This file contains the functions which collect the time between the
+transmission of a PReq and the reception of the corresponding PRes in a
+histogram. The MN keeps one histogram per CN. The functions don't depend on
+the Ethernet driver, therefore they can be fed with the time stamps of pcap
+savefiles as well.
+
+\ingroup module_dllk
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <kernel/dllk.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset a response time histogram
+
+The function clears all bins and counters of a response time histogram.
+
+\param  pHist_p             Pointer to histogram.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_resetResponseTimeHist(tDllkResponseTimeHist* pHist_p)
+{
+    EPL_MEMSET(pHist_p, 0, sizeof (*pHist_p));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add a response time to a histogram
+
+The function accounts one response time in the histogram. The response time
+is sorted into the bin of its binary logarithm, so that the histogram covers
+the range from a few microseconds up to several cycles with a fixed number of
+bins.
+
+\param  pHist_p             Pointer to histogram.
+\param  responseTimeNs_p    Time between PReq and PRes in ns.
+
+\ingroup module_dllk
+*/
+//------------------------------------------------------------------------------
+void dllk_updateResponseTimeHist(tDllkResponseTimeHist* pHist_p, UINT32 responseTimeNs_p)
+{
+    UINT        bin = 0;
+    UINT32      limit = responseTimeNs_p >> DLLK_RESPTIME_HIST_SHIFT;
+
+    while ((limit != 0) && (bin < (DLLK_RESPTIME_HIST_BINS - 1)))
+    {
+        limit >>= 1;
+        bin++;
+    }
+    pHist_p->aBin[bin]++;
+
+    if ((pHist_p->count == 0) || (responseTimeNs_p < pHist_p->minNs))
+        pHist_p->minNs = responseTimeNs_p;
+    if (responseTimeNs_p > pHist_p->maxNs)
+        pHist_p->maxNs = responseTimeNs_p;
+
+    pHist_p->sumNs += responseTimeNs_p;
+    pHist_p->count++;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
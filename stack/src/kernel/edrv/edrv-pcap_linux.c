@@ -54,6 +54,8 @@
 ****************************************************************************/
 
 #include "edrv.h"
+#include <EdrvPcapFilter.h>
+#include <timestamp_linuxuser.h>
 
 #include <unistd.h>
 #include <pcap.h>
@@ -115,6 +117,13 @@
 //---------------------------------------------------------------------------
 #define EDRV_MAX_FRAME_SIZE     0x600
 
+#ifndef PCAP_NETMASK_UNKNOWN
+#define PCAP_NETMASK_UNKNOWN    0xffffffff      // not defined by libpcap < 1.1
+#endif
+
+#define EDRV_PCAP_SNAPLEN       65535
+#define EDRV_PCAP_TIMEOUT_MS    1
+
 //---------------------------------------------------------------------------
 // local types
 //---------------------------------------------------------------------------
@@ -130,6 +139,10 @@ typedef struct
     pcap_t*             m_pPcap;
     pcap_t*             m_pPcapThread;
     pthread_t           m_hThread;
+    pthread_mutex_t     m_filterMutex;      // protects the filter set
+    tEdrvPcapFilterSet  m_filterSet;        // Rx filter and multicast entries
+    char                m_szFilterExpr[EDRVPCAP_FILTER_EXPR_SIZE];
+    BOOL                m_fNanoPrecision;   // capture time stamps contain ns instead of us
 } tEdrvInstance;
 
 //---------------------------------------------------------------------------
@@ -142,6 +155,8 @@ static tEdrvInstance EdrvInstance_l;
 //---------------------------------------------------------------------------
 static void EdrvPacketHandler(u_char *param, const struct pcap_pkthdr *header, const u_char *pkt_data);
 static void *EdrvWorkerThread(void *);
+static tEplKernel EdrvApplyFilter(tEdrvInstance* pInstance_p);
+static pcap_t* EdrvOpenCapture(tEdrvInstance* pInstance_p, char* pszErrMsg_p);
 
 //---------------------------------------------------------------------------
 // Function:            getMacAdrs
@@ -223,7 +238,6 @@ tEplKernel EdrvInit(tEdrvInitParam *pEdrvInitParam_p)
 {
     tEplKernel                  Ret;
     char                        sErr_Msg[PCAP_ERRBUF_SIZE];
-    struct sched_param          schedParam;
 
     Ret = kEplSuccessful;
 
@@ -252,6 +266,8 @@ tEplKernel EdrvInit(tEdrvInitParam *pEdrvInitParam_p)
 
     // save the init data (with updated MAC address)
     EdrvInstance_l.m_initParam = *pEdrvInitParam_p;
+    EPL_MEMCPY(EdrvInstance_l.m_filterSet.abMyMacAddr,
+               pEdrvInitParam_p->m_abMyMacAddr, 6);
 
     EdrvInstance_l.m_pPcap = pcap_open_live (
                         EdrvInstance_l.m_initParam.m_HwParam.m_pszDevName,
@@ -283,6 +299,13 @@ tEplKernel EdrvInit(tEdrvInitParam *pEdrvInitParam_p)
         goto Exit;
     }
 
+    if (pthread_mutex_init(&EdrvInstance_l.m_filterMutex, NULL) != 0)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() couldn't init filter mutex\n", __func__);
+        Ret = kEplEdrvInitError;
+        goto Exit;
+    }
+
     if (sem_init(&EdrvInstance_l.m_syncSem, 0, 0) != 0)
     {
         EPL_DBGLVL_ERROR_TRACE("%s() couldn't init semaphore\n", __func__);
@@ -298,8 +321,8 @@ tEplKernel EdrvInit(tEdrvInitParam *pEdrvInitParam_p)
         goto Exit;
     }
 
-    schedParam.__sched_priority = EPL_THREAD_PRIORITY_MEDIUM;
-    if (pthread_setschedparam(EdrvInstance_l.m_hThread, SCHED_FIFO, &schedParam) != 0)
+    if (target_setThreadSchedParam(EdrvInstance_l.m_hThread, kEplThreadEdrvRx,
+                                   SCHED_FIFO, EPL_THREAD_PRIORITY_MEDIUM) != 0)
     {
         EPL_DBGLVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n",
                                 __func__);
@@ -333,6 +356,7 @@ tEplKernel EdrvShutdown( void )
     pcap_close(EdrvInstance_l.m_pPcap);
 
     pthread_mutex_destroy(&EdrvInstance_l.m_mutex);
+    pthread_mutex_destroy(&EdrvInstance_l.m_filterMutex);
 
     // clear instance structure
     EPL_MEMSET(&EdrvInstance_l, 0, sizeof (EdrvInstance_l));
@@ -368,6 +392,7 @@ tEplKernel EdrvSendTxMsg(tEdrvTxBuffer *pBuffer_p)
          * tx handler! Otherwise the stack would hang! */
         if (pBuffer_p->m_pfnTxHandler != NULL)
         {
+            pBuffer_p->m_pTgtTimeStamp = NULL;
             pBuffer_p->m_pfnTxHandler(pBuffer_p);
         }
     }
@@ -429,6 +454,7 @@ tEplKernel EdrvAllocTxMsgBuffer(tEdrvTxBuffer * pBuffer_p)
     }
 
     pBuffer_p->m_BufferNumber.m_pVal = NULL;
+    pBuffer_p->m_pTgtTimeStamp = NULL;
 
 Exit:
     return Ret;
@@ -459,7 +485,9 @@ tEplKernel EdrvReleaseTxMsgBuffer(tEdrvTxBuffer * pBuffer_p)
 // Function:    EdrvChangeFilter
 //
 // Description: Change all rx-filters or one specific rx-filter
-//              of the openMAC
+//              The enabled rx-filters are compiled into a BPF program which
+//              is installed in the kernel. Thus, frames which are not needed
+//              by the DLL are dropped before they reach the worker thread.
 //
 // Parameters:  pFilter_p           = pointer to array of filter entries
 //              uiCount_p           = number of filters in array
@@ -481,12 +509,23 @@ tEplKernel EdrvReleaseTxMsgBuffer(tEdrvTxBuffer * pBuffer_p)
 // Returns:     Errorcode           = kEplSuccessful
 //                                  = kEplEdrvInvalidParam
 //---------------------------------------------------------------------------
-tEplKernel EdrvChangeFilter(tEdrvFilter*    pFilter_p __attribute__((unused)),
-                            unsigned int    uiCount_p __attribute__((unused)),
+tEplKernel EdrvChangeFilter(tEdrvFilter*    pFilter_p,
+                            unsigned int    uiCount_p,
                             unsigned int    uiEntryChanged_p __attribute__((unused)),
                             unsigned int    uiChangeFlags_p __attribute__((unused)))
 {
-    return kEplSuccessful;
+    tEplKernel  Ret;
+
+    // the whole filter array is evaluated, even if only one entry changed
+    pthread_mutex_lock(&EdrvInstance_l.m_filterMutex);
+    Ret = EdrvPcapSetFilterEntries(&EdrvInstance_l.m_filterSet, pFilter_p, uiCount_p);
+    if (Ret == kEplSuccessful)
+    {
+        Ret = EdrvApplyFilter(&EdrvInstance_l);
+    }
+    pthread_mutex_unlock(&EdrvInstance_l.m_filterMutex);
+
+    return Ret;
 }
 
 //---------------------------------------------------------------------------
@@ -499,9 +538,19 @@ tEplKernel EdrvChangeFilter(tEdrvFilter*    pFilter_p __attribute__((unused)),
 //
 // Returns:     Errorcode       = kEplSuccessful
 //---------------------------------------------------------------------------
-tEplKernel EdrvUndefineRxMacAddrEntry (BYTE * pbMacAddr_p __attribute__((unused)))
+tEplKernel EdrvUndefineRxMacAddrEntry (BYTE * pbMacAddr_p)
 {
-    return kEplSuccessful;
+    tEplKernel  Ret;
+
+    pthread_mutex_lock(&EdrvInstance_l.m_filterMutex);
+    Ret = EdrvPcapRemoveMulticast(&EdrvInstance_l.m_filterSet, pbMacAddr_p);
+    if (Ret == kEplSuccessful)
+    {
+        Ret = EdrvApplyFilter(&EdrvInstance_l);
+    }
+    pthread_mutex_unlock(&EdrvInstance_l.m_filterMutex);
+
+    return Ret;
 }
 
 //---------------------------------------------------------------------------
@@ -513,10 +562,76 @@ tEplKernel EdrvUndefineRxMacAddrEntry (BYTE * pbMacAddr_p __attribute__((unused)
 // Parameters:  pbMacAddr_p     = pointer to multicast entry to set
 //
 // Returns:     Errorcode       = kEplSuccessful
+//                              = kEplEdrvNoFreeBufEntry
 //---------------------------------------------------------------------------
-tEplKernel EdrvDefineRxMacAddrEntry (BYTE * pbMacAddr_p __attribute__((unused)))
+tEplKernel EdrvDefineRxMacAddrEntry (BYTE * pbMacAddr_p)
 {
-    return kEplSuccessful;
+    tEplKernel  Ret;
+
+    pthread_mutex_lock(&EdrvInstance_l.m_filterMutex);
+    Ret = EdrvPcapAddMulticast(&EdrvInstance_l.m_filterSet, pbMacAddr_p);
+    if (Ret == kEplSuccessful)
+    {
+        Ret = EdrvApplyFilter(&EdrvInstance_l);
+    }
+    pthread_mutex_unlock(&EdrvInstance_l.m_filterMutex);
+
+    return Ret;
+}
+
+//---------------------------------------------------------------------------
+//
+// Function:    EdrvApplyFilter
+//
+// Description: Compile the filter set into a BPF program and install it
+//              in the kernel. If the filter expression cannot be built,
+//              all frames are passed. The filter mutex must be locked.
+//
+// Parameters:  pInstance_p     = pointer to instance structure
+//
+// Returns:     Errorcode       = kEplSuccessful
+//                              = kEplEdrvInvalidParam
+//---------------------------------------------------------------------------
+static tEplKernel EdrvApplyFilter(tEdrvInstance* pInstance_p)
+{
+    tEplKernel          Ret;
+    struct bpf_program  program;
+
+    if (pInstance_p->m_pPcapThread == NULL)
+    {   // filter is applied when the worker thread opens its pcap handle
+        return kEplSuccessful;
+    }
+
+    Ret = EdrvPcapBuildFilterExpr(&pInstance_p->m_filterSet, pInstance_p->m_szFilterExpr,
+                                  sizeof(pInstance_p->m_szFilterExpr));
+    if (Ret != kEplSuccessful)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() filter expression too long, passing all frames\n",
+                               __func__);
+    }
+
+    if (pcap_compile(pInstance_p->m_pPcapThread, &program, pInstance_p->m_szFilterExpr,
+                     1, PCAP_NETMASK_UNKNOWN) < 0)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() couldn't compile filter: %s\n", __func__,
+                               pcap_geterr(pInstance_p->m_pPcapThread));
+        return kEplEdrvInvalidParam;
+    }
+
+    if (pcap_setfilter(pInstance_p->m_pPcapThread, &program) < 0)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() couldn't set filter: %s\n", __func__,
+                               pcap_geterr(pInstance_p->m_pPcapThread));
+        Ret = kEplEdrvInvalidParam;
+    }
+    else
+    {
+        Ret = kEplSuccessful;
+    }
+
+    pcap_freecode(&program);
+
+    return Ret;
 }
 
 //---------------------------------------------------------------------------
@@ -536,14 +651,18 @@ static void EdrvPacketHandler(u_char *pUser_p,
                               const struct pcap_pkthdr *header,
                               const u_char *pkt_data)
 {
-    tEdrvInstance*  pInstance = (tEdrvInstance*) pUser_p;
-    tEdrvRxBuffer   RxBuffer;
+    tEdrvInstance*      pInstance = (tEdrvInstance*) pUser_p;
+    tEdrvRxBuffer       RxBuffer;
+    tEplTgtTimeStamp    TimeStamp;
+
+    EplTgtTimeStampSetTimeval(&TimeStamp, &header->ts, pInstance->m_fNanoPrecision);
 
     if (memcmp (pkt_data + 6, pInstance->m_initParam.m_abMyMacAddr, 6 ) != 0)
     {   // filter out self generated traffic
         RxBuffer.m_BufferInFrame    = kEdrvBufferLastInFrame;
         RxBuffer.m_uiRxMsgLen       = header->caplen;
         RxBuffer.m_pbBuffer         = (BYTE*) pkt_data;
+        RxBuffer.m_pTgtTimeStamp    = &TimeStamp;
 
         FTRACE_MARKER("%s RX", __func__);
         pInstance->m_initParam.m_pfnRxHandler(&RxBuffer);
@@ -572,8 +691,10 @@ static void EdrvPacketHandler(u_char *pUser_p,
                     pTxBuffer->m_BufferNumber.m_pVal = NULL;
 
                     if (pTxBuffer->m_pfnTxHandler != NULL)
-                    {
+                    {   // the capture time of the own frame is its transmission time
+                        pTxBuffer->m_pTgtTimeStamp = &TimeStamp;
                         pTxBuffer->m_pfnTxHandler(pTxBuffer);
+                        pTxBuffer->m_pTgtTimeStamp = NULL;
                     }
                 }
                 else
@@ -627,12 +748,7 @@ static void * EdrvWorkerThread(void *pArgument_p)
 
     EPL_DBGLVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
 
-    pInstance->m_pPcapThread =
-        pcap_open_live (pInstance->m_initParam.m_HwParam.m_pszDevName,
-                           65535,  // snaplen
-                           1,      // promiscuous mode
-                           1,      // milli seconds read timeout
-                           sErr_Msg);
+    pInstance->m_pPcapThread = EdrvOpenCapture(pInstance, sErr_Msg);
 
    if (pInstance->m_pPcapThread == NULL)
    {
@@ -646,6 +762,11 @@ static void * EdrvWorkerThread(void *pArgument_p)
        EPL_DBGLVL_ERROR_TRACE("%s() couldn't set PCAP direction1\n", __func__);
    }
 
+   // install the initial filter, only own, unicast and broadcast frames pass
+   pthread_mutex_lock(&pInstance->m_filterMutex);
+   EdrvApplyFilter(pInstance);
+   pthread_mutex_unlock(&pInstance->m_filterMutex);
+
    /* signal that thread is successfully started */
    sem_post(&pInstance->m_syncSem);
 
@@ -674,3 +795,73 @@ static void * EdrvWorkerThread(void *pArgument_p)
 }
 
 
+
+//---------------------------------------------------------------------------
+// Function:    EdrvOpenCapture
+//
+// Description: Open the pcap capture handle of the worker thread.
+//              Nanosecond time stamps are requested and, if the network
+//              adapter supports it, the time stamps are taken by the
+//              adapter instead of the host. Otherwise the capture falls
+//              back to the host time stamps of libpcap.
+//
+// Parameters:  pInstance_p     = pointer to instance structure
+//              pszErrMsg_p     = buffer of size PCAP_ERRBUF_SIZE for the
+//                                error message
+//
+// Returns:     pcap_t*         = capture handle or NULL on error
+//---------------------------------------------------------------------------
+static pcap_t* EdrvOpenCapture(tEdrvInstance* pInstance_p, char* pszErrMsg_p)
+{
+    pcap_t*     pPcap;
+    int         iRet;
+
+    pInstance_p->m_fNanoPrecision = FALSE;
+
+    pPcap = pcap_create(pInstance_p->m_initParam.m_HwParam.m_pszDevName, pszErrMsg_p);
+    if (pPcap == NULL)
+    {
+        return NULL;
+    }
+
+    pcap_set_snaplen(pPcap, EDRV_PCAP_SNAPLEN);
+    pcap_set_promisc(pPcap, 1);
+    pcap_set_timeout(pPcap, EDRV_PCAP_TIMEOUT_MS);
+
+#ifdef PCAP_TSTAMP_ADAPTER
+    // adapter time stamps which are synchronized to the host clock,
+    // so that the time stamps of transmitted frames are comparable
+    if (pcap_set_tstamp_type(pPcap, PCAP_TSTAMP_ADAPTER) != 0)
+    {
+        EPL_DBGLVL_EDRV_TRACE("%s() adapter time stamps not supported, using host time stamps\n",
+                              __func__);
+    }
+#endif
+
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+    if (pcap_set_tstamp_precision(pPcap, PCAP_TSTAMP_PRECISION_NANO) != 0)
+    {
+        EPL_DBGLVL_EDRV_TRACE("%s() nanosecond time stamps not supported\n", __func__);
+    }
+#endif
+
+    iRet = pcap_activate(pPcap);
+    if (iRet < 0)
+    {
+        snprintf(pszErrMsg_p, PCAP_ERRBUF_SIZE, "%s", pcap_geterr(pPcap));
+        pcap_close(pPcap);
+        return NULL;
+    }
+    else if (iRet > 0)
+    {
+        EPL_DBGLVL_EDRV_TRACE("%s() pcap_activate warning: %s\n", __func__,
+                              pcap_geterr(pPcap));
+    }
+
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+    pInstance_p->m_fNanoPrecision =
+        (pcap_get_tstamp_precision(pPcap) == PCAP_TSTAMP_PRECISION_NANO) ? TRUE : FALSE;
+#endif
+
+    return pPcap;
+}
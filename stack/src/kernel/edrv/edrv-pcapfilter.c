@@ -0,0 +1,402 @@
+/**
+********************************************************************************
+\file   edrv-pcapfilter.c
+
+\brief  Receive filter of the pcap Ethernet driver
+
+This file contains the functions which build the pcap filter expression of
+the pcap Ethernet driver. The filter set consists of the Rx filter entries
+which are set by the DLL (see dllkfilter.c) and the multicast entries. The
+functions don't depend on libpcap, therefore the expressions can be checked
+without a network interface.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, SYSTEC electronic GmbH
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EdrvPcapFilter.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRVPCAP_FILTER_LEN     22      // number of bytes of a filter entry
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Expression buffer
+
+The structure is used to append text to the filter expression. If the buffer
+overflows, the overflow flag is set and further text is ignored.
+*/
+typedef struct
+{
+    char*           pszExpr;            ///< Expression buffer
+    size_t          size;               ///< Size of the expression buffer
+    size_t          len;                ///< Current length of the expression
+    BOOL            fOverflow;          ///< Buffer is too small for the expression
+} tExprBuffer;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void appendExpr(tExprBuffer* pBuffer_p, const char* pszFormat_p, ...);
+static void appendMacExpr(tExprBuffer* pBuffer_p, const char* pszDir_p, const BYTE* pbMacAddr_p);
+static BOOL appendFilterExpr(tExprBuffer* pBuffer_p, const tEdrvFilter* pFilter_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set filter entries
+
+The function copies the Rx filter entries of the DLL into the filter set. If
+pFilter_p is NULL or count_p is 0, all filter entries are removed and the
+multicast entries are used for filtering.
+
+\param  pFilterSet_p        Pointer to the filter set.
+\param  pFilter_p           Base pointer of Rx filter array.
+\param  count_p             Number of Rx filter array entries.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvPcapSetFilterEntries(tEdrvPcapFilterSet* pFilterSet_p,
+                                    tEdrvFilter* pFilter_p, UINT count_p)
+{
+    if ((pFilter_p == NULL) || (count_p == 0))
+    {
+        pFilterSet_p->filterCount = 0;
+        pFilterSet_p->fFilterOverflow = FALSE;
+        return kEplSuccessful;
+    }
+
+    if (count_p > EDRVPCAP_MAX_FILTERS)
+    {   // keep the filter entries but let all frames pass
+        pFilterSet_p->filterCount = 0;
+        pFilterSet_p->fFilterOverflow = TRUE;
+        return kEplSuccessful;
+    }
+
+    EPL_MEMCPY(pFilterSet_p->aFilter, pFilter_p, count_p * sizeof(tEdrvFilter));
+    pFilterSet_p->filterCount = count_p;
+    pFilterSet_p->fFilterOverflow = FALSE;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add multicast entry
+
+The function adds a multicast MAC address to the filter set. Adding an
+address which is already contained has no effect.
+
+\param  pFilterSet_p        Pointer to the filter set.
+\param  pbMacAddr_p         Multicast MAC address to be added.
+
+\return The function returns a tEplKernel error code.
+\retval kEplSuccessful          The address was added.
+\retval kEplEdrvNoFreeBufEntry  No free multicast entry is available.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvPcapAddMulticast(tEdrvPcapFilterSet* pFilterSet_p, BYTE* pbMacAddr_p)
+{
+    UINT        index;
+
+    for (index = 0; index < pFilterSet_p->multicastCount; index++)
+    {
+        if (EPL_MEMCMP(pFilterSet_p->aabMulticastMac[index], pbMacAddr_p, 6) == 0)
+            return kEplSuccessful;
+    }
+
+    if (pFilterSet_p->multicastCount >= EDRVPCAP_MAX_MULTICAST)
+        return kEplEdrvNoFreeBufEntry;
+
+    EPL_MEMCPY(pFilterSet_p->aabMulticastMac[pFilterSet_p->multicastCount], pbMacAddr_p, 6);
+    pFilterSet_p->multicastCount++;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove multicast entry
+
+The function removes a multicast MAC address from the filter set.
+
+\param  pFilterSet_p        Pointer to the filter set.
+\param  pbMacAddr_p         Multicast MAC address to be removed.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvPcapRemoveMulticast(tEdrvPcapFilterSet* pFilterSet_p, BYTE* pbMacAddr_p)
+{
+    UINT        index;
+
+    for (index = 0; index < pFilterSet_p->multicastCount; index++)
+    {
+        if (EPL_MEMCMP(pFilterSet_p->aabMulticastMac[index], pbMacAddr_p, 6) == 0)
+        {
+            pFilterSet_p->multicastCount--;
+            EPL_MEMCPY(pFilterSet_p->aabMulticastMac[index],
+                       pFilterSet_p->aabMulticastMac[pFilterSet_p->multicastCount], 6);
+            break;
+        }
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build pcap filter expression
+
+The function builds a pcap filter expression from the filter set. The
+expression accepts the following frames:
+- frames sent by the own MAC address, they are needed to confirm the
+  transmission of TX buffers
+- frames addressed to the own MAC address and broadcast frames, they carry
+  unicast POWERLINK frames and the traffic of the virtual Ethernet interface
+- frames matching an enabled Rx filter entry of the DLL or, if the DLL hasn't
+  set any Rx filter entries, frames addressed to a multicast entry
+
+If all frames shall be accepted, an empty expression is returned.
+
+\param  pFilterSet_p        Pointer to the filter set.
+\param  pszExpr_p           Buffer to store the expression.
+\param  size_p              Size of the buffer.
+
+\return The function returns a tEplKernel error code.
+\retval kEplSuccessful          The expression was built.
+\retval kEplEdrvInvalidParam    The buffer is too small for the expression.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvPcapBuildFilterExpr(tEdrvPcapFilterSet* pFilterSet_p,
+                                   char* pszExpr_p, size_t size_p)
+{
+    tExprBuffer     buffer;
+    UINT            index;
+
+    if (size_p == 0)
+        return kEplEdrvInvalidParam;
+
+    buffer.pszExpr = pszExpr_p;
+    buffer.size = size_p;
+    buffer.len = 0;
+    buffer.fOverflow = FALSE;
+    pszExpr_p[0] = '\0';
+
+    if (pFilterSet_p->fFilterOverflow)
+        return kEplSuccessful;
+
+    appendMacExpr(&buffer, "src", pFilterSet_p->abMyMacAddr);
+    appendExpr(&buffer, " or ");
+    appendMacExpr(&buffer, "dst", pFilterSet_p->abMyMacAddr);
+    appendExpr(&buffer, " or ether broadcast");
+
+    if (pFilterSet_p->filterCount > 0)
+    {
+        for (index = 0; index < pFilterSet_p->filterCount; index++)
+        {
+            if (!pFilterSet_p->aFilter[index].m_fEnable)
+                continue;
+
+            appendExpr(&buffer, " or ");
+            if (!appendFilterExpr(&buffer, &pFilterSet_p->aFilter[index]))
+            {   // the entry matches every frame
+                pszExpr_p[0] = '\0';
+                return kEplSuccessful;
+            }
+        }
+    }
+    else
+    {
+        for (index = 0; index < pFilterSet_p->multicastCount; index++)
+        {
+            appendExpr(&buffer, " or ");
+            appendMacExpr(&buffer, "dst", pFilterSet_p->aabMulticastMac[index]);
+        }
+    }
+
+    if (buffer.fOverflow)
+    {
+        pszExpr_p[0] = '\0';
+        return kEplEdrvInvalidParam;
+    }
+
+    return kEplSuccessful;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Append text to the expression
+
+\param  pBuffer_p           Pointer to the expression buffer.
+\param  pszFormat_p         printf() format string of the text.
+*/
+//------------------------------------------------------------------------------
+static void appendExpr(tExprBuffer* pBuffer_p, const char* pszFormat_p, ...)
+{
+    va_list     argList;
+    int         len;
+
+    if (pBuffer_p->fOverflow)
+        return;
+
+    va_start(argList, pszFormat_p);
+    len = vsnprintf(pBuffer_p->pszExpr + pBuffer_p->len,
+                    pBuffer_p->size - pBuffer_p->len, pszFormat_p, argList);
+    va_end(argList);
+
+    if ((len < 0) || ((size_t)len >= pBuffer_p->size - pBuffer_p->len))
+    {
+        pBuffer_p->fOverflow = TRUE;
+        return;
+    }
+
+    pBuffer_p->len += len;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Append MAC address primitive to the expression
+
+\param  pBuffer_p           Pointer to the expression buffer.
+\param  pszDir_p            Direction qualifier ("src" or "dst").
+\param  pbMacAddr_p         MAC address.
+*/
+//------------------------------------------------------------------------------
+static void appendMacExpr(tExprBuffer* pBuffer_p, const char* pszDir_p, const BYTE* pbMacAddr_p)
+{
+    appendExpr(pBuffer_p, "ether %s %02x:%02x:%02x:%02x:%02x:%02x", pszDir_p,
+               pbMacAddr_p[0], pbMacAddr_p[1], pbMacAddr_p[2],
+               pbMacAddr_p[3], pbMacAddr_p[4], pbMacAddr_p[5]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Append Rx filter entry to the expression
+
+The function appends the comparisons of an Rx filter entry to the expression.
+The filter bytes are compared in chunks of four bytes, chunks without any mask
+bits are omitted.
+
+\param  pBuffer_p           Pointer to the expression buffer.
+\param  pFilter_p           Pointer to the Rx filter entry.
+
+\return The function returns FALSE if the filter entry has no mask bits, i.e.
+        it matches every frame. Otherwise it returns TRUE.
+*/
+//------------------------------------------------------------------------------
+static BOOL appendFilterExpr(tExprBuffer* pBuffer_p, const tEdrvFilter* pFilter_p)
+{
+    UINT        offset;
+    UINT        chunkLen;
+    UINT        i;
+    UINT32      mask;
+    UINT32      value;
+    BOOL        fFirst = TRUE;
+
+    for (offset = 0; offset < EDRVPCAP_FILTER_LEN; offset += 4)
+    {
+        chunkLen = ((EDRVPCAP_FILTER_LEN - offset) < 4) ? 2 : 4;
+        mask = 0;
+        value = 0;
+        for (i = 0; i < chunkLen; i++)
+        {
+            mask = (mask << 8) | pFilter_p->m_abFilterMask[offset + i];
+            value = (value << 8) | (pFilter_p->m_abFilterValue[offset + i] &
+                                    pFilter_p->m_abFilterMask[offset + i]);
+        }
+
+        if (mask == 0)
+            continue;
+
+        appendExpr(pBuffer_p, "%sether[%u:%u] & 0x%lx = 0x%lx",
+                   fFirst ? "(" : " and ", offset, chunkLen,
+                   (unsigned long)mask, (unsigned long)value);
+        fFirst = FALSE;
+    }
+
+    if (fFirst)
+        return FALSE;
+
+    appendExpr(pBuffer_p, ")");
+    return TRUE;
+}
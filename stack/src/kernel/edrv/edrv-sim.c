@@ -0,0 +1,1371 @@
+/**
+********************************************************************************
+\file   edrv-sim.c
+
+\brief  Implementation of the simulated Ethernet driver
+
+This file contains the implementation of the simulated Ethernet driver. It
+implements the Edrv interface on top of a simulated Ethernet segment which
+is located in POSIX shared memory. The segment is shared by all ports attached
+to it, regardless if they are located in the same process or in different
+processes on the same host.
+
+Each port owns a receive queue in the segment and a worker thread which
+processes the queue. The worker thread emulates the non-reentrant interrupt
+processing of a real Ethernet driver, i.e. the receive and transmit callbacks
+of one port are mutual exclusive. The link latency and the frame loss rate
+are configured per segment.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EdrvSim.h>
+
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRVSIM_SHM_PREFIX          "/edrvsim-"
+#define EDRVSIM_MAX_NAME_LEN        64
+#define EDRVSIM_MAX_SEGMENTS        4
+#define EDRVSIM_SEGMENT_MAGIC       0x4D495345          // "ESIM"
+#define EDRVSIM_SEGMENT_WAIT_US     1000                // poll interval while another process creates the segment
+#define EDRVSIM_SEGMENT_WAIT_COUNT  1000                // number of polls until the segment is considered broken
+#define EDRVSIM_IDLE_TIMEOUT_NS     100000000ULL        // wait timeout of an idle worker thread
+#define EDRVSIM_DEFAULT_SEED        0x2545F491
+
+#if ((EDRVSIM_RX_QUEUE_SIZE & (EDRVSIM_RX_QUEUE_SIZE - 1)) != 0)
+#error "EDRVSIM_RX_QUEUE_SIZE must be a power of two!"
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Frame slot of a receive queue
+*/
+typedef struct
+{
+    UINT64              deliverTime;                    ///< Time (CLOCK_MONOTONIC in ns) at which the frame is delivered
+    UINT                frameLen;                       ///< Length of the frame
+    BYTE                aFrame[EDRVSIM_MAX_FRAME_SIZE]; ///< Frame data
+} tEdrvSimFrame;
+
+/**
+\brief  Port data located in the segment
+
+The read index is only modified by the worker thread of the port, the write
+index only by the transmitting ports. Both are free-running and modified
+while the segment mutex is held. A slot is not reused before the worker
+thread has finished processing it, so the frame is passed to the receive
+handler without copying.
+*/
+typedef struct
+{
+    UINT32              fUsed;                          ///< Port is attached
+    BYTE                aMacAddr[6];                    ///< MAC address of the port
+    UINT32              rxReadIdx;                      ///< Index of the next frame to be delivered
+    UINT32              rxWriteIdx;                     ///< Index of the next free frame slot
+    tEdrvSimStatistics  statistics;                     ///< Statistics of the port
+    pthread_cond_t      rxCond;                         ///< Signals new frames to the worker thread
+    tEdrvSimFrame       aRxQueue[EDRVSIM_RX_QUEUE_SIZE];///< Receive queue
+} tEdrvSimSharedPort;
+
+/**
+\brief  Simulated Ethernet segment
+
+This structure is located in shared memory.
+*/
+typedef struct
+{
+    UINT32              magic;                          ///< Set after the segment was initialized
+    UINT32              segmentSize;                    ///< Size of the segment, detects incompatible builds
+    UINT32              attachCount;                    ///< Number of attached ports of all processes
+    UINT32              randomState;                    ///< State of the loss generator
+    tEdrvSimLinkParam   linkParam;                      ///< Link parameters of the segment
+    pthread_mutex_t     mutex;                          ///< Protects the whole segment
+    tEdrvSimSharedPort  aPort[EDRVSIM_MAX_PORTS];       ///< Ports of the segment
+} tEdrvSimSegment;
+
+/**
+\brief  Process local reference to a segment
+*/
+typedef struct
+{
+    char                aShmName[EDRVSIM_MAX_NAME_LEN]; ///< Name of the shared memory object
+    tEdrvSimSegment*    pSegment;                       ///< Mapping of the segment
+    UINT                refCount;                       ///< Number of local users of the mapping
+    BOOL                fLinkParamRef;                  ///< One reference is held for the link parameters
+} tEdrvSimSegmentRef;
+
+/**
+\brief  Process local data of a port
+*/
+struct sEdrvSimPort
+{
+    tEdrvSimSegmentRef* pSegmentRef;                    ///< Segment the port is attached to
+    tEdrvSimSegment*    pSegment;                       ///< Mapping of the segment
+    UINT                portIdx;                        ///< Index of the port in the segment
+    tEdrvSimRxHandler   pfnRxHandler;                   ///< Receive handler of the port
+    void*               pArg;                           ///< Argument of the receive handler
+    tEdrvTxBuffer*      pTxDoneFirst;                   ///< First transmitted Tx buffer waiting for its Tx handler
+    tEdrvTxBuffer*      pTxDoneLast;                    ///< Last transmitted Tx buffer waiting for its Tx handler
+    BOOL                fStop;                          ///< Worker thread shall terminate
+    sem_t               syncSem;                        ///< Signals the start of the worker thread
+    pthread_t           hThread;                        ///< Worker thread
+};
+
+/**
+\brief  Instance of the Edrv interface
+*/
+typedef struct
+{
+    tEdrvInitParam      initParam;                      ///< Init parameters of the Edrv module
+    tEdrvSimPort*       pPort;                          ///< Port used by the Edrv module
+} tEdrvInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvInstance        edrvInstance_l;
+static tEdrvSimSegmentRef   aSegmentRef_l[EDRVSIM_MAX_SEGMENTS];
+static pthread_mutex_t      segmentRefMutex_l = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel openSegment(const char* pszSegment_p, tEdrvSimSegmentRef** ppSegmentRef_p);
+static void closeSegment(tEdrvSimSegmentRef* pSegmentRef_p, BOOL fUnlink_p);
+static void releaseLinkParamRef(tEdrvSimSegmentRef* pSegmentRef_p);
+static void initSegment(tEdrvSimSegment* pSegment_p);
+static void lockSegment(tEdrvSimSegment* pSegment_p);
+static void unlockSegment(tEdrvSimSegment* pSegment_p);
+static tEplKernel attachPort(const char* pszSegment_p, BYTE* pbMacAddr_p,
+                             tEdrvSimRxHandler pfnRxHandler_p, void* pArg_p,
+                             int priority_p, tEdrvSimPort** ppPort_p);
+static BOOL enqueueFrame(tEdrvSimSharedPort* pSharedPort_p, BYTE* pbFrame_p,
+                         UINT frameLen_p, UINT64 deliverTime_p);
+static void transmitFrame(tEdrvSimPort* pPort_p, BYTE* pbFrame_p, UINT frameLen_p);
+static UINT32 getRandom(tEdrvSimSegment* pSegment_p);
+static UINT64 getTimeNs(void);
+static UINT32 getEnvValue(const char* pszName_p, UINT32 default_p);
+static void* workerThread(void* pArgument_p);
+static void edrvRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                          UINT frameLen_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize Ethernet driver
+
+The function initializes the simulated Ethernet driver. The device name of
+the hardware parameters selects the simulated segment. If no MAC address is
+specified, the driver assigns a locally administered address which is unique
+on the segment and returns it in the init parameters.
+
+\param  pEdrvInitParam_p    Pointer to the init parameters
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvInit(tEdrvInitParam* pEdrvInitParam_p)
+{
+    tEplKernel      ret;
+
+    EPL_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+
+    if (pEdrvInitParam_p->m_HwParam.m_pszDevName == NULL)
+        return kEplEdrvInitError;
+
+    // the worker thread may deliver frames before EdrvInit() returns
+    edrvInstance_l.initParam = *pEdrvInitParam_p;
+
+    ret = attachPort(pEdrvInitParam_p->m_HwParam.m_pszDevName,
+                     edrvInstance_l.initParam.m_abMyMacAddr, edrvRxHandler,
+                     &edrvInstance_l, EPL_THREAD_PRIORITY_MEDIUM,
+                     &edrvInstance_l.pPort);
+    if (ret != kEplSuccessful)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() couldn't attach to segment %s\n", __func__,
+                               pEdrvInitParam_p->m_HwParam.m_pszDevName);
+        return kEplEdrvInitError;
+    }
+
+    EPL_MEMCPY(pEdrvInitParam_p->m_abMyMacAddr, edrvInstance_l.initParam.m_abMyMacAddr, 6);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down Ethernet driver
+
+The function detaches the driver from the simulated segment. Segments which
+were created by EdrvSimSetLinkParam() and have no attached port are removed.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvShutdown(void)
+{
+    UINT    i;
+
+    if (edrvInstance_l.pPort != NULL)
+        EdrvSimDetachPort(edrvInstance_l.pPort);
+
+    for (i = 0; i < EDRVSIM_MAX_SEGMENTS; i++)
+    {
+        if (aSegmentRef_l[i].fLinkParamRef)
+            releaseLinkParamRef(&aSegmentRef_l[i]);
+    }
+
+    EPL_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send Tx buffer
+
+The function transmits the frame on the simulated segment. The Tx handler of
+the buffer is called by the worker thread afterwards.
+
+\param  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvSendTxMsg(tEdrvTxBuffer* pBuffer_p)
+{
+    tEdrvSimPort*       pPort = edrvInstance_l.pPort;
+    tEdrvSimSharedPort* pSharedPort;
+
+    FTRACE_MARKER("%s", __func__);
+
+    if (pBuffer_p->m_BufferNumber.m_pVal != NULL)
+        return kEplInvalidOperation;
+
+    if (pPort == NULL)
+        return kEplEdrvInitError;
+
+    if (pBuffer_p->m_uiTxMsgLen > EDRVSIM_MAX_FRAME_SIZE)
+        return kEplEdrvInvalidParam;
+
+    pSharedPort = &pPort->pSegment->aPort[pPort->portIdx];
+
+    lockSegment(pPort->pSegment);
+
+    transmitFrame(pPort, pBuffer_p->m_pbBuffer, pBuffer_p->m_uiTxMsgLen);
+
+    // the buffer list is linked by the buffer number as in the pcap driver
+    if (pPort->pTxDoneLast == NULL)
+    {
+        pPort->pTxDoneFirst = pBuffer_p;
+    }
+    else
+    {
+        pPort->pTxDoneLast->m_BufferNumber.m_pVal = pBuffer_p;
+    }
+    pPort->pTxDoneLast = pBuffer_p;
+    pthread_cond_signal(&pSharedPort->rxCond);
+
+    unlockSegment(pPort->pSegment);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate Tx buffer
+
+The function allocates a Tx buffer.
+
+\param  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvAllocTxMsgBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    if (pBuffer_p->m_uiMaxBufferLen > EDRVSIM_MAX_FRAME_SIZE)
+        return kEplEdrvNoFreeBufEntry;
+
+    pBuffer_p->m_pbBuffer = EPL_MALLOC(pBuffer_p->m_uiMaxBufferLen);
+    if (pBuffer_p->m_pbBuffer == NULL)
+        return kEplEdrvNoFreeBufEntry;
+
+    pBuffer_p->m_BufferNumber.m_pVal = NULL;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free Tx buffer
+
+The function releases a Tx buffer.
+
+\param  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvReleaseTxMsgBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    BYTE*   pbBuffer = pBuffer_p->m_pbBuffer;
+
+    // mark buffer as free, before actually freeing it
+    pBuffer_p->m_pbBuffer = NULL;
+
+    EPL_FREE(pbBuffer);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change Rx filter setup
+
+The simulated segment delivers all frames to all ports like a pcap interface
+in promiscuous mode. Therefore, the filter setup is ignored.
+
+\param  pFilter_p           Base pointer of Rx filter array
+\param  uiCount_p           Number of Rx filter array entries
+\param  uiEntryChanged_p    Index of Rx filter entry that shall be changed
+\param  uiChangeFlags_p     Bit mask that selects the changing Rx filter property
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvChangeFilter(tEdrvFilter* pFilter_p __attribute__((unused)),
+                            unsigned int uiCount_p __attribute__((unused)),
+                            unsigned int uiEntryChanged_p __attribute__((unused)),
+                            unsigned int uiChangeFlags_p __attribute__((unused)))
+{
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear multicast address entry
+
+The function is a no-op as the simulated segment has no address filter.
+
+\param  pbMacAddr_p     Multicast address
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvUndefineRxMacAddrEntry(BYTE* pbMacAddr_p __attribute__((unused)))
+{
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set multicast address entry
+
+The function is a no-op as the simulated segment has no address filter.
+
+\param  pbMacAddr_p     Multicast address
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvDefineRxMacAddrEntry(BYTE* pbMacAddr_p __attribute__((unused)))
+{
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Inject a frame into the Edrv port
+
+The function puts a frame into the receive queue of the port used by the Edrv
+module as if it was received from the segment. The frame is delivered to the
+DLL by the worker thread of the port.
+
+\param  bBufferInFrame_p    Position of the buffer in the frame (ignored, the
+                            buffer has to contain the whole frame)
+\param  pbEthernetData_p    Frame data
+\param  wDataLen_p          Length of the frame
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void EdrvRxInterruptHandler(BYTE bBufferInFrame_p __attribute__((unused)),
+                            BYTE* pbEthernetData_p, WORD wDataLen_p)
+{
+    tEdrvSimPort*       pPort = edrvInstance_l.pPort;
+    tEdrvSimSharedPort* pSharedPort;
+
+    if ((pPort == NULL) || (wDataLen_p > EDRVSIM_MAX_FRAME_SIZE))
+        return;
+
+    pSharedPort = &pPort->pSegment->aPort[pPort->portIdx];
+
+    lockSegment(pPort->pSegment);
+    if (enqueueFrame(pSharedPort, pbEthernetData_p, wDataLen_p, getTimeNs()))
+    {
+        pthread_cond_signal(&pSharedPort->rxCond);
+    }
+    unlockSegment(pPort->pSegment);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set link parameters of a segment
+
+The function sets the latency and loss rate of a simulated segment. If the
+segment does not exist yet, it is created. The segment is kept until the last
+port detaches from it or until EdrvShutdown() is called.
+
+\param  pszSegment_p        Name of the segment
+\param  pLinkParam_p        Link parameters
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvSimSetLinkParam(const char* pszSegment_p,
+                               const tEdrvSimLinkParam* pLinkParam_p)
+{
+    tEplKernel          ret;
+    tEdrvSimSegmentRef* pSegmentRef;
+    tEdrvSimSegment*    pSegment;
+
+    if (pLinkParam_p->lossPpm > EDRVSIM_LOSS_PPM_MAX)
+        return kEplEdrvInvalidParam;
+
+    ret = openSegment(pszSegment_p, &pSegmentRef);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    pSegment = pSegmentRef->pSegment;
+    lockSegment(pSegment);
+    pSegment->linkParam.latencyNs = pLinkParam_p->latencyNs;
+    pSegment->linkParam.lossPpm = pLinkParam_p->lossPpm;
+    if (pLinkParam_p->seed != 0)
+    {
+        pSegment->linkParam.seed = pLinkParam_p->seed;
+        pSegment->randomState = pLinkParam_p->seed;
+    }
+    unlockSegment(pSegment);
+
+    // keep one reference, otherwise the parameters are lost before a port attaches
+    if (pSegmentRef->fLinkParamRef)
+        closeSegment(pSegmentRef, FALSE);
+    else
+        pSegmentRef->fLinkParamRef = TRUE;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get link parameters of a segment
+
+The function reads the latency and loss rate of a simulated segment.
+
+\param  pszSegment_p        Name of the segment
+\param  pLinkParam_p        Pointer to store the link parameters
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvSimGetLinkParam(const char* pszSegment_p, tEdrvSimLinkParam* pLinkParam_p)
+{
+    tEplKernel          ret;
+    tEdrvSimSegmentRef* pSegmentRef;
+
+    ret = openSegment(pszSegment_p, &pSegmentRef);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    lockSegment(pSegmentRef->pSegment);
+    *pLinkParam_p = pSegmentRef->pSegment->linkParam;
+    unlockSegment(pSegmentRef->pSegment);
+
+    closeSegment(pSegmentRef, FALSE);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Attach a port to a segment
+
+The function attaches an additional port to a simulated segment. The receive
+handler is called by a dedicated worker thread for every frame sent by the
+other ports of the segment. If the MAC address is all zero, a locally
+administered address is assigned and returned in pbMacAddr_p.
+
+\param  pszSegment_p        Name of the segment
+\param  pbMacAddr_p         MAC address of the port
+\param  pfnRxHandler_p      Receive handler
+\param  pArg_p              Argument passed to the receive handler
+\param  ppPort_p            Pointer to store the port handle
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvSimAttachPort(const char* pszSegment_p, BYTE* pbMacAddr_p,
+                             tEdrvSimRxHandler pfnRxHandler_p, void* pArg_p,
+                             tEdrvSimPort** ppPort_p)
+{
+    return attachPort(pszSegment_p, pbMacAddr_p, pfnRxHandler_p, pArg_p, 0, ppPort_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Detach a port from its segment
+
+The function stops the worker thread of the port and detaches it from the
+segment. Frames which are still in the receive queue are discarded. The
+segment is removed if no port is attached anymore.
+
+\param  pPort_p             Port handle
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvSimDetachPort(tEdrvSimPort* pPort_p)
+{
+    tEdrvSimSegment*    pSegment = pPort_p->pSegment;
+    tEdrvSimSharedPort* pSharedPort = &pSegment->aPort[pPort_p->portIdx];
+    tEdrvTxBuffer*      pTxBuffer;
+    BOOL                fLastPort;
+
+    lockSegment(pSegment);
+    pPort_p->fStop = TRUE;
+    pthread_cond_broadcast(&pSharedPort->rxCond);
+    unlockSegment(pSegment);
+
+    pthread_join(pPort_p->hThread, NULL);
+
+    lockSegment(pSegment);
+    pSharedPort->fUsed = FALSE;
+    pSegment->attachCount--;
+    fLastPort = (pSegment->attachCount == 0);
+    unlockSegment(pSegment);
+
+    // release pending Tx buffers without calling their handlers
+    while (pPort_p->pTxDoneFirst != NULL)
+    {
+        pTxBuffer = pPort_p->pTxDoneFirst;
+        pPort_p->pTxDoneFirst = pTxBuffer->m_BufferNumber.m_pVal;
+        pTxBuffer->m_BufferNumber.m_pVal = NULL;
+    }
+
+    sem_destroy(&pPort_p->syncSem);
+    if (fLastPort && pPort_p->pSegmentRef->fLinkParamRef)
+    {
+        pPort_p->pSegmentRef->fLinkParamRef = FALSE;
+        closeSegment(pPort_p->pSegmentRef, FALSE);
+    }
+    closeSegment(pPort_p->pSegmentRef, fLastPort);
+    EPL_FREE(pPort_p);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a frame from a port
+
+The function transmits a frame from a port attached with EdrvSimAttachPort().
+
+\param  pPort_p             Port handle
+\param  pbFrame_p           Frame data
+\param  frameLen_p          Length of the frame
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvSimSendFrame(tEdrvSimPort* pPort_p, BYTE* pbFrame_p, UINT frameLen_p)
+{
+    if (frameLen_p > EDRVSIM_MAX_FRAME_SIZE)
+        return kEplEdrvInvalidParam;
+
+    lockSegment(pPort_p->pSegment);
+    transmitFrame(pPort_p, pbFrame_p, frameLen_p);
+    unlockSegment(pPort_p->pSegment);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get port statistics
+
+The function reads the statistics of a port.
+
+\param  pPort_p             Port handle
+\param  pStatistics_p       Pointer to store the statistics
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEplKernel EdrvSimGetStatistics(tEdrvSimPort* pPort_p, tEdrvSimStatistics* pStatistics_p)
+{
+    lockSegment(pPort_p->pSegment);
+    *pStatistics_p = pPort_p->pSegment->aPort[pPort_p->portIdx].statistics;
+    unlockSegment(pPort_p->pSegment);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get port of the Edrv module
+
+The function returns the port used by the Edrv module, e.g. to read its
+statistics.
+
+\return The function returns the port handle or NULL if the Edrv module is
+        not initialized.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tEdrvSimPort* EdrvSimGetEdrvPort(void)
+{
+    return edrvInstance_l.pPort;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open a segment
+
+The function maps the shared memory of a segment. If the segment is already
+mapped by this process, the existing mapping is reused. If the segment does
+not exist, it is created and initialized.
+
+\param  pszSegment_p        Name of the segment
+\param  ppSegmentRef_p      Pointer to store the segment reference
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel openSegment(const char* pszSegment_p, tEdrvSimSegmentRef** ppSegmentRef_p)
+{
+    tEplKernel          ret = kEplSuccessful;
+    char                aShmName[EDRVSIM_MAX_NAME_LEN];
+    tEdrvSimSegmentRef* pSegmentRef = NULL;
+    tEdrvSimSegment*    pSegment;
+    struct stat         stat;
+    BOOL                fCreator = FALSE;
+    int                 fd;
+    int                 waitCount;
+    UINT                i;
+
+    if (pszSegment_p[0] == '/')
+        pszSegment_p++;
+
+    if ((pszSegment_p[0] == '\0') || (strchr(pszSegment_p, '/') != NULL) ||
+        (snprintf(aShmName, sizeof(aShmName), "%s%s", EDRVSIM_SHM_PREFIX,
+                  pszSegment_p) >= (int)sizeof(aShmName)))
+    {
+        return kEplEdrvInvalidParam;
+    }
+
+    pthread_mutex_lock(&segmentRefMutex_l);
+
+    for (i = 0; i < EDRVSIM_MAX_SEGMENTS; i++)
+    {
+        if (aSegmentRef_l[i].refCount == 0)
+        {
+            if (pSegmentRef == NULL)
+                pSegmentRef = &aSegmentRef_l[i];
+        }
+        else if (strcmp(aSegmentRef_l[i].aShmName, aShmName) == 0)
+        {
+            aSegmentRef_l[i].refCount++;
+            *ppSegmentRef_p = &aSegmentRef_l[i];
+            goto Exit;
+        }
+    }
+
+    if (pSegmentRef == NULL)
+    {
+        ret = kEplNoResource;
+        goto Exit;
+    }
+
+    fd = shm_open(aShmName, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd >= 0)
+    {
+        fCreator = TRUE;
+        if (ftruncate(fd, sizeof(tEdrvSimSegment)) != 0)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() ftruncate failed!\n", __func__);
+            close(fd);
+            shm_unlink(aShmName);
+            ret = kEplNoResource;
+            goto Exit;
+        }
+    }
+    else
+    {
+        fd = shm_open(aShmName, O_RDWR, 0);
+        if (fd < 0)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() shm_open failed!\n", __func__);
+            ret = kEplNoResource;
+            goto Exit;
+        }
+
+        // the creator might not have resized the segment yet
+        for (waitCount = 0; ; waitCount++)
+        {
+            if ((fstat(fd, &stat) == 0) && (stat.st_size >= (off_t)sizeof(tEdrvSimSegment)))
+                break;
+
+            if (waitCount >= EDRVSIM_SEGMENT_WAIT_COUNT)
+            {
+                close(fd);
+                ret = kEplNoResource;
+                goto Exit;
+            }
+            usleep(EDRVSIM_SEGMENT_WAIT_US);
+        }
+    }
+
+    pSegment = mmap(NULL, sizeof(tEdrvSimSegment), PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+    close(fd);
+    if (pSegment == MAP_FAILED)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() mmap failed!\n", __func__);
+        if (fCreator)
+            shm_unlink(aShmName);
+        ret = kEplNoResource;
+        goto Exit;
+    }
+
+    if (fCreator)
+    {
+        initSegment(pSegment);
+    }
+    else
+    {
+        for (waitCount = 0; pSegment->magic != EDRVSIM_SEGMENT_MAGIC; waitCount++)
+        {
+            if (waitCount >= EDRVSIM_SEGMENT_WAIT_COUNT)
+                break;
+            usleep(EDRVSIM_SEGMENT_WAIT_US);
+        }
+        __sync_synchronize();
+
+        if ((pSegment->magic != EDRVSIM_SEGMENT_MAGIC) ||
+            (pSegment->segmentSize != sizeof(tEdrvSimSegment)))
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() segment %s is invalid!\n", __func__, aShmName);
+            munmap(pSegment, sizeof(tEdrvSimSegment));
+            ret = kEplNoResource;
+            goto Exit;
+        }
+    }
+
+    strcpy(pSegmentRef->aShmName, aShmName);
+    pSegmentRef->pSegment = pSegment;
+    pSegmentRef->refCount = 1;
+    *ppSegmentRef_p = pSegmentRef;
+
+Exit:
+    pthread_mutex_unlock(&segmentRefMutex_l);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close a segment
+
+The function releases a segment reference. The mapping is removed if it has
+no local users anymore.
+
+\param  pSegmentRef_p       Segment reference
+\param  fUnlink_p           Remove the shared memory object of the segment
+*/
+//------------------------------------------------------------------------------
+static void closeSegment(tEdrvSimSegmentRef* pSegmentRef_p, BOOL fUnlink_p)
+{
+    pthread_mutex_lock(&segmentRefMutex_l);
+
+    if (fUnlink_p)
+        shm_unlink(pSegmentRef_p->aShmName);
+
+    pSegmentRef_p->refCount--;
+    if (pSegmentRef_p->refCount == 0)
+    {
+        munmap(pSegmentRef_p->pSegment, sizeof(tEdrvSimSegment));
+        pSegmentRef_p->pSegment = NULL;
+    }
+
+    pthread_mutex_unlock(&segmentRefMutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release the link parameter reference of a segment
+
+The function releases the reference held by EdrvSimSetLinkParam(). The segment
+is removed if no port is attached to it.
+
+\param  pSegmentRef_p       Segment reference
+*/
+//------------------------------------------------------------------------------
+static void releaseLinkParamRef(tEdrvSimSegmentRef* pSegmentRef_p)
+{
+    BOOL    fUnused;
+
+    lockSegment(pSegmentRef_p->pSegment);
+    fUnused = (pSegmentRef_p->pSegment->attachCount == 0);
+    unlockSegment(pSegmentRef_p->pSegment);
+
+    pSegmentRef_p->fLinkParamRef = FALSE;
+    closeSegment(pSegmentRef_p, fUnused);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize a segment
+
+The function initializes a newly created segment. The mutex is robust, so the
+segment stays usable if a process terminates while holding it.
+
+\param  pSegment_p          Segment
+*/
+//------------------------------------------------------------------------------
+static void initSegment(tEdrvSimSegment* pSegment_p)
+{
+    pthread_mutexattr_t mutexAttr;
+    pthread_condattr_t  condAttr;
+    UINT                i;
+
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&pSegment_p->mutex, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    for (i = 0; i < EDRVSIM_MAX_PORTS; i++)
+    {
+        pthread_cond_init(&pSegment_p->aPort[i].rxCond, &condAttr);
+    }
+    pthread_condattr_destroy(&condAttr);
+
+    pSegment_p->linkParam.latencyNs = getEnvValue("EDRVSIM_LATENCY_NS", 0);
+    pSegment_p->linkParam.lossPpm = getEnvValue("EDRVSIM_LOSS_PPM", 0);
+    if (pSegment_p->linkParam.lossPpm > EDRVSIM_LOSS_PPM_MAX)
+        pSegment_p->linkParam.lossPpm = EDRVSIM_LOSS_PPM_MAX;
+    pSegment_p->linkParam.seed = getEnvValue("EDRVSIM_SEED", EDRVSIM_DEFAULT_SEED);
+    if (pSegment_p->linkParam.seed == 0)
+        pSegment_p->linkParam.seed = EDRVSIM_DEFAULT_SEED;
+    pSegment_p->randomState = pSegment_p->linkParam.seed;
+    pSegment_p->attachCount = 0;
+    pSegment_p->segmentSize = sizeof(tEdrvSimSegment);
+
+    __sync_synchronize();
+    pSegment_p->magic = EDRVSIM_SEGMENT_MAGIC;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Lock a segment
+
+\param  pSegment_p          Segment
+*/
+//------------------------------------------------------------------------------
+static void lockSegment(tEdrvSimSegment* pSegment_p)
+{
+    if (pthread_mutex_lock(&pSegment_p->mutex) == EOWNERDEAD)
+    {
+        // the previous owner terminated, the segment data is still consistent
+        // because it is only modified in short non-failing sequences
+        pthread_mutex_consistent(&pSegment_p->mutex);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unlock a segment
+
+\param  pSegment_p          Segment
+*/
+//------------------------------------------------------------------------------
+static void unlockSegment(tEdrvSimSegment* pSegment_p)
+{
+    pthread_mutex_unlock(&pSegment_p->mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Attach a port to a segment
+
+The function allocates a port on the segment and starts its worker thread.
+
+\param  pszSegment_p        Name of the segment
+\param  pbMacAddr_p         MAC address of the port
+\param  pfnRxHandler_p      Receive handler
+\param  pArg_p              Argument passed to the receive handler
+\param  priority_p          SCHED_FIFO priority of the worker thread, 0 keeps
+                            the default scheduling policy
+\param  ppPort_p            Pointer to store the port handle
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel attachPort(const char* pszSegment_p, BYTE* pbMacAddr_p,
+                             tEdrvSimRxHandler pfnRxHandler_p, void* pArg_p,
+                             int priority_p, tEdrvSimPort** ppPort_p)
+{
+    tEplKernel          ret;
+    tEdrvSimPort*       pPort;
+    tEdrvSimSegment*    pSegment;
+    tEdrvSimSharedPort* pSharedPort = NULL;
+    struct sched_param  schedParam;
+    static const BYTE   abZeroMac[6] = {0};
+    UINT                i;
+
+    pPort = EPL_MALLOC(sizeof(tEdrvSimPort));
+    if (pPort == NULL)
+        return kEplNoResource;
+
+    EPL_MEMSET(pPort, 0, sizeof(tEdrvSimPort));
+    pPort->pfnRxHandler = pfnRxHandler_p;
+    pPort->pArg = pArg_p;
+
+    ret = openSegment(pszSegment_p, &pPort->pSegmentRef);
+    if (ret != kEplSuccessful)
+    {
+        EPL_FREE(pPort);
+        return ret;
+    }
+
+    pSegment = pPort->pSegmentRef->pSegment;
+    pPort->pSegment = pSegment;
+
+    lockSegment(pSegment);
+    for (i = 0; i < EDRVSIM_MAX_PORTS; i++)
+    {
+        if (!pSegment->aPort[i].fUsed)
+        {
+            pSharedPort = &pSegment->aPort[i];
+            break;
+        }
+    }
+
+    if (pSharedPort != NULL)
+    {
+        if (EPL_MEMCMP(pbMacAddr_p, abZeroMac, 6) == 0)
+        {   // locally administered unicast address
+            pbMacAddr_p[0] = 0x02;
+            pbMacAddr_p[1] = 0x00;
+            pbMacAddr_p[2] = 0x53;
+            pbMacAddr_p[3] = 0x49;
+            pbMacAddr_p[4] = (BYTE)(i >> 8);
+            pbMacAddr_p[5] = (BYTE)i;
+        }
+
+        pPort->portIdx = i;
+        EPL_MEMCPY(pSharedPort->aMacAddr, pbMacAddr_p, 6);
+        EPL_MEMSET(&pSharedPort->statistics, 0, sizeof(pSharedPort->statistics));
+        pSharedPort->rxReadIdx = 0;
+        pSharedPort->rxWriteIdx = 0;
+        pSharedPort->fUsed = TRUE;
+        pSegment->attachCount++;
+    }
+    unlockSegment(pSegment);
+
+    if (pSharedPort == NULL)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() no free port on segment!\n", __func__);
+        closeSegment(pPort->pSegmentRef, FALSE);
+        EPL_FREE(pPort);
+        return kEplNoResource;
+    }
+
+    if ((sem_init(&pPort->syncSem, 0, 0) != 0) ||
+        (pthread_create(&pPort->hThread, NULL, workerThread, pPort) != 0))
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() couldn't create worker thread!\n", __func__);
+        lockSegment(pSegment);
+        pSharedPort->fUsed = FALSE;
+        pSegment->attachCount--;
+        unlockSegment(pSegment);
+        closeSegment(pPort->pSegmentRef, FALSE);
+        EPL_FREE(pPort);
+        return kEplNoResource;
+    }
+
+    if (priority_p > 0)
+    {
+        schedParam.sched_priority = priority_p;
+        if (pthread_setschedparam(pPort->hThread, SCHED_FIFO, &schedParam) != 0)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n",
+                                   __func__);
+        }
+    }
+
+    // wait until thread is started
+    sem_wait(&pPort->syncSem);
+
+    *ppPort_p = pPort;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Put a frame into a receive queue
+
+The function must be called with the segment locked.
+
+\param  pSharedPort_p       Receiving port
+\param  pbFrame_p           Frame data
+\param  frameLen_p          Length of the frame
+\param  deliverTime_p       Time at which the frame is delivered
+
+\return The function returns TRUE if the frame was queued or FALSE if the
+        receive queue is full.
+*/
+//------------------------------------------------------------------------------
+static BOOL enqueueFrame(tEdrvSimSharedPort* pSharedPort_p, BYTE* pbFrame_p,
+                         UINT frameLen_p, UINT64 deliverTime_p)
+{
+    tEdrvSimFrame*      pFrame;
+
+    if ((UINT32)(pSharedPort_p->rxWriteIdx - pSharedPort_p->rxReadIdx) >= EDRVSIM_RX_QUEUE_SIZE)
+    {
+        pSharedPort_p->statistics.overflowCount++;
+        return FALSE;
+    }
+
+    pFrame = &pSharedPort_p->aRxQueue[pSharedPort_p->rxWriteIdx & (EDRVSIM_RX_QUEUE_SIZE - 1)];
+    pFrame->deliverTime = deliverTime_p;
+    pFrame->frameLen = frameLen_p;
+    EPL_MEMCPY(pFrame->aFrame, pbFrame_p, frameLen_p);
+    pSharedPort_p->rxWriteIdx++;
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Transmit a frame on the segment
+
+The function copies the frame into the receive queues of all other ports of
+the segment. The frame loss is decided independently for every receiver. The
+function must be called with the segment locked.
+
+\param  pPort_p             Transmitting port
+\param  pbFrame_p           Frame data
+\param  frameLen_p          Length of the frame
+*/
+//------------------------------------------------------------------------------
+static void transmitFrame(tEdrvSimPort* pPort_p, BYTE* pbFrame_p, UINT frameLen_p)
+{
+    tEdrvSimSegment*    pSegment = pPort_p->pSegment;
+    tEdrvSimSharedPort* pSharedPort;
+    UINT64              deliverTime;
+    UINT                i;
+
+    deliverTime = getTimeNs() + pSegment->linkParam.latencyNs;
+
+    for (i = 0; i < EDRVSIM_MAX_PORTS; i++)
+    {
+        pSharedPort = &pSegment->aPort[i];
+        if ((i == pPort_p->portIdx) || !pSharedPort->fUsed)
+            continue;
+
+        if ((pSegment->linkParam.lossPpm != 0) &&
+            ((getRandom(pSegment) % EDRVSIM_LOSS_PPM_MAX) < pSegment->linkParam.lossPpm))
+        {
+            pSharedPort->statistics.lossCount++;
+            continue;
+        }
+
+        if (enqueueFrame(pSharedPort, pbFrame_p, frameLen_p, deliverTime))
+        {
+            pthread_cond_signal(&pSharedPort->rxCond);
+        }
+    }
+
+    pSegment->aPort[pPort_p->portIdx].statistics.txFrameCount++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get next random number of the loss generator
+
+The function implements a xorshift generator. It must be called with the
+segment locked.
+
+\param  pSegment_p          Segment
+
+\return The function returns the random number.
+*/
+//------------------------------------------------------------------------------
+static UINT32 getRandom(tEdrvSimSegment* pSegment_p)
+{
+    UINT32  x = pSegment_p->randomState;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pSegment_p->randomState = x;
+
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a numeric environment variable
+
+\param  pszName_p           Name of the environment variable
+\param  default_p           Value if the variable is not set
+
+\return The function returns the value of the environment variable.
+*/
+//------------------------------------------------------------------------------
+static UINT32 getEnvValue(const char* pszName_p, UINT32 default_p)
+{
+    const char*     pszValue = getenv(pszName_p);
+
+    if ((pszValue == NULL) || (pszValue[0] == '\0'))
+        return default_p;
+
+    return (UINT32)strtoul(pszValue, NULL, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Worker thread of a port
+
+The worker thread calls the Tx handlers of transmitted Tx buffers and delivers
+the received frames to the receive handler as soon as their delivery time is
+reached. It emulates the non-reentrant interrupt processing of a real
+Ethernet controller.
+
+\param  pArgument_p         Port handle
+
+\return The function returns the thread exit code.
+*/
+//------------------------------------------------------------------------------
+static void* workerThread(void* pArgument_p)
+{
+    tEdrvSimPort*       pPort = (tEdrvSimPort*)pArgument_p;
+    tEdrvSimSegment*    pSegment = pPort->pSegment;
+    tEdrvSimSharedPort* pSharedPort = &pSegment->aPort[pPort->portIdx];
+    tEdrvSimFrame*      pFrame;
+    tEdrvTxBuffer*      pTxBuffer;
+    struct timespec     timeout;
+    UINT64              curTime;
+    UINT64              wakeupTime;
+
+    // signal that thread is successfully started
+    sem_post(&pPort->syncSem);
+
+    lockSegment(pSegment);
+    while (!pPort->fStop)
+    {
+        if (pPort->pTxDoneFirst != NULL)
+        {
+            pTxBuffer = pPort->pTxDoneFirst;
+            pPort->pTxDoneFirst = pTxBuffer->m_BufferNumber.m_pVal;
+            if (pPort->pTxDoneFirst == NULL)
+                pPort->pTxDoneLast = NULL;
+            unlockSegment(pSegment);
+
+            pTxBuffer->m_BufferNumber.m_pVal = NULL;
+            if (pTxBuffer->m_pfnTxHandler != NULL)
+            {
+                pTxBuffer->m_pfnTxHandler(pTxBuffer);
+            }
+
+            lockSegment(pSegment);
+            continue;
+        }
+
+        curTime = getTimeNs();
+        if (pSharedPort->rxReadIdx != pSharedPort->rxWriteIdx)
+        {
+            pFrame = &pSharedPort->aRxQueue[pSharedPort->rxReadIdx & (EDRVSIM_RX_QUEUE_SIZE - 1)];
+            if (pFrame->deliverTime <= curTime)
+            {
+                pSharedPort->statistics.rxFrameCount++;
+                unlockSegment(pSegment);
+
+                pPort->pfnRxHandler(pPort, pPort->pArg, pFrame->aFrame, pFrame->frameLen);
+
+                lockSegment(pSegment);
+                // free the slot after the handler has finished with it
+                pSharedPort->rxReadIdx++;
+                continue;
+            }
+            wakeupTime = pFrame->deliverTime;
+        }
+        else
+        {
+            wakeupTime = curTime + EDRVSIM_IDLE_TIMEOUT_NS;
+        }
+
+        timeout.tv_sec = (time_t)(wakeupTime / 1000000000ULL);
+        timeout.tv_nsec = (long)(wakeupTime % 1000000000ULL);
+        if (pthread_cond_timedwait(&pSharedPort->rxCond, &pSegment->mutex, &timeout) == EOWNERDEAD)
+        {
+            pthread_mutex_consistent(&pSegment->mutex);
+        }
+    }
+    unlockSegment(pSegment);
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive handler of the Edrv port
+
+The function forwards the received frames to the DLL.
+
+\param  pPort_p             Port handle
+\param  pArg_p              Pointer to the Edrv instance
+\param  pbFrame_p           Frame data
+\param  frameLen_p          Length of the frame
+*/
+//------------------------------------------------------------------------------
+static void edrvRxHandler(tEdrvSimPort* pPort_p __attribute__((unused)), void* pArg_p,
+                          BYTE* pbFrame_p, UINT frameLen_p)
+{
+    tEdrvInstance*  pInstance = (tEdrvInstance*)pArg_p;
+    tEdrvRxBuffer   rxBuffer;
+
+    rxBuffer.m_BufferInFrame = kEdrvBufferLastInFrame;
+    rxBuffer.m_uiRxMsgLen = frameLen_p;
+    rxBuffer.m_pbBuffer = pbFrame_p;
+    rxBuffer.m_pTgtTimeStamp = NULL;
+
+    FTRACE_MARKER("%s RX", __func__);
+    pInstance->initParam.m_pfnRxHandler(&rxBuffer);
+}
+
+/// \}
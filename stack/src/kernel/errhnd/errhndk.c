@@ -64,6 +64,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC    1   // occurred
 #define ERRORHANDLERK_CN_LOSS_PRES_EVENT_THR    2   // threshold exceeded
 
+// Lazily decayed threshold counters are materialized before the decay
+// could overflow the signed cycle difference used by ERRHND_GET_DECAY()
+#define ERRORHANDLERK_MAX_PENDING_DECAY         0x40000000
+
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
@@ -84,6 +88,39 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief  MN loss of PRes state of a CN
+
+The threshold counter of a CN is not decremented in every cycle. Instead, the
+value stored in the error object is valid at cycle refCycleCnt and the decay
+of the cycles since then is applied on demand, i.e. if an error occurs, the
+node leaves the isochronous phase or the user reads the object.
+*/
+typedef struct
+{
+    BYTE                event;          ///< Detected error event (ERRORHANDLERK_CN_LOSS_PRES_EVENT_xxx)
+    BOOL                fActive;        ///< Node is in the current CN node-ID list
+    BOOL                fInList;        ///< Scratch flag for synchronizing the node-ID list
+    UINT32              refCycleCnt;    ///< Cycle count at which the stored threshold counter is valid
+} tErrHndkMnCnLossPres;
+
+/**
+\brief  Coalescing state of a history entry
+
+Repeated history entries with the same error code and node ID are not posted
+one by one. The first occurrence is posted immediately, further occurrences
+within the coalescing window are counted and reported by a single entry when
+the window expires.
+*/
+typedef struct
+{
+    BOOL                fUsed;          ///< Entry is in use
+    UINT                nodeId;         ///< Node ID of the history entry (0 if not node specific)
+    UINT32              startCycleCnt;  ///< Cycle count at which the coalescing window started
+    UINT32              suppressedCnt;  ///< Number of occurrences which were not posted yet
+    tEplErrHistoryEntry lastEntry;      ///< Last occurred history entry
+} tErrHndkHistoryCoalesce;
+
 /**
 \brief  instance of kernel error handler
 
@@ -92,7 +129,17 @@ The structure defines the instance variables of the kernel error handler.
 typedef struct
 {
     ULONG               dllErrorEvents;                                 ///< Variable stores detected error events
-    BYTE                aMnCnLossPresEvent[NUM_DLL_MNCN_LOSSPRES_OBJS]; ///< Variable stores detected error events from CNs
+#ifdef CONFIG_INCLUDE_NMT_MN
+    tErrHndkMnCnLossPres aMnCnLossPres[NUM_DLL_MNCN_LOSSPRES_OBJS];     ///< Loss of PRes state of CNs
+    UINT32              mnCycleCnt;                                     ///< Number of cycles decremented on MN
+    UINT                cnNodeIdListGen;                                ///< Generation of last processed CN node-ID list
+    UINT                refreshNodeIdx;                                 ///< Next node checked for pending decay overflow
+#endif
+    UINT32              cycleCnt;                                       ///< Number of cycles since initialization
+    tErrHndkHistoryCoalesce aHistoryCoalesce[CONFIG_ERRHND_HISTORY_COALESCE_ENTRIES]; ///< Coalesced history entries
+    UINT                historyCoalesceUsed;                            ///< Number of used coalescing entries
+    UINT32              historyPostedCnt;                               ///< Number of posted history entries
+    UINT32              historySuppressedCnt;                           ///< Number of coalesced history entries
     tErrHndObjects      errorObjects;                                   ///< Error objects (counters and thresholds)
 } tErrHndkInstance;
 
@@ -108,13 +155,19 @@ static tEplKernel postNmtEvent(tNmtEvent nmtEvent_p);
 static tEplKernel generateHistoryEntry(UINT16 errorCode_p, tEplNetTime netTime_p);
 static tEplKernel generateHistoryEntryNodeId(UINT16 errorCode_p, tEplNetTime netTime_p, UINT nodeId_p);
 static void       decrementCnCounters(void);
-static tEplKernel postHistoryEntryEvent(tEplErrHistoryEntry* pHistoryEntry_p);
+static tEplKernel postHistoryEntryEvent(tEplErrHistoryEntry* pHistoryEntry_p, UINT nodeId_p);
+static tEplKernel sendHistoryEntryEvent(tEplErrHistoryEntry* pHistoryEntry_p, UINT32 occurrenceCnt_p);
+static tEplKernel flushHistoryEntry(tErrHndkHistoryCoalesce* pCoalesce_p);
+static void       processHistoryCoalesce(void);
 static tEplKernel handleDllErrors(tEplEvent *pEvent_p);
 
 #ifdef CONFIG_INCLUDE_NMT_MN
 static tEplKernel decrementMnCounters(void);
 static tEplKernel postHeartbeatEvent(UINT nodeId_p, tNmtState state_p, UINT16 errorCode_p);
 static tEplKernel generateHistoryEntryWithError(UINT16 errorCode_p, tEplNetTime netTime_p, UINT16 eplError_p);
+static void       updateMnCnLossPres(UINT nodeIdx_p);
+static void       publishMnCnLossPresDecay(UINT nodeIdx_p);
+static void       syncCnNodeIdList(BYTE* pCnNodeId_p);
 #endif
 
 //============================================================================//
@@ -139,8 +192,25 @@ tEplKernel errhndk_init(void)
 
     ret = kEplSuccessful;
     instance_l.dllErrorEvents = 0;
+#ifdef CONFIG_INCLUDE_NMT_MN
+    EPL_MEMSET(instance_l.aMnCnLossPres, 0, sizeof(instance_l.aMnCnLossPres));
+    instance_l.mnCycleCnt = 0;
+    instance_l.cnNodeIdListGen = 0;
+    instance_l.refreshNodeIdx = 0;
+#endif
+    instance_l.cycleCnt = 0;
+    EPL_MEMSET(instance_l.aHistoryCoalesce, 0, sizeof(instance_l.aHistoryCoalesce));
+    instance_l.historyCoalesceUsed = 0;
+    instance_l.historyPostedCnt = 0;
+    instance_l.historySuppressedCnt = 0;
 
     ret = errhndkcal_init();
+    if (ret != kEplSuccessful)
+    {
+        return ret;
+    }
+
+    errhndkcal_setHistoryCoalesceStats(0, 0);
     return ret;
 }
 
@@ -230,6 +300,12 @@ tEplKernel errhndk_decrementCounters(BOOL fMN_p)
     // reset error events
     instance_l.dllErrorEvents = 0L;
 
+    instance_l.cycleCnt++;
+    if (instance_l.historyCoalesceUsed > 0)
+    {
+        processHistoryCoalesce();
+    }
+
     return kEplSuccessful;
 }
 
@@ -286,7 +362,10 @@ tEplKernel errhndk_resetCnError(UINT nodeId_p)
     if (nodeIdx >= NUM_DLL_MNCN_LOSSPRES_OBJS)
         return kEplInvalidNodeId;
 
-    instance_l.aMnCnLossPresEvent[nodeIdx] = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+    updateMnCnLossPres(nodeIdx);
+    instance_l.aMnCnLossPres[nodeIdx].event = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+    instance_l.aMnCnLossPres[nodeIdx].refCycleCnt = instance_l.mnCycleCnt;
+    publishMnCnLossPresDecay(nodeIdx);
     return kEplSuccessful;
 }
 #endif
@@ -303,47 +382,43 @@ tEplKernel errhndk_resetCnError(UINT nodeId_p)
 /**
 \brief    Decrement MN error counters
 
-The function decrements the error counters used by a MN node.
+The function decrements the error counters used by a MN node. The loss of PRes
+threshold counters of the CNs are not touched in every cycle. Only the cycle
+count is advanced and the decay is applied on demand by updateMnCnLossPres().
+The CN node-ID list is only scanned if it was changed by the DLL.
 
 \return Returns kEplSuccessful or error code
 */
 //------------------------------------------------------------------------------
 static tEplKernel decrementMnCounters(void)
 {
-    BYTE*           pCnNodeId;
-    UINT            nodeIdx;
-    UINT32          thresholdCnt;
+    BYTE*                   pCnNodeId;
+    UINT                    cnNodeIdListGen;
+    UINT32                  thresholdCnt;
+    tErrHndkMnCnLossPres*   pLossPres;
 
-    dllk_getCurrentCnNodeIdList(&pCnNodeId);
+    dllk_getCurrentCnNodeIdList(&pCnNodeId, &cnNodeIdListGen);
+    if (cnNodeIdListGen != instance_l.cnNodeIdListGen)
+    {
+        syncCnNodeIdList(pCnNodeId);
+        instance_l.cnNodeIdListGen = cnNodeIdListGen;
+    }
 
-    // iterate through node info structure list
-    while (*pCnNodeId != EPL_C_ADR_INVALID)
+    instance_l.mnCycleCnt++;
+    errhndkcal_setMnCycleCnt(instance_l.mnCycleCnt);
+
+    // Materialize one node per cycle if its pending decay becomes too large
+    pLossPres = &instance_l.aMnCnLossPres[instance_l.refreshNodeIdx];
+    if ((pLossPres->fActive != FALSE) &&
+        (pLossPres->event == ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE) &&
+        ((instance_l.mnCycleCnt - pLossPres->refCycleCnt) >= ERRORHANDLERK_MAX_PENDING_DECAY))
     {
-        nodeIdx = *pCnNodeId - 1;
-        if (nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS)
-        {
-            if  (instance_l.aMnCnLossPresEvent[nodeIdx] ==
-                 ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE)
-            {
-                errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx, &thresholdCnt);
-                if (thresholdCnt > 0)
-                {
-                    thresholdCnt--;
-                    errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
-                }
-            }
-            else
-            {
-                if (instance_l.aMnCnLossPresEvent[nodeIdx] ==
-                     ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC)
-                {
-                    instance_l.aMnCnLossPresEvent[nodeIdx] =
-                                          ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
-                }
-            }
-        }
-        pCnNodeId++;
+        updateMnCnLossPres(instance_l.refreshNodeIdx);
+        publishMnCnLossPresDecay(instance_l.refreshNodeIdx);
     }
+    instance_l.refreshNodeIdx++;
+    if (instance_l.refreshNodeIdx >= NUM_DLL_MNCN_LOSSPRES_OBJS)
+        instance_l.refreshNodeIdx = 0;
 
     if ((instance_l.dllErrorEvents & EPL_DLL_ERR_MN_CRC) == 0)
     {   // decrement CRC threshold counter, because it didn't occur last cycle
@@ -780,13 +855,18 @@ static tEplKernel handleMnCnLossPres(tEplEvent *pEvent_p)
     //if (nodeIdx >= tabentries(pErrorObjects_p->m_adwMnCnLossPresCumCnt))
     //    return kEplSuccessful;
 
-    errhndkcal_getMnCnLossPresError(nodeIdx, &cumulativeCnt,
-                                    &thresholdCnt, &threshold);
+    if (nodeIdx >= NUM_DLL_MNCN_LOSSPRES_OBJS)
+        return kEplSuccessful;
+
+    updateMnCnLossPres(nodeIdx);
 
-    if  (instance_l.aMnCnLossPresEvent[nodeIdx] !=
+    if  (instance_l.aMnCnLossPres[nodeIdx].event !=
                                   ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE)
         return kEplSuccessful;
 
+    errhndkcal_getMnCnLossPresError(nodeIdx, &cumulativeCnt,
+                                    &thresholdCnt, &threshold);
+
     cumulativeCnt++;
 
     // According to spec threshold counting is disabled by setting threshold to 0
@@ -796,8 +876,9 @@ static tEplKernel handleMnCnLossPres(tEplEvent *pEvent_p)
 
         if (thresholdCnt >= threshold)
         {
-            instance_l.aMnCnLossPresEvent[nodeIdx] =
+            instance_l.aMnCnLossPres[nodeIdx].event =
                             ERRORHANDLERK_CN_LOSS_PRES_EVENT_THR;
+            publishMnCnLossPresDecay(nodeIdx);
 
             ret = generateHistoryEntryNodeId(EPL_E_DLL_LOSS_PRES_TH,
                                              pEvent_p->m_NetTime,
@@ -821,8 +902,11 @@ static tEplKernel handleMnCnLossPres(tEplEvent *pEvent_p)
         }
         else
         {
-            instance_l.aMnCnLossPresEvent[nodeIdx] =
+            // the threshold counter is not decremented in the current cycle
+            instance_l.aMnCnLossPres[nodeIdx].event =
                             ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC;
+            instance_l.aMnCnLossPres[nodeIdx].refCycleCnt = instance_l.mnCycleCnt + 1;
+            publishMnCnLossPresDecay(nodeIdx);
         }
     }
     errhndkcal_setMnCnLossPresCounters(nodeIdx, cumulativeCnt, thresholdCnt);
@@ -920,27 +1004,198 @@ static tEplKernel postHeartbeatEvent(UINT nodeId_p, tNmtState state_p,
 /**
 \brief    Post a history entry event
 
-The function is used to post a history entry event to the API.
+The function is used to post a history entry event to the API. Repeated entries
+with the same error code and node ID within the coalescing window are not
+posted immediately. They are counted and reported by a single entry when the
+window expires (see processHistoryCoalesce()).
 
 \param  pHistoryEntry_p     Pointer to event which should be posted.
+\param  nodeId_p            Node ID the entry refers to (0 if not node specific)
+
+\return Returns kEplSuccessful or error code
+*/
+//------------------------------------------------------------------------------
+static tEplKernel postHistoryEntryEvent(tEplErrHistoryEntry* pHistoryEntry_p, UINT nodeId_p)
+{
+    tEplKernel                  ret;
+    UINT32                      window;
+    UINT                        i;
+    tErrHndkHistoryCoalesce*    pCoalesce;
+    tErrHndkHistoryCoalesce*    pFree = NULL;
+    tErrHndkHistoryCoalesce*    pOldest = NULL;
+
+    errhndkcal_getHistoryCoalesceWindow(&window);
+    if (window == 0)
+    {   // coalescing is disabled
+        return sendHistoryEntryEvent(pHistoryEntry_p, 1);
+    }
+
+    for (i = 0; i < CONFIG_ERRHND_HISTORY_COALESCE_ENTRIES; i++)
+    {
+        pCoalesce = &instance_l.aHistoryCoalesce[i];
+        if (pCoalesce->fUsed == FALSE)
+        {
+            if (pFree == NULL)
+            {
+                pFree = pCoalesce;
+            }
+            continue;
+        }
+
+        if ((pCoalesce->lastEntry.m_wErrorCode == pHistoryEntry_p->m_wErrorCode) &&
+            (pCoalesce->nodeId == nodeId_p))
+        {
+            if ((instance_l.cycleCnt - pCoalesce->startCycleCnt) < window)
+            {   // repeated within the window -> only count the occurrence
+                pCoalesce->suppressedCnt++;
+                pCoalesce->lastEntry = *pHistoryEntry_p;
+                instance_l.historySuppressedCnt++;
+                errhndkcal_setHistoryCoalesceStats(instance_l.historyPostedCnt,
+                                                   instance_l.historySuppressedCnt);
+                return kEplSuccessful;
+            }
+
+            // window expired but not processed yet (e.g. window was changed)
+            ret = flushHistoryEntry(pCoalesce);
+            if (ret != kEplSuccessful)
+            {
+                return ret;
+            }
+            pFree = pCoalesce;
+            break;
+        }
+
+        if ((pOldest == NULL) ||
+            ((instance_l.cycleCnt - pCoalesce->startCycleCnt) >
+             (instance_l.cycleCnt - pOldest->startCycleCnt)))
+        {
+            pOldest = pCoalesce;
+        }
+    }
+
+    if (pFree == NULL)
+    {   // all entries are in use -> report and reuse the oldest one
+        ret = flushHistoryEntry(pOldest);
+        if (ret != kEplSuccessful)
+        {
+            return ret;
+        }
+        pFree = pOldest;
+    }
+
+    // first occurrence is posted immediately and starts a new window
+    pFree->fUsed = TRUE;
+    pFree->nodeId = nodeId_p;
+    pFree->startCycleCnt = instance_l.cycleCnt;
+    pFree->suppressedCnt = 0;
+    pFree->lastEntry = *pHistoryEntry_p;
+    instance_l.historyCoalesceUsed++;
+
+    return sendHistoryEntryEvent(pHistoryEntry_p, 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Send a history entry event
+
+The function stores the occurrence count in the additional information of the
+history entry and posts it to the API.
+
+\param  pHistoryEntry_p     Pointer to history entry which should be posted.
+\param  occurrenceCnt_p     Number of occurrences represented by the entry
 
 \return Returns kEplSuccessful or error code
 */
 //------------------------------------------------------------------------------
-static tEplKernel postHistoryEntryEvent(tEplErrHistoryEntry* pHistoryEntry_p)
+static tEplKernel sendHistoryEntryEvent(tEplErrHistoryEntry* pHistoryEntry_p,
+                                        UINT32 occurrenceCnt_p)
 {
     tEplKernel              ret;
     tEplEvent               event;
+    tEplErrHistoryEntry     historyEntry;
+
+    historyEntry = *pHistoryEntry_p;
+    AmiSetDwordToLe(&historyEntry.m_abAddInfo[EPL_ERR_ADDINFO_OCCURRENCE_CNT],
+                    occurrenceCnt_p);
 
     event.m_EventSink = kEplEventSinkApi;
     event.m_EventType = kEplEventTypeHistoryEntry;
-    event.m_uiSize = sizeof (*pHistoryEntry_p);
-    event.m_pArg = pHistoryEntry_p;
+    event.m_uiSize = sizeof (historyEntry);
+    event.m_pArg = &historyEntry;
     ret = eventk_postEvent(&event);
 
+    instance_l.historyPostedCnt++;
+    errhndkcal_setHistoryCoalesceStats(instance_l.historyPostedCnt,
+                                       instance_l.historySuppressedCnt);
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Flush a coalesced history entry
+
+The function posts the last occurred history entry of a coalescing entry if
+occurrences were suppressed and releases the coalescing entry.
+
+\param  pCoalesce_p         Pointer to coalescing entry
+
+\return Returns kEplSuccessful or error code
+*/
+//------------------------------------------------------------------------------
+static tEplKernel flushHistoryEntry(tErrHndkHistoryCoalesce* pCoalesce_p)
+{
+    tEplKernel              ret = kEplSuccessful;
+
+    if (pCoalesce_p->suppressedCnt > 0)
+    {
+        ret = sendHistoryEntryEvent(&pCoalesce_p->lastEntry, pCoalesce_p->suppressedCnt);
+    }
+
+    pCoalesce_p->fUsed = FALSE;
+    instance_l.historyCoalesceUsed--;
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Process coalescing windows of history entries
+
+The function is called at the end of each cycle if history entries are being
+coalesced. For each expired window the suppressed occurrences are reported by
+a single history entry and a new window is started. Entries without further
+occurrences in the window are released.
+*/
+//------------------------------------------------------------------------------
+static void processHistoryCoalesce(void)
+{
+    UINT32                      window;
+    UINT                        i;
+    tErrHndkHistoryCoalesce*    pCoalesce;
+
+    errhndkcal_getHistoryCoalesceWindow(&window);
+
+    for (i = 0; i < CONFIG_ERRHND_HISTORY_COALESCE_ENTRIES; i++)
+    {
+        pCoalesce = &instance_l.aHistoryCoalesce[i];
+        if ((pCoalesce->fUsed == FALSE) ||
+            ((instance_l.cycleCnt - pCoalesce->startCycleCnt) < window))
+        {
+            continue;
+        }
+
+        if ((pCoalesce->suppressedCnt > 0) && (window != 0))
+        {   // error is still occurring -> report it and start a new window
+            sendHistoryEntryEvent(&pCoalesce->lastEntry, pCoalesce->suppressedCnt);
+            pCoalesce->suppressedCnt = 0;
+            pCoalesce->startCycleCnt = instance_l.cycleCnt;
+        }
+        else
+        {
+            flushHistoryEntry(pCoalesce);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief    Generate a history entry
@@ -965,9 +1220,9 @@ static tEplKernel generateHistoryEntry(UINT16 errorCode_p, tEplNetTime netTime_p
 
     historyEntry.m_wErrorCode = errorCode_p;
     historyEntry.m_TimeStamp = netTime_p;
-    memset (historyEntry.m_abAddInfo, 0, sizeof(historyEntry.m_abAddInfo));
+    EPL_MEMSET(historyEntry.m_abAddInfo, 0, sizeof(historyEntry.m_abAddInfo));
 
-    ret = postHistoryEntryEvent(&historyEntry);
+    ret = postHistoryEntryEvent(&historyEntry, 0);
     return ret;
 }
 
@@ -997,9 +1252,10 @@ static tEplKernel generateHistoryEntryNodeId(UINT16 errorCode_p,
 
     historyEntry.m_wErrorCode = errorCode_p;
     historyEntry.m_TimeStamp = netTime_p;
+    EPL_MEMSET(historyEntry.m_abAddInfo, 0, sizeof(historyEntry.m_abAddInfo));
     AmiSetByteToLe(&historyEntry.m_abAddInfo[0], (BYTE)nodeId_p);
 
-    ret = postHistoryEntryEvent(&historyEntry);
+    ret = postHistoryEntryEvent(&historyEntry, nodeId_p);
     return ret;
 }
 
@@ -1031,11 +1287,127 @@ static tEplKernel generateHistoryEntryWithError(UINT16 errorCode_p,
 
     historyEntry.m_wErrorCode = errorCode_p;
     historyEntry.m_TimeStamp = netTime_p;
+    EPL_MEMSET(historyEntry.m_abAddInfo, 0, sizeof(historyEntry.m_abAddInfo));
     AmiSetWordToLe(&historyEntry.m_abAddInfo[0], (UINT16)eplError_p);
 
-    ret = postHistoryEntryEvent(&historyEntry);
+    ret = postHistoryEntryEvent(&historyEntry, 0);
     return ret;
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief    Apply pending decay of loss of PRes threshold counter
+
+The function applies the decay of all cycles since the stored threshold counter
+of the specified CN was last updated. Afterwards the stored value is valid at
+the current cycle count. The decay is equivalent to decrementing the threshold
+counter at the end of each cycle in which the CN was in the isochronous phase
+and no error occurred.
+
+\param  nodeIdx_p               Index of node (node ID - 1)
+*/
+//------------------------------------------------------------------------------
+static void updateMnCnLossPres(UINT nodeIdx_p)
+{
+    tErrHndkMnCnLossPres*   pLossPres = &instance_l.aMnCnLossPres[nodeIdx_p];
+    UINT32                  decay;
+    UINT32                  thresholdCnt;
+
+    if ((pLossPres->fActive == FALSE) ||
+        (pLossPres->event == ERRORHANDLERK_CN_LOSS_PRES_EVENT_THR))
+        return;
+
+    if (pLossPres->event == ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC)
+    {
+        if ((INT32)(instance_l.mnCycleCnt - pLossPres->refCycleCnt) < 0)
+            return;     // cycle in which the error occurred is not finished yet
+
+        pLossPres->event = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+    }
+
+    decay = ERRHND_GET_DECAY(instance_l.mnCycleCnt, pLossPres->refCycleCnt);
+    if (decay > 0)
+    {
+        errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx_p, &thresholdCnt);
+        if (thresholdCnt > 0)
+        {
+            thresholdCnt = (thresholdCnt > decay) ? (thresholdCnt - decay) : 0;
+            errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx_p, thresholdCnt);
+        }
+    }
+    pLossPres->refCycleCnt = instance_l.mnCycleCnt;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Publish decay state of loss of PRes threshold counter
+
+The function stores the decay state of the specified CN in the error objects,
+so that the user part of the error handler is able to calculate the current
+value of the threshold counter.
+
+\param  nodeIdx_p               Index of node (node ID - 1)
+*/
+//------------------------------------------------------------------------------
+static void publishMnCnLossPresDecay(UINT nodeIdx_p)
+{
+    tErrHndkMnCnLossPres*   pLossPres = &instance_l.aMnCnLossPres[nodeIdx_p];
+    BOOL                    fDecay;
+
+    fDecay = ((pLossPres->fActive != FALSE) &&
+              (pLossPres->event != ERRORHANDLERK_CN_LOSS_PRES_EVENT_THR));
+    errhndkcal_setMnCnLossPresDecay(nodeIdx_p, pLossPres->refCycleCnt, fDecay);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Synchronize CNs with changed node-ID list
+
+The function is called if the DLL changed the CN node-ID list. CNs which left
+the isochronous phase get their pending decay applied and CNs which joined
+start to decay with the upcoming cycle.
+
+\param  pCnNodeId_p             Pointer to node-ID list terminated by
+                                EPL_C_ADR_INVALID
+*/
+//------------------------------------------------------------------------------
+static void syncCnNodeIdList(BYTE* pCnNodeId_p)
+{
+    UINT                    nodeIdx;
+    tErrHndkMnCnLossPres*   pLossPres;
+
+    while (*pCnNodeId_p != EPL_C_ADR_INVALID)
+    {
+        nodeIdx = *pCnNodeId_p - 1;
+        if (nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS)
+            instance_l.aMnCnLossPres[nodeIdx].fInList = TRUE;
+        pCnNodeId_p++;
+    }
+
+    for (nodeIdx = 0; nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS; nodeIdx++)
+    {
+        pLossPres = &instance_l.aMnCnLossPres[nodeIdx];
+        if (pLossPres->fInList != pLossPres->fActive)
+        {
+            if (pLossPres->fInList == FALSE)
+            {   // node left isochronous phase
+                updateMnCnLossPres(nodeIdx);
+                pLossPres->fActive = FALSE;
+            }
+            else
+            {   // node joined isochronous phase, a pending error event is
+                // consumed by the upcoming cycle
+                pLossPres->fActive = TRUE;
+                if (pLossPres->event == ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC)
+                    pLossPres->refCycleCnt = instance_l.mnCycleCnt + 1;
+                else
+                    pLossPres->refCycleCnt = instance_l.mnCycleCnt;
+            }
+            publishMnCnLossPresDecay(nodeIdx);
+        }
+        pLossPres->fInList = FALSE;
+    }
+}
 #endif
 
 //------------------------------------------------------------------------------
@@ -523,8 +523,64 @@ void errhndkcal_setMnCnLossPresThresholdCnt(UINT nodeIdx_p, UINT32 dwThresholdCn
 {
     pErrHnd_l->aMnCnLossPres[nodeIdx_p].thresholdCnt = dwThresholdCnt_p;
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set cycle count of MN
+
+The cycle count is the time base for the decay of the MnCnLossPres threshold
+counters.
+
+\param  cycleCnt_p              Number of finished cycles
+*/
+//------------------------------------------------------------------------------
+void errhndkcal_setMnCycleCnt(UINT32 cycleCnt_p)
+{
+    pErrHnd_l->mnCycleCnt = cycleCnt_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set decay state of MnCnLossPres threshold counter
+
+\param  nodeIdx_p               Index of node (node ID - 1)
+\param  refCycleCnt_p           Cycle count at which the threshold counter is valid
+\param  fDecay_p                Threshold counter is decremented each cycle
+*/
+//------------------------------------------------------------------------------
+void errhndkcal_setMnCnLossPresDecay(UINT nodeIdx_p, UINT32 refCycleCnt_p, BOOL fDecay_p)
+{
+    pErrHnd_l->aMnCnLossPresDecay[nodeIdx_p].refCycleCnt = refCycleCnt_p;
+    pErrHnd_l->aMnCnLossPresDecay[nodeIdx_p].fDecay = (UINT32)fDecay_p;
+}
 #endif
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get coalescing window of history entries
+
+\param  pWindow_p               Pointer to store the window in cycles
+*/
+//------------------------------------------------------------------------------
+void errhndkcal_getHistoryCoalesceWindow(UINT32* pWindow_p)
+{
+    *pWindow_p = pErrHnd_l->historyCoalesce.window;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set coalescing statistics of history entries
+
+\param  postedCnt_p             Number of posted history entry events
+\param  suppressedCnt_p         Number of coalesced occurrences
+*/
+//------------------------------------------------------------------------------
+void errhndkcal_setHistoryCoalesceStats(UINT32 postedCnt_p, UINT32 suppressedCnt_p)
+{
+    pErrHnd_l->historyCoalesce.postedCnt = postedCnt_p;
+    pErrHnd_l->historyCoalesce.suppressedCnt = suppressedCnt_p;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -95,6 +95,14 @@ void errhndkcal_setMnCrcThresholdCnt(UINT32 thresholdCnt_p) SECTION_ERRHNDKCAL_S
 void errhndkcal_setMnCycTimeExceedThresholdCnt(UINT32 thresholdCnt_p) SECTION_ERRHNDKCAL_SETMNCNT;
 void errhndkcal_setMnCnLossPresThresholdCnt(UINT nodeIdx_p, UINT32 thresholdCnt_p) SECTION_ERRHNDKCAL_SETMNCNT;
 
+/* Coalescing of history entries */
+void errhndkcal_getHistoryCoalesceWindow(UINT32* pWindow_p);
+void errhndkcal_setHistoryCoalesceStats(UINT32 postedCnt_p, UINT32 suppressedCnt_p);
+
+/* Writing of threshold counter decay state */
+void errhndkcal_setMnCycleCnt(UINT32 cycleCnt_p) SECTION_ERRHNDKCAL_SETMNCNT;
+void errhndkcal_setMnCnLossPresDecay(UINT nodeIdx_p, UINT32 refCycleCnt_p, BOOL fDecay_p) SECTION_ERRHNDKCAL_SETMNCNT;
+
 #ifdef __cplusplus
 }
 #endif
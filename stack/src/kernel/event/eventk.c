@@ -258,6 +258,11 @@ tEplKernel eventk_postEvent (tEplEvent *pEvent_p)
 {
     tEplKernel ret = kEplSuccessful;
 
+#if defined(CONFIG_TARGET_NETTIME)
+    // stamp the event with the time it is raised
+    EplTgtGetNetTime(&pEvent_p->m_NetTime);
+#endif
+
     switch(pEvent_p->m_EventSink)
     {
         case kEplEventSinkNmtMnu:
@@ -129,7 +129,6 @@ The function initializes the kernel event CAL module on Linux.
 //------------------------------------------------------------------------------
 tEplKernel eventkcal_init (void)
 {
-    struct sched_param  schedParam;
 
     EPL_MEMSET(&instance_l, 0, sizeof(tEventkCalInstance));
 
@@ -156,11 +155,11 @@ tEplKernel eventkcal_init (void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.__sched_priority = KERNEL_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_setThreadSchedParam(instance_l.threadId, kEplThreadEventKernel,
+                                   SCHED_FIFO, KERNEL_EVENT_THREAD_PRIORITY) != 0)
     {
-        EPL_DBGLVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-               __func__, schedParam.__sched_priority);
+        EPL_DBGLVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters!\n",
+               __func__);
     }
 
     instance_l.fInitialized = TRUE;
@@ -48,6 +48,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/eventkcal.h>
 #include <kernel/eventkcalintf.h>
 #include <circbuffer.h>
+#include <shmring.h>
+#include <powerlink-module.h>
 
 #include <linux/kthread.h>
 #include <asm/uaccess.h>
@@ -55,6 +57,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <linux/errno.h>
 #include <linux/wait.h>
 #include <linux/delay.h>
+#include <linux/spinlock.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -99,12 +102,12 @@ typedef struct
     struct task_struct      *threadId;
     wait_queue_head_t       kernelWaitQueue;
     wait_queue_head_t       userWaitQueue;
-    atomic_t                userEventCount;
     atomic_t                kernelEventCount;
     BOOL                    fThreadIsRunning;
     BOOL                    fInitialized;
-    BYTE                    aUintRxBuffer[sizeof(tEplEvent) + EPL_MAX_EVENT_ARG_SIZE];
-    BYTE                    aK2URxBuffer[sizeof(tEplEvent) + EPL_MAX_EVENT_ARG_SIZE];
+    BYTE*                   pEventRingMem;          ///< Memory of the event ring mapped into user space
+    tShmRingInstance        eventRing;              ///< Kernel to user event ring
+    spinlock_t              eventRingLock;          ///< Serializes the kernel producers of the event ring
 } tEventkCalInstance;
 
 //------------------------------------------------------------------------------
@@ -117,8 +120,8 @@ static tEventkCalInstance   instance_l;             ///< Instance variable of ke
 // local function prototypes
 //------------------------------------------------------------------------------
 static int eventThread(void *arg);
-static void signalUserEvent(void);
 static void signalKernelEvent(void);
+static tEplKernel postEventToUser(tEplEvent* pEvent_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -132,6 +135,10 @@ The function initializes the kernel event CAL module. Depending on the
 configuration it gets the function pointer interface of the used queue
 implementations and calls the appropriate init functions.
 
+Events for the user layer are not stored in a circular buffer but in the event
+ring which is mapped into the user application. The user layer reads the
+events directly from the ring and uses the ioctl only to wait for new events.
+
 \return The function returns a tEplKernel error code.
 \retval kEplSuccessful          If function executes correctly
 \retval other error codes       If an error occurred
@@ -146,26 +153,25 @@ tEplKernel eventkcal_init (void)
     init_waitqueue_head(&instance_l.kernelWaitQueue);
     init_waitqueue_head(&instance_l.userWaitQueue);
     atomic_set(&instance_l.kernelEventCount, 0);
-    atomic_set(&instance_l.userEventCount, 0);
+    spin_lock_init(&instance_l.eventRingLock);
 
-    if (eventkcal_initQueueCircbuf(kEventQueueK2U) != kEplSuccessful)
+    instance_l.pEventRingMem = (BYTE*)__get_free_pages(GFP_KERNEL | __GFP_ZERO,
+                                                       get_order(PLK_EVENT_RING_SIZE));
+    if (instance_l.pEventRingMem == NULL)
         goto Exit;
 
-    if (eventkcal_initQueueCircbuf(kEventQueueU2K) != kEplSuccessful)
+    if (shmring_init(&instance_l.eventRing, instance_l.pEventRingMem,
+                     PLK_EVENT_RING_SIZE) != kShmRingOk)
         goto Exit;
 
-    if (eventkcal_initQueueCircbuf(kEventQueueKInt) != kEplSuccessful)
+    if (eventkcal_initQueueCircbuf(kEventQueueU2K) != kEplSuccessful)
         goto Exit;
 
-    if (eventkcal_initQueueCircbuf(kEventQueueUInt) != kEplSuccessful)
+    if (eventkcal_initQueueCircbuf(kEventQueueKInt) != kEplSuccessful)
         goto Exit;
 
-    eventkcal_setSignalingCircbuf(kEventQueueK2U, signalUserEvent);
-
     eventkcal_setSignalingCircbuf(kEventQueueU2K, signalKernelEvent);
 
-    eventkcal_setSignalingCircbuf(kEventQueueUInt, signalUserEvent);
-
     eventkcal_setSignalingCircbuf(kEventQueueKInt, signalKernelEvent);
 
     instance_l.threadId =  kthread_run(eventThread, NULL, "EventkThread");
@@ -178,10 +184,13 @@ tEplKernel eventkcal_init (void)
 
 Exit:
     TRACE("%s() Initialization error!\n", __func__);
-    eventkcal_exitQueueCircbuf(kEventQueueK2U);
     eventkcal_exitQueueCircbuf(kEventQueueU2K);
     eventkcal_exitQueueCircbuf(kEventQueueKInt);
-    eventkcal_exitQueueCircbuf(kEventQueueUInt);
+    if (instance_l.pEventRingMem != NULL)
+    {
+        free_pages((ULONG)instance_l.pEventRingMem, get_order(PLK_EVENT_RING_SIZE));
+        instance_l.pEventRingMem = NULL;
+    }
 
     return kEplNoResource;
 }
@@ -218,11 +227,12 @@ tEplKernel eventkcal_exit (void)
         }
     }
 
-    eventkcal_exitQueueCircbuf(kEventQueueK2U);
     eventkcal_exitQueueCircbuf(kEventQueueU2K);
-    eventkcal_exitQueueCircbuf(kEventQueueUInt);
     eventkcal_exitQueueCircbuf(kEventQueueKInt);
 
+    free_pages((ULONG)instance_l.pEventRingMem, get_order(PLK_EVENT_RING_SIZE));
+    instance_l.pEventRingMem = NULL;
+
     return kEplSuccessful;
 }
 
@@ -252,7 +262,7 @@ tEplKernel eventkcal_postUserEvent (tEplEvent *pEvent_p)
            EplGetEventSinkStr(pEvent_p->m_EventSink), pEvent_p->m_EventSink,
            pEvent_p->m_uiSize);*/
 
-    ret = eventkcal_postEventCircbuf(kEventQueueK2U, pEvent_p);
+    ret = postEventToUser(pEvent_p);
 
     return ret;
 }
@@ -371,7 +381,7 @@ int eventkcal_postEventFromUser(unsigned long arg)
                    EplGetEventTypeStr(event.m_EventType), event.m_EventType,
                    EplGetEventSinkStr(event.m_EventSink), event.m_EventSink,
                    event.m_uiSize);*/
-            ret = eventkcal_postEventCircbuf(kEventQueueUInt, &event);
+            ret = postEventToUser(&event);
             break;
 
         default:
@@ -387,80 +397,56 @@ int eventkcal_postEventFromUser(unsigned long arg)
 
 //------------------------------------------------------------------------------
 /**
-\brief    Get a event for the user layer
-
-This function waits for events to the user.
+\brief    Wait for events for the user layer
 
-\param  arg                Ioctl argument. Contains the received event.
+This function waits until the event ring for the user layer contains events.
+The events are read by the user layer directly from the mapped ring.
 
 \return The function returns Linux error code.
+\retval 0                       The event ring contains events.
+\retval -ERESTARTSYS            Timeout or interrupted by a signal.
 
 \ingroup module_eventkcal
 */
 //------------------------------------------------------------------------------
-int eventkcal_getEventForUser(unsigned long arg)
+int eventkcal_waitEventForUser(void)
 {
-    tEplKernel          error;
     int                 ret;
-    size_t              readSize;
     int                 timeout = 500 * HZ / 1000;
 
     if (!instance_l.fInitialized)
         return -EIO;
 
     ret = wait_event_interruptible_timeout(instance_l.userWaitQueue,
-                             (atomic_read(&instance_l.userEventCount) > 0), timeout);
+                             !shmring_isEmpty(&instance_l.eventRing), timeout);
     if (ret == 0)
-    {
-        //TRACE("%s() timeout!\n", __func__);
         return -ERESTARTSYS;
-    }
 
-    if (ret == -ERESTARTSYS)
-    {
-        //TRACE("%s() interrupted\n", __func__);
+    if (ret < 0)
         return ret;
-    }
-
-    if (eventkcal_getEventCountCircbuf(kEventQueueK2U) > 0)
-    {
-        atomic_dec(&instance_l.userEventCount);
-
-        error = eventkcal_getEventCircbuf(kEventQueueK2U, instance_l.aK2URxBuffer, &readSize);
-        if(error != kEplSuccessful)
-        {
-            EPL_DBGLVL_ERROR_TRACE ("%s() Error reading K2U events %d!\n", __func__, error);
-            return -EIO;
-        }
 
-        //TRACE("%s() copy kernel event to user: %d Bytes\n", __func__, readSize);
-        if (copy_to_user((void __user *)arg, instance_l.aK2URxBuffer, readSize))
-            return -EFAULT;
+    return 0;
+}
 
-        return 0;
-    }
-    else
-    {
+//------------------------------------------------------------------------------
+/**
+\brief    Get the memory of the event ring
 
-        if (eventkcal_getEventCountCircbuf(kEventQueueUInt) > 0)
-        {
-            atomic_dec(&instance_l.userEventCount);
+This function returns the memory of the event ring for mapping it into the
+user application.
 
-            error = eventkcal_getEventCircbuf(kEventQueueUInt, instance_l.aUintRxBuffer, &readSize);
-            if(error != kEplSuccessful)
-            {
-                EPL_DBGLVL_ERROR_TRACE ("%s() Error reading UINT events %d!\n", __func__, error);
-                return -EIO;
-            }
+\param  pSize_p                 Pointer to store the size of the memory.
 
-            //TRACE("%s() copy user event to user: %d Bytes\n", __func__, readSize);
-            if(copy_to_user((void __user *)arg, instance_l.aUintRxBuffer, readSize))
-                return -EFAULT;
+\return The function returns the pointer to the memory of the event ring or
+        NULL if it isn't available.
 
-            return 0;
-        }
-    }
-    return -ERESTARTSYS;
+\ingroup module_eventkcal
+*/
+//------------------------------------------------------------------------------
+BYTE* eventkcal_getEventRingMem(size_t* pSize_p)
+{
+    *pSize_p = PLK_EVENT_RING_SIZE;
+    return instance_l.pEventRingMem;
 }
 
 //============================================================================//
@@ -527,16 +513,37 @@ static int eventThread(void *arg)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Signal a user event
+\brief  Post an event to the user layer
 
-This function signals that a user event was posted. It will be registered in
-the circular buffer library as signal callback function
+This function writes an event and its argument as one entry into the event ring
+and wakes up the user layer. The kernel layer posts events from different
+contexts, therefore the producer side of the ring is protected by a spinlock.
+
+\param  pEvent_p                Event to be posted.
+
+\return The function returns a tEplKernel error code.
+\retval kEplSuccessful          If function executes correctly
+\retval kEplEventPostError      If the event ring is full
 */
 //------------------------------------------------------------------------------
-void signalUserEvent(void)
+static tEplKernel postEventToUser(tEplEvent* pEvent_p)
 {
-    atomic_inc(&instance_l.userEventCount);
+    tShmRingError       ringError;
+    ULONG               flags;
+
+    spin_lock_irqsave(&instance_l.eventRingLock, flags);
+    ringError = shmring_writeMultipleData(&instance_l.eventRing, pEvent_p, sizeof(tEplEvent),
+                                          pEvent_p->m_pArg, pEvent_p->m_uiSize);
+    spin_unlock_irqrestore(&instance_l.eventRingLock, flags);
+
+    if (ringError != kShmRingOk)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() Error writing event to user ring %d!\n", __func__, ringError);
+        return kEplEventPostError;
+    }
+
     wake_up_interruptible(&instance_l.userWaitQueue);
+    return kEplSuccessful;
 }
 
 //------------------------------------------------------------------------------
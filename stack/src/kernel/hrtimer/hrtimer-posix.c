@@ -171,7 +171,6 @@ tEplKernel PUBLIC EplTimerHighReskAddInstance(void)
 {
     tEplKernel                   Ret;
     UINT                         uiIndex;
-    struct sched_param           schedParam;
     tEplTimerHighReskTimerInfo*  pTimerInfo;
     struct sigevent              sev;
 
@@ -202,8 +201,8 @@ tEplKernel PUBLIC EplTimerHighReskAddInstance(void)
         goto Exit;
     }
 
-    schedParam.__sched_priority = EPL_THREAD_PRIORITY_HIGH;
-    if (pthread_setschedparam(EplTimerHighReskInstance_l.m_thread, SCHED_FIFO, &schedParam) != 0)
+    if (target_setThreadSchedParam(EplTimerHighReskInstance_l.m_thread, kEplThreadHrTimer,
+                                   SCHED_FIFO, EPL_THREAD_PRIORITY_HIGH) != 0)
     {
         EPL_DBGLVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
         Ret = kEplNoResource;
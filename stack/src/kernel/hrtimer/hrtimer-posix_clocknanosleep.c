@@ -191,7 +191,6 @@ tEplKernel PUBLIC EplTimerHighReskAddInstance(void)
 {
     tEplKernel                   Ret;
     UINT                         uiIndex;
-    struct sched_param           schedParam;
     tEplTimerHighReskTimerInfo*  pTimerInfo;
 
     Ret = kEplSuccessful;
@@ -224,8 +223,8 @@ tEplKernel PUBLIC EplTimerHighReskAddInstance(void)
             goto Exit;
         }
 
-        schedParam.__sched_priority = EPL_THREAD_PRIORITY_HIGH;
-        if (pthread_setschedparam(pTimerInfo->m_timerThread, SCHED_FIFO, &schedParam) != 0)
+        if (target_setThreadSchedParam(pTimerInfo->m_timerThread, kEplThreadHrTimer,
+                                       SCHED_FIFO, EPL_THREAD_PRIORITY_HIGH) != 0)
         {
             EPL_DBGLVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
             Ret = kEplNoResource;
@@ -124,6 +124,7 @@ typedef struct
 {
     tNmtState                   nmtState;
     tNmtkStateFunc              pfnState;
+    UINT                        dllEventMask;   ///< DLL generated NMT events processed in this state
 } tNmtkStateTable;
 
 //------------------------------------------------------------------------------
@@ -162,25 +163,25 @@ static tEplKernel doStateCsStopped(tNmtEvent nmtEvent_p);
 //------------------------------------------------------------------------------
 tNmtkStateTable             nmtkStates_g[] =
 {
-    { kNmtGsOff,                 doStateGsOff },
-    { kNmtGsInitialising,        doStateGsInitialising },
-    { kNmtGsResetApplication,    doStateGsResetApplication },
-    { kNmtGsResetCommunication,  doStateGsResetCommunication },
-    { kNmtGsResetConfiguration,  doStateGsResetConfiguration },
-    { kNmtCsNotActive,           doStateCsNotActive },
-    { kNmtCsPreOperational1,     doStateCsPreOperational1 },
-    { kNmtCsStopped,             doStateCsStopped },
-    { kNmtCsPreOperational2,     doStateCsPreOperational2 },
-    { kNmtCsReadyToOperate,      doStateCsReadyToOperate },
-    { kNmtCsOperational,         doStateCsOperational },
-    { kNmtCsBasicEthernet,       doStateCsBasicEthernet },
-    { kNmtMsNotActive,           doStateMsNotActive },
+    { kNmtGsOff,                 doStateGsOff,                  DLLK_NMTEVENT_NONE },
+    { kNmtGsInitialising,        doStateGsInitialising,         DLLK_NMTEVENT_NONE },
+    { kNmtGsResetApplication,    doStateGsResetApplication,     DLLK_NMTEVENT_NONE },
+    { kNmtGsResetCommunication,  doStateGsResetCommunication,   DLLK_NMTEVENT_NONE },
+    { kNmtGsResetConfiguration,  doStateGsResetConfiguration,   DLLK_NMTEVENT_NONE },
+    { kNmtCsNotActive,           doStateCsNotActive,            DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA },
+    { kNmtCsPreOperational1,     doStateCsPreOperational1,      DLLK_NMTEVENT_SOC },
+    { kNmtCsStopped,             doStateCsStopped,              DLLK_NMTEVENT_NONE },
+    { kNmtCsPreOperational2,     doStateCsPreOperational2,      DLLK_NMTEVENT_NONE },
+    { kNmtCsReadyToOperate,      doStateCsReadyToOperate,       DLLK_NMTEVENT_NONE },
+    { kNmtCsOperational,         doStateCsOperational,          DLLK_NMTEVENT_NONE },
+    { kNmtCsBasicEthernet,       doStateCsBasicEthernet,        DLLK_NMTEVENT_ALL },
+    { kNmtMsNotActive,           doStateMsNotActive,            DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA },
 #if defined(CONFIG_INCLUDE_NMT_MN)
-    { kNmtMsPreOperational1,     doStateMsPreOperational1 },
-    { kNmtMsPreOperational2,     doStateMsPreOperational2 },
-    { kNmtMsReadyToOperate,      doStateMsReadyToOperate },
-    { kNmtMsOperational,         doStateMsOperational },
-    { kNmtMsBasicEthernet,       doStateMsBasicEthernet }
+    { kNmtMsPreOperational1,     doStateMsPreOperational1,      DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA },
+    { kNmtMsPreOperational2,     doStateMsPreOperational2,      DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA },
+    { kNmtMsReadyToOperate,      doStateMsReadyToOperate,       DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA },
+    { kNmtMsOperational,         doStateMsOperational,          DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA },
+    { kNmtMsBasicEthernet,       doStateMsBasicEthernet,        DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA }
 #endif
 };
 
@@ -289,6 +290,9 @@ tEplKernel nmtk_process(tEplEvent* pEvent_p)
         event.m_pArg = &nmtStateChange;
         event.m_uiSize = sizeof(nmtStateChange);
 
+        // tell DLLk which NMT events of received frames are processed in the new state
+        dllk_setNmtEventMask(nmtkStates_g[nmtkInstance_g.stateIndex].dllEventMask);
+
         // inform DLLk module about state change
         event.m_EventSink = kEplEventSinkDllk;
         ret = dllk_process(&event);
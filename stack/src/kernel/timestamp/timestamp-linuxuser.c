@@ -0,0 +1,237 @@
+/**
+********************************************************************************
+\file   timestamp-linuxuser.c
+
+\brief  Target specific time stamp functions of Linux userspace
+
+This file contains the functions to handle the target specific time stamps
+on Linux userspace. The time stamps are kept in nanoseconds, therefore the
+difference of two time stamps is computed without any conversion.
+
+The current time and the net time of events and SoC frames are read from one
+clock, so that error history entries, cycle diagnostics and application
+events share a common timebase. CLOCK_TAI is used by default, because the net
+time is defined as IEEE 1588 time. Define TIMESTAMP_LINUXUSER_CLOCK as
+CLOCK_MONOTONIC_RAW to get a timebase which is not affected by adjustments of
+the system time.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <timestamp_linuxuser.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef TIMESTAMP_LINUXUSER_CLOCK
+#ifdef CLOCK_TAI
+#define TIMESTAMP_LINUXUSER_CLOCK   CLOCK_TAI
+#else
+#define TIMESTAMP_LINUXUSER_CLOCK   CLOCK_MONOTONIC_RAW     // CLOCK_TAI is not defined by glibc < 2.21
+#endif
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time stamp
+
+The function returns the current time of the time stamp clock.
+
+\return The function returns the time stamp in ns.
+*/
+//------------------------------------------------------------------------------
+unsigned long long PUBLIC EplTgtGetTimeStampNs(void)
+{
+    struct timespec     ts;
+
+    clock_gettime(TIMESTAMP_LINUXUSER_CLOCK, &ts);
+
+    return ((unsigned long long) ts.tv_sec * 1000000000ULL) + (unsigned long long) ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current net time
+
+The function returns the current time of the time stamp clock as net time.
+It is used to stamp the kernel events and the SoC frames.
+
+\param  pNetTime_p          Pointer to store the net time.
+*/
+//------------------------------------------------------------------------------
+void PUBLIC EplTgtGetNetTime(tEplNetTime* pNetTime_p)
+{
+    struct timespec     ts;
+
+    clock_gettime(TIMESTAMP_LINUXUSER_CLOCK, &ts);
+
+    pNetTime_p->m_dwSec = (DWORD) ts.tv_sec;
+    pNetTime_p->m_dwNanoSec = (DWORD) ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate time difference of two time stamps
+
+The function calculates the time difference between two time stamps. A
+successor which is older than the predecessor results in a difference of 0.
+
+\param  pTimeStampPredecessor_p     Time stamp which was taken earlier.
+\param  pTimeStampSuccessor_p       Time stamp which was taken later.
+
+\return The function returns the time difference in ns.
+*/
+//------------------------------------------------------------------------------
+DWORD PUBLIC EplTgtTimeStampTimeDiffNs(tEplTgtTimeStamp* pTimeStampPredecessor_p,
+                                       tEplTgtTimeStamp* pTimeStampSuccessor_p)
+{
+    if (pTimeStampSuccessor_p->timeStampNs < pTimeStampPredecessor_p->timeStampNs)
+        return 0;
+
+    return (DWORD)(pTimeStampSuccessor_p->timeStampNs - pTimeStampPredecessor_p->timeStampNs);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a time stamp
+
+The function allocates memory for one time stamp.
+
+\return The function returns a pointer to the time stamp or NULL if no memory
+        is available.
+*/
+//------------------------------------------------------------------------------
+tEplTgtTimeStamp* PUBLIC EplTgtTimeStampAlloc(void)
+{
+    return (tEplTgtTimeStamp*) calloc(1, sizeof (struct _tEplTgtTimeStamp));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a time stamp
+
+The function frees a time stamp which was allocated by EplTgtTimeStampAlloc().
+
+\param  pTimeStamp_p        Time stamp to be freed.
+*/
+//------------------------------------------------------------------------------
+void PUBLIC EplTgtTimeStampFree(tEplTgtTimeStamp* pTimeStamp_p)
+{
+    free(pTimeStamp_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy a time stamp
+
+The function copies one time stamp to another.
+
+\param  pTimeStampDest_p    Destination time stamp.
+\param  pTimeStampSrc_p     Source time stamp.
+*/
+//------------------------------------------------------------------------------
+void PUBLIC EplTgtTimeStampCopy(tEplTgtTimeStamp* pTimeStampDest_p,
+                                tEplTgtTimeStamp* pTimeStampSrc_p)
+{
+    *pTimeStampDest_p = *pTimeStampSrc_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set a time stamp from a capture time
+
+The function sets a time stamp from the capture time of a frame as it is
+reported by libpcap and stored in pcap savefiles. If the capture was opened
+with nanosecond precision, the sub-second part of the time value contains
+nanoseconds instead of microseconds.
+
+\param  pTimeStamp_p        Time stamp to be set.
+\param  pTimeval_p          Capture time of the frame.
+\param  fNanoPrecision_p    TRUE if the sub-second part contains nanoseconds.
+*/
+//------------------------------------------------------------------------------
+void EplTgtTimeStampSetTimeval(tEplTgtTimeStamp* pTimeStamp_p,
+                               const struct timeval* pTimeval_p,
+                               BOOL fNanoPrecision_p)
+{
+    UINT64      subSecNs;
+
+    subSecNs = (UINT64) pTimeval_p->tv_usec;
+    if (fNanoPrecision_p == FALSE)
+        subSecNs *= 1000;
+
+    pTimeStamp_p->timeStampNs = ((UINT64) pTimeval_p->tv_sec * 1000000000ULL) + subSecNs;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
@@ -167,6 +167,12 @@ tEplKernel veth_addInstance(const UINT8 aSrcMac_p[6])
     if (pthread_create(&vethInstance_l.threadHandle, NULL, vethRecvThread, (void*)&vethInstance_l) != 0)
         return kEplNoFreeInstance;
 
+    // the receive thread keeps the inherited scheduling unless configured
+    if (target_setThreadSchedParam(vethInstance_l.threadHandle, kEplThreadVeth, -1, 0) != 0)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
+    }
+
     // register callback function in DLL
     ret = dllk_regAsyncHandler(veth_receiveFrame);
 
@@ -50,14 +50,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/nmtcnu.h>
 #include <user/nmtmnu.h>
 #include <user/EplSdoComu.h>
+#include <user/sdobatchu.h>
 #include <user/identu.h>
 #include <user/cfmu.h>
 #include <user/ctrlu.h>
+#include <user/errhndu.h>
 
 #if (CONFIG_OBD_USE_LOAD_CONCISEDCF != FALSE)
 #include "obdcdc.h"
 #endif
 
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+#include "obdstore.h"
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -470,6 +476,68 @@ tEplKernel oplk_writeObject(tSdoComConHdl* pSdoComConHdl_p, UINT nodeId_p, UINT
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Start a batch of object accesses
+
+The function starts a batch of read and write accesses to the object
+dictionaries of the local and of remote nodes. Accesses to the local node are
+performed immediately. Accesses to remote nodes are queued per node and
+transferred one after the other over a single SDO connection per node, while
+different nodes are served in parallel.
+
+If requested by the batch, every finished remote access is reported by the
+event kEplApiEventSdoBatchItem. When all accesses are finished, the event
+kEplApiEventSdoBatch is posted. The results of the accesses are stored in the
+items of the batch.
+
+\param  pSdoBatch_p         Pointer to the batch. The batch and its items must
+                            remain valid until the batch is finished.
+
+\return The function returns a tEplKernel error code.
+\retval kEplSuccessful          All accesses addressed the local node and are
+                                finished.
+\retval kEplApiTaskDeferred     The batch was started. The application is
+                                informed by the event callback function when
+                                it is finished.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_startSdoBatch(tSdoBatch* pSdoBatch_p)
+{
+#if defined(CONFIG_INCLUDE_SDOC)
+    return sdobatchu_start(pSdoBatch_p);
+#else
+    UNUSED_PARAMETER(pSdoBatch_p);
+    return kEplApiInvalidParam;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Abort a batch of object accesses
+
+The function aborts all accesses of the specified batch which are not finished
+yet. The finished batch is reported by the event kEplApiEventSdoBatch.
+
+\param  pSdoBatch_p         Pointer to the batch to abort.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_abortSdoBatch(tSdoBatch* pSdoBatch_p)
+{
+#if defined(CONFIG_INCLUDE_SDOC)
+    return sdobatchu_abort(pSdoBatch_p);
+#else
+    UNUSED_PARAMETER(pSdoBatch_p);
+    return kEplApiInvalidParam;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Free SDO channel
@@ -799,6 +867,31 @@ tEplKernel oplk_setCdcFilename(char* pCdcFilename_p)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set OD store path
+
+The function sets the directory in which the stack stores the objects with the
+store attribute when object 0x1010 (NMT_StoreParam_REC) is written.
+
+\param  pStorePath_p    Directory for the stored object dictionary images.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_setOdStorePath(char* pStorePath_p)
+{
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+    obdstore_setPath(pStorePath_p);
+    return kEplSuccessful;
+#else
+    UNUSED_PARAMETER(pStorePath_p);
+    return kEplApiInvalidParam;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Stack process function
@@ -852,6 +945,78 @@ tEplKernel oplk_waitSyncEvent(ULONG timeout_p)
     return pdoucal_waitSyncEvent(timeout_p);
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief Get number of missed sync events
+
+The function returns the number of sync events which have been missed by the
+application because it was still processing a previous sync event.
+
+\param  pCount_p        Pointer to store the number of missed sync events.
+
+\return The function returns a tEplKernel error code.
+\retval kEplInvalidOperation   Missed sync events are not detected by the
+                                used stack configuration.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_getMissedSyncCount(UINT32* pCount_p)
+{
+    if (pCount_p == NULL)
+        return kEplApiInvalidParam;
+
+    return pdoucal_getMissedSyncCount(pCount_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Set coalescing window of error history entries
+
+The function sets the window in which repeated error history entries with the
+same error code and node ID are coalesced into a single history entry event.
+The first occurrence is reported immediately, further occurrences within the
+window are reported by one event when the window expires. The number of
+occurrences is stored as UNSIGNED32 at offset EPL_ERR_ADDINFO_OCCURRENCE_CNT
+of the additional information of the history entry.
+
+\param  cycles_p        Coalescing window in POWERLINK cycles. If 0, every
+                        history entry is reported.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_setErrHistoryCoalesceWindow(UINT32 cycles_p)
+{
+    return errhndu_setHistoryCoalesceWindow(cycles_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Get statistics of error history entries
+
+The function returns the number of posted error history entry events and the
+number of occurrences which were coalesced into other events.
+
+\param  pPostedCnt_p        Pointer to store the number of posted events.
+\param  pSuppressedCnt_p    Pointer to store the number of coalesced
+                            occurrences.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_getErrHistoryStats(UINT32* pPostedCnt_p, UINT32* pSuppressedCnt_p)
+{
+    if ((pPostedCnt_p == NULL) || (pSuppressedCnt_p == NULL))
+        return kEplApiInvalidParam;
+
+    return errhndu_getHistoryCoalesceStats(pPostedCnt_p, pSuppressedCnt_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get IdentResponse of node
@@ -876,6 +1041,64 @@ tEplKernel oplk_getIdentResponse(UINT nodeId_p, tEplIdentResponse** ppIdentRespo
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get boot timeline
+
+The function returns the timeline of the last boot process of the MN. It
+contains the start times of the MN boot phases and the times at which each CN
+reached its boot milestones.
+
+\param  pTimeline_p         Pointer to store the boot timeline.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_getBootTimeline(tNmtBootTimeline* pTimeline_p)
+{
+#if defined(CONFIG_INCLUDE_NMT_MN) && (EPL_NMTMNU_BOOT_TIMELINE != FALSE)
+    return nmtmnu_getBootTimeline(pTimeline_p);
+#else
+    UNUSED_PARAMETER(pTimeline_p);
+    return kEplApiInvalidParam;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write boot timeline to CSV file
+
+The function writes the timeline of the last boot process of the MN to a CSV
+file. Each line contains an event name, the node ID and the time in
+milliseconds since the MN entered PreOperational1. Boot phases of the MN are
+written with the configured node ID of the MN. Events which were not reached are omitted.
+
+\param  pszFileName_p       Name of the CSV file.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_writeBootTimelineCsv(char* pszFileName_p)
+{
+#if defined(CONFIG_INCLUDE_NMT_MN) && (EPL_NMTMNU_BOOT_TIMELINE != FALSE)
+    tEplKernel          ret;
+    tNmtBootTimeline    timeline;
+
+    ret = nmtmnu_getBootTimeline(&timeline);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    return nmtmnu_writeBootTimelineCsv(&timeline, obd_getNodeId(), pszFileName_p);
+#else
+    UNUSED_PARAMETER(pszFileName_p);
+    return kEplApiInvalidParam;
+#endif
+}
+
 
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
@@ -904,6 +1127,13 @@ static tEplKernel cbSdoCon(tSdoComFinished* pSdoComFinished_p)
 
     eventArg.m_Sdo = *pSdoComFinished_p;
     ret = ctrlu_callUserEventCallback(kEplApiEventSdo, &eventArg);
+
+    // batches may wait for the connection of the finished transfer
+    if (ret == kEplSuccessful)
+        ret = sdobatchu_resume();
+    else
+        sdobatchu_resume();
+
     return ret;
 }
 #endif
@@ -293,6 +293,108 @@ tEplKernel oplk_exchangeProcessImageOut(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange input process image of selected nodes
+
+The function exchanges the parts of the input process image which are mapped
+to the TPDOs of the selected nodes. The bitmap addresses the TPDOs by the node
+ID of their channel (0 for the PRes). The copy cost depends on the number of
+selected TPDOs only. Threads which serve disjoint sets of nodes can exchange
+their parts at different rates.
+
+\param  pNodes_p            Pointer to a node bitmap of EPL_API_NODE_BITMAP_SIZE
+                            bytes. Use EPL_API_NODE_BITMAP_SET() to select
+                            the nodes.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_exchangeProcessImageInNodes(BYTE* pNodes_p)
+{
+    tEplKernel      ret;
+
+    if (pNodes_p == NULL)
+        return kEplApiInvalidParam;
+
+    if (instance_l.inputImage.m_pImage != NULL)
+        ret = pdou_copyTxPdoFromPiNodes(pNodes_p);
+    else
+        ret = kEplApiPINotAllocated;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange output process image of selected nodes
+
+The function exchanges the parts of the output process image which are mapped
+to the RPDOs of the selected nodes. The bitmap addresses the RPDOs by the node
+ID of their channel (0 for the PReq on a CN). The copy cost depends on the
+number of selected RPDOs only. Threads which serve disjoint sets of nodes can
+exchange their parts at different rates.
+
+\param  pNodes_p            Pointer to a node bitmap of EPL_API_NODE_BITMAP_SIZE
+                            bytes. Use EPL_API_NODE_BITMAP_SET() to select
+                            the nodes.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_exchangeProcessImageOutNodes(BYTE* pNodes_p)
+{
+    tEplKernel      ret;
+
+    if (pNodes_p == NULL)
+        return kEplApiInvalidParam;
+
+    if (instance_l.outputImage.m_pImage != NULL)
+        ret = pdou_copyRxPdoToPiNodes(pNodes_p);
+    else
+        ret = kEplApiPINotAllocated;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange changed parts of output process image
+
+The function exchanges the output process image like
+oplk_exchangeProcessImageOut() but copies only the RPDOs whose contents changed
+since the last call of this function. The supplied node bitmap receives one bit
+per changed RPDO, addressed by the node ID of its channel (0 for the PReq on a
+CN). Use EPL_API_NODE_BITMAP_TEST() to check the bits. Parts of the output
+image which belong to unchanged RPDOs keep their contents.
+
+\param  pChangedNodes_p     Pointer to a node bitmap of EPL_API_NODE_BITMAP_SIZE
+                            bytes.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_exchangeProcessImageOutChanged(BYTE* pChangedNodes_p)
+{
+    tEplKernel      ret;
+
+    if (pChangedNodes_p == NULL)
+        return kEplApiInvalidParam;
+
+    if (instance_l.outputImage.m_pImage != NULL)
+        ret = pdou_copyChangedRxPdoToPi(pChangedNodes_p);
+    else
+        ret = kEplApiPINotAllocated;
+
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get pointer to input process image
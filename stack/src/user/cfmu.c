@@ -50,6 +50,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <obd.h>
 #include <user/EplSdoComu.h>
 #include <user/nmtu.h>
+#include <crc32.h>
 
 #if !defined(CONFIG_INCLUDE_OBD)
 #error "CFM module needs openPOWERLINK module OBD!"
@@ -113,6 +114,20 @@ typedef enum
     kCfmStateInternalAbort,
 } tCfmState;
 
+/**
+\brief Digest of a ConciseDCF entry
+
+The structure identifies the value of a ConciseDCF entry which was downloaded
+to a CN. The CRC detects every change of entries up to 4 bytes.
+*/
+typedef struct
+{
+    UINT16                  index;          ///< Object index
+    UINT8                   subindex;       ///< Object subindex
+    UINT32                  size;           ///< Size of the object data
+    UINT32                  crc;            ///< CRC-32 of the object data
+} tCfmEntryDigest;
+
 /**
 \brief CFM node information structure
 
@@ -130,6 +145,15 @@ typedef struct
     tCfmState               cfmState;
     UINT                    curDataSize;
     BOOL                    fDoStore;
+    tCfmEntryDigest*        paEntryDigest;      ///< Digests of the ConciseDCF entries
+    UINT32                  digestCapacity;     ///< Number of allocated digests
+    UINT32                  digestCount;        ///< Number of digests of the last stored download
+    UINT32                  digestConfDate;     ///< Configuration date of the digests
+    UINT32                  digestConfTime;     ///< Configuration time of the digests
+    UINT32                  digestCompareCount; ///< Number of digests to compare in this download
+    UINT32                  entryNumber;        ///< Number of the current ConciseDCF entry
+    UINT32                  expConfDate;        ///< Configuration date of this download
+    UINT32                  expConfTime;        ///< Configuration time of this download
 } tCfmNodeInfo;
 
 /**
@@ -161,6 +185,8 @@ static tCfmNodeInfo* allocNodeInfo(UINT nodeId_p);
 static tEplKernel callCbProgress(tCfmNodeInfo* pNodeInfo_p);
 static tEplKernel downloadCycleLength(tCfmNodeInfo* pNodeInfo_p);
 static tEplKernel downloadObject(tCfmNodeInfo* pNodeInfo_p);
+static tEplKernel startDigest(tCfmNodeInfo* pNodeInfo_p, tEplIdentResponse* pIdentResponse_p);
+static BOOL checkEntryUnchanged(tCfmNodeInfo* pNodeInfo_p);
 static tEplKernel sdoWriteObject(tCfmNodeInfo* pNodeInfo_p, void* pLeSrcData_p, UINT size_p);
 static tEplKernel cbSdoCon(tSdoComFinished* pSdoComFinished_p);
 
@@ -258,6 +284,10 @@ tEplKernel cfmu_exit(void)
                 EPL_FREE(pBuffer);
                 pNodeInfo->pObdBufferConciseDcf = NULL;
             }
+            if (pNodeInfo->paEntryDigest != NULL)
+            {
+                EPL_FREE(pNodeInfo->paEntryDigest);
+            }
             EPL_FREE(pNodeInfo);
             CFM_GET_NODEINFO(nodeId) = NULL;
         }
@@ -273,6 +303,10 @@ tEplKernel cfmu_exit(void)
 The function processes a node event. It starts configuration of the specified
 CN if configuration data and time differs with local values.
 
+If the CN still holds the configuration of the last stored download, i.e. it
+reports the configuration date and time of that download in its IdentResponse,
+only the ConciseDCF entries whose value changed are downloaded.
+
 \param  nodeId_p        Node ID of node to configure.
 \param  nodeEvent_p     Node event to process.
 
@@ -320,6 +354,7 @@ tEplKernel cfmu_processNodeEvent(UINT nodeId_p, tNmtNodeEvent nodeEvent_p)
     }
 
     pNodeInfo->curDataSize = 0;
+    pNodeInfo->eventCnProgress.entriesSkipped = 0;
 
     // fetch pointer to ConciseDCF from object 0x1F22
     // (this allows the application to link its own memory to this object)
@@ -369,6 +404,8 @@ tEplKernel cfmu_processNodeEvent(UINT nodeId_p, tNmtNodeEvent nodeEvent_p)
         {
             EPL_DBGLVL_CFM_TRACE("CN%x Error Reading 0x1F27 returns 0x%X\n", uiNodeId_p, ret);
         }
+        pNodeInfo->expConfDate = expConfDate;
+        pNodeInfo->expConfTime = expConfTime;
         if ((expConfDate != 0) || (expConfTime != 0))
         {   // store configuration in CN at the end of the download,
             // because expected configuration date or time is set
@@ -415,6 +452,10 @@ tEplKernel cfmu_processNodeEvent(UINT nodeId_p, tNmtNodeEvent nodeEvent_p)
     }
     else if (nodeEvent_p == kNmtNodeEventUpdateConf)
     {
+        ret = startDigest(pNodeInfo, pIdentResponse);
+        if (ret != kEplSuccessful)
+            return ret;
+
         pNodeInfo->cfmState = kCfmStateDownload;
         ret = downloadObject(pNodeInfo);
         if (ret == kEplSuccessful)
@@ -424,6 +465,24 @@ tEplKernel cfmu_processNodeEvent(UINT nodeId_p, tNmtNodeEvent nodeEvent_p)
     }
     else
     {
+        ret = startDigest(pNodeInfo, pIdentResponse);
+        if (ret != kEplSuccessful)
+            return ret;
+
+        if (pNodeInfo->digestCompareCount != 0)
+        {   // CN holds the stored configuration of the last download,
+            // only download the changed entries without restoring the defaults
+            EPL_DBGLVL_CFM_TRACE("CN%x - Cfg Mismatch, CN holds last stored Cfg. Downloading changes...\n",
+                                 nodeId_p);
+            pNodeInfo->cfmState = kCfmStateDownload;
+            ret = downloadObject(pNodeInfo);
+            if (ret == kEplSuccessful)
+            {   // SDO transfer started
+                ret = kEplReject;
+            }
+            return ret;
+        }
+
         pNodeInfo->cfmState = kCfmStateWaitRestore;
 
         pNodeInfo->eventCnProgress.totalNumberOfBytes += sizeof(leSignature);
@@ -703,6 +762,13 @@ static tEplKernel cbSdoCon(tSdoComFinished* pSdoComFinished_p)
             break;
 
         case kCfmStateWaitStore:
+            if (pSdoComFinished_p->sdoComConState == kEplSdoComTransferFinished)
+            {   // the CN keeps the downloaded configuration after a reset
+                pNodeInfo->digestCount = pNodeInfo->entryNumber;
+                pNodeInfo->digestConfDate = pNodeInfo->expConfDate;
+                pNodeInfo->digestConfTime = pNodeInfo->expConfTime;
+            }
+
             if ((ret = downloadCycleLength(pNodeInfo)) == kEplReject)
             {
                 pNodeInfo->cfmState = kCfmStateUpToDate;
@@ -780,8 +846,9 @@ static tEplKernel downloadObject(tCfmNodeInfo* pNodeInfo_p)
     // forward data pointer for last transfer
     pNodeInfo_p->pDataConciseDcf += pNodeInfo_p->curDataSize;
     pNodeInfo_p->bytesRemaining -= pNodeInfo_p->curDataSize;
+    pNodeInfo_p->curDataSize = 0;
 
-    if (pNodeInfo_p->entriesRemaining > 0)
+    while (pNodeInfo_p->entriesRemaining > 0)
     {
         if (pNodeInfo_p->bytesRemaining < EPL_CDC_OFFSET_DATA)
         {
@@ -811,41 +878,148 @@ static tEplKernel downloadObject(tCfmNodeInfo* pNodeInfo_p)
         }
 
         pNodeInfo_p->entriesRemaining--;
-        ret = sdoWriteObject(pNodeInfo_p, pNodeInfo_p->pDataConciseDcf, pNodeInfo_p->curDataSize);
+        if (checkEntryUnchanged(pNodeInfo_p))
+        {   // CN already holds this value, continue with next entry
+            pNodeInfo_p->eventCnProgress.entriesSkipped++;
+            pNodeInfo_p->eventCnProgress.totalNumberOfBytes -= pNodeInfo_p->curDataSize;
+            pNodeInfo_p->pDataConciseDcf += pNodeInfo_p->curDataSize;
+            pNodeInfo_p->bytesRemaining -= pNodeInfo_p->curDataSize;
+            pNodeInfo_p->curDataSize = 0;
+            continue;
+        }
+
+        return sdoWriteObject(pNodeInfo_p, pNodeInfo_p->pDataConciseDcf, pNodeInfo_p->curDataSize);
+    }
+
+    // download finished
+    if (pNodeInfo_p->fDoStore != FALSE)
+    {
+        // store configuration into non-volatile memory
+        pNodeInfo_p->cfmState = kCfmStateWaitStore;
+        AmiSetDwordToLe(&leSignature, 0x65766173);
+        pNodeInfo_p->eventCnProgress.objectIndex = 0x1010;
+        pNodeInfo_p->eventCnProgress.objectSubIndex = 0x01;
+        ret = sdoWriteObject(pNodeInfo_p, &leSignature, sizeof (leSignature));
         if (ret != kEplSuccessful)
             return ret;
     }
     else
-    {   // download finished
-        if (pNodeInfo_p->fDoStore != FALSE)
+    {
+        ret = downloadCycleLength(pNodeInfo_p);
+        if (ret == kEplReject)
         {
-            // store configuration into non-volatile memory
-            pNodeInfo_p->cfmState = kCfmStateWaitStore;
-            AmiSetDwordToLe(&leSignature, 0x65766173);
-            pNodeInfo_p->eventCnProgress.objectIndex = 0x1010;
-            pNodeInfo_p->eventCnProgress.objectSubIndex = 0x01;
-            ret = sdoWriteObject(pNodeInfo_p, &leSignature, sizeof (leSignature));
-            if (ret != kEplSuccessful)
-                return ret;
+            pNodeInfo_p->cfmState = kCfmStateUpToDate;
+            return kEplSuccessful;
         }
         else
         {
-            ret = downloadCycleLength(pNodeInfo_p);
-            if (ret == kEplReject)
-            {
-                pNodeInfo_p->cfmState = kCfmStateUpToDate;
-                return kEplSuccessful;
-            }
-            else
-            {
-                return finishConfig(pNodeInfo_p, kNmtNodeCommandConfReset);
-            }
+            return finishConfig(pNodeInfo_p, kNmtNodeCommandConfReset);
         }
     }
 
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Prepare the entry digests for a download
+
+The function determines if unchanged entries can be skipped in the following
+download and makes sure that a digest can be recorded for every ConciseDCF
+entry. If entries can be skipped, the restore of the default configuration is
+omitted, because the CN holds the configuration the digests were recorded for.
+The digests of the last download are only used for comparison in this
+download. They become valid again when the download and the store are
+completed, because an aborted download leaves the CN in an unknown state.
+
+\param  pNodeInfo_p         Node info of the node which will be configured.
+\param  pIdentResponse_p    IdentResponse of the node.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel startDigest(tCfmNodeInfo* pNodeInfo_p, tEplIdentResponse* pIdentResponse_p)
+{
+    tCfmEntryDigest*    paEntryDigest;
+
+    // skipping is only safe if the CN holds the stored configuration of the
+    // last download, the configuration date and time identify it
+    if (((pNodeInfo_p->digestConfDate != 0) || (pNodeInfo_p->digestConfTime != 0)) &&
+        (AmiGetDwordFromLe(&pIdentResponse_p->m_le_dwVerifyConfigurationDate) == pNodeInfo_p->digestConfDate) &&
+        (AmiGetDwordFromLe(&pIdentResponse_p->m_le_dwVerifyConfigurationTime) == pNodeInfo_p->digestConfTime))
+    {
+        pNodeInfo_p->digestCompareCount = pNodeInfo_p->digestCount;
+    }
+    else
+    {
+        pNodeInfo_p->digestCompareCount = 0;
+    }
+
+    pNodeInfo_p->digestCount = 0;
+    pNodeInfo_p->entryNumber = 0;
+
+    if (pNodeInfo_p->entriesRemaining > pNodeInfo_p->digestCapacity)
+    {
+        paEntryDigest = EPL_MALLOC(pNodeInfo_p->entriesRemaining * sizeof(tCfmEntryDigest));
+        if (paEntryDigest == NULL)
+            return kEplNoResource;
+
+        if (pNodeInfo_p->paEntryDigest != NULL)
+        {
+            EPL_MEMCPY(paEntryDigest, pNodeInfo_p->paEntryDigest,
+                       pNodeInfo_p->digestCompareCount * sizeof(tCfmEntryDigest));
+            EPL_FREE(pNodeInfo_p->paEntryDigest);
+        }
+        pNodeInfo_p->paEntryDigest = paEntryDigest;
+        pNodeInfo_p->digestCapacity = pNodeInfo_p->entriesRemaining;
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if the current entry is unchanged
+
+The function compares the current ConciseDCF entry with the digest of the same
+entry of the last download and records the digest of the current entry. The
+digests are compared by position, so inserted or removed entries only cause
+the following entries to be downloaded.
+
+\param  pNodeInfo_p     Node info of the node which is configured.
+
+\return The function returns TRUE if the entry needn't be downloaded.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkEntryUnchanged(tCfmNodeInfo* pNodeInfo_p)
+{
+    tCfmEntryDigest*    pDigest;
+    UINT32              crc;
+    BOOL                fUnchanged = FALSE;
+
+    if (pNodeInfo_p->entryNumber >= pNodeInfo_p->digestCapacity)
+        return FALSE;   // more entries than announced, they are always downloaded
+
+    pDigest = &pNodeInfo_p->paEntryDigest[pNodeInfo_p->entryNumber];
+    crc = crc32_calc(pNodeInfo_p->pDataConciseDcf, pNodeInfo_p->curDataSize);
+
+    if ((pNodeInfo_p->entryNumber < pNodeInfo_p->digestCompareCount) &&
+        (pDigest->index == pNodeInfo_p->eventCnProgress.objectIndex) &&
+        (pDigest->subindex == pNodeInfo_p->eventCnProgress.objectSubIndex) &&
+        (pDigest->size == pNodeInfo_p->curDataSize) &&
+        (pDigest->crc == crc))
+    {
+        fUnchanged = TRUE;
+    }
+
+    pDigest->index = (UINT16)pNodeInfo_p->eventCnProgress.objectIndex;
+    pDigest->subindex = (UINT8)pNodeInfo_p->eventCnProgress.objectSubIndex;
+    pDigest->size = pNodeInfo_p->curDataSize;
+    pDigest->crc = crc;
+    pNodeInfo_p->entryNumber++;
+
+    return fUnchanged;
+}
 
 //------------------------------------------------------------------------------
 /**
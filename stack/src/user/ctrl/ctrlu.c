@@ -54,6 +54,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/nmtcnu.h>
 #include <user/nmtmnu.h>
 #include <user/EplSdoComu.h>
+#include <user/sdobatchu.h>
 #include <user/identu.h>
 #include <user/statusu.h>
 #include <user/EplTimeru.h>
@@ -78,6 +79,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <obdcdc.h>
 #endif
 
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+#include <obdstore.h>
+#endif
+
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
 #include <user/syncu.h>
 #endif
@@ -109,6 +114,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+#define CTRLU_STORE_SIGNATURE       0x65766173      // "save"
+#define CTRLU_RESTORE_SIGNATURE     0x64616F6C      // "load"
+#endif
 
 //------------------------------------------------------------------------------
 // local types
@@ -132,6 +141,9 @@ static tEplKernel initObd(tEplApiInitParam* pInitParam_p);
 static tEplKernel updateDllConfig(tEplApiInitParam* pInitParam_p, BOOL fUpdateIdentity_p);
 static tEplKernel updateSdoConfig();
 static tEplKernel updateObd(tEplApiInitParam* pInitParam_p);
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+static tEplKernel storeRestoreParam(tObdCbParam MEM* pParam_p);
+#endif
 
 static tEplKernel processUserEvent(tEplEvent* pEplEvent_p);
 static tEplKernel cbCnCheckEvent(tNmtEvent NmtEvent_p);
@@ -155,6 +167,11 @@ static tEplKernel cbCfmEventCnProgress(tCfmEventCnProgress* pEventCnProgress_p);
 static tEplKernel cbCfmEventCnResult(unsigned int uiNodeId_p, tNmtNodeCommand NodeCommand_p);
 #endif
 
+#if defined(CONFIG_INCLUDE_SDOC)
+static tEplKernel cbSdoBatchItemFinished(tSdoBatchItem* pItem_p);
+static tEplKernel cbSdoBatchFinished(tSdoBatch* pBatch_p);
+#endif
+
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
 //============================================================================//
@@ -267,6 +284,11 @@ tEplKernel ctrlu_initStack(tEplApiInitParam * pInitParam_p)
         goto Exit;
     }
 
+#if (TARGET_SYSTEM == _LINUX_)
+    // thread configuration must be set before the stack threads are created
+    target_setThreadConfig(&ctrlInstance_l.initParam.m_ThreadConfig);
+#endif
+
     if ((ret = initObd(&ctrlInstance_l.initParam)) != kEplSuccessful)
         goto Exit;
 
@@ -344,6 +366,15 @@ tEplKernel ctrlu_initStack(tEplApiInitParam * pInitParam_p)
     }
 #endif
 
+#if defined(CONFIG_INCLUDE_SDOC)
+    TRACE ("Initialize SdoBatch module...\n");
+    ret = sdobatchu_init(cbSdoBatchItemFinished, cbSdoBatchFinished);
+    if (ret != kEplSuccessful)
+    {
+        goto Exit;
+    }
+#endif
+
 #if defined (CONFIG_INCLUDE_CFM)
     TRACE ("Initialize Cfm module...\n");
     ret = cfmu_init(cbCfmEventCnProgress, cbCfmEventCnResult);
@@ -385,6 +416,11 @@ tEplKernel ctrlu_shutdownStack(void)
     TRACE("cfmu_exit():    0x%X\n", ret);
 #endif
 
+#if defined(CONFIG_INCLUDE_SDOC)
+    ret = sdobatchu_exit();
+    TRACE("sdobatchu_exit():  0x%X\n", ret);
+#endif
+
 #if defined(CONFIG_INCLUDE_SDOS) || defined(CONFIG_INCLUDE_SDOC)
     ret = EplSdoComDelInstance();
     TRACE("EplSdoComDelInstance():  0x%X\n", ret);
@@ -444,6 +480,10 @@ tEplKernel ctrlu_shutdownStack(void)
     obdcdc_exit();
 #endif
 
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+    obdstore_exit();
+#endif
+
     ret = obd_deleteInstance();
 
     return ret;
@@ -598,6 +638,13 @@ tEplKernel ctrlu_cbObdAccess(tObdCbParam MEM* pParam_p)
             }
             break;
 
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+        case 0x1010:    // NMT_StoreParam_REC
+        case 0x1011:    // NMT_RestoreDefParam_REC
+            ret = storeRestoreParam(pParam_p);
+            break;
+#endif
+
         case 0x1F9E:    // NMT_ResetCmd_U8
             if (pParam_p->obdEvent == kObdEvPreWrite)
             {
@@ -659,6 +706,15 @@ tEplKernel ctrlu_cbObdAccess(tObdCbParam MEM* pParam_p)
             break;
 
 #if (((EPL_MODULE_INTEGRATION) & (EPL_MODULE_NMT_MN)) != 0)
+        case 0x1F81:    // NMT_NodeAssignment_AU32
+            if ((pParam_p->obdEvent == kObdEvPostWrite) &&
+                (pParam_p->subIndex != 0))
+            {
+                ret = nmtmnu_updateNodeAssignment(pParam_p->subIndex,
+                                                  *((UINT32*)pParam_p->pArg));
+            }
+            break;
+
         case 0x1F9F:    // NMT_RequestCmd_REC
             if ((pParam_p->obdEvent == kObdEvPostWrite) &&
                 (pParam_p->subIndex == 1) &&
@@ -828,6 +884,16 @@ static tEplKernel initObd(tEplApiInitParam* pInitParam_p)
 
 #if (CONFIG_OBD_USE_LOAD_CONCISEDCF != FALSE)
     ret = obdcdc_init();
+    if (ret != kEplSuccessful)
+        return ret;
+#endif
+
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+    ret = obdstore_init();
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = obd_storeLoadObjCallback(obdstore_cbStoreLoadObject);
 #endif
 
 #endif
@@ -1470,6 +1536,84 @@ static tEplKernel updateObd(tEplApiInitParam* pInitParam_p)
     return kEplSuccessful;
 }
 
+#if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Store or restore parameters
+
+The function handles writes to the objects NMT_StoreParam_REC (0x1010) and
+NMT_RestoreDefParam_REC (0x1011). If the signature "save" is written to
+0x1010 the parameters of the selected OD parts are stored in non-volatile
+memory. If the signature "load" is written to 0x1011 the stored parameters
+are deleted, so the default values are used after the next reset.
+
+\param  pParam_p        OBD callback parameter.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel storeRestoreParam(tObdCbParam MEM* pParam_p)
+{
+    tEplKernel          ret = kEplSuccessful;
+    UINT32              signature;
+    tObdDir             direction;
+    tObdPart            odPart;
+
+    if (pParam_p->index == 0x1010)
+    {
+        signature = CTRLU_STORE_SIGNATURE;
+        direction = kObdDirStore;
+    }
+    else
+    {
+        signature = CTRLU_RESTORE_SIGNATURE;
+        direction = kObdDirRestore;
+    }
+
+    switch (pParam_p->subIndex)
+    {
+        case 1:     // all parameters
+            odPart = kObdPartAll;
+            break;
+
+        case 2:     // communication parameters
+            odPart = kObdPartGen;
+            break;
+
+        case 3:     // application parameters
+            odPart = kObdPartDev;
+            break;
+
+        case 4:     // manufacturer specific parameters
+            odPart = kObdPartMan;
+            break;
+
+        default:
+            return kEplSuccessful;
+    }
+
+    if (pParam_p->obdEvent == kObdEvPreWrite)
+    {
+        if (AmiGetDwordFromLe(pParam_p->pArg) != signature)
+        {
+            pParam_p->abortCode = EPL_SDOAC_DATA_NOT_TRANSF_OR_STORED;
+            ret = kEplObdAccessViolation;
+        }
+    }
+    else if (pParam_p->obdEvent == kObdEvPostWrite)
+    {
+        ret = obd_accessOdPart(odPart, direction);
+        if (ret != kEplSuccessful)
+            pParam_p->abortCode = EPL_SDOAC_ACCESS_FAILED_DUE_HW_ERROR;
+
+        // reading the object shall return the store/restore capability again
+        *((UINT32*)pParam_p->pArg) = 1;
+    }
+
+    return ret;
+}
+#endif
+
 #if defined(CONFIG_INCLUDE_NMT_MN)
 //------------------------------------------------------------------------------
 /**
@@ -1629,6 +1773,47 @@ static tEplKernel cbCfmEventCnResult(UINT nodeId_p, tNmtNodeCommand nodeCommand_
 }
 #endif
 
+#if defined(CONFIG_INCLUDE_SDOC)
+//------------------------------------------------------------------------------
+/**
+\brief  Callback function for finished SDO batch items
+
+The function implements the callback function for finished items of an SDO
+batch.
+
+\param  pItem_p                 Pointer to the finished item.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbSdoBatchItemFinished(tSdoBatchItem* pItem_p)
+{
+    tEplApiEventArg         eventArg;
+
+    eventArg.m_pSdoBatchItem = pItem_p;
+    return ctrlu_callUserEventCallback(kEplApiEventSdoBatchItem, &eventArg);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Callback function for finished SDO batches
+
+The function implements the callback function for finished SDO batches.
+
+\param  pBatch_p                Pointer to the finished batch.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbSdoBatchFinished(tSdoBatch* pBatch_p)
+{
+    tEplApiEventArg         eventArg;
+
+    eventArg.m_pSdoBatch = pBatch_p;
+    return ctrlu_callUserEventCallback(kEplApiEventSdoBatch, &eventArg);
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 \brief  Callback function for CN to check events
@@ -43,8 +43,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <dllcal.h>
 #include <user/ctrlucal.h>
 #include <powerlink-module.h>
+#include <shmring.h>
 
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <pthread.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -87,9 +90,25 @@ typedef struct
     int                         fd;                 ///< File descriptor of openPOWERLINK driver
 } tDllCalIoctlInstance;
 
+/**
+\brief Asynchronous TX frame ring
+
+The asynchronous TX frame ring of the kernel module is mapped once and shared
+by all DLL CAL queue instances. The frames of all queues are written into the
+ring, each entry carries the queue it belongs to.
+*/
+typedef struct
+{
+    void*                       pMem;               ///< Mapped memory of the ring
+    tShmRingInstance            ring;               ///< Ring instance (producer side)
+    pthread_mutex_t             mutex;              ///< Serializes the producers of the ring
+    UINT                        refCount;           ///< Number of queue instances using the ring
+} tDllCalIoctlAsyncRing;
+
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static tDllCalIoctlAsyncRing    asyncRing_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -169,6 +188,32 @@ static tEplKernel addInstance(tDllCalQueueInstance *ppDllCalQueue_p,
     pInstance->dllCalQueue = dllCalQueue_p;
     pInstance->fd = ctrlucal_getFd();
 
+    if (asyncRing_l.refCount == 0)
+    {
+        asyncRing_l.pMem = mmap(NULL, PLK_ASYNC_RING_SIZE, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, pInstance->fd, PLK_MMAP_OFFSET_ASYNC_RING);
+        if (asyncRing_l.pMem == MAP_FAILED)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() mapping of async ring failed!\n", __func__);
+            EPL_FREE(pInstance);
+            ret = kEplNoResource;
+            goto Exit;
+        }
+
+        if (shmring_connect(&asyncRing_l.ring, asyncRing_l.pMem,
+                            PLK_ASYNC_RING_SIZE) != kShmRingOk)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() invalid async ring!\n", __func__);
+            munmap(asyncRing_l.pMem, PLK_ASYNC_RING_SIZE);
+            EPL_FREE(pInstance);
+            ret = kEplNoResource;
+            goto Exit;
+        }
+
+        pthread_mutex_init(&asyncRing_l.mutex, NULL);
+    }
+    asyncRing_l.refCount++;
+
     *ppDllCalQueue_p = (tDllCalQueueInstance*)pInstance;
 
 Exit:
@@ -193,6 +238,14 @@ static tEplKernel delInstance(tDllCalQueueInstance pDllCalQueue_p)
     tDllCalIoctlInstance*     pInstance = (tDllCalIoctlInstance*)pDllCalQueue_p;
 
     EPL_FREE(pInstance);
+
+    if ((asyncRing_l.refCount > 0) && (--asyncRing_l.refCount == 0))
+    {
+        pthread_mutex_destroy(&asyncRing_l.mutex);
+        munmap(asyncRing_l.pMem, PLK_ASYNC_RING_SIZE);
+        asyncRing_l.pMem = NULL;
+    }
+
     return kEplSuccessful;
 }
 
@@ -200,7 +253,10 @@ static tEplKernel delInstance(tDllCalQueueInstance pDllCalQueue_p)
 /**
 \brief  Insert data block into queue
 
-Inserts a data block into the DLL CAL queue.
+Inserts a data block into the DLL CAL queue. The data block is written into
+the asynchronous TX frame ring. The kernel module is only signaled by an ioctl
+if it has not already been signaled for previously written frames which it
+hasn't processed yet.
 
 \param  pDllCalQueue_p          Pointer to DllCal Queue instance
 \param  pData_p                 Pointer to the data block to be insert
@@ -218,7 +274,8 @@ static tEplKernel insertDataBlock (tDllCalQueueInstance pDllCalQueue_p,
     tEplKernel                      ret = kEplSuccessful;
     tDllCalIoctlInstance*           pInstance =
                                             (tDllCalIoctlInstance*)pDllCalQueue_p;
-    tIoctlDllCalAsync               ioctlAsyncFrame;
+    tAsyncRingEntryHdr              entryHdr;
+    tShmRingError                   ringError;
     int                             ioctlRet;
 
     if(pInstance == NULL)
@@ -227,13 +284,25 @@ static tEplKernel insertDataBlock (tDllCalQueueInstance pDllCalQueue_p,
         goto Exit;
     }
 
-    ioctlAsyncFrame.size = *pDataSize_p;
-    ioctlAsyncFrame.queue = pInstance->dllCalQueue;
-    ioctlAsyncFrame.pData = pData_p;
+    entryHdr.queue = pInstance->dllCalQueue;
+    entryHdr.reserved = 0;
     //TRACE ("%s() send async frame: size:%d\n", __func__, pFrameInfo_p->frameSize);
-    ioctlRet = ioctl(pInstance->fd, PLK_CMD_DLLCAL_ASYNCSEND, (ULONG)&ioctlAsyncFrame);
-    if (ioctlRet < 0)
+    pthread_mutex_lock(&asyncRing_l.mutex);
+    ringError = shmring_writeMultipleData(&asyncRing_l.ring, &entryHdr, sizeof(tAsyncRingEntryHdr),
+                                          pData_p, *pDataSize_p);
+    pthread_mutex_unlock(&asyncRing_l.mutex);
+    if (ringError != kShmRingOk)
         return kEplDllAsyncTxBufferFull;
+
+    if (shmring_setSignalPending(&asyncRing_l.ring))
+    {
+        ioctlRet = ioctl(pInstance->fd, PLK_CMD_DLLCAL_ASYNCRING_SIGNAL, 0);
+        if (ioctlRet < 0)
+        {   // allow the next frame to signal the kernel module again
+            shmring_clearSignalPending(&asyncRing_l.ring);
+            return kEplNoResource;
+        }
+    }
     return kEplSuccessful;
 
 Exit:
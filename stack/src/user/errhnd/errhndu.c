@@ -104,6 +104,7 @@ static tEplKernel linkErrorCounter(tErrorObject* pErrorCounter_p, UINT index_p);
 #ifdef CONFIG_INCLUDE_NMT_MN
 static tEplKernel checkErrorObject(UINT index_p, BYTE *pEntries_p);
 static tEplKernel linkMnCnLossPresErrors(tErrHndObjects* pError_p);
+static void       applyMnCnLossPresDecay(UINT nodeIdx_p, UINT32* pThresholdCnt_p);
 #endif
 
 //============================================================================//
@@ -171,6 +172,8 @@ tEplKernel errhndu_init(void)
     }
 #endif
 
+    ret = errhndu_setHistoryCoalesceWindow(CONFIG_ERRHND_HISTORY_COALESCE_WINDOW);
+
 Exit:
     if (ret != kEplSuccessful)
     {
@@ -298,10 +301,17 @@ tEplKernel errhndu_mnCnLossPresCbObdAccess(tObdCbParam MEM* pParam_p)
                 // the error handler only modifies the cumulative counter
                 // and threshold counter
                 case OID_DLL_MNCN_LOSSPRES_CUMCNT_AU32:
+                    errhnducal_readErrorObject(pParam_p->index,
+                                               pParam_p->subIndex,
+                                               (UINT32 *)pParam_p->pArg);
+                    break;
+
                 case OID_DLL_MNCN_LOSSPRES_THRCNT_AU32:
                     errhnducal_readErrorObject(pParam_p->index,
                                                pParam_p->subIndex,
                                                (UINT32 *)pParam_p->pArg);
+                    applyMnCnLossPresDecay(pParam_p->subIndex - 1,
+                                           (UINT32 *)pParam_p->pArg);
                     break;
             }
             break;
@@ -314,6 +324,62 @@ tEplKernel errhndu_mnCnLossPresCbObdAccess(tObdCbParam MEM* pParam_p)
 }
 #endif
 
+//------------------------------------------------------------------------------
+/**
+\brief    Set coalescing window of error history entries
+
+The function sets the window in which repeated error history entries with the
+same error code and node ID are coalesced by the kernel error handler.
+
+\param  window_p            Coalescing window in cycles. If 0, every error
+                            history entry is posted.
+
+\return Returns a tEplKernel error code.
+
+\ingroup module_errhndu
+*/
+//------------------------------------------------------------------------------
+tEplKernel errhndu_setHistoryCoalesceWindow(UINT32 window_p)
+{
+    instance_l.errorObjects.historyCoalesce.window = window_p;
+    return errhnducal_writeErrorObject(0, 0,
+                                       &instance_l.errorObjects.historyCoalesce.window);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get coalescing statistics of error history entries
+
+The function reads the number of error history entries posted by the kernel
+error handler and the number of occurrences which were coalesced.
+
+\param  pPostedCnt_p        Pointer to store the number of posted entries.
+\param  pSuppressedCnt_p    Pointer to store the number of coalesced
+                            occurrences.
+
+\return Returns a tEplKernel error code.
+
+\ingroup module_errhndu
+*/
+//------------------------------------------------------------------------------
+tEplKernel errhndu_getHistoryCoalesceStats(UINT32* pPostedCnt_p, UINT32* pSuppressedCnt_p)
+{
+    tErrHistoryCoalesce*    pCoalesce = &instance_l.errorObjects.historyCoalesce;
+    tEplKernel              ret;
+
+    ret = errhnducal_readErrorObject(0, 0, &pCoalesce->postedCnt);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = errhnducal_readErrorObject(0, 0, &pCoalesce->suppressedCnt);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    *pPostedCnt_p = pCoalesce->postedCnt;
+    *pSuppressedCnt_p = pCoalesce->suppressedCnt;
+    return kEplSuccessful;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -473,5 +539,39 @@ static tEplKernel linkMnCnLossPresErrors(tErrHndObjects* pError_p)
     return ret;
 }
 
+
+//------------------------------------------------------------------------------
+/**
+\brief    Apply pending decay to loss of PRes threshold counter
+
+The kernel error handler decrements the loss of PRes threshold counters on
+demand. The function calculates the current value of a threshold counter which
+was read from the kernel error objects.
+
+\param  nodeIdx_p           Index of node (node ID - 1)
+\param  pThresholdCnt_p     Pointer to threshold counter which will be updated
+*/
+//------------------------------------------------------------------------------
+static void applyMnCnLossPresDecay(UINT nodeIdx_p, UINT32* pThresholdCnt_p)
+{
+    tErrHndObjects*     pErrorObjects = &instance_l.errorObjects;
+    tErrorDecay*        pDecay;
+    UINT32              decay;
+
+    if (nodeIdx_p >= NUM_DLL_MNCN_LOSSPRES_OBJS)
+        return;
+
+    pDecay = &pErrorObjects->aMnCnLossPresDecay[nodeIdx_p];
+    errhnducal_readErrorObject(0, 0, &pDecay->fDecay);
+    if (pDecay->fDecay == FALSE)
+        return;
+
+    errhnducal_readErrorObject(0, 0, &pDecay->refCycleCnt);
+    errhnducal_readErrorObject(0, 0, &pErrorObjects->mnCycleCnt);
+
+    decay = ERRHND_GET_DECAY(pErrorObjects->mnCycleCnt, pDecay->refCycleCnt);
+    *pThresholdCnt_p = (*pThresholdCnt_p > decay) ? (*pThresholdCnt_p - decay) : 0;
+}
+
 #endif
 
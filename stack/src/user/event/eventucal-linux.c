@@ -129,7 +129,6 @@ CAL module.
 //------------------------------------------------------------------------------
 tEplKernel eventucal_init (void)
 {
-    struct sched_param  schedParam;
 
     EPL_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
@@ -156,11 +155,11 @@ tEplKernel eventucal_init (void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.__sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_setThreadSchedParam(instance_l.threadId, kEplThreadEventUser,
+                                   SCHED_FIFO, USER_EVENT_THREAD_PRIORITY) != 0)
     {
-        EPL_DBGLVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-               __func__, schedParam.__sched_priority);
+        EPL_DBGLVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters!\n",
+               __func__);
     }
     instance_l.fInitialized = TRUE;
     return kEplSuccessful;
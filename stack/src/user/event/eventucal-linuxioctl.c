@@ -52,7 +52,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pthread.h>
 
 #include <powerlink-module.h>
+#include <shmring.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 
 #include <unistd.h> //sleep
 #include <user/ctrlucal.h>
@@ -98,6 +100,8 @@ typedef struct
     int                 fd;
     pthread_t           threadId;
     BOOL                fStopThread;
+    void*               pEventRingMem;      ///< Mapped memory of the kernel event ring
+    tShmRingInstance    eventRing;          ///< Kernel to user event ring (consumer side)
 } tEventuCalInstance;
 
 //------------------------------------------------------------------------------
@@ -123,6 +127,9 @@ The function initializes the user event CAL module. Depending on the
 configuration it gets the function pointer interface of the used queue
 implementations and calls the appropriate init functions.
 
+The events of the kernel layer are read directly from the event ring of the
+kernel module which is mapped into the application.
+
 \return The function returns a tEplKernel error code.
 \retval kEplSuccessful          If function executes correctly
 \retval other error codes       If an error occurred
@@ -133,26 +140,47 @@ implementations and calls the appropriate init functions.
 tEplKernel eventucal_init(void)
 {
     tEplKernel          ret = kEplSuccessful;
-    struct sched_param  schedParam;
 
     EPL_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
     instance_l.fd = ctrlucal_getFd();
     instance_l.fStopThread = FALSE;
 
+    instance_l.pEventRingMem = mmap(NULL, PLK_EVENT_RING_SIZE, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED, instance_l.fd, PLK_MMAP_OFFSET_EVENT_RING);
+    if (instance_l.pEventRingMem == MAP_FAILED)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() mapping of event ring failed!\n", __func__);
+        instance_l.pEventRingMem = NULL;
+        return kEplNoResource;
+    }
+
+    if (shmring_connect(&instance_l.eventRing, instance_l.pEventRingMem,
+                        PLK_EVENT_RING_SIZE) != kShmRingOk)
+    {
+        EPL_DBGLVL_ERROR_TRACE("%s() invalid event ring!\n", __func__);
+        ret = kEplNoResource;
+        goto Exit;
+    }
+
     //create thread for signaling new data
     if (pthread_create(&instance_l.threadId, NULL, eventThread, NULL) != 0)
     {
+        ret = kEplNoResource;
         goto Exit;
     }
-    schedParam.__sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_setThreadSchedParam(instance_l.threadId, kEplThreadEventUser,
+                                   SCHED_FIFO, USER_EVENT_THREAD_PRIORITY) != 0)
     {
-        EPL_DBGLVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-               __func__, schedParam.__sched_priority);
+        EPL_DBGLVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters!\n",
+               __func__);
     }
 
+    return ret;
+
 Exit:
+    munmap(instance_l.pEventRingMem, PLK_EVENT_RING_SIZE);
+    instance_l.pEventRingMem = NULL;
     return ret;
 }
 
@@ -185,6 +213,12 @@ tEplKernel eventucal_exit (void)
         }
     }
 
+    if (instance_l.pEventRingMem != NULL)
+    {
+        munmap(instance_l.pEventRingMem, PLK_EVENT_RING_SIZE);
+        instance_l.pEventRingMem = NULL;
+    }
+
     return kEplSuccessful;
 }
 
@@ -285,7 +319,8 @@ static tEplKernel postEvent(tEplEvent *pEvent_p)
 /**
 \brief    Event thread function
 
-This function implements the event thread.
+This function implements the event thread. It processes all events of the
+event ring and calls the wait ioctl only if the ring is empty.
 
 \param  arg_p                Thread argument.
 
@@ -293,9 +328,10 @@ This function implements the event thread.
 //------------------------------------------------------------------------------
 static void *eventThread (void * arg_p)
 {
-    tEplEvent*  pEvent;
-    int         ret;
-    char        eventBuf[sizeof(tEplEvent) + EPL_MAX_EVENT_ARG_SIZE];
+    tEplEvent*      pEvent;
+    tShmRingError   ringError;
+    size_t          readSize;
+    char            eventBuf[sizeof(tEplEvent) + EPL_MAX_EVENT_ARG_SIZE];
 
     UNUSED_PARAMETER(arg_p);
 
@@ -303,19 +339,26 @@ static void *eventThread (void * arg_p)
 
     while (!instance_l.fStopThread)
     {
-        ret = ioctl(instance_l.fd, PLK_CMD_GET_EVENT, eventBuf);
-        if (ret == 0)
+        ringError = shmring_readData(&instance_l.eventRing, eventBuf, sizeof(eventBuf), &readSize);
+        if (ringError == kShmRingNoReadableData)
         {
-            /*TRACE ("%s() User: got event type:%d(%s) sink:%d(%s)\n", __func__,
-                    pEvent->m_EventType, EplGetEventTypeStr(pEvent->m_EventType),
-                    pEvent->m_EventSink, EplGetEventSinkStr(pEvent->m_EventSink));*/
-            if (pEvent->m_uiSize != 0)
-                pEvent->m_pArg = (char *)pEvent + sizeof(tEplEvent);
+            ioctl(instance_l.fd, PLK_CMD_WAIT_EVENT, 0);
+            continue;
+        }
 
-            ret = eventu_process(pEvent);
+        if (ringError != kShmRingOk)
+        {
+            EPL_DBGLVL_ERROR_TRACE("%s() Error reading event ring %d!\n", __func__, ringError);
+            break;
         }
-        /*else
-            TRACE("%s() ret = %d\n", __func__, ret);*/
+
+        /*TRACE ("%s() User: got event type:%d(%s) sink:%d(%s)\n", __func__,
+                pEvent->m_EventType, EplGetEventTypeStr(pEvent->m_EventType),
+                pEvent->m_EventSink, EplGetEventSinkStr(pEvent->m_EventSink));*/
+        if (pEvent->m_uiSize != 0)
+            pEvent->m_pArg = (char *)pEvent + sizeof(tEplEvent);
+
+        eventu_process(pEvent);
     }
     instance_l.fStopThread = FALSE;
 
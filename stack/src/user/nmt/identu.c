@@ -74,8 +74,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 typedef struct
 {
-    tEplIdentResponse*  apIdentResponse[254];    // the IdentResponse are managed dynamically
+    tEplIdentResponse*  apIdentResponse[254];    // points to the pool entry of the node if an IdentResponse is stored
     tIdentuCbResponse   apfnCbResponse[254];
+    tEplIdentResponse*  pIdentResponsePool;      // one IdentResponse per node, allocated when the instance is added
 } tIdentuInstance;
 
 //------------------------------------------------------------------------------
@@ -112,7 +113,10 @@ tEplKernel identu_init(void)
 /**
 \brief  Add ident module instance
 
-The function adds an ident module instance
+The function adds an ident module instance. It allocates the pool which stores
+the IdentResponses of the nodes up to node ID EPL_NMT_MAX_NODE_ID. The pool is
+kept until the instance is deleted, therefore no memory is allocated or freed
+while the stack is running.
 
 \return The function returns a tEplKernel error code.
 
@@ -125,6 +129,12 @@ tEplKernel identu_addInstance(void)
 
     EPL_MEMSET(&instance_g, 0, sizeof(instance_g));
 
+#if EPL_NMT_MAX_NODE_ID > 0
+    instance_g.pIdentResponsePool = EPL_MALLOC(sizeof(tEplIdentResponse) * EPL_NMT_MAX_NODE_ID);
+    if (instance_g.pIdentResponsePool == NULL)
+        return kEplNoResource;
+#endif
+
     // register IdentResponse callback function
     ret = dllucal_regAsndService(kDllAsndIdentResponse, identu_cbIdentResponse,
                                  kDllAsndFilterAny);
@@ -150,6 +160,12 @@ tEplKernel identu_delInstance(void)
     dllucal_regAsndService(kDllAsndIdentResponse, NULL, kDllAsndFilterNone);
 
     ret = identu_reset();
+
+    if (instance_g.pIdentResponsePool != NULL)
+    {
+        EPL_FREE(instance_g.pIdentResponsePool);
+        instance_g.pIdentResponsePool = NULL;
+    }
     return ret;
 
 }
@@ -158,7 +174,8 @@ tEplKernel identu_delInstance(void)
 /**
 \brief  Reset ident module instance
 
-The function resets an ident module instance
+The function resets an ident module instance. The stored IdentResponses are
+discarded, the pool is kept.
 
 \return The function returns a tEplKernel error code.
 
@@ -167,27 +184,20 @@ The function resets an ident module instance
 //------------------------------------------------------------------------------
 tEplKernel identu_reset()
 {
-    tEplKernel  ret;
-    UINT        index;
+    EPL_MEMSET(instance_g.apIdentResponse, 0, sizeof(instance_g.apIdentResponse));
+    EPL_MEMSET(instance_g.apfnCbResponse, 0, sizeof(instance_g.apfnCbResponse));
 
-    ret = kEplSuccessful;
-    for (index = 0; index < tabentries(instance_g.apIdentResponse); index++)
-    {
-        if (instance_g.apIdentResponse[index] != NULL)
-        {
-            EPL_FREE(instance_g.apIdentResponse[index]);
-        }
-    }
-    EPL_MEMSET(&instance_g, 0, sizeof (tIdentuInstance));
-
-    return ret;
+    return kEplSuccessful;
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Get ident response
 
-The function gets the IdentResponse for a specified node.
+The function gets the IdentResponse for a specified node. No data is copied,
+the returned pointer refers to the IdentResponse stored in the pool. It is
+valid until the next IdentResponse of the node is received or the module is
+reset.
 
 \param  nodeId_p            The Node ID to get the IdentResponse for.
 \param  ppIdentResponse_p   Pointer to store IdentResponse. NULL, if no IdentResponse
@@ -355,16 +365,13 @@ static tEplKernel identu_cbIdentResponse(tFrameInfo* pFrameInfo_p)
         }
         else
         {   // IdentResponse received
-            if (instance_g.apIdentResponse[index] == NULL)
-            {   // memory for IdentResponse must be allocated
-                instance_g.apIdentResponse[index] = EPL_MALLOC(sizeof(tEplIdentResponse));
-                if (instance_g.apIdentResponse[index] == NULL)
-                {   // malloc failed
-                    ret = pfnCbResponse(nodeId,
-                                        &pFrameInfo_p->pFrame->m_Data.m_Asnd.m_Payload.m_IdentResponse);
-                    goto Exit;
-                }
+            if ((nodeId > EPL_NMT_MAX_NODE_ID) || (instance_g.pIdentResponsePool == NULL))
+            {   // node has no pool entry, IdentResponse can't be stored
+                ret = pfnCbResponse(nodeId,
+                                    &pFrameInfo_p->pFrame->m_Data.m_Asnd.m_Payload.m_IdentResponse);
+                goto Exit;
             }
+            instance_g.apIdentResponse[index] = &instance_g.pIdentResponsePool[index];
 
             // copy IdentResponse to instance structure
             EPL_MEMCPY(instance_g.apIdentResponse[index],
@@ -0,0 +1,160 @@
+/**
+********************************************************************************
+\file   nmtmnu-timeline.c
+
+\brief  Boot timeline export of NMT MNU module
+
+This file contains the function which writes the boot timeline recorded by the
+NMT MNU module to a CSV file.
+
+\ingroup module_nmtmnu
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+
+#include "user/nmtmnu.h"
+
+#if defined(CONFIG_INCLUDE_NMT_MN) && (EPL_NMTMNU_BOOT_TIMELINE != FALSE)
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+// names of boot phases and CN milestones used in the boot timeline CSV file
+static const char*  apszBootPhaseName_l[kNmtBootPhaseCount] =
+{
+    "PreOp1", "BootStep1", "BootStep2", "CheckCom", "StartNodes"
+};
+
+static const char*  apszBootNodeEventName_l[kNmtBootNodeEventCount] =
+{
+    "IdentResponse", "Configured", "StatusResponse", "Operational"
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write boot timeline to CSV file
+
+The function writes a boot timeline to a CSV file. Each line contains an event
+name, the node ID and the time in milliseconds since the MN entered
+PreOperational1. Boot phases of the MN are written with the node ID of the MN.
+Events which were not reached are omitted.
+
+\param  pTimeline_p         Pointer to the boot timeline.
+\param  mnNodeId_p          Node ID of the MN.
+\param  pszFileName_p       Name of the CSV file.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tEplKernel nmtmnu_writeBootTimelineCsv(const tNmtBootTimeline* pTimeline_p, UINT mnNodeId_p,
+                                       const char* pszFileName_p)
+{
+    FILE*       pFile;
+    UINT        index;
+    UINT        nodeEvent;
+
+    if ((pTimeline_p == NULL) || (pszFileName_p == NULL))
+        return kEplNmtInvalidParam;
+
+    pFile = fopen(pszFileName_p, "w");
+    if (pFile == NULL)
+        return kEplNoResource;
+
+    fprintf(pFile, "event,node,time_ms\n");
+    for (index = 0; index < kNmtBootPhaseCount; index++)
+    {
+        if (pTimeline_p->aPhaseTime[index] != NMT_BOOT_TIME_INVALID)
+        {
+            fprintf(pFile, "%s,%u,%lu\n", apszBootPhaseName_l[index], mnNodeId_p,
+                    (ULONG)pTimeline_p->aPhaseTime[index]);
+        }
+    }
+
+    for (index = 0; index < NMT_BOOT_TIMELINE_NODE_COUNT; index++)
+    {
+        for (nodeEvent = 0; nodeEvent < kNmtBootNodeEventCount; nodeEvent++)
+        {
+            if (pTimeline_p->aaNodeTime[index][nodeEvent] != NMT_BOOT_TIME_INVALID)
+            {
+                fprintf(pFile, "%s,%u,%lu\n", apszBootNodeEventName_l[nodeEvent], index + 1,
+                        (ULONG)pTimeline_p->aaNodeTime[index][nodeEvent]);
+            }
+        }
+    }
+
+    if (fclose(pFile) != 0)
+        return kEplNoResource;
+
+    return kEplSuccessful;
+}
+
+#endif // #if defined(CONFIG_INCLUDE_NMT_MN) && (EPL_NMTMNU_BOOT_TIMELINE != FALSE)
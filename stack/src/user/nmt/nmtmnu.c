@@ -182,10 +182,26 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NMTMNU_FLAG_PRC_ADD_IN_PROGRESS         0x0010  // add-PRC-node process is in progress
 #endif
 
+// record boot timeline
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+#define NMTMNU_BOOT_TIMELINE_PHASE(phase_p)                 bootTimelineSetPhase(phase_p)
+#define NMTMNU_BOOT_TIMELINE_NODE(nodeId_p, nodeEvent_p)    bootTimelineSetNodeEvent(nodeId_p, nodeEvent_p)
+#else
+#define NMTMNU_BOOT_TIMELINE_PHASE(phase_p)
+#define NMTMNU_BOOT_TIMELINE_NODE(nodeId_p, nodeEvent_p)
+#endif
+
 // return pointer to node info structure for specified node ID
 // d.k. may be replaced by special (hash) function if node ID array is smaller than 254
 #define NMTMNU_GET_NODEINFO(nodeId_p) (&nmtMnuInstance_g.aNodeInfo[nodeId_p - 1])
 
+// number of words of the node assignment bitmap
+#define NMTMNU_NODE_BITMAP_WORDS    ((EPL_C_ADR_BROADCAST + 1) / 32)
+
+// bits of object 0x1F81 which put a node into the node list
+#define NMTMNU_NODEASSIGN_LISTED    (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS | \
+                                     EPL_NODEASSIGN_MN_PRES)
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -267,6 +283,9 @@ typedef struct
 typedef struct
 {
     tNmtMnuNodeInfo     aNodeInfo[EPL_NMT_MAX_NODE_ID];  ///< Information about CNs
+    UINT32              aNodeAssignment[NMTMNU_NODE_BITMAP_WORDS]; ///< Bit n is set if node n is assigned in object 0x1F81
+    UINT8               aNodeList[EPL_NMT_MAX_NODE_ID];  ///< Ascending node IDs of the nodes of the current boot process
+    UINT                nodeListCount;          ///< Number of valid entries in aNodeList
     tEplTimerHdl        timerHdlNmtState;       ///< Timeout for stay in NMT state
     UINT                mandatorySlaveCount;    ///< Count of found mandatory CNs
     UINT                signalSlaveCount;       ///< Count of CNs which are not identified
@@ -282,6 +301,10 @@ typedef struct
     UINT32              prcPResTimeFirstCorrectionNs;   ///< to be commented!
     UINT32              prcPResTimeFirstNegOffsetNs;    ///< to be commented!
 #endif
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+    DWORD               bootStartTickMs;        ///< Tick count at entry of PreOperational1
+    tNmtBootTimeline    bootTimeline;           ///< Timestamps of the last boot process
+#endif
 } tNmtMnuInstance;
 
 //------------------------------------------------------------------------------
@@ -312,6 +335,9 @@ static tEplKernel doPreop1(tEventNmtStateChange nmtStateChange_p);
 static tEplKernel processInternalEvent(UINT nodeId_p, tNmtState nodeNmtState_p,
                                        UINT16 errorCode_p, tNmtMnuIntNodeEvent nodeEvent_p);
 static tEplKernel reset(void);
+static tEplKernel readNodeAssignment(void);
+static void       setNodeAssignment(UINT nodeId_p, UINT32 nodeCfg_p);
+static UINT       findNodeListIndex(UINT nodeId_p);
 
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
 static tEplKernel prcMeasure(void);
@@ -337,6 +363,12 @@ static void       prcSetFlagsNmtCommandReset(tNmtMnuNodeInfo* pNodeInfo_p,
                                              tNmtCommand nmtCommand_p);
 #endif
 
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+static void bootTimelineStart(void);
+static void bootTimelineSetPhase(tNmtBootPhase bootPhase_p);
+static void bootTimelineSetNodeEvent(UINT nodeId_p, tNmtBootNodeEvent nodeEvent_p);
+#endif
+
 /* internal node event handler functions */
 static INT processNodeEventNoIdentResponse (UINT nodeId_p, tNmtState nodeNmtState_p,
                                             tNmtState nmtState_p, UINT16 errorCode_p, tEplKernel* pRet_p);
@@ -459,6 +491,10 @@ tEplKernel nmtmnu_addInstance(tNmtMnuCbNodeEvent pfnCbNodeEvent_p,
     nmtMnuInstance_g.prcPResTimeFirstNegOffsetNs  = 500;
 #endif
 
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+    EPL_MEMSET(&nmtMnuInstance_g.bootTimeline, 0xFF, sizeof(nmtMnuInstance_g.bootTimeline));
+#endif
+
 Exit:
     return ret;
 }
@@ -507,6 +543,7 @@ tEplKernel nmtmnu_sendNmtCommandEx(UINT nodeId_p, tNmtCommand nmtCommand_p,
     UINT8               aBuffer[EPL_C_DLL_MINSIZE_NMTCMDEXT];
     tEplFrame*          pFrame;
     tDllNodeOpParam     nodeOpParam;
+    UINT                index;
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
     tNmtMnuNodeInfo*    pNodeInfo;
 #endif
@@ -531,9 +568,10 @@ tEplKernel nmtmnu_sendNmtCommandEx(UINT nodeId_p, tNmtCommand nmtCommand_p,
     //          transitions, but the expected NMT state will be changed and never fullfilled.
 
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
-    pNodeInfo = NMTMNU_GET_NODEINFO(nodeId_p);
+    // there is no node info structure for the broadcast address
+    pNodeInfo = (nodeId_p != EPL_C_ADR_BROADCAST) ? NMTMNU_GET_NODEINFO(nodeId_p) : NULL;
 
-    if (pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING)
+    if ((pNodeInfo != NULL) && (pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING))
     {   // Node is a PRes Chaining node
         switch (nmtCommand_p)
         {
@@ -635,7 +673,7 @@ tEplKernel nmtmnu_sendNmtCommandEx(UINT nodeId_p, tNmtCommand nmtCommand_p,
     EPL_DBGLVL_NMTMN_TRACE("NMTCmd(%02X->%02X)\n", NmtCommand_p, nodeId_p);
 
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
-    if (pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING)
+    if ((pNodeInfo != NULL) && (pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING))
     {   // Node is a PRes Chaining node
         // The following action (delete node) is only necessary for non-PRC nodes
         goto Exit;
@@ -684,8 +722,9 @@ tEplKernel nmtmnu_sendNmtCommandEx(UINT nodeId_p, tNmtCommand nmtCommand_p,
     }
     else
     {   // do it for all active CNs
-        for (nodeId_p = 1; nodeId_p <= tabentries(nmtMnuInstance_g.aNodeInfo); nodeId_p++)
+        for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
         {
+            nodeId_p = nmtMnuInstance_g.aNodeList[index];
             if ((NMTMNU_GET_NODEINFO(nodeId_p)->nodeCfg & (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS)) != 0)
             {
                 nodeOpParam.nodeId = nodeId_p;
@@ -963,6 +1002,9 @@ tEplKernel nmtmnu_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p)
                 {
                     nmtMnuInstance_g.timeoutReadyToOp = 0L;
                 }
+
+                // object 0x1F81 may have been reloaded without OD callbacks
+                ret = readNodeAssignment();
             }
             break;
 
@@ -1228,8 +1270,11 @@ tEplKernel nmtmnu_processEvent(tEplEvent* pEvent_p)
                 }
                 else
                 {   // process internal event for all active nodes (except myself)
-                    for (uiNodeId = 1; uiNodeId <= tabentries(nmtMnuInstance_g.aNodeInfo); uiNodeId++)
+                    UINT    index;
+
+                    for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
                     {
+                        uiNodeId = nmtMnuInstance_g.aNodeList[index];
                         if ((NMTMNU_GET_NODEINFO(uiNodeId)->nodeCfg & (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS)) != 0)
                         {
                             ret = processInternalEvent(uiNodeId, (tNmtState) (bNmtState | NMT_TYPE_CS),
@@ -1373,6 +1418,31 @@ tEplKernel nmtmnu_getDiagnosticInfo(UINT* pMandatorySlaveCount_p,
     return kEplSuccessful;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Update node assignment
+
+The function updates the node assignment of a node after the according
+sub-index of object 0x1F81 NMT_NodeAssignment_AU32 was written. The change
+takes effect with the next BootStep1 of the MN.
+
+\param  nodeId_p                Node ID whose assignment was written.
+\param  nodeCfg_p               New value of object 0x1F81 of the node.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tEplKernel nmtmnu_updateNodeAssignment(UINT nodeId_p, UINT32 nodeCfg_p)
+{
+    if ((nodeId_p == EPL_C_ADR_INVALID) || (nodeId_p > tabentries(nmtMnuInstance_g.aNodeInfo)))
+        return kEplInvalidNodeId;
+
+    setNodeAssignment(nodeId_p, nodeCfg_p);
+    return kEplSuccessful;
+}
+
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
 //------------------------------------------------------------------------------
 /**
@@ -1395,6 +1465,32 @@ tEplKernel nmtmnu_configPrc(tEplNmtMnuConfigParam* pConfigParam_p)
 }
 #endif
 
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+//------------------------------------------------------------------------------
+/**
+\brief  Get boot timeline
+
+The function copies the timeline of the last boot process of the MN. It
+contains the start times of the boot phases and the times at which each CN
+reached its boot milestones.
+
+\param  pTimeline_p             Pointer to store the boot timeline.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tEplKernel nmtmnu_getBootTimeline(tNmtBootTimeline* pTimeline_p)
+{
+    if (pTimeline_p == NULL)
+        return kEplNmtInvalidParam;
+
+    EPL_MEMCPY(pTimeline_p, &nmtMnuInstance_g.bootTimeline, sizeof(tNmtBootTimeline));
+    return kEplSuccessful;
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -1613,15 +1709,16 @@ static tEplKernel addNodeIsochronous(UINT nodeId_p)
 
     if (nmtMnuInstance_g.flags & NMTMNU_FLAG_PRC_ADD_SCHEDULED)
     {
-        UINT            nodeId;
+        UINT            index;
         BOOL            fInvalidateNext;
 
         fInvalidateNext = FALSE;
-        for (nodeId = 1; nodeId < 254; nodeId++)
+        for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
         {
-            pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
-            if (pNodeInfo == NULL)
-                continue;
+            if (nmtMnuInstance_g.aNodeList[index] >= 254)
+                break;
+
+            pNodeInfo = NMTMNU_GET_NODEINFO(nmtMnuInstance_g.aNodeList[index]);
 
             // $$$ only PRC
 
@@ -1673,58 +1770,86 @@ The function starts the BootStep1.
 //------------------------------------------------------------------------------
 static tEplKernel startBootStep1(BOOL fNmtResetAllIssued_p)
 {
-    tEplKernel            ret = kEplSuccessful;
-    UINT                subIndex;
+    tEplKernel          ret = kEplSuccessful;
+    UINT                index;
+    UINT                wordIndex;
+    UINT32              nodeBits;
+    UINT                nodeId;
     UINT                localNodeId;
-    UINT32                nodeCfg;
+    UINT32              nodeCfg;
     tObdSize            obdSize;
     tNmtMnuNodeInfo*    pNodeInfo;
 
+    NMTMNU_BOOT_TIMELINE_PHASE(kNmtBootPhaseBootStep1);
+
     // $$$ d.k.: save current time for 0x1F89/2 MNTimeoutPreOp1_U32
 
     // start network scan
     nmtMnuInstance_g.mandatorySlaveCount = 0;
     nmtMnuInstance_g.signalSlaveCount = 0;
-    // check 0x1F81
+
+    // clear node info of the previous boot process,
+    // nodes which are not assigned anymore shall not be processed
+    for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
+    {
+        pNodeInfo = NMTMNU_GET_NODEINFO(nmtMnuInstance_g.aNodeList[index]);
+        pNodeInfo->flags &= ~(NMTMNU_NODE_FLAG_ISOCHRON | NMTMNU_NODE_FLAG_NOT_SCANNED);
+        pNodeInfo->nodeCfg = 0;
+        pNodeInfo->nodeState = kNmtMnuNodeStateUnknown;
+    }
+    nmtMnuInstance_g.nodeListCount = 0;
+
+    // check 0x1F81, only assigned nodes and the diagnostic node are read
     localNodeId = obd_getNodeId();
-    for (subIndex = 1; subIndex <= 254; subIndex++)
+    for (wordIndex = 0; wordIndex < NMTMNU_NODE_BITMAP_WORDS; wordIndex++)
     {
-        obdSize = 4;
-        ret = obd_readEntry(0x1F81, subIndex, &nodeCfg, &obdSize);
-        if (ret != kEplSuccessful)
-            goto Exit;
+        nodeBits = nmtMnuInstance_g.aNodeAssignment[wordIndex];
+        if (wordIndex == (EPL_C_ADR_DIAG_DEF_NODE_ID >> 5))
+            nodeBits |= (UINT32)1 << (EPL_C_ADR_DIAG_DEF_NODE_ID & 0x1F);
 
-        if (subIndex != localNodeId)
+        for (nodeId = wordIndex << 5; nodeBits != 0; nodeId++, nodeBits >>= 1)
         {
-            pNodeInfo = NMTMNU_GET_NODEINFO(subIndex);
+            if ((nodeBits & 1) == 0)
+                continue;
+
+            obdSize = 4;
+            ret = obd_readEntry(0x1F81, nodeId, &nodeCfg, &obdSize);
+            if (ret != kEplSuccessful)
+                goto Exit;
+
+            pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
+            if (nodeId != localNodeId)
+            {
+                if (nodeId == EPL_C_ADR_DIAG_DEF_NODE_ID)
+                {   // diagnostic node must be scanned by MN in any case
+                    nodeCfg |= (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS);
+                    // and it must be isochronously accessed
+                    nodeCfg &= ~EPL_NODEASSIGN_ASYNCONLY_NODE;
+                }
+
+                if ((nodeCfg & (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS)) == 0)
+                    continue;
 
-            // reset flags "not scanned" and "isochronous"
-            pNodeInfo->flags &= ~(NMTMNU_NODE_FLAG_ISOCHRON | NMTMNU_NODE_FLAG_NOT_SCANNED);
+                // reset flags "not scanned" and "isochronous"
+                pNodeInfo->flags &= ~(NMTMNU_NODE_FLAG_ISOCHRON | NMTMNU_NODE_FLAG_NOT_SCANNED);
 
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
-            // Reset all PRC flags and PRC related values
-            pNodeInfo->prcFlags = 0;
-            pNodeInfo->pResTimeFirstNs = 0;
-            pNodeInfo->relPropagationDelayNs = 0;
+                // Reset all PRC flags and PRC related values
+                pNodeInfo->prcFlags = 0;
+                pNodeInfo->pResTimeFirstNs = 0;
+                pNodeInfo->relPropagationDelayNs = 0;
 #endif
 
-            if (subIndex == EPL_C_ADR_DIAG_DEF_NODE_ID)
-            {   // diagnostic node must be scanned by MN in any case
-                nodeCfg |= (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS);
-                // and it must be isochronously accessed
-                nodeCfg &= ~EPL_NODEASSIGN_ASYNCONLY_NODE;
-            }
-
-            // save node config in local node info structure
-            pNodeInfo->nodeCfg = nodeCfg;
-            pNodeInfo->nodeState = kNmtMnuNodeStateUnknown;
+                // save node config in local node info structure
+                pNodeInfo->nodeCfg = nodeCfg;
+                pNodeInfo->nodeState = kNmtMnuNodeStateUnknown;
+                nmtMnuInstance_g.aNodeList[nmtMnuInstance_g.nodeListCount++] = (UINT8)nodeId;
 
-            if ((nodeCfg & (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS)) != 0)
-            {   // node is configured as CN
+                // node is configured as CN
                 if (fNmtResetAllIssued_p == FALSE)
                 {
                     // identify the node
-                    ret = identu_requestIdentResponse(subIndex, cbIdentResponse);
+                    ret = identu_requestIdentResponse(nodeId, cbIdentResponse);
                     if (ret != kEplSuccessful)
                         goto Exit;
                 }
@@ -1740,12 +1865,15 @@ static tEplKernel startBootStep1(BOOL fNmtResetAllIssued_p)
                     // mandatory slave counter shall be decremented if mandatory CN was configured successfully
                 }
             }
-        }
-        else
-        {   // subindex of MN
-            if ((nodeCfg & (EPL_NODEASSIGN_MN_PRES | EPL_NODEASSIGN_NODE_EXISTS)) != 0)
-            {   // MN shall send PRes
-                ret = addNodeIsochronous(localNodeId);
+            else
+            {   // subindex of MN
+                if ((nodeCfg & (EPL_NODEASSIGN_MN_PRES | EPL_NODEASSIGN_NODE_EXISTS)) != 0)
+                {   // MN shall send PRes
+                    nmtMnuInstance_g.aNodeList[nmtMnuInstance_g.nodeListCount++] = (UINT8)nodeId;
+                    ret = addNodeIsochronous(localNodeId);
+                    if (ret != kEplSuccessful)
+                        goto Exit;
+                }
             }
         }
     }
@@ -1774,6 +1902,10 @@ static tEplKernel doPreop1(tEventNmtStateChange nmtStateChange_p)
     BOOL            fNmtResetAllIssued = FALSE;
     tEplKernel      ret = kEplSuccessful;
 
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+    bootTimelineStart();
+#endif
+
     // reset IdentResponses and running IdentRequests and StatusRequests
     ret = identu_reset();
     ret = statusu_reset();
@@ -1857,11 +1989,14 @@ static tEplKernel startBootStep2(void)
 {
     tEplKernel          ret = kEplSuccessful;
     UINT                index;
+    UINT                nodeId;
     tNmtMnuNodeInfo*    pNodeInfo;
     tObdSize            obdSize;
     UINT8               nmtState;
     tNmtState           expNmtState;
 
+    NMTMNU_BOOT_TIMELINE_PHASE(kNmtBootPhaseBootStep2);
+
     if ((nmtMnuInstance_g.flags & NMTMNU_FLAG_HALTED) == 0)
     {   // boot process is not halted
         nmtMnuInstance_g.mandatorySlaveCount = 0;
@@ -1870,12 +2005,14 @@ static tEplKernel startBootStep2(void)
         nmtMnuInstance_g.flags &= ~NMTMNU_FLAG_APP_INFORMED;
     }
 
-    pNodeInfo = nmtMnuInstance_g.aNodeInfo;
-    for (index = 1; index <= tabentries(nmtMnuInstance_g.aNodeInfo); index++, pNodeInfo++)
+    for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
     {
+        nodeId = nmtMnuInstance_g.aNodeList[index];
+        pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
+
         obdSize = 1;
         // read object 0x1F8F NMT_MNNodeExpState_AU8
-        ret = obd_readEntry(0x1F8F, index, &nmtState, &obdSize);
+        ret = obd_readEntry(0x1F8F, nodeId, &nmtState, &obdSize);
         if (ret != kEplSuccessful)
             goto Exit;
 
@@ -1889,7 +2026,7 @@ static tEplKernel startBootStep2(void)
             // The change to PreOp2 is an implicit NMT command.
             // Unexpected NMT states of the nodes are ignored until
             // the state monitor timer is elapsed.
-            NMTMNU_SET_FLAGS_TIMERARG_STATE_MON(pNodeInfo, index, timerArg);
+            NMTMNU_SET_FLAGS_TIMERARG_STATE_MON(pNodeInfo, nodeId, timerArg);
 
             // set NMT state change flag
             pNodeInfo->flags |= NMTMNU_NODE_FLAG_NMT_CMD_ISSUED;
@@ -1901,7 +2038,7 @@ static tEplKernel startBootStep2(void)
 
             // update object 0x1F8F NMT_MNNodeExpState_AU8 to PreOp2
             nmtState = (UINT8)(kNmtCsPreOperational2 & 0xFF);
-            ret = obd_writeEntry(0x1F8F, index, &nmtState, 1);
+            ret = obd_writeEntry(0x1F8F, nodeId, &nmtState, 1);
             if (ret != kEplSuccessful)
                 goto Exit;
 
@@ -2005,8 +2142,11 @@ static tEplKernel startCheckCom(void)
 {
     tEplKernel      ret = kEplSuccessful;
     UINT            index;
+    UINT            nodeId;
     tNmtMnuNodeInfo* pNodeInfo;
 
+    NMTMNU_BOOT_TIMELINE_PHASE(kNmtBootPhaseCheckCom);
+
     if ((nmtMnuInstance_g.flags & NMTMNU_FLAG_HALTED) == 0)
     {   // boot process is not halted
         // wait some time and check that no communication error occurs
@@ -2015,12 +2155,13 @@ static tEplKernel startCheckCom(void)
         // reset flag that application was informed about possible state change
         nmtMnuInstance_g.flags &= ~NMTMNU_FLAG_APP_INFORMED;
 
-        pNodeInfo = nmtMnuInstance_g.aNodeInfo;
-        for (index = 1; index <= tabentries(nmtMnuInstance_g.aNodeInfo); index++, pNodeInfo++)
+        for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
         {
+            nodeId = nmtMnuInstance_g.aNodeList[index];
+            pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
             if (pNodeInfo->nodeState == kNmtMnuNodeStateReadyToOp)
             {
-                ret = nodeCheckCom(index, pNodeInfo);
+                ret = nodeCheckCom(nodeId, pNodeInfo);
                 if (ret == kEplReject)
                 {   // timer was started
                     // wait until it expires
@@ -2106,8 +2247,11 @@ static tEplKernel startNodes(void)
 {
     tEplKernel      ret = kEplSuccessful;
     UINT            index;
+    UINT            nodeId;
     tNmtMnuNodeInfo* pNodeInfo;
 
+    NMTMNU_BOOT_TIMELINE_PHASE(kNmtBootPhaseStartNodes);
+
     if ((nmtMnuInstance_g.flags & NMTMNU_FLAG_HALTED) == 0)
     {   // boot process is not halted
         // send NMT command Start Node
@@ -2116,15 +2260,16 @@ static tEplKernel startNodes(void)
         // reset flag that application was informed about possible state change
         nmtMnuInstance_g.flags &= ~NMTMNU_FLAG_APP_INFORMED;
 
-        pNodeInfo = nmtMnuInstance_g.aNodeInfo;
-        for (index = 1; index <= tabentries(nmtMnuInstance_g.aNodeInfo); index++, pNodeInfo++)
+        for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
         {
+            nodeId = nmtMnuInstance_g.aNodeList[index];
+            pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
             if (pNodeInfo->nodeState == kNmtMnuNodeStateComChecked)
             {
                 if ((nmtMnuInstance_g.nmtStartup & EPL_NMTST_STARTALLNODES) == 0)
                 {
-                    NMTMNU_DBG_POST_TRACE_VALUE(0, index, kNmtCmdStartNode);
-                    ret = nmtmnu_sendNmtCommand(index, kNmtCmdStartNode);
+                    NMTMNU_DBG_POST_TRACE_VALUE(0, nodeId, kNmtCmdStartNode);
+                    ret = nmtmnu_sendNmtCommand(nodeId, kNmtCmdStartNode);
                     if (ret != kEplSuccessful)
                         goto Exit;
                 }
@@ -2182,6 +2327,7 @@ static INT processNodeEventIdentResponse(UINT nodeId_p, tNmtState nodeNmtState_p
     pNodeInfo = NMTMNU_GET_NODEINFO(nodeId_p);
 
     NMTMNU_DBG_POST_TRACE_VALUE(kNmtMnuIntNodeEventIdentResponse, nodeId_p, pNodeInfo->nodeState);
+    NMTMNU_BOOT_TIMELINE_NODE(nodeId_p, kNmtBootNodeEventIdentResponse);
 
     if ((pNodeInfo->nodeState != kNmtMnuNodeStateResetConf) &&
         (pNodeInfo->nodeState != kNmtMnuNodeStateConfRestored))
@@ -2401,6 +2547,7 @@ static INT processNodeEventConfigured(UINT nodeId_p, tNmtState nodeNmtState_p, t
     }
 
     pNodeInfo->nodeState = kNmtMnuNodeStateConfigured;
+    NMTMNU_BOOT_TIMELINE_NODE(nodeId_p, kNmtBootNodeEventConfigured);
     if (nmtState_p == kNmtMsPreOperational1)
     {
         if ((pNodeInfo->nodeCfg & EPL_NODEASSIGN_MANDATORY_CN) != 0)
@@ -2510,6 +2657,7 @@ static INT processNodeEventStatusResponse(UINT nodeId_p, tNmtState nodeNmtState_
     tNmtMnuNodeInfo*    pNodeInfo;
 
     pNodeInfo = NMTMNU_GET_NODEINFO(nodeId_p);
+    NMTMNU_BOOT_TIMELINE_NODE(nodeId_p, kNmtBootNodeEventStatusResponse);
 
     if ((nmtState_p >= kNmtMsPreOperational2) &&
         ((pNodeInfo->flags & NMTMNU_NODE_FLAG_NOT_SCANNED) != 0))
@@ -3225,6 +3373,7 @@ static tEplKernel checkNmtState(UINT nodeId_p, tNmtMnuNodeInfo* pNodeInfo_p,
     else if ((pNodeInfo_p->nodeState == kNmtMnuNodeStateComChecked) && (nodeNmtState_p == kNmtCsOperational))
     {   // CN switched to OPERATIONAL
         pNodeInfo_p->nodeState = kNmtMnuNodeStateOperational;
+        NMTMNU_BOOT_TIMELINE_NODE(nodeId_p, kNmtBootNodeEventOperational);
 
         if ((pNodeInfo_p->nodeCfg & EPL_NODEASSIGN_MANDATORY_CN) != 0)
         {   // node is a mandatory CN -> decrement counter
@@ -3325,6 +3474,8 @@ static tEplKernel reset(void)
     UINT        index;
 
     ret = EplTimeruDeleteTimer(&nmtMnuInstance_g.timerHdlNmtState);
+    // all nodes are processed, because NMT commands to single nodes start
+    // timers also for nodes which are not in the node list
     for (index = 1; index <= tabentries (nmtMnuInstance_g.aNodeInfo); index++)
     {
         ret = EplTimeruDeleteTimer(&NMTMNU_GET_NODEINFO(index)->timerHdlStatReq);
@@ -3337,6 +3488,146 @@ static tEplKernel reset(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read node assignment
+
+The function reads all sub-indices of object 0x1F81 NMT_NodeAssignment_AU32
+and rebuilds the node assignment bitmap. It is called in ResetConfiguration
+because the object may have been loaded without calling the OD callback.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel readNodeAssignment(void)
+{
+    tEplKernel  ret = kEplSuccessful;
+    UINT        nodeId;
+    UINT32      nodeCfg;
+    tObdSize    obdSize;
+
+    EPL_MEMSET(nmtMnuInstance_g.aNodeAssignment, 0, sizeof(nmtMnuInstance_g.aNodeAssignment));
+    for (nodeId = 1; nodeId <= tabentries(nmtMnuInstance_g.aNodeInfo); nodeId++)
+    {
+        obdSize = 4;
+        ret = obd_readEntry(0x1F81, nodeId, &nodeCfg, &obdSize);
+        if (ret != kEplSuccessful)
+            break;
+
+        setNodeAssignment(nodeId, nodeCfg);
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set node in node assignment bitmap
+
+The function sets or clears the bit of a node in the node assignment bitmap.
+The bit is set if the node is configured as CN or if the node is the MN and
+shall send a PRes.
+
+\param  nodeId_p            Node ID to set.
+\param  nodeCfg_p           Value of object 0x1F81 of the node.
+*/
+//------------------------------------------------------------------------------
+static void setNodeAssignment(UINT nodeId_p, UINT32 nodeCfg_p)
+{
+    if ((nodeCfg_p & NMTMNU_NODEASSIGN_LISTED) != 0)
+        nmtMnuInstance_g.aNodeAssignment[nodeId_p >> 5] |= (UINT32)1 << (nodeId_p & 0x1F);
+    else
+        nmtMnuInstance_g.aNodeAssignment[nodeId_p >> 5] &= ~((UINT32)1 << (nodeId_p & 0x1F));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Find node in node list
+
+The function searches the node list for the first node whose node ID is
+greater or equal than the specified node ID.
+
+\param  nodeId_p            Node ID to search for.
+
+\return The function returns the index of the found node in the node list or
+        the count of the node list if no node was found.
+*/
+//------------------------------------------------------------------------------
+static UINT findNodeListIndex(UINT nodeId_p)
+{
+    UINT    low = 0;
+    UINT    high = nmtMnuInstance_g.nodeListCount;
+    UINT    middle;
+
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        if (nmtMnuInstance_g.aNodeList[middle] < nodeId_p)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+
+#if EPL_NMTMNU_BOOT_TIMELINE != FALSE
+//------------------------------------------------------------------------------
+/**
+\brief  Start boot timeline
+
+The function clears the boot timeline and stores the start time of the boot
+process. It is called when the MN enters PreOperational1.
+*/
+//------------------------------------------------------------------------------
+static void bootTimelineStart(void)
+{
+    EPL_MEMSET(&nmtMnuInstance_g.bootTimeline, 0xFF, sizeof(nmtMnuInstance_g.bootTimeline));
+    nmtMnuInstance_g.bootStartTickMs = EplTgtGetTickCountMs();
+    nmtMnuInstance_g.bootTimeline.aPhaseTime[kNmtBootPhasePreOp1] = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record start of boot phase
+
+The function records the time at which the MN entered a boot phase. If a
+phase is entered several times within a boot process, e.g. after the boot
+process was halted, only the first entry is recorded.
+
+\param  bootPhase_p         Boot phase which is started.
+*/
+//------------------------------------------------------------------------------
+static void bootTimelineSetPhase(tNmtBootPhase bootPhase_p)
+{
+    UINT32*     pTime = &nmtMnuInstance_g.bootTimeline.aPhaseTime[bootPhase_p];
+
+    if (*pTime == NMT_BOOT_TIME_INVALID)
+        *pTime = (UINT32)(EplTgtGetTickCountMs() - nmtMnuInstance_g.bootStartTickMs);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record boot milestone of CN
+
+The function records the time at which the specified CN reached a boot
+milestone. Only the first occurrence within a boot process is recorded.
+
+\param  nodeId_p            Node ID of the CN.
+\param  nodeEvent_p         Boot milestone which is reached.
+*/
+//------------------------------------------------------------------------------
+static void bootTimelineSetNodeEvent(UINT nodeId_p, tNmtBootNodeEvent nodeEvent_p)
+{
+    UINT32*     pTime;
+
+    if ((nodeId_p == 0) || (nodeId_p > NMT_BOOT_TIMELINE_NODE_COUNT))
+        return;
+
+    pTime = &nmtMnuInstance_g.bootTimeline.aaNodeTime[nodeId_p - 1][nodeEvent_p];
+    if (*pTime == NMT_BOOT_TIME_INVALID)
+        *pTime = (UINT32)(EplTgtGetTickCountMs() - nmtMnuInstance_g.bootStartTickMs);
+}
+#endif
 
 #if EPL_NMTMNU_PRES_CHAINING_MN != FALSE
 //------------------------------------------------------------------------------
@@ -3351,6 +3642,7 @@ The function performs the measure phase of a PRC node insertion
 static tEplKernel prcMeasure(void)
 {
     tEplKernel          ret;
+    UINT                index;
     UINT                nodeId;
     tNmtMnuNodeInfo*    pNodeInfo;
     BOOL                fSyncReqSentToPredNode;
@@ -3365,11 +3657,13 @@ static tEplKernel prcMeasure(void)
     nodeIdPrevSyncReq    = EPL_C_ADR_INVALID;
     nodeIdFirstNode      = EPL_C_ADR_INVALID;
 
-    for (nodeId = 1; nodeId < 254; nodeId++)
+    for (index = 0; index < nmtMnuInstance_g.nodeListCount; index++)
     {
+        nodeId = nmtMnuInstance_g.aNodeList[index];
+        if (nodeId >= 254)
+            break;
+
         pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
-        if (pNodeInfo == NULL)
-            continue;
 
         if (   (pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING)
             && (   (pNodeInfo->flags & NMTMNU_NODE_FLAG_ISOCHRON)
@@ -3479,6 +3773,7 @@ Time (MN).
 static tEplKernel prcCalculate(UINT nodeIdFirstNode_p)
 {
     tEplKernel          ret;
+    UINT                index;
     UINT                nodeId;
     tNmtMnuNodeInfo*    pNodeInfo;
     UINT                nodeIdPredNode;
@@ -3491,11 +3786,13 @@ static tEplKernel prcCalculate(UINT nodeIdFirstNode_p)
     }
 
     nodeIdPredNode = EPL_C_ADR_INVALID;
-    for (nodeId = nodeIdFirstNode_p; nodeId < 254; nodeId++)
+    for (index = findNodeListIndex(nodeIdFirstNode_p); index < nmtMnuInstance_g.nodeListCount; index++)
     {
+        nodeId = nmtMnuInstance_g.aNodeList[index];
+        if (nodeId >= 254)
+            break;
+
         pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
-        if (pNodeInfo == NULL)
-            continue;
 
         if ((pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING) &&
              ((pNodeInfo->flags & NMTMNU_NODE_FLAG_ISOCHRON) ||
@@ -3691,23 +3988,24 @@ addition is in progress.
 //------------------------------------------------------------------------------
 static UINT prcFindPredecessorNode(UINT nodeId_p)
 {
+    UINT                    index;
     UINT                    nodeId;
     tNmtMnuNodeInfo*        pNodeInfo;
 
-    for (nodeId = nodeId_p - 1; nodeId >= 1; nodeId--)
+    // the node list is searched backwards from the node before nodeId_p
+    for (index = findNodeListIndex(nodeId_p); index > 0; index--)
     {
+        nodeId = nmtMnuInstance_g.aNodeList[index - 1];
         pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
-        if (pNodeInfo == NULL)
-            continue;
 
         if ((pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING) &&
             ((pNodeInfo->flags & NMTMNU_NODE_FLAG_ISOCHRON) ||
              (pNodeInfo->prcFlags & NMTMNU_NODE_FLAG_PRC_ADD_IN_PROGRESS)))
         {
-            break;
+            return nodeId;
         }
     }
-    return nodeId;
+    return EPL_C_ADR_INVALID;
 }
 
 //------------------------------------------------------------------------------
@@ -3803,6 +4101,7 @@ The function performs the shift phase for PRC node insertion.
 static tEplKernel prcShift(UINT nodeIdPrevShift_p)
 {
     tEplKernel          ret;
+    UINT                index;
     UINT                nodeId;
     tNmtMnuNodeInfo*    pNodeInfo;
     tDllSyncRequest     syncRequestData;
@@ -3814,24 +4113,25 @@ static tEplKernel prcShift(UINT nodeIdPrevShift_p)
 
     // The search starts with the previous shift node
     // as this node might require a second SyncReq
-    nodeId = nodeIdPrevShift_p;
-    do
+    nodeId = EPL_C_ADR_INVALID;
+    pNodeInfo = NULL;
+    for (index = findNodeListIndex(nodeIdPrevShift_p + 1); index > 0; index--)
     {
-        pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
-        if (pNodeInfo == NULL)
-            continue;
+        pNodeInfo = NMTMNU_GET_NODEINFO(nmtMnuInstance_g.aNodeList[index - 1]);
 
         if ((pNodeInfo->nodeCfg & EPL_NODEASSIGN_PRES_CHAINING) &&
             ((pNodeInfo->flags & NMTMNU_NODE_FLAG_ISOCHRON) ||
              (pNodeInfo->prcFlags & NMTMNU_NODE_FLAG_PRC_ADD_IN_PROGRESS)))
         {
             if (pNodeInfo->prcFlags & NMTMNU_NODE_FLAG_PRC_SHIFT_REQUIRED)
+            {
+                nodeId = nmtMnuInstance_g.aNodeList[index - 1];
                 break;
+            }
         }
-        nodeId--;
-    } while (nodeId >= 1);
+    }
 
-    if (nodeId == 0)
+    if (nodeId == EPL_C_ADR_INVALID)
     {   // No node requires shifting
         // Enter next phase
         ret = prcAdd(EPL_C_ADR_INVALID);
@@ -3910,6 +4210,7 @@ static tEplKernel prcAdd(UINT nodeIdPrevAdd_p)
     tObdSize            obdSize;
     UINT32              cycleLenUs;
     UINT32              cNLossOfSocToleranceNs;
+    UINT                index;
     UINT                nodeId;
     tNmtMnuNodeInfo*    pNodeInfo;
     tDllSyncRequest     syncReqData;
@@ -3939,11 +4240,10 @@ static tEplKernel prcAdd(UINT nodeIdPrevAdd_p)
     pNodeInfoLastSyncReq = NULL;
 
     // The search starts with the next node after the previous one
-    for (nodeId = nodeIdPrevAdd_p + 1; nodeId <= 254; nodeId++)
+    for (index = findNodeListIndex(nodeIdPrevAdd_p + 1); index < nmtMnuInstance_g.nodeListCount; index++)
     {
+        nodeId = nmtMnuInstance_g.aNodeList[index];
         pNodeInfo = NMTMNU_GET_NODEINFO(nodeId);
-        if (pNodeInfo == NULL)
-            continue;
 
         if (pNodeInfo->prcFlags & NMTMNU_NODE_FLAG_PRC_ADD_IN_PROGRESS)
         {
@@ -66,6 +66,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define OBD_SNAPSHOT_PART_COUNT     4       // generic, manufacturer, device and user part
 
 //------------------------------------------------------------------------------
 // local types
@@ -83,11 +84,95 @@ typedef struct
     tObdSize        (*pfnGetObjSize)(tObdSubEntryPtr pSubIndexEntry_p);
 } tObdDataTypeSize;
 
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+/**
+\brief Snapshot copy entry
+
+The structure describes a block of default data in the snapshot which is
+copied to the current data of one or more consecutive objects.
+*/
+typedef struct
+{
+    void MEM*           pDstData;           ///< Pointer to the current data
+    tObdSize            offset;             ///< Offset of the default data in the snapshot
+    tObdSize            size;               ///< Size of the data block
+} tObdSnapshotCopy;
+
+/**
+\brief Snapshot variable entry
+
+The structure describes a variable of an object without callback function.
+The default data is copied to the variable linked by the application.
+*/
+typedef struct
+{
+    tObdVarEntry MEM*   pVarEntry;          ///< Pointer to the VarEntry of the object
+    tObdSize            offset;             ///< Offset of the default data in the snapshot
+    tObdSize            size;               ///< Size of the default data
+} tObdSnapshotVar;
+
+/**
+\brief Snapshot fixup types
+
+The enumeration lists the types of sub-indices which need further handling
+after the copy entries of a snapshot have been applied.
+*/
+typedef enum
+{
+    kObdSnapshotFixupPostDefault    = 0,    ///< Static object, only the post default event is issued
+    kObdSnapshotFixupVarEntry       = 1,    ///< Default data is copied to the linked variable
+    kObdSnapshotFixupResolve        = 2,    ///< String or domain, data pointer and size are resolved
+} tObdSnapshotFixupType;
+
+/**
+\brief Snapshot fixup entry
+
+The structure describes a sub-index which needs further handling after the
+copy entries of the snapshot have been applied. The data of variables,
+strings and domains is copied at the time of the reset because their data
+pointer and size may change at runtime. For all sub-indices of objects with a
+callback function the post default event is issued.
+*/
+typedef struct
+{
+    tObdEntryPtr        pObdEntry;          ///< Pointer to the index entry
+    tObdSubEntryPtr     pSubEntry;          ///< Pointer to the sub-index entry
+    UINT                subIndex;           ///< Sub-index number (needed for arrays)
+    tObdSnapshotFixupType fixupType;        ///< Type of the fixup
+    void MEM*           pData;              ///< Pointer to the current data or to the VarEntry
+    tObdSize            offset;             ///< Offset of the default data of a variable
+    tObdSize            size;               ///< Size of the default data of a variable
+} tObdSnapshotFixup;
+
+/**
+\brief Default value snapshot of an OD partition
+
+The snapshot contains the default data of all static objects of an OD
+partition in one contiguous block. It is allocated as a single memory block
+which contains this structure, the copy, variable and fixup entries and the
+default data.
+*/
+typedef struct
+{
+    UINT                copyCount;          ///< Number of copy entries
+    UINT                varCount;           ///< Number of variable entries
+    UINT                fixupCount;         ///< Number of fixup entries
+    tObdSnapshotCopy*   paCopy;             ///< Pointer to the copy entries
+    tObdSnapshotVar*    paVar;              ///< Pointer to the variable entries
+    tObdSnapshotFixup*  paFixup;            ///< Pointer to the fixup entries
+    BYTE*               pData;              ///< Pointer to the default data
+    tObdSize            dataSize;           ///< Size of the default data
+} tObdSnapshot;
+#endif
+
 typedef struct
 {
     tObdInitParam                   initParam;
     tObdStoreLoadCallback           pfnStoreLoadObjectCb;
     BYTE                            obdTrashObject[8];
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+    tObdSnapshot*                   apSnapshot[OBD_SNAPSHOT_PART_COUNT];
+#endif
 } tObdInstance;
 
 //------------------------------------------------------------------------------
@@ -126,14 +211,26 @@ static tEplKernel   callObjectCallback(tObdCallback pfnCallback_p, tObdCbParam M
 static tEplKernel   callPostDefault(void *pData_p, tObdEntryPtr pObdEntry_p, tObdSubEntryPtr pObdSubEntry_p);
 static tEplKernel   isNumerical(tObdSubEntryPtr pObdSubEntry_p, BOOL* pfEntryNumerical_p);
 
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+static tEplKernel   restoreSnapshot(tObdPart currentOdPart_p, tObdEntryPtr pObdEntry_p);
+static tEplKernel   createSnapshot(tObdEntryPtr pObdEntry_p, tObdSnapshot** ppSnapshot_p);
+static void         scanSnapshot(tObdEntryPtr pObdEntry_p, tObdSnapshot* pSnapshot_p);
+static void         addSnapshotFixup(tObdSnapshot* pSnapshot_p, tObdEntryPtr pObdEntry_p,
+                                     tObdSubEntryPtr pSubEntry_p, tObdSnapshotFixupType fixupType_p,
+                                     void MEM* pData_p, tObdSize size_p);
+static void         freeSnapshot(tObdPart obdPart_p);
+static tObdSnapshot** getSnapshotSlot(tObdPart obdPart_p);
+#endif
+
 #if (CONFIG_OBD_CHECK_OBJECT_RANGE != FALSE)
 static tEplKernel   checkObjectRange(tObdSubEntryPtr pSubIndexEntry_p, void * pData_p);
 #endif
 
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
 static tEplKernel   prepareStoreRestore(tObdDir direction_p, tObdCbStoreParam MEM* pCbStore_p);
-static tEplKernel   cleanupStoreRestore(tObdDir direction_p, tObdCbStoreParam MEM* pCbStore_p)
+static tEplKernel   cleanupStoreRestore(tObdDir direction_p, tObdCbStoreParam MEM* pCbStore_p);
 static tEplKernel   doStoreRestore(tObdAccess access_p, tObdCbStoreParam MEM* pCbStore_p,
+                                   UINT index_p, UINT subIndex_p,
                                    void MEM * pObjData_p, tObdSize objSize_p);
 static tEplKernel   callStoreCallback(tObdCbStoreParam MEM* pCbStoreParam_p);
 #endif // (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
@@ -198,6 +295,11 @@ tEplKernel obd_init(tObdInitParam MEM* pInitParam_p)
     if (pInitParam_p == NULL)
         return kEplSuccessful;
 
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+    // snapshots of a previous OD are no longer valid
+    freeSnapshot(kObdPartAll);
+#endif
+
     EPL_MEMCPY (&obdInstance_l.initParam, pInitParam_p, sizeof (tObdInitParam));
 
     // clear callback function for command LOAD and STORE
@@ -223,6 +325,9 @@ The function deinitializes the OD module.
 //------------------------------------------------------------------------------
 tEplKernel obd_deleteInstance(void)
 {
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+    freeSnapshot(kObdPartAll);
+#endif
     return kEplSuccessful;
 }
 
@@ -521,6 +626,9 @@ The function registers an user object dictionary.
 tEplKernel obd_registerUserOd (tObdEntryPtr pUserOd_p)
 {
     obdInitParam_l.m_pUserPart = pUserOd_p;
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+    freeSnapshot(kObdPartUsr);
+#endif
     return kEplSuccessful;
 }
 #endif
@@ -1045,7 +1153,10 @@ tEplKernel obd_searchVarEntry(UINT index_p, UINT subIndex_p, tObdVarEntry MEM**
 /**
 \brief  Set callback function for load/store command
 
-The function sets the callback function for the load/store command.
+The function sets the callback function for the load/store command. If the
+callback returns kEplObdNoConfigData for kObdCmdOpenRead, no stored parameters
+exist. The objects are then only set to their default values and the callback
+is not called for the objects and for kObdCmdCloseRead.
 
 \param  pfnCallback_p           Pointer to the callback function.
 
@@ -1058,7 +1169,7 @@ The function sets the callback function for the load/store command.
 tEplKernel obd_storeLoadObjCallback (tObdStoreLoadCallback pfnCallback_p)
 {
     // set new address of callback function
-    pfnStoreLoadObjectCb_l = pfnCallback_p;
+    obdInstance_l.pfnStoreLoadObjectCb = pfnCallback_p;
     return kEplSuccessful;
 }
 #endif // (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
@@ -1921,24 +2032,50 @@ static tEplKernel accessOdPartition (tObdPart currentOdPart_p, tObdEntryPtr pObd
     tObdSize                    ObjSize;
     tEplKernel                  Ret = kEplSuccessful;
     tObdVarEntry MEM*           pVarEntry = NULL;
+    BOOL                        fDefaultRestored = FALSE;
+    BOOL                        fStoreRestore = FALSE;
 
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
     tObdCbStoreParam MEM        CbStore;
-#else
+#elif (CONFIG_OBD_USE_RESET_SNAPSHOT == FALSE)
     UNUSED_PARAMETER(currentOdPart_p);
 #endif
 
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
     // prepare structure for STORE RESTORE callback function
     CbStore.currentOdPart   = (BYTE) currentOdPart_p;
+    CbStore.index           = 0;
+    CbStore.subIndex        = 0;
     CbStore.pData           = NULL;
     CbStore.objSize         = 0;
 
     // command of first action depends on direction to access
-    if ((Ret = prepareStoreRestore(direction_p, &CbStore)) != kEplSuccessful)
+    Ret = prepareStoreRestore(direction_p, &CbStore);
+    if (Ret == kEplObdNoConfigData)
+    {   // no stored parameters exist, only the default values are loaded
+        Ret = kEplSuccessful;
+    }
+    else if (Ret != kEplSuccessful)
+    {
         return Ret;
+    }
+    else
+    {
+        fStoreRestore = TRUE;
+    }
+#endif
+
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+    // default values are restored from the snapshot of the partition. If the
+    // snapshot can't be created the partition is walked through as usual.
+    if (direction_p == kObdDirLoad)
+        fDefaultRestored = (restoreSnapshot(currentOdPart_p, pObdEntry_p) == kEplSuccessful);
 #endif
 
+    // nothing left to do if the default values are already restored
+    if (fDefaultRestored && !fStoreRestore)
+        return Ret;
+
     // we should not restore the OD values here
     // the next NMT command "Reset Node" or "Reset Communication" resets the OD data
     if (direction_p != kObdDirRestore)
@@ -2005,17 +2142,29 @@ static tEplKernel accessOdPartition (tObdPart currentOdPart_p, tObdEntryPtr pObd
 
                     // objects with attribute kObdAccStore has to be load from EEPROM or from a file
                     case kObdDirLoad:
-                        copyObjectData(pDstData, pDefault, ObjSize, pSubIndex->type);
-                        callPostDefault(pDstData, pObdEntry_p, pSubIndex);
+                        if (!fDefaultRestored)
+                        {
+                            copyObjectData(pDstData, pDefault, ObjSize, pSubIndex->type);
+                            callPostDefault(pDstData, pObdEntry_p, pSubIndex);
+                        }
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
-                        doStoreRestore(Access, &CbStore, pDstData, ObjSize);
+                        // the remaining objects keep their default values if loading fails
+                        if ((Ret == kEplSuccessful) && fStoreRestore)
+                        {
+                            Ret = doStoreRestore(Access, &CbStore, pObdEntry_p->index,
+                                                 pSubIndex->subIndex, pDstData, ObjSize);
+                        }
 #endif
                         break;
 
                     // objects with attribute kObdAccStore has to be stored in EEPROM or in a file
                     case kObdDirStore:
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
-                        doStoreRestore(Access, &CbStore, pDstData, ObjSize);
+                        if (Ret == kEplSuccessful)
+                        {
+                            Ret = doStoreRestore(Access, &CbStore, pObdEntry_p->index,
+                                                 pSubIndex->subIndex, pDstData, ObjSize);
+                        }
 #endif
                         break;
 
@@ -2053,12 +2202,19 @@ static tEplKernel accessOdPartition (tObdPart currentOdPart_p, tObdEntryPtr pObd
         }
     }
 
-    // command of last action depends on direction to access
+    // command of last action depends on direction to access. It is also issued
+    // if an object failed, so the callback is able to discard the transfer.
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
-    return cleanupStoreRestore(direction_p, &CbStore);
-#else
-    return Ret;
+    if (fStoreRestore)
+    {
+        tEplKernel      cleanupRet;
+
+        cleanupRet = cleanupStoreRestore(direction_p, &CbStore);
+        if (Ret == kEplSuccessful)
+            Ret = cleanupRet;
+    }
 #endif
+    return Ret;
 }
 
 //------------------------------------------------------------------------------
@@ -2194,6 +2350,379 @@ static tEplKernel isNumerical(tObdSubEntryPtr pObdSubEntry_p,
     return ret;
 }
 
+#if (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Restore default values from snapshot
+
+The function restores the default values of an OD partition from its
+snapshot. The snapshot is created on the first call. The default data of all
+static objects is copied in blocks and the linked variables are restored,
+afterwards the fixup entries are processed in the order of the OD.
+
+\param  currentOdPart_p         OD partition to restore.
+\param  pObdEntry_p             Pointer to first index entry of the partition.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel restoreSnapshot(tObdPart currentOdPart_p, tObdEntryPtr pObdEntry_p)
+{
+    tEplKernel              ret;
+    tObdSnapshot**          ppSnapshot;
+    tObdSnapshot*           pSnapshot;
+    tObdSnapshotCopy*       pCopy;
+    tObdSnapshotVar*        pVar;
+    tObdSnapshotFixup*      pFixup;
+    tObdSubEntryPtr         pSubEntry;
+    void MEM*               pDstData;
+    UINT                    i;
+
+    ppSnapshot = getSnapshotSlot(currentOdPart_p);
+    if (ppSnapshot == NULL)
+        return kEplObdIllegalPart;
+
+    if (*ppSnapshot == NULL)
+    {
+        ret = createSnapshot(pObdEntry_p, ppSnapshot);
+        if (ret != kEplSuccessful)
+            return ret;
+    }
+    pSnapshot = *ppSnapshot;
+
+    pCopy = pSnapshot->paCopy;
+    for (i = 0; i < pSnapshot->copyCount; i++, pCopy++)
+    {
+        EPL_MEMCPY(pCopy->pDstData, pSnapshot->pData + pCopy->offset, pCopy->size);
+    }
+
+    // variables which aren't linked by the application point to the trash
+    // object, there is no need to restore them
+    pVar = pSnapshot->paVar;
+    for (i = 0; i < pSnapshot->varCount; i++, pVar++)
+    {
+        pDstData = pVar->pVarEntry->pData;
+        if ((pDstData != NULL) && (pDstData != obdInstance_l.obdTrashObject))
+            EPL_MEMCPY(pDstData, pSnapshot->pData + pVar->offset, pVar->size);
+    }
+
+    pFixup = pSnapshot->paFixup;
+    for (i = 0; i < pSnapshot->fixupCount; i++, pFixup++)
+    {
+        pSubEntry = pFixup->pSubEntry;
+        if ((pSubEntry->access & kObdAccArray) != 0)
+            pSubEntry->subIndex = pFixup->subIndex;
+
+        switch (pFixup->fixupType)
+        {
+            case kObdSnapshotFixupVarEntry:
+                pDstData = ((tObdVarEntry MEM*)pFixup->pData)->pData;
+                if ((pDstData != NULL) && (pDstData != obdInstance_l.obdTrashObject) &&
+                    (pFixup->size != 0))
+                {
+                    EPL_MEMCPY(pDstData, pSnapshot->pData + pFixup->offset, pFixup->size);
+                }
+                break;
+
+            case kObdSnapshotFixupResolve:
+                pDstData = getObjectCurrentPtr(pSubEntry);
+                copyObjectData(pDstData, getObjectDefaultPtr(pSubEntry),
+                               getObjectSize(pSubEntry), pSubEntry->type);
+                break;
+
+            default:
+                pDstData = pFixup->pData;
+                break;
+        }
+
+        if (pFixup->pObdEntry->pfnCallback != NULL)
+            callPostDefault(pDstData, pFixup->pObdEntry, pSubEntry);
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create snapshot of an OD partition
+
+The function creates the default value snapshot of an OD partition. The
+partition is scanned twice, first to determine the size of the snapshot and
+then to fill it.
+
+\param  pObdEntry_p             Pointer to first index entry of the partition.
+\param  ppSnapshot_p            Pointer to store the pointer to the snapshot.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel createSnapshot(tObdEntryPtr pObdEntry_p, tObdSnapshot** ppSnapshot_p)
+{
+    tObdSnapshot            snapshotSize;
+    tObdSnapshot*           pSnapshot;
+    size_t                  allocSize;
+
+    EPL_MEMSET(&snapshotSize, 0, sizeof(tObdSnapshot));
+    scanSnapshot(pObdEntry_p, &snapshotSize);
+
+    allocSize = sizeof(tObdSnapshot) +
+                (snapshotSize.copyCount * sizeof(tObdSnapshotCopy)) +
+                (snapshotSize.varCount * sizeof(tObdSnapshotVar)) +
+                (snapshotSize.fixupCount * sizeof(tObdSnapshotFixup)) +
+                snapshotSize.dataSize;
+
+    pSnapshot = (tObdSnapshot*)EPL_MALLOC(allocSize);
+    if (pSnapshot == NULL)
+    {
+        EPL_DBGLVL_OBD_TRACE("%s() couldn't allocate snapshot of %u bytes!\n", __func__,
+                             (UINT)allocSize);
+        return kEplNoResource;
+    }
+
+    EPL_MEMSET(pSnapshot, 0, sizeof(tObdSnapshot));
+    pSnapshot->paCopy = (tObdSnapshotCopy*)(pSnapshot + 1);
+    pSnapshot->paVar = (tObdSnapshotVar*)(pSnapshot->paCopy + snapshotSize.copyCount);
+    pSnapshot->paFixup = (tObdSnapshotFixup*)(pSnapshot->paVar + snapshotSize.varCount);
+    pSnapshot->pData = (BYTE*)(pSnapshot->paFixup + snapshotSize.fixupCount);
+    scanSnapshot(pObdEntry_p, pSnapshot);
+
+    EPL_DBGLVL_OBD_TRACE("%s() %u copies, %u variables, %u fixups, %u bytes of data\n", __func__,
+                         pSnapshot->copyCount, pSnapshot->varCount, pSnapshot->fixupCount,
+                         (UINT)pSnapshot->dataSize);
+
+    *ppSnapshot_p = pSnapshot;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Scan OD partition for snapshot
+
+The function walks through an OD partition like accessOdPartition() does and
+collects the copy, variable and fixup entries of the snapshot. The default
+data of consecutive objects is merged into one copy entry. If the entry arrays
+of the snapshot aren't set up, only the number of entries and the data size
+are determined.
+
+\param  pObdEntry_p             Pointer to first index entry of the partition.
+\param  pSnapshot_p             Pointer to the snapshot to fill.
+*/
+//------------------------------------------------------------------------------
+static void scanSnapshot(tObdEntryPtr pObdEntry_p, tObdSnapshot* pSnapshot_p)
+{
+    tObdSubEntryPtr         pSubIndex;
+    UINT                    nSubIndexCount;
+    tObdAccess              access;
+    tObdType                type;
+    CONST void*             pDefault;
+    void MEM*               pDstData;
+    tObdSize                objSize;
+    BYTE MEM*               pNextDstData = NULL;
+    BOOL                    fFill = (pSnapshot_p->paCopy != NULL);
+    tObdVarEntry MEM*       pVarEntry = NULL;
+    tObdSnapshotCopy*       pCopy;
+    tObdSnapshotVar*        pVar;
+
+    while (pObdEntry_p->index != OBD_TABLE_INDEX_END)
+    {
+        pSubIndex = pObdEntry_p->pSubIndex;
+        nSubIndexCount = pObdEntry_p->count;
+
+        while (nSubIndexCount != 0)
+        {
+            access = (tObdAccess)pSubIndex->access;
+            type = pSubIndex->type;
+
+            if ((type == kObdTypeVString) || (type == kObdTypeOString) || (type == kObdTypeDomain))
+            {   // data pointer and size of strings and domains are resolved at the time of the reset
+                addSnapshotFixup(pSnapshot_p, pObdEntry_p, pSubIndex, kObdSnapshotFixupResolve, NULL, 0);
+            }
+            else if ((access & kObdAccVar) != 0)
+            {   // the variable is linked at runtime, its default data is kept in the snapshot
+                getVarEntry(pSubIndex, &pVarEntry);
+                pDefault = getObjectDefaultPtr(pSubIndex);
+                objSize  = (pDefault != NULL) ? getObjectSize(pSubIndex) : 0;
+
+                if (pObdEntry_p->pfnCallback != NULL)
+                {   // post default event must be issued
+                    addSnapshotFixup(pSnapshot_p, pObdEntry_p, pSubIndex, kObdSnapshotFixupVarEntry,
+                                     pVarEntry, objSize);
+                }
+                else if (objSize != 0)
+                {
+                    if (fFill)
+                    {
+                        pVar = &pSnapshot_p->paVar[pSnapshot_p->varCount];
+                        pVar->pVarEntry = pVarEntry;
+                        pVar->offset    = pSnapshot_p->dataSize;
+                        pVar->size      = objSize;
+                    }
+                    pSnapshot_p->varCount++;
+                }
+
+                if (fFill && (objSize != 0))
+                    EPL_MEMCPY(pSnapshot_p->pData + pSnapshot_p->dataSize, pDefault, objSize);
+                pSnapshot_p->dataSize += objSize;
+            }
+            else
+            {   // the current data of this object can't be moved at runtime
+                pDefault = getObjectDefaultPtr(pSubIndex);
+                pDstData = getObjectCurrentPtr(pSubIndex);
+                objSize  = getObjectSize(pSubIndex);
+
+                if ((pDstData != NULL) && (pDefault != NULL) && (objSize != 0))
+                {
+                    if ((pSnapshot_p->copyCount != 0) && ((BYTE MEM*)pDstData == pNextDstData))
+                    {   // object follows the previous one, extend its copy entry
+                        if (fFill)
+                            pSnapshot_p->paCopy[pSnapshot_p->copyCount - 1].size += objSize;
+                    }
+                    else
+                    {
+                        if (fFill)
+                        {
+                            pCopy = &pSnapshot_p->paCopy[pSnapshot_p->copyCount];
+                            pCopy->pDstData = pDstData;
+                            pCopy->offset   = pSnapshot_p->dataSize;
+                            pCopy->size     = objSize;
+                        }
+                        pSnapshot_p->copyCount++;
+                    }
+
+                    if (fFill)
+                        EPL_MEMCPY(pSnapshot_p->pData + pSnapshot_p->dataSize, pDefault, objSize);
+                    pSnapshot_p->dataSize += objSize;
+                    pNextDstData = (BYTE MEM*)pDstData + objSize;
+                }
+
+                if (pObdEntry_p->pfnCallback != NULL)
+                {   // post default event must be issued
+                    addSnapshotFixup(pSnapshot_p, pObdEntry_p, pSubIndex,
+                                     kObdSnapshotFixupPostDefault, pDstData, 0);
+                }
+            }
+
+            nSubIndexCount--;
+
+            // next sub-index entry
+            if ((access & kObdAccArray) == 0)
+            {
+                pSubIndex++;
+                if ((nSubIndexCount > 0) && ((pSubIndex->access & kObdAccArray) != 0))
+                {
+                    pSubIndex->subIndex = 1;    // next sub-index points to an array - reset sub-index number
+                }
+            }
+            else
+            {
+                if (nSubIndexCount > 0)
+                {
+                    pSubIndex->subIndex++;      // next sub-index points to an array - increment sub-index number
+                }
+            }
+        }
+        pObdEntry_p++;                          // next index entry
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add fixup entry to snapshot
+
+The function adds a fixup entry to a snapshot. The default data of a variable
+must be appended to the snapshot data by the caller afterwards. If the entry
+arrays of the snapshot aren't set up, only the number of entries is counted.
+
+\param  pSnapshot_p             Pointer to the snapshot.
+\param  pObdEntry_p             Pointer to the index entry.
+\param  pSubEntry_p             Pointer to the sub-index entry.
+\param  fixupType_p             Type of the fixup.
+\param  pData_p                 Pointer to the current data or to the VarEntry.
+\param  size_p                  Size of the default data of a variable.
+*/
+//------------------------------------------------------------------------------
+static void addSnapshotFixup(tObdSnapshot* pSnapshot_p, tObdEntryPtr pObdEntry_p,
+                             tObdSubEntryPtr pSubEntry_p, tObdSnapshotFixupType fixupType_p,
+                             void MEM* pData_p, tObdSize size_p)
+{
+    tObdSnapshotFixup*      pFixup;
+
+    if (pSnapshot_p->paFixup != NULL)
+    {
+        pFixup = &pSnapshot_p->paFixup[pSnapshot_p->fixupCount];
+        pFixup->pObdEntry = pObdEntry_p;
+        pFixup->pSubEntry = pSubEntry_p;
+        pFixup->subIndex  = pSubEntry_p->subIndex;
+        pFixup->fixupType = fixupType_p;
+        pFixup->pData     = pData_p;
+        pFixup->offset    = pSnapshot_p->dataSize;
+        pFixup->size      = size_p;
+    }
+    pSnapshot_p->fixupCount++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free snapshots
+
+The function frees the snapshots of the specified OD partitions.
+
+\param  obdPart_p               OD partitions whose snapshots shall be freed.
+*/
+//------------------------------------------------------------------------------
+static void freeSnapshot(tObdPart obdPart_p)
+{
+    static const tObdPart   aPart[OBD_SNAPSHOT_PART_COUNT] =
+                                {kObdPartGen, kObdPartMan, kObdPartDev, kObdPartUsr};
+    tObdSnapshot**          ppSnapshot;
+    UINT                    i;
+
+    for (i = 0; i < OBD_SNAPSHOT_PART_COUNT; i++)
+    {
+        if ((obdPart_p & aPart[i]) == 0)
+            continue;
+
+        ppSnapshot = getSnapshotSlot(aPart[i]);
+        if (*ppSnapshot != NULL)
+        {
+            EPL_FREE(*ppSnapshot);
+            *ppSnapshot = NULL;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get snapshot slot of OD partition
+
+\param  obdPart_p               OD partition (only one partition bit).
+
+\return The function returns a pointer to the snapshot pointer of the
+        partition or NULL if the partition is invalid.
+*/
+//------------------------------------------------------------------------------
+static tObdSnapshot** getSnapshotSlot(tObdPart obdPart_p)
+{
+    switch (obdPart_p)
+    {
+        case kObdPartGen:
+            return &obdInstance_l.apSnapshot[0];
+
+        case kObdPartMan:
+            return &obdInstance_l.apSnapshot[1];
+
+        case kObdPartDev:
+            return &obdInstance_l.apSnapshot[2];
+
+        case kObdPartUsr:
+            return &obdInstance_l.apSnapshot[3];
+
+        default:
+            return NULL;
+    }
+}
+#endif // (CONFIG_OBD_USE_RESET_SNAPSHOT != FALSE)
+
 #if (CONFIG_OBD_CHECK_OBJECT_RANGE != FALSE)
 //------------------------------------------------------------------------------
 /**
@@ -2445,7 +2974,7 @@ The functions cleans up a store/restore command.
 //------------------------------------------------------------------------------
 static tEplKernel cleanupStoreRestore(tObdDir direction_p, tObdCbStoreParam MEM* pCbStore_p)
 {
-    tEplKernel          ret;
+    tEplKernel          ret = kEplSuccessful;
 
     if (direction_p == kObdDirOBKCheck)
     {
@@ -2481,6 +3010,8 @@ The functions executes a store/restore command.
 
 \param  access_p                OD access command.
 \param  pCbStore_p              Pointer to store callback parameters.
+\param  index_p                 Index of object.
+\param  subIndex_p              Sub-index of object.
 \param  pObjData_p              Pointer to object data.
 \param  objSize_p               Size of object.
 
@@ -2488,14 +3019,17 @@ The functions executes a store/restore command.
 */
 //------------------------------------------------------------------------------
 static tEplKernel doStoreRestore(tObdAccess access_p, tObdCbStoreParam MEM* pCbStore_p,
-                          void MEM * pObjData_p, tObdSize objSize_p)
+                          UINT index_p, UINT subIndex_p, void MEM * pObjData_p, tObdSize objSize_p)
 {
     tEplKernel          ret = kEplSuccessful;
 
     // when attribute kObdAccStore is set, then call callback function
-    if ((access_p & kObdAccStore) != 0)
+    // (not for VAR objects which are not linked to application variables yet)
+    if (((access_p & kObdAccStore) != 0) && (pObjData_p != NULL))
     {
-        // fill out data pointer and size of data
+        // fill out object, data pointer and size of data
+        pCbStore_p->index    = index_p;
+        pCbStore_p->subIndex = subIndex_p;
         pCbStore_p->pData    = pObjData_p;
         pCbStore_p->objSize  = objSize_p;
 
@@ -2520,9 +3054,9 @@ static tEplKernel callStoreCallback(tObdCbStoreParam MEM* pCbStoreParam_p)
 {
     tEplKernel ret = kEplSuccessful;
 
-    if (pfnStoreLoadObjectCb_l != NULL)
+    if (obdInstance_l.pfnStoreLoadObjectCb != NULL)
     {
-        ret = pfnStoreLoadObjectCb_l(pCbStoreParam_p);
+        ret = obdInstance_l.pfnStoreLoadObjectCb(pCbStoreParam_p);
     }
     return ret;
 }
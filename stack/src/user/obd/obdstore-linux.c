@@ -0,0 +1,713 @@
+/**
+********************************************************************************
+\file   obdstore-linux.c
+
+\brief  Implementation of the OBD store module for Linux
+
+This file contains the Linux implementation of the OBD store module. It stores
+the objects of each OD partition in a binary image file which is written with
+a single write and replaced atomically. On load the image is mapped into
+memory and validated by its checksums before the objects are restored.
+
+\ingroup module_obd
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <obd.h>
+#include <obdstore.h>
+#include <crc32.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define OBDSTORE_IMAGE_MAGIC        0x5344424F      // "OBDS"
+#define OBDSTORE_IMAGE_VERSION      1
+#define OBDSTORE_INITIAL_BUF_SIZE   4096
+#define OBDSTORE_ALIGN(size)        (((size) + 3) & ~3)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief  Image header
+
+The header is located at the beginning of every image. It is followed by the
+object records of the OD partition.
+*/
+typedef struct
+{
+    UINT32              magic;                  ///< Magic number of the image
+    UINT16              version;                ///< Version of the image layout
+    UINT8               odPart;                 ///< OD partition stored in the image
+    UINT8               reserved;
+    UINT32              recordCount;            ///< Number of object records
+    UINT32              dataSize;               ///< Size of the object records
+    UINT32              dataCrc;                ///< CRC-32 of the object records
+    UINT32              headerCrc;              ///< CRC-32 of the preceding header fields
+} tObdStoreHeader;
+
+/**
+\brief  Object record
+
+Every stored object is saved as a record which is followed by the object data.
+The data is padded to a multiple of 4 bytes.
+*/
+typedef struct
+{
+    UINT16              index;                  ///< Index of the object
+    UINT8               subIndex;               ///< Sub-index of the object
+    UINT8               reserved;
+    UINT32              size;                   ///< Size of the object data
+} tObdStoreRecord;
+
+/**
+\brief  OBD store instance
+
+The structure contains all variables of the OBD store module.
+*/
+typedef struct
+{
+    char*               pStorePath;             ///< Directory of the image files
+    UINT8*              pWriteBuffer;           ///< Buffer for building the image to store
+    size_t              writeBufferSize;        ///< Size of the write buffer
+    size_t              writeSize;              ///< Used size of the write buffer
+    UINT32              writeRecordCount;       ///< Number of records in the write buffer
+    BOOL                fWriteFailed;           ///< The image to store is incomplete
+    UINT8*              pReadImage;             ///< Mapped image to load
+    size_t              readImageSize;          ///< Size of the mapped image
+    size_t              readOffset;             ///< Offset of the next record to load
+} tObdStoreInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdStoreInstance    obdStoreInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel openWrite(void);
+static tEplKernel writeObject(tObdCbStoreParam MEM* pCbStoreParam_p);
+static tEplKernel closeWrite(tObdPart odPart_p);
+static tEplKernel openRead(tObdPart odPart_p);
+static tEplKernel readObject(tObdCbStoreParam MEM* pCbStoreParam_p);
+static void       closeRead(void);
+static tEplKernel clearImage(tObdPart odPart_p);
+static tEplKernel getFilename(tObdPart odPart_p, char* pFilename_p, size_t size_p);
+static BOOL       validateImage(tObdPart odPart_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize OBD store module
+
+The function initializes the OBD store module.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_obd
+*/
+//------------------------------------------------------------------------------
+tEplKernel obdstore_init(void)
+{
+    EPL_MEMSET(&obdStoreInstance_l, 0, sizeof(tObdStoreInstance));
+    obdStoreInstance_l.pStorePath = CONFIG_OBD_DEF_STORE_PATH;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Exit OBD store module
+
+The function exits and cleans up the OBD store module.
+
+\ingroup module_obd
+*/
+//------------------------------------------------------------------------------
+void obdstore_exit(void)
+{
+    closeRead();
+
+    if (obdStoreInstance_l.pWriteBuffer != NULL)
+        EPL_FREE(obdStoreInstance_l.pWriteBuffer);
+
+    EPL_MEMSET(&obdStoreInstance_l, 0, sizeof(tObdStoreInstance));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the store path
+
+The function sets the directory in which the images of the OD partitions are
+stored.
+
+\param  pStorePath_p        Directory of the image files.
+
+\ingroup module_obd
+*/
+//------------------------------------------------------------------------------
+void obdstore_setPath(char* pStorePath_p)
+{
+    obdStoreInstance_l.pStorePath = pStorePath_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store/load callback function
+
+The function implements the store/load callback of the OBD module. Each OD
+partition is stored as one image file. The objects of the partition are
+collected in memory and written with a single write to a temporary file
+which then atomically replaces the previous image. On load the image is
+mapped into memory and validated before any object is loaded. A missing or
+invalid image is reported by kEplObdNoConfigData, so the objects keep their
+default values and the OD is not walked for loading.
+
+\param  pCbStoreParam_p     Pointer to store callback parameters.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_obd
+*/
+//------------------------------------------------------------------------------
+tEplKernel obdstore_cbStoreLoadObject(tObdCbStoreParam MEM* pCbStoreParam_p)
+{
+    tEplKernel      ret = kEplSuccessful;
+
+    switch (pCbStoreParam_p->command)
+    {
+        case kObdCmdOpenWrite:
+            ret = openWrite();
+            break;
+
+        case kObdCmdWriteObj:
+            ret = writeObject(pCbStoreParam_p);
+            break;
+
+        case kObdCmdCloseWrite:
+            ret = closeWrite(pCbStoreParam_p->currentOdPart);
+            break;
+
+        case kObdCmdOpenRead:
+            ret = openRead(pCbStoreParam_p->currentOdPart);
+            break;
+
+        case kObdCmdReadObj:
+            ret = readObject(pCbStoreParam_p);
+            break;
+
+        case kObdCmdCloseRead:
+            closeRead();
+            break;
+
+        case kObdCmdClear:
+            ret = clearImage(pCbStoreParam_p->currentOdPart);
+            break;
+
+        default:
+            break;
+    }
+
+    return ret;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open image for writing
+
+The function prepares the write buffer for a new image. The header is filled
+in when the image is closed.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel openWrite(void)
+{
+    if (obdStoreInstance_l.pWriteBuffer == NULL)
+    {
+        obdStoreInstance_l.pWriteBuffer = (UINT8*)EPL_MALLOC(OBDSTORE_INITIAL_BUF_SIZE);
+        if (obdStoreInstance_l.pWriteBuffer == NULL)
+            return kEplObdOutOfMemory;
+        obdStoreInstance_l.writeBufferSize = OBDSTORE_INITIAL_BUF_SIZE;
+    }
+
+    obdStoreInstance_l.writeSize = sizeof(tObdStoreHeader);
+    obdStoreInstance_l.writeRecordCount = 0;
+    obdStoreInstance_l.fWriteFailed = FALSE;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write object into image
+
+The function appends the object to the image in the write buffer. The buffer
+is enlarged if necessary.
+
+\param  pCbStoreParam_p     Pointer to store callback parameters.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel writeObject(tObdCbStoreParam MEM* pCbStoreParam_p)
+{
+    tObdStoreRecord*    pRecord;
+    size_t              recordSize;
+    size_t              newSize;
+    UINT8*              pNewBuffer;
+
+    if (obdStoreInstance_l.pWriteBuffer == NULL)
+        return kEplObdAccessViolation;
+
+    recordSize = sizeof(tObdStoreRecord) + OBDSTORE_ALIGN(pCbStoreParam_p->objSize);
+    if (obdStoreInstance_l.writeSize + recordSize > obdStoreInstance_l.writeBufferSize)
+    {
+        newSize = obdStoreInstance_l.writeBufferSize * 2;
+        while (obdStoreInstance_l.writeSize + recordSize > newSize)
+            newSize *= 2;
+
+        pNewBuffer = (UINT8*)EPL_MALLOC(newSize);
+        if (pNewBuffer == NULL)
+        {
+            obdStoreInstance_l.fWriteFailed = TRUE;
+            return kEplObdOutOfMemory;
+        }
+
+        EPL_MEMCPY(pNewBuffer, obdStoreInstance_l.pWriteBuffer, obdStoreInstance_l.writeSize);
+        EPL_FREE(obdStoreInstance_l.pWriteBuffer);
+        obdStoreInstance_l.pWriteBuffer = pNewBuffer;
+        obdStoreInstance_l.writeBufferSize = newSize;
+    }
+
+    pRecord = (tObdStoreRecord*)(obdStoreInstance_l.pWriteBuffer + obdStoreInstance_l.writeSize);
+    EPL_MEMSET(pRecord, 0, recordSize);
+    pRecord->index = (UINT16)pCbStoreParam_p->index;
+    pRecord->subIndex = (UINT8)pCbStoreParam_p->subIndex;
+    pRecord->size = (UINT32)pCbStoreParam_p->objSize;
+    EPL_MEMCPY(pRecord + 1, pCbStoreParam_p->pData, pCbStoreParam_p->objSize);
+
+    obdStoreInstance_l.writeSize += recordSize;
+    obdStoreInstance_l.writeRecordCount++;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close image after writing
+
+The function completes the header of the image and writes the image into a
+temporary file. After the data is flushed to the disk the temporary file
+replaces the previous image of the OD partition. Therefore, either the old or
+the new image is found after a crash, but never a partially written one.
+
+\param  odPart_p            OD partition of the image.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel closeWrite(tObdPart odPart_p)
+{
+    tObdStoreHeader*    pHeader;
+    char                aFilename[PATH_MAX];
+    char                aTmpFilename[PATH_MAX];
+    UINT8*              pData;
+    size_t              remaining;
+    ssize_t             written;
+    int                 fd;
+    tEplKernel          ret;
+
+    if ((obdStoreInstance_l.pWriteBuffer == NULL) || obdStoreInstance_l.fWriteFailed)
+        return kEplSuccessful;      // discard the incomplete image, the error was already reported
+
+    ret = getFilename(odPart_p, aFilename, sizeof(aFilename));
+    if (ret != kEplSuccessful)
+        return ret;
+
+    if (snprintf(aTmpFilename, sizeof(aTmpFilename), "%s.tmp", aFilename) >= (int)sizeof(aTmpFilename))
+        return kEplObdAccessViolation;
+
+    pHeader = (tObdStoreHeader*)obdStoreInstance_l.pWriteBuffer;
+    pHeader->magic = OBDSTORE_IMAGE_MAGIC;
+    pHeader->version = OBDSTORE_IMAGE_VERSION;
+    pHeader->odPart = (UINT8)odPart_p;
+    pHeader->reserved = 0;
+    pHeader->recordCount = obdStoreInstance_l.writeRecordCount;
+    pHeader->dataSize = (UINT32)(obdStoreInstance_l.writeSize - sizeof(tObdStoreHeader));
+    pHeader->dataCrc = crc32_calc((UINT8*)(pHeader + 1), pHeader->dataSize);
+    pHeader->headerCrc = crc32_calc((UINT8*)pHeader, offsetof(tObdStoreHeader, headerCrc));
+
+    fd = open(aTmpFilename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() open %s failed (%d)\n", __func__, aTmpFilename, errno);
+        return kEplObdErrnoSet;
+    }
+
+    pData = obdStoreInstance_l.pWriteBuffer;
+    remaining = obdStoreInstance_l.writeSize;
+    while (remaining > 0)
+    {
+        written = write(fd, pData, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        pData += written;
+        remaining -= written;
+    }
+
+    if ((remaining != 0) || (fsync(fd) != 0))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() write %s failed (%d)\n", __func__, aTmpFilename, errno);
+        close(fd);
+        unlink(aTmpFilename);
+        return kEplObdErrnoSet;
+    }
+    close(fd);
+
+    if (rename(aTmpFilename, aFilename) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() rename %s failed (%d)\n", __func__, aTmpFilename, errno);
+        unlink(aTmpFilename);
+        return kEplObdErrnoSet;
+    }
+
+    // flush the directory entry of the renamed file
+    fd = open(obdStoreInstance_l.pStorePath, O_RDONLY);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open image for reading
+
+The function maps the image of the OD partition into memory and validates it.
+If no valid image exists, no object will be loaded.
+
+\param  odPart_p            OD partition of the image.
+
+\return The function returns a tEplKernel error code. kEplObdNoConfigData is
+        returned if no valid image exists.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel openRead(tObdPart odPart_p)
+{
+    char                aFilename[PATH_MAX];
+    struct stat         fileStat;
+    void*               pImage;
+    int                 fd;
+    tEplKernel          ret;
+
+    closeRead();
+
+    ret = getFilename(odPart_p, aFilename, sizeof(aFilename));
+    if (ret != kEplSuccessful)
+        return ret;
+
+    fd = open(aFilename, O_RDONLY);
+    if (fd < 0)
+    {
+        if (errno != ENOENT)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() open %s failed (%d)\n", __func__, aFilename, errno);
+        }
+        return kEplObdNoConfigData;
+    }
+
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size < (off_t)sizeof(tObdStoreHeader)))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() %s is not a valid image\n", __func__, aFilename);
+        close(fd);
+        return kEplObdNoConfigData;
+    }
+
+    pImage = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pImage == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mmap %s failed (%d)\n", __func__, aFilename, errno);
+        return kEplObdNoConfigData;
+    }
+
+    obdStoreInstance_l.pReadImage = (UINT8*)pImage;
+    obdStoreInstance_l.readImageSize = (size_t)fileStat.st_size;
+    obdStoreInstance_l.readOffset = sizeof(tObdStoreHeader);
+
+    if (!validateImage(odPart_p))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() %s is corrupted and ignored\n", __func__, aFilename);
+        closeRead();
+        return kEplObdNoConfigData;
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read object from image
+
+The function loads the object from the mapped image. The records are stored
+in the same order as the objects are loaded, so normally the next record
+belongs to the object. Records of objects which no longer exist are skipped.
+Objects which are not found in the image or whose size has changed keep their
+default values.
+
+\param  pCbStoreParam_p     Pointer to store callback parameters.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel readObject(tObdCbStoreParam MEM* pCbStoreParam_p)
+{
+    const tObdStoreRecord*  pRecord;
+    size_t                  offset;
+
+    if (obdStoreInstance_l.pReadImage == NULL)
+        return kEplSuccessful;
+
+    offset = obdStoreInstance_l.readOffset;
+    while (offset < obdStoreInstance_l.readImageSize)
+    {
+        // the record layout was checked by validateImage()
+        pRecord = (const tObdStoreRecord*)(obdStoreInstance_l.pReadImage + offset);
+        offset += sizeof(tObdStoreRecord) + OBDSTORE_ALIGN(pRecord->size);
+
+        if ((pRecord->index == pCbStoreParam_p->index) &&
+            (pRecord->subIndex == pCbStoreParam_p->subIndex))
+        {
+            if (pRecord->size == pCbStoreParam_p->objSize)
+                EPL_MEMCPY(pCbStoreParam_p->pData, pRecord + 1, pRecord->size);
+
+            obdStoreInstance_l.readOffset = offset;
+            break;
+        }
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close image after reading
+
+The function unmaps the image.
+*/
+//------------------------------------------------------------------------------
+static void closeRead(void)
+{
+    if (obdStoreInstance_l.pReadImage != NULL)
+    {
+        munmap(obdStoreInstance_l.pReadImage, obdStoreInstance_l.readImageSize);
+        obdStoreInstance_l.pReadImage = NULL;
+        obdStoreInstance_l.readImageSize = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear image
+
+The function deletes the image of the OD partition. Therefore, the objects
+are set to their default values on the next reset.
+
+\param  odPart_p            OD partition of the image.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel clearImage(tObdPart odPart_p)
+{
+    char                aFilename[PATH_MAX];
+    tEplKernel          ret;
+
+    ret = getFilename(odPart_p, aFilename, sizeof(aFilename));
+    if (ret != kEplSuccessful)
+        return ret;
+
+    if ((unlink(aFilename) != 0) && (errno != ENOENT))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() unlink %s failed (%d)\n", __func__, aFilename, errno);
+        return kEplObdErrnoSet;
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get image filename
+
+The function builds the filename of the image of the OD partition.
+
+\param  odPart_p            OD partition of the image.
+\param  pFilename_p         Buffer for the filename.
+\param  size_p              Size of the buffer.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel getFilename(tObdPart odPart_p, char* pFilename_p, size_t size_p)
+{
+    const char*     pPartName;
+    int             len;
+
+    switch (odPart_p)
+    {
+        case kObdPartGen:
+            pPartName = "gen";
+            break;
+
+        case kObdPartMan:
+            pPartName = "man";
+            break;
+
+        case kObdPartDev:
+            pPartName = "dev";
+            break;
+
+        case kObdPartUsr:
+            pPartName = "usr";
+            break;
+
+        default:
+            return kEplObdIllegalPart;
+    }
+
+    len = snprintf(pFilename_p, size_p, "%s/obd-%s.img", obdStoreInstance_l.pStorePath, pPartName);
+    if ((len < 0) || ((size_t)len >= size_p))
+        return kEplObdAccessViolation;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Validate image
+
+The function checks the header, the checksums and the record layout of the
+mapped image.
+
+\param  odPart_p            OD partition the image must belong to.
+
+\return The function returns TRUE if the image is valid, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL validateImage(tObdPart odPart_p)
+{
+    const tObdStoreHeader*  pHeader;
+    const tObdStoreRecord*  pRecord;
+    const UINT8*            pData;
+    size_t                  offset;
+    UINT32                  recordCount;
+
+    pHeader = (const tObdStoreHeader*)obdStoreInstance_l.pReadImage;
+    pData = (const UINT8*)(pHeader + 1);
+
+    if ((pHeader->magic != OBDSTORE_IMAGE_MAGIC) ||
+        (pHeader->version != OBDSTORE_IMAGE_VERSION) ||
+        (pHeader->odPart != (UINT8)odPart_p) ||
+        (pHeader->headerCrc != crc32_calc((const UINT8*)pHeader, offsetof(tObdStoreHeader, headerCrc))) ||
+        (pHeader->dataSize != obdStoreInstance_l.readImageSize - sizeof(tObdStoreHeader)) ||
+        (pHeader->dataCrc != crc32_calc(pData, pHeader->dataSize)))
+    {
+        return FALSE;
+    }
+
+    // check that all records are located within the image
+    offset = 0;
+    recordCount = 0;
+    while (offset < pHeader->dataSize)
+    {
+        if (pHeader->dataSize - offset < sizeof(tObdStoreRecord))
+            return FALSE;
+
+        pRecord = (const tObdStoreRecord*)(pData + offset);
+        offset += sizeof(tObdStoreRecord);
+        if (pHeader->dataSize - offset < OBDSTORE_ALIGN((size_t)pRecord->size))
+            return FALSE;
+
+        offset += OBDSTORE_ALIGN((size_t)pRecord->size);
+        recordCount++;
+    }
+
+    return (recordCount == pHeader->recordCount);
+}
+
+///\}
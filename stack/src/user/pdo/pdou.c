@@ -98,6 +98,9 @@ typedef struct
     tPdoMappObject*         paTxObject;                 ///< Pointer to TX channel objects
     BOOL                    fAllocated;                 ///< Flag determines if PDOs are allocated
     BOOL                    fRunning;                   ///< Flag determines if PDO engine is running
+    BYTE*                   pRxPdoShadow;               ///< Copy of the RXPDOs of the last change detecting exchange
+    size_t                  rxPdoShadowSize;            ///< Size of the RXPDO shadow buffer
+    BOOL                    fRxPdoShadowValid;          ///< Flag determines if the RXPDO shadow matches the channel setup
     //BYTE*                   pPdoMem;                    ///< pointer to PDO memory
 } tPdouInstance;
 
@@ -139,6 +142,9 @@ static UINT         calcPdoMemSize(tPdoChannelSetup* pPdoChannels_p, size_t* pRx
                                    size_t* pTxPdoMemSize_p);
 static tEplKernel   copyVarToPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p);
 static tEplKernel   copyVarFromPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p);
+static tEplKernel   copyRxPdoChannelToPi(UINT channelId_p, tPdoChannel* pPdoChannel_p,
+                                         BYTE* pPdo_p);
+static tEplKernel   setupRxPdoShadow(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -340,11 +346,32 @@ The function copies RXPDOs into the process image
 */
 //------------------------------------------------------------------------------
 tEplKernel pdou_copyRxPdoToPi (void)
+{
+    return pdou_copyRxPdoToPiNodes(NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy RXPDOs of selected nodes to process image
+
+The function copies the RXPDOs of the channels whose node ID is set in the
+supplied node bitmap into the process image. The mapped objects of all other
+channels are not touched. Therefore, the function can be called concurrently
+for disjoint sets of nodes.
+
+\param  pNodes_p            Pointer to node bitmap of EPL_API_NODE_BITMAP_SIZE
+                            bytes which selects the RXPDOs. If NULL, all
+                            RXPDOs are copied.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdou_copyRxPdoToPiNodes(BYTE* pNodes_p)
 {
     tEplKernel          Ret;
-    UINT                mappObjectCount;
     tPdoChannel*        pPdoChannel;
-    tPdoMappObject*     pMappObject;
     UINT                channelId;
     BYTE*               pPdo;
 
@@ -365,23 +392,99 @@ tEplKernel pdou_copyRxPdoToPi (void)
             continue;
         }
 
+        if ((pNodes_p != NULL) && !EPL_API_NODE_BITMAP_TEST(pNodes_p, pPdoChannel->nodeId))
+        {
+            continue;
+        }
+
         Ret = pdoucal_getRxPdo(&pPdo, channelId, pPdoChannel->pdoSize);
 
         //TRACE ("%s() Channel:%d Node:%d pPdo:%p\n", __func__, channelId, pPdoChannel->nodeId, pPdo);
 
-        for (mappObjectCount = pPdoChannel->mappObjectCount,
-             pMappObject = pdouInstance_g.paRxObject + (channelId * EPL_D_PDO_RPDOChannelObjects_U8);
-             mappObjectCount > 0;
-             mappObjectCount--, pMappObject++)
+        Ret = copyRxPdoChannelToPi(channelId, pPdoChannel, pPdo);
+        if (Ret != kEplSuccessful)
+        {   // other fatal error occurred
+            return Ret;
+        }
+    }
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy changed RXPDOs to process image
+
+The function copies the RXPDOs whose contents changed since the last call into
+the process image. The RXPDOs of the other channels are not copied because the
+process image still contains their data. For every copied RXPDO the bit of
+the node ID of its channel is set in the supplied node bitmap. On the first
+call and after the PDOs were reconfigured all RXPDOs are copied.
+
+\param  pChangedNodes_p     Pointer to node bitmap of EPL_API_NODE_BITMAP_SIZE
+                            bytes which receives the changed RXPDOs.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdou_copyChangedRxPdoToPi(BYTE* pChangedNodes_p)
+{
+    tEplKernel          ret;
+    tPdoChannel*        pPdoChannel;
+    UINT                channelId;
+    BYTE*               pPdo;
+    BYTE*               pShadow;
+    BOOL                fCopyAll;
+
+    EPL_MEMSET(pChangedNodes_p, 0, EPL_API_NODE_BITMAP_SIZE);
+
+    if (!pdouInstance_g.fRunning)
+    {
+        EPL_DBGLVL_PDO_TRACE ("%s() PDO channels not running!\n", __func__);
+        return kEplSuccessful;
+    }
+
+    fCopyAll = !pdouInstance_g.fRxPdoShadowValid;
+    if (fCopyAll)
+    {
+        ret = setupRxPdoShadow();
+        if (ret != kEplSuccessful)
+            return ret;
+    }
+
+    // the shadow contains the valid channels one after another
+    pShadow = pdouInstance_g.pRxPdoShadow;
+    for (channelId = 0;
+         channelId < pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+         channelId++)
+    {
+        pPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[channelId];
+
+        if (pPdoChannel->nodeId == PDO_INVALID_NODE_ID)
         {
-            Ret = copyVarFromPdo(pPdo, pMappObject);
-            if (Ret != kEplSuccessful)
-            {   // other fatal error occurred
-                return Ret;
-            }
+            continue;
+        }
+
+        ret = pdoucal_getRxPdo(&pPdo, channelId, pPdoChannel->pdoSize);
+        if (ret != kEplSuccessful)
+            return ret;
 
+        if (fCopyAll || (EPL_MEMCMP(pShadow, pPdo, pPdoChannel->pdoSize) != 0))
+        {
+            EPL_MEMCPY(pShadow, pPdo, pPdoChannel->pdoSize);
+
+            ret = copyRxPdoChannelToPi(channelId, pPdoChannel, pPdo);
+            if (ret != kEplSuccessful)
+                return ret;
+
+            EPL_API_NODE_BITMAP_SET(pChangedNodes_p, pPdoChannel->nodeId);
         }
+
+        pShadow += pPdoChannel->pdoSize;
     }
+
+    pdouInstance_g.fRxPdoShadowValid = TRUE;
     return kEplSuccessful;
 }
 
@@ -398,6 +501,29 @@ The function copies the TXPDOs from the process image into the PDO buffers.
 */
 //------------------------------------------------------------------------------
 tEplKernel pdou_copyTxPdoFromPi (void)
+{
+    return pdou_copyTxPdoFromPiNodes(NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy TXPDOs of selected nodes from process image
+
+The function copies the TXPDOs of the channels whose node ID is set in the
+supplied node bitmap from the process image into the PDO buffers. The PDO
+buffers of all other channels are not touched. Therefore, the function can be
+called concurrently for disjoint sets of nodes.
+
+\param  pNodes_p            Pointer to node bitmap of EPL_API_NODE_BITMAP_SIZE
+                            bytes which selects the TXPDOs. If NULL, all
+                            TXPDOs are copied.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdou_copyTxPdoFromPiNodes(BYTE* pNodes_p)
 {
     tEplKernel          ret = kEplSuccessful;
     UINT                mappObjectCount;
@@ -424,6 +550,11 @@ tEplKernel pdou_copyTxPdoFromPi (void)
             continue;
         }
 
+        if ((pNodes_p != NULL) && !EPL_API_NODE_BITMAP_TEST(pNodes_p, pPdoChannel->nodeId))
+        {
+            continue;
+        }
+
         pPdo = pdoucal_getTxPdoAdrs(channelId);
         //TRACE ("%s() pPdo: %p\n", __func__, pPdo);
 
@@ -662,6 +793,7 @@ static tEplKernel allocatePdoChannels(tPdoAllocationParam* pAllocationParam_p)
     {
         pdouInstance_g.pdoChannels.pRxPdoChannel[index].nodeId = PDO_INVALID_NODE_ID;
     }
+    pdouInstance_g.fRxPdoShadowValid = FALSE;
 
     //--------------------------------------------------------------------------
     if (pdouInstance_g.pdoChannels.allocation.txPdoChannelCount != pAllocationParam_p->txPdoChannelCount)
@@ -750,6 +882,14 @@ static tEplKernel freePdoChannels(void)
         pdouInstance_g.paTxObject = NULL;
     }
 
+    if (pdouInstance_g.pRxPdoShadow != NULL)
+    {
+        EPL_FREE(pdouInstance_g.pRxPdoShadow);
+        pdouInstance_g.pRxPdoShadow = NULL;
+        pdouInstance_g.rxPdoShadowSize = 0;
+    }
+    pdouInstance_g.fRxPdoShadowValid = FALSE;
+
     return ret;
 }
 
@@ -1008,6 +1148,10 @@ static tEplKernel configurePdoChannel(tPdoChannelConf* pChannelConf_p)
         // Setup user channel configuration
         EPL_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof (tPdoChannel));
 
+        // the RXPDO shadow no longer matches the channel setup
+        if (!pChannelConf_p->fTx)
+            pdouInstance_g.fRxPdoShadowValid = FALSE;
+
         // TRACE ("postConfigureChannel: TX:%d channel:%d size:%d\n",
         //        pChannelConf_p->fTx, pChannelConf_p->channelId, pChannelConf_p->pdoChannel.pdoSize);
         ret = pdoucal_postConfigureChannel(pChannelConf_p);
@@ -1614,6 +1758,79 @@ static tEplKernel copyVarFromPdo(BYTE* pPayload_p, tPdoMappObject* pMappObject_p
     return Ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Copy RXPDO channel to process image
+
+The function copies all objects mapped to an RXPDO channel from the PDO into
+the process image.
+
+\param  channelId_p         ID of the RXPDO channel.
+\param  pPdoChannel_p       Pointer to the RXPDO channel.
+\param  pPdo_p              Pointer to the received PDO.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel copyRxPdoChannelToPi(UINT channelId_p, tPdoChannel* pPdoChannel_p,
+                                       BYTE* pPdo_p)
+{
+    tEplKernel          ret;
+    UINT                mappObjectCount;
+    tPdoMappObject*     pMappObject;
+
+    for (mappObjectCount = pPdoChannel_p->mappObjectCount,
+         pMappObject = pdouInstance_g.paRxObject + (channelId_p * EPL_D_PDO_RPDOChannelObjects_U8);
+         mappObjectCount > 0;
+         mappObjectCount--, pMappObject++)
+    {
+        ret = copyVarFromPdo(pPdo_p, pMappObject);
+        if (ret != kEplSuccessful)
+            return ret;
+    }
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Setup RXPDO shadow
+
+The function sets up the shadow buffer which keeps a copy of the valid RXPDO
+channels for the change detection. The buffer is enlarged if the channel setup
+needs more memory.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel setupRxPdoShadow(void)
+{
+    tPdoChannel*        pPdoChannel;
+    UINT                channelId;
+    size_t              shadowSize = 0;
+
+    for (channelId = 0, pPdoChannel = pdouInstance_g.pdoChannels.pRxPdoChannel;
+         channelId < pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+         channelId++, pPdoChannel++)
+    {
+        if (pPdoChannel->nodeId != PDO_INVALID_NODE_ID)
+            shadowSize += pPdoChannel->pdoSize;
+    }
+
+    if ((shadowSize > pdouInstance_g.rxPdoShadowSize) || (pdouInstance_g.pRxPdoShadow == NULL))
+    {
+        if (pdouInstance_g.pRxPdoShadow != NULL)
+            EPL_FREE(pdouInstance_g.pRxPdoShadow);
+
+        pdouInstance_g.rxPdoShadowSize = 0;
+        pdouInstance_g.pRxPdoShadow = (BYTE*)EPL_MALLOC(shadowSize + 1);
+        if (pdouInstance_g.pRxPdoShadow == NULL)
+            return kEplNoResource;
+        pdouInstance_g.rxPdoShadowSize = shadowSize;
+    }
+
+    return kEplSuccessful;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Calculate PDO memory size
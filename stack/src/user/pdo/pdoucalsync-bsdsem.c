@@ -173,6 +173,25 @@ tEplKernel pdoucal_waitSyncEvent(ULONG timeout_p)
         return kEplGeneralError;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get number of missed sync events
+
+The function returns the number of missed sync events. Missed sync events are
+not detected by this implementation.
+
+\param  pCount_p        Pointer to store the number of missed sync events.
+
+\return The function returns a tEplKernel error code.
+\retval kEplInvalidOperation   Missed sync events are not detected.
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdoucal_getMissedSyncCount(UINT32* pCount_p)
+{
+    *pCount_p = 0;
+    return kEplInvalidOperation;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
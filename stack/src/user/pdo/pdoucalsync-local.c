@@ -0,0 +1,350 @@
+/**
+********************************************************************************
+\file   pdoucalsync-local.c
+
+\brief  Sync implementation for the PDO user CAL module in a single process
+
+This file contains the sync implementation for the PDO user CAL module used
+if the kernel and the user part of the stack are located in the same process.
+The sync event of the kernel part only increments a sync counter and wakes up
+the waiting threads, it never waits for the application. The application
+waits for the sync event in its own thread with pdoucal_waitSyncEvent(). If a
+sync callback function is registered, the module creates a sync thread which
+waits for the sync events and calls the callback function. Sync events which
+are signaled while the application is still processing a previous one are
+counted as missed syncs.
+
+\ingroup module_pdoucal
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <pthread.h>
+#include <time.h>
+
+#include <EplInc.h>
+#include <pdo.h>
+#include <user/pdoucal.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define PDOUCAL_SYNC_THREAD_TIMEOUT     100000      ///< Timeout of the sync thread in us to check for termination
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Instance of the PDO user CAL sync module
+*/
+typedef struct
+{
+    pthread_mutex_t     mutex;              ///< Mutex protecting the sync counters
+    pthread_cond_t      syncCond;           ///< Condition signaled on every sync event
+    UINT32              syncCount;          ///< Number of signaled sync events
+    UINT32              consumedCount;      ///< Value of syncCount when the last sync was consumed
+    UINT32              missedSyncCount;    ///< Number of missed sync events
+    BOOL                fStop;              ///< Waiting threads shall terminate
+    tEplSyncCb          pfnSyncCb;          ///< Sync callback function of the application
+    pthread_t           syncThread;         ///< Thread calling the sync callback function
+    BOOL                fSyncThreadRunning; ///< Sync thread was created
+} tPdoucalSyncInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPdoucalSyncInstance     instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel waitSync(ULONG timeout_p);
+static void* syncThread(void* pArg_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize PDO user CAL sync module
+
+The function initializes the PDO user CAL sync module. If a sync callback
+function is specified, the sync thread which calls it is created.
+
+\param  pfnSyncCb_p             function that is called in case of sync event
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdoucal_initSync(tEplSyncCb pfnSyncCb_p)
+{
+    pthread_condattr_t      condAttr;
+
+    EPL_MEMSET(&instance_l, 0, sizeof(tPdoucalSyncInstance));
+    instance_l.pfnSyncCb = pfnSyncCb_p;
+
+    if (pthread_mutex_init(&instance_l.mutex, NULL) != 0)
+        return kEplNoResource;
+
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&instance_l.syncCond, &condAttr) != 0)
+    {
+        pthread_condattr_destroy(&condAttr);
+        pthread_mutex_destroy(&instance_l.mutex);
+        return kEplNoResource;
+    }
+    pthread_condattr_destroy(&condAttr);
+
+    if (pfnSyncCb_p != NULL)
+    {
+        if (pthread_create(&instance_l.syncThread, NULL, syncThread, NULL) != 0)
+        {
+            TRACE("%s() couldn't create sync thread!\n", __func__);
+            pthread_cond_destroy(&instance_l.syncCond);
+            pthread_mutex_destroy(&instance_l.mutex);
+            return kEplNoResource;
+        }
+        instance_l.fSyncThreadRunning = TRUE;
+
+        // the sync thread keeps the inherited scheduling unless configured
+        target_setThreadSchedParam(instance_l.syncThread, kEplThreadSyncUser, -1, 0);
+    }
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cleanup PDO user CAL sync module
+
+The function cleans up the PDO user CAL sync module. Waiting threads are
+released and the sync thread is terminated.
+*/
+//------------------------------------------------------------------------------
+void pdoucal_exitSync(void)
+{
+    pthread_mutex_lock(&instance_l.mutex);
+    instance_l.fStop = TRUE;
+    pthread_cond_broadcast(&instance_l.syncCond);
+    pthread_mutex_unlock(&instance_l.mutex);
+
+    if (instance_l.fSyncThreadRunning)
+    {
+        pthread_join(instance_l.syncThread, NULL);
+        instance_l.fSyncThreadRunning = FALSE;
+    }
+
+    pthread_cond_destroy(&instance_l.syncCond);
+    pthread_mutex_destroy(&instance_l.mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for a sync event
+
+The function waits for a sync event. If a sync event has been signaled since
+the last call, it returns immediately. If it is called by the sync callback
+function, it returns immediately because the sync thread has already waited
+for the sync event.
+
+\param  timeout_p       Specifies a timeout in microseconds. If 0 it waits
+                        forever.
+
+\return The function returns a tEplKernel error code.
+\retval kEplSuccessful      Successfully received sync event
+\retval kEplGeneralError    Error while waiting on sync event
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdoucal_waitSyncEvent(ULONG timeout_p)
+{
+    if (instance_l.fSyncThreadRunning &&
+        pthread_equal(pthread_self(), instance_l.syncThread))
+        return kEplSuccessful;
+
+    return waitSync(timeout_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal a sync event
+
+The function is called by the kernel part of the stack on every sync event.
+It wakes up the threads waiting for the sync event and returns without
+waiting for the application.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdoucal_callSyncCb(void)
+{
+    pthread_mutex_lock(&instance_l.mutex);
+    instance_l.syncCount++;
+    pthread_cond_broadcast(&instance_l.syncCond);
+    pthread_mutex_unlock(&instance_l.mutex);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get number of missed sync events
+
+The function returns the number of sync events which have been signaled while
+the application was still processing a previous sync event.
+
+\param  pCount_p        Pointer to store the number of missed sync events.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdoucal_getMissedSyncCount(UINT32* pCount_p)
+{
+    pthread_mutex_lock(&instance_l.mutex);
+    *pCount_p = instance_l.missedSyncCount;
+    pthread_mutex_unlock(&instance_l.mutex);
+
+    return kEplSuccessful;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for a sync event
+
+The function waits until a sync event has been signaled since the last sync
+event was consumed. All sync events signaled additionally are counted as
+missed.
+
+\param  timeout_p       Specifies a timeout in microseconds. If 0 it waits
+                        forever.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel waitSync(ULONG timeout_p)
+{
+    struct timespec     timeout;
+    struct timespec     curTime;
+    UINT32              pending;
+    int                 ret = 0;
+
+    if (timeout_p != 0)
+    {
+        timeout.tv_sec = timeout_p / 1000000;
+        timeout.tv_nsec = (timeout_p % 1000000) * 1000;
+        clock_gettime(CLOCK_MONOTONIC, &curTime);
+        TIMESPECADD(&timeout, &curTime);
+    }
+
+    pthread_mutex_lock(&instance_l.mutex);
+
+    while ((instance_l.syncCount == instance_l.consumedCount) &&
+           !instance_l.fStop && (ret == 0))
+    {
+        if (timeout_p != 0)
+            ret = pthread_cond_timedwait(&instance_l.syncCond, &instance_l.mutex, &timeout);
+        else
+            ret = pthread_cond_wait(&instance_l.syncCond, &instance_l.mutex);
+    }
+
+    if (instance_l.syncCount == instance_l.consumedCount)
+    {   // timeout, error or termination
+        pthread_mutex_unlock(&instance_l.mutex);
+        return kEplGeneralError;
+    }
+
+    pending = instance_l.syncCount - instance_l.consumedCount;
+    if (pending > 1)
+    {
+        instance_l.missedSyncCount += pending - 1;
+        EPL_DBGLVL_PDO_TRACE("%s() missed %u sync events\n", __func__, (UINT)(pending - 1));
+    }
+    instance_l.consumedCount = instance_l.syncCount;
+
+    pthread_mutex_unlock(&instance_l.mutex);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Sync thread
+
+The thread waits for sync events and calls the sync callback function of the
+application.
+
+\param  pArg_p          Thread argument, not used.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* syncThread(void* pArg_p)
+{
+    UNUSED_PARAMETER(pArg_p);
+
+    while (!instance_l.fStop)
+    {
+        if (waitSync(PDOUCAL_SYNC_THREAD_TIMEOUT) == kEplSuccessful)
+            instance_l.pfnSyncCb();
+    }
+
+    return NULL;
+}
+
+/// \}
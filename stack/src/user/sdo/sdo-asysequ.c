@@ -846,6 +846,49 @@ tEplKernel PUBLIC EplSdoAsySeqSetTimeout( DWORD Timeout_p )
     return  kEplSuccessful;
 }
 
+//---------------------------------------------------------------------------
+//
+// Function:    EplSdoAsySeqGetProtType
+//
+// Description: returns the protocol layer (UDP or ASnd) which is used
+//              by a connection
+//
+// Parameters:  SdoSeqConHdl_p  = handle of the connection
+//              pSdoType_p      = pointer to store the protocol layer
+//
+// Returns:     tEplKernel = errorcode
+//
+//---------------------------------------------------------------------------
+tEplKernel PUBLIC EplSdoAsySeqGetProtType(tSdoSeqConHdl SdoSeqConHdl_p,
+                                    tSdoType* pSdoType_p)
+{
+unsigned int        uiHandle;
+tEplAsySdoSeqCon*   pAsySdoSeqCon;
+
+    uiHandle = (SdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK);
+    if (uiHandle >= EPL_MAX_SDO_SEQ_CON)
+    {
+        return kEplSdoSeqInvalidHdl;
+    }
+
+    pAsySdoSeqCon = &AsySdoSequInstance_g.m_AsySdoConnection[uiHandle];
+    switch (pAsySdoSeqCon->m_ConHandle & SDO_ASY_HANDLE_MASK)
+    {
+        case SDO_UDP_HANDLE:
+            *pSdoType_p = kSdoTypeUdp;
+            break;
+
+        case SDO_ASND_HANDLE:
+            *pSdoType_p = kSdoTypeAsnd;
+            break;
+
+        default:
+            return kEplSdoSeqInvalidHdl;
+    }
+
+    return kEplSuccessful;
+}
+
 //=========================================================================//
 //                                                                         //
 //          P R I V A T E   F U N C T I O N S                              //
@@ -937,18 +980,20 @@ unsigned int        uiFreeEntries;
                     // set set send rcon to 0
                     pAsySdoSeqCon->m_bSendSeqNum = 0x00;
 
+                    // change state before sending, because the answer may be
+                    // received by another thread (e.g. UDP receive thread)
+                    pAsySdoSeqCon->m_SdoState = kEplAsySdoStateInit1;
+
                     Ret = EplSdoAsySeqSendIntern(pAsySdoSeqCon,
                                                  0,
                                                  NULL,
                                                  FALSE);
                     if(Ret != kEplSuccessful)
                     {
+                        pAsySdoSeqCon->m_SdoState = kEplAsySdoStateIdle;
                         goto Exit;
                     }
 
-                    // change state
-                    pAsySdoSeqCon->m_SdoState = kEplAsySdoStateInit1;
-
                     // set timer
                     Ret = EplSdoAsySeqSetTimer(pAsySdoSeqCon,
                             AsySdoSequInstance_g.m_SdoSequTimeout);
@@ -1760,6 +1805,13 @@ unsigned int        uiFreeEntries;
                     case 2:
                     {
                         // should be ack
+                        if ((uiDataSize_p <= EPL_SEQ_HEADER_SIZE)
+                            && (EplSdoAsyGetFreeEntriesFromHistory(pAsySdoSeqCon) == 0))
+                        {   // repeated ack which does not free the history
+                            // -> keep waiting, otherwise every repeated ack
+                            //    would trigger an additional frame
+                            break;
+                        }
                         // -> change to state kEplAsySdoStateConnected
                         pAsySdoSeqCon->m_SdoState = kEplAsySdoStateConnected;
                         // call Command Layer Cb
@@ -0,0 +1,719 @@
+/**
+********************************************************************************
+\file   sdo-batchu.c
+
+\brief  Implementation of SDO batch module
+
+This file contains the implementation of the SDO batch module. The module
+accepts lists of object accesses (batches), queues the accesses per node and
+transfers the queue of every node back-to-back over a single SDO command layer
+connection. The queues of different nodes are processed in parallel. The
+module reports every finished access and every finished batch by callback
+functions.
+
+\ingroup module_sdo_batchu
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <user/sdobatchu.h>
+#include <EplSdoAc.h>
+#include <obd.h>
+#include <user/EplSdoComu.h>
+
+#if defined(CONFIG_INCLUDE_CFM)
+#include <user/cfmu.h>
+#endif
+
+#if !defined(CONFIG_INCLUDE_SDOC)
+#error "SDO batch module needs openPOWERLINK module SDO client!"
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief Enumeration for node states
+
+The following enumeration lists all valid states of a node queue.
+*/
+typedef enum
+{
+    kSdoBatchNodeStateIdle      = 0x00,     ///< Queue is empty
+    kSdoBatchNodeStateWaiting,              ///< Queue is waiting for a free or idle SDO connection
+    kSdoBatchNodeStateRunning,              ///< First item of the queue is transferred
+} tSdoBatchNodeState;
+
+/**
+\brief Node queue
+
+The following structure defines the queue of batch items of one node.
+*/
+typedef struct
+{
+    tSdoBatchItem*          pFirst;         ///< First item of the queue, it is transferred if the node is running
+    tSdoBatchItem*          pLast;          ///< Last item of the queue
+    tSdoBatchNodeState      nodeState;      ///< State of the queue
+    tSdoComConHdl           sdoComConHdl;   ///< SDO connection used for the queue
+    tSdoType                sdoType;        ///< SDO type of the connection
+    BOOL                    fConOwned;      ///< Connection was defined by this module and is closed when the queue is empty
+    BOOL                    fProcessing;    ///< Queue is currently processed, prevents recursive processing
+} tSdoBatchNode;
+
+/**
+\brief SDO batch instance
+
+The following structure defines the instance of the SDO batch module.
+*/
+typedef struct
+{
+#if EPL_NMT_MAX_NODE_ID > 0
+    tSdoBatchNode           aNode[EPL_NMT_MAX_NODE_ID];
+#endif
+    UINT                    runningCount;   ///< Number of nodes with a running transfer
+    tSdoBatchCbItemFinished pfnCbItemFinished;
+    tSdoBatchCbFinished     pfnCbFinished;
+} tSdoBatchInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSdoBatchInstance    instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+#if EPL_NMT_MAX_NODE_ID > 0
+static tEplKernel processNode(UINT nodeId_p, tSdoBatchItem* pFinishedItem_p);
+static tEplKernel startTransfer(UINT nodeId_p, tSdoBatchItem* pItem_p);
+static tEplKernel closeConnection(tSdoBatchNode* pNode_p);
+static tEplKernel cbSdoCon(tSdoComFinished* pSdoComFinished_p);
+#endif
+static tEplKernel finishItem(tSdoBatchItem* pItem_p, BOOL fReport_p);
+static void       accessLocalObd(tSdoBatchItem* pItem_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Init SDO batch module
+
+The function initializes the SDO batch module.
+
+\param  pfnCbItemFinished_p     Pointer to callback function for finished items.
+\param  pfnCbFinished_p         Pointer to callback function for finished
+                                batches.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_sdo_batchu
+*/
+//------------------------------------------------------------------------------
+tEplKernel sdobatchu_init(tSdoBatchCbItemFinished pfnCbItemFinished_p,
+                          tSdoBatchCbFinished pfnCbFinished_p)
+{
+    EPL_MEMSET(&instance_l, 0, sizeof(tSdoBatchInstance));
+
+    instance_l.pfnCbItemFinished = pfnCbItemFinished_p;
+    instance_l.pfnCbFinished = pfnCbFinished_p;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Exit SDO batch module
+
+The function deinitializes the SDO batch module. Connections defined by the
+module are closed, pending batches are dropped without further notification.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_sdo_batchu
+*/
+//------------------------------------------------------------------------------
+tEplKernel sdobatchu_exit(void)
+{
+#if EPL_NMT_MAX_NODE_ID > 0
+    UINT            nodeId;
+    tSdoBatchNode*  pNode;
+
+    for (nodeId = 1; nodeId <= EPL_NMT_MAX_NODE_ID; nodeId++)
+    {
+        pNode = &instance_l.aNode[nodeId - 1];
+        if (pNode->fConOwned)
+            EplSdoComUndefineCon(pNode->sdoComConHdl);
+    }
+#endif
+
+    EPL_MEMSET(&instance_l, 0, sizeof(tSdoBatchInstance));
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start an SDO batch
+
+The function starts the processing of the specified batch. Items addressing
+the local node are executed immediately. All other items are appended to the
+queue of their node. The queue of every node is processed over a single SDO
+connection; the next item of a node is started as soon as the previous one
+is finished.
+
+Items which fail before their transfer could be started are reported by the
+finished item callback like any other item. Therefore the callbacks may be
+called before the function returns.
+
+\param  pBatch_p            Pointer to the batch. The batch and its items must
+                            remain valid until the batch is finished.
+
+\return The function returns a tEplKernel error code.
+\retval kEplSuccessful          All items addressed the local node and are
+                                finished.
+\retval kEplApiTaskDeferred     The batch has been queued. The batch callback
+                                is called when all items are finished.
+\retval kEplApiInvalidParam     The batch or one of its items is invalid or
+                                the batch is already active.
+
+\ingroup module_sdo_batchu
+*/
+//------------------------------------------------------------------------------
+tEplKernel sdobatchu_start(tSdoBatch* pBatch_p)
+{
+    tEplKernel          ret = kEplSuccessful;
+    tSdoBatchItem*      pItem;
+#if EPL_NMT_MAX_NODE_ID > 0
+    tSdoBatchNode*      pNode;
+#endif
+    UINT                localNodeId;
+    UINT                remoteCount;
+    UINT                i;
+
+    if ((pBatch_p == NULL) || (pBatch_p->pItems == NULL) ||
+        (pBatch_p->itemCount == 0) || pBatch_p->fActive)
+        return kEplApiInvalidParam;
+
+    // without MN or cross-traffic support only the local node is accessible
+    localNodeId = obd_getNodeId();
+    for (i = 0; i < pBatch_p->itemCount; i++)
+    {
+        pItem = &pBatch_p->pItems[i];
+        if ((pItem->index == 0) || (pItem->pData == NULL) || (pItem->size == 0) ||
+            ((pItem->nodeId > EPL_NMT_MAX_NODE_ID) && (pItem->nodeId != localNodeId)))
+            return kEplApiInvalidParam;
+    }
+
+    pBatch_p->finishedCount = 0;
+    pBatch_p->errorCount = 0;
+
+    remoteCount = 0;
+    for (i = 0; i < pBatch_p->itemCount; i++)
+    {
+        pItem = &pBatch_p->pItems[i];
+        pItem->pBatch = pBatch_p;
+        pItem->pNext = NULL;
+        pItem->ret = kEplSuccessful;
+        pItem->sdoComConState = kEplSdoComTransferNotActive;
+        pItem->abortCode = 0;
+
+        if ((pItem->nodeId == 0) || (pItem->nodeId == localNodeId))
+        {
+            accessLocalObd(pItem);
+            finishItem(pItem, FALSE);
+            continue;
+        }
+
+#if EPL_NMT_MAX_NODE_ID > 0
+        remoteCount++;
+        pNode = &instance_l.aNode[pItem->nodeId - 1];
+        if (pNode->pLast == NULL)
+            pNode->pFirst = pItem;
+        else
+            pNode->pLast->pNext = pItem;
+        pNode->pLast = pItem;
+        if (pNode->nodeState == kSdoBatchNodeStateIdle)
+            pNode->nodeState = kSdoBatchNodeStateWaiting;
+#endif
+    }
+
+    if (remoteCount == 0)
+        return kEplSuccessful;
+
+    pBatch_p->fActive = TRUE;
+
+    // start all nodes which are not yet transferring
+    ret = sdobatchu_resume();
+    if (ret != kEplSuccessful)
+        return ret;
+
+    return kEplApiTaskDeferred;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Abort an SDO batch
+
+The function aborts all items of the specified batch which are not finished
+yet. Queued items are finished with state kEplSdoComTransferTxAborted, running
+transfers are aborted with the abort code
+EPL_SDOAC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL. The finished batch is reported
+by the batch callback as usual.
+
+\param  pBatch_p            Pointer to the batch to abort.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_sdo_batchu
+*/
+//------------------------------------------------------------------------------
+tEplKernel sdobatchu_abort(tSdoBatch* pBatch_p)
+{
+    tEplKernel          ret = kEplSuccessful;
+#if EPL_NMT_MAX_NODE_ID > 0
+    tSdoBatchNode*      pNode;
+    tSdoBatchItem*      pItem;
+    tSdoBatchItem**     ppPrev;
+    tSdoBatchItem*      pPrevItem;
+    UINT                nodeId;
+#endif
+
+    if (pBatch_p == NULL)
+        return kEplApiInvalidParam;
+
+    if (!pBatch_p->fActive)
+        return kEplSuccessful;
+
+#if EPL_NMT_MAX_NODE_ID > 0
+    for (nodeId = 1; nodeId <= EPL_NMT_MAX_NODE_ID; nodeId++)
+    {
+        pNode = &instance_l.aNode[nodeId - 1];
+
+        // remove all queued items of the batch, a running item stays in the queue
+        ppPrev = &pNode->pFirst;
+        pPrevItem = NULL;
+        if ((pNode->nodeState == kSdoBatchNodeStateRunning) && (pNode->pFirst != NULL))
+        {
+            pPrevItem = pNode->pFirst;
+            ppPrev = &pPrevItem->pNext;
+        }
+
+        while ((pItem = *ppPrev) != NULL)
+        {
+            if (pItem->pBatch != pBatch_p)
+            {
+                pPrevItem = pItem;
+                ppPrev = &pItem->pNext;
+                continue;
+            }
+
+            *ppPrev = pItem->pNext;
+            if (pNode->pLast == pItem)
+                pNode->pLast = pPrevItem;
+            pItem->pNext = NULL;
+            pItem->sdoComConState = kEplSdoComTransferTxAborted;
+            pItem->abortCode = EPL_SDOAC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL;
+            finishItem(pItem, TRUE);
+        }
+
+        // The connection of a waiting node is kept open because a transfer of
+        // the application may still be running on it. It is reused by the
+        // next batch for the node or closed by sdobatchu_exit().
+        if ((pNode->pFirst == NULL) && (pNode->nodeState == kSdoBatchNodeStateWaiting))
+            pNode->nodeState = kSdoBatchNodeStateIdle;
+    }
+
+    // abort running transfers, they are finished by the SDO callback
+    for (nodeId = 1; nodeId <= EPL_NMT_MAX_NODE_ID; nodeId++)
+    {
+        pNode = &instance_l.aNode[nodeId - 1];
+        if ((pNode->nodeState == kSdoBatchNodeStateRunning) &&
+            (pNode->pFirst != NULL) && (pNode->pFirst->pBatch == pBatch_p))
+        {
+            ret = EplSdoComSdoAbort(pNode->sdoComConHdl, EPL_SDOAC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL);
+            if (ret != kEplSuccessful)
+                break;
+        }
+    }
+#endif
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Resume waiting node queues
+
+The function tries to start the transfers of all node queues which are
+waiting for a free or idle SDO connection. It must be called whenever an SDO
+connection which is not controlled by this module becomes idle.
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_sdo_batchu
+*/
+//------------------------------------------------------------------------------
+tEplKernel sdobatchu_resume(void)
+{
+    tEplKernel          ret = kEplSuccessful;
+#if EPL_NMT_MAX_NODE_ID > 0
+    tEplKernel          retNode;
+    tSdoBatchNode*      pNode;
+    UINT                nodeId;
+
+    for (nodeId = 1; nodeId <= EPL_NMT_MAX_NODE_ID; nodeId++)
+    {
+        pNode = &instance_l.aNode[nodeId - 1];
+        if ((pNode->nodeState != kSdoBatchNodeStateWaiting) || pNode->fProcessing)
+            continue;
+
+        retNode = processNode(nodeId, NULL);
+        if (ret == kEplSuccessful)
+            ret = retNode;
+    }
+#endif
+    return ret;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+#if EPL_NMT_MAX_NODE_ID > 0
+//------------------------------------------------------------------------------
+/**
+\brief  Process the queue of a node
+
+The function finishes the specified item of the node queue and starts the
+transfer of the next queued item. Items which cannot be started are finished
+with an error until a transfer is running or the queue is empty.
+
+\param  nodeId_p            Node ID of the queue to process.
+\param  pFinishedItem_p     Pointer to the finished first item of the queue.
+                            NULL if no item is finished.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel processNode(UINT nodeId_p, tSdoBatchItem* pFinishedItem_p)
+{
+    tEplKernel          ret = kEplSuccessful;
+    tEplKernel          retItem;
+    tSdoBatchNode*      pNode = &instance_l.aNode[nodeId_p - 1];
+    tSdoBatchItem*      pItem;
+
+    pNode->fProcessing = TRUE;
+
+    if (pFinishedItem_p != NULL)
+    {
+        pNode->pFirst = pFinishedItem_p->pNext;
+        if (pNode->pFirst == NULL)
+            pNode->pLast = NULL;
+        pFinishedItem_p->pNext = NULL;
+        pNode->nodeState = kSdoBatchNodeStateWaiting;
+        ret = finishItem(pFinishedItem_p, TRUE);
+    }
+
+    while (((pItem = pNode->pFirst) != NULL) &&
+           (pNode->nodeState == kSdoBatchNodeStateWaiting))
+    {
+        retItem = startTransfer(nodeId_p, pItem);
+        if (retItem == kEplSuccessful)
+        {
+            pNode->nodeState = kSdoBatchNodeStateRunning;
+            instance_l.runningCount++;
+            break;
+        }
+
+        if (retItem == kEplSdoComHandleBusy)
+        {   // shared connection is used by the application, wait until it is idle
+            break;
+        }
+
+        if ((retItem == kEplSdoComNoFreeHandle) && (instance_l.runningCount > 0))
+        {   // wait until another node releases its connection
+            break;
+        }
+
+        // the item cannot be transferred
+        pNode->pFirst = pItem->pNext;
+        if (pNode->pFirst == NULL)
+            pNode->pLast = NULL;
+        pItem->pNext = NULL;
+        pItem->ret = retItem;
+        retItem = finishItem(pItem, TRUE);
+        if (ret == kEplSuccessful)
+            ret = retItem;
+    }
+
+    if ((pNode->pFirst == NULL) && (pNode->nodeState != kSdoBatchNodeStateRunning))
+    {
+        pNode->nodeState = kSdoBatchNodeStateIdle;
+        if (pNode->fConOwned)
+        {
+            closeConnection(pNode);
+            pNode->fProcessing = FALSE;
+            // the released connection may be used by a waiting node
+            retItem = sdobatchu_resume();
+            if (ret == kEplSuccessful)
+                ret = retItem;
+            return ret;
+        }
+    }
+
+    pNode->fProcessing = FALSE;
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start the transfer of a batch item
+
+The function defines the SDO connection of the node if necessary and starts
+the transfer of the specified item.
+
+\param  nodeId_p            Node ID of the item.
+\param  pItem_p             Pointer to the item to transfer.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel startTransfer(UINT nodeId_p, tSdoBatchItem* pItem_p)
+{
+    tEplKernel                  ret;
+    tSdoBatchNode*              pNode = &instance_l.aNode[nodeId_p - 1];
+    tSdoComConHdl               sdoComConHdl;
+    tSdoComTransParamByIndex    transParamByIndex;
+
+#if defined(CONFIG_INCLUDE_CFM)
+    if (cfmu_isSdoRunning(nodeId_p))
+        return kEplApiSdoBusyIntern;
+#endif
+
+    if (pNode->fConOwned && (pNode->sdoType != pItem_p->pBatch->sdoType))
+        closeConnection(pNode);
+
+    if (!pNode->fConOwned)
+    {
+        ret = EplSdoComDefineCon(&sdoComConHdl, nodeId_p, pItem_p->pBatch->sdoType);
+        if ((ret != kEplSuccessful) && (ret != kEplSdoComHandleExists))
+            return ret;
+
+        pNode->sdoComConHdl = sdoComConHdl;
+        pNode->sdoType = pItem_p->pBatch->sdoType;
+        pNode->fConOwned = (ret == kEplSuccessful);
+    }
+
+    transParamByIndex.sdoComConHdl = pNode->sdoComConHdl;
+    transParamByIndex.index = pItem_p->index;
+    transParamByIndex.subindex = pItem_p->subindex;
+    transParamByIndex.pData = pItem_p->pData;
+    transParamByIndex.dataSize = pItem_p->size;
+    transParamByIndex.timeout = 0;
+    transParamByIndex.sdoAccessType = pItem_p->sdoAccessType;
+    transParamByIndex.pfnSdoFinishedCb = cbSdoCon;
+    transParamByIndex.pUserArg = pItem_p;
+
+    ret = EplSdoComInitTransferByIndex(&transParamByIndex);
+    if (ret == kEplSuccessful)
+        pItem_p->sdoComConState = kEplSdoComTransferRunning;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close SDO connection of a node
+
+The function closes the SDO connection of the node if it was defined by this
+module.
+
+\param  pNode_p             Pointer to the node queue.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel closeConnection(tSdoBatchNode* pNode_p)
+{
+    tEplKernel      ret = kEplSuccessful;
+
+    if (pNode_p->fConOwned)
+    {
+        ret = EplSdoComUndefineCon(pNode_p->sdoComConHdl);
+        pNode_p->fConOwned = FALSE;
+    }
+    return ret;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish a batch item
+
+The function updates the counters of the batch the item belongs to and
+reports the finished item and the finished batch.
+
+\param  pItem_p             Pointer to the finished item.
+\param  fReport_p           Report the item by the item callback if requested
+                            by the batch.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel finishItem(tSdoBatchItem* pItem_p, BOOL fReport_p)
+{
+    tEplKernel      ret = kEplSuccessful;
+    tSdoBatch*      pBatch = pItem_p->pBatch;
+
+    pBatch->finishedCount++;
+    if ((pItem_p->ret != kEplSuccessful) ||
+        (pItem_p->sdoComConState != kEplSdoComTransferFinished))
+        pBatch->errorCount++;
+
+    if (fReport_p && pBatch->fItemEvents && (instance_l.pfnCbItemFinished != NULL))
+        ret = instance_l.pfnCbItemFinished(pItem_p);
+
+    if (pBatch->fActive && (pBatch->finishedCount == pBatch->itemCount))
+    {
+        pBatch->fActive = FALSE;
+        if (instance_l.pfnCbFinished != NULL)
+        {
+            if (ret == kEplSuccessful)
+                ret = instance_l.pfnCbFinished(pBatch);
+            else
+                instance_l.pfnCbFinished(pBatch);
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Access local object dictionary
+
+The function executes a batch item which addresses the local node.
+
+\param  pItem_p             Pointer to the item.
+*/
+//------------------------------------------------------------------------------
+static void accessLocalObd(tSdoBatchItem* pItem_p)
+{
+    tObdSize        obdSize;
+
+    if (pItem_p->sdoAccessType == kSdoAccessTypeRead)
+    {
+        obdSize = (tObdSize)pItem_p->size;
+        pItem_p->ret = obd_readEntryToLe(pItem_p->index, pItem_p->subindex,
+                                         pItem_p->pData, &obdSize);
+        pItem_p->size = (UINT)obdSize;
+    }
+    else
+    {
+        pItem_p->ret = obd_writeEntryFromLe(pItem_p->index, pItem_p->subindex,
+                                            pItem_p->pData, (tObdSize)pItem_p->size);
+    }
+
+    pItem_p->sdoComConState = (pItem_p->ret == kEplSuccessful) ?
+                              kEplSdoComTransferFinished : kEplSdoComTransferTxAborted;
+}
+
+#if EPL_NMT_MAX_NODE_ID > 0
+//------------------------------------------------------------------------------
+/**
+\brief  SDO callback function
+
+The function is called by the SDO command layer when the transfer of a batch
+item is finished. It stores the result in the item and continues with the
+next item of the node.
+
+\param  pSdoComFinished_p   Pointer to information about the finished transfer.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbSdoCon(tSdoComFinished* pSdoComFinished_p)
+{
+    tSdoBatchItem*      pItem = (tSdoBatchItem*)pSdoComFinished_p->pUserArg;
+    tSdoBatchNode*      pNode;
+
+    if ((pItem == NULL) || (pItem->nodeId == 0) || (pItem->nodeId > EPL_NMT_MAX_NODE_ID))
+        return kEplInvalidNodeId;
+
+    pNode = &instance_l.aNode[pItem->nodeId - 1];
+    if ((pNode->nodeState != kSdoBatchNodeStateRunning) || (pNode->pFirst != pItem))
+        return kEplInvalidOperation;
+
+    pItem->sdoComConState = pSdoComFinished_p->sdoComConState;
+    pItem->abortCode = pSdoComFinished_p->abortCode;
+    pItem->size = pSdoComFinished_p->transferredBytes;
+
+    instance_l.runningCount--;
+
+    if (pSdoComFinished_p->sdoComConState == kEplSdoComTransferLowerLayerAbort)
+    {   // the connection is broken, a new one is defined for the next item
+        closeConnection(pNode);
+    }
+
+    return processNode(pItem->nodeId, pItem);
+}
+#endif
+
+/// \}
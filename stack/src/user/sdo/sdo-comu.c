@@ -70,6 +70,10 @@
 
 #include "user/EplSdoComu.h"
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+#include "user/identu.h"
+#endif
+
 #if ((((EPL_MODULE_INTEGRATION) & (EPL_MODULE_SDOS)) == 0) &&\
      (((EPL_MODULE_INTEGRATION) & (EPL_MODULE_SDOC)) == 0)   )
 
@@ -175,6 +179,7 @@ typedef struct
     tSdoTransType    m_SdoTransType;     // Auto, Expedited, Segmented
     tSdoServiceType  m_SdoServiceType;   // WriteByIndex, ReadByIndex
     tSdoType         m_SdoProtType;      // protocol layer: Auto, Udp, Asnd, Pdo
+    unsigned int        m_uiSegmentSize;    // segment size of the transfer
     BYTE*               m_pData;            // pointer to data
     unsigned int        m_uiTransSize;      // number of bytes
                                             // to transfer
@@ -238,6 +243,8 @@ static tEplKernel EplSdoComTransferFinished(tSdoComConHdl   SdoComCon_p,
                                             tEplSdoComCon*     pSdoComCon_p,
                                             tSdoComConState SdoComConState_p);
 
+static unsigned int EplSdoComCalcSegmentSize(tEplSdoComCon* pSdoComCon_p);
+
 #if(((EPL_MODULE_INTEGRATION) & (EPL_MODULE_SDOS)) != 0)
 static tEplKernel EplSdoComServerInitReadByIndex(tEplSdoComCon*     pSdoComCon_p,
                                          tAsySdoCom*     pAsySdoCom_p);
@@ -607,6 +614,7 @@ tEplSdoComCon*  pSdoComCon;
     // reset parts of control structure
     pSdoComCon->m_dwLastAbortCode = 0;
     pSdoComCon->m_SdoTransType = kSdoTransAuto;
+    pSdoComCon->m_uiSegmentSize = EplSdoComCalcSegmentSize(pSdoComCon);
     // save timeout
     //pSdoComCon->m_uiTimeout = SdoComTransParam_p.timeout;
 
@@ -1991,7 +1999,8 @@ DWORD           dwAbortCode;
 
     // get size of object to see iof segmented or expedited transfer
     EntrySize = obd_getDataSize(uiIndex, uiSubindex);
-    if(EntrySize > SDO_MAX_SEGMENT_SIZE)
+    pSdoComCon_p->m_uiSegmentSize = EplSdoComCalcSegmentSize(pSdoComCon_p);
+    if(EntrySize > pSdoComCon_p->m_uiSegmentSize)
     {   // segmented transfer
         pSdoComCon_p->m_SdoTransType = kSdoTransSegmented;
         // get pointer to object-entry data
@@ -2148,26 +2157,26 @@ BYTE            bFlag;
                     // init data size in variable header, which includes itself
                     AmiSetDwordToLe(&pCommandFrame->m_le_abCommandData[0], pSdoComCon_p->m_uiTransSize + 4);
                     // copy data in frame
-                    EPL_MEMCPY(&pCommandFrame->m_le_abCommandData[4],pSdoComCon_p->m_pData, (SDO_MAX_SEGMENT_SIZE-4));
+                    EPL_MEMCPY(&pCommandFrame->m_le_abCommandData[4],pSdoComCon_p->m_pData, (pSdoComCon_p->m_uiSegmentSize - 4));
 
                     // correct byte-counter
-                    pSdoComCon_p->m_uiTransSize -= (SDO_MAX_SEGMENT_SIZE-4);
-                    pSdoComCon_p->m_uiTransferredByte += (SDO_MAX_SEGMENT_SIZE-4);
+                    pSdoComCon_p->m_uiTransSize -= (pSdoComCon_p->m_uiSegmentSize - 4);
+                    pSdoComCon_p->m_uiTransferredByte += (pSdoComCon_p->m_uiSegmentSize - 4);
                     // move data pointer
-                    pSdoComCon_p->m_pData +=(SDO_MAX_SEGMENT_SIZE-4);
+                    pSdoComCon_p->m_pData +=(pSdoComCon_p->m_uiSegmentSize - 4);
 
                     // set segment size
-                    AmiSetWordToLe(&pCommandFrame->m_le_wSegmentSize, SDO_MAX_SEGMENT_SIZE);
+                    AmiSetWordToLe(&pCommandFrame->m_le_wSegmentSize, pSdoComCon_p->m_uiSegmentSize);
 
                     // send frame
-                    uiSizeOfFrame += SDO_MAX_SEGMENT_SIZE;
+                    uiSizeOfFrame += pSdoComCon_p->m_uiSegmentSize;
                     Ret = EplSdoAsySeqSendData(pSdoComCon_p->m_SdoSeqConHdl,
                                                 uiSizeOfFrame,
                                                 pFrame);
 
                 }
                 else if((pSdoComCon_p->m_uiTransferredByte > 0)
-                    &&(pSdoComCon_p->m_uiTransSize > SDO_MAX_SEGMENT_SIZE))
+                    &&(pSdoComCon_p->m_uiTransSize > pSdoComCon_p->m_uiSegmentSize))
                 {   // segment
                     // set segment flag
                     bFlag = AmiGetByteFromLe( &pCommandFrame->m_le_bFlags);
@@ -2175,19 +2184,19 @@ BYTE            bFlag;
                     AmiSetByteToLe(&pCommandFrame->m_le_bFlags,  bFlag);
 
                     // copy data in frame
-                    EPL_MEMCPY(&pCommandFrame->m_le_abCommandData[0],pSdoComCon_p->m_pData, SDO_MAX_SEGMENT_SIZE);
+                    EPL_MEMCPY(&pCommandFrame->m_le_abCommandData[0],pSdoComCon_p->m_pData, pSdoComCon_p->m_uiSegmentSize);
 
                     // correct byte-counter
-                    pSdoComCon_p->m_uiTransSize -= SDO_MAX_SEGMENT_SIZE;
-                    pSdoComCon_p->m_uiTransferredByte += SDO_MAX_SEGMENT_SIZE;
+                    pSdoComCon_p->m_uiTransSize -= pSdoComCon_p->m_uiSegmentSize;
+                    pSdoComCon_p->m_uiTransferredByte += pSdoComCon_p->m_uiSegmentSize;
                     // move data pointer
-                    pSdoComCon_p->m_pData +=SDO_MAX_SEGMENT_SIZE;
+                    pSdoComCon_p->m_pData +=pSdoComCon_p->m_uiSegmentSize;
 
                     // set segment size
-                    AmiSetWordToLe(&pCommandFrame->m_le_wSegmentSize,SDO_MAX_SEGMENT_SIZE);
+                    AmiSetWordToLe(&pCommandFrame->m_le_wSegmentSize, pSdoComCon_p->m_uiSegmentSize);
 
                     // send frame
-                    uiSizeOfFrame += SDO_MAX_SEGMENT_SIZE;
+                    uiSizeOfFrame += pSdoComCon_p->m_uiSegmentSize;
                     Ret = EplSdoAsySeqSendData(pSdoComCon_p->m_SdoSeqConHdl,
                                                 uiSizeOfFrame,
                                                 pFrame);
@@ -2467,8 +2476,8 @@ BYTE*           pbSrcData;
         }
 
         uiBytesToTransfer = AmiGetWordFromLe(&pAsySdoCom_p->m_le_wSegmentSize);
-        // eleminate header (Command header (8) + variable part (4) + Command header (4))
-        uiBytesToTransfer -= 16;
+        // eleminate header (variable part (4) + Command header (4))
+        uiBytesToTransfer -= 8;
         // get pointer to object entry
         pSdoComCon_p->m_pData = obd_getObjectDataPtr(uiIndex,
                                                         uiSubindex);
@@ -2595,7 +2604,7 @@ BYTE*           pbPayload;
 
                 case kSdoServiceWriteByIndex:
                 {
-                    if(pSdoComCon_p->m_uiTransSize > (SDO_MAX_SEGMENT_SIZE - 4))
+                    if(pSdoComCon_p->m_uiTransSize > (pSdoComCon_p->m_uiSegmentSize - 4))
                     {   // segmented transfer
                         // -> variable part of header needed
                         // save that transfer is segmented
@@ -2606,7 +2615,7 @@ BYTE*           pbPayload;
                         // set pointer to real payload
                         pbPayload = &pCommandFrame->m_le_abCommandData[4];
                         // fill rest of header
-                        AmiSetWordToLe( &pCommandFrame->m_le_wSegmentSize, SDO_MAX_SEGMENT_SIZE);
+                        AmiSetWordToLe( &pCommandFrame->m_le_wSegmentSize, pSdoComCon_p->m_uiSegmentSize);
                         bFlags = 0x10;
                         AmiSetByteToLe( &pCommandFrame->m_le_bFlags, bFlags);
                         // create command header
@@ -2616,14 +2625,14 @@ BYTE*           pbPayload;
                         // on byte for reserved
                         pbPayload += 2;
                         // calc size
-                        uiSizeOfFrame += SDO_MAX_SEGMENT_SIZE;
+                        uiSizeOfFrame += pSdoComCon_p->m_uiSegmentSize;
 
                         // copy payload
-                        EPL_MEMCPY( pbPayload,pSdoComCon_p->m_pData,  (SDO_MAX_SEGMENT_SIZE - 8));
-                        pSdoComCon_p->m_pData += (SDO_MAX_SEGMENT_SIZE - 8);
+                        EPL_MEMCPY( pbPayload,pSdoComCon_p->m_pData,  (pSdoComCon_p->m_uiSegmentSize - 8));
+                        pSdoComCon_p->m_pData += (pSdoComCon_p->m_uiSegmentSize - 8);
                         // correct intern counter
-                        pSdoComCon_p->m_uiTransSize -= (SDO_MAX_SEGMENT_SIZE - 8);
-                        pSdoComCon_p->m_uiTransferredByte = (SDO_MAX_SEGMENT_SIZE - 8);
+                        pSdoComCon_p->m_uiTransSize -= (pSdoComCon_p->m_uiSegmentSize - 8);
+                        pSdoComCon_p->m_uiTransferredByte = (pSdoComCon_p->m_uiSegmentSize - 8);
 
                     }
                     else
@@ -2669,21 +2678,21 @@ BYTE*           pbPayload;
                 {   // send next frame
                     if(pSdoComCon_p->m_SdoTransType == kSdoTransSegmented)
                     {
-                        if(pSdoComCon_p->m_uiTransSize > SDO_MAX_SEGMENT_SIZE)
+                        if(pSdoComCon_p->m_uiTransSize > pSdoComCon_p->m_uiSegmentSize)
                         {   // next segment
                             pbPayload = &pCommandFrame->m_le_abCommandData[0];
                             // fill rest of header
-                            AmiSetWordToLe( &pCommandFrame->m_le_wSegmentSize, SDO_MAX_SEGMENT_SIZE);
+                            AmiSetWordToLe( &pCommandFrame->m_le_wSegmentSize, pSdoComCon_p->m_uiSegmentSize);
                             bFlags = 0x20;
                             AmiSetByteToLe( &pCommandFrame->m_le_bFlags, bFlags);
                             // copy data
-                            EPL_MEMCPY( pbPayload,pSdoComCon_p->m_pData,  SDO_MAX_SEGMENT_SIZE);
-                            pSdoComCon_p->m_pData += SDO_MAX_SEGMENT_SIZE;
+                            EPL_MEMCPY( pbPayload,pSdoComCon_p->m_pData,  pSdoComCon_p->m_uiSegmentSize);
+                            pSdoComCon_p->m_pData += pSdoComCon_p->m_uiSegmentSize;
                             // correct intern counter
-                            pSdoComCon_p->m_uiTransSize -= SDO_MAX_SEGMENT_SIZE;
-                            pSdoComCon_p->m_uiTransferredByte += SDO_MAX_SEGMENT_SIZE;
+                            pSdoComCon_p->m_uiTransSize -= pSdoComCon_p->m_uiSegmentSize;
+                            pSdoComCon_p->m_uiTransferredByte += pSdoComCon_p->m_uiSegmentSize;
                             // calc size
-                            uiSizeOfFrame += SDO_MAX_SEGMENT_SIZE;
+                            uiSizeOfFrame += pSdoComCon_p->m_uiSegmentSize;
 
 
                         }
@@ -2700,8 +2709,8 @@ BYTE*           pbPayload;
                             // calc size
                             uiSizeOfFrame += pSdoComCon_p->m_uiTransSize;
                             // correct intern counter
-                            pSdoComCon_p->m_uiTransSize = 0;
                             pSdoComCon_p->m_uiTransferredByte += pSdoComCon_p->m_uiTransSize;
+                            pSdoComCon_p->m_uiTransSize = 0;
 
                         }
                     }
@@ -3120,5 +3129,93 @@ tEplKernel      Ret;
     return Ret;
 }
 
+//---------------------------------------------------------------------------
+//
+// Function:        EplSdoComCalcSegmentSize
+//
+// Description:     calculates the segment size of a transfer from the MTU
+//                  of the protocol layer and the MTU of the peer.
+//                  ASnd uses the AsyncMTU of the local node, because it is
+//                  configured equally for all nodes. UDP uses the maximum
+//                  MTU of Ethernet if the peer reported its AsyncMTU in the
+//                  IdentResponse, otherwise the minimum MTU of IP.
+//
+// Parameters:      pSdoComCon_p     = pointer to control structure of connection
+//
+// Returns:         unsigned int = segment size
+//
+//
+// State:
+//
+//---------------------------------------------------------------------------
+static unsigned int EplSdoComCalcSegmentSize(tEplSdoComCon* pSdoComCon_p)
+{
+tSdoType            SdoProtType;
+unsigned int        uiMtu;
+unsigned int        uiPeerMtu;
+WORD                wAsyncMtu;
+tObdSize            ObdSize;
+#if defined(CONFIG_INCLUDE_NMT_MN)
+tEplIdentResponse*  pIdentResponse;
+#endif
+
+    SdoProtType = pSdoComCon_p->m_SdoProtType;
+    if (SdoProtType == kSdoTypeAuto)
+    {   // server connection -> ask sequence layer
+        if (EplSdoAsySeqGetProtType(pSdoComCon_p->m_SdoSeqConHdl, &SdoProtType) != kEplSuccessful)
+        {
+            return SDO_DEFAULT_SEGMENT_SIZE;
+        }
+    }
+
+    // get AsyncMTU of the peer from its IdentResponse (0 = unknown)
+    uiPeerMtu = 0;
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    if ((pSdoComCon_p->m_uiNodeId != 0) &&
+        (identu_getIdentResponse(pSdoComCon_p->m_uiNodeId, &pIdentResponse) == kEplSuccessful) &&
+        (pIdentResponse != NULL))
+    {
+        uiPeerMtu = AmiGetWordFromLe(&pIdentResponse->m_le_wMtu);
+    }
+#endif
+
+    switch (SdoProtType)
+    {
+        case kSdoTypeAsnd:
+        {
+            ObdSize = sizeof(wAsyncMtu);
+            if (obd_readEntry(0x1F98, 8, &wAsyncMtu, &ObdSize) != kEplSuccessful)
+            {
+                wAsyncMtu = EPL_C_DLL_MIN_ASYNC_MTU;
+            }
+            uiMtu = wAsyncMtu;
+            break;
+        }
+
+        case kSdoTypeUdp:
+        {
+            uiMtu = (uiPeerMtu != 0) ? EPL_C_DLL_MAX_ASYNC_MTU : EPL_C_IP_MIN_MTU;
+            break;
+        }
+
+        default:
+        {
+            return SDO_DEFAULT_SEGMENT_SIZE;
+        }
+    }
+
+    if ((uiPeerMtu != 0) && (uiPeerMtu < uiMtu))
+    {
+        uiMtu = uiPeerMtu;
+    }
+
+    if (uiMtu < (SDO_DEFAULT_SEGMENT_SIZE + SDO_SEGMENT_HEADER_SIZE))
+    {
+        return SDO_DEFAULT_SEGMENT_SIZE;
+    }
+
+    return min(uiMtu - SDO_SEGMENT_HEADER_SIZE, SDO_MAX_SEGMENT_SIZE);
+}
+
 // EOF
 
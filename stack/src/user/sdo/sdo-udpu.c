@@ -119,6 +119,7 @@ typedef struct
     tSdoUdpCon              aSdoAbsUdpConnection[SDO_MAX_CONNECTION_UDP];
     tSequLayerReceiveCb     pfnSdoAsySeqCb;
     SOCKET                  udpSocket;
+    ULONG                   ipAddr;         ///< Local IP address in host byte order
 #if (TARGET_SYSTEM == _WIN32_)
     HANDLE                  threadHandle;
     LPCRITICAL_SECTION      pCriticalSection;
@@ -308,6 +309,8 @@ tEplKernel sdoudp_config(ULONG ipAddr_p, UINT port_p)
         sdoUdpInstance_l.threadHandle = 0;
     }
 
+    sdoUdpInstance_l.ipAddr = ipAddr_p;
+
     if (sdoUdpInstance_l.udpSocket != INVALID_SOCKET)
     {
         error = closesocket(sdoUdpInstance_l.udpSocket);
@@ -372,6 +375,7 @@ tEplKernel sdoudp_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
     UINT                count;
     UINT                freeCon;
     tSdoUdpCon*         pSdoUdpCon;
+    ULONG               netAddr;
 
     // get free entry in control structure
     count = 0;
@@ -402,8 +406,14 @@ tEplKernel sdoudp_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
     {
         pSdoUdpCon = &sdoUdpInstance_l.aSdoAbsUdpConnection[freeCon];
         // save infos for connection
+        // target is located in the network of the local node
+        netAddr = sdoUdpInstance_l.ipAddr & 0xFFFFFF00;
+        if (netAddr == 0)
+        {   // local address not configured -> use default network 192.168.100.0
+            netAddr = 0xC0A86400;
+        }
         pSdoUdpCon->port = htons(EPL_C_SDO_EPL_PORT);
-        pSdoUdpCon->ipAddr = htonl(0xC0A86400 | targetNodeId_p);   // 192.168.100.uiTargetNodeId_p
+        pSdoUdpCon->ipAddr = htonl(netAddr | targetNodeId_p);
 
         // set handle
         *pSdoConHandle_p = (freeCon | SDO_UDP_HANDLE);
@@ -0,0 +1,422 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for abstract memory interface
+
+This file contains the unit test functions for the array functions of the
+abstract memory interface. They compare the array functions with the functions
+for single values and measure their throughput.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+
+#include "test-ami.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_MAX_COUNT              67          // values per conversion
+#define TEST_MAX_MISALIGN           3           // byte offsets of the buffers
+#define TEST_BENCH_MAX_SIZE         65536
+#define TEST_BENCH_TOTAL_SIZE       (64 * 1024 * 1024)  // bytes per measurement
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void fillPattern(BYTE* pBuffer_p, UINT size_p, UINT seed_p);
+static void benchmarkSize(UINT size_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const UINT   aTestCount_l[] = {0, 1, 3, 4, 8, 15, 16, 17, 33, TEST_MAX_COUNT};
+
+// the buffers are large enough for the QWORD values and the misalignment
+static BYTE         abValues_l[(TEST_MAX_COUNT * 8) + TEST_MAX_MISALIGN + 8];
+static BYTE         abResult_l[(TEST_MAX_COUNT * 8) + TEST_MAX_MISALIGN + 8];
+static BYTE         abExpected_l[(TEST_MAX_COUNT * 8) + TEST_MAX_MISALIGN + 8];
+
+static QWORD        aqwBenchValues_l[TEST_BENCH_MAX_SIZE / sizeof(QWORD)];
+static BYTE         abBenchScalar_l[TEST_BENCH_MAX_SIZE];
+static BYTE         abBenchArray_l[TEST_BENCH_MAX_SIZE];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test WORD array conversion
+
+The function converts WORD arrays of different lengths to and from big endian
+and little endian buffers at all byte offsets and compares the result with
+the conversion of the single values.
+*/
+//------------------------------------------------------------------------------
+void test_ami_wordArray(void)
+{
+    WORD*       pwValues = (WORD*)abValues_l;
+    WORD        awResult[TEST_MAX_COUNT];
+    UINT        countIndex;
+    UINT        misalign;
+    UINT        count;
+    UINT        i;
+
+    fillPattern(abValues_l, sizeof(abValues_l), 1);
+
+    for (countIndex = 0; countIndex < (sizeof(aTestCount_l) / sizeof(aTestCount_l[0])); countIndex++)
+    {
+        count = aTestCount_l[countIndex];
+        for (misalign = 0; misalign <= TEST_MAX_MISALIGN; misalign++)
+        {
+            for (i = 0; i < count; i++)
+                AmiSetWordToBe(&abExpected_l[misalign + (i * 2)], pwValues[i]);
+            AmiSetWordArrayToBe(&abResult_l[misalign], pwValues, count);
+            CU_ASSERT_EQUAL(memcmp(&abResult_l[misalign], &abExpected_l[misalign], count * 2), 0);
+
+            memset(awResult, 0, sizeof(awResult));
+            AmiGetWordArrayFromBe(awResult, &abResult_l[misalign], count);
+            CU_ASSERT_EQUAL(memcmp(awResult, pwValues, count * 2), 0);
+
+            for (i = 0; i < count; i++)
+                AmiSetWordToLe(&abExpected_l[misalign + (i * 2)], pwValues[i]);
+            AmiSetWordArrayToLe(&abResult_l[misalign], pwValues, count);
+            CU_ASSERT_EQUAL(memcmp(&abResult_l[misalign], &abExpected_l[misalign], count * 2), 0);
+
+            memset(awResult, 0, sizeof(awResult));
+            AmiGetWordArrayFromLe(awResult, &abResult_l[misalign], count);
+            CU_ASSERT_EQUAL(memcmp(awResult, pwValues, count * 2), 0);
+        }
+    }
+
+    // a single value is converted like by the single value function
+    AmiSetWordArrayToBe(abResult_l, pwValues, 1);
+    CU_ASSERT_EQUAL(AmiGetWordFromBe(abResult_l), pwValues[0]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test DWORD array conversion
+
+The function converts DWORD arrays of different lengths to and from big
+endian and little endian buffers at all byte offsets and compares the result
+with the conversion of the single values.
+*/
+//------------------------------------------------------------------------------
+void test_ami_dwordArray(void)
+{
+    DWORD*      pdwValues = (DWORD*)abValues_l;
+    DWORD       adwResult[TEST_MAX_COUNT];
+    UINT        countIndex;
+    UINT        misalign;
+    UINT        count;
+    UINT        i;
+
+    fillPattern(abValues_l, sizeof(abValues_l), 2);
+
+    for (countIndex = 0; countIndex < (sizeof(aTestCount_l) / sizeof(aTestCount_l[0])); countIndex++)
+    {
+        count = aTestCount_l[countIndex];
+        for (misalign = 0; misalign <= TEST_MAX_MISALIGN; misalign++)
+        {
+            for (i = 0; i < count; i++)
+                AmiSetDwordToBe(&abExpected_l[misalign + (i * 4)], pdwValues[i]);
+            AmiSetDwordArrayToBe(&abResult_l[misalign], pdwValues, count);
+            CU_ASSERT_EQUAL(memcmp(&abResult_l[misalign], &abExpected_l[misalign], count * 4), 0);
+
+            memset(adwResult, 0, sizeof(adwResult));
+            AmiGetDwordArrayFromBe(adwResult, &abResult_l[misalign], count);
+            CU_ASSERT_EQUAL(memcmp(adwResult, pdwValues, count * 4), 0);
+
+            for (i = 0; i < count; i++)
+                AmiSetDwordToLe(&abExpected_l[misalign + (i * 4)], pdwValues[i]);
+            AmiSetDwordArrayToLe(&abResult_l[misalign], pdwValues, count);
+            CU_ASSERT_EQUAL(memcmp(&abResult_l[misalign], &abExpected_l[misalign], count * 4), 0);
+
+            memset(adwResult, 0, sizeof(adwResult));
+            AmiGetDwordArrayFromLe(adwResult, &abResult_l[misalign], count);
+            CU_ASSERT_EQUAL(memcmp(adwResult, pdwValues, count * 4), 0);
+        }
+    }
+
+    AmiSetDwordArrayToBe(abResult_l, pdwValues, 1);
+    CU_ASSERT_EQUAL(AmiGetDwordFromBe(abResult_l), pdwValues[0]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test QWORD array conversion
+
+The function converts QWORD arrays of different lengths to and from big
+endian and little endian buffers at all byte offsets and compares the result
+with the conversion of the single values.
+*/
+//------------------------------------------------------------------------------
+void test_ami_qwordArray(void)
+{
+    QWORD*      pqwValues = (QWORD*)abValues_l;
+    QWORD       aqwResult[TEST_MAX_COUNT];
+    UINT        countIndex;
+    UINT        misalign;
+    UINT        count;
+    UINT        i;
+
+    fillPattern(abValues_l, sizeof(abValues_l), 3);
+
+    for (countIndex = 0; countIndex < (sizeof(aTestCount_l) / sizeof(aTestCount_l[0])); countIndex++)
+    {
+        count = aTestCount_l[countIndex];
+        for (misalign = 0; misalign <= TEST_MAX_MISALIGN; misalign++)
+        {
+            for (i = 0; i < count; i++)
+                AmiSetQword64ToBe(&abExpected_l[misalign + (i * 8)], pqwValues[i]);
+            AmiSetQwordArrayToBe(&abResult_l[misalign], pqwValues, count);
+            CU_ASSERT_EQUAL(memcmp(&abResult_l[misalign], &abExpected_l[misalign], count * 8), 0);
+
+            memset(aqwResult, 0, sizeof(aqwResult));
+            AmiGetQwordArrayFromBe(aqwResult, &abResult_l[misalign], count);
+            CU_ASSERT_EQUAL(memcmp(aqwResult, pqwValues, count * 8), 0);
+
+            for (i = 0; i < count; i++)
+                AmiSetQword64ToLe(&abExpected_l[misalign + (i * 8)], pqwValues[i]);
+            AmiSetQwordArrayToLe(&abResult_l[misalign], pqwValues, count);
+            CU_ASSERT_EQUAL(memcmp(&abResult_l[misalign], &abExpected_l[misalign], count * 8), 0);
+
+            memset(aqwResult, 0, sizeof(aqwResult));
+            AmiGetQwordArrayFromLe(aqwResult, &abResult_l[misalign], count);
+            CU_ASSERT_EQUAL(memcmp(aqwResult, pqwValues, count * 8), 0);
+        }
+    }
+
+    AmiSetQwordArrayToBe(abResult_l, pqwValues, 1);
+    CU_ASSERT_EQUAL(AmiGetQword64FromBe(abResult_l), pqwValues[0]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test in-place array conversion
+
+The function converts arrays in place, i.e. source and destination are the
+same buffer, and checks that the result equals the conversion into a separate
+buffer.
+*/
+//------------------------------------------------------------------------------
+void test_ami_inPlace(void)
+{
+    fillPattern(abValues_l, sizeof(abValues_l), 4);
+
+    AmiSetWordArrayToBe(abExpected_l, (WORD*)abValues_l, TEST_MAX_COUNT);
+    memcpy(abResult_l, abValues_l, TEST_MAX_COUNT * 2);
+    AmiSetWordArrayToBe(abResult_l, (WORD*)abResult_l, TEST_MAX_COUNT);
+    CU_ASSERT_EQUAL(memcmp(abResult_l, abExpected_l, TEST_MAX_COUNT * 2), 0);
+
+    AmiSetDwordArrayToBe(abExpected_l, (DWORD*)abValues_l, TEST_MAX_COUNT);
+    memcpy(abResult_l, abValues_l, TEST_MAX_COUNT * 4);
+    AmiGetDwordArrayFromBe((DWORD*)abResult_l, abResult_l, TEST_MAX_COUNT);
+    CU_ASSERT_EQUAL(memcmp(abResult_l, abExpected_l, TEST_MAX_COUNT * 4), 0);
+
+    AmiSetQwordArrayToBe(abExpected_l, (QWORD*)abValues_l, TEST_MAX_COUNT);
+    memcpy(abResult_l, abValues_l, TEST_MAX_COUNT * 8);
+    AmiSetQwordArrayToBe(abResult_l, (QWORD*)abResult_l, TEST_MAX_COUNT);
+    CU_ASSERT_EQUAL(memcmp(abResult_l, abExpected_l, TEST_MAX_COUNT * 8), 0);
+
+    memcpy(abResult_l, abValues_l, TEST_MAX_COUNT * 8);
+    AmiSetQwordArrayToLe(abResult_l, (QWORD*)abResult_l, TEST_MAX_COUNT);
+    CU_ASSERT_EQUAL(memcmp(abResult_l, abValues_l, TEST_MAX_COUNT * 8), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark array conversion
+
+The function measures the throughput of the big endian conversion of 1 KB and
+64 KB buffers with the array functions and with a loop over the functions for
+single values. It checks that both produce the same result and prints the
+throughput in MB/s.
+*/
+//------------------------------------------------------------------------------
+void test_ami_arrayBenchmark(void)
+{
+    fillPattern((BYTE*)aqwBenchValues_l, sizeof(aqwBenchValues_l), 5);
+
+    printf("\n");
+    benchmarkSize(1024);
+    benchmarkSize(TEST_BENCH_MAX_SIZE);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill buffer with test pattern
+
+The function fills a buffer with a pseudo random byte pattern.
+
+\param  pBuffer_p           Pointer to the buffer.
+\param  size_p              Size of the buffer.
+\param  seed_p              Start value of the pattern.
+*/
+//------------------------------------------------------------------------------
+static void fillPattern(BYTE* pBuffer_p, UINT size_p, UINT seed_p)
+{
+    UINT32      value = seed_p;
+    UINT        i;
+
+    for (i = 0; i < size_p; i++)
+    {
+        value = (value * 1103515245UL) + 12345UL;
+        pBuffer_p[i] = (BYTE)(value >> 16);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark array conversion of one buffer size
+
+\param  size_p              Size of the converted buffer in bytes.
+*/
+//------------------------------------------------------------------------------
+static void benchmarkSize(UINT size_p)
+{
+    static const char*  apszType[] = {"WORD", "DWORD", "QWORD"};
+    UINT                rounds = TEST_BENCH_TOTAL_SIZE / size_p;
+    UINT                round;
+    UINT                type;
+    UINT                i;
+    UINT64              scalarTime;
+    UINT64              arrayTime;
+    UINT64              startTime;
+
+    for (type = 0; type < 3; type++)
+    {
+        startTime = getTimeNs();
+        for (round = 0; round < rounds; round++)
+        {
+            switch (type)
+            {
+                case 0:
+                    for (i = 0; i < size_p / 2; i++)
+                        AmiSetWordToBe(&abBenchScalar_l[i * 2], ((WORD*)aqwBenchValues_l)[i]);
+                    break;
+
+                case 1:
+                    for (i = 0; i < size_p / 4; i++)
+                        AmiSetDwordToBe(&abBenchScalar_l[i * 4], ((DWORD*)aqwBenchValues_l)[i]);
+                    break;
+
+                default:
+                    for (i = 0; i < size_p / 8; i++)
+                        AmiSetQword64ToBe(&abBenchScalar_l[i * 8], aqwBenchValues_l[i]);
+                    break;
+            }
+        }
+        scalarTime = getTimeNs() - startTime;
+
+        startTime = getTimeNs();
+        for (round = 0; round < rounds; round++)
+        {
+            switch (type)
+            {
+                case 0:
+                    AmiSetWordArrayToBe(abBenchArray_l, (WORD*)aqwBenchValues_l, size_p / 2);
+                    break;
+
+                case 1:
+                    AmiSetDwordArrayToBe(abBenchArray_l, (DWORD*)aqwBenchValues_l, size_p / 4);
+                    break;
+
+                default:
+                    AmiSetQwordArrayToBe(abBenchArray_l, aqwBenchValues_l, size_p / 8);
+                    break;
+            }
+        }
+        arrayTime = getTimeNs() - startTime;
+
+        CU_ASSERT_EQUAL(memcmp(abBenchScalar_l, abBenchArray_l, size_p), 0);
+
+        printf("    %5u bytes %-5s: single values %8.1f MB/s, array %8.1f MB/s\n",
+               size_p, apszType[type],
+               ((double)size_p * rounds * 1000.0) / (scalarTime + 1),
+               ((double)size_p * rounds * 1000.0) / (arrayTime + 1));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
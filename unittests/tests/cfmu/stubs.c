@@ -0,0 +1,310 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for configuration manager module unit tests
+
+This file contains all stubs needed by the unit tests of the configuration
+manager (CFM) module. The object dictionary provides the ConciseDCF and the
+expected configuration date and time of the tests. SDO transfers are kept
+pending until the test finishes them, the number of writes is counted per
+object index.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <obd.h>
+#include <EplSdoAc.h>
+#include <user/EplSdoComu.h>
+#include <user/identu.h>
+
+#include "test-cfmu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_MAX_INDEX_COUNT        8
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Write counter of an object index
+*/
+typedef struct
+{
+    UINT                        index;
+    UINT                        count;
+} tStubWriteCount;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT8*                   pDcf_l;
+static UINT                     dcfSize_l;
+static UINT32                   expConfDate_l;
+static UINT32                   expConfTime_l;
+static tEplIdentResponse        identResponse_l;
+static BOOL                     fTransferPending_l;
+static tSdoComTransParamByIndex transParam_l;
+static tStubWriteCount          aWriteCount_l[STUB_MAX_INDEX_COUNT];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_reset(void)
+{
+    pDcf_l = NULL;
+    dcfSize_l = 0;
+    expConfDate_l = 0;
+    expConfTime_l = 0;
+    EPL_MEMSET(&identResponse_l, 0, sizeof(identResponse_l));
+    fTransferPending_l = FALSE;
+    EPL_MEMSET(aWriteCount_l, 0, sizeof(aWriteCount_l));
+}
+
+void stub_setConciseDcf(UINT8* pDcf_p, UINT size_p)
+{
+    pDcf_l = pDcf_p;
+    dcfSize_l = size_p;
+}
+
+void stub_setExpectedConf(UINT32 confDate_p, UINT32 confTime_p)
+{
+    expConfDate_l = confDate_p;
+    expConfTime_l = confTime_p;
+}
+
+void stub_setIdentConf(UINT32 confDate_p, UINT32 confTime_p)
+{
+    AmiSetDwordToLe(&identResponse_l.m_le_dwVerifyConfigurationDate, confDate_p);
+    AmiSetDwordToLe(&identResponse_l.m_le_dwVerifyConfigurationTime, confTime_p);
+}
+
+BOOL stub_getPendingTransfer(UINT* pIndex_p, UINT* pSubIndex_p)
+{
+    if (!fTransferPending_l)
+        return FALSE;
+
+    *pIndex_p = transParam_l.index;
+    *pSubIndex_p = transParam_l.subindex;
+    return TRUE;
+}
+
+tEplKernel stub_finishTransfer(BOOL fSuccess_p)
+{
+    tSdoComFinished     sdoComFinished;
+    UINT                i;
+
+    if (!fTransferPending_l)
+        return kEplInvalidOperation;
+
+    fTransferPending_l = FALSE;
+
+    EPL_MEMSET(&sdoComFinished, 0, sizeof(sdoComFinished));
+    sdoComFinished.sdoComConHdl = transParam_l.sdoComConHdl;
+    sdoComFinished.sdoAccessType = transParam_l.sdoAccessType;
+    sdoComFinished.targetIndex = transParam_l.index;
+    sdoComFinished.targetSubIndex = transParam_l.subindex;
+    sdoComFinished.pUserArg = transParam_l.pUserArg;
+    if (fSuccess_p)
+    {
+        sdoComFinished.sdoComConState = kEplSdoComTransferFinished;
+        sdoComFinished.transferredBytes = transParam_l.dataSize;
+
+        for (i = 0; i < STUB_MAX_INDEX_COUNT; i++)
+        {
+            if ((aWriteCount_l[i].count == 0) || (aWriteCount_l[i].index == transParam_l.index))
+            {
+                aWriteCount_l[i].index = transParam_l.index;
+                aWriteCount_l[i].count++;
+                break;
+            }
+        }
+    }
+    else
+    {
+        sdoComFinished.sdoComConState = kEplSdoComTransferRxAborted;
+        sdoComFinished.abortCode = EPL_SDOAC_GENERAL_ERROR;
+    }
+
+    return transParam_l.pfnSdoFinishedCb(&sdoComFinished);
+}
+
+UINT stub_getWriteCount(UINT index_p)
+{
+    UINT        i;
+
+    for (i = 0; i < STUB_MAX_INDEX_COUNT; i++)
+    {
+        if ((aWriteCount_l[i].count != 0) && (aWriteCount_l[i].index == index_p))
+            return aWriteCount_l[i].count;
+    }
+    return 0;
+}
+
+tEplKernel obd_defineVar(tVarParam MEM* pVarParam_p)
+{
+    UNUSED_PARAMETER(pVarParam_p);
+    return kEplSuccessful;
+}
+
+void* obd_getObjectDataPtr(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if (index_p != 0x1F22)
+        return NULL;
+
+    return pDcf_l;
+}
+
+tObdSize obd_getDataSize(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if (index_p != 0x1F22)
+        return 0;
+
+    return dcfSize_l;
+}
+
+tEplKernel obd_readEntry(UINT index_p, UINT subIndex_p, void* pDstData_p, tObdSize *pSize_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if (*pSize_p < sizeof(UINT32))
+        return kEplObdValueLengthError;
+
+    switch (index_p)
+    {
+        case 0x1F26:
+            EPL_MEMCPY(pDstData_p, &expConfDate_l, sizeof(UINT32));
+            break;
+
+        case 0x1F27:
+            EPL_MEMCPY(pDstData_p, &expConfTime_l, sizeof(UINT32));
+            break;
+
+        default:
+            return kEplObdIndexNotExist;
+    }
+
+    *pSize_p = sizeof(UINT32);
+    return kEplSuccessful;
+}
+
+tEplKernel obd_readEntryToLe(UINT index_p, UINT subIndex_p, void* pDstData_p, tObdSize* pSize_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    UNUSED_PARAMETER(pDstData_p);
+    UNUSED_PARAMETER(pSize_p);
+    return kEplObdIndexNotExist;
+}
+
+tEplKernel identu_getIdentResponse(UINT nodeId_p, tEplIdentResponse** ppIdentResponse_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+
+    *ppIdentResponse_p = &identResponse_l;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplSdoComDefineCon(tSdoComConHdl* pSdoComConHdl_p,
+                                     unsigned int uiTargetNodeId_p,
+                                     tSdoType ProtType_p)
+{
+    UNUSED_PARAMETER(ProtType_p);
+
+    *pSdoComConHdl_p = uiTargetNodeId_p;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplSdoComInitTransferByIndex(tSdoComTransParamByIndex* pSdoComTransParam_p)
+{
+    if (fTransferPending_l)
+        return kEplSdoComHandleBusy;
+
+    transParam_l = *pSdoComTransParam_p;
+    fTransferPending_l = TRUE;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplSdoComUndefineCon(tSdoComConHdl SdoComConHdl_p)
+{
+    UNUSED_PARAMETER(SdoComConHdl_p);
+
+    fTransferPending_l = FALSE;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplSdoComSdoAbort(tSdoComConHdl SdoComConHdl_p, DWORD dwAbortCode_p)
+{
+    UNUSED_PARAMETER(SdoComConHdl_p);
+    UNUSED_PARAMETER(dwAbortCode_p);
+
+    fTransferPending_l = FALSE;
+    return kEplSuccessful;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
@@ -0,0 +1,83 @@
+/**
+********************************************************************************
+\file   test-cfmu.h
+
+\brief  Definitions unit tests of configuration manager module
+
+The file contains the definitions for the unit tests of the configuration
+manager (CFM) module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_test_cfmu_H_
+#define _INC_test_cfmu_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <user/cfmu.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void test_cfmu_fullDownload(void);
+void test_cfmu_skipUnchanged(void);
+void test_cfmu_skipUnchangedRestore(void);
+void test_cfmu_restoreUnknownConf(void);
+void test_cfmu_abortInvalidates(void);
+
+// stub control functions
+void stub_reset(void);
+void stub_setConciseDcf(UINT8* pDcf_p, UINT size_p);
+void stub_setExpectedConf(UINT32 confDate_p, UINT32 confTime_p);
+void stub_setIdentConf(UINT32 confDate_p, UINT32 confTime_p);
+BOOL stub_getPendingTransfer(UINT* pIndex_p, UINT* pSubIndex_p);
+tEplKernel stub_finishTransfer(BOOL fSuccess_p);
+UINT stub_getWriteCount(UINT index_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_test_cfmu_H_ */
@@ -0,0 +1,399 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for configuration manager module
+
+This file contains the unit test functions for the configuration manager (CFM)
+module. They check that unchanged ConciseDCF entries are only skipped while
+the CN holds the configuration of the last stored download.
+
+*******************************************************************************/
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stddef.h>
+#include <CUnit/CUnit.h>
+
+#include "test-cfmu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NODE_ID                1
+#define TEST_ENTRY_COUNT            10
+#define TEST_ENTRY_SIZE             (EPL_CDC_OFFSET_DATA + sizeof(UINT32))
+#define TEST_OBJECT_INDEX           0x2000
+#define TEST_CONF_DATE              0x1000
+#define TEST_CONF_TIME              0x2000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void initTest(void);
+static void setValue(UINT entry_p, UINT32 value_p);
+static tNmtNodeCommand runConfig(tNmtNodeEvent nodeEvent_p, BOOL fRestoreOk_p, UINT failWrite_p);
+static void runFullDownload(void);
+static tEplKernel cbEventCnProgress(tCfmEventCnProgress* pEventCnProgress_p);
+static tEplKernel cbEventCnResult(UINT nodeId_p, tNmtNodeCommand nodeCommand_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT8            abDcf_l[sizeof(UINT32) + (TEST_ENTRY_COUNT * TEST_ENTRY_SIZE)];
+static UINT32           entriesSkipped_l;
+static tNmtNodeCommand  nodeCommand_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test full download of a ConciseDCF
+
+The function checks that the first download writes all entries and stores the
+configuration, and that no download is started if the CN reports the expected
+configuration date and time.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_fullDownload(void)
+{
+    UINT    index;
+    UINT    subIndex;
+
+    initTest();
+
+    runFullDownload();
+
+    // CN reports the downloaded configuration after the reset
+    stub_setIdentConf(TEST_CONF_DATE, TEST_CONF_TIME);
+    CU_ASSERT_EQUAL(cfmu_processNodeEvent(TEST_NODE_ID, kNmtNodeEventCheckConf), kEplSuccessful);
+    CU_ASSERT_FALSE(stub_getPendingTransfer(&index, &subIndex));
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), TEST_ENTRY_COUNT);
+
+    cfmu_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test unchanged entries are skipped
+
+The function changes one entry and the configuration date of the ConciseDCF.
+It checks that only the changed entry is downloaded to a CN which holds the
+configuration of the last download.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_skipUnchanged(void)
+{
+    initTest();
+
+    runFullDownload();
+
+    setValue(3, 0xCAFE);
+    stub_setExpectedConf(TEST_CONF_DATE + 1, TEST_CONF_TIME);
+    stub_setIdentConf(TEST_CONF_DATE, TEST_CONF_TIME);
+
+    // restore isn't supported by the CN, hence, the download starts
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventCheckConf, FALSE, 0), kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), TEST_ENTRY_COUNT + 1);
+    CU_ASSERT_EQUAL(stub_getWriteCount(0x1010), 2);
+    CU_ASSERT_EQUAL(entriesSkipped_l, TEST_ENTRY_COUNT - 1);
+
+    // the digests of the second download are valid, too
+    setValue(9, 0xBEEF);
+    stub_setExpectedConf(TEST_CONF_DATE + 2, TEST_CONF_TIME);
+    stub_setIdentConf(TEST_CONF_DATE + 1, TEST_CONF_TIME);
+
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventUpdateConf, FALSE, 0), kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), TEST_ENTRY_COUNT + 2);
+    CU_ASSERT_EQUAL(entriesSkipped_l, TEST_ENTRY_COUNT - 1);
+
+    cfmu_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test unchanged entries are skipped on a CN supporting restore
+
+The function checks that the default configuration isn't restored on a CN
+which holds the configuration of the last download, so that only the changed
+entry is downloaded.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_skipUnchangedRestore(void)
+{
+    initTest();
+
+    runFullDownload();
+
+    setValue(3, 0xCAFE);
+    stub_setExpectedConf(TEST_CONF_DATE + 1, TEST_CONF_TIME);
+    stub_setIdentConf(TEST_CONF_DATE, TEST_CONF_TIME);
+
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventCheckConf, TRUE, 0), kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(stub_getWriteCount(0x1011), 0);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), TEST_ENTRY_COUNT + 1);
+    CU_ASSERT_EQUAL(stub_getWriteCount(0x1010), 2);
+    CU_ASSERT_EQUAL(entriesSkipped_l, TEST_ENTRY_COUNT - 1);
+
+    cfmu_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test restore of a CN with unknown configuration
+
+The function checks that the default configuration is restored and all
+entries are downloaded if the CN doesn't hold the configuration of the last
+download.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_restoreUnknownConf(void)
+{
+    initTest();
+
+    runFullDownload();
+
+    setValue(3, 0xCAFE);
+    stub_setExpectedConf(TEST_CONF_DATE + 1, TEST_CONF_TIME);
+    stub_setIdentConf(TEST_CONF_DATE + 5, TEST_CONF_TIME);
+
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventCheckConf, TRUE, 0), kNmtNodeCommandConfRestored);
+    CU_ASSERT_EQUAL(stub_getWriteCount(0x1011), 1);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), TEST_ENTRY_COUNT);
+
+    // the CN reports the default configuration after the restore
+    stub_setIdentConf(0, 0);
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventUpdateConf, TRUE, 0), kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), 2 * TEST_ENTRY_COUNT);
+    CU_ASSERT_EQUAL(entriesSkipped_l, 0);
+
+    cfmu_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test aborted download invalidates digests
+
+The function checks that all entries are downloaded after a download was
+aborted, because the state of the CN is unknown.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_abortInvalidates(void)
+{
+    initTest();
+
+    runFullDownload();
+
+    setValue(3, 0xCAFE);
+    stub_setExpectedConf(TEST_CONF_DATE + 1, TEST_CONF_TIME);
+    stub_setIdentConf(TEST_CONF_DATE, TEST_CONF_TIME);
+
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventCheckConf, FALSE, 1), kNmtNodeCommandConfErr);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), TEST_ENTRY_COUNT);
+
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventCheckConf, FALSE, 0), kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), 2 * TEST_ENTRY_COUNT);
+    CU_ASSERT_EQUAL(entriesSkipped_l, 0);
+
+    cfmu_exit();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize test
+
+The function resets the stubs, initializes the CFM module and builds the
+ConciseDCF of the test.
+*/
+//------------------------------------------------------------------------------
+static void initTest(void)
+{
+    UINT    entry;
+    UINT8*  pEntry;
+
+    stub_reset();
+    cfmu_init(cbEventCnProgress, cbEventCnResult);
+
+    AmiSetDwordToLe(abDcf_l, TEST_ENTRY_COUNT);
+    for (entry = 0; entry < TEST_ENTRY_COUNT; entry++)
+    {
+        pEntry = &abDcf_l[sizeof(UINT32) + (entry * TEST_ENTRY_SIZE)];
+        AmiSetWordToLe(&pEntry[EPL_CDC_OFFSET_INDEX], TEST_OBJECT_INDEX);
+        AmiSetByteToLe(&pEntry[EPL_CDC_OFFSET_SUBINDEX], (BYTE)(entry + 1));
+        AmiSetDwordToLe(&pEntry[EPL_CDC_OFFSET_SIZE], sizeof(UINT32));
+        setValue(entry, entry * 100);
+    }
+
+    stub_setConciseDcf(abDcf_l, sizeof(abDcf_l));
+    stub_setExpectedConf(TEST_CONF_DATE, TEST_CONF_TIME);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set value of a ConciseDCF entry
+
+\param  entry_p         Number of the entry.
+\param  value_p         Value of the entry.
+*/
+//------------------------------------------------------------------------------
+static void setValue(UINT entry_p, UINT32 value_p)
+{
+    AmiSetDwordToLe(&abDcf_l[sizeof(UINT32) + (entry_p * TEST_ENTRY_SIZE) + EPL_CDC_OFFSET_DATA],
+                    value_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run configuration of the test node
+
+The function processes a node event and finishes all SDO transfers started by
+the CFM module until the configuration is finished.
+
+\param  nodeEvent_p     Node event to process.
+\param  fRestoreOk_p    The CN restores its default configuration.
+\param  failWrite_p     Number of the write to the test object which fails,
+                        0 if all writes succeed.
+
+\return The function returns the node command of the result callback.
+*/
+//------------------------------------------------------------------------------
+static tNmtNodeCommand runConfig(tNmtNodeEvent nodeEvent_p, BOOL fRestoreOk_p, UINT failWrite_p)
+{
+    UINT        index;
+    UINT        subIndex;
+    UINT        writeCount = 0;
+    BOOL        fSuccess;
+
+    nodeCommand_l = 0;
+    entriesSkipped_l = 0;
+
+    CU_ASSERT_EQUAL(cfmu_processNodeEvent(TEST_NODE_ID, nodeEvent_p), kEplReject);
+
+    while (stub_getPendingTransfer(&index, &subIndex))
+    {
+        if (index == 0x1011)
+        {
+            fSuccess = fRestoreOk_p;
+        }
+        else if (index == TEST_OBJECT_INDEX)
+        {
+            writeCount++;
+            fSuccess = (writeCount != failWrite_p);
+        }
+        else
+        {
+            fSuccess = TRUE;
+        }
+
+        CU_ASSERT_EQUAL(stub_finishTransfer(fSuccess), kEplSuccessful);
+    }
+
+    return nodeCommand_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run full download
+
+The function runs the first configuration of the test node, which downloads
+all entries of the ConciseDCF.
+*/
+//------------------------------------------------------------------------------
+static void runFullDownload(void)
+{
+    CU_ASSERT_EQUAL(runConfig(kNmtNodeEventCheckConf, FALSE, 0), kNmtNodeCommandConfReset);
+    CU_ASSERT_EQUAL(stub_getWriteCount(TEST_OBJECT_INDEX), TEST_ENTRY_COUNT);
+    CU_ASSERT_EQUAL(stub_getWriteCount(0x1010), 1);
+    CU_ASSERT_EQUAL(entriesSkipped_l, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  CN progress callback
+
+\param  pEventCnProgress_p  Pointer to CN progress event.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbEventCnProgress(tCfmEventCnProgress* pEventCnProgress_p)
+{
+    entriesSkipped_l = pEventCnProgress_p->entriesSkipped;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  CN result callback
+
+\param  nodeId_p        Node ID of the CN.
+\param  nodeCommand_p   Node command which finishes the configuration.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbEventCnResult(UINT nodeId_p, tNmtNodeCommand nodeCommand_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+
+    nodeCommand_l = nodeCommand_p;
+    return kEplSuccessful;
+}
@@ -0,0 +1,350 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for process-local circular buffer library
+
+This file contains the unit test functions for the circular buffer library
+using the process-local architecture backend. They check the transfer of data
+between instances, the handling of allocated and connected buffers and the
+locking with concurrent threads, and measure the duration of a transfer.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <circbuffer.h>
+
+#include "test-circbuf.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_BUFFER_ID              3
+#define TEST_BUFFER_SIZE            4096
+#define TEST_THREAD_ENTRIES         100000
+#define TEST_BENCH_ROUNDS           200000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void* producerThread(void* pArg_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test transfer between allocated and connected buffer
+
+The function writes data into a buffer with the instance which allocated it
+and reads the data with a connected instance.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_transfer(void)
+{
+    tCircBufInstance*   pAlloc;
+    tCircBufInstance*   pConn;
+    UINT8               aData[100];
+    UINT8               aRead[100];
+    size_t              size;
+    UINT                i;
+
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_connect(TEST_BUFFER_ID, &pConn), kCircBufOk);
+
+    for (i = 0; i < sizeof(aData); i++)
+        aData[i] = (UINT8)i;
+
+    CU_ASSERT_EQUAL(circbuf_writeData(pAlloc, aData, sizeof(aData)), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_writeMultipleData(pAlloc, aData, 10, aData + 10, 20), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pConn), 2);
+
+    CU_ASSERT_EQUAL(circbuf_readData(pConn, aRead, sizeof(aRead), &size), kCircBufOk);
+    CU_ASSERT_EQUAL(size, sizeof(aData));
+    CU_ASSERT_EQUAL(memcmp(aRead, aData, sizeof(aData)), 0);
+
+    CU_ASSERT_EQUAL(circbuf_readData(pConn, aRead, sizeof(aRead), &size), kCircBufOk);
+    CU_ASSERT_EQUAL(size, 30);
+    CU_ASSERT_EQUAL(memcmp(aRead, aData, 30), 0);
+
+    CU_ASSERT_EQUAL(circbuf_readData(pAlloc, aRead, sizeof(aRead), &size), kCircBufNoReadableData);
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pAlloc), 0);
+
+    CU_ASSERT_EQUAL(circbuf_disconnect(pConn), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_free(pAlloc), kCircBufOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test allocating and connecting buffers
+
+The function checks that a buffer can only be connected while it is allocated
+and that a buffer ID can't be allocated twice.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_connect(void)
+{
+    tCircBufInstance*   pAlloc;
+    tCircBufInstance*   pOther;
+    tCircBufInstance*   pConn;
+
+    CU_ASSERT_EQUAL(circbuf_connect(TEST_BUFFER_ID, &pConn), kCircBufNoResource);
+
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pOther), kCircBufNoResource);
+
+    // a different ID is an independent buffer
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID + 1, TEST_BUFFER_SIZE, &pOther), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_writeData(pOther, "x", 1), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pAlloc), 0);
+    CU_ASSERT_EQUAL(circbuf_free(pOther), kCircBufOk);
+
+    CU_ASSERT_EQUAL(circbuf_free(pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_connect(TEST_BUFFER_ID, &pConn), kCircBufNoResource);
+
+    // the ID can be allocated again after the buffer was freed
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_free(pAlloc), kCircBufOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test freeing a buffer with connected instances
+
+The function checks that a connected instance can still access the buffer
+after it has been freed and that the buffer is released when the last
+instance disconnects.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_freeConnected(void)
+{
+    tCircBufInstance*   pAlloc;
+    tCircBufInstance*   pConn;
+    UINT8               aRead[16];
+    size_t              size;
+
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_connect(TEST_BUFFER_ID, &pConn), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_writeData(pAlloc, "data", 4), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_free(pAlloc), kCircBufOk);
+
+    // the buffer is still used by the connected instance
+    CU_ASSERT_EQUAL(circbuf_readData(pConn, aRead, sizeof(aRead), &size), kCircBufOk);
+    CU_ASSERT_EQUAL(size, 4);
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufNoResource);
+
+    CU_ASSERT_EQUAL(circbuf_disconnect(pConn), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_free(pAlloc), kCircBufOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test producer and consumer threads
+
+The function writes numbered entries with a producer thread and reads them
+with a consumer. The entries must be received completely and in order.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_threads(void)
+{
+    tCircBufInstance*   pAlloc;
+    tCircBufInstance*   pConn;
+    pthread_t           thread;
+    UINT32              expected = 0;
+    UINT32              value;
+    size_t              size;
+    tCircBufError       ret;
+    BOOL                fInOrder = TRUE;
+
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_connect(TEST_BUFFER_ID, &pConn), kCircBufOk);
+
+    CU_ASSERT_EQUAL(pthread_create(&thread, NULL, producerThread, pConn), 0);
+
+    while (expected < TEST_THREAD_ENTRIES)
+    {
+        ret = circbuf_readData(pAlloc, &value, sizeof(value), &size);
+        if (ret == kCircBufNoReadableData)
+        {
+            sched_yield();
+            continue;
+        }
+
+        if ((ret != kCircBufOk) || (size != sizeof(value)) || (value != expected))
+        {
+            fInOrder = FALSE;
+            break;
+        }
+        expected++;
+    }
+
+    pthread_join(thread, NULL);
+    CU_ASSERT_TRUE(fInOrder);
+    CU_ASSERT_EQUAL(expected, TEST_THREAD_ENTRIES);
+    CU_ASSERT_EQUAL(circbuf_getDataCount(pAlloc), 0);
+
+    CU_ASSERT_EQUAL(circbuf_disconnect(pConn), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_free(pAlloc), kCircBufOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark writing and reading data
+
+The function measures the duration of writing and reading an event sized
+entry.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_benchmark(void)
+{
+    tCircBufInstance*   pAlloc;
+    tCircBufInstance*   pConn;
+    UINT8               aData[64];
+    size_t              size;
+    UINT64              startTime;
+    UINT64              duration;
+    UINT                round;
+    BOOL                fOk = TRUE;
+
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_BUFFER_ID, TEST_BUFFER_SIZE, &pAlloc), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_connect(TEST_BUFFER_ID, &pConn), kCircBufOk);
+    memset(aData, 0xA5, sizeof(aData));
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if ((circbuf_writeData(pConn, aData, sizeof(aData)) != kCircBufOk) ||
+            (circbuf_readData(pAlloc, aData, sizeof(aData), &size) != kCircBufOk))
+        {
+            fOk = FALSE;
+            break;
+        }
+    }
+    duration = getTimeNs() - startTime;
+
+    CU_ASSERT_TRUE(fOk);
+    printf("\n    write and read of %u byte entry: %llu ns\n", (UINT)sizeof(aData),
+           (unsigned long long)(duration / TEST_BENCH_ROUNDS));
+
+    CU_ASSERT_EQUAL(circbuf_disconnect(pConn), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_free(pAlloc), kCircBufOk);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Producer thread
+
+The thread writes numbered entries into the buffer. It retries if the buffer
+is full.
+
+\param  pArg_p              Pointer to the connected buffer instance.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* producerThread(void* pArg_p)
+{
+    tCircBufInstance*   pInstance = (tCircBufInstance*)pArg_p;
+    UINT32              value = 0;
+
+    while (value < TEST_THREAD_ENTRIES)
+    {
+        if (circbuf_writeData(pInstance, &value, sizeof(value)) == kCircBufOk)
+            value++;
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
+
+/// \}
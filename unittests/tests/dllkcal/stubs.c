@@ -0,0 +1,277 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for kernel DLL CAL module unit tests
+
+This file contains all stubs needed by the unit tests of the kernel DLL CAL
+module. The circular buffers and the DLL CAL queues are always empty, thus only
+the IdentRequests and StatusRequests are scheduled.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <dllcal.h>
+#include <circbuffer.h>
+#include <kernel/dllk.h>
+#include <kernel/eventk.h>
+
+#include "test-dllkcal.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue dllCalQueue_p);
+static tEplKernel delInstance(tDllCalQueueInstance pDllCalQueue_p);
+static tEplKernel insertDataBlock(tDllCalQueueInstance pDllCalQueue_p, BYTE* pData_p,
+                                  UINT* pDataSize_p);
+static tEplKernel getDataBlock(tDllCalQueueInstance pDllCalQueue_p, BYTE* pData_p,
+                               UINT* pDataSize_p);
+static tEplKernel getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p, ULONG* pDataBlockCount_p);
+static tEplKernel resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p, ULONG timeOutMs_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tDllCalFuncIntf  funcintf_l =
+{
+    addInstance,
+    delInstance,
+    insertDataBlock,
+    getDataBlock,
+    getDataBlockCount,
+    resetDataBlockQueue
+};
+
+static tCircBufInstance circBufInstance_l;
+static UINT             flag1Count_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_reset(void)
+{
+    flag1Count_l = 0;
+}
+
+UINT stub_getFlag1Count(void)
+{
+    return flag1Count_l;
+}
+
+tDllCalFuncIntf* dllkcalcircbuf_getInterface(void)
+{
+    return &funcintf_l;
+}
+
+tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInstance_p)
+{
+    UNUSED_PARAMETER(id_p);
+    UNUSED_PARAMETER(size_p);
+
+    *ppInstance_p = &circBufInstance_l;
+    return kCircBufOk;
+}
+
+tCircBufError circbuf_free(tCircBufInstance* pInstance_p)
+{
+    UNUSED_PARAMETER(pInstance_p);
+    return kCircBufOk;
+}
+
+void circbuf_reset(tCircBufInstance* pInstance_p)
+{
+    UNUSED_PARAMETER(pInstance_p);
+}
+
+tCircBufError circbuf_writeData(tCircBufInstance* pInstance_p, const void* pData_p,
+                                size_t size_p)
+{
+    UNUSED_PARAMETER(pInstance_p);
+    UNUSED_PARAMETER(pData_p);
+    UNUSED_PARAMETER(size_p);
+
+    return kCircBufBufferFull;
+}
+
+tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
+                               size_t size_p, size_t* pDataBlockSize_p)
+{
+    UNUSED_PARAMETER(pInstance_p);
+    UNUSED_PARAMETER(pData_p);
+    UNUSED_PARAMETER(size_p);
+    UNUSED_PARAMETER(pDataBlockSize_p);
+
+    return kCircBufNoReadableData;
+}
+
+tEplKernel dllk_setFlag1OfNode(UINT nodeId_p, BYTE soaFlag1_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(soaFlag1_p);
+
+    flag1Count_l++;
+    return kEplSuccessful;
+}
+
+tEplKernel dllk_config(tDllConfigParam* pDllConfigParam_p)
+{
+    UNUSED_PARAMETER(pDllConfigParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel dllk_setIdentity(tDllIdentParam* pDllIdentParam_p)
+{
+    UNUSED_PARAMETER(pDllIdentParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel dllk_setAsndServiceIdFilter(tDllAsndServiceId ServiceId_p, tDllAsndFilter Filter_p)
+{
+    UNUSED_PARAMETER(ServiceId_p);
+    UNUSED_PARAMETER(Filter_p);
+    return kEplSuccessful;
+}
+
+tEplKernel dllk_configNode(tDllNodeInfo* pNodeInfo_p)
+{
+    UNUSED_PARAMETER(pNodeInfo_p);
+    return kEplSuccessful;
+}
+
+tEplKernel dllk_addNode(tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel dllk_deleteNode(tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel dllk_getCnMacAddress(UINT nodeId_p, UINT8* pCnMacAddress_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(pCnMacAddress_p);
+    return kEplSuccessful;
+}
+
+tEplKernel eventk_postEvent(tEplEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+    return kEplSuccessful;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+static tEplKernel addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue dllCalQueue_p)
+{
+    UNUSED_PARAMETER(dllCalQueue_p);
+
+    *ppDllCalQueue_p = NULL;
+    return kEplSuccessful;
+}
+
+static tEplKernel delInstance(tDllCalQueueInstance pDllCalQueue_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    return kEplSuccessful;
+}
+
+static tEplKernel insertDataBlock(tDllCalQueueInstance pDllCalQueue_p, BYTE* pData_p,
+                                  UINT* pDataSize_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    UNUSED_PARAMETER(pData_p);
+    UNUSED_PARAMETER(pDataSize_p);
+    return kEplDllAsyncTxBufferFull;
+}
+
+static tEplKernel getDataBlock(tDllCalQueueInstance pDllCalQueue_p, BYTE* pData_p,
+                               UINT* pDataSize_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    UNUSED_PARAMETER(pData_p);
+
+    *pDataSize_p = 0;
+    return kEplDllAsyncTxBufferEmpty;
+}
+
+static tEplKernel getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p, ULONG* pDataBlockCount_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+
+    *pDataBlockCount_p = 0;
+    return kEplSuccessful;
+}
+
+static tEplKernel resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p, ULONG timeOutMs_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    UNUSED_PARAMETER(timeOutMs_p);
+    return kEplSuccessful;
+}
@@ -0,0 +1,395 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for kernel DLL CAL module
+
+This file contains the unit test functions for the kernel DLL CAL module.
+They check the scheduling of IdentRequests and StatusRequests and measure the
+duration of dllkcal_getSoaRequest() with 239 CNs.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <kernel/dllkcal.h>
+
+#include "test-dllkcal.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_BENCH_CN_COUNT         239
+#define TEST_BENCH_ROUNDS           2000
+#define TEST_BENCH_ISSUE_REPEAT     4
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void initDllkCal(void);
+static BOOL getRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static BOOL     fDllkCalInitialized_l = FALSE;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test deduplication of issued requests
+
+The function issues IdentRequests and StatusRequests several times to the same
+nodes and checks that each node is requested only once per service.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_requestDedup(void)
+{
+    tDllReqServiceId    reqServiceId;
+    UINT                nodeId;
+    UINT                i;
+
+    initDllkCal();
+
+    for (i = 0; i < 10; i++)
+    {
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, 5, 0xFF), kEplSuccessful);
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 5, 0xFF), kEplSuccessful);
+    }
+    // more requests than the former request queues could hold
+    for (i = 0; i < 1000; i++)
+    {
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 7, 0xFF), kEplSuccessful);
+    }
+
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceIdent);
+    CU_ASSERT_EQUAL(nodeId, 5);
+
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceStatus);
+    CU_ASSERT_EQUAL(nodeId, 5);
+
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceStatus);
+    CU_ASSERT_EQUAL(nodeId, 7);
+
+    CU_ASSERT_FALSE(getRequest(&reqServiceId, &nodeId));
+
+    // Flag1 is still forwarded to the DLL for every issued request
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 5, 0x10), kEplSuccessful);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 5, 0x00), kEplSuccessful);
+    CU_ASSERT_EQUAL(stub_getFlag1Count(), 2);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test round-robin order of pending requests
+
+The function checks that pending requests are served in ascending node order
+starting behind the last served node and that the search wraps around. A node
+which is requested again immediately must not be served before the other
+pending nodes.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_roundRobin(void)
+{
+    tDllReqServiceId    reqServiceId;
+    UINT                nodeId;
+    UINT                i;
+
+    initDllkCal();
+
+    dllkcal_issueRequest(kDllReqServiceStatus, 200, 0xFF);
+    dllkcal_issueRequest(kDllReqServiceStatus, 10, 0xFF);
+    dllkcal_issueRequest(kDllReqServiceStatus, 3, 0xFF);
+
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 3);
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 10);
+
+    // node 4 is before the cursor, thus it is served after wrap around
+    dllkcal_issueRequest(kDllReqServiceStatus, 4, 0xFF);
+    dllkcal_issueRequest(kDllReqServiceStatus, 254, 0xFF);
+
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 200);
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 254);
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 4);
+    CU_ASSERT_FALSE(getRequest(&reqServiceId, &nodeId));
+
+    // node 1 is requested permanently, nodes 2 and 3 must not starve
+    dllkcal_issueRequest(kDllReqServiceIdent, 1, 0xFF);
+    dllkcal_issueRequest(kDllReqServiceIdent, 2, 0xFF);
+    dllkcal_issueRequest(kDllReqServiceIdent, 3, 0xFF);
+    for (i = 0; i < 3; i++)
+    {
+        CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+        CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceIdent);
+        CU_ASSERT_EQUAL(nodeId, i + 1);
+        dllkcal_issueRequest(kDllReqServiceIdent, 1, 0xFF);
+    }
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 1);
+    CU_ASSERT_FALSE(getRequest(&reqServiceId, &nodeId));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test requests for invalid node IDs
+
+The function checks that requests for invalid node IDs and invalid services
+are rejected.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_invalidNode(void)
+{
+    tDllReqServiceId    reqServiceId;
+    UINT                nodeId;
+
+    initDllkCal();
+
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, EPL_C_ADR_INVALID, 0xFF),
+                    kEplDllInvalidParam);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, EPL_C_ADR_BROADCAST, 0xFF),
+                    kEplDllInvalidParam);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 1000, 0xFF),
+                    kEplDllInvalidParam);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceNmtRequest, 1, 0xFF),
+                    kEplDllInvalidParam);
+    CU_ASSERT_EQUAL(stub_getFlag1Count(), 0);
+
+    CU_ASSERT_FALSE(getRequest(&reqServiceId, &nodeId));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test clearing the asynchronous queues
+
+The function checks that pending requests are discarded and the round-robin
+cursor is reset by dllkcal_clearAsyncQueues().
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_clearQueues(void)
+{
+    tDllReqServiceId    reqServiceId;
+    UINT                nodeId;
+
+    initDllkCal();
+
+    dllkcal_issueRequest(kDllReqServiceStatus, 100, 0xFF);
+    dllkcal_issueRequest(kDllReqServiceStatus, 101, 0xFF);
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 100);
+
+    dllkcal_issueRequest(kDllReqServiceIdent, 50, 0xFF);
+    CU_ASSERT_EQUAL(dllkcal_clearAsyncQueues(), kEplSuccessful);
+    CU_ASSERT_FALSE(getRequest(&reqServiceId, &nodeId));
+
+    dllkcal_issueRequest(kDllReqServiceStatus, 101, 0xFF);
+    dllkcal_issueRequest(kDllReqServiceStatus, 20, 0xFF);
+    CU_ASSERT_TRUE(getRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 20);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark SoA request scheduling
+
+The function simulates an MN with 239 CNs. In each round every CN is issued a
+StatusRequest several times, every fourth CN additionally an IdentRequest.
+Afterwards dllkcal_getSoaRequest() is called until no request is left. The
+test checks that every node is served exactly once per round and service and
+prints the average duration of the calls.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_soaRequestBenchmark(void)
+{
+    tDllReqServiceId    reqServiceId;
+    UINT                nodeId;
+    UINT                round;
+    UINT                i;
+    UINT                aStatusCount[TEST_BENCH_CN_COUNT + 1];
+    UINT                aIdentCount[TEST_BENCH_CN_COUNT + 1];
+    UINT                soaCount = 0;
+    UINT                issueCount = 0;
+    BOOL                fFair = TRUE;
+    UINT64              issueTime = 0;
+    UINT64              soaTime = 0;
+    UINT64              startTime;
+
+    initDllkCal();
+
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        EPL_MEMSET(aStatusCount, 0, sizeof(aStatusCount));
+        EPL_MEMSET(aIdentCount, 0, sizeof(aIdentCount));
+
+        startTime = getTimeNs();
+        for (i = 0; i < TEST_BENCH_ISSUE_REPEAT * TEST_BENCH_CN_COUNT; i++)
+        {
+            nodeId = (i % TEST_BENCH_CN_COUNT) + 1;
+            dllkcal_issueRequest(kDllReqServiceStatus, nodeId, 0xFF);
+            if ((nodeId & 3) == 0)
+            {
+                dllkcal_issueRequest(kDllReqServiceIdent, nodeId, 0xFF);
+                issueCount++;
+            }
+            issueCount++;
+        }
+        issueTime += getTimeNs() - startTime;
+
+        startTime = getTimeNs();
+        for (;;)
+        {
+            reqServiceId = kDllReqServiceNo;
+            dllkcal_getSoaRequest(&reqServiceId, &nodeId, NULL);
+            soaCount++;
+            if (reqServiceId == kDllReqServiceNo)
+                break;
+
+            if (reqServiceId == kDllReqServiceStatus)
+                aStatusCount[nodeId]++;
+            else if (reqServiceId == kDllReqServiceIdent)
+                aIdentCount[nodeId]++;
+        }
+        soaTime += getTimeNs() - startTime;
+
+        for (nodeId = 1; nodeId <= TEST_BENCH_CN_COUNT; nodeId++)
+        {
+            if ((aStatusCount[nodeId] != 1) ||
+                (aIdentCount[nodeId] != (((nodeId & 3) == 0) ? 1U : 0U)))
+            {
+                fFair = FALSE;
+            }
+        }
+    }
+
+    CU_ASSERT_TRUE(fFair);
+
+    printf("\n    %u CNs: issueRequest %.1f ns/call, getSoaRequest %.1f ns/call\n",
+           TEST_BENCH_CN_COUNT, (double)issueTime / issueCount,
+           (double)soaTime / soaCount);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the kernel DLL CAL module for a test
+
+The function resets the stubs and reinitializes the kernel DLL CAL module.
+*/
+//------------------------------------------------------------------------------
+static void initDllkCal(void)
+{
+    stub_reset();
+    if (fDllkCalInitialized_l)
+        dllkcal_exit();
+
+    CU_ASSERT_EQUAL(dllkcal_init(), kEplSuccessful);
+    fDllkCalInitialized_l = TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the next IdentRequest or StatusRequest
+
+The function calls dllkcal_getSoaRequest() until it returns an IdentRequest or
+StatusRequest or all request queues are checked.
+
+\param  pReqServiceId_p         Pointer to store the request service ID.
+\param  pNodeId_p               Pointer to store the node ID.
+
+\return The function returns TRUE if a request was found.
+*/
+//------------------------------------------------------------------------------
+static BOOL getRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+{
+    *pReqServiceId_p = kDllReqServiceNo;
+    dllkcal_getSoaRequest(pReqServiceId_p, pNodeId_p, NULL);
+
+    return (*pReqServiceId_p != kDllReqServiceNo);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
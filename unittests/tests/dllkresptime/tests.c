@@ -0,0 +1,541 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for DLL response time histograms
+
+This file contains the unit test functions for the response time histograms
+of the DLL. The response times are computed from the time stamps of pcap
+savefiles in the same way as the MN computes them from the time stamps of the
+pcap Ethernet driver.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+
+#include "test-dllkresptime.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SAVEFILE_MAGIC_MICRO        0xA1B2C3D4  // savefile with us time stamps
+#define SAVEFILE_MAGIC_NANO         0xA1B23C4D  // savefile with ns time stamps
+#define SAVEFILE_LINKTYPE_ETHERNET  1
+#define SAVEFILE_MAX_FRAME_SIZE     1518
+
+#define TEST_FRAME_SIZE             60
+#define TEST_EXTERNAL_SAVEFILE_ENV  "DLLKRESPTIME_SAVEFILE"
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+// global header of a pcap savefile
+typedef struct
+{
+    UINT32          magic;
+    UINT16          versionMajor;
+    UINT16          versionMinor;
+    UINT32          thisZone;
+    UINT32          sigFigs;
+    UINT32          snapLen;
+    UINT32          linkType;
+} tSavefileHeader;
+
+// record header of a frame in a pcap savefile
+typedef struct
+{
+    UINT32          tsSec;
+    UINT32          tsSubSec;                   // us or ns, depending on magic
+    UINT32          capLen;
+    UINT32          origLen;
+} tSavefileRecord;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static FILE* createSavefile(UINT32 magic_p);
+static void  writeFrame(FILE* pFile_p, UINT32 sec_p, UINT32 subSec_p,
+                        tEplMsgType msgType_p, UINT dstNodeId_p, UINT srcNodeId_p);
+static BOOL  evaluateSavefile(FILE* pFile_p, tDllkResponseTimeHist* aHist_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tDllkResponseTimeHist    aHist_l[EPL_C_ADR_BROADCAST];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test sorting of response times into histogram bins
+
+The function checks the bin boundaries and the statistics of the histogram.
+*/
+//------------------------------------------------------------------------------
+void test_dllkresptime_histogram(void)
+{
+    tDllkResponseTimeHist   hist;
+    UINT                    bin;
+
+    dllk_resetResponseTimeHist(&hist);
+    CU_ASSERT_EQUAL(hist.count, 0);
+
+    dllk_updateResponseTimeHist(&hist, 0);
+    dllk_updateResponseTimeHist(&hist, 1023);
+    dllk_updateResponseTimeHist(&hist, 1024);
+    dllk_updateResponseTimeHist(&hist, 2047);
+    dllk_updateResponseTimeHist(&hist, 2048);
+    dllk_updateResponseTimeHist(&hist, 3000);
+
+    CU_ASSERT_EQUAL(hist.aBin[0], 2);
+    CU_ASSERT_EQUAL(hist.aBin[1], 2);
+    CU_ASSERT_EQUAL(hist.aBin[2], 2);
+    CU_ASSERT_EQUAL(hist.count, 6);
+    CU_ASSERT_EQUAL(hist.minNs, 0);
+    CU_ASSERT_EQUAL(hist.maxNs, 3000);
+    CU_ASSERT_EQUAL(hist.sumNs, 9142);
+
+    // the last bin collects all long response times
+    dllk_resetResponseTimeHist(&hist);
+    dllk_updateResponseTimeHist(&hist, 1UL << (DLLK_RESPTIME_HIST_SHIFT + DLLK_RESPTIME_HIST_BINS - 2));
+    dllk_updateResponseTimeHist(&hist, 0xFFFFFFFFUL);
+    for (bin = 0; bin < DLLK_RESPTIME_HIST_BINS - 1; bin++)
+    {
+        CU_ASSERT_EQUAL(hist.aBin[bin], 0);
+    }
+    CU_ASSERT_EQUAL(hist.aBin[DLLK_RESPTIME_HIST_BINS - 1], 2);
+    CU_ASSERT_EQUAL(hist.minNs, 1UL << (DLLK_RESPTIME_HIST_SHIFT + DLLK_RESPTIME_HIST_BINS - 2));
+    CU_ASSERT_EQUAL(hist.maxNs, 0xFFFFFFFFUL);
+    CU_ASSERT_EQUAL(hist.sumNs, 0xFFFFFFFFULL + (1ULL << (DLLK_RESPTIME_HIST_SHIFT + DLLK_RESPTIME_HIST_BINS - 2)));
+
+    // the minimum is taken from the first response time after a reset
+    dllk_resetResponseTimeHist(&hist);
+    dllk_updateResponseTimeHist(&hist, 5000);
+    CU_ASSERT_EQUAL(hist.minNs, 5000);
+    CU_ASSERT_EQUAL(hist.maxNs, 5000);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test time stamps from capture times
+
+The function checks the conversion of the capture times with us and ns
+precision and the time difference of two time stamps.
+*/
+//------------------------------------------------------------------------------
+void test_dllkresptime_timeStamp(void)
+{
+    tEplTgtTimeStamp*   pTimeStamp;
+    tEplTgtTimeStamp    timeStamp;
+    struct timeval      tv;
+
+    pTimeStamp = EplTgtTimeStampAlloc();
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pTimeStamp);
+
+    tv.tv_sec = 1381234567;
+    tv.tv_usec = 999999;
+    EplTgtTimeStampSetTimeval(pTimeStamp, &tv, FALSE);
+    CU_ASSERT_EQUAL(pTimeStamp->timeStampNs, 1381234567999999000ULL);
+
+    tv.tv_sec = 1381234568;
+    tv.tv_usec = 250;
+    EplTgtTimeStampSetTimeval(&timeStamp, &tv, TRUE);
+    CU_ASSERT_EQUAL(timeStamp.timeStampNs, 1381234568000000250ULL);
+
+    CU_ASSERT_EQUAL(EplTgtTimeStampTimeDiffNs(pTimeStamp, &timeStamp), 1250);
+    // frames may be captured out of order, this must not wrap around
+    CU_ASSERT_EQUAL(EplTgtTimeStampTimeDiffNs(&timeStamp, pTimeStamp), 0);
+
+    EplTgtTimeStampCopy(pTimeStamp, &timeStamp);
+    CU_ASSERT_EQUAL(pTimeStamp->timeStampNs, timeStamp.timeStampNs);
+
+    EplTgtTimeStampFree(pTimeStamp);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test current time stamp and net time
+
+The function checks that the current time stamp and the net time are read
+from the same clock.
+*/
+//------------------------------------------------------------------------------
+void test_dllkresptime_netTime(void)
+{
+    unsigned long long  timeStampNs;
+    unsigned long long  netTimeNs;
+    tEplNetTime         netTime;
+
+    timeStampNs = EplTgtGetTimeStampNs();
+    EplTgtGetNetTime(&netTime);
+    netTimeNs = ((unsigned long long) netTime.m_dwSec * 1000000000ULL) + netTime.m_dwNanoSec;
+
+    CU_ASSERT_TRUE(netTime.m_dwNanoSec < 1000000000UL);
+    CU_ASSERT_TRUE(netTimeNs >= timeStampNs);
+    CU_ASSERT_TRUE((netTimeNs - timeStampNs) < 1000000000ULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test response times of savefile with us time stamps
+
+The function writes a savefile with several cycles of two CNs and checks
+the histograms computed from the savefile. A PRes which was not requested
+by a PReq is not accounted.
+*/
+//------------------------------------------------------------------------------
+void test_dllkresptime_savefileMicro(void)
+{
+    FILE*   pFile;
+    UINT32  cycleUs;
+    UINT    cycle;
+
+    pFile = createSavefile(SAVEFILE_MAGIC_MICRO);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pFile);
+
+    for (cycle = 0; cycle < 10; cycle++)
+    {
+        cycleUs = 1000 * cycle;
+        writeFrame(pFile, 100, cycleUs, kEplMsgTypeSoc, EPL_C_ADR_BROADCAST, EPL_C_ADR_MN_DEF_NODE_ID);
+        writeFrame(pFile, 100, cycleUs + 20, kEplMsgTypePreq, 1, EPL_C_ADR_MN_DEF_NODE_ID);
+        writeFrame(pFile, 100, cycleUs + 28 + cycle, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 1);
+        writeFrame(pFile, 100, cycleUs + 60, kEplMsgTypePreq, 2, EPL_C_ADR_MN_DEF_NODE_ID);
+        writeFrame(pFile, 100, cycleUs + 85, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 2);
+        // chained PRes without PReq
+        writeFrame(pFile, 100, cycleUs + 120, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 3);
+        writeFrame(pFile, 100, cycleUs + 150, kEplMsgTypeSoa, EPL_C_ADR_BROADCAST, EPL_C_ADR_MN_DEF_NODE_ID);
+    }
+
+    rewind(pFile);
+    CU_ASSERT_TRUE(evaluateSavefile(pFile, aHist_l));
+    fclose(pFile);
+
+    CU_ASSERT_EQUAL(aHist_l[0].count, 10);
+    CU_ASSERT_EQUAL(aHist_l[0].minNs, 8000);
+    CU_ASSERT_EQUAL(aHist_l[0].maxNs, 17000);
+    CU_ASSERT_EQUAL(aHist_l[0].sumNs, 125000);
+    CU_ASSERT_EQUAL(aHist_l[0].aBin[3], 1);     // 8 us
+    CU_ASSERT_EQUAL(aHist_l[0].aBin[4], 8);     // 9 us .. 16 us
+    CU_ASSERT_EQUAL(aHist_l[0].aBin[5], 1);     // 17 us
+
+    CU_ASSERT_EQUAL(aHist_l[1].count, 10);
+    CU_ASSERT_EQUAL(aHist_l[1].minNs, 25000);
+    CU_ASSERT_EQUAL(aHist_l[1].maxNs, 25000);
+    CU_ASSERT_EQUAL(aHist_l[1].aBin[5], 10);
+
+    CU_ASSERT_EQUAL(aHist_l[2].count, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test response times of savefile with ns time stamps
+
+The function writes a savefile with nanosecond time stamps, which also
+contains a response time crossing a second boundary, and checks the
+histogram computed from the savefile.
+*/
+//------------------------------------------------------------------------------
+void test_dllkresptime_savefileNano(void)
+{
+    FILE*   pFile;
+
+    pFile = createSavefile(SAVEFILE_MAGIC_NANO);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pFile);
+
+    writeFrame(pFile, 5, 999999500, kEplMsgTypePreq, 1, EPL_C_ADR_MN_DEF_NODE_ID);
+    writeFrame(pFile, 6, 487, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 1);
+    writeFrame(pFile, 6, 1000000, kEplMsgTypePreq, 1, EPL_C_ADR_MN_DEF_NODE_ID);
+    writeFrame(pFile, 6, 1001234, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 1);
+    writeFrame(pFile, 6, 2000000, kEplMsgTypePreq, 1, EPL_C_ADR_MN_DEF_NODE_ID);
+    writeFrame(pFile, 6, 2002047, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 1);
+    writeFrame(pFile, 6, 3000000, kEplMsgTypePreq, 1, EPL_C_ADR_MN_DEF_NODE_ID);
+    writeFrame(pFile, 6, 3002048, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 1);
+    // PReq without response (loss of PRes), the next PRes must not be accounted
+    writeFrame(pFile, 6, 4000000, kEplMsgTypePreq, 1, EPL_C_ADR_MN_DEF_NODE_ID);
+    writeFrame(pFile, 6, 4000500, kEplMsgTypePreq, 2, EPL_C_ADR_MN_DEF_NODE_ID);
+    writeFrame(pFile, 6, 4001000, kEplMsgTypePres, EPL_C_ADR_BROADCAST, 1);
+
+    rewind(pFile);
+    CU_ASSERT_TRUE(evaluateSavefile(pFile, aHist_l));
+    fclose(pFile);
+
+    CU_ASSERT_EQUAL(aHist_l[0].count, 4);
+    CU_ASSERT_EQUAL(aHist_l[0].minNs, 987);
+    CU_ASSERT_EQUAL(aHist_l[0].maxNs, 2048);
+    CU_ASSERT_EQUAL(aHist_l[0].sumNs, 987 + 1234 + 2047 + 2048);
+    CU_ASSERT_EQUAL(aHist_l[0].aBin[0], 1);
+    CU_ASSERT_EQUAL(aHist_l[0].aBin[1], 2);
+    CU_ASSERT_EQUAL(aHist_l[0].aBin[2], 1);
+
+    CU_ASSERT_EQUAL(aHist_l[1].count, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test response times of external savefile
+
+The function computes the histograms of a savefile which was captured on a
+real network. The name of the savefile is taken from the environment variable
+DLLKRESPTIME_SAVEFILE. If it is not set, the test passes without checks.
+*/
+//------------------------------------------------------------------------------
+void test_dllkresptime_savefileExternal(void)
+{
+    const char*     pszFileName;
+    FILE*           pFile;
+    UINT            index;
+    UINT            bin;
+
+    pszFileName = getenv(TEST_EXTERNAL_SAVEFILE_ENV);
+    if (pszFileName == NULL)
+        return;
+
+    pFile = fopen(pszFileName, "rb");
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pFile);
+    CU_ASSERT_TRUE(evaluateSavefile(pFile, aHist_l));
+    fclose(pFile);
+
+    for (index = 0; index < tabentries(aHist_l); index++)
+    {
+        if (aHist_l[index].count == 0)
+            continue;
+
+        printf("\nCN %3u: count %lu min %lu ns max %lu ns avg %llu ns\n", index + 1,
+               (ULONG) aHist_l[index].count, (ULONG) aHist_l[index].minNs,
+               (ULONG) aHist_l[index].maxNs, aHist_l[index].sumNs / aHist_l[index].count);
+        for (bin = 0; bin < DLLK_RESPTIME_HIST_BINS; bin++)
+        {
+            if (aHist_l[index].aBin[bin] != 0)
+            {
+                printf("        < %8lu ns: %lu\n", 1UL << (DLLK_RESPTIME_HIST_SHIFT + bin),
+                       (ULONG) aHist_l[index].aBin[bin]);
+            }
+        }
+    }
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create a savefile
+
+The function creates a temporary savefile and writes its global header.
+
+\param  magic_p             Magic number which selects the precision of the
+                            time stamps.
+
+\return The function returns the file or NULL on error.
+*/
+//------------------------------------------------------------------------------
+static FILE* createSavefile(UINT32 magic_p)
+{
+    FILE*               pFile;
+    tSavefileHeader     header;
+
+    pFile = tmpfile();
+    if (pFile == NULL)
+        return NULL;
+
+    EPL_MEMSET(&header, 0, sizeof(header));
+    header.magic = magic_p;
+    header.versionMajor = 2;
+    header.versionMinor = 4;
+    header.snapLen = 65535;
+    header.linkType = SAVEFILE_LINKTYPE_ETHERNET;
+    fwrite(&header, sizeof(header), 1, pFile);
+
+    return pFile;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write a frame to a savefile
+
+The function writes a POWERLINK frame of minimum size to a savefile.
+
+\param  pFile_p             Savefile.
+\param  sec_p               Capture time, seconds.
+\param  subSec_p            Capture time, us or ns depending on the savefile.
+\param  msgType_p           POWERLINK message type.
+\param  dstNodeId_p         Destination node ID.
+\param  srcNodeId_p         Source node ID.
+*/
+//------------------------------------------------------------------------------
+static void writeFrame(FILE* pFile_p, UINT32 sec_p, UINT32 subSec_p,
+                       tEplMsgType msgType_p, UINT dstNodeId_p, UINT srcNodeId_p)
+{
+    tSavefileRecord     record;
+    BYTE                abFrame[TEST_FRAME_SIZE];
+
+    EPL_MEMSET(abFrame, 0, sizeof(abFrame));
+    abFrame[offsetof(tEplFrame, m_be_abSrcMac) + 5] = (BYTE) srcNodeId_p;
+    abFrame[offsetof(tEplFrame, m_be_wEtherType)] = (BYTE) (EPL_C_DLL_ETHERTYPE_EPL >> 8);
+    abFrame[offsetof(tEplFrame, m_be_wEtherType) + 1] = (BYTE) EPL_C_DLL_ETHERTYPE_EPL;
+    abFrame[offsetof(tEplFrame, m_le_bMessageType)] = (BYTE) msgType_p;
+    abFrame[offsetof(tEplFrame, m_le_bDstNodeId)] = (BYTE) dstNodeId_p;
+    abFrame[offsetof(tEplFrame, m_le_bSrcNodeId)] = (BYTE) srcNodeId_p;
+
+    record.tsSec = sec_p;
+    record.tsSubSec = subSec_p;
+    record.capLen = sizeof(abFrame);
+    record.origLen = sizeof(abFrame);
+    fwrite(&record, sizeof(record), 1, pFile_p);
+    fwrite(abFrame, sizeof(abFrame), 1, pFile_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compute response time histograms of a savefile
+
+The function reads all frames of a savefile and computes the response time
+histograms in the same way as the MN: The capture time of a PReq is the start
+and the capture time of the PRes of the addressed CN is the end of the
+response time.
+
+\param  pFile_p             Savefile in native byte order.
+\param  aHist_p             Array of histograms, indexed by node ID - 1.
+
+\return The function returns TRUE if the savefile could be read.
+*/
+//------------------------------------------------------------------------------
+static BOOL evaluateSavefile(FILE* pFile_p, tDllkResponseTimeHist* aHist_p)
+{
+    tSavefileHeader     header;
+    tSavefileRecord     record;
+    BYTE                abFrame[SAVEFILE_MAX_FRAME_SIZE];
+    BOOL                fNanoPrecision;
+    tEplTgtTimeStamp    preqTimeStamp;
+    tEplTgtTimeStamp    timeStamp;
+    struct timeval      tv;
+    UINT                preqNodeId = EPL_C_ADR_INVALID;
+    UINT                nodeId;
+    UINT                index;
+
+    for (index = 0; index < EPL_C_ADR_BROADCAST; index++)
+    {
+        dllk_resetResponseTimeHist(&aHist_p[index]);
+    }
+
+    if (fread(&header, sizeof(header), 1, pFile_p) != 1)
+        return FALSE;
+
+    if (header.magic == SAVEFILE_MAGIC_MICRO)
+        fNanoPrecision = FALSE;
+    else if (header.magic == SAVEFILE_MAGIC_NANO)
+        fNanoPrecision = TRUE;
+    else
+        return FALSE;
+
+    if (header.linkType != SAVEFILE_LINKTYPE_ETHERNET)
+        return FALSE;
+
+    while (fread(&record, sizeof(record), 1, pFile_p) == 1)
+    {
+        if (record.capLen > sizeof(abFrame))
+        {   // no POWERLINK frame
+            if (fseek(pFile_p, record.capLen, SEEK_CUR) != 0)
+                return FALSE;
+            continue;
+        }
+
+        if (fread(abFrame, record.capLen, 1, pFile_p) != 1)
+            return FALSE;
+
+        if ((record.capLen <= offsetof(tEplFrame, m_le_bSrcNodeId))
+            || (abFrame[offsetof(tEplFrame, m_be_wEtherType)] != (BYTE) (EPL_C_DLL_ETHERTYPE_EPL >> 8))
+            || (abFrame[offsetof(tEplFrame, m_be_wEtherType) + 1] != (BYTE) EPL_C_DLL_ETHERTYPE_EPL))
+        {   // no POWERLINK frame
+            continue;
+        }
+
+        tv.tv_sec = record.tsSec;
+        tv.tv_usec = record.tsSubSec;
+        EplTgtTimeStampSetTimeval(&timeStamp, &tv, fNanoPrecision);
+
+        switch (abFrame[offsetof(tEplFrame, m_le_bMessageType)])
+        {
+            case kEplMsgTypePreq:
+                preqNodeId = abFrame[offsetof(tEplFrame, m_le_bDstNodeId)];
+                EplTgtTimeStampCopy(&preqTimeStamp, &timeStamp);
+                break;
+
+            case kEplMsgTypePres:
+                nodeId = abFrame[offsetof(tEplFrame, m_le_bSrcNodeId)];
+                if ((nodeId != EPL_C_ADR_INVALID) && (nodeId == preqNodeId))
+                {
+                    dllk_updateResponseTimeHist(&aHist_p[nodeId - 1],
+                                                EplTgtTimeStampTimeDiffNs(&preqTimeStamp, &timeStamp));
+                    preqNodeId = EPL_C_ADR_INVALID;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,486 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for pcap Ethernet driver filter
+
+This file contains the unit test functions for the filter expression builder
+of the pcap Ethernet driver.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+#ifdef TEST_EDRVPCAP_LIBPCAP
+#include <pcap.h>
+#endif
+
+#include <EplInc.h>
+#include <EdrvPcapFilter.h>
+
+#include "test-edrvpcapfilter.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_BASIC_EXPR     "ether src 00:12:34:56:78:9a or ether dst 00:12:34:56:78:9a" \
+                            " or ether broadcast"
+
+#define TEST_FRAME_SIZE     60
+
+#ifndef PCAP_NETMASK_UNKNOWN
+#define PCAP_NETMASK_UNKNOWN    0xffffffff      // not defined by libpcap < 1.1
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+#ifdef TEST_EDRVPCAP_LIBPCAP
+/**
+\brief  Frames of the traffic test
+
+POWERLINK frames of the isochronous phase are mixed with frames of other
+protocols on the same network.
+*/
+typedef enum
+{
+    kTestFramePres1         = 0,        ///< PRes of node 1
+    kTestFramePres2         = 1,        ///< PRes of node 2
+    kTestFramePres3         = 2,        ///< PRes of node 3
+    kTestFrameSoc           = 3,        ///< SoC
+    kTestFramePreq          = 4,        ///< PReq to the own node
+    kTestFrameAsnd          = 5,        ///< ASnd to another node
+    kTestFrameOwn           = 6,        ///< PRes sent by the own node
+    kTestFrameArp           = 7,        ///< ARP request (broadcast)
+    kTestFrameIp            = 8,        ///< IPv4 frame to another node
+    kTestFrameIpv6          = 9,        ///< IPv6 frame to a multicast address
+    kTestFrameIpPresMac     = 10,       ///< IPv4 frame to the PRes multicast address
+    kTestFrameCount         = 11,
+} tTestFrame;
+#endif
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void initFilterSet(void);
+static void setupPresFilter(tEdrvFilter* pFilter_p, BYTE nodeId_p, BOOL fEnable_p);
+#ifdef TEST_EDRVPCAP_LIBPCAP
+static void setupFrame(tTestFrame frame_p, const BYTE* pDstMac_p, const BYTE* pSrcMac_p,
+                       WORD etherType_p, BYTE messageType_p, BYTE srcNodeId_p);
+static void setupTraffic(void);
+static void checkTraffic(const BOOL* afPass_p);
+#endif
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvPcapFilterSet   filterSet_l;
+static char                 szExpr_l[EDRVPCAP_FILTER_EXPR_SIZE];
+static BYTE                 abMyMacAddr_l[6] = {0x00, 0x12, 0x34, 0x56, 0x78, 0x9A};
+static BYTE                 abPresMac_l[6] = {0x01, 0x11, 0x1E, 0x00, 0x00, 0x02};
+static BYTE                 abSocMac_l[6] = {0x01, 0x11, 0x1E, 0x00, 0x00, 0x01};
+#ifdef TEST_EDRVPCAP_LIBPCAP
+static BYTE                 abCnMac_l[6] = {0x00, 0x12, 0x34, 0x56, 0x78, 0x01};
+static BYTE                 abBroadcastMac_l[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static BYTE                 abIpv6Mac_l[6] = {0x33, 0x33, 0x00, 0x00, 0x00, 0x01};
+static BYTE                 aabFrame_l[kTestFrameCount][TEST_FRAME_SIZE];
+#endif
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test expression without filter entries
+
+The function checks that own, unicast and broadcast frames pass if neither
+filter nor multicast entries are set.
+*/
+//------------------------------------------------------------------------------
+void test_edrvpcapfilter_basicExpr(void)
+{
+    initFilterSet();
+
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, TEST_BASIC_EXPR);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test expression of Rx filter entries
+
+The function checks that enabled Rx filter entries are translated into masked
+comparisons, that bytes without mask bits are omitted and that disabled
+entries are ignored.
+*/
+//------------------------------------------------------------------------------
+void test_edrvpcapfilter_filterEntries(void)
+{
+    tEdrvFilter     aFilter[3];
+
+    initFilterSet();
+
+    setupPresFilter(&aFilter[0], 1, TRUE);
+    setupPresFilter(&aFilter[1], 2, FALSE);
+    setupPresFilter(&aFilter[2], 3, TRUE);
+
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, aFilter, 3), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, TEST_BASIC_EXPR
+        " or (ether[0:4] & 0xffffffff = 0x1111e00 and ether[4:4] & 0xffff0000 = 0x20000"
+        " and ether[12:4] & 0xffffff00 = 0x88ab0400 and ether[16:4] & 0xff000000 = 0x1000000)"
+        " or (ether[0:4] & 0xffffffff = 0x1111e00 and ether[4:4] & 0xffff0000 = 0x20000"
+        " and ether[12:4] & 0xffffff00 = 0x88ab0400 and ether[16:4] & 0xff000000 = 0x3000000)");
+
+    // multicast entries are ignored if Rx filter entries are set
+    CU_ASSERT_EQUAL(EdrvPcapAddMulticast(&filterSet_l, abSocMac_l), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_PTR_NULL(strstr(szExpr_l, "ether dst 01:11:1e:00:00:01"));
+
+    // removing the filter entries falls back to the multicast entries
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, NULL, 0), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, TEST_BASIC_EXPR " or ether dst 01:11:1e:00:00:01");
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test expression of multicast entries
+
+The function checks adding and removing of multicast entries.
+*/
+//------------------------------------------------------------------------------
+void test_edrvpcapfilter_multicast(void)
+{
+    BYTE        abMac[6] = {0x01, 0x11, 0x1E, 0x00, 0x00, 0x00};
+    UINT        index;
+
+    initFilterSet();
+
+    CU_ASSERT_EQUAL(EdrvPcapAddMulticast(&filterSet_l, abSocMac_l), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapAddMulticast(&filterSet_l, abPresMac_l), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapAddMulticast(&filterSet_l, abSocMac_l), kEplSuccessful);
+    CU_ASSERT_EQUAL(filterSet_l.multicastCount, 2);
+
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, TEST_BASIC_EXPR
+        " or ether dst 01:11:1e:00:00:01 or ether dst 01:11:1e:00:00:02");
+
+    CU_ASSERT_EQUAL(EdrvPcapRemoveMulticast(&filterSet_l, abSocMac_l), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, TEST_BASIC_EXPR " or ether dst 01:11:1e:00:00:02");
+
+    // fill up all multicast entries
+    for (index = filterSet_l.multicastCount; index < EDRVPCAP_MAX_MULTICAST; index++)
+    {
+        abMac[5] = (BYTE)(0x10 + index);
+        CU_ASSERT_EQUAL(EdrvPcapAddMulticast(&filterSet_l, abMac), kEplSuccessful);
+    }
+    abMac[5] = 0xFF;
+    CU_ASSERT_EQUAL(EdrvPcapAddMulticast(&filterSet_l, abMac), kEplEdrvNoFreeBufEntry);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test filter sets which pass all frames
+
+The function checks that an empty expression is built if the DLL sets more
+filter entries than supported or an enabled filter entry has no mask bits.
+*/
+//------------------------------------------------------------------------------
+void test_edrvpcapfilter_passAll(void)
+{
+    static tEdrvFilter  aFilter[EDRVPCAP_MAX_FILTERS + 1];
+    UINT                index;
+
+    initFilterSet();
+
+    for (index = 0; index < EDRVPCAP_MAX_FILTERS + 1; index++)
+        setupPresFilter(&aFilter[index], (BYTE)(index + 1), TRUE);
+
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, aFilter, EDRVPCAP_MAX_FILTERS + 1),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, "");
+
+    // the maximum number of filter entries fits into the expression buffer
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, aFilter, EDRVPCAP_MAX_FILTERS),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_NOT_EQUAL(strlen(szExpr_l), 0);
+
+    // an enabled entry without mask bits matches every frame
+    EPL_MEMSET(aFilter[1].m_abFilterMask, 0, sizeof(aFilter[1].m_abFilterMask));
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, aFilter, 2), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, "");
+
+    // unless it is disabled
+    aFilter[1].m_fEnable = FALSE;
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, aFilter, 2), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    CU_ASSERT_NOT_EQUAL(strlen(szExpr_l), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test expression buffer overflow
+
+The function checks that an empty expression and an error are returned if the
+expression doesn't fit into the buffer.
+*/
+//------------------------------------------------------------------------------
+void test_edrvpcapfilter_bufferOverflow(void)
+{
+    initFilterSet();
+
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, 0), kEplEdrvInvalidParam);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(TEST_BASIC_EXPR) - 1),
+                    kEplEdrvInvalidParam);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, "");
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(TEST_BASIC_EXPR)),
+                    kEplSuccessful);
+    CU_ASSERT_STRING_EQUAL(szExpr_l, TEST_BASIC_EXPR);
+}
+
+#ifdef TEST_EDRVPCAP_LIBPCAP
+//------------------------------------------------------------------------------
+/**
+\brief  Test filter expressions on frames
+
+The function compiles the expressions with libpcap and applies them to a mix
+of POWERLINK and other frames. It checks that exactly the frames needed by the
+DLL pass the filter.
+*/
+//------------------------------------------------------------------------------
+void test_edrvpcapfilter_traffic(void)
+{
+    tEdrvFilter     aFilter[3];
+    static const BOOL   afPassFilter[kTestFrameCount] =
+        {TRUE, FALSE, TRUE, FALSE, TRUE, FALSE, TRUE, TRUE, FALSE, FALSE, FALSE};
+    static const BOOL   afPassMulticast[kTestFrameCount] =
+        {FALSE, FALSE, FALSE, TRUE, TRUE, FALSE, TRUE, TRUE, FALSE, FALSE, FALSE};
+    static const BOOL   afPassAll[kTestFrameCount] =
+        {TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE};
+
+    initFilterSet();
+    setupTraffic();
+
+    // Rx filter entries for the PRes of node 1 and 3
+    setupPresFilter(&aFilter[0], 1, TRUE);
+    setupPresFilter(&aFilter[1], 2, FALSE);
+    setupPresFilter(&aFilter[2], 3, TRUE);
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, aFilter, 3), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapAddMulticast(&filterSet_l, abSocMac_l), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    checkTraffic(afPassFilter);
+
+    // multicast entries only
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, NULL, 0), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    checkTraffic(afPassMulticast);
+
+    // an entry without mask bits passes all frames
+    EPL_MEMSET(aFilter[0].m_abFilterMask, 0, sizeof(aFilter[0].m_abFilterMask));
+    CU_ASSERT_EQUAL(EdrvPcapSetFilterEntries(&filterSet_l, aFilter, 1), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvPcapBuildFilterExpr(&filterSet_l, szExpr_l, sizeof(szExpr_l)),
+                    kEplSuccessful);
+    checkTraffic(afPassAll);
+}
+#endif
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the filter set for a test
+*/
+//------------------------------------------------------------------------------
+static void initFilterSet(void)
+{
+    EPL_MEMSET(&filterSet_l, 0, sizeof(filterSet_l));
+    EPL_MEMCPY(filterSet_l.abMyMacAddr, abMyMacAddr_l, 6);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up an Rx filter entry for PRes frames
+
+The function sets up a filter entry in the same way as the DLL for PRes frames
+of a specific CN.
+
+\param  pFilter_p           Pointer to the filter entry.
+\param  nodeId_p            Source node ID of the PRes frames.
+\param  fEnable_p           Enable flag of the filter entry.
+*/
+//------------------------------------------------------------------------------
+static void setupPresFilter(tEdrvFilter* pFilter_p, BYTE nodeId_p, BOOL fEnable_p)
+{
+    EPL_MEMSET(pFilter_p, 0, sizeof(tEdrvFilter));
+    pFilter_p->m_fEnable = fEnable_p;
+
+    EPL_MEMCPY(&pFilter_p->m_abFilterValue[0], abPresMac_l, 6);
+    EPL_MEMSET(&pFilter_p->m_abFilterMask[0], 0xFF, 6);
+    pFilter_p->m_abFilterValue[12] = 0x88;
+    pFilter_p->m_abFilterValue[13] = 0xAB;
+    pFilter_p->m_abFilterValue[14] = 0x04;
+    pFilter_p->m_abFilterValue[16] = nodeId_p;
+    EPL_MEMSET(&pFilter_p->m_abFilterMask[12], 0xFF, 3);
+    pFilter_p->m_abFilterMask[16] = 0xFF;
+}
+
+#ifdef TEST_EDRVPCAP_LIBPCAP
+//------------------------------------------------------------------------------
+/**
+\brief  Set up a test frame
+
+\param  frame_p             Frame which is set up.
+\param  pDstMac_p           Destination MAC address.
+\param  pSrcMac_p           Source MAC address.
+\param  etherType_p         Ethertype of the frame.
+\param  messageType_p       POWERLINK message type (first payload byte).
+\param  srcNodeId_p         POWERLINK source node ID (third payload byte).
+*/
+//------------------------------------------------------------------------------
+static void setupFrame(tTestFrame frame_p, const BYTE* pDstMac_p, const BYTE* pSrcMac_p,
+                       WORD etherType_p, BYTE messageType_p, BYTE srcNodeId_p)
+{
+    BYTE*   pFrame = aabFrame_l[frame_p];
+
+    EPL_MEMSET(pFrame, 0, TEST_FRAME_SIZE);
+    EPL_MEMCPY(&pFrame[0], pDstMac_p, 6);
+    EPL_MEMCPY(&pFrame[6], pSrcMac_p, 6);
+    pFrame[12] = (BYTE)(etherType_p >> 8);
+    pFrame[13] = (BYTE)etherType_p;
+    pFrame[14] = messageType_p;
+    pFrame[16] = srcNodeId_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up the frames of the traffic test
+*/
+//------------------------------------------------------------------------------
+static void setupTraffic(void)
+{
+    setupFrame(kTestFramePres1, abPresMac_l, abCnMac_l, 0x88AB, 0x04, 1);
+    setupFrame(kTestFramePres2, abPresMac_l, abCnMac_l, 0x88AB, 0x04, 2);
+    setupFrame(kTestFramePres3, abPresMac_l, abCnMac_l, 0x88AB, 0x04, 3);
+    setupFrame(kTestFrameSoc, abSocMac_l, abCnMac_l, 0x88AB, 0x01, 240);
+    setupFrame(kTestFramePreq, abMyMacAddr_l, abCnMac_l, 0x88AB, 0x03, 240);
+    setupFrame(kTestFrameAsnd, abCnMac_l, abCnMac_l, 0x88AB, 0x06, 240);
+    setupFrame(kTestFrameOwn, abPresMac_l, abMyMacAddr_l, 0x88AB, 0x04, 5);
+    setupFrame(kTestFrameArp, abBroadcastMac_l, abCnMac_l, 0x0806, 0x00, 0);
+    setupFrame(kTestFrameIp, abCnMac_l, abCnMac_l, 0x0800, 0x45, 0);
+    setupFrame(kTestFrameIpv6, abIpv6Mac_l, abCnMac_l, 0x86DD, 0x60, 0);
+    setupFrame(kTestFrameIpPresMac, abPresMac_l, abCnMac_l, 0x0800, 0x04, 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Apply the current expression to the test frames
+
+The function compiles the expression in szExpr_l and checks for each test
+frame whether it passes the filter.
+
+\param  afPass_p            Expected result for each frame of tTestFrame.
+*/
+//------------------------------------------------------------------------------
+static void checkTraffic(const BOOL* afPass_p)
+{
+    pcap_t*             pPcap;
+    struct bpf_program  program;
+    struct pcap_pkthdr  header;
+    UINT                index;
+    BOOL                fPass;
+
+    pPcap = pcap_open_dead(DLT_EN10MB, TEST_FRAME_SIZE);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pPcap);
+    CU_ASSERT_EQUAL_FATAL(pcap_compile(pPcap, &program, szExpr_l, 1, PCAP_NETMASK_UNKNOWN), 0);
+
+    EPL_MEMSET(&header, 0, sizeof(header));
+    header.caplen = TEST_FRAME_SIZE;
+    header.len = TEST_FRAME_SIZE;
+
+    for (index = 0; index < kTestFrameCount; index++)
+    {
+        fPass = (pcap_offline_filter(&program, &header, aabFrame_l[index]) != 0) ? TRUE : FALSE;
+        if (fPass != afPass_p[index])
+        {
+            printf("\n    frame %u: %s", index, (fPass != FALSE) ? "passed" : "dropped");
+            CU_FAIL("unexpected filter result");
+        }
+    }
+
+    pcap_freecode(&program);
+    pcap_close(pPcap);
+}
+#endif
@@ -0,0 +1,746 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for simulated Ethernet driver
+
+This file contains the unit test functions for the simulated Ethernet driver.
+The tests attach the Edrv module and additional responder ports to a private
+simulated segment and check the frame delivery, the link latency and the
+frame loss.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <EdrvSim.h>
+
+#include "test-edrvsim.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_FRAME_LEN              60
+#define TEST_TIMEOUT_MS             5000
+#define TEST_LATENCY_NS             20000000
+#define TEST_LOSS_PPM               250000
+#define TEST_LOSS_FRAMES            384
+#define TEST_LOSS_BATCH             32
+#define TEST_NUM_RESPONDERS         239
+#define TEST_NUM_CYCLES             3
+
+#define TEST_FRAME_TYPE_OFFSET      14
+#define TEST_FRAME_NODE_OFFSET      15
+#define TEST_FRAME_TYPE_REQ         0x03
+#define TEST_FRAME_TYPE_RES         0x04
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Receive record of a port
+*/
+typedef struct
+{
+    pthread_mutex_t     mutex;
+    pthread_cond_t      cond;
+    UINT                rxCount;
+    UINT                txCount;
+    UINT64              lastRxTime;
+    UINT                lastLen;
+    BYTE                aLastFrame[EDRVSIM_MAX_FRAME_SIZE];
+    UINT                aResCount[TEST_NUM_RESPONDERS + 1];
+} tRxRecord;
+
+/**
+\brief  Lightweight responder
+*/
+typedef struct
+{
+    tEdrvSimPort*       pPort;
+    UINT                nodeId;
+    BYTE                aMacAddr[6];
+} tResponder;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void getSegmentName(char* pszName_p, size_t size_p);
+static BOOL segmentExists(const char* pszSegment_p);
+static UINT64 getTimeNs(void);
+static void initRecord(tRxRecord* pRecord_p);
+static void putFrame(tRxRecord* pRecord_p, BYTE* pbFrame_p, UINT frameLen_p);
+static BOOL waitRxCount(tRxRecord* pRecord_p, UINT count_p);
+static BOOL waitTxCount(tRxRecord* pRecord_p, UINT count_p);
+static void buildFrame(BYTE* pbFrame_p, BYTE* pbSrcMac_p, BYTE type_p, BYTE nodeId_p);
+static tEdrvReleaseRxBuffer edrvRxHandler(tEdrvRxBuffer* pRxBuffer_p);
+static void edrvTxHandler(tEdrvTxBuffer* pTxBuffer_p);
+static void portRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                          UINT frameLen_p);
+static void responderRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                               UINT frameLen_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tRxRecord    edrvRecord_l;
+static tRxRecord    aPortRecord_l[3];
+static tResponder   aResponder_l[TEST_NUM_RESPONDERS + 1];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test frame exchange between Edrv and simulated ports
+
+The test checks that a frame sent by one port is delivered to all other ports
+of the segment, but not to the sender itself, and that the Tx handler of the
+Edrv module is called.
+*/
+//------------------------------------------------------------------------------
+void test_edrvsim_frameExchange(void)
+{
+    char                aSegment[32];
+    tEdrvInitParam      initParam;
+    tEdrvTxBuffer       txBuffer;
+    tEdrvSimPort*       apPort[2];
+    BYTE                aaMacAddr[2][6];
+    BYTE                aFrame[TEST_FRAME_LEN];
+    tEdrvSimStatistics  statistics;
+    UINT                i;
+
+    getSegmentName(aSegment, sizeof(aSegment));
+    initRecord(&edrvRecord_l);
+    initRecord(&aPortRecord_l[0]);
+    initRecord(&aPortRecord_l[1]);
+
+    EPL_MEMSET(&initParam, 0, sizeof(initParam));
+    initParam.m_pfnRxHandler = edrvRxHandler;
+    initParam.m_HwParam.m_pszDevName = aSegment;
+    CU_ASSERT_EQUAL_FATAL(EdrvInit(&initParam), kEplSuccessful);
+    CU_ASSERT_EQUAL(initParam.m_abMyMacAddr[0], 0x02);
+
+    EPL_MEMSET(aaMacAddr, 0, sizeof(aaMacAddr));
+    for (i = 0; i < 2; i++)
+    {
+        CU_ASSERT_EQUAL_FATAL(EdrvSimAttachPort(aSegment, aaMacAddr[i], portRxHandler,
+                                                &aPortRecord_l[i], &apPort[i]),
+                              kEplSuccessful);
+        CU_ASSERT(EPL_MEMCMP(aaMacAddr[i], initParam.m_abMyMacAddr, 6) != 0);
+    }
+    CU_ASSERT(EPL_MEMCMP(aaMacAddr[0], aaMacAddr[1], 6) != 0);
+
+    // frame of Edrv module reaches both ports
+    EPL_MEMSET(&txBuffer, 0, sizeof(txBuffer));
+    txBuffer.m_uiMaxBufferLen = TEST_FRAME_LEN;
+    txBuffer.m_pfnTxHandler = edrvTxHandler;
+    CU_ASSERT_EQUAL_FATAL(EdrvAllocTxMsgBuffer(&txBuffer), kEplSuccessful);
+    buildFrame(txBuffer.m_pbBuffer, initParam.m_abMyMacAddr, TEST_FRAME_TYPE_REQ, 1);
+    txBuffer.m_uiTxMsgLen = TEST_FRAME_LEN;
+    CU_ASSERT_EQUAL(EdrvSendTxMsg(&txBuffer), kEplSuccessful);
+
+    CU_ASSERT(waitTxCount(&edrvRecord_l, 1));
+    CU_ASSERT(txBuffer.m_BufferNumber.m_pVal == NULL);
+    for (i = 0; i < 2; i++)
+    {
+        CU_ASSERT(waitRxCount(&aPortRecord_l[i], 1));
+        CU_ASSERT_EQUAL(aPortRecord_l[i].lastLen, TEST_FRAME_LEN);
+        CU_ASSERT(EPL_MEMCMP(aPortRecord_l[i].aLastFrame, txBuffer.m_pbBuffer,
+                             TEST_FRAME_LEN) == 0);
+    }
+
+    // frame of a simulated port reaches the Edrv module and the other port
+    buildFrame(aFrame, aaMacAddr[0], TEST_FRAME_TYPE_RES, 1);
+    CU_ASSERT_EQUAL(EdrvSimSendFrame(apPort[0], aFrame, TEST_FRAME_LEN), kEplSuccessful);
+    CU_ASSERT(waitRxCount(&edrvRecord_l, 1));
+    CU_ASSERT(waitRxCount(&aPortRecord_l[1], 2));
+    CU_ASSERT(EPL_MEMCMP(edrvRecord_l.aLastFrame, aFrame, TEST_FRAME_LEN) == 0);
+
+    // injected frame only reaches the Edrv module
+    aFrame[TEST_FRAME_NODE_OFFSET] = 2;
+    EdrvRxInterruptHandler(kEdrvBufferLastInFrame, aFrame, TEST_FRAME_LEN);
+    CU_ASSERT(waitRxCount(&edrvRecord_l, 2));
+    CU_ASSERT_EQUAL(edrvRecord_l.aLastFrame[TEST_FRAME_NODE_OFFSET], 2);
+
+    // no port receives its own frames
+    usleep(10000);
+    CU_ASSERT_EQUAL(aPortRecord_l[0].rxCount, 1);
+    CU_ASSERT_EQUAL(aPortRecord_l[1].rxCount, 2);
+    CU_ASSERT_EQUAL(edrvRecord_l.rxCount, 2);
+
+    CU_ASSERT_EQUAL(EdrvSimGetStatistics(EdrvSimGetEdrvPort(), &statistics), kEplSuccessful);
+    CU_ASSERT_EQUAL(statistics.txFrameCount, 1);
+    CU_ASSERT_EQUAL(statistics.rxFrameCount, 2);
+    CU_ASSERT_EQUAL(statistics.lossCount, 0);
+    CU_ASSERT_EQUAL(statistics.overflowCount, 0);
+
+    CU_ASSERT_EQUAL(EdrvSendTxMsg(&txBuffer), kEplSuccessful);
+    CU_ASSERT(waitTxCount(&edrvRecord_l, 2));
+
+    EdrvSimDetachPort(apPort[0]);
+    EdrvSimDetachPort(apPort[1]);
+    EdrvReleaseTxMsgBuffer(&txBuffer);
+    CU_ASSERT_EQUAL(EdrvShutdown(), kEplSuccessful);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test link latency
+
+The test checks that a frame is not delivered before the configured link
+latency has passed.
+*/
+//------------------------------------------------------------------------------
+void test_edrvsim_latency(void)
+{
+    char                aSegment[32];
+    tEdrvSimLinkParam   linkParam;
+    tEdrvSimPort*       apPort[2];
+    BYTE                aaMacAddr[2][6];
+    BYTE                aFrame[TEST_FRAME_LEN];
+    UINT64              sendTime;
+    UINT                i;
+
+    getSegmentName(aSegment, sizeof(aSegment));
+    initRecord(&aPortRecord_l[0]);
+    initRecord(&aPortRecord_l[1]);
+
+    linkParam.latencyNs = TEST_LATENCY_NS;
+    linkParam.lossPpm = 0;
+    linkParam.seed = 0;
+    CU_ASSERT_EQUAL_FATAL(EdrvSimSetLinkParam(aSegment, &linkParam), kEplSuccessful);
+
+    EPL_MEMSET(aaMacAddr, 0, sizeof(aaMacAddr));
+    for (i = 0; i < 2; i++)
+    {
+        CU_ASSERT_EQUAL_FATAL(EdrvSimAttachPort(aSegment, aaMacAddr[i], portRxHandler,
+                                                &aPortRecord_l[i], &apPort[i]),
+                              kEplSuccessful);
+    }
+
+    EPL_MEMSET(&linkParam, 0, sizeof(linkParam));
+    CU_ASSERT_EQUAL(EdrvSimGetLinkParam(aSegment, &linkParam), kEplSuccessful);
+    CU_ASSERT_EQUAL(linkParam.latencyNs, TEST_LATENCY_NS);
+    CU_ASSERT_EQUAL(linkParam.lossPpm, 0);
+
+    buildFrame(aFrame, aaMacAddr[0], TEST_FRAME_TYPE_REQ, 1);
+    sendTime = getTimeNs();
+    CU_ASSERT_EQUAL(EdrvSimSendFrame(apPort[0], aFrame, TEST_FRAME_LEN), kEplSuccessful);
+    CU_ASSERT(waitRxCount(&aPortRecord_l[1], 1));
+    CU_ASSERT(aPortRecord_l[1].lastRxTime - sendTime >= TEST_LATENCY_NS);
+
+    EdrvSimDetachPort(apPort[0]);
+    EdrvSimDetachPort(apPort[1]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test frame loss
+
+The test checks that the loss generator drops the configured share of frames
+independently for each receiver and that the statistics account for every
+transmitted frame.
+*/
+//------------------------------------------------------------------------------
+void test_edrvsim_loss(void)
+{
+    char                aSegment[32];
+    tEdrvSimLinkParam   linkParam;
+    tEdrvSimPort*       apPort[3];
+    BYTE                aaMacAddr[3][6];
+    BYTE                aFrame[TEST_FRAME_LEN];
+    tEdrvSimStatistics  aStatistics[3];
+    UINT                sent;
+    UINT                i;
+    int                 timeout;
+
+    getSegmentName(aSegment, sizeof(aSegment));
+
+    linkParam.latencyNs = 0;
+    linkParam.lossPpm = TEST_LOSS_PPM;
+    linkParam.seed = 1234;
+    CU_ASSERT_EQUAL_FATAL(EdrvSimSetLinkParam(aSegment, &linkParam), kEplSuccessful);
+    linkParam.lossPpm = EDRVSIM_LOSS_PPM_MAX + 1;
+    CU_ASSERT_EQUAL(EdrvSimSetLinkParam(aSegment, &linkParam), kEplEdrvInvalidParam);
+
+    EPL_MEMSET(aaMacAddr, 0, sizeof(aaMacAddr));
+    for (i = 0; i < 3; i++)
+    {
+        initRecord(&aPortRecord_l[i]);
+        CU_ASSERT_EQUAL_FATAL(EdrvSimAttachPort(aSegment, aaMacAddr[i], portRxHandler,
+                                                &aPortRecord_l[i], &apPort[i]),
+                              kEplSuccessful);
+    }
+
+    buildFrame(aFrame, aaMacAddr[0], TEST_FRAME_TYPE_REQ, 1);
+    for (sent = 0; sent < TEST_LOSS_FRAMES; )
+    {
+        for (i = 0; i < TEST_LOSS_BATCH; i++, sent++)
+            EdrvSimSendFrame(apPort[0], aFrame, TEST_FRAME_LEN);
+
+        // wait until the receivers have processed the batch
+        for (timeout = TEST_TIMEOUT_MS; timeout > 0; timeout--)
+        {
+            EdrvSimGetStatistics(apPort[1], &aStatistics[1]);
+            EdrvSimGetStatistics(apPort[2], &aStatistics[2]);
+            if ((aStatistics[1].rxFrameCount + aStatistics[1].lossCount +
+                 aStatistics[1].overflowCount >= sent) &&
+                (aStatistics[2].rxFrameCount + aStatistics[2].lossCount +
+                 aStatistics[2].overflowCount >= sent))
+                break;
+            usleep(1000);
+        }
+    }
+    usleep(10000);
+
+    for (i = 0; i < 3; i++)
+        EdrvSimGetStatistics(apPort[i], &aStatistics[i]);
+
+    CU_ASSERT_EQUAL(aStatistics[0].txFrameCount, TEST_LOSS_FRAMES);
+    CU_ASSERT_EQUAL(aStatistics[0].rxFrameCount, 0);
+    for (i = 1; i < 3; i++)
+    {
+        CU_ASSERT_EQUAL(aStatistics[i].overflowCount, 0);
+        CU_ASSERT_EQUAL(aStatistics[i].rxFrameCount + aStatistics[i].lossCount,
+                        TEST_LOSS_FRAMES);
+        CU_ASSERT_EQUAL(aStatistics[i].rxFrameCount, aPortRecord_l[i].rxCount);
+        CU_ASSERT(aStatistics[i].lossCount > TEST_LOSS_FRAMES / 8);
+        CU_ASSERT(aStatistics[i].lossCount < TEST_LOSS_FRAMES * 3 / 8);
+    }
+    // loss is decided for each receiver separately
+    CU_ASSERT(aStatistics[1].lossCount != aStatistics[2].lossCount);
+
+    for (i = 0; i < 3; i++)
+        EdrvSimDetachPort(apPort[i]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test removal of segments
+
+The test checks that a segment created by EdrvSimSetLinkParam() keeps its
+parameters until a port attaches, and that its shared memory object is removed
+when the last port detaches or, if no port ever attached, on EdrvShutdown().
+*/
+//------------------------------------------------------------------------------
+void test_edrvsim_segmentRemoval(void)
+{
+    char                aSegment[32];
+    tEdrvSimLinkParam   linkParam;
+    tEdrvSimPort*       pPort;
+    BYTE                aMacAddr[6];
+
+    // segment without any port is removed on shutdown
+    getSegmentName(aSegment, sizeof(aSegment));
+    linkParam.latencyNs = TEST_LATENCY_NS;
+    linkParam.lossPpm = 0;
+    linkParam.seed = 0;
+    CU_ASSERT_EQUAL_FATAL(EdrvSimSetLinkParam(aSegment, &linkParam), kEplSuccessful);
+    CU_ASSERT_EQUAL(EdrvSimSetLinkParam(aSegment, &linkParam), kEplSuccessful);
+    CU_ASSERT(segmentExists(aSegment));
+
+    CU_ASSERT_EQUAL(EdrvShutdown(), kEplSuccessful);
+    CU_ASSERT_FALSE(segmentExists(aSegment));
+
+    // segment with ports is removed when the last port detaches
+    getSegmentName(aSegment, sizeof(aSegment));
+    CU_ASSERT_EQUAL_FATAL(EdrvSimSetLinkParam(aSegment, &linkParam), kEplSuccessful);
+
+    EPL_MEMSET(aMacAddr, 0, sizeof(aMacAddr));
+    CU_ASSERT_EQUAL_FATAL(EdrvSimAttachPort(aSegment, aMacAddr, portRxHandler,
+                                            &aPortRecord_l[0], &pPort),
+                          kEplSuccessful);
+    EPL_MEMSET(&linkParam, 0, sizeof(linkParam));
+    CU_ASSERT_EQUAL(EdrvSimGetLinkParam(aSegment, &linkParam), kEplSuccessful);
+    CU_ASSERT_EQUAL(linkParam.latencyNs, TEST_LATENCY_NS);
+
+    EdrvSimDetachPort(pPort);
+    CU_ASSERT_FALSE(segmentExists(aSegment));
+
+    CU_ASSERT_EQUAL(EdrvShutdown(), kEplSuccessful);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test cycle of one MN and many responders
+
+The test attaches the Edrv module as MN and one lightweight responder per CN
+node ID. The MN polls every responder with a request frame and waits for its
+response before the next one is polled, like in the isochronous phase of a
+POWERLINK cycle.
+*/
+//------------------------------------------------------------------------------
+void test_edrvsim_scale(void)
+{
+    char                aSegment[32];
+    tEdrvInitParam      initParam;
+    tEdrvTxBuffer       txBuffer;
+    tEdrvSimStatistics  statistics;
+    UINT                nodeId;
+    UINT                cycle;
+    UINT                expected;
+
+    getSegmentName(aSegment, sizeof(aSegment));
+    initRecord(&edrvRecord_l);
+
+    EPL_MEMSET(&initParam, 0, sizeof(initParam));
+    initParam.m_pfnRxHandler = edrvRxHandler;
+    initParam.m_HwParam.m_pszDevName = aSegment;
+    CU_ASSERT_EQUAL_FATAL(EdrvInit(&initParam), kEplSuccessful);
+
+    for (nodeId = 1; nodeId <= TEST_NUM_RESPONDERS; nodeId++)
+    {
+        aResponder_l[nodeId].nodeId = nodeId;
+        EPL_MEMSET(aResponder_l[nodeId].aMacAddr, 0, 6);
+        CU_ASSERT_EQUAL_FATAL(EdrvSimAttachPort(aSegment, aResponder_l[nodeId].aMacAddr,
+                                                responderRxHandler, &aResponder_l[nodeId],
+                                                &aResponder_l[nodeId].pPort),
+                              kEplSuccessful);
+    }
+
+    EPL_MEMSET(&txBuffer, 0, sizeof(txBuffer));
+    txBuffer.m_uiMaxBufferLen = TEST_FRAME_LEN;
+    CU_ASSERT_EQUAL_FATAL(EdrvAllocTxMsgBuffer(&txBuffer), kEplSuccessful);
+    txBuffer.m_uiTxMsgLen = TEST_FRAME_LEN;
+    txBuffer.m_pfnTxHandler = edrvTxHandler;
+
+    expected = 0;
+    for (cycle = 0; cycle < TEST_NUM_CYCLES; cycle++)
+    {
+        for (nodeId = 1; nodeId <= TEST_NUM_RESPONDERS; nodeId++)
+        {
+            buildFrame(txBuffer.m_pbBuffer, initParam.m_abMyMacAddr,
+                       TEST_FRAME_TYPE_REQ, (BYTE)nodeId);
+            EPL_MEMCPY(txBuffer.m_pbBuffer, aResponder_l[nodeId].aMacAddr, 6);
+            CU_ASSERT_EQUAL(EdrvSendTxMsg(&txBuffer), kEplSuccessful);
+            expected++;
+            CU_ASSERT(waitTxCount(&edrvRecord_l, expected));
+            CU_ASSERT(waitRxCount(&edrvRecord_l, expected));
+        }
+    }
+
+    for (nodeId = 1; nodeId <= TEST_NUM_RESPONDERS; nodeId++)
+    {
+        CU_ASSERT_EQUAL(edrvRecord_l.aResCount[nodeId], TEST_NUM_CYCLES);
+    }
+
+    EdrvSimGetStatistics(EdrvSimGetEdrvPort(), &statistics);
+    CU_ASSERT_EQUAL(statistics.txFrameCount, TEST_NUM_RESPONDERS * TEST_NUM_CYCLES);
+    CU_ASSERT_EQUAL(statistics.overflowCount, 0);
+
+    for (nodeId = 1; nodeId <= TEST_NUM_RESPONDERS; nodeId++)
+    {
+        EdrvSimGetStatistics(aResponder_l[nodeId].pPort, &statistics);
+        CU_ASSERT_EQUAL(statistics.txFrameCount, TEST_NUM_CYCLES);
+        CU_ASSERT_EQUAL(statistics.overflowCount, 0);
+        EdrvSimDetachPort(aResponder_l[nodeId].pPort);
+    }
+
+    EdrvReleaseTxMsgBuffer(&txBuffer);
+    EdrvShutdown();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get name of a private segment
+
+\param  pszName_p           Buffer to store the segment name
+\param  size_p              Size of the buffer
+*/
+//------------------------------------------------------------------------------
+static void getSegmentName(char* pszName_p, size_t size_p)
+{
+    static UINT     segmentCount = 0;
+
+    snprintf(pszName_p, size_p, "unittest%d-%u", (int)getpid(), segmentCount++);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if the shared memory object of a segment exists
+
+\param  pszSegment_p        Name of the segment
+
+\return The function returns TRUE if the segment exists.
+*/
+//------------------------------------------------------------------------------
+static BOOL segmentExists(const char* pszSegment_p)
+{
+    char    aShmName[64];
+    int     fd;
+
+    snprintf(aShmName, sizeof(aShmName), "/edrvsim-%s", pszSegment_p);
+    fd = shm_open(aShmName, O_RDONLY, 0);
+    if (fd < 0)
+        return FALSE;
+
+    close(fd);
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize a receive record
+
+\param  pRecord_p           Receive record
+*/
+//------------------------------------------------------------------------------
+static void initRecord(tRxRecord* pRecord_p)
+{
+    EPL_MEMSET(pRecord_p, 0, sizeof(tRxRecord));
+    pthread_mutex_init(&pRecord_p->mutex, NULL);
+    pthread_cond_init(&pRecord_p->cond, NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store a received frame in a receive record
+
+\param  pRecord_p           Receive record
+\param  pbFrame_p           Frame data
+\param  frameLen_p          Length of the frame
+*/
+//------------------------------------------------------------------------------
+static void putFrame(tRxRecord* pRecord_p, BYTE* pbFrame_p, UINT frameLen_p)
+{
+    pthread_mutex_lock(&pRecord_p->mutex);
+    pRecord_p->lastRxTime = getTimeNs();
+    pRecord_p->lastLen = frameLen_p;
+    EPL_MEMCPY(pRecord_p->aLastFrame, pbFrame_p, frameLen_p);
+    if ((pbFrame_p[TEST_FRAME_TYPE_OFFSET] == TEST_FRAME_TYPE_RES) &&
+        (pbFrame_p[TEST_FRAME_NODE_OFFSET] <= TEST_NUM_RESPONDERS))
+    {
+        pRecord_p->aResCount[pbFrame_p[TEST_FRAME_NODE_OFFSET]]++;
+    }
+    pRecord_p->rxCount++;
+    pthread_cond_broadcast(&pRecord_p->cond);
+    pthread_mutex_unlock(&pRecord_p->mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait until a number of frames was received
+
+\param  pRecord_p           Receive record
+\param  count_p             Expected number of received frames
+
+\return The function returns TRUE if the frames were received in time.
+*/
+//------------------------------------------------------------------------------
+static BOOL waitRxCount(tRxRecord* pRecord_p, UINT count_p)
+{
+    struct timespec     timeout;
+    BOOL                fReceived;
+
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_sec += TEST_TIMEOUT_MS / 1000;
+
+    pthread_mutex_lock(&pRecord_p->mutex);
+    while (pRecord_p->rxCount < count_p)
+    {
+        if (pthread_cond_timedwait(&pRecord_p->cond, &pRecord_p->mutex, &timeout) != 0)
+            break;
+    }
+    fReceived = (pRecord_p->rxCount >= count_p);
+    pthread_mutex_unlock(&pRecord_p->mutex);
+
+    return fReceived;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait until a number of Tx handler calls
+
+\param  pRecord_p           Receive record
+\param  count_p             Expected number of Tx handler calls
+
+\return The function returns TRUE if the Tx handler was called in time.
+*/
+//------------------------------------------------------------------------------
+static BOOL waitTxCount(tRxRecord* pRecord_p, UINT count_p)
+{
+    struct timespec     timeout;
+    BOOL                fTransmitted;
+
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_sec += TEST_TIMEOUT_MS / 1000;
+
+    pthread_mutex_lock(&pRecord_p->mutex);
+    while (pRecord_p->txCount < count_p)
+    {
+        if (pthread_cond_timedwait(&pRecord_p->cond, &pRecord_p->mutex, &timeout) != 0)
+            break;
+    }
+    fTransmitted = (pRecord_p->txCount >= count_p);
+    pthread_mutex_unlock(&pRecord_p->mutex);
+
+    return fTransmitted;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build a test frame
+
+\param  pbFrame_p           Frame buffer
+\param  pbSrcMac_p          Source MAC address
+\param  type_p              Frame type
+\param  nodeId_p            Addressed node ID
+*/
+//------------------------------------------------------------------------------
+static void buildFrame(BYTE* pbFrame_p, BYTE* pbSrcMac_p, BYTE type_p, BYTE nodeId_p)
+{
+    UINT    i;
+
+    EPL_MEMSET(pbFrame_p, 0xFF, 6);
+    EPL_MEMCPY(pbFrame_p + 6, pbSrcMac_p, 6);
+    pbFrame_p[12] = 0x88;
+    pbFrame_p[13] = 0xAB;
+    pbFrame_p[TEST_FRAME_TYPE_OFFSET] = type_p;
+    pbFrame_p[TEST_FRAME_NODE_OFFSET] = nodeId_p;
+    for (i = TEST_FRAME_NODE_OFFSET + 1; i < TEST_FRAME_LEN; i++)
+        pbFrame_p[i] = (BYTE)i;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive handler of the Edrv module
+*/
+//------------------------------------------------------------------------------
+static tEdrvReleaseRxBuffer edrvRxHandler(tEdrvRxBuffer* pRxBuffer_p)
+{
+    CU_ASSERT_EQUAL(pRxBuffer_p->m_BufferInFrame, kEdrvBufferLastInFrame);
+    putFrame(&edrvRecord_l, pRxBuffer_p->m_pbBuffer, pRxBuffer_p->m_uiRxMsgLen);
+
+    return kEdrvReleaseRxBufferImmediately;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Tx handler of the Edrv module
+*/
+//------------------------------------------------------------------------------
+static void edrvTxHandler(tEdrvTxBuffer* pTxBuffer_p __attribute__((unused)))
+{
+    pthread_mutex_lock(&edrvRecord_l.mutex);
+    edrvRecord_l.txCount++;
+    pthread_cond_broadcast(&edrvRecord_l.cond);
+    pthread_mutex_unlock(&edrvRecord_l.mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive handler of a simulated port
+*/
+//------------------------------------------------------------------------------
+static void portRxHandler(tEdrvSimPort* pPort_p __attribute__((unused)), void* pArg_p,
+                          BYTE* pbFrame_p, UINT frameLen_p)
+{
+    putFrame((tRxRecord*)pArg_p, pbFrame_p, frameLen_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive handler of a lightweight responder
+
+The responder answers request frames addressed to its node ID.
+*/
+//------------------------------------------------------------------------------
+static void responderRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                               UINT frameLen_p)
+{
+    tResponder*     pResponder = (tResponder*)pArg_p;
+    BYTE            aFrame[TEST_FRAME_LEN];
+
+    if ((frameLen_p < TEST_FRAME_LEN) ||
+        (pbFrame_p[TEST_FRAME_TYPE_OFFSET] != TEST_FRAME_TYPE_REQ) ||
+        (pbFrame_p[TEST_FRAME_NODE_OFFSET] != pResponder->nodeId))
+        return;
+
+    buildFrame(aFrame, pResponder->aMacAddr, TEST_FRAME_TYPE_RES, (BYTE)pResponder->nodeId);
+    EdrvSimSendFrame(pPort_p, aFrame, TEST_FRAME_LEN);
+}
+
+/// \}
@@ -0,0 +1,166 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for kernel error handler module unit tests
+
+This file contains all stubs needed by the unit tests of the kernel error
+handler module. The DLL stubs provide a CN node-ID list which is controlled
+by the tests.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <event.h>
+#include <kernel/eventk.h>
+#include <kernel/dllk.h>
+
+#include "test-errhndk.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static BYTE     aCnNodeIdList_l[EPL_NMT_MAX_NODE_ID + 1];
+static UINT     cnNodeIdListGen_l;
+static UINT     aDeleteNodeCount_l[EPL_NMT_MAX_NODE_ID + 1];
+static UINT     historyEntryCount_l;
+static UINT32   historyOccurrenceSum_l;
+static tEplErrHistoryEntry lastHistoryEntry_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_setCnNodeIdList(BYTE* pCnNodeIdList_p, UINT count_p)
+{
+    if ((count_p == 0) || (EPL_MEMCMP(aCnNodeIdList_l, pCnNodeIdList_p, count_p) != 0) ||
+        (aCnNodeIdList_l[count_p] != EPL_C_ADR_INVALID))
+    {
+        cnNodeIdListGen_l++;
+    }
+    EPL_MEMCPY(aCnNodeIdList_l, pCnNodeIdList_p, count_p);
+    aCnNodeIdList_l[count_p] = EPL_C_ADR_INVALID;
+}
+
+UINT stub_getDeleteNodeCount(UINT nodeId_p)
+{
+    return aDeleteNodeCount_l[nodeId_p];
+}
+
+UINT stub_getHistoryEntryCount(void)
+{
+    return historyEntryCount_l;
+}
+
+UINT32 stub_getHistoryOccurrenceSum(void)
+{
+    return historyOccurrenceSum_l;
+}
+
+void stub_getLastHistoryEntry(tEplErrHistoryEntry* pHistoryEntry_p)
+{
+    *pHistoryEntry_p = lastHistoryEntry_l;
+}
+
+void stub_reset(void)
+{
+    EPL_MEMSET(aCnNodeIdList_l, 0, sizeof(aCnNodeIdList_l));
+    EPL_MEMSET(aDeleteNodeCount_l, 0, sizeof(aDeleteNodeCount_l));
+    EPL_MEMSET(&lastHistoryEntry_l, 0, sizeof(lastHistoryEntry_l));
+    historyEntryCount_l = 0;
+    historyOccurrenceSum_l = 0;
+    cnNodeIdListGen_l++;
+}
+
+void dllk_getCurrentCnNodeIdList(BYTE** ppbCnNodeIdList_p, UINT* pGeneration_p)
+{
+    *ppbCnNodeIdList_p = aCnNodeIdList_l;
+    *pGeneration_p = cnNodeIdListGen_l;
+}
+
+tEplKernel dllk_deleteNode(tDllNodeOpParam* pNodeOpParam_p)
+{
+    aDeleteNodeCount_l[pNodeOpParam_p->nodeId]++;
+    return kEplSuccessful;
+}
+
+tEplKernel eventk_postEvent(tEplEvent* pEvent_p)
+{
+    if ((pEvent_p->m_EventSink == kEplEventSinkApi) &&
+        (pEvent_p->m_EventType == kEplEventTypeHistoryEntry))
+    {
+        EPL_MEMCPY(&lastHistoryEntry_l, pEvent_p->m_pArg, sizeof(lastHistoryEntry_l));
+        historyEntryCount_l++;
+        historyOccurrenceSum_l += AmiGetDwordFromLe(
+                    &lastHistoryEntry_l.m_abAddInfo[EPL_ERR_ADDINFO_OCCURRENCE_CNT]);
+    }
+    return kEplSuccessful;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
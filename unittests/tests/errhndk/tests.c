@@ -0,0 +1,659 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for kernel error handler module
+
+This file contains the unit test functions for the kernel error handler
+module. The on-demand decay of the MN loss of PRes threshold counters is
+compared against a reference model which decrements the counters in every
+cycle.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdlib.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <event.h>
+#include <errhnd.h>
+#include <kernel/errhndk.h>
+
+#include "test-errhndk.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+extern tErrHndObjects       errhndk_errorObjects_g;
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NUM_NODES              16
+#define TEST_NUM_CYCLES             20000
+#define TEST_BURST_NODES            40
+#define TEST_BURST_CYCLES           5000
+
+#define REF_EVENT_NONE              0
+#define REF_EVENT_OCC               1
+#define REF_EVENT_THR               2
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Reference model of MN loss of PRes error counters
+
+The reference model implements the error counters the way they have been
+implemented by decrementing all threshold counters in every cycle.
+*/
+typedef struct
+{
+    BYTE        aEvent[TEST_NUM_NODES + 1];
+    UINT32      aThresholdCnt[TEST_NUM_NODES + 1];
+    UINT32      aCumulativeCnt[TEST_NUM_NODES + 1];
+    UINT        aDeleteNodeCount[TEST_NUM_NODES + 1];
+    BOOL        aInList[TEST_NUM_NODES + 1];
+} tRefModel;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void     setupTest(void);
+static void     setNodeList(BOOL* afInList_p);
+static void     postLossPres(UINT nodeId_p);
+static void     postInvalidFormat(UINT nodeId_p);
+static void     runCycles(UINT count_p);
+static UINT32   runBurst(UINT nodeCount_p);
+static UINT32   getOccurrenceCnt(tEplErrHistoryEntry* pHistoryEntry_p);
+static UINT32   getThresholdCnt(UINT nodeId_p);
+static void     refLossPres(UINT nodeId_p);
+static void     refDecrement(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tRefModel    ref_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test on-demand decay of MnCnLossPres threshold counters
+
+The test checks that the threshold counters of the CNs in the isochronous
+phase are not written at cycle end, but read back with the decay applied.
+*/
+//------------------------------------------------------------------------------
+void test_errhndk_mnCnLossPresDecay(void)
+{
+    BOOL        afInList[TEST_NUM_NODES + 1];
+    UINT        nodeId;
+    UINT        cycle;
+
+    setupTest();
+
+    EPL_MEMSET(afInList, 0, sizeof(afInList));
+    for (nodeId = 1; nodeId <= TEST_NUM_NODES; nodeId++)
+    {
+        afInList[nodeId] = TRUE;
+        errhndk_errorObjects_g.aMnCnLossPres[nodeId - 1].threshold = 15;
+    }
+    setNodeList(afInList);
+
+    // first error raises the counter by 8, second one exceeds the threshold
+    postLossPres(1);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 8);
+    errhndk_decrementCounters(TRUE);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 8);     // no decay in cycle of error
+
+    for (cycle = 0; cycle < 5; cycle++)
+        errhndk_decrementCounters(TRUE);
+
+    // stored value is untouched, decay is applied when reading
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.aMnCnLossPres[0].thresholdCnt, 8);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 3);
+
+    postLossPres(1);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 11);
+
+    postLossPres(1);                            // ignored in same cycle
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 11);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.aMnCnLossPres[0].cumulativeCnt, 2);
+
+    errhndk_decrementCounters(TRUE);
+    postLossPres(1);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 19);
+    CU_ASSERT_EQUAL(stub_getDeleteNodeCount(1), 1);
+
+    // threshold counter is frozen after threshold was exceeded
+    for (cycle = 0; cycle < 100; cycle++)
+        errhndk_decrementCounters(TRUE);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 19);
+
+    // counter saturates at zero
+    for (cycle = 0; cycle < 100; cycle++)
+        errhndk_decrementCounters(TRUE);
+    errhndk_resetCnError(1);
+    errhndk_decrementCounters(TRUE);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 18);
+    for (cycle = 0; cycle < 100; cycle++)
+        errhndk_decrementCounters(TRUE);
+    CU_ASSERT_EQUAL(getThresholdCnt(1), 0);
+
+    // counter does not decay while node is not in isochronous phase
+    postLossPres(2);
+    afInList[2] = FALSE;
+    setNodeList(afInList);
+    for (cycle = 0; cycle < 100; cycle++)
+        errhndk_decrementCounters(TRUE);
+    CU_ASSERT_EQUAL(getThresholdCnt(2), 8);
+
+    afInList[2] = TRUE;
+    setNodeList(afInList);
+    errhndk_decrementCounters(TRUE);            // consumes pending error event
+    CU_ASSERT_EQUAL(getThresholdCnt(2), 8);
+    errhndk_decrementCounters(TRUE);
+    CU_ASSERT_EQUAL(getThresholdCnt(2), 7);
+
+    errhndk_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test equivalence of on-demand decay with per-cycle decrement
+
+The test runs a random sequence of errors, node list changes and resets and
+compares the error counters with the reference model after each step.
+*/
+//------------------------------------------------------------------------------
+void test_errhndk_mnCnLossPresEquivalence(void)
+{
+    BOOL        afInList[TEST_NUM_NODES + 1];
+    UINT        nodeId;
+    UINT        cycle;
+    UINT        i;
+    BOOL        fListChanged;
+
+    setupTest();
+    srand(4711);
+
+    EPL_MEMSET(afInList, 0, sizeof(afInList));
+    for (nodeId = 1; nodeId <= TEST_NUM_NODES; nodeId++)
+    {
+        afInList[nodeId] = (rand() % 2) ? TRUE : FALSE;
+        // threshold 0 disables threshold counting of a node
+        errhndk_errorObjects_g.aMnCnLossPres[nodeId - 1].threshold = rand() % 40;
+    }
+    setNodeList(afInList);
+
+    for (cycle = 0; cycle < TEST_NUM_CYCLES; cycle++)
+    {
+        // errors during cycle
+        for (i = rand() % 3; i > 0; i--)
+        {
+            nodeId = 1 + rand() % TEST_NUM_NODES;
+            postLossPres(nodeId);
+            refLossPres(nodeId);
+        }
+
+        // nodes removed due to exceeded threshold leave the isochronous phase
+        fListChanged = FALSE;
+        for (nodeId = 1; nodeId <= TEST_NUM_NODES; nodeId++)
+        {
+            if (stub_getDeleteNodeCount(nodeId) != ref_l.aDeleteNodeCount[nodeId])
+                CU_FAIL("dllk_deleteNode() call count differs");
+
+            if ((ref_l.aEvent[nodeId] == REF_EVENT_THR) && (afInList[nodeId] != FALSE))
+            {
+                afInList[nodeId] = FALSE;
+                fListChanged = TRUE;
+            }
+        }
+
+        // random changes of isochronous phase, added nodes get their error reset
+        if ((rand() % 8) == 0)
+        {
+            nodeId = 1 + rand() % TEST_NUM_NODES;
+            afInList[nodeId] = (afInList[nodeId] == FALSE) ? TRUE : FALSE;
+            if (afInList[nodeId] != FALSE)
+            {
+                errhndk_resetCnError(nodeId);
+                ref_l.aEvent[nodeId] = REF_EVENT_NONE;
+            }
+            fListChanged = TRUE;
+        }
+
+        if (fListChanged)
+            setNodeList(afInList);
+
+        errhndk_decrementCounters(TRUE);
+        refDecrement();
+
+        for (nodeId = 1; nodeId <= TEST_NUM_NODES; nodeId++)
+        {
+            if ((getThresholdCnt(nodeId) != ref_l.aThresholdCnt[nodeId]) ||
+                (errhndk_errorObjects_g.aMnCnLossPres[nodeId - 1].cumulativeCnt !=
+                 ref_l.aCumulativeCnt[nodeId]))
+            {
+                CU_FAIL("Error counters differ from reference model");
+                errhndk_exit();
+                return;
+            }
+        }
+    }
+
+    for (nodeId = 1; nodeId <= TEST_NUM_NODES; nodeId++)
+        CU_ASSERT_EQUAL(stub_getDeleteNodeCount(nodeId), ref_l.aDeleteNodeCount[nodeId]);
+
+    errhndk_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test coalescing of repeated history entries
+
+The test checks that the first occurrence of an error is posted immediately and
+further occurrences of the same error code and node within the window are
+reported by a single history entry carrying the occurrence count.
+*/
+//------------------------------------------------------------------------------
+void test_errhndk_historyCoalesce(void)
+{
+    tEplErrHistoryEntry     entry;
+    UINT                    i;
+
+    setupTest();
+    errhndk_errorObjects_g.historyCoalesce.window = 10;
+
+    postInvalidFormat(1);
+    CU_ASSERT_EQUAL(stub_getHistoryEntryCount(), 1);
+    stub_getLastHistoryEntry(&entry);
+    CU_ASSERT_EQUAL(entry.m_wErrorCode, EPL_E_DLL_INVALID_FORMAT);
+    CU_ASSERT_EQUAL(entry.m_abAddInfo[0], 1);
+    CU_ASSERT_EQUAL(getOccurrenceCnt(&entry), 1);
+
+    // repeated occurrences are counted
+    for (i = 0; i < 4; i++)
+    {
+        runCycles(1);
+        postInvalidFormat(1);
+    }
+    CU_ASSERT_EQUAL(stub_getHistoryEntryCount(), 1);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.postedCnt, 1);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.suppressedCnt, 4);
+
+    // other node is not coalesced with node 1
+    postInvalidFormat(2);
+    CU_ASSERT_EQUAL(stub_getHistoryEntryCount(), 2);
+    stub_getLastHistoryEntry(&entry);
+    CU_ASSERT_EQUAL(entry.m_abAddInfo[0], 2);
+
+    // expired window reports the suppressed occurrences of node 1 only
+    runCycles(6);
+    CU_ASSERT_EQUAL(stub_getHistoryEntryCount(), 3);
+    stub_getLastHistoryEntry(&entry);
+    CU_ASSERT_EQUAL(entry.m_abAddInfo[0], 1);
+    CU_ASSERT_EQUAL(getOccurrenceCnt(&entry), 4);
+    CU_ASSERT_EQUAL(stub_getHistoryOccurrenceSum(), 6);
+
+    // windows without further occurrences don't post anything
+    runCycles(30);
+    CU_ASSERT_EQUAL(stub_getHistoryEntryCount(), 3);
+
+    // error occurring again is posted immediately
+    postInvalidFormat(1);
+    CU_ASSERT_EQUAL(stub_getHistoryEntryCount(), 4);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.postedCnt, 4);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.suppressedCnt, 4);
+
+    errhndk_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test history entries with disabled coalescing
+
+The test checks that every occurrence is posted if the window is 0.
+*/
+//------------------------------------------------------------------------------
+void test_errhndk_historyCoalesceDisabled(void)
+{
+    tEplErrHistoryEntry     entry;
+    UINT                    i;
+
+    setupTest();
+
+    for (i = 0; i < 20; i++)
+    {
+        postInvalidFormat(1);
+        runCycles(1);
+    }
+
+    CU_ASSERT_EQUAL(stub_getHistoryEntryCount(), 20);
+    CU_ASSERT_EQUAL(stub_getHistoryOccurrenceSum(), 20);
+    stub_getLastHistoryEntry(&entry);
+    CU_ASSERT_EQUAL(getOccurrenceCnt(&entry), 1);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.postedCnt, 20);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.suppressedCnt, 0);
+
+    errhndk_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test coalescing of history entry bursts of many nodes
+
+The test posts random error bursts of more nodes than coalescing entries are
+available. No occurrence may be lost and the number of posted events must be
+reduced significantly.
+*/
+//------------------------------------------------------------------------------
+void test_errhndk_historyCoalesceBurst(void)
+{
+    UINT32      occurrenceCnt;
+
+    // all nodes fit into the coalescing entries
+    setupTest();
+    srand(4711);
+    errhndk_errorObjects_g.historyCoalesce.window = 100;
+
+    occurrenceCnt = runBurst(CONFIG_ERRHND_HISTORY_COALESCE_ENTRIES);
+    CU_ASSERT_EQUAL(stub_getHistoryOccurrenceSum(), occurrenceCnt);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.postedCnt,
+                    stub_getHistoryEntryCount());
+    CU_ASSERT(stub_getHistoryEntryCount() < (occurrenceCnt / 50));
+    errhndk_exit();
+
+    // more nodes than coalescing entries, the oldest entries are reported early
+    setupTest();
+    errhndk_errorObjects_g.historyCoalesce.window = 100;
+
+    occurrenceCnt = runBurst(TEST_BURST_NODES);
+    CU_ASSERT_EQUAL(stub_getHistoryOccurrenceSum(), occurrenceCnt);
+    CU_ASSERT_EQUAL(errhndk_errorObjects_g.historyCoalesce.postedCnt,
+                    stub_getHistoryEntryCount());
+    CU_ASSERT(stub_getHistoryEntryCount() < occurrenceCnt);
+    errhndk_exit();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize error handler, stubs and reference model
+*/
+//------------------------------------------------------------------------------
+static void setupTest(void)
+{
+    stub_reset();
+    EPL_MEMSET(&ref_l, 0, sizeof(ref_l));
+    EPL_MEMSET(&errhndk_errorObjects_g, 0, sizeof(errhndk_errorObjects_g));
+    errhndk_init();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set CN node-ID list of DLL stub and reference model
+
+\param  afInList_p          Array of flags which nodes are in the list
+*/
+//------------------------------------------------------------------------------
+static void setNodeList(BOOL* afInList_p)
+{
+    BYTE        aNodeIdList[TEST_NUM_NODES];
+    UINT        count = 0;
+    UINT        nodeId;
+
+    for (nodeId = 1; nodeId <= TEST_NUM_NODES; nodeId++)
+    {
+        ref_l.aInList[nodeId] = afInList_p[nodeId];
+        if (afInList_p[nodeId] != FALSE)
+            aNodeIdList[count++] = (BYTE)nodeId;
+    }
+    stub_setCnNodeIdList(aNodeIdList, count);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Post loss of PRes error of a CN to the error handler
+
+\param  nodeId_p            Node ID of CN
+*/
+//------------------------------------------------------------------------------
+static void postLossPres(UINT nodeId_p)
+{
+    tEplEvent       event;
+    tErrHndkEvent   errEvent;
+
+    EPL_MEMSET(&event, 0, sizeof(event));
+    EPL_MEMSET(&errEvent, 0, sizeof(errEvent));
+    errEvent.m_ulDllErrorEvents = EPL_DLL_ERR_MN_CN_LOSS_PRES;
+    errEvent.m_uiNodeId = nodeId_p;
+    errEvent.m_NmtState = kNmtMsOperational;
+    event.m_EventSink = kEplEventSinkErrk;
+    event.m_EventType = kEplEventTypeDllError;
+    event.m_pArg = &errEvent;
+    event.m_uiSize = sizeof(errEvent);
+
+    errhndk_process(&event);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Post invalid format error of a CN to the error handler
+
+\param  nodeId_p            Node ID of CN
+*/
+//------------------------------------------------------------------------------
+static void postInvalidFormat(UINT nodeId_p)
+{
+    tEplEvent       event;
+    tErrHndkEvent   errEvent;
+
+    EPL_MEMSET(&event, 0, sizeof(event));
+    EPL_MEMSET(&errEvent, 0, sizeof(errEvent));
+    errEvent.m_ulDllErrorEvents = EPL_DLL_ERR_INVALID_FORMAT;
+    errEvent.m_uiNodeId = nodeId_p;
+    errEvent.m_NmtState = kNmtMsOperational;
+    event.m_EventSink = kEplEventSinkErrk;
+    event.m_EventType = kEplEventTypeDllError;
+    event.m_pArg = &errEvent;
+    event.m_uiSize = sizeof(errEvent);
+
+    errhndk_process(&event);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run cycle end processing of the error handler
+
+\param  count_p             Number of cycles
+*/
+//------------------------------------------------------------------------------
+static void runCycles(UINT count_p)
+{
+    for (; count_p > 0; count_p--)
+        errhndk_decrementCounters(TRUE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run error bursts of several nodes
+
+In the burst phases each node fails once per cycle on average. At the end all
+pending coalescing windows are expired.
+
+\param  nodeCount_p         Number of failing nodes
+
+\return Number of posted errors
+*/
+//------------------------------------------------------------------------------
+static UINT32 runBurst(UINT nodeCount_p)
+{
+    UINT        cycle;
+    UINT        i;
+    UINT32      occurrenceCnt = 0;
+
+    for (cycle = 0; cycle < TEST_BURST_CYCLES; cycle++)
+    {
+        if ((cycle % 500) < 200)
+        {
+            for (i = 0; i < nodeCount_p; i++)
+            {
+                postInvalidFormat(1 + rand() % nodeCount_p);
+                occurrenceCnt++;
+            }
+        }
+        runCycles(1);
+    }
+
+    runCycles(200);
+    return occurrenceCnt;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get occurrence count of a history entry
+
+\param  pHistoryEntry_p     Pointer to history entry
+
+\return Occurrence count stored in the additional information
+*/
+//------------------------------------------------------------------------------
+static UINT32 getOccurrenceCnt(tEplErrHistoryEntry* pHistoryEntry_p)
+{
+    return AmiGetDwordFromLe(&pHistoryEntry_p->m_abAddInfo[EPL_ERR_ADDINFO_OCCURRENCE_CNT]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get threshold counter as seen by user part of error handler
+
+\param  nodeId_p            Node ID of CN
+
+\return Current value of threshold counter
+*/
+//------------------------------------------------------------------------------
+static UINT32 getThresholdCnt(UINT nodeId_p)
+{
+    tErrorDecay*    pDecay = &errhndk_errorObjects_g.aMnCnLossPresDecay[nodeId_p - 1];
+    UINT32          thresholdCnt;
+    UINT32          decay;
+
+    thresholdCnt = errhndk_errorObjects_g.aMnCnLossPres[nodeId_p - 1].thresholdCnt;
+    if (pDecay->fDecay == FALSE)
+        return thresholdCnt;
+
+    decay = ERRHND_GET_DECAY(errhndk_errorObjects_g.mnCycleCnt, pDecay->refCycleCnt);
+    return (thresholdCnt > decay) ? (thresholdCnt - decay) : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Handle loss of PRes error in reference model
+
+\param  nodeId_p            Node ID of CN
+*/
+//------------------------------------------------------------------------------
+static void refLossPres(UINT nodeId_p)
+{
+    UINT32      threshold = errhndk_errorObjects_g.aMnCnLossPres[nodeId_p - 1].threshold;
+
+    if (ref_l.aEvent[nodeId_p] != REF_EVENT_NONE)
+        return;
+
+    ref_l.aCumulativeCnt[nodeId_p]++;
+    if (threshold > 0)
+    {
+        ref_l.aThresholdCnt[nodeId_p] += 8;
+        if (ref_l.aThresholdCnt[nodeId_p] >= threshold)
+        {
+            ref_l.aEvent[nodeId_p] = REF_EVENT_THR;
+            ref_l.aDeleteNodeCount[nodeId_p]++;
+        }
+        else
+        {
+            ref_l.aEvent[nodeId_p] = REF_EVENT_OCC;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Decrement threshold counters of reference model at cycle end
+*/
+//------------------------------------------------------------------------------
+static void refDecrement(void)
+{
+    UINT        nodeId;
+
+    for (nodeId = 1; nodeId <= TEST_NUM_NODES; nodeId++)
+    {
+        if (ref_l.aInList[nodeId] == FALSE)
+            continue;
+
+        if (ref_l.aEvent[nodeId] == REF_EVENT_NONE)
+        {
+            if (ref_l.aThresholdCnt[nodeId] > 0)
+                ref_l.aThresholdCnt[nodeId]--;
+        }
+        else if (ref_l.aEvent[nodeId] == REF_EVENT_OCC)
+        {
+            ref_l.aEvent[nodeId] = REF_EVENT_NONE;
+        }
+    }
+}
+
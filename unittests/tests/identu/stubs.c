@@ -0,0 +1,162 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for ident and status user module unit tests
+
+This file contains all stubs needed by the unit tests of the ident and status
+user modules. The registered ASnd callbacks are stored, so that the tests can
+pass received frames to the modules. The heap functions are wrapped by the
+linker and counted.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdlib.h>
+
+#include <EplInc.h>
+#include <user/dllucal.h>
+
+#include "test-identu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+void* __real_malloc(size_t size_p);
+void  __real_free(void* ptr_p);
+void* __wrap_malloc(size_t size_p);
+void  __wrap_free(void* ptr_p);
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_ASND_SERVICE_COUNT     8       // number of ASnd service IDs handled by the stub
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEplDlluCbAsnd   apfnCbAsnd_l[STUB_ASND_SERVICE_COUNT];
+static UINT             issuedRequestCount_l;
+static UINT             mallocCount_l;
+static UINT             freeCount_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_reset(void)
+{
+    issuedRequestCount_l = 0;
+}
+
+tEplKernel stub_receiveAsnd(tDllAsndServiceId serviceId_p, tFrameInfo* pFrameInfo_p)
+{
+    if ((serviceId_p >= STUB_ASND_SERVICE_COUNT) || (apfnCbAsnd_l[serviceId_p] == NULL))
+        return kEplInvalidOperation;
+
+    return apfnCbAsnd_l[serviceId_p](pFrameInfo_p);
+}
+
+UINT stub_getIssuedRequestCount(void)
+{
+    return issuedRequestCount_l;
+}
+
+UINT stub_getMallocCount(void)
+{
+    return mallocCount_l;
+}
+
+UINT stub_getFreeCount(void)
+{
+    return freeCount_l;
+}
+
+void* __wrap_malloc(size_t size_p)
+{
+    mallocCount_l++;
+    return __real_malloc(size_p);
+}
+
+void __wrap_free(void* ptr_p)
+{
+    if (ptr_p != NULL)
+        freeCount_l++;
+    __real_free(ptr_p);
+}
+
+tEplKernel dllucal_regAsndService(tDllAsndServiceId ServiceId_p,
+                                  tEplDlluCbAsnd pfnDlluCbAsnd_p,
+                                  tDllAsndFilter Filter_p)
+{
+    UNUSED_PARAMETER(Filter_p);
+
+    if (ServiceId_p >= STUB_ASND_SERVICE_COUNT)
+        return kEplDllInvalidAsndServiceId;
+
+    apfnCbAsnd_l[ServiceId_p] = pfnDlluCbAsnd_p;
+    return kEplSuccessful;
+}
+
+tEplKernel dllucal_issueRequest(tDllReqServiceId Service_p, unsigned int uiNodeId_p, BYTE bSoaFlag1_p)
+{
+    UNUSED_PARAMETER(Service_p);
+    UNUSED_PARAMETER(uiNodeId_p);
+    UNUSED_PARAMETER(bSoaFlag1_p);
+
+    issuedRequestCount_l++;
+    return kEplSuccessful;
+}
@@ -0,0 +1,355 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for ident and status user modules
+
+This file contains the unit test functions for the ident and status user
+modules. They check the storage of IdentResponses in the pool and verify that
+no heap functions are called after the initialization.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <user/identu.h>
+#include <user/statusu.h>
+
+#include "test-identu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_HEAP_CN_COUNT          239
+#define TEST_HEAP_ROUNDS            10
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel receiveResponse(tDllAsndServiceId serviceId_p, UINT nodeId_p,
+                                  UINT32 serialNumber_p, UINT frameSize_p);
+static tEplKernel cbIdentResponse(UINT nodeId_p, tEplIdentResponse* pIdentResponse_p);
+static tEplKernel cbStatusResponse(UINT nodeId_p, tEplStatusResponse* pStatusResponse_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEplFrame            frame_l;
+static UINT                 cbCount_l;
+static UINT                 cbNodeId_l;
+static tEplIdentResponse*   pCbIdentResponse_l;
+static tEplStatusResponse*  pCbStatusResponse_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test storage of IdentResponses
+
+The function checks that a received IdentResponse is stored in the pool and
+that identu_getIdentResponse() returns the stored IdentResponse without
+copying it.
+*/
+//------------------------------------------------------------------------------
+void test_identu_storeResponse(void)
+{
+    tEplIdentResponse*  pIdentResponse;
+    tEplIdentResponse*  pFirstIdentResponse;
+
+    CU_ASSERT_EQUAL_FATAL(identu_init(), kEplSuccessful);
+    stub_reset();
+    cbCount_l = 0;
+
+    CU_ASSERT_EQUAL(identu_getIdentResponse(5, &pIdentResponse), kEplInvalidOperation);
+    CU_ASSERT_PTR_NULL(pIdentResponse);
+
+    CU_ASSERT_EQUAL(identu_requestIdentResponse(5, cbIdentResponse), kEplSuccessful);
+    // request is already running
+    CU_ASSERT_EQUAL(identu_requestIdentResponse(5, cbIdentResponse), kEplInvalidOperation);
+    CU_ASSERT_EQUAL(stub_getIssuedRequestCount(), 1);
+
+    CU_ASSERT_EQUAL(receiveResponse(kDllAsndIdentResponse, 5, 0x1234, EPL_C_DLL_MINSIZE_IDENTRES),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(cbCount_l, 1);
+    CU_ASSERT_EQUAL(cbNodeId_l, 5);
+    CU_ASSERT_PTR_NOT_NULL(pCbIdentResponse_l);
+    if (pCbIdentResponse_l == NULL)
+        return;
+    // the IdentResponse was copied out of the frame
+    CU_ASSERT_TRUE(pCbIdentResponse_l != &frame_l.m_Data.m_Asnd.m_Payload.m_IdentResponse);
+    CU_ASSERT_EQUAL(AmiGetDwordFromLe(&pCbIdentResponse_l->m_le_dwSerialNumber), 0x1234);
+
+    CU_ASSERT_EQUAL(identu_getIdentResponse(5, &pIdentResponse), kEplSuccessful);
+    CU_ASSERT_PTR_EQUAL(pIdentResponse, pCbIdentResponse_l);
+    pFirstIdentResponse = pIdentResponse;
+
+    // a new IdentResponse of the node overwrites the pool entry
+    CU_ASSERT_EQUAL(identu_requestIdentResponse(5, cbIdentResponse), kEplSuccessful);
+    CU_ASSERT_EQUAL(receiveResponse(kDllAsndIdentResponse, 5, 0x5678, EPL_C_DLL_MINSIZE_IDENTRES),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(identu_getIdentResponse(5, &pIdentResponse), kEplSuccessful);
+    CU_ASSERT_PTR_EQUAL(pIdentResponse, pFirstIdentResponse);
+    CU_ASSERT_EQUAL(AmiGetDwordFromLe(&pIdentResponse->m_le_dwSerialNumber), 0x5678);
+
+    // the stored IdentResponses are discarded by a reset
+    CU_ASSERT_EQUAL(identu_reset(), kEplSuccessful);
+    CU_ASSERT_EQUAL(identu_getIdentResponse(5, &pIdentResponse), kEplInvalidOperation);
+    CU_ASSERT_PTR_NULL(pIdentResponse);
+
+    identu_delInstance();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test invalid and incomplete IdentResponses
+
+The function checks the handling of invalid node IDs, of too short
+IdentResponse frames and of IdentResponses which were not requested.
+*/
+//------------------------------------------------------------------------------
+void test_identu_invalidResponse(void)
+{
+    tEplIdentResponse*  pIdentResponse;
+
+    CU_ASSERT_EQUAL_FATAL(identu_init(), kEplSuccessful);
+    cbCount_l = 0;
+
+    CU_ASSERT_EQUAL(identu_getIdentResponse(EPL_C_ADR_INVALID, &pIdentResponse), kEplInvalidNodeId);
+    CU_ASSERT_PTR_NULL(pIdentResponse);
+    CU_ASSERT_EQUAL(identu_getIdentResponse(EPL_C_ADR_BROADCAST, &pIdentResponse), kEplInvalidNodeId);
+    CU_ASSERT_EQUAL(identu_requestIdentResponse(EPL_C_ADR_BROADCAST, cbIdentResponse), kEplInvalidNodeId);
+
+    // IdentResponse is too short
+    CU_ASSERT_EQUAL(identu_requestIdentResponse(7, cbIdentResponse), kEplSuccessful);
+    CU_ASSERT_EQUAL(receiveResponse(kDllAsndIdentResponse, 7, 0x1234, EPL_C_DLL_MINSIZE_IDENTRES - 1),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(cbCount_l, 1);
+    CU_ASSERT_PTR_NULL(pCbIdentResponse_l);
+    CU_ASSERT_EQUAL(identu_getIdentResponse(7, &pIdentResponse), kEplInvalidOperation);
+
+    // IdentResponse was not requested
+    CU_ASSERT_EQUAL(receiveResponse(kDllAsndIdentResponse, 9, 0x1234, EPL_C_DLL_MINSIZE_IDENTRES),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(cbCount_l, 1);
+    CU_ASSERT_EQUAL(identu_getIdentResponse(9, &pIdentResponse), kEplInvalidOperation);
+
+    identu_delInstance();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test StatusResponses
+
+The function checks that a requested StatusResponse is passed to the callback
+function and that StatusResponses which were not requested are ignored.
+*/
+//------------------------------------------------------------------------------
+void test_statusu_response(void)
+{
+    CU_ASSERT_EQUAL_FATAL(statusu_init(), kEplSuccessful);
+    cbCount_l = 0;
+
+    CU_ASSERT_EQUAL(statusu_requestStatusResponse(3, cbStatusResponse), kEplSuccessful);
+    CU_ASSERT_EQUAL(statusu_requestStatusResponse(3, cbStatusResponse), kEplInvalidOperation);
+    CU_ASSERT_EQUAL(receiveResponse(kDllAsndStatusResponse, 3, 0, EPL_C_DLL_MINSIZE_STATUSRES),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(cbCount_l, 1);
+    CU_ASSERT_EQUAL(cbNodeId_l, 3);
+    CU_ASSERT_PTR_NOT_NULL(pCbStatusResponse_l);
+
+    CU_ASSERT_EQUAL(receiveResponse(kDllAsndStatusResponse, 4, 0, EPL_C_DLL_MINSIZE_STATUSRES),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(cbCount_l, 1);
+
+    statusu_delInstance();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test that no heap functions are called after the initialization
+
+The function initializes the ident and status modules and runs several boot
+cycles with IdentRequests and StatusRequests to all CNs. The heap calls are
+counted by the linker wrappers of malloc() and free(). Only the initialization
+and the deletion of the ident module may use the heap.
+*/
+//------------------------------------------------------------------------------
+void test_identu_noHeapAfterInit(void)
+{
+    UINT        mallocCount;
+    UINT        freeCount;
+    UINT        round;
+    UINT        nodeId;
+    UINT        errorCount = 0;
+
+    mallocCount = stub_getMallocCount();
+    CU_ASSERT_EQUAL_FATAL(identu_init(), kEplSuccessful);
+    CU_ASSERT_EQUAL_FATAL(statusu_init(), kEplSuccessful);
+    CU_ASSERT_EQUAL(stub_getMallocCount() - mallocCount, 1);
+
+    mallocCount = stub_getMallocCount();
+    freeCount = stub_getFreeCount();
+    cbCount_l = 0;
+
+    for (round = 0; round < TEST_HEAP_ROUNDS; round++)
+    {
+        for (nodeId = 1; nodeId <= TEST_HEAP_CN_COUNT; nodeId++)
+        {
+            if (identu_requestIdentResponse(nodeId, cbIdentResponse) != kEplSuccessful)
+                errorCount++;
+            if (receiveResponse(kDllAsndIdentResponse, nodeId, nodeId, EPL_C_DLL_MINSIZE_IDENTRES) != kEplSuccessful)
+                errorCount++;
+            if (statusu_requestStatusResponse(nodeId, cbStatusResponse) != kEplSuccessful)
+                errorCount++;
+            if (receiveResponse(kDllAsndStatusResponse, nodeId, 0, EPL_C_DLL_MINSIZE_STATUSRES) != kEplSuccessful)
+                errorCount++;
+        }
+
+        // reset is done on every entry of PreOperational1
+        identu_reset();
+        statusu_reset();
+    }
+
+    CU_ASSERT_EQUAL(stub_getMallocCount(), mallocCount);
+    CU_ASSERT_EQUAL(stub_getFreeCount(), freeCount);
+    CU_ASSERT_EQUAL(errorCount, 0);
+    CU_ASSERT_EQUAL(cbCount_l, 2 * TEST_HEAP_ROUNDS * TEST_HEAP_CN_COUNT);
+
+    freeCount = stub_getFreeCount();
+    identu_delInstance();
+    statusu_delInstance();
+    CU_ASSERT_EQUAL(stub_getFreeCount() - freeCount, 1);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive response frame
+
+The function builds an IdentResponse or StatusResponse frame and passes it to
+the registered ASnd callback function.
+
+\param  serviceId_p             ASnd service ID of the frame.
+\param  nodeId_p                Source node ID of the frame.
+\param  serialNumber_p          Serial number stored in an IdentResponse.
+\param  frameSize_p             Size of the frame.
+
+\return The function returns the return value of the ASnd callback function.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel receiveResponse(tDllAsndServiceId serviceId_p, UINT nodeId_p,
+                                  UINT32 serialNumber_p, UINT frameSize_p)
+{
+    tFrameInfo      frameInfo;
+    tEplFrame*      pFrame = &frame_l;
+
+    EPL_MEMSET(pFrame, 0, sizeof(tEplFrame));
+    AmiSetByteToLe(&pFrame->m_le_bSrcNodeId, (BYTE)nodeId_p);
+    AmiSetByteToLe(&pFrame->m_Data.m_Asnd.m_le_bServiceId, (BYTE)serviceId_p);
+    if (serviceId_p == kDllAsndIdentResponse)
+    {
+        AmiSetDwordToLe(&pFrame->m_Data.m_Asnd.m_Payload.m_IdentResponse.m_le_dwSerialNumber,
+                        serialNumber_p);
+    }
+
+    frameInfo.pFrame = pFrame;
+    frameInfo.frameSize = frameSize_p;
+    return stub_receiveAsnd(serviceId_p, &frameInfo);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  IdentResponse callback function
+
+\param  nodeId_p                Node ID of the responding node.
+\param  pIdentResponse_p        Pointer to IdentResponse or NULL.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbIdentResponse(UINT nodeId_p, tEplIdentResponse* pIdentResponse_p)
+{
+    cbCount_l++;
+    cbNodeId_l = nodeId_p;
+    pCbIdentResponse_l = pIdentResponse_p;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  StatusResponse callback function
+
+\param  nodeId_p                Node ID of the responding node.
+\param  pStatusResponse_p       Pointer to StatusResponse or NULL.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbStatusResponse(UINT nodeId_p, tEplStatusResponse* pStatusResponse_p)
+{
+    cbCount_l++;
+    cbNodeId_l = nodeId_p;
+    pCbStatusResponse_l = pStatusResponse_p;
+    return kEplSuccessful;
+}
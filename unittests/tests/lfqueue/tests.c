@@ -0,0 +1,541 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for hostif lock-free queue
+
+This file contains the unit test functions for the lock-free queue of the host
+interface library. The queue is placed in process memory. The tests compare
+the enqueued and dequeued entries and measure the throughput of single and
+multiple enqueue and dequeue calls.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include "test-lfqueue.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_QUEUE_HDR_SIZE         16          // sizeof(tQueueBufferHdr)
+#define TEST_MAX_ENTRIES            16          // entries per batch
+#define TEST_MAX_ENTRY_SIZE         256         // size of an entry buffer
+#define TEST_BENCH_BURST            32          // entries per burst
+#define TEST_BENCH_ENTRY_SIZE       64          // payload size of an entry
+#define TEST_BENCH_ROUNDS           100000      // bursts per measurement
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tQueueInstance createQueue(UINT16 dataSpan_p);
+static void fillPattern(UINT8* pBuffer_p, UINT16 size_p, UINT32 seed_p);
+static unsigned long long getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT32       aaEntry_l[TEST_MAX_ENTRIES][TEST_MAX_ENTRY_SIZE / 4];
+static UINT32       aaResult_l[TEST_BENCH_BURST][TEST_MAX_ENTRY_SIZE / 4];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test single enqueue and dequeue
+
+The function enqueues entries of different sizes one by one and checks that
+they are dequeued in the same order with their aligned size.
+*/
+//------------------------------------------------------------------------------
+void test_lfqueue_single(void)
+{
+    static const UINT16 aSize[] = {4, 10, 100, 1};
+    tQueueInstance      pQueue;
+    UINT16              entryCount;
+    UINT16              size;
+    BOOL                fEmpty;
+    UINT32              i;
+
+    pQueue = createQueue(1024);
+    CU_ASSERT_PTR_NOT_NULL(pQueue);
+    if (pQueue == NULL)
+        return;
+
+    for (i = 0; i < 4; i++)
+    {
+        fillPattern((UINT8*)aaEntry_l[i], aSize[i], i);
+        CU_ASSERT_EQUAL(lfq_entryEnqueue(pQueue, (UINT8*)aaEntry_l[i], aSize[i]),
+                        kQueueSuccessful);
+    }
+
+    CU_ASSERT_EQUAL(lfq_getEntryCount(pQueue, &entryCount), kQueueSuccessful);
+    CU_ASSERT_EQUAL(entryCount, 4);
+
+    for (i = 0; i < 4; i++)
+    {
+        size = TEST_MAX_ENTRY_SIZE;
+        CU_ASSERT_EQUAL(lfq_entryDequeue(pQueue, (UINT8*)aaResult_l[i], &size),
+                        kQueueSuccessful);
+        CU_ASSERT_EQUAL(size, (aSize[i] + 3) & ~3);
+        CU_ASSERT_EQUAL(memcmp(aaResult_l[i], aaEntry_l[i], aSize[i]), 0);
+    }
+
+    size = TEST_MAX_ENTRY_SIZE;
+    CU_ASSERT_EQUAL(lfq_entryDequeue(pQueue, (UINT8*)aaResult_l[0], &size), kQueueEmpty);
+    CU_ASSERT_EQUAL(lfq_checkEmpty(pQueue, &fEmpty), kQueueSuccessful);
+    CU_ASSERT_TRUE(fEmpty);
+
+    lfq_delete(pQueue);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test multiple enqueue and dequeue
+
+The function enqueues a batch of entries with one call and dequeues them with
+one call. It checks that the batch is returned completely and in order.
+*/
+//------------------------------------------------------------------------------
+void test_lfqueue_multiple(void)
+{
+    tQueueInstance      pQueue;
+    UINT8*              apData[TEST_MAX_ENTRIES];
+    UINT16              aSize[TEST_MAX_ENTRIES];
+    UINT16              count;
+    UINT16              entryCount;
+    UINT32              i;
+
+    pQueue = createQueue(4096);
+    CU_ASSERT_PTR_NOT_NULL(pQueue);
+    if (pQueue == NULL)
+        return;
+
+    for (i = 0; i < 8; i++)
+    {
+        aSize[i] = (UINT16)((i * 20) + 4);
+        apData[i] = (UINT8*)aaEntry_l[i];
+        fillPattern(apData[i], aSize[i], i + 10);
+    }
+
+    CU_ASSERT_EQUAL(lfq_entryEnqueueMultiple(pQueue, apData, aSize, 8, &count),
+                    kQueueSuccessful);
+    CU_ASSERT_EQUAL(count, 8);
+
+    CU_ASSERT_EQUAL(lfq_getEntryCount(pQueue, &entryCount), kQueueSuccessful);
+    CU_ASSERT_EQUAL(entryCount, 8);
+
+    for (i = 0; i < TEST_MAX_ENTRIES; i++)
+    {
+        apData[i] = (UINT8*)aaResult_l[i];
+        aSize[i] = TEST_MAX_ENTRY_SIZE;
+    }
+
+    CU_ASSERT_EQUAL(lfq_entryDequeueMultiple(pQueue, apData, aSize, TEST_MAX_ENTRIES,
+                                             &count), kQueueSuccessful);
+    CU_ASSERT_EQUAL(count, 8);
+
+    for (i = 0; i < 8; i++)
+    {
+        CU_ASSERT_EQUAL(aSize[i], (i * 20) + 4);
+        CU_ASSERT_EQUAL(memcmp(aaResult_l[i], aaEntry_l[i], aSize[i]), 0);
+    }
+
+    CU_ASSERT_EQUAL(lfq_entryDequeueMultiple(pQueue, apData, aSize, TEST_MAX_ENTRIES,
+                                             &count), kQueueEmpty);
+    CU_ASSERT_EQUAL(count, 0);
+
+    lfq_delete(pQueue);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test enqueue into full queue
+
+The function enqueues a batch which doesn't fit into the queue completely.
+It checks that the fitting entries are enqueued and that a full queue rejects
+further entries.
+*/
+//------------------------------------------------------------------------------
+void test_lfqueue_full(void)
+{
+    tQueueInstance      pQueue;
+    UINT8*              apData[TEST_MAX_ENTRIES];
+    UINT16              aSize[TEST_MAX_ENTRIES];
+    UINT16              count;
+    UINT32              i;
+
+    // 256 bytes hold three entries of 60 bytes payload and 8 bytes header
+    pQueue = createQueue(256);
+    CU_ASSERT_PTR_NOT_NULL(pQueue);
+    if (pQueue == NULL)
+        return;
+
+    for (i = 0; i < 5; i++)
+    {
+        aSize[i] = 60;
+        apData[i] = (UINT8*)aaEntry_l[i];
+        fillPattern(apData[i], aSize[i], i + 20);
+    }
+
+    CU_ASSERT_EQUAL(lfq_entryEnqueueMultiple(pQueue, apData, aSize, 5, &count),
+                    kQueueSuccessful);
+    CU_ASSERT_EQUAL(count, 3);
+
+    CU_ASSERT_EQUAL(lfq_entryEnqueueMultiple(pQueue, &apData[3], &aSize[3], 2, &count),
+                    kQueueFull);
+    CU_ASSERT_EQUAL(count, 0);
+    CU_ASSERT_EQUAL(lfq_entryEnqueue(pQueue, apData[3], aSize[3]), kQueueFull);
+
+    for (i = 0; i < 5; i++)
+    {
+        apData[i] = (UINT8*)aaResult_l[i];
+        aSize[i] = TEST_MAX_ENTRY_SIZE;
+    }
+
+    CU_ASSERT_EQUAL(lfq_entryDequeueMultiple(pQueue, apData, aSize, 5, &count),
+                    kQueueSuccessful);
+    CU_ASSERT_EQUAL(count, 3);
+
+    for (i = 0; i < 3; i++)
+        CU_ASSERT_EQUAL(memcmp(aaResult_l[i], aaEntry_l[i], 60), 0);
+
+    lfq_delete(pQueue);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test wrap-around of queue buffer
+
+The function repeatedly enqueues and dequeues batches whose size isn't a
+divisor of the queue buffer span. Thus, entry headers and payloads are split
+at the end of the buffer.
+*/
+//------------------------------------------------------------------------------
+void test_lfqueue_wrapAround(void)
+{
+    tQueueInstance      pQueue;
+    UINT8*              apData[2];
+    UINT8*              apResult[2];
+    UINT16              aSize[2];
+    UINT16              count;
+    UINT32              round;
+    UINT32              i;
+    BOOL                fOk = TRUE;
+
+    pQueue = createQueue(256);
+    CU_ASSERT_PTR_NOT_NULL(pQueue);
+    if (pQueue == NULL)
+        return;
+
+    for (round = 0; round < 1000; round++)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            aSize[i] = (UINT16)(48 + ((round + i) % 3) * 4);
+            apData[i] = (UINT8*)aaEntry_l[i];
+            apResult[i] = (UINT8*)aaResult_l[i];
+            fillPattern(apData[i], aSize[i], (round * 2) + i);
+        }
+
+        if ((lfq_entryEnqueueMultiple(pQueue, apData, aSize, 2, &count) != kQueueSuccessful) ||
+            (count != 2))
+        {
+            fOk = FALSE;
+            break;
+        }
+
+        aSize[0] = TEST_MAX_ENTRY_SIZE;
+        aSize[1] = TEST_MAX_ENTRY_SIZE;
+        if ((lfq_entryDequeueMultiple(pQueue, apResult, aSize, 2, &count) != kQueueSuccessful) ||
+            (count != 2) ||
+            (aSize[0] != 48 + (round % 3) * 4) ||
+            (memcmp(apResult[0], apData[0], aSize[0]) != 0) ||
+            (memcmp(apResult[1], apData[1], aSize[1]) != 0))
+        {
+            fOk = FALSE;
+            break;
+        }
+    }
+
+    CU_ASSERT_TRUE(fOk);
+
+    lfq_delete(pQueue);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test dequeue with too small buffers
+
+The function checks that a batch dequeue stops at an entry which doesn't fit
+into the provided buffer and that this entry remains in the queue.
+*/
+//------------------------------------------------------------------------------
+void test_lfqueue_noResource(void)
+{
+    tQueueInstance      pQueue;
+    UINT8*              apData[3];
+    UINT16              aSize[3] = {16, 64, 16};
+    UINT16              count;
+    UINT16              size;
+    UINT32              i;
+
+    pQueue = createQueue(1024);
+    CU_ASSERT_PTR_NOT_NULL(pQueue);
+    if (pQueue == NULL)
+        return;
+
+    for (i = 0; i < 3; i++)
+    {
+        apData[i] = (UINT8*)aaEntry_l[i];
+        fillPattern(apData[i], aSize[i], i + 30);
+    }
+
+    CU_ASSERT_EQUAL(lfq_entryEnqueueMultiple(pQueue, apData, aSize, 3, &count),
+                    kQueueSuccessful);
+    CU_ASSERT_EQUAL(count, 3);
+
+    for (i = 0; i < 3; i++)
+        apData[i] = (UINT8*)aaResult_l[i];
+
+    // the second buffer is too small for the second entry
+    aSize[0] = 64;
+    aSize[1] = 32;
+    aSize[2] = 64;
+    CU_ASSERT_EQUAL(lfq_entryDequeueMultiple(pQueue, apData, aSize, 3, &count),
+                    kQueueSuccessful);
+    CU_ASSERT_EQUAL(count, 1);
+    CU_ASSERT_EQUAL(aSize[0], 16);
+    CU_ASSERT_EQUAL(memcmp(aaResult_l[0], aaEntry_l[0], 16), 0);
+
+    aSize[0] = 32;
+    CU_ASSERT_EQUAL(lfq_entryDequeueMultiple(pQueue, apData, aSize, 1, &count),
+                    kQueueNoResource);
+    CU_ASSERT_EQUAL(count, 0);
+
+    size = 64;
+    CU_ASSERT_EQUAL(lfq_entryDequeue(pQueue, (UINT8*)aaResult_l[1], &size), kQueueSuccessful);
+    CU_ASSERT_EQUAL(size, 64);
+    CU_ASSERT_EQUAL(memcmp(aaResult_l[1], aaEntry_l[1], 64), 0);
+
+    size = 64;
+    CU_ASSERT_EQUAL(lfq_entryDequeue(pQueue, (UINT8*)aaResult_l[2], &size), kQueueSuccessful);
+    CU_ASSERT_EQUAL(memcmp(aaResult_l[2], aaEntry_l[2], 16), 0);
+
+    lfq_delete(pQueue);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark single and multiple enqueue and dequeue
+
+The function transfers bursts of entries through the queue, once with single
+enqueue and dequeue calls and once with one multiple call per burst. It
+prints the time per entry of both variants.
+*/
+//------------------------------------------------------------------------------
+void test_lfqueue_benchmark(void)
+{
+    tQueueInstance      pQueue;
+    UINT8*              apData[TEST_BENCH_BURST];
+    UINT8*              apResult[TEST_BENCH_BURST];
+    UINT16              aSize[TEST_BENCH_BURST];
+    UINT16              count;
+    UINT16              size;
+    UINT32              round;
+    UINT32              i;
+    UINT32              errors = 0;
+    unsigned long long  singleTime;
+    unsigned long long  multipleTime;
+    unsigned long long  startTime;
+
+    pQueue = createQueue(8192);
+    CU_ASSERT_PTR_NOT_NULL(pQueue);
+    if (pQueue == NULL)
+        return;
+
+    for (i = 0; i < TEST_BENCH_BURST; i++)
+    {
+        apData[i] = (UINT8*)aaEntry_l[i % TEST_MAX_ENTRIES];
+        apResult[i] = (UINT8*)aaResult_l[i];
+        fillPattern(apData[i], TEST_BENCH_ENTRY_SIZE, i);
+    }
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < TEST_BENCH_BURST; i++)
+        {
+            if (lfq_entryEnqueue(pQueue, apData[i], TEST_BENCH_ENTRY_SIZE) != kQueueSuccessful)
+                errors++;
+        }
+
+        for (i = 0; i < TEST_BENCH_BURST; i++)
+        {
+            size = TEST_MAX_ENTRY_SIZE;
+            if (lfq_entryDequeue(pQueue, apResult[i], &size) != kQueueSuccessful)
+                errors++;
+        }
+    }
+    singleTime = getTimeNs() - startTime;
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < TEST_BENCH_BURST; i++)
+            aSize[i] = TEST_BENCH_ENTRY_SIZE;
+
+        if ((lfq_entryEnqueueMultiple(pQueue, apData, aSize, TEST_BENCH_BURST,
+                                      &count) != kQueueSuccessful) ||
+            (count != TEST_BENCH_BURST))
+            errors++;
+
+        for (i = 0; i < TEST_BENCH_BURST; i++)
+            aSize[i] = TEST_MAX_ENTRY_SIZE;
+
+        if ((lfq_entryDequeueMultiple(pQueue, apResult, aSize, TEST_BENCH_BURST,
+                                      &count) != kQueueSuccessful) ||
+            (count != TEST_BENCH_BURST))
+            errors++;
+    }
+    multipleTime = getTimeNs() - startTime;
+
+    CU_ASSERT_EQUAL(errors, 0);
+    for (i = 0; i < TEST_BENCH_BURST; i++)
+        CU_ASSERT_EQUAL(memcmp(apResult[i], apData[i], TEST_BENCH_ENTRY_SIZE), 0);
+
+    printf("\n    %u bursts of %u x %u bytes: single %6.1f ns/entry, multiple %6.1f ns/entry\n",
+           TEST_BENCH_ROUNDS, TEST_BENCH_BURST, TEST_BENCH_ENTRY_SIZE,
+           (double)singleTime / ((double)TEST_BENCH_ROUNDS * TEST_BENCH_BURST),
+           (double)multipleTime / ((double)TEST_BENCH_ROUNDS * TEST_BENCH_BURST));
+
+    lfq_delete(pQueue);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create queue in process memory
+
+\param  dataSpan_p          Span of the queue data section, must be a power
+                            of 2.
+
+\return The function returns the queue instance or NULL on error.
+*/
+//------------------------------------------------------------------------------
+static tQueueInstance createQueue(UINT16 dataSpan_p)
+{
+    tQueueConfig        config;
+    tQueueInstance      pQueue = NULL;
+
+    config.queueRole = kQueueBoth;
+    config.fAllocHeap = TRUE;
+    config.pBase = NULL;
+    config.span = dataSpan_p + TEST_QUEUE_HDR_SIZE;
+
+    if (lfq_create(&config, &pQueue) != kQueueSuccessful)
+        return NULL;
+
+    return pQueue;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill buffer with test pattern
+
+The function fills a buffer with a pseudo random byte pattern.
+
+\param  pBuffer_p           Pointer to the buffer.
+\param  size_p              Size of the buffer.
+\param  seed_p              Start value of the pattern.
+*/
+//------------------------------------------------------------------------------
+static void fillPattern(UINT8* pBuffer_p, UINT16 size_p, UINT32 seed_p)
+{
+    UINT32      value = seed_p;
+    UINT16      i;
+
+    for (i = 0; i < size_p; i++)
+    {
+        value = (value * 1103515245UL) + 12345UL;
+        pBuffer_p[i] = (UINT8)(value >> 16);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static unsigned long long getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((unsigned long long)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
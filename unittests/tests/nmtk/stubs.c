@@ -0,0 +1,150 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for kernel error handler module unit tests
+
+This file contains all stubs needed by the unit tests of the NMT kernel
+module. The DLL and event stubs record the state changes reported by the NMT
+state machine.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <event.h>
+#include <kernel/eventk.h>
+#include <kernel/dllk.h>
+
+#include "test-nmtk.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_MAX_STATE_CHANGES      32
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tNmtState    aStateChange_l[STUB_MAX_STATE_CHANGES];
+static UINT         stateChangeCount_l;
+static UINT         postedEventCount_l;
+static UINT         nmtEventMask_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_reset(void)
+{
+    stateChangeCount_l = 0;
+    postedEventCount_l = 0;
+    nmtEventMask_l = DLLK_NMTEVENT_ALL;
+}
+
+UINT stub_getStateChangeCount(void)
+{
+    return stateChangeCount_l;
+}
+
+tNmtState stub_getStateChange(UINT index_p)
+{
+    return aStateChange_l[index_p];
+}
+
+UINT stub_getPostedEventCount(void)
+{
+    return postedEventCount_l;
+}
+
+UINT stub_getNmtEventMask(void)
+{
+    return nmtEventMask_l;
+}
+
+tEplKernel dllk_process(tEplEvent* pEvent_p)
+{
+    tEventNmtStateChange*   pStateChange = (tEventNmtStateChange*)pEvent_p->m_pArg;
+
+    if ((pEvent_p->m_EventType == kEplEventTypeNmtStateChange) &&
+        (stateChangeCount_l < STUB_MAX_STATE_CHANGES))
+    {
+        aStateChange_l[stateChangeCount_l++] = pStateChange->newNmtState;
+    }
+    return kEplSuccessful;
+}
+
+void dllk_setNmtEventMask(UINT nmtEventMask_p)
+{
+    nmtEventMask_l = nmtEventMask_p;
+}
+
+tEplKernel eventk_postEvent(tEplEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+    postedEventCount_l++;
+    return kEplSuccessful;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
@@ -0,0 +1,320 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for NMT kernel module
+
+This file contains the unit test functions for the NMT kernel
+module. They check that the NMT events of received frames which are
+suppressed by the DLL according to the event mask of the current NMT state
+do not influence the NMT state machine.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <event.h>
+#include <kernel/nmtk.h>
+#include <kernel/dllk.h>
+
+#include "test-nmtk.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_MAX_PATH_LEN           16
+#define TEST_LAST_NMT_EVENT         kNmtEventCriticalError
+
+#define TEST_PATH_RESET_CONFIG      kNmtEventSwReset, kNmtEventEnterResetApp, \
+                                    kNmtEventEnterResetCom, kNmtEventEnterResetConfig
+#define TEST_PATH_CS_PREOP2         TEST_PATH_RESET_CONFIG, kNmtEventEnterCsNotActive, \
+                                    kNmtEventDllCeSoc, kNmtEventDllCeSoc
+#define TEST_PATH_CS_OP             TEST_PATH_CS_PREOP2, kNmtEventEnterReadyToOperate, \
+                                    kNmtEventEnableReadyToOperate, kNmtEventStartNode
+#define TEST_PATH_MS_PREOP1         TEST_PATH_RESET_CONFIG, kNmtEventEnterMsNotActive, \
+                                    kNmtEventTimerMsPreOp1
+#define TEST_PATH_MS_PREOP2         TEST_PATH_MS_PREOP1, kNmtEventTimerMsPreOp2, \
+                                    kNmtEventAllMandatoryCNIdent
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Event sequence leading to a NMT state
+
+The event sequence is applied to a freshly initialized NMT state machine. The
+list of events is terminated by kNmtEventNoEvent.
+*/
+typedef struct
+{
+    tNmtState       nmtState;                       ///< Resulting NMT state
+    UINT            dllEventMask;                   ///< Expected DLLK_NMTEVENT_xxx mask
+    tNmtEvent       aEvent[TEST_MAX_PATH_LEN];      ///< Event sequence
+} tStatePath;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void         postNmtEvent(tNmtEvent nmtEvent_p);
+static tNmtState    replayPath(const tStatePath* pPath_p);
+static BOOL         compareFollowUp(const tStatePath* pPath_p, tNmtEvent dllEvent_p,
+                                    tNmtEvent event1_p, tNmtEvent event2_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const tStatePath     aStatePath_l[] =
+{
+    { kNmtGsInitialising,       DLLK_NMTEVENT_NONE, { kNmtEventSwReset } },
+    { kNmtGsResetApplication,   DLLK_NMTEVENT_NONE, { kNmtEventSwReset, kNmtEventEnterResetApp } },
+    { kNmtGsResetCommunication, DLLK_NMTEVENT_NONE, { kNmtEventSwReset, kNmtEventEnterResetApp, kNmtEventEnterResetCom } },
+    { kNmtGsResetConfiguration, DLLK_NMTEVENT_NONE, { TEST_PATH_RESET_CONFIG } },
+    { kNmtCsNotActive,          DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA,
+                                                    { TEST_PATH_RESET_CONFIG, kNmtEventEnterCsNotActive } },
+    { kNmtCsBasicEthernet,      DLLK_NMTEVENT_ALL,  { TEST_PATH_RESET_CONFIG, kNmtEventEnterCsNotActive, kNmtEventTimerBasicEthernet } },
+    { kNmtCsPreOperational1,    DLLK_NMTEVENT_SOC,  { TEST_PATH_RESET_CONFIG, kNmtEventEnterCsNotActive, kNmtEventDllCeSoc } },
+    { kNmtCsPreOperational2,    DLLK_NMTEVENT_NONE, { TEST_PATH_CS_PREOP2 } },
+    { kNmtCsPreOperational2,    DLLK_NMTEVENT_NONE, { TEST_PATH_CS_PREOP2, kNmtEventEnterReadyToOperate } },
+    { kNmtCsPreOperational2,    DLLK_NMTEVENT_NONE, { TEST_PATH_CS_PREOP2, kNmtEventEnableReadyToOperate } },
+    { kNmtCsReadyToOperate,     DLLK_NMTEVENT_NONE, { TEST_PATH_CS_PREOP2, kNmtEventEnterReadyToOperate, kNmtEventEnableReadyToOperate } },
+    { kNmtCsOperational,        DLLK_NMTEVENT_NONE, { TEST_PATH_CS_OP } },
+    { kNmtCsStopped,            DLLK_NMTEVENT_NONE, { TEST_PATH_CS_OP, kNmtEventStopNode } },
+    { kNmtCsPreOperational1,    DLLK_NMTEVENT_SOC,  { TEST_PATH_CS_OP, kNmtEventNmtCycleError } },
+    { kNmtMsNotActive,          DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA,
+                                                    { TEST_PATH_RESET_CONFIG, kNmtEventEnterMsNotActive } },
+    { kNmtMsBasicEthernet,      DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA,
+                                                    { TEST_PATH_RESET_CONFIG, kNmtEventEnterMsNotActive, kNmtEventTimerBasicEthernet } },
+    { kNmtMsPreOperational1,    DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA, { TEST_PATH_MS_PREOP1 } },
+    { kNmtMsPreOperational1,    DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA, { TEST_PATH_MS_PREOP1, kNmtEventTimerMsPreOp2 } },
+    { kNmtMsPreOperational1,    DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA, { TEST_PATH_MS_PREOP1, kNmtEventAllMandatoryCNIdent } },
+    { kNmtMsPreOperational2,    DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA, { TEST_PATH_MS_PREOP2 } },
+    { kNmtMsReadyToOperate,     DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA, { TEST_PATH_MS_PREOP2, kNmtEventEnterReadyToOperate } },
+    { kNmtMsOperational,        DLLK_NMTEVENT_SOC | DLLK_NMTEVENT_SOA, { TEST_PATH_MS_PREOP2, kNmtEventEnterReadyToOperate, kNmtEventEnterMsOperational } },
+};
+
+static const tNmtEvent      aDllEvent_l[] =
+{
+    kNmtEventDllCeSoc, kNmtEventDllCePreq, kNmtEventDllCePres, kNmtEventDllCeSoa
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test NMT state paths and DLL event masks
+
+The test checks that each event sequence leads to the expected NMT state and
+that the NMT state machine passes the expected event mask to the DLL.
+*/
+//------------------------------------------------------------------------------
+void test_nmtk_statePaths(void)
+{
+    UINT        i;
+
+    for (i = 0; i < tabentries(aStatePath_l); i++)
+    {
+        CU_ASSERT_EQUAL(replayPath(&aStatePath_l[i]), aStatePath_l[i].nmtState);
+        CU_ASSERT_EQUAL(stub_getNmtEventMask(), aStatePath_l[i].dllEventMask);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test that suppressed DLL events do not change the NMT state machine
+
+For every NMT state, each DLL event which is not contained in the event mask of
+the state is processed by the NMT state machine. It must neither change the
+state nor post events. Additionally all sequences of two subsequent events
+must lead to the same state changes as without the DLL event, so that internal
+flags of the state machine are not affected either.
+*/
+//------------------------------------------------------------------------------
+void test_nmtk_suppressedDllEvents(void)
+{
+    UINT        i;
+    UINT        j;
+    UINT        mask;
+    UINT        stateChangeCount;
+    UINT        postedEventCount;
+    tNmtEvent   event1;
+    tNmtEvent   event2;
+
+    for (i = 0; i < tabentries(aStatePath_l); i++)
+    {
+        for (j = 0; j < tabentries(aDllEvent_l); j++)
+        {
+            replayPath(&aStatePath_l[i]);
+            mask = stub_getNmtEventMask();
+            if ((mask & (1 << (aDllEvent_l[j] - kNmtEventDllCeSoc))) != 0)
+                continue;
+
+            stateChangeCount = stub_getStateChangeCount();
+            postedEventCount = stub_getPostedEventCount();
+            postNmtEvent(aDllEvent_l[j]);
+            CU_ASSERT_EQUAL(stub_getStateChangeCount(), stateChangeCount);
+            CU_ASSERT_EQUAL(stub_getPostedEventCount(), postedEventCount);
+
+            for (event1 = kNmtEventNoEvent; event1 <= TEST_LAST_NMT_EVENT; event1++)
+            {
+                for (event2 = kNmtEventNoEvent; event2 <= TEST_LAST_NMT_EVENT; event2++)
+                {
+                    if (!compareFollowUp(&aStatePath_l[i], aDllEvent_l[j], event1, event2))
+                    {
+                        CU_FAIL("Suppressed DLL event changes NMT state machine");
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Post NMT event to NMT state machine
+
+\param  nmtEvent_p          NMT event to be processed
+*/
+//------------------------------------------------------------------------------
+static void postNmtEvent(tNmtEvent nmtEvent_p)
+{
+    tEplEvent       event;
+
+    EPL_MEMSET(&event, 0, sizeof(event));
+    event.m_EventSink = kEplEventSinkNmtk;
+    event.m_EventType = kEplEventTypeNmtEvent;
+    event.m_uiSize = sizeof(nmtEvent_p);
+    event.m_pArg = &nmtEvent_p;
+    nmtk_process(&event);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize NMT state machine and apply event sequence
+
+\param  pPath_p             Event sequence to apply
+
+\return Returns the resulting NMT state
+*/
+//------------------------------------------------------------------------------
+static tNmtState replayPath(const tStatePath* pPath_p)
+{
+    UINT        i;
+
+    nmtk_init();
+    stub_reset();
+
+    for (i = 0; (i < TEST_MAX_PATH_LEN) && (pPath_p->aEvent[i] != kNmtEventNoEvent); i++)
+        postNmtEvent(pPath_p->aEvent[i]);
+
+    if (stub_getStateChangeCount() == 0)
+        return kNmtGsOff;
+
+    return stub_getStateChange(stub_getStateChangeCount() - 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare state changes of two events with and without DLL event
+
+\param  pPath_p             Event sequence leading to the tested state
+\param  dllEvent_p          Suppressed DLL event
+\param  event1_p            First subsequent event
+\param  event2_p            Second subsequent event
+
+\return Returns TRUE if the NMT state machine behaves identically
+*/
+//------------------------------------------------------------------------------
+static BOOL compareFollowUp(const tStatePath* pPath_p, tNmtEvent dllEvent_p,
+                            tNmtEvent event1_p, tNmtEvent event2_p)
+{
+    tNmtState   aStateChange[2][4];
+    UINT        aStateChangeCount[2];
+    UINT        run;
+    UINT        first;
+    UINT        i;
+
+    for (run = 0; run < 2; run++)
+    {
+        replayPath(pPath_p);
+        first = stub_getStateChangeCount();
+        if (run == 1)
+            postNmtEvent(dllEvent_p);
+        postNmtEvent(event1_p);
+        postNmtEvent(event2_p);
+
+        aStateChangeCount[run] = stub_getStateChangeCount() - first;
+        for (i = 0; i < aStateChangeCount[run]; i++)
+            aStateChange[run][i] = stub_getStateChange(first + i);
+    }
+
+    if (aStateChangeCount[0] != aStateChangeCount[1])
+        return FALSE;
+
+    for (i = 0; i < aStateChangeCount[0]; i++)
+    {
+        if (aStateChange[0][i] != aStateChange[1][i])
+            return FALSE;
+    }
+    return TRUE;
+}
+
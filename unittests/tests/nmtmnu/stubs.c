@@ -0,0 +1,365 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for NMT MNU module unit tests
+
+This file contains all stubs needed by the unit tests of the NMT MNU module.
+The object dictionary stub holds the NMT objects of all nodes. The DLL and
+ident stubs record the node IDs they are called with, so that the tests can
+check which nodes the module processes and in which order.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <obd.h>
+#include <user/dllucal.h>
+#include <user/eventu.h>
+#include <user/identu.h>
+#include <user/statusu.h>
+#include <user/syncu.h>
+#include <user/nmtu.h>
+#include <user/EplTimeru.h>
+
+#include "test-nmtmnu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_MAX_RECORDS            1024        ///< Number of calls a record is able to hold
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Record of node IDs passed to a stub function
+*/
+typedef struct
+{
+    UINT            count;
+    UINT8           aNodeId[STUB_MAX_RECORDS];
+} tStubRecord;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void addRecord(tStubRecord* pRecord_p, UINT nodeId_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT32       aNodeAssignment_l[EPL_NMT_MAX_NODE_ID];
+static UINT8        aExpNmtState_l[EPL_NMT_MAX_NODE_ID];
+static UINT8        aCurNmtState_l[EPL_NMT_MAX_NODE_ID];
+static tStubRecord  aRecord_l[kStubRecordCount];
+static tNmtState    nmtState_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_reset(void)
+{
+    EPL_MEMSET(aNodeAssignment_l, 0, sizeof(aNodeAssignment_l));
+    EPL_MEMSET(aExpNmtState_l, 0, sizeof(aExpNmtState_l));
+    EPL_MEMSET(aCurNmtState_l, 0, sizeof(aCurNmtState_l));
+    EPL_MEMSET(aRecord_l, 0, sizeof(aRecord_l));
+    nmtState_l = kNmtGsResetConfiguration;
+}
+
+void stub_clearRecords(void)
+{
+    EPL_MEMSET(aRecord_l, 0, sizeof(aRecord_l));
+}
+
+UINT stub_getRecordCount(tStubRecordType type_p)
+{
+    return aRecord_l[type_p].count;
+}
+
+UINT stub_getRecordNodeId(tStubRecordType type_p, UINT index_p)
+{
+    if (index_p >= aRecord_l[type_p].count)
+        return EPL_C_ADR_INVALID;
+
+    return aRecord_l[type_p].aNodeId[index_p];
+}
+
+void stub_setNodeAssignment(UINT nodeId_p, UINT32 nodeCfg_p)
+{
+    aNodeAssignment_l[nodeId_p - 1] = nodeCfg_p;
+}
+
+void stub_setNmtState(tNmtState nmtState_p)
+{
+    nmtState_l = nmtState_p;
+}
+
+//------------------------------------------------------------------------------
+// OBD stubs
+//------------------------------------------------------------------------------
+UINT obd_getNodeId(void)
+{
+    return STUB_LOCAL_NODE_ID;
+}
+
+tEplKernel obd_readEntry(UINT index_p, UINT subIndex_p, void* pDstData_p, tObdSize* pSize_p)
+{
+    switch (index_p)
+    {
+        case 0x1F81:
+            if ((subIndex_p == 0) || (subIndex_p > EPL_NMT_MAX_NODE_ID) || (*pSize_p < 4))
+                return kEplObdSubindexNotExist;
+            *(UINT32*)pDstData_p = aNodeAssignment_l[subIndex_p - 1];
+            *pSize_p = 4;
+            break;
+
+        case 0x1F8E:
+        case 0x1F8F:
+            if ((subIndex_p == 0) || (subIndex_p > EPL_NMT_MAX_NODE_ID) || (*pSize_p < 1))
+                return kEplObdSubindexNotExist;
+            if (index_p == 0x1F8E)
+                *(UINT8*)pDstData_p = aCurNmtState_l[subIndex_p - 1];
+            else
+                *(UINT8*)pDstData_p = aExpNmtState_l[subIndex_p - 1];
+            *pSize_p = 1;
+            break;
+
+        default:
+            // all other objects are zero
+            EPL_MEMSET(pDstData_p, 0, *pSize_p);
+            break;
+    }
+    return kEplSuccessful;
+}
+
+tEplKernel obd_writeEntry(UINT index_p, UINT subIndex_p, void* pSrcData_p, tObdSize size_p)
+{
+    UNUSED_PARAMETER(size_p);
+
+    switch (index_p)
+    {
+        case 0x1F81:
+            if ((subIndex_p == 0) || (subIndex_p > EPL_NMT_MAX_NODE_ID))
+                return kEplObdSubindexNotExist;
+            aNodeAssignment_l[subIndex_p - 1] = *(UINT32*)pSrcData_p;
+            break;
+
+        case 0x1F8E:
+        case 0x1F8F:
+            if ((subIndex_p == 0) || (subIndex_p > EPL_NMT_MAX_NODE_ID))
+                return kEplObdSubindexNotExist;
+            if (index_p == 0x1F8E)
+                aCurNmtState_l[subIndex_p - 1] = *(UINT8*)pSrcData_p;
+            else
+                aExpNmtState_l[subIndex_p - 1] = *(UINT8*)pSrcData_p;
+            break;
+
+        default:
+            break;
+    }
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+// DLL stubs
+//------------------------------------------------------------------------------
+tEplKernel dllucal_regAsndService(tDllAsndServiceId ServiceId_p,
+                                  tEplDlluCbAsnd pfnDlluCbAsnd_p,
+                                  tDllAsndFilter Filter_p)
+{
+    UNUSED_PARAMETER(ServiceId_p);
+    UNUSED_PARAMETER(pfnDlluCbAsnd_p);
+    UNUSED_PARAMETER(Filter_p);
+    return kEplSuccessful;
+}
+
+tEplKernel dllucal_sendAsyncFrame(tFrameInfo* pFrameInfo_p, tDllAsyncReqPriority Priority_p)
+{
+    UNUSED_PARAMETER(Priority_p);
+
+    addRecord(&aRecord_l[kStubRecordNmtCommand], AmiGetByteFromLe(&pFrameInfo_p->pFrame->m_le_bDstNodeId));
+    return kEplSuccessful;
+}
+
+tEplKernel dllucal_addNode(tDllNodeOpParam* pNodeOpParam_p)
+{
+    addRecord(&aRecord_l[kStubRecordAddNode], pNodeOpParam_p->nodeId);
+    return kEplSuccessful;
+}
+
+tEplKernel dllucal_deleteNode(tDllNodeOpParam* pNodeOpParam_p)
+{
+    addRecord(&aRecord_l[kStubRecordDeleteNode], pNodeOpParam_p->nodeId);
+    return kEplSuccessful;
+}
+
+tEplKernel dllucal_configNode(tDllNodeInfo* pNodeInfo_p)
+{
+    UNUSED_PARAMETER(pNodeInfo_p);
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+// Ident, status and sync stubs
+//------------------------------------------------------------------------------
+tEplKernel identu_requestIdentResponse(UINT nodeId_p, tIdentuCbResponse pfnCbResponse_p)
+{
+    UNUSED_PARAMETER(pfnCbResponse_p);
+
+    addRecord(&aRecord_l[kStubRecordIdentRequest], nodeId_p);
+    return kEplSuccessful;
+}
+
+tEplKernel identu_reset(void)
+{
+    return kEplSuccessful;
+}
+
+tEplKernel statusu_requestStatusResponse(UINT nodeId_p, tStatusuCbResponse pfnCbResponse_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(pfnCbResponse_p);
+    return kEplSuccessful;
+}
+
+tEplKernel statusu_reset(void)
+{
+    return kEplSuccessful;
+}
+
+tEplKernel syncu_requestSyncResponse(tSyncuCbResponse pfnCbResponse_p,
+                                     tDllSyncRequest* pSyncRequestData_p,
+                                     UINT size_p)
+{
+    UNUSED_PARAMETER(pfnCbResponse_p);
+    UNUSED_PARAMETER(pSyncRequestData_p);
+    UNUSED_PARAMETER(size_p);
+    return kEplSuccessful;
+}
+
+tEplKernel syncu_reset(void)
+{
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+// NMT, event, timer and target stubs
+//------------------------------------------------------------------------------
+tNmtState nmtu_getNmtState(void)
+{
+    return nmtState_l;
+}
+
+tEplKernel nmtu_postNmtEvent(tNmtEvent nmtEvent_p)
+{
+    UNUSED_PARAMETER(nmtEvent_p);
+    return kEplSuccessful;
+}
+
+tEplKernel eventu_postEvent(tEplEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+    return kEplSuccessful;
+}
+
+tEplKernel eventu_postError(tEplEventSource EventSource_p, tEplKernel error_p,
+                            UINT argSize_p, void* pArg_p)
+{
+    UNUSED_PARAMETER(EventSource_p);
+    UNUSED_PARAMETER(error_p);
+    UNUSED_PARAMETER(argSize_p);
+    UNUSED_PARAMETER(pArg_p);
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplTimeruModifyTimerMs(tEplTimerHdl* pTimerHdl_p, unsigned long ulTimeMs_p,
+                                        tEplTimerArg Argument_p)
+{
+    UNUSED_PARAMETER(ulTimeMs_p);
+    UNUSED_PARAMETER(Argument_p);
+
+    *pTimerHdl_p = 1;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplTimeruDeleteTimer(tEplTimerHdl* pTimerHdl_p)
+{
+    *pTimerHdl_p = 0;
+    return kEplSuccessful;
+}
+
+DWORD PUBLIC EplTgtGetTickCountMs(void)
+{
+    return 0;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add node ID to a record
+
+\param  pRecord_p           Pointer to the record.
+\param  nodeId_p            Node ID to add.
+*/
+//------------------------------------------------------------------------------
+static void addRecord(tStubRecord* pRecord_p, UINT nodeId_p)
+{
+    if (pRecord_p->count < STUB_MAX_RECORDS)
+        pRecord_p->aNodeId[pRecord_p->count++] = (UINT8)nodeId_p;
+}
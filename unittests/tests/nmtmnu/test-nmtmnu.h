@@ -0,0 +1,95 @@
+/**
+********************************************************************************
+\file   test-nmtmnu.h
+
+\brief  Definitions unit tests of NMT MNU module
+
+The file contains the definitions for the unit tests of the NMT MNU module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_test_nmtmnu_H_
+#define _INC_test_nmtmnu_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <nmt.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_LOCAL_NODE_ID          240         ///< Node ID of the local node (MN)
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/// Calls recorded by the stubs
+typedef enum
+{
+    kStubRecordIdentRequest         = 0,        ///< identu_requestIdentResponse()
+    kStubRecordAddNode              = 1,        ///< dllucal_addNode()
+    kStubRecordDeleteNode           = 2,        ///< dllucal_deleteNode()
+    kStubRecordNmtCommand           = 3,        ///< dllucal_sendAsyncFrame() with NMT command
+    kStubRecordCount                = 4,
+} tStubRecordType;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void test_nmtmnu_timelineCsv(void);
+void test_nmtmnu_timelineCsvEmpty(void);
+void test_nmtmnu_timelineCsvInvalid(void);
+void test_nmtmnu_nodeList(void);
+void test_nmtmnu_nodeListUpdateDuringBoot(void);
+void test_nmtmnu_nodeListResetConfiguration(void);
+void test_nmtmnu_nodeListInvalidNode(void);
+void test_nmtmnu_bootStep1Benchmark(void);
+
+// stub control functions
+void stub_reset(void);
+void stub_clearRecords(void);
+UINT stub_getRecordCount(tStubRecordType type_p);
+UINT stub_getRecordNodeId(tStubRecordType type_p, UINT index_p);
+void stub_setNodeAssignment(UINT nodeId_p, UINT32 nodeCfg_p);
+void stub_setNmtState(tNmtState nmtState_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_test_nmtmnu_H_ */
@@ -0,0 +1,562 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for NMT MNU module
+
+This file contains the unit test functions for the NMT MNU module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <user/nmtmnu.h>
+#include <user/nmtu.h>
+
+#include "test-nmtmnu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_MN_NODE_ID             239         ///< Node ID of the MN, differs from EPL_C_ADR_MN_DEF_NODE_ID
+#define TEST_CSV_SIZE               1024
+
+#define TEST_CN_CFG                 (EPL_NODEASSIGN_NODE_IS_CN | EPL_NODEASSIGN_NODE_EXISTS)
+#define TEST_MN_CFG                 (EPL_NODEASSIGN_NODE_EXISTS | EPL_NODEASSIGN_MN_PRES)
+#define TEST_ADDED_NODE_ID          7
+#define TEST_REMOVED_NODE_ID        5
+#define TEST_BENCHMARK_ROUNDS       10000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void initTimeline(tNmtBootTimeline* pTimeline_p);
+static void getFilename(char* pszFilename_p, size_t size_p);
+static BOOL readFile(const char* pszFilename_p, char* pszBuffer_p, size_t size_p);
+static void initNmtMnu(void);
+static tEplKernel changeState(tNmtState newNmtState_p);
+static void bootMn(void);
+static BOOL checkRecord(tStubRecordType type_p, const UINT* pNodeIds_p, UINT count_p);
+static tEplKernel cbNodeEvent(UINT nodeId_p, tNmtNodeEvent nodeEvent_p, tNmtState nmtState_p,
+                              UINT16 errorCode_p, BOOL fMandatory_p);
+static tEplKernel cbBootEvent(tNmtBootEvent bootEvent_p, tNmtState nmtState_p,
+                              UINT16 errorCode_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+// assigned CNs, node 174 shares the word of the node assignment bitmap which
+// follows the node info array with the PRes Chaining bit of nodeCfg
+static const UINT   aCnNodeId_l[] = {1, 5, 31, 32, 33, 174, 200};
+
+// CNs of the boot process including the diagnostic node
+static const UINT   aBootNodeId_l[] = {1, 5, 31, 32, 33, 174, 200, EPL_C_ADR_DIAG_DEF_NODE_ID};
+static const UINT   aUpdatedNodeId_l[] = {1, 7, 31, 32, 33, 174, 200, EPL_C_ADR_DIAG_DEF_NODE_ID};
+static const UINT   aRemovedNodeId_l[] = {1, 31, 32, 33, 174, 200, EPL_C_ADR_DIAG_DEF_NODE_ID};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test boot timeline CSV file
+
+The test writes a timeline with some reached boot phases and CN milestones and
+checks that the file contains exactly these events. Boot phases must be written
+with the node ID of the MN, CN milestones with the node ID of the CN.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_timelineCsv(void)
+{
+    tNmtBootTimeline    timeline;
+    char                aFilename[64];
+    char                aCsv[TEST_CSV_SIZE];
+
+    initTimeline(&timeline);
+    timeline.aPhaseTime[kNmtBootPhasePreOp1] = 0;
+    timeline.aPhaseTime[kNmtBootPhaseBootStep1] = 5;
+    timeline.aPhaseTime[kNmtBootPhaseBootStep2] = 1250;
+    timeline.aPhaseTime[kNmtBootPhaseCheckCom] = 1400;
+    timeline.aaNodeTime[0][kNmtBootNodeEventIdentResponse] = 7;
+    timeline.aaNodeTime[0][kNmtBootNodeEventConfigured] = 830;
+    timeline.aaNodeTime[0][kNmtBootNodeEventStatusResponse] = 1260;
+    timeline.aaNodeTime[NMT_BOOT_TIMELINE_NODE_COUNT - 1][kNmtBootNodeEventIdentResponse] = 9;
+    timeline.aaNodeTime[NMT_BOOT_TIMELINE_NODE_COUNT - 1][kNmtBootNodeEventOperational] = 70000;
+
+    getFilename(aFilename, sizeof(aFilename));
+    CU_ASSERT_EQUAL_FATAL(nmtmnu_writeBootTimelineCsv(&timeline, TEST_MN_NODE_ID, aFilename),
+                          kEplSuccessful);
+    CU_ASSERT_FATAL(readFile(aFilename, aCsv, sizeof(aCsv)));
+    unlink(aFilename);
+
+    CU_ASSERT_STRING_EQUAL(aCsv,
+                           "event,node,time_ms\n"
+                           "PreOp1,239,0\n"
+                           "BootStep1,239,5\n"
+                           "BootStep2,239,1250\n"
+                           "CheckCom,239,1400\n"
+                           "IdentResponse,1,7\n"
+                           "Configured,1,830\n"
+                           "StatusResponse,1,1260\n"
+                           "IdentResponse,254,9\n"
+                           "Operational,254,70000\n");
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test boot timeline CSV file without events
+
+The test checks that only the header line is written if no boot phase and no
+CN milestone was reached.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_timelineCsvEmpty(void)
+{
+    tNmtBootTimeline    timeline;
+    char                aFilename[64];
+    char                aCsv[TEST_CSV_SIZE];
+
+    initTimeline(&timeline);
+
+    getFilename(aFilename, sizeof(aFilename));
+    CU_ASSERT_EQUAL_FATAL(nmtmnu_writeBootTimelineCsv(&timeline, TEST_MN_NODE_ID, aFilename),
+                          kEplSuccessful);
+    CU_ASSERT_FATAL(readFile(aFilename, aCsv, sizeof(aCsv)));
+    unlink(aFilename);
+
+    CU_ASSERT_STRING_EQUAL(aCsv, "event,node,time_ms\n");
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test boot timeline CSV file with invalid parameters
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_timelineCsvInvalid(void)
+{
+    tNmtBootTimeline    timeline;
+    char                aFilename[64];
+
+    initTimeline(&timeline);
+    getFilename(aFilename, sizeof(aFilename));
+
+    CU_ASSERT_EQUAL(nmtmnu_writeBootTimelineCsv(NULL, TEST_MN_NODE_ID, aFilename),
+                    kEplNmtInvalidParam);
+    CU_ASSERT_EQUAL(nmtmnu_writeBootTimelineCsv(&timeline, TEST_MN_NODE_ID, NULL),
+                    kEplNmtInvalidParam);
+    CU_ASSERT_EQUAL(access(aFilename, F_OK), -1);
+
+    CU_ASSERT_EQUAL(nmtmnu_writeBootTimelineCsv(&timeline, TEST_MN_NODE_ID,
+                                                "/nonexistent/timeline.csv"),
+                    kEplNoResource);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test node list of the boot process
+
+The test checks that BootStep1 takes exactly the assigned CNs and the
+diagnostic node into the boot process and that a broadcast NMT command
+processes them in ascending order. Nodes which are not configured as CN are
+ignored, the MN is added to the isochronous phase if it sends a PRes.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_nodeList(void)
+{
+    UINT        i;
+    UINT        mandatorySlaveCount;
+    UINT        signalSlaveCount;
+    UINT16      flags;
+    UINT        mnNodeId = STUB_LOCAL_NODE_ID;
+    UINT        broadcast = EPL_C_ADR_BROADCAST;
+
+    initNmtMnu();
+    for (i = 0; i < tabentries(aCnNodeId_l); i++)
+        stub_setNodeAssignment(aCnNodeId_l[i], TEST_CN_CFG);
+    stub_setNodeAssignment(17, EPL_NODEASSIGN_MANDATORY_CN);
+    stub_setNodeAssignment(STUB_LOCAL_NODE_ID, TEST_MN_CFG);
+
+    bootMn();
+    CU_ASSERT(checkRecord(kStubRecordAddNode, &mnNodeId, 1));
+    // the reset of all nodes was issued, therefore no IdentRequests are sent
+    CU_ASSERT_EQUAL(stub_getRecordCount(kStubRecordIdentRequest), 0);
+    CU_ASSERT_EQUAL(nmtmnu_getDiagnosticInfo(&mandatorySlaveCount, &signalSlaveCount, &flags),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(signalSlaveCount, tabentries(aBootNodeId_l));
+    CU_ASSERT_EQUAL(mandatorySlaveCount, 0);
+
+    stub_clearRecords();
+    CU_ASSERT_EQUAL(nmtmnu_sendNmtCommand(EPL_C_ADR_BROADCAST, kNmtCmdResetNode), kEplSuccessful);
+    CU_ASSERT(checkRecord(kStubRecordNmtCommand, &broadcast, 1));
+    CU_ASSERT(checkRecord(kStubRecordDeleteNode, aBootNodeId_l, tabentries(aBootNodeId_l)));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test node assignment changes during the boot process
+
+The test adds and removes a CN while the boot process is running. The running
+boot process must keep its node list, the next BootStep1 must take the changed
+assignment.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_nodeListUpdateDuringBoot(void)
+{
+    UINT        i;
+    UINT        mandatorySlaveCount;
+    UINT        signalSlaveCount;
+    UINT16      flags;
+
+    initNmtMnu();
+    for (i = 0; i < tabentries(aCnNodeId_l); i++)
+        stub_setNodeAssignment(aCnNodeId_l[i], TEST_CN_CFG);
+    bootMn();
+
+    // write object 0x1F81 like the OD callback does
+    stub_setNodeAssignment(TEST_ADDED_NODE_ID, TEST_CN_CFG);
+    CU_ASSERT_EQUAL(nmtmnu_updateNodeAssignment(TEST_ADDED_NODE_ID, TEST_CN_CFG), kEplSuccessful);
+    stub_setNodeAssignment(TEST_REMOVED_NODE_ID, 0);
+    CU_ASSERT_EQUAL(nmtmnu_updateNodeAssignment(TEST_REMOVED_NODE_ID, 0), kEplSuccessful);
+
+    stub_clearRecords();
+    CU_ASSERT_EQUAL(nmtmnu_sendNmtCommand(EPL_C_ADR_BROADCAST, kNmtCmdResetNode), kEplSuccessful);
+    CU_ASSERT(checkRecord(kStubRecordDeleteNode, aBootNodeId_l, tabentries(aBootNodeId_l)));
+
+    // restart boot process, the nodes of the previous boot process are reset
+    stub_clearRecords();
+    CU_ASSERT_EQUAL(changeState(kNmtMsPreOperational1), kEplSuccessful);
+    CU_ASSERT(checkRecord(kStubRecordDeleteNode, aBootNodeId_l, tabentries(aBootNodeId_l)));
+    CU_ASSERT_EQUAL(nmtmnu_getDiagnosticInfo(&mandatorySlaveCount, &signalSlaveCount, &flags),
+                    kEplSuccessful);
+    CU_ASSERT_EQUAL(signalSlaveCount, tabentries(aUpdatedNodeId_l));
+
+    stub_clearRecords();
+    CU_ASSERT_EQUAL(nmtmnu_sendNmtCommand(EPL_C_ADR_BROADCAST, kNmtCmdResetNode), kEplSuccessful);
+    CU_ASSERT(checkRecord(kStubRecordDeleteNode, aUpdatedNodeId_l, tabentries(aUpdatedNodeId_l)));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test node assignment reload in ResetConfiguration
+
+The test changes object 0x1F81 without calling nmtmnu_updateNodeAssignment(),
+like a reload of the object in ResetCommunication does. The node assignment
+must be read again in ResetConfiguration.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_nodeListResetConfiguration(void)
+{
+    UINT        i;
+
+    initNmtMnu();
+    for (i = 0; i < tabentries(aCnNodeId_l); i++)
+        stub_setNodeAssignment(aCnNodeId_l[i], TEST_CN_CFG);
+    bootMn();
+
+    stub_setNodeAssignment(TEST_ADDED_NODE_ID, TEST_CN_CFG);
+    stub_setNodeAssignment(TEST_REMOVED_NODE_ID, 0);
+
+    // without ResetConfiguration, the bitmap is not updated and the added
+    // node is missing, but BootStep1 reads the configuration of listed nodes
+    CU_ASSERT_EQUAL(changeState(kNmtMsPreOperational1), kEplSuccessful);
+    stub_clearRecords();
+    CU_ASSERT_EQUAL(nmtmnu_sendNmtCommand(EPL_C_ADR_BROADCAST, kNmtCmdResetNode), kEplSuccessful);
+    CU_ASSERT(checkRecord(kStubRecordDeleteNode, aRemovedNodeId_l, tabentries(aRemovedNodeId_l)));
+
+    bootMn();
+    stub_clearRecords();
+    CU_ASSERT_EQUAL(nmtmnu_sendNmtCommand(EPL_C_ADR_BROADCAST, kNmtCmdResetNode), kEplSuccessful);
+    CU_ASSERT(checkRecord(kStubRecordDeleteNode, aUpdatedNodeId_l, tabentries(aUpdatedNodeId_l)));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test node assignment update with invalid node ID
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_nodeListInvalidNode(void)
+{
+    initNmtMnu();
+
+    CU_ASSERT_EQUAL(nmtmnu_updateNodeAssignment(EPL_C_ADR_INVALID, TEST_CN_CFG), kEplInvalidNodeId);
+    CU_ASSERT_EQUAL(nmtmnu_updateNodeAssignment(EPL_NMT_MAX_NODE_ID + 1, TEST_CN_CFG),
+                    kEplInvalidNodeId);
+    CU_ASSERT_EQUAL(nmtmnu_updateNodeAssignment(EPL_NMT_MAX_NODE_ID, TEST_CN_CFG), kEplSuccessful);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark BootStep1 with few assigned nodes
+
+The benchmark measures the entry of PreOperational1 including the reset of all
+nodes and BootStep1 with the CNs of the node list test. The OD stub returns
+the values directly, so the cost of OD accesses is not included.
+*/
+//------------------------------------------------------------------------------
+void test_nmtmnu_bootStep1Benchmark(void)
+{
+    UINT        i;
+    UINT64      startTime;
+    UINT64      bootTime;
+
+    initNmtMnu();
+    for (i = 0; i < tabentries(aCnNodeId_l); i++)
+        stub_setNodeAssignment(aCnNodeId_l[i], TEST_CN_CFG);
+    bootMn();
+
+    startTime = getTimeNs();
+    for (i = 0; i < TEST_BENCHMARK_ROUNDS; i++)
+    {
+        stub_clearRecords();
+        changeState(kNmtMsPreOperational1);
+    }
+    bootTime = getTimeNs() - startTime;
+
+    CU_ASSERT(checkRecord(kStubRecordDeleteNode, aBootNodeId_l, tabentries(aBootNodeId_l)));
+    printf("\n    %u CNs: PreOperational1 with BootStep1 %.1f ns\n",
+           (UINT)tabentries(aBootNodeId_l), (double)bootTime / TEST_BENCHMARK_ROUNDS);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize boot timeline
+
+The function marks all boot phases and CN milestones as not reached.
+
+\param  pTimeline_p         Pointer to the boot timeline.
+*/
+//------------------------------------------------------------------------------
+static void initTimeline(tNmtBootTimeline* pTimeline_p)
+{
+    EPL_MEMSET(pTimeline_p, 0xFF, sizeof(tNmtBootTimeline));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get name of a temporary CSV file
+
+\param  pszFilename_p       Buffer to store the file name.
+\param  size_p              Size of the buffer.
+*/
+//------------------------------------------------------------------------------
+static void getFilename(char* pszFilename_p, size_t size_p)
+{
+    snprintf(pszFilename_p, size_p, "/tmp/nmtmnu-timeline-%d.csv", (int)getpid());
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a file into a string
+
+\param  pszFilename_p       Name of the file.
+\param  pszBuffer_p         Buffer to store the file content.
+\param  size_p              Size of the buffer.
+
+\return The function returns TRUE if the file was read completely.
+*/
+//------------------------------------------------------------------------------
+static BOOL readFile(const char* pszFilename_p, char* pszBuffer_p, size_t size_p)
+{
+    FILE*       pFile;
+    size_t      length;
+
+    pFile = fopen(pszFilename_p, "r");
+    if (pFile == NULL)
+        return FALSE;
+
+    length = fread(pszBuffer_p, 1, size_p - 1, pFile);
+    pszBuffer_p[length] = '\0';
+    fclose(pFile);
+
+    return (length < (size_p - 1));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize NMT MNU module
+
+The function resets the stubs and initializes the NMT MNU module.
+*/
+//------------------------------------------------------------------------------
+static void initNmtMnu(void)
+{
+    stub_reset();
+    CU_ASSERT_EQUAL_FATAL(nmtmnu_init(cbNodeEvent, cbBootEvent), kEplSuccessful);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change NMT state of the MN
+
+\param  newNmtState_p       New NMT state of the MN.
+
+\return The function returns the return value of nmtmnu_cbNmtStateChange().
+*/
+//------------------------------------------------------------------------------
+static tEplKernel changeState(tNmtState newNmtState_p)
+{
+    tEventNmtStateChange    nmtStateChange;
+
+    nmtStateChange.oldNmtState = nmtu_getNmtState();
+    nmtStateChange.newNmtState = newNmtState_p;
+    nmtStateChange.nmtEvent = kNmtEventNoEvent;
+    stub_setNmtState(newNmtState_p);
+
+    return nmtmnu_cbNmtStateChange(nmtStateChange);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Boot MN until BootStep1
+
+The function passes the MN through ResetConfiguration into PreOperational1.
+*/
+//------------------------------------------------------------------------------
+static void bootMn(void)
+{
+    CU_ASSERT_EQUAL(changeState(kNmtGsResetConfiguration), kEplSuccessful);
+    stub_clearRecords();
+    CU_ASSERT_EQUAL(changeState(kNmtMsPreOperational1), kEplSuccessful);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check recorded node IDs
+
+\param  type_p              Record to check.
+\param  pNodeIds_p          Expected node IDs.
+\param  count_p             Number of expected node IDs.
+
+\return The function returns TRUE if the record contains exactly the expected
+        node IDs in the expected order.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkRecord(tStubRecordType type_p, const UINT* pNodeIds_p, UINT count_p)
+{
+    UINT    i;
+
+    if (stub_getRecordCount(type_p) != count_p)
+        return FALSE;
+
+    for (i = 0; i < count_p; i++)
+    {
+        if (stub_getRecordNodeId(type_p, i) != pNodeIds_p[i])
+            return FALSE;
+    }
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Node event callback function
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbNodeEvent(UINT nodeId_p, tNmtNodeEvent nodeEvent_p, tNmtState nmtState_p,
+                              UINT16 errorCode_p, BOOL fMandatory_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(nodeEvent_p);
+    UNUSED_PARAMETER(nmtState_p);
+    UNUSED_PARAMETER(errorCode_p);
+    UNUSED_PARAMETER(fMandatory_p);
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Boot event callback function
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbBootEvent(tNmtBootEvent bootEvent_p, tNmtState nmtState_p,
+                              UINT16 errorCode_p)
+{
+    UNUSED_PARAMETER(bootEvent_p);
+    UNUSED_PARAMETER(nmtState_p);
+    UNUSED_PARAMETER(errorCode_p);
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
+
+/// \}
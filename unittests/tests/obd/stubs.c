@@ -0,0 +1,161 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for object dictionary module unit tests
+
+This file contains all stubs needed by the unit tests of the object dictionary
+module. The OD callback functions of the stack count the post default events
+and remember the data pointer of a watched sub-index.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <Epl.h>
+#include <obd.h>
+#include <user/pdou.h>
+#include <user/errhndu.h>
+#include <user/ctrlu.h>
+#include <user/cfmu.h>
+
+#include "test-obd.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel cbObdAccess(tObdCbParam MEM* pParam_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT                     postDefaultCount_l;
+static UINT                     watchIndex_l;
+static UINT                     watchSubIndex_l;
+static void*                    pWatchArg_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_reset(void)
+{
+    postDefaultCount_l = 0;
+    watchIndex_l = 0;
+    watchSubIndex_l = 0;
+    pWatchArg_l = NULL;
+}
+
+void stub_watchPostDefault(UINT index_p, UINT subIndex_p)
+{
+    watchIndex_l = index_p;
+    watchSubIndex_l = subIndex_p;
+    pWatchArg_l = NULL;
+}
+
+UINT stub_getPostDefaultCount(void)
+{
+    return postDefaultCount_l;
+}
+
+void* stub_getPostDefaultArg(void)
+{
+    return pWatchArg_l;
+}
+
+tEplKernel PUBLIC pdou_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+tEplKernel ctrlu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+tEplKernel errhndu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+tEplKernel errhndu_mnCnLossPresCbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+tEplKernel cfmu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+static tEplKernel cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    if (pParam_p->obdEvent == kObdEvPostDefault)
+    {
+        postDefaultCount_l++;
+        if ((pParam_p->index == watchIndex_l) && (pParam_p->subIndex == watchSubIndex_l))
+            pWatchArg_l = pParam_p->pArg;
+    }
+    return kEplSuccessful;
+}
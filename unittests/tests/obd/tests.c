@@ -0,0 +1,301 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for object dictionary module
+
+This file contains the unit test functions for the object dictionary module
+using the object dictionary of the MN. They check that resetting the OD
+restores the default values of static objects, strings and linked variables,
+and compare the duration of the initial walk through the OD with the reset
+from the default value snapshots.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <obd.h>
+
+#include "test-obd.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_BENCH_ROUNDS           1000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel initOd(void);
+static UINT getPostDefaultCount(void);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdInitParam    initParam_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test restoring default values
+
+The function changes static objects and a string and checks that loading the
+OD restores their default values. The post default event must be issued for
+every sub-index of all objects with a callback function.
+*/
+//------------------------------------------------------------------------------
+void test_obd_reset(void)
+{
+    UINT32              value;
+    tObdSize            size;
+    char*               pDeviceName;
+    UINT                round;
+
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+
+    for (round = 0; round < 2; round++)
+    {
+        value = 10000;
+        CU_ASSERT_EQUAL(obd_writeEntry(0x1006, 0, &value, sizeof(value)), kEplSuccessful);
+        value = 0x1234;
+        CU_ASSERT_EQUAL(obd_writeEntry(0x1F81, 5, &value, sizeof(value)), kEplSuccessful);
+        pDeviceName = (char*)obd_getObjectDataPtr(0x1008, 0);
+        strcpy(pDeviceName, "changed");
+
+        stub_reset();
+        stub_watchPostDefault(0x1F81, 5);
+        CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartAll, kObdDirLoad), kEplSuccessful);
+
+        size = sizeof(value);
+        CU_ASSERT_EQUAL(obd_readEntry(0x1006, 0, &value, &size), kEplSuccessful);
+        CU_ASSERT_EQUAL(value, 0);
+        size = sizeof(value);
+        CU_ASSERT_EQUAL(obd_readEntry(0x1F81, 5, &value, &size), kEplSuccessful);
+        CU_ASSERT_EQUAL(value, 0);
+        CU_ASSERT_STRING_EQUAL(pDeviceName, "openPOWERLINK device");
+
+        CU_ASSERT_EQUAL(stub_getPostDefaultCount(), getPostDefaultCount());
+        CU_ASSERT_TRUE(stub_getPostDefaultArg() == obd_getObjectDataPtr(0x1F81, 5));
+    }
+
+    obd_deleteInstance();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test restoring linked variables
+
+The function links an application variable to an object and checks that
+loading the OD copies the default value into the variable.
+*/
+//------------------------------------------------------------------------------
+void test_obd_varEntry(void)
+{
+    tVarParam           varParam;
+    UINT32              var = 0x55;
+
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+
+    varParam.validFlag = kVarValidAll;
+    varParam.index = 0x1C00;
+    varParam.subindex = 3;
+    varParam.size = sizeof(var);
+    varParam.pData = &var;
+    CU_ASSERT_EQUAL(obd_defineVar(&varParam), kEplSuccessful);
+    CU_ASSERT_TRUE(obd_getObjectDataPtr(0x1C00, 3) == &var);
+
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartAll, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(var, 15);
+
+    // the variable stays linked and is restored on every reset
+    var = 0x55;
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartAll, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(var, 15);
+    CU_ASSERT_TRUE(obd_getObjectDataPtr(0x1C00, 3) == &var);
+
+    obd_deleteInstance();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark resetting the OD
+
+The function compares the duration of walking through the whole OD, as done
+on the initialization and previously on every reset, with the reset from the
+default value snapshots.
+*/
+//------------------------------------------------------------------------------
+void test_obd_benchmark(void)
+{
+    UINT64              startTime;
+    UINT64              walkDuration;
+    UINT64              snapshotDuration;
+    UINT                round;
+    BOOL                fOk = TRUE;
+
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+
+    // the first load creates the snapshots
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartAll, kObdDirLoad), kEplSuccessful);
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if (obd_accessOdPart(kObdPartAll, kObdDirInit) != kEplSuccessful)
+            fOk = FALSE;
+    }
+    walkDuration = getTimeNs() - startTime;
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if (obd_accessOdPart(kObdPartAll, kObdDirLoad) != kEplSuccessful)
+            fOk = FALSE;
+    }
+    snapshotDuration = getTimeNs() - startTime;
+
+    CU_ASSERT_TRUE(fOk);
+    printf("\n    walk through OD: %llu ns, reset from snapshot: %llu ns\n",
+           (unsigned long long)(walkDuration / TEST_BENCH_ROUNDS),
+           (unsigned long long)(snapshotDuration / TEST_BENCH_ROUNDS));
+
+    obd_deleteInstance();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize OD
+
+The function creates and initializes the object dictionary of the MN.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel initOd(void)
+{
+    tEplKernel          ret;
+
+    stub_reset();
+
+    ret = obd_initObd(&initParam_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    return obd_init(&initParam_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get expected number of post default events
+
+The function determines the number of post default events issued on a reset
+by counting the sub-indices of all objects with a callback function.
+
+\return The function returns the number of post default events.
+*/
+//------------------------------------------------------------------------------
+static UINT getPostDefaultCount(void)
+{
+    tObdEntryPtr        apPart[] = {initParam_l.pGenericPart,
+                                    initParam_l.pManufacturerPart,
+                                    initParam_l.pDevicePart};
+    tObdEntryPtr        pObdEntry;
+    UINT                count = 0;
+    UINT                i;
+
+    for (i = 0; i < tabentries(apPart); i++)
+    {
+        for (pObdEntry = apPart[i]; pObdEntry->index != OBD_TABLE_INDEX_END; pObdEntry++)
+        {
+            if (pObdEntry->pfnCallback != NULL)
+                count += pObdEntry->count;
+        }
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
+
+/// \}
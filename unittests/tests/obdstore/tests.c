@@ -0,0 +1,569 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for OBD store module
+
+This file contains the unit test functions for the OBD store module using the
+object dictionary of the MN. They check that stored objects are loaded on a
+reset, that restoring the default parameters and corrupted images fall back
+to the default values, and compare the duration of storing and loading the OD
+with a backend writing every object with its own I/O call.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <obd.h>
+#include <obdstore.h>
+
+#include "test-obdstore.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_BENCH_ROUNDS           20
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel initOd(void);
+static void exitOd(void);
+static void changeObjects(void);
+static void getFilename(char* pFilename_p, size_t size_p, const char* pSuffix_p);
+static UINT32 readObject(UINT index_p, UINT subIndex_p);
+static tEplKernel cbStorePerObject(tObdCbStoreParam MEM* pCbStoreParam_p);
+static tEplKernel cbStoreCounting(tObdCbStoreParam MEM* pCbStoreParam_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdInitParam    initParam_l;
+static char             aStorePath_l[64];
+static int              perObjectFd_l = -1;
+static UINT             perObjectCount_l;
+static UINT             aCommandCount_l[kObdCmdClear + 1];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test storing and loading objects
+
+The function stores the communication part of the OD, changes some objects
+and checks that loading the OD restores the stored values of the objects with
+the store attribute and the default values of all other objects.
+*/
+//------------------------------------------------------------------------------
+void test_obdstore_storeLoad(void)
+{
+    char                aFilename[128];
+    UINT                round;
+
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+
+    changeObjects();
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirStore), kEplSuccessful);
+
+    getFilename(aFilename, sizeof(aFilename), "");
+    CU_ASSERT_EQUAL(access(aFilename, F_OK), 0);
+    getFilename(aFilename, sizeof(aFilename), ".tmp");
+    CU_ASSERT_NOT_EQUAL(access(aFilename, F_OK), 0);
+
+    for (round = 0; round < 2; round++)
+    {
+        UINT32      value = 0;
+
+        obd_writeEntry(0x1006, 0, &value, sizeof(value));
+        obd_writeEntry(0x1F81, 5, &value, sizeof(value));
+
+        CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirLoad), kEplSuccessful);
+        CU_ASSERT_EQUAL(readObject(0x1006, 0), 10000);
+        CU_ASSERT_EQUAL(readObject(0x1F81, 5), 0x1234);
+        CU_ASSERT_EQUAL(readObject(0x1010, 2), 1);
+    }
+
+    exitOd();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test restoring default parameters
+
+The function stores the communication part of the OD and checks that the
+default values are loaded after the stored parameters were deleted.
+*/
+//------------------------------------------------------------------------------
+void test_obdstore_restore(void)
+{
+    char                aFilename[128];
+
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+
+    changeObjects();
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirStore), kEplSuccessful);
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirRestore), kEplSuccessful);
+
+    getFilename(aFilename, sizeof(aFilename), "");
+    CU_ASSERT_NOT_EQUAL(access(aFilename, F_OK), 0);
+
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(readObject(0x1006, 0), 0);
+    CU_ASSERT_EQUAL(readObject(0x1F81, 5), 0);
+
+    exitOd();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test ignoring corrupted images
+
+The function checks that a left over temporary file of an interrupted store
+does not affect the stored image, and that the default values are loaded if
+the image is damaged or truncated.
+*/
+//------------------------------------------------------------------------------
+void test_obdstore_corruptImage(void)
+{
+    char                aFilename[128];
+    char                aTmpFilename[128];
+    UINT8               data;
+    off_t               size;
+    int                 fd;
+
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+
+    changeObjects();
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirStore), kEplSuccessful);
+    getFilename(aFilename, sizeof(aFilename), "");
+    getFilename(aTmpFilename, sizeof(aTmpFilename), ".tmp");
+
+    // interrupted store
+    fd = open(aTmpFilename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    CU_ASSERT_TRUE(fd >= 0);
+    CU_ASSERT_EQUAL(write(fd, "OBDS", 4), 4);
+    close(fd);
+
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(readObject(0x1006, 0), 10000);
+
+    // damaged image
+    fd = open(aFilename, O_RDWR);
+    CU_ASSERT_TRUE(fd >= 0);
+    size = lseek(fd, 0, SEEK_END);
+    CU_ASSERT_EQUAL(pread(fd, &data, 1, size / 2), 1);
+    data ^= 0x01;
+    CU_ASSERT_EQUAL(pwrite(fd, &data, 1, size / 2), 1);
+
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(readObject(0x1006, 0), 0);
+    CU_ASSERT_EQUAL(readObject(0x1F81, 5), 0);
+
+    // truncated image
+    data ^= 0x01;
+    CU_ASSERT_EQUAL(pwrite(fd, &data, 1, size / 2), 1);
+    CU_ASSERT_EQUAL(ftruncate(fd, size - 4), 0);
+    close(fd);
+
+    changeObjects();
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(readObject(0x1006, 0), 0);
+
+    unlink(aTmpFilename);
+    exitOd();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test loading without stored image
+
+The function checks that the objects are not walked for loading if no stored
+image exists, and that the default values are restored nevertheless.
+*/
+//------------------------------------------------------------------------------
+void test_obdstore_loadWithoutImage(void)
+{
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+    obd_storeLoadObjCallback(cbStoreCounting);
+
+    changeObjects();
+    EPL_MEMSET(aCommandCount_l, 0, sizeof(aCommandCount_l));
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(aCommandCount_l[kObdCmdOpenRead], 1);
+    CU_ASSERT_EQUAL(aCommandCount_l[kObdCmdReadObj], 0);
+    CU_ASSERT_EQUAL(aCommandCount_l[kObdCmdCloseRead], 0);
+    CU_ASSERT_EQUAL(readObject(0x1006, 0), 0);
+    CU_ASSERT_EQUAL(readObject(0x1F81, 5), 0);
+
+    // with a stored image the objects are loaded as usual
+    changeObjects();
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirStore), kEplSuccessful);
+    EPL_MEMSET(aCommandCount_l, 0, sizeof(aCommandCount_l));
+    CU_ASSERT_EQUAL(obd_accessOdPart(kObdPartGen, kObdDirLoad), kEplSuccessful);
+    CU_ASSERT_EQUAL(aCommandCount_l[kObdCmdOpenRead], 1);
+    CU_ASSERT(aCommandCount_l[kObdCmdReadObj] > 0);
+    CU_ASSERT_EQUAL(aCommandCount_l[kObdCmdCloseRead], 1);
+    CU_ASSERT_EQUAL(readObject(0x1006, 0), 10000);
+
+    exitOd();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark storing and loading the OD
+
+The function compares the duration of storing and loading the whole OD with
+the OBD store module and with a backend which writes and reads every object
+with its own I/O call. The duration of loading without a stored image is
+measured as well.
+*/
+//------------------------------------------------------------------------------
+void test_obdstore_benchmark(void)
+{
+    UINT64              startTime;
+    UINT64              noImageLoadDuration;
+    UINT64              storeDuration;
+    UINT64              loadDuration;
+    UINT64              perObjectStoreDuration;
+    UINT64              perObjectLoadDuration;
+    UINT                round;
+    BOOL                fOk = TRUE;
+
+    CU_ASSERT_EQUAL(initOd(), kEplSuccessful);
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if (obd_accessOdPart(kObdPartAll, kObdDirLoad) != kEplSuccessful)
+            fOk = FALSE;
+    }
+    noImageLoadDuration = getTimeNs() - startTime;
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if (obd_accessOdPart(kObdPartAll, kObdDirStore) != kEplSuccessful)
+            fOk = FALSE;
+    }
+    storeDuration = getTimeNs() - startTime;
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if (obd_accessOdPart(kObdPartAll, kObdDirLoad) != kEplSuccessful)
+            fOk = FALSE;
+    }
+    loadDuration = getTimeNs() - startTime;
+
+    obd_storeLoadObjCallback(cbStorePerObject);
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        perObjectCount_l = 0;
+        if (obd_accessOdPart(kObdPartAll, kObdDirStore) != kEplSuccessful)
+            fOk = FALSE;
+    }
+    perObjectStoreDuration = getTimeNs() - startTime;
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if (obd_accessOdPart(kObdPartAll, kObdDirLoad) != kEplSuccessful)
+            fOk = FALSE;
+    }
+    perObjectLoadDuration = getTimeNs() - startTime;
+
+    CU_ASSERT_TRUE(fOk);
+    printf("\n    %u stored objects\n", perObjectCount_l);
+    printf("    no image:   load %llu us\n",
+           (unsigned long long)(noImageLoadDuration / TEST_BENCH_ROUNDS / 1000));
+    printf("    image:      store %llu us, load %llu us\n",
+           (unsigned long long)(storeDuration / TEST_BENCH_ROUNDS / 1000),
+           (unsigned long long)(loadDuration / TEST_BENCH_ROUNDS / 1000));
+    printf("    per object: store %llu us, load %llu us\n",
+           (unsigned long long)(perObjectStoreDuration / TEST_BENCH_ROUNDS / 1000),
+           (unsigned long long)(perObjectLoadDuration / TEST_BENCH_ROUNDS / 1000));
+
+    exitOd();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize OD
+
+The function creates and initializes the object dictionary of the MN and
+registers the OBD store module with an empty store directory.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel initOd(void)
+{
+    tEplKernel          ret;
+
+    strcpy(aStorePath_l, "/tmp/obdstore-XXXXXX");
+    if (mkdtemp(aStorePath_l) == NULL)
+        return kEplNoResource;
+
+    ret = obd_initObd(&initParam_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = obd_init(&initParam_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = obdstore_init();
+    if (ret != kEplSuccessful)
+        return ret;
+
+    obdstore_setPath(aStorePath_l);
+    return obd_storeLoadObjCallback(obdstore_cbStoreLoadObject);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up OD
+
+The function deletes the object dictionary and the store directory.
+*/
+//------------------------------------------------------------------------------
+static void exitOd(void)
+{
+    char                aFilename[128];
+    const char*         apPartName[] = {"gen", "man", "dev",
+                                        "perobject1", "perobject2", "perobject4"};
+    UINT                i;
+
+    obdstore_exit();
+    obd_deleteInstance();
+
+    for (i = 0; i < tabentries(apPartName); i++)
+    {
+        snprintf(aFilename, sizeof(aFilename), "%s/obd-%s.img", aStorePath_l, apPartName[i]);
+        unlink(aFilename);
+    }
+    rmdir(aStorePath_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change objects
+
+The function changes two objects with the store attribute and one object
+without it.
+*/
+//------------------------------------------------------------------------------
+static void changeObjects(void)
+{
+    UINT32              value;
+
+    value = 10000;
+    CU_ASSERT_EQUAL(obd_writeEntry(0x1006, 0, &value, sizeof(value)), kEplSuccessful);
+    value = 0x1234;
+    CU_ASSERT_EQUAL(obd_writeEntry(0x1F81, 5, &value, sizeof(value)), kEplSuccessful);
+    value = 0x65766173;
+    CU_ASSERT_EQUAL(obd_writeEntry(0x1010, 2, &value, sizeof(value)), kEplSuccessful);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get image filename
+
+The function builds the filename of the image of the communication part.
+
+\param  pFilename_p         Buffer for the filename.
+\param  size_p              Size of the buffer.
+\param  pSuffix_p           Suffix appended to the filename.
+*/
+//------------------------------------------------------------------------------
+static void getFilename(char* pFilename_p, size_t size_p, const char* pSuffix_p)
+{
+    snprintf(pFilename_p, size_p, "%s/obd-gen.img%s", aStorePath_l, pSuffix_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read UINT32 object
+
+\param  index_p             Index of the object.
+\param  subIndex_p          Sub-index of the object.
+
+\return The function returns the value of the object.
+*/
+//------------------------------------------------------------------------------
+static UINT32 readObject(UINT index_p, UINT subIndex_p)
+{
+    UINT32              value = 0xFFFFFFFF;
+    tObdSize            size = sizeof(value);
+
+    CU_ASSERT_EQUAL(obd_readEntry(index_p, subIndex_p, &value, &size), kEplSuccessful);
+    return value;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store/load callback with one I/O call per object
+
+The function stores and loads every object with its own write and read call.
+It is used as reference for the benchmark.
+
+\param  pCbStoreParam_p     Pointer to store callback parameters.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbStorePerObject(tObdCbStoreParam MEM* pCbStoreParam_p)
+{
+    char                aFilename[128];
+    tEplKernel          ret = kEplSuccessful;
+
+    snprintf(aFilename, sizeof(aFilename), "%s/obd-perobject%u.img", aStorePath_l,
+             (UINT)pCbStoreParam_p->currentOdPart);
+
+    switch (pCbStoreParam_p->command)
+    {
+        case kObdCmdOpenWrite:
+            perObjectFd_l = open(aFilename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            break;
+
+        case kObdCmdOpenRead:
+            perObjectFd_l = open(aFilename, O_RDONLY);
+            break;
+
+        case kObdCmdWriteObj:
+            perObjectCount_l++;
+            if (write(perObjectFd_l, pCbStoreParam_p->pData, pCbStoreParam_p->objSize) !=
+                (ssize_t)pCbStoreParam_p->objSize)
+                ret = kEplObdErrnoSet;
+            break;
+
+        case kObdCmdReadObj:
+            if (read(perObjectFd_l, pCbStoreParam_p->pData, pCbStoreParam_p->objSize) !=
+                (ssize_t)pCbStoreParam_p->objSize)
+                ret = kEplObdErrnoSet;
+            break;
+
+        case kObdCmdCloseWrite:
+            fsync(perObjectFd_l);
+            // fall through
+
+        case kObdCmdCloseRead:
+            close(perObjectFd_l);
+            perObjectFd_l = -1;
+            break;
+
+        default:
+            break;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store/load callback counting the commands
+
+The function counts the commands and forwards them to the OBD store module.
+
+\param  pCbStoreParam_p     Pointer to store callback parameters.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbStoreCounting(tObdCbStoreParam MEM* pCbStoreParam_p)
+{
+    if (pCbStoreParam_p->command <= kObdCmdClear)
+        aCommandCount_l[pCbStoreParam_p->command]++;
+
+    return obdstore_cbStoreLoadObject(pCbStoreParam_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
+
+/// \}
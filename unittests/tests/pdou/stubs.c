@@ -0,0 +1,223 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for PDO user module unit tests
+
+This file contains all stubs needed by the unit tests of the PDO user module.
+The PDO CAL module is replaced by a simulated PDO buffer per PDO channel and
+the OD callback functions of the other stack modules accept every access.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <Epl.h>
+#include <obd.h>
+#include <user/pdoucal.h>
+#include <user/errhndu.h>
+#include <user/ctrlu.h>
+#include <user/cfmu.h>
+
+#include "test-pdou.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel cbObdAccess(tObdCbParam MEM* pParam_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static BYTE         aRxPdo_l[STUB_RX_CHANNELS][STUB_MAX_PDO_SIZE];
+static BYTE         aTxPdo_l[STUB_TX_CHANNELS][STUB_MAX_PDO_SIZE];
+static UINT         aTxPdoCount_l[STUB_TX_CHANNELS];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+BYTE* stub_getRxPdo(UINT channelId_p)
+{
+    return aRxPdo_l[channelId_p];
+}
+
+BYTE* stub_getTxPdo(UINT channelId_p)
+{
+    return aTxPdo_l[channelId_p];
+}
+
+UINT stub_getTxPdoCount(UINT channelId_p)
+{
+    return aTxPdoCount_l[channelId_p];
+}
+
+tEplKernel pdoucal_init(tEplSyncCb pfnSyncCb_p)
+{
+    UNUSED_PARAMETER(pfnSyncCb_p);
+    EPL_MEMSET(aRxPdo_l, 0, sizeof(aRxPdo_l));
+    EPL_MEMSET(aTxPdo_l, 0, sizeof(aTxPdo_l));
+    EPL_MEMSET(aTxPdoCount_l, 0, sizeof(aTxPdoCount_l));
+    return kEplSuccessful;
+}
+
+tEplKernel pdoucal_exit(void)
+{
+    return kEplSuccessful;
+}
+
+tEplKernel pdoucal_postPdokChannelAlloc(tPdoAllocationParam* pAllocationParam_p)
+{
+    if ((pAllocationParam_p->rxPdoChannelCount > STUB_RX_CHANNELS) ||
+        (pAllocationParam_p->txPdoChannelCount > STUB_TX_CHANNELS))
+        return kEplPdoTooManyPdos;
+    return kEplSuccessful;
+}
+
+tEplKernel pdoucal_postConfigureChannel(tPdoChannelConf* pChannelConf_p)
+{
+    if (pChannelConf_p->pdoChannel.pdoSize > STUB_MAX_PDO_SIZE)
+        return kEplPdoLengthExceeded;
+    return kEplSuccessful;
+}
+
+tEplKernel pdoucal_postSetupPdoBuffers(size_t rxPdoMemSize_p, size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+    return kEplSuccessful;
+}
+
+tEplKernel pdoucal_initPdoMem(tPdoChannelSetup* pPdoChannels_p, size_t rxPdoMemSize_p,
+                              size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(pPdoChannels_p);
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+    return kEplSuccessful;
+}
+
+void pdoucal_cleanupPdoMem(void)
+{
+}
+
+BYTE* pdoucal_getTxPdoAdrs(UINT channelId_p)
+{
+    if (channelId_p >= STUB_TX_CHANNELS)
+        return NULL;
+
+    return aTxPdo_l[channelId_p];
+}
+
+tEplKernel pdoucal_setTxPdo(UINT channelId_p, BYTE* pPdo_p,  WORD pdoSize_p)
+{
+    UNUSED_PARAMETER(pPdo_p);
+    UNUSED_PARAMETER(pdoSize_p);
+    if (channelId_p >= STUB_TX_CHANNELS)
+        return kEplPdoInvalidObjIndex;
+
+    aTxPdoCount_l[channelId_p]++;
+    return kEplSuccessful;
+}
+
+tEplKernel pdoucal_getRxPdo(BYTE** ppPdo_p, UINT channelId_p, WORD pdoSize_p)
+{
+    UNUSED_PARAMETER(pdoSize_p);
+    if (channelId_p >= STUB_RX_CHANNELS)
+        return kEplPdoInvalidObjIndex;
+
+    *ppPdo_p = aRxPdo_l[channelId_p];
+    return kEplSuccessful;
+}
+
+void target_msleep(UINT32 milliSeconds_p)
+{
+    UNUSED_PARAMETER(milliSeconds_p);
+}
+
+tEplKernel ctrlu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+tEplKernel errhndu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+tEplKernel errhndu_mnCnLossPresCbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+tEplKernel cfmu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    return cbObdAccess(pParam_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+static tEplKernel cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    return kEplSuccessful;
+}
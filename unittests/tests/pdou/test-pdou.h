@@ -0,0 +1,83 @@
+/**
+********************************************************************************
+\file   test-obdstore.h
+
+\brief  Definitions unit tests of PDO user module
+
+The file contains the definitions for the unit tests of the PDO user module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_test_pdou_H_
+#define _INC_test_pdou_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <obd.h>
+#include <pdo.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_RX_CHANNELS            40          ///< Number of RPDO channels of the MN OD
+#define STUB_TX_CHANNELS            40          ///< Number of TPDO channels of the MN OD
+#define STUB_MAX_PDO_SIZE           36          ///< Maximum size of an RPDO
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void test_pdou_changedRxPdos(void);
+void test_pdou_changedRxPdosReconfig(void);
+void test_pdou_changedRxPdosBenchmark(void);
+void test_pdou_rxPdoNodes(void);
+void test_pdou_txPdoNodes(void);
+void test_pdou_pdoNodesBenchmark(void);
+
+// stub control functions
+BYTE* stub_getRxPdo(UINT channelId_p);
+BYTE* stub_getTxPdo(UINT channelId_p);
+UINT  stub_getTxPdoCount(UINT channelId_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_test_pdou_H_ */
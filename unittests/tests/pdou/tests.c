@@ -0,0 +1,643 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for PDO user module
+
+This file contains the unit test functions for the PDO user module using the
+object dictionary of the MN. The RPDOs and TPDOs of up to 40 nodes are mapped
+to the static output objects 0xA4C0 and input objects 0xA040 which are linked
+to simulated process images. The tests check that only changed RPDOs are
+copied into the process image and reported in the node bitmap, that only the
+PDOs of selected nodes are exchanged, and compare the durations with copying
+all PDOs.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <CUnit/CUnit.h>
+
+#include <Epl.h>
+#include <obd.h>
+#include <nmt.h>
+#include <user/pdou.h>
+
+#include "test-pdou.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_OUTPUT_INDEX           0xA4C0      // static output objects (UNSIGNED8)
+#define TEST_INPUT_INDEX            0xA040      // static input objects (UNSIGNED8)
+#define TEST_PI_SIZE                252         // number of sub-indices of the objects
+#define TEST_PDO_SIZE               32
+#define TEST_BENCH_ROUNDS           100000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel initPdou(void);
+static void exitPdou(void);
+static tEplKernel configurePdos(UINT channelCount_p, UINT pdoSize_p);
+static tEplKernel mapPdo(UINT channelId_p, BOOL fTxPdo_p, UINT channelCount_p,
+                         UINT pdoSize_p);
+static tEplKernel linkProcessImage(UINT index_p, BYTE* pImage_p);
+static BYTE* getOutputObject(UINT channelId_p, UINT pdoSize_p, UINT offset_p);
+static BYTE* getInputObject(UINT channelId_p, UINT pdoSize_p, UINT offset_p);
+static UINT countNodes(BYTE* pNodeBitmap_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdInitParam    initParam_l;
+static BYTE             aOutputImage_l[TEST_PI_SIZE];
+static BYTE             aInputImage_l[TEST_PI_SIZE];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test copying changed RPDOs
+
+The function checks that the first exchange copies all RPDOs, that later
+exchanges only copy and report the RPDOs whose contents changed and that the
+process image data of unchanged RPDOs is not touched.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_changedRxPdos(void)
+{
+    BYTE                aChangedNodes[EPL_API_NODE_BITMAP_SIZE];
+    UINT                channelId;
+
+    CU_ASSERT_EQUAL(initPdou(), kEplSuccessful);
+    CU_ASSERT_EQUAL(configurePdos(4, 4), kEplSuccessful);
+
+    for (channelId = 0; channelId < 4; channelId++)
+        EPL_MEMSET(stub_getRxPdo(channelId), 0x10 + channelId, 4);
+
+    // first exchange copies all RPDOs
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 4);
+    for (channelId = 0; channelId < 4; channelId++)
+    {
+        CU_ASSERT_TRUE(EPL_API_NODE_BITMAP_TEST(aChangedNodes, channelId + 1));
+        CU_ASSERT_EQUAL(*getOutputObject(channelId, 4, 3), 0x10 + channelId);
+    }
+
+    // nothing changed
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 0);
+
+    // only the RPDO of node 3 changed, the process image of node 1 is kept
+    stub_getRxPdo(2)[1] = 0x55;
+    *getOutputObject(0, 4, 0) = 0xAA;
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 1);
+    CU_ASSERT_TRUE(EPL_API_NODE_BITMAP_TEST(aChangedNodes, 3));
+    CU_ASSERT_EQUAL(*getOutputObject(2, 4, 1), 0x55);
+    CU_ASSERT_EQUAL(*getOutputObject(0, 4, 0), 0xAA);
+
+    // copying all RPDOs does not affect the change detection
+    CU_ASSERT_EQUAL(pdou_copyRxPdoToPi(), kEplSuccessful);
+    CU_ASSERT_EQUAL(*getOutputObject(0, 4, 0), 0x10);
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 0);
+
+    exitPdou();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test change detection after reconfiguration
+
+The function checks that all RPDOs are reported as changed after the PDOs
+were reconfigured, even if the PDO contents did not change.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_changedRxPdosReconfig(void)
+{
+    BYTE                aChangedNodes[EPL_API_NODE_BITMAP_SIZE];
+
+    CU_ASSERT_EQUAL(initPdou(), kEplSuccessful);
+    CU_ASSERT_EQUAL(configurePdos(2, 4), kEplSuccessful);
+
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 2);
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 0);
+
+    // more and larger RPDOs
+    CU_ASSERT_EQUAL(configurePdos(3, 8), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 3);
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 0);
+
+    stub_getRxPdo(2)[7] = 0x01;
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(countNodes(aChangedNodes), 1);
+    CU_ASSERT_TRUE(EPL_API_NODE_BITMAP_TEST(aChangedNodes, 3));
+    CU_ASSERT_EQUAL(*getOutputObject(2, 8, 7), 0x01);
+
+    exitPdou();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark copying changed RPDOs
+
+The function measures the duration of copying all RPDOs of 40 nodes and of
+copying only the changed RPDOs if one node changes per cycle.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_changedRxPdosBenchmark(void)
+{
+    BYTE                aChangedNodes[EPL_API_NODE_BITMAP_SIZE];
+    UINT                round;
+    UINT64              startTime;
+    UINT64              copyAllDuration;
+    UINT64              copyChangedDuration;
+    BOOL                fOk = TRUE;
+
+    CU_ASSERT_EQUAL(initPdou(), kEplSuccessful);
+    CU_ASSERT_EQUAL(configurePdos(STUB_RX_CHANNELS, TEST_PDO_SIZE), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        stub_getRxPdo(round % STUB_RX_CHANNELS)[0]++;
+        if (pdou_copyRxPdoToPi() != kEplSuccessful)
+            fOk = FALSE;
+    }
+    copyAllDuration = getTimeNs() - startTime;
+
+    CU_ASSERT_EQUAL(pdou_copyChangedRxPdoToPi(aChangedNodes), kEplSuccessful);
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        stub_getRxPdo(round % STUB_RX_CHANNELS)[0]++;
+        if ((pdou_copyChangedRxPdoToPi(aChangedNodes) != kEplSuccessful) ||
+            (countNodes(aChangedNodes) != 1))
+            fOk = FALSE;
+    }
+    copyChangedDuration = getTimeNs() - startTime;
+
+    CU_ASSERT_TRUE(fOk);
+    printf("\n    %u RPDOs with %u bytes, 1 changed RPDO per cycle\n",
+           STUB_RX_CHANNELS, TEST_PDO_SIZE);
+    printf("    copy all:     %llu ns per cycle\n",
+           (unsigned long long)(copyAllDuration / TEST_BENCH_ROUNDS));
+    printf("    copy changed: %llu ns per cycle\n",
+           (unsigned long long)(copyChangedDuration / TEST_BENCH_ROUNDS));
+
+    exitPdou();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test copying RPDOs of selected nodes
+
+The function checks that only the RPDOs of the selected nodes are copied into
+the output process image.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_rxPdoNodes(void)
+{
+    BYTE                aNodes[EPL_API_NODE_BITMAP_SIZE];
+    UINT                channelId;
+
+    CU_ASSERT_EQUAL(initPdou(), kEplSuccessful);
+    CU_ASSERT_EQUAL(configurePdos(4, 4), kEplSuccessful);
+
+    for (channelId = 0; channelId < 4; channelId++)
+        EPL_MEMSET(stub_getRxPdo(channelId), 0x20 + channelId, 4);
+
+    EPL_MEMSET(aNodes, 0, sizeof(aNodes));
+    EPL_API_NODE_BITMAP_SET(aNodes, 2);
+    EPL_API_NODE_BITMAP_SET(aNodes, 4);
+    CU_ASSERT_EQUAL(pdou_copyRxPdoToPiNodes(aNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(*getOutputObject(0, 4, 0), 0x00);
+    CU_ASSERT_EQUAL(*getOutputObject(1, 4, 0), 0x21);
+    CU_ASSERT_EQUAL(*getOutputObject(2, 4, 3), 0x00);
+    CU_ASSERT_EQUAL(*getOutputObject(3, 4, 3), 0x23);
+
+    // nodes without RPDO are ignored
+    EPL_MEMSET(aNodes, 0, sizeof(aNodes));
+    EPL_API_NODE_BITMAP_SET(aNodes, 1);
+    EPL_API_NODE_BITMAP_SET(aNodes, 100);
+    CU_ASSERT_EQUAL(pdou_copyRxPdoToPiNodes(aNodes), kEplSuccessful);
+    CU_ASSERT_EQUAL(*getOutputObject(0, 4, 0), 0x20);
+    CU_ASSERT_EQUAL(*getOutputObject(2, 4, 0), 0x00);
+
+    exitPdou();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test copying TPDOs of selected nodes
+
+The function checks that only the TPDOs of the selected nodes are copied from
+the input process image and passed to the PDO buffers.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_txPdoNodes(void)
+{
+    BYTE                aNodes[EPL_API_NODE_BITMAP_SIZE];
+    UINT                channelId;
+
+    CU_ASSERT_EQUAL(initPdou(), kEplSuccessful);
+    CU_ASSERT_EQUAL(configurePdos(4, 4), kEplSuccessful);
+
+    for (channelId = 0; channelId < 4; channelId++)
+        *getInputObject(channelId, 4, 1) = 0x30 + channelId;
+
+    EPL_MEMSET(aNodes, 0, sizeof(aNodes));
+    EPL_API_NODE_BITMAP_SET(aNodes, 3);
+    CU_ASSERT_EQUAL(pdou_copyTxPdoFromPiNodes(aNodes), kEplSuccessful);
+    for (channelId = 0; channelId < 4; channelId++)
+    {
+        CU_ASSERT_EQUAL(stub_getTxPdo(channelId)[1], (channelId == 2) ? 0x32 : 0x00);
+        CU_ASSERT_EQUAL(stub_getTxPdoCount(channelId), (channelId == 2) ? 1 : 0);
+    }
+
+    CU_ASSERT_EQUAL(pdou_copyTxPdoFromPi(), kEplSuccessful);
+    for (channelId = 0; channelId < 4; channelId++)
+    {
+        CU_ASSERT_EQUAL(stub_getTxPdo(channelId)[1], 0x30 + channelId);
+        CU_ASSERT_EQUAL(stub_getTxPdoCount(channelId), (channelId == 2) ? 2 : 1);
+    }
+
+    exitPdou();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark copying PDOs of selected nodes
+
+The function measures the duration of copying the RPDOs and TPDOs of all 40
+nodes and of 4 selected nodes.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_pdoNodesBenchmark(void)
+{
+    BYTE                aNodes[EPL_API_NODE_BITMAP_SIZE];
+    UINT                round;
+    UINT64              startTime;
+    UINT64              allDuration;
+    UINT64              nodesDuration;
+    BOOL                fOk = TRUE;
+
+    CU_ASSERT_EQUAL(initPdou(), kEplSuccessful);
+    CU_ASSERT_EQUAL(configurePdos(STUB_RX_CHANNELS, TEST_PDO_SIZE), kEplSuccessful);
+
+    EPL_MEMSET(aNodes, 0, sizeof(aNodes));
+    EPL_API_NODE_BITMAP_SET(aNodes, 1);
+    EPL_API_NODE_BITMAP_SET(aNodes, 11);
+    EPL_API_NODE_BITMAP_SET(aNodes, 21);
+    EPL_API_NODE_BITMAP_SET(aNodes, 31);
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if ((pdou_copyRxPdoToPi() != kEplSuccessful) ||
+            (pdou_copyTxPdoFromPi() != kEplSuccessful))
+            fOk = FALSE;
+    }
+    allDuration = getTimeNs() - startTime;
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        if ((pdou_copyRxPdoToPiNodes(aNodes) != kEplSuccessful) ||
+            (pdou_copyTxPdoFromPiNodes(aNodes) != kEplSuccessful))
+            fOk = FALSE;
+    }
+    nodesDuration = getTimeNs() - startTime;
+
+    CU_ASSERT_TRUE(fOk);
+    printf("\n    %u RPDOs and TPDOs with %u bytes\n", STUB_RX_CHANNELS, TEST_PDO_SIZE);
+    printf("    all nodes: %llu ns per cycle\n",
+           (unsigned long long)(allDuration / TEST_BENCH_ROUNDS));
+    printf("    4 nodes:   %llu ns per cycle\n",
+           (unsigned long long)(nodesDuration / TEST_BENCH_ROUNDS));
+
+    exitPdou();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize PDO user module
+
+The function creates the object dictionary of the MN, links the static output
+and input objects to the simulated process images and initializes the PDO user
+module.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel initPdou(void)
+{
+    tEplKernel          ret;
+
+    ret = obd_initObd(&initParam_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = obd_init(&initParam_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = linkProcessImage(TEST_OUTPUT_INDEX, aOutputImage_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = linkProcessImage(TEST_INPUT_INDEX, aInputImage_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    return pdou_init(NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up PDO user module
+
+The function shuts down the PDO user module and deletes the object dictionary.
+*/
+//------------------------------------------------------------------------------
+static void exitPdou(void)
+{
+    pdou_exit();
+    obd_deleteInstance();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Configure PDOs
+
+The function maps the RPDOs and the TPDOs of the nodes 1 to channelCount_p
+byte by byte to consecutive static output and input objects and configures
+the PDOs by a transition to NMT_GS_RESET_CONFIGURATION.
+
+\param  channelCount_p      Number of RPDOs and TPDOs.
+\param  pdoSize_p           Size of each PDO in bytes.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel configurePdos(UINT channelCount_p, UINT pdoSize_p)
+{
+    tEplKernel              ret;
+    tEventNmtStateChange    nmtStateChange;
+    UINT                    channelId;
+
+    for (channelId = 0; channelId < STUB_RX_CHANNELS; channelId++)
+    {
+        ret = mapPdo(channelId, FALSE, channelCount_p, pdoSize_p);
+        if (ret != kEplSuccessful)
+            return ret;
+    }
+
+    for (channelId = 0; channelId < STUB_TX_CHANNELS; channelId++)
+    {
+        ret = mapPdo(channelId, TRUE, channelCount_p, pdoSize_p);
+        if (ret != kEplSuccessful)
+            return ret;
+    }
+
+    nmtStateChange.newNmtState = kNmtGsResetConfiguration;
+    nmtStateChange.oldNmtState = kNmtGsResetCommunication;
+    nmtStateChange.nmtEvent = kNmtEventEnterResetConfig;
+    return pdou_cbNmtStateChange(nmtStateChange);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Map PDO
+
+The function maps the PDO of node channelId_p + 1 byte by byte to consecutive
+static objects. The objects wrap around at the end of the process image. The
+PDOs from channelCount_p on are disabled.
+
+\param  channelId_p         PDO channel which is mapped.
+\param  fTxPdo_p            TRUE for a TPDO, FALSE for an RPDO.
+\param  channelCount_p      Number of enabled PDOs.
+\param  pdoSize_p           Size of the PDO in bytes.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel mapPdo(UINT channelId_p, BOOL fTxPdo_p, UINT channelCount_p,
+                         UINT pdoSize_p)
+{
+    tEplKernel              ret;
+    UINT                    commParamIndex;
+    UINT                    mappParamIndex;
+    UINT                    objIndex;
+    UINT                    offset;
+    BYTE                    value;
+    QWORD                   objectMapping;
+
+    commParamIndex = (fTxPdo_p ? 0x1800 : 0x1400) + channelId_p;
+    mappParamIndex = (fTxPdo_p ? 0x1A00 : 0x1600) + channelId_p;
+    objIndex = fTxPdo_p ? TEST_INPUT_INDEX : TEST_OUTPUT_INDEX;
+
+    // disable PDO before changing it
+    value = 0;
+    ret = obd_writeEntry(mappParamIndex, 0, &value, sizeof(value));
+    if ((ret != kEplSuccessful) || (channelId_p >= channelCount_p))
+        return ret;
+
+    value = (BYTE)(channelId_p + 1);
+    ret = obd_writeEntry(commParamIndex, 1, &value, sizeof(value));
+    if (ret != kEplSuccessful)
+        return ret;
+
+    for (offset = 0; offset < pdoSize_p; offset++)
+    {
+        objectMapping = objIndex |
+                        ((QWORD)(((channelId_p * pdoSize_p + offset) % TEST_PI_SIZE) + 1) << 16) |
+                        ((QWORD)(offset * 8) << 32) |
+                        ((QWORD)8 << 48);
+        ret = obd_writeEntry(mappParamIndex, offset + 1, &objectMapping,
+                             sizeof(objectMapping));
+        if (ret != kEplSuccessful)
+            return ret;
+    }
+
+    value = (BYTE)pdoSize_p;
+    return obd_writeEntry(mappParamIndex, 0, &value, sizeof(value));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Link process image
+
+The function links all sub-indices of a static object to a simulated process
+image.
+
+\param  index_p             Index of the static object.
+\param  pImage_p            Pointer to the process image.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel linkProcessImage(UINT index_p, BYTE* pImage_p)
+{
+    tEplKernel          ret;
+    tVarParam           varParam;
+    UINT                subIndex;
+
+    EPL_MEMSET(pImage_p, 0, TEST_PI_SIZE);
+    varParam.validFlag = kVarValidAll;
+    varParam.index = index_p;
+    varParam.size = 1;
+    for (subIndex = 1; subIndex <= TEST_PI_SIZE; subIndex++)
+    {
+        varParam.subindex = subIndex;
+        varParam.pData = &pImage_p[subIndex - 1];
+        ret = obd_defineVar(&varParam);
+        if (ret != kEplSuccessful)
+            return ret;
+    }
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get output process image object
+
+\param  channelId_p         RPDO channel which is mapped to the object.
+\param  pdoSize_p           Size of each RPDO in bytes.
+\param  offset_p            Offset of the object in the RPDO.
+
+\return The function returns a pointer to the object in the process image.
+*/
+//------------------------------------------------------------------------------
+static BYTE* getOutputObject(UINT channelId_p, UINT pdoSize_p, UINT offset_p)
+{
+    return &aOutputImage_l[(channelId_p * pdoSize_p + offset_p) % TEST_PI_SIZE];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get input process image object
+
+\param  channelId_p         TPDO channel which is mapped to the object.
+\param  pdoSize_p           Size of each TPDO in bytes.
+\param  offset_p            Offset of the object in the TPDO.
+
+\return The function returns a pointer to the object in the process image.
+*/
+//------------------------------------------------------------------------------
+static BYTE* getInputObject(UINT channelId_p, UINT pdoSize_p, UINT offset_p)
+{
+    return &aInputImage_l[(channelId_p * pdoSize_p + offset_p) % TEST_PI_SIZE];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Count nodes in node bitmap
+
+\param  pNodeBitmap_p       Pointer to node bitmap.
+
+\return The function returns the number of set bits.
+*/
+//------------------------------------------------------------------------------
+static UINT countNodes(BYTE* pNodeBitmap_p)
+{
+    UINT                nodeId;
+    UINT                count = 0;
+
+    for (nodeId = 0; nodeId <= EPL_C_ADR_BROADCAST; nodeId++)
+    {
+        if (EPL_API_NODE_BITMAP_TEST(pNodeBitmap_p, nodeId))
+            count++;
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
+
+/// \}
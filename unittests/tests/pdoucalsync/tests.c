@@ -0,0 +1,302 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for PDO user CAL sync module
+
+This file contains the unit test functions for the process-local PDO user CAL
+sync module. They check waiting for sync events, the counting of missed sync
+events and the decoupled sync thread, and measure the duration of signaling a
+sync event.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <user/pdoucal.h>
+
+#include "test-pdoucalsync.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_WAIT_TIMEOUT           20000       // 20 ms
+#define TEST_SIGNAL_DELAY           5000        // 5 ms
+#define TEST_CALLBACK_DURATION      10000       // 10 ms
+#define TEST_CALLBACK_SYNCS         20
+#define TEST_BENCH_ROUNDS           200000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void* signalThread(void* pArg_p);
+static tEplKernel syncCb(void);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static volatile UINT    syncCbCount_l;
+static volatile BOOL    fSyncCbWaitFailed_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test waiting for sync events
+
+The function checks that waiting times out without a sync event and that a
+sync event signaled before or during the wait releases the waiting thread.
+*/
+//------------------------------------------------------------------------------
+void test_pdoucalsync_wait(void)
+{
+    pthread_t           thread;
+    UINT32              missed;
+
+    CU_ASSERT_EQUAL(pdoucal_initSync(NULL), kEplSuccessful);
+
+    CU_ASSERT_EQUAL(pdoucal_waitSyncEvent(TEST_WAIT_TIMEOUT), kEplGeneralError);
+
+    // sync event signaled before the wait
+    CU_ASSERT_EQUAL(pdoucal_callSyncCb(), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdoucal_waitSyncEvent(TEST_WAIT_TIMEOUT), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdoucal_waitSyncEvent(TEST_WAIT_TIMEOUT), kEplGeneralError);
+
+    // sync event signaled by another thread during the wait
+    CU_ASSERT_EQUAL(pthread_create(&thread, NULL, signalThread, NULL), 0);
+    CU_ASSERT_EQUAL(pdoucal_waitSyncEvent(0), kEplSuccessful);
+    pthread_join(thread, NULL);
+
+    CU_ASSERT_EQUAL(pdoucal_getMissedSyncCount(&missed), kEplSuccessful);
+    CU_ASSERT_EQUAL(missed, 0);
+
+    pdoucal_exitSync();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test counting of missed sync events
+
+The function checks that sync events which are signaled while the application
+doesn't wait are counted as missed.
+*/
+//------------------------------------------------------------------------------
+void test_pdoucalsync_missed(void)
+{
+    UINT32              missed;
+
+    CU_ASSERT_EQUAL(pdoucal_initSync(NULL), kEplSuccessful);
+
+    CU_ASSERT_EQUAL(pdoucal_callSyncCb(), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdoucal_callSyncCb(), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdoucal_callSyncCb(), kEplSuccessful);
+
+    CU_ASSERT_EQUAL(pdoucal_waitSyncEvent(TEST_WAIT_TIMEOUT), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdoucal_getMissedSyncCount(&missed), kEplSuccessful);
+    CU_ASSERT_EQUAL(missed, 2);
+
+    CU_ASSERT_EQUAL(pdoucal_callSyncCb(), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdoucal_waitSyncEvent(TEST_WAIT_TIMEOUT), kEplSuccessful);
+    CU_ASSERT_EQUAL(pdoucal_getMissedSyncCount(&missed), kEplSuccessful);
+    CU_ASSERT_EQUAL(missed, 2);
+
+    pdoucal_exitSync();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test sync callback in sync thread
+
+The function checks that the sync callback is called by the sync thread and
+that signaling sync events doesn't wait for a slow callback. Waiting for the
+sync event inside the callback must return immediately.
+*/
+//------------------------------------------------------------------------------
+void test_pdoucalsync_callback(void)
+{
+    UINT64              startTime;
+    UINT64              duration;
+    UINT32              missed;
+    UINT                i;
+
+    syncCbCount_l = 0;
+    fSyncCbWaitFailed_l = FALSE;
+
+    CU_ASSERT_EQUAL(pdoucal_initSync(syncCb), kEplSuccessful);
+
+    CU_ASSERT_EQUAL(pdoucal_callSyncCb(), kEplSuccessful);
+    while (syncCbCount_l == 0)
+        usleep(1000);
+
+    // the callback is still running, signaling must not be delayed by it
+    startTime = getTimeNs();
+    for (i = 0; i < TEST_CALLBACK_SYNCS; i++)
+        CU_ASSERT_EQUAL(pdoucal_callSyncCb(), kEplSuccessful);
+    duration = getTimeNs() - startTime;
+    CU_ASSERT_TRUE(duration < (TEST_CALLBACK_DURATION * 1000ULL));
+
+    while (syncCbCount_l < 2)
+        usleep(1000);
+
+    pdoucal_exitSync();
+
+    CU_ASSERT_FALSE(fSyncCbWaitFailed_l);
+    CU_ASSERT_EQUAL(syncCbCount_l, 2);
+    CU_ASSERT_EQUAL(pdoucal_getMissedSyncCount(&missed), kEplSuccessful);
+    CU_ASSERT_EQUAL(missed, TEST_CALLBACK_SYNCS - 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark signaling sync events
+
+The function measures the duration of signaling a sync event without a
+waiting application.
+*/
+//------------------------------------------------------------------------------
+void test_pdoucalsync_benchmark(void)
+{
+    UINT64              startTime;
+    UINT64              duration;
+    UINT                round;
+
+    CU_ASSERT_EQUAL(pdoucal_initSync(NULL), kEplSuccessful);
+
+    startTime = getTimeNs();
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+        pdoucal_callSyncCb();
+    duration = getTimeNs() - startTime;
+
+    printf("\n    signal sync event: %llu ns\n",
+           (unsigned long long)(duration / TEST_BENCH_ROUNDS));
+
+    pdoucal_exitSync();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal thread
+
+The thread signals a sync event after a short delay.
+
+\param  pArg_p              Thread argument, not used.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* signalThread(void* pArg_p)
+{
+    UNUSED_PARAMETER(pArg_p);
+
+    usleep(TEST_SIGNAL_DELAY);
+    pdoucal_callSyncCb();
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Sync callback
+
+The callback waits for the sync event like the application does and simulates
+a long processing time.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel syncCb(void)
+{
+    if (pdoucal_waitSyncEvent(TEST_WAIT_TIMEOUT) != kEplSuccessful)
+        fSyncCbWaitFailed_l = TRUE;
+
+    usleep(TEST_CALLBACK_DURATION);
+    syncCbCount_l++;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
+
+/// \}
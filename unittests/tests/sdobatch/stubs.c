@@ -0,0 +1,810 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for SDO batch module unit tests
+
+This file contains all stubs needed by the unit tests of the SDO batch module.
+The SDO command layer stub simulates the SDO connections to remote nodes. A
+transfer started in one simulated cycle is finished after a configurable
+number of cycles, independently of the transfers running on other
+connections.
+
+If a simulated network is attached, the transfers are carried out as ASnd SDO
+frames on a segment of the simulated Ethernet driver instead. Every remote node
+is represented by a port with a responder which answers the requests. The
+responses are received by the worker thread of the local port and queued until
+they are processed by stub_processNetwork() in the context of the test.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <EplInc.h>
+#include <EdrvSim.h>
+#include <obd.h>
+#include <user/EplSdoComu.h>
+#include <user/cfmu.h>
+
+#include "test-sdobatch.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_MAX_CON                EPL_MAX_SDO_COM_CON
+
+#define STUB_NET_FRAME_SIZE         EDRVSIM_MAX_FRAME_SIZE  ///< Size of the SDO frame buffers
+#define STUB_NET_MIN_FRAME_SIZE     60          ///< Minimum Ethernet frame size without CRC
+#define STUB_NET_CMD_HEADER_SIZE    4           ///< Size of index, sub-index and reserved byte of a request
+#define STUB_NET_MAX_DATA           32          ///< Maximum data size of a simulated transfer
+#define STUB_NET_OBJECT_SIZE        4           ///< Size of the objects of the responders
+#define STUB_NET_QUEUE_SIZE         64          ///< Number of responses the receive queue is able to hold
+#define STUB_NET_WAIT_NS            10000000    ///< Maximum time stub_processNetwork() waits for a response
+#define STUB_NET_FLAG_RESPONSE      0x80        ///< Response flag of the SDO command layer header
+
+/// Offset of the command data in an ASnd SDO frame
+#define STUB_NET_DATA_OFFSET        offsetof(tEplFrame, m_Data.m_Asnd.m_Payload.m_SdoSequenceFrame. \
+                                             m_le_abSdoSeqPayload.m_le_abCommandData)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Simulated SDO command layer connection
+*/
+typedef struct
+{
+    BOOL                        fDefined;
+    UINT                        nodeId;
+    tSdoType                    sdoType;
+    BOOL                        fRunning;
+    UINT                        finishCycle;
+    UINT                        transactionId;
+    tSdoComTransParamByIndex    transParam;
+} tStubCon;
+
+/**
+\brief  Simulated remote node
+
+The responder answers the SDO requests addressed to its node on the simulated
+network.
+*/
+typedef struct
+{
+    UINT                        nodeId;
+    BYTE                        aMacAddr[6];
+    tEdrvSimPort*               pPort;
+} tStubResponder;
+
+/**
+\brief  Received SDO response
+*/
+typedef struct
+{
+    UINT                        nodeId;
+    UINT                        transactionId;
+    UINT                        size;
+    BYTE                        aData[STUB_NET_MAX_DATA];
+} tStubResponse;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void finishTransfer(tSdoComConHdl sdoComConHdl_p, tSdoComConState conState_p,
+                           UINT32 abortCode_p, const BYTE* pbRxData_p, UINT rxSize_p);
+static tEplKernel sendRequest(tStubCon* pCon_p);
+static void processResponse(const tStubResponse* pResponse_p);
+static UINT buildSdoFrame(BYTE* pbFrame_p, const BYTE* pbDstMac_p, const BYTE* pbSrcMac_p,
+                          UINT dstNodeId_p, UINT srcNodeId_p, UINT transactionId_p,
+                          UINT flags_p, UINT commandId_p, const BYTE* pbData_p, UINT size_p);
+static tAsySdoCom* getSdoCommand(BYTE* pbFrame_p, UINT frameLen_p, UINT nodeId_p);
+static void netRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                         UINT frameLen_p);
+static void responderRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                               UINT frameLen_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tStubCon     aCon_l[STUB_MAX_CON];
+static UINT         latencyCycles_l;
+static UINT         cycleCount_l;
+static UINT         runningCount_l;
+static UINT         maxRunningCount_l;
+static UINT         definedConCount_l;
+static UINT         maxDefinedConCount_l;
+static UINT         orderErrorCount_l;
+static UINT         aLastKey_l[EPL_NMT_MAX_NODE_ID];
+static UINT32       aWrittenValue_l[EPL_NMT_MAX_NODE_ID];
+static UINT         abortIndex_l;
+static UINT32       abortCode_l;
+static UINT         cfmBusyNodeId_l;
+
+static BOOL             fNetwork_l = FALSE;
+static tEdrvSimPort*    pNetPort_l;
+static BYTE             aNetMacAddr_l[6];
+static tStubResponder   aResponder_l[EPL_NMT_MAX_NODE_ID];
+static UINT             responderCount_l;
+static tStubResponse    aResponse_l[STUB_NET_QUEUE_SIZE];
+static UINT             responseWriteIdx_l;
+static UINT             responseReadIdx_l;
+static UINT             responseDropCount_l;
+static pthread_mutex_t  netMutex_l = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   netCond_l = PTHREAD_COND_INITIALIZER;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_reset(UINT latencyCycles_p)
+{
+    EPL_MEMSET(aCon_l, 0, sizeof(aCon_l));
+    EPL_MEMSET(aLastKey_l, 0, sizeof(aLastKey_l));
+    EPL_MEMSET(aWrittenValue_l, 0, sizeof(aWrittenValue_l));
+    latencyCycles_l = latencyCycles_p;
+    cycleCount_l = 0;
+    runningCount_l = 0;
+    maxRunningCount_l = 0;
+    definedConCount_l = 0;
+    maxDefinedConCount_l = 0;
+    orderErrorCount_l = 0;
+    abortIndex_l = 0;
+    abortCode_l = 0;
+    cfmBusyNodeId_l = 0;
+}
+
+void stub_processCycle(void)
+{
+    UINT    i;
+
+    cycleCount_l++;
+    for (i = 0; i < STUB_MAX_CON; i++)
+    {
+        if (aCon_l[i].fRunning && (aCon_l[i].finishCycle <= cycleCount_l))
+        {
+            if (aCon_l[i].transParam.index == abortIndex_l)
+                finishTransfer(i, kEplSdoComTransferRxAborted, abortCode_l, NULL, 0);
+            else
+                finishTransfer(i, kEplSdoComTransferFinished, 0, NULL, 0);
+        }
+    }
+}
+
+UINT stub_getCycleCount(void)
+{
+    return cycleCount_l;
+}
+
+UINT stub_getRunningCount(void)
+{
+    return runningCount_l;
+}
+
+UINT stub_getDefinedConCount(void)
+{
+    return definedConCount_l;
+}
+
+UINT stub_getMaxDefinedConCount(void)
+{
+    return maxDefinedConCount_l;
+}
+
+UINT stub_getMaxRunningCount(void)
+{
+    return maxRunningCount_l;
+}
+
+UINT stub_getOrderErrorCount(void)
+{
+    return orderErrorCount_l;
+}
+
+void stub_setAbortIndex(UINT index_p, UINT32 abortCode_p)
+{
+    abortIndex_l = index_p;
+    abortCode_l = abortCode_p;
+}
+
+void stub_setCfmBusyNode(UINT nodeId_p)
+{
+    cfmBusyNodeId_l = nodeId_p;
+}
+
+UINT32 stub_getWrittenValue(UINT nodeId_p)
+{
+    return aWrittenValue_l[nodeId_p - 1];
+}
+
+tEplKernel stub_attachNetwork(const char* pszSegment_p, UINT nodeCount_p, UINT32 latencyNs_p)
+{
+    tEplKernel          ret;
+    tEdrvSimLinkParam   linkParam;
+    UINT                i;
+
+    if ((nodeCount_p == 0) || (nodeCount_p > EPL_NMT_MAX_NODE_ID))
+        return kEplApiInvalidParam;
+
+    linkParam.latencyNs = latencyNs_p;
+    linkParam.lossPpm = 0;
+    linkParam.seed = 0;
+    ret = EdrvSimSetLinkParam(pszSegment_p, &linkParam);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    responseWriteIdx_l = 0;
+    responseReadIdx_l = 0;
+    responseDropCount_l = 0;
+    responderCount_l = 0;
+
+    EPL_MEMSET(aNetMacAddr_l, 0, sizeof(aNetMacAddr_l));
+    ret = EdrvSimAttachPort(pszSegment_p, aNetMacAddr_l, netRxHandler, NULL, &pNetPort_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    for (i = 0; i < nodeCount_p; i++)
+    {
+        EPL_MEMSET(&aResponder_l[i], 0, sizeof(tStubResponder));
+        aResponder_l[i].nodeId = i + 1;
+        ret = EdrvSimAttachPort(pszSegment_p, aResponder_l[i].aMacAddr, responderRxHandler,
+                                &aResponder_l[i], &aResponder_l[i].pPort);
+        if (ret != kEplSuccessful)
+        {
+            stub_detachNetwork();
+            return ret;
+        }
+        responderCount_l++;
+    }
+
+    fNetwork_l = TRUE;
+    return kEplSuccessful;
+}
+
+void stub_detachNetwork(void)
+{
+    UINT    i;
+
+    fNetwork_l = FALSE;
+    for (i = 0; i < responderCount_l; i++)
+        EdrvSimDetachPort(aResponder_l[i].pPort);
+    responderCount_l = 0;
+
+    if (pNetPort_l != NULL)
+    {
+        EdrvSimDetachPort(pNetPort_l);
+        pNetPort_l = NULL;
+    }
+}
+
+void stub_processNetwork(void)
+{
+    tStubResponse       response;
+    struct timespec     timeout;
+
+    pthread_mutex_lock(&netMutex_l);
+    if (responseReadIdx_l == responseWriteIdx_l)
+    {
+        clock_gettime(CLOCK_REALTIME, &timeout);
+        timeout.tv_nsec += STUB_NET_WAIT_NS;
+        if (timeout.tv_nsec >= 1000000000)
+        {
+            timeout.tv_sec++;
+            timeout.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&netCond_l, &netMutex_l, &timeout);
+    }
+
+    while (responseReadIdx_l != responseWriteIdx_l)
+    {
+        response = aResponse_l[responseReadIdx_l % STUB_NET_QUEUE_SIZE];
+        responseReadIdx_l++;
+        pthread_mutex_unlock(&netMutex_l);
+        processResponse(&response);
+        pthread_mutex_lock(&netMutex_l);
+    }
+    pthread_mutex_unlock(&netMutex_l);
+}
+
+UINT stub_getResponseDropCount(void)
+{
+    return responseDropCount_l;
+}
+
+//------------------------------------------------------------------------------
+// SDO command layer stubs
+//------------------------------------------------------------------------------
+tEplKernel PUBLIC EplSdoComDefineCon(tSdoComConHdl* pSdoComConHdl_p,
+                                     unsigned int uiTargetNodeId_p,
+                                     tSdoType ProtType_p)
+{
+    UINT    i;
+    UINT    freeHdl = STUB_MAX_CON;
+
+    for (i = 0; i < STUB_MAX_CON; i++)
+    {
+        if (!aCon_l[i].fDefined)
+        {
+            if (freeHdl == STUB_MAX_CON)
+                freeHdl = i;
+        }
+        else if ((aCon_l[i].nodeId == uiTargetNodeId_p) && (aCon_l[i].sdoType == ProtType_p))
+        {
+            *pSdoComConHdl_p = i;
+            return kEplSdoComHandleExists;
+        }
+    }
+
+    if (freeHdl == STUB_MAX_CON)
+        return kEplSdoComNoFreeHandle;
+
+    aCon_l[freeHdl].fDefined = TRUE;
+    aCon_l[freeHdl].nodeId = uiTargetNodeId_p;
+    aCon_l[freeHdl].sdoType = ProtType_p;
+    aCon_l[freeHdl].fRunning = FALSE;
+    definedConCount_l++;
+    if (definedConCount_l > maxDefinedConCount_l)
+        maxDefinedConCount_l = definedConCount_l;
+
+    *pSdoComConHdl_p = freeHdl;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplSdoComInitTransferByIndex(tSdoComTransParamByIndex* pSdoComTransParam_p)
+{
+    tEplKernel  ret;
+    tStubCon*   pCon;
+    UINT        key;
+
+    if ((pSdoComTransParam_p->index == 0) || (pSdoComTransParam_p->pData == NULL) ||
+        (pSdoComTransParam_p->dataSize == 0))
+        return kEplSdoComInvalidParam;
+
+    if (pSdoComTransParam_p->sdoComConHdl >= STUB_MAX_CON)
+        return kEplSdoComInvalidHandle;
+
+    pCon = &aCon_l[pSdoComTransParam_p->sdoComConHdl];
+    if (!pCon->fDefined)
+        return kEplSdoComInvalidHandle;
+
+    if (pCon->fRunning)
+        return kEplSdoComHandleBusy;
+
+    // transfers of a node must be started in ascending object order
+    key = (pSdoComTransParam_p->index << 8) | pSdoComTransParam_p->subindex;
+    if (key <= aLastKey_l[pCon->nodeId - 1])
+        orderErrorCount_l++;
+    aLastKey_l[pCon->nodeId - 1] = key;
+
+    pCon->transParam = *pSdoComTransParam_p;
+    pCon->fRunning = TRUE;
+    pCon->finishCycle = cycleCount_l + latencyCycles_l;
+    pCon->transactionId++;
+    runningCount_l++;
+    if (runningCount_l > maxRunningCount_l)
+        maxRunningCount_l = runningCount_l;
+
+    if (fNetwork_l)
+    {
+        ret = sendRequest(pCon);
+        if (ret != kEplSuccessful)
+        {
+            pCon->fRunning = FALSE;
+            runningCount_l--;
+        }
+        return ret;
+    }
+
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplSdoComUndefineCon(tSdoComConHdl SdoComConHdl_p)
+{
+    if ((SdoComConHdl_p >= STUB_MAX_CON) || !aCon_l[SdoComConHdl_p].fDefined)
+        return kEplSdoComInvalidHandle;
+
+    if (aCon_l[SdoComConHdl_p].fRunning)
+        runningCount_l--;
+
+    aCon_l[SdoComConHdl_p].fDefined = FALSE;
+    aCon_l[SdoComConHdl_p].fRunning = FALSE;
+    definedConCount_l--;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplSdoComSdoAbort(tSdoComConHdl SdoComConHdl_p, DWORD dwAbortCode_p)
+{
+    if ((SdoComConHdl_p >= STUB_MAX_CON) || !aCon_l[SdoComConHdl_p].fDefined)
+        return kEplSdoComInvalidHandle;
+
+    if (aCon_l[SdoComConHdl_p].fRunning)
+        finishTransfer(SdoComConHdl_p, kEplSdoComTransferTxAborted, dwAbortCode_p, NULL, 0);
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+// OBD and CFM stubs
+//------------------------------------------------------------------------------
+UINT obd_getNodeId(void)
+{
+    return STUB_LOCAL_NODE_ID;
+}
+
+tEplKernel obd_readEntryToLe(UINT index_p, UINT subIndex_p, void* pDstData_p, tObdSize* pSize_p)
+{
+    if (index_p == abortIndex_l)
+        return kEplObdIndexNotExist;
+
+    *pSize_p = 1;
+    *(UINT8*)pDstData_p = (UINT8)(STUB_LOCAL_NODE_ID + index_p + subIndex_p);
+    return kEplSuccessful;
+}
+
+tEplKernel obd_writeEntryFromLe(UINT index_p, UINT subIndex_p, void* pSrcData_p, tObdSize size_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+    UNUSED_PARAMETER(size_p);
+
+    if (index_p == abortIndex_l)
+        return kEplObdIndexNotExist;
+
+    aWrittenValue_l[STUB_LOCAL_NODE_ID - 1] = *(UINT8*)pSrcData_p;
+    return kEplSuccessful;
+}
+
+BOOL cfmu_isSdoRunning(UINT nodeId_p)
+{
+    return (nodeId_p == cfmBusyNodeId_l);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish a simulated transfer
+
+The function finishes the running transfer of the specified connection. Read
+transfers fill the buffer with the received data or, without received data,
+with a pattern derived from node ID, index and sub-index; write transfers
+store the first data byte per node. Like the SDO command layer, the connection
+is idle again when the callback function is called.
+
+\param  sdoComConHdl_p      Handle of the connection.
+\param  conState_p          Resulting state of the transfer.
+\param  abortCode_p         Abort code of the transfer.
+\param  pbRxData_p          Received data of a read transfer, or NULL.
+\param  rxSize_p            Size of the received data.
+*/
+//------------------------------------------------------------------------------
+static void finishTransfer(tSdoComConHdl sdoComConHdl_p, tSdoComConState conState_p,
+                           UINT32 abortCode_p, const BYTE* pbRxData_p, UINT rxSize_p)
+{
+    tStubCon*           pCon = &aCon_l[sdoComConHdl_p];
+    tSdoComFinished     finished;
+    UINT                i;
+    UINT8*              pData = (UINT8*)pCon->transParam.pData;
+
+    finished.sdoComConHdl = sdoComConHdl_p;
+    finished.sdoComConState = conState_p;
+    finished.abortCode = abortCode_p;
+    finished.sdoAccessType = pCon->transParam.sdoAccessType;
+    finished.nodeId = pCon->nodeId;
+    finished.targetIndex = pCon->transParam.index;
+    finished.targetSubIndex = pCon->transParam.subindex;
+    finished.transferredBytes = 0;
+    finished.pUserArg = pCon->transParam.pUserArg;
+
+    if (conState_p == kEplSdoComTransferFinished)
+    {
+        finished.transferredBytes = pCon->transParam.dataSize;
+        if ((pCon->transParam.sdoAccessType == kSdoAccessTypeRead) && (pbRxData_p != NULL))
+        {
+            if (rxSize_p < finished.transferredBytes)
+                finished.transferredBytes = rxSize_p;
+            EPL_MEMCPY(pData, pbRxData_p, finished.transferredBytes);
+        }
+        else if (pCon->transParam.sdoAccessType == kSdoAccessTypeRead)
+        {
+            for (i = 0; i < pCon->transParam.dataSize; i++)
+                pData[i] = (UINT8)(pCon->nodeId + pCon->transParam.index + pCon->transParam.subindex + i);
+        }
+        else
+        {
+            aWrittenValue_l[pCon->nodeId - 1] = pData[0];
+        }
+    }
+
+    pCon->fRunning = FALSE;
+    runningCount_l--;
+
+    if (pCon->transParam.pfnSdoFinishedCb != NULL)
+        pCon->transParam.pfnSdoFinishedCb(&finished);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send the request of a transfer to the simulated network
+
+\param  pCon_p              Pointer to the connection.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel sendRequest(tStubCon* pCon_p)
+{
+    BYTE            aFrame[STUB_NET_FRAME_SIZE];
+    BYTE            aData[STUB_NET_CMD_HEADER_SIZE + STUB_NET_MAX_DATA];
+    UINT            size = STUB_NET_CMD_HEADER_SIZE;
+    UINT            commandId = kSdoServiceReadByIndex;
+    UINT            frameLen;
+
+    if ((pCon_p->nodeId > responderCount_l) || (pCon_p->transParam.dataSize > STUB_NET_MAX_DATA))
+        return kEplSdoComInvalidParam;
+
+    AmiSetWordToLe(&aData[0], (WORD)pCon_p->transParam.index);
+    AmiSetByteToLe(&aData[2], (BYTE)pCon_p->transParam.subindex);
+    AmiSetByteToLe(&aData[3], 0);
+    if (pCon_p->transParam.sdoAccessType == kSdoAccessTypeWrite)
+    {
+        commandId = kSdoServiceWriteByIndex;
+        EPL_MEMCPY(&aData[size], pCon_p->transParam.pData, pCon_p->transParam.dataSize);
+        size += pCon_p->transParam.dataSize;
+    }
+
+    frameLen = buildSdoFrame(aFrame, aResponder_l[pCon_p->nodeId - 1].aMacAddr, aNetMacAddr_l,
+                             pCon_p->nodeId, STUB_LOCAL_NODE_ID, pCon_p->transactionId,
+                             0, commandId, aData, size);
+
+    return EdrvSimSendFrame(pNetPort_l, aFrame, frameLen);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process a received SDO response
+
+The function finishes the running transfer the response belongs to. Responses
+of transfers which are not running anymore, e.g. because they were aborted,
+are ignored.
+
+\param  pResponse_p         Pointer to the response.
+*/
+//------------------------------------------------------------------------------
+static void processResponse(const tStubResponse* pResponse_p)
+{
+    UINT    i;
+
+    for (i = 0; i < STUB_MAX_CON; i++)
+    {
+        if (aCon_l[i].fRunning && (aCon_l[i].nodeId == pResponse_p->nodeId) &&
+            ((BYTE)aCon_l[i].transactionId == pResponse_p->transactionId))
+        {
+            finishTransfer(i, kEplSdoComTransferFinished, 0, pResponse_p->aData,
+                           pResponse_p->size);
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build an ASnd SDO frame
+
+\param  pbFrame_p           Pointer to the frame buffer.
+\param  pbDstMac_p          Destination MAC address.
+\param  pbSrcMac_p          Source MAC address.
+\param  dstNodeId_p         Destination node ID.
+\param  srcNodeId_p         Source node ID.
+\param  transactionId_p     Transaction ID of the command layer.
+\param  flags_p             Flags of the command layer.
+\param  commandId_p         Command ID of the command layer.
+\param  pbData_p            Command data.
+\param  size_p              Size of the command data.
+
+\return The function returns the length of the frame.
+*/
+//------------------------------------------------------------------------------
+static UINT buildSdoFrame(BYTE* pbFrame_p, const BYTE* pbDstMac_p, const BYTE* pbSrcMac_p,
+                          UINT dstNodeId_p, UINT srcNodeId_p, UINT transactionId_p,
+                          UINT flags_p, UINT commandId_p, const BYTE* pbData_p, UINT size_p)
+{
+    tEplFrame*      pFrame = (tEplFrame*)pbFrame_p;
+    tAsySdoSeq*     pSeq = &pFrame->m_Data.m_Asnd.m_Payload.m_SdoSequenceFrame;
+    tAsySdoCom*     pCom = &pSeq->m_le_abSdoSeqPayload;
+    UINT            frameLen;
+
+    EPL_MEMSET(pbFrame_p, 0, STUB_NET_FRAME_SIZE);
+    EPL_MEMCPY(pFrame->m_be_abDstMac, pbDstMac_p, 6);
+    EPL_MEMCPY(pFrame->m_be_abSrcMac, pbSrcMac_p, 6);
+    AmiSetWordToBe(&pFrame->m_be_wEtherType, EPL_C_DLL_ETHERTYPE_EPL);
+    AmiSetByteToLe(&pFrame->m_le_bMessageType, (BYTE)kEplMsgTypeAsnd);
+    AmiSetByteToLe(&pFrame->m_le_bDstNodeId, (BYTE)dstNodeId_p);
+    AmiSetByteToLe(&pFrame->m_le_bSrcNodeId, (BYTE)srcNodeId_p);
+    AmiSetByteToLe(&pFrame->m_Data.m_Asnd.m_le_bServiceId, (BYTE)kDllAsndSdo);
+
+    AmiSetByteToLe(&pCom->m_le_bTransactionId, (BYTE)transactionId_p);
+    AmiSetByteToLe(&pCom->m_le_bFlags, (BYTE)flags_p);
+    AmiSetByteToLe(&pCom->m_le_bCommandId, (BYTE)commandId_p);
+    AmiSetWordToLe(&pCom->m_le_wSegmentSize, (WORD)size_p);
+    EPL_MEMCPY(pCom->m_le_abCommandData, pbData_p, size_p);
+
+    frameLen = STUB_NET_DATA_OFFSET + size_p;
+    if (frameLen < STUB_NET_MIN_FRAME_SIZE)
+        frameLen = STUB_NET_MIN_FRAME_SIZE;
+
+    return frameLen;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the SDO command layer header of a received frame
+
+\param  pbFrame_p           Pointer to the frame.
+\param  frameLen_p          Length of the frame.
+\param  nodeId_p            Node ID the frame must be addressed to.
+
+\return The function returns a pointer to the command layer header, or NULL if
+        the frame is no ASnd SDO frame for the node.
+*/
+//------------------------------------------------------------------------------
+static tAsySdoCom* getSdoCommand(BYTE* pbFrame_p, UINT frameLen_p, UINT nodeId_p)
+{
+    tEplFrame*      pFrame = (tEplFrame*)pbFrame_p;
+    tAsySdoCom*     pCom = &pFrame->m_Data.m_Asnd.m_Payload.m_SdoSequenceFrame.m_le_abSdoSeqPayload;
+
+    if ((frameLen_p < STUB_NET_DATA_OFFSET) ||
+        (AmiGetWordFromBe(&pFrame->m_be_wEtherType) != EPL_C_DLL_ETHERTYPE_EPL) ||
+        (AmiGetByteFromLe(&pFrame->m_le_bMessageType) != kEplMsgTypeAsnd) ||
+        (AmiGetByteFromLe(&pFrame->m_Data.m_Asnd.m_le_bServiceId) != kDllAsndSdo) ||
+        (AmiGetByteFromLe(&pFrame->m_le_bDstNodeId) != nodeId_p))
+        return NULL;
+
+    if ((STUB_NET_DATA_OFFSET + AmiGetWordFromLe(&pCom->m_le_wSegmentSize)) > frameLen_p)
+        return NULL;
+
+    return pCom;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive handler of the local port
+
+The handler queues the SDO responses addressed to the local node. It is called
+by the worker thread of the port.
+*/
+//------------------------------------------------------------------------------
+static void netRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                         UINT frameLen_p)
+{
+    tEplFrame*      pFrame = (tEplFrame*)pbFrame_p;
+    tAsySdoCom*     pCom;
+    tStubResponse*  pResponse;
+    UINT            size;
+
+    UNUSED_PARAMETER(pPort_p);
+    UNUSED_PARAMETER(pArg_p);
+
+    pCom = getSdoCommand(pbFrame_p, frameLen_p, STUB_LOCAL_NODE_ID);
+    if ((pCom == NULL) || ((AmiGetByteFromLe(&pCom->m_le_bFlags) & STUB_NET_FLAG_RESPONSE) == 0))
+        return;
+
+    size = AmiGetWordFromLe(&pCom->m_le_wSegmentSize);
+    pthread_mutex_lock(&netMutex_l);
+    if ((size > STUB_NET_MAX_DATA) ||
+        ((responseWriteIdx_l - responseReadIdx_l) >= STUB_NET_QUEUE_SIZE))
+    {
+        responseDropCount_l++;
+    }
+    else
+    {
+        pResponse = &aResponse_l[responseWriteIdx_l % STUB_NET_QUEUE_SIZE];
+        pResponse->nodeId = AmiGetByteFromLe(&pFrame->m_le_bSrcNodeId);
+        pResponse->transactionId = AmiGetByteFromLe(&pCom->m_le_bTransactionId);
+        pResponse->size = size;
+        EPL_MEMCPY(pResponse->aData, pCom->m_le_abCommandData, size);
+        responseWriteIdx_l++;
+        pthread_cond_signal(&netCond_l);
+    }
+    pthread_mutex_unlock(&netMutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive handler of a responder
+
+The handler answers the SDO requests addressed to the node of the responder.
+Read requests return an object filled with a pattern derived from node ID,
+index and sub-index; write requests are confirmed without data.
+*/
+//------------------------------------------------------------------------------
+static void responderRxHandler(tEdrvSimPort* pPort_p, void* pArg_p, BYTE* pbFrame_p,
+                               UINT frameLen_p)
+{
+    tStubResponder* pResponder = (tStubResponder*)pArg_p;
+    tEplFrame*      pFrame = (tEplFrame*)pbFrame_p;
+    tAsySdoCom*     pCom;
+    BYTE            aFrame[STUB_NET_FRAME_SIZE];
+    BYTE            aData[STUB_NET_OBJECT_SIZE];
+    UINT            commandId;
+    UINT            index;
+    UINT            subindex;
+    UINT            size = 0;
+    UINT            frameLen;
+    UINT            i;
+
+    pCom = getSdoCommand(pbFrame_p, frameLen_p, pResponder->nodeId);
+    if ((pCom == NULL) || ((AmiGetByteFromLe(&pCom->m_le_bFlags) & STUB_NET_FLAG_RESPONSE) != 0) ||
+        (AmiGetWordFromLe(&pCom->m_le_wSegmentSize) < STUB_NET_CMD_HEADER_SIZE))
+        return;
+
+    commandId = AmiGetByteFromLe(&pCom->m_le_bCommandId);
+    index = AmiGetWordFromLe(&pCom->m_le_abCommandData[0]);
+    subindex = AmiGetByteFromLe(&pCom->m_le_abCommandData[2]);
+    if (commandId == kSdoServiceReadByIndex)
+    {
+        for (i = 0; i < STUB_NET_OBJECT_SIZE; i++)
+            aData[i] = (BYTE)(pResponder->nodeId + index + subindex + i);
+        size = STUB_NET_OBJECT_SIZE;
+    }
+
+    frameLen = buildSdoFrame(aFrame, pFrame->m_be_abSrcMac, pResponder->aMacAddr,
+                             AmiGetByteFromLe(&pFrame->m_le_bSrcNodeId), pResponder->nodeId,
+                             AmiGetByteFromLe(&pCom->m_le_bTransactionId),
+                             STUB_NET_FLAG_RESPONSE, commandId, aData, size);
+    EdrvSimSendFrame(pPort_p, aFrame, frameLen);
+}
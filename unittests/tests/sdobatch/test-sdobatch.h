@@ -0,0 +1,94 @@
+/**
+********************************************************************************
+\file   test-sdobatch.h
+
+\brief  Definitions unit tests of SDO batch module
+
+The file contains the definitions for the unit tests of the SDO batch module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_test_sdobatch_H_
+#define _INC_test_sdobatch_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <sdo.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_LOCAL_NODE_ID          240         ///< Node ID of the local node (MN)
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void test_sdobatch_remoteItems(void);
+void test_sdobatch_localItems(void);
+void test_sdobatch_errors(void);
+void test_sdobatch_abort(void);
+void test_sdobatch_busyConnection(void);
+void test_sdobatch_connectionLimit(void);
+void test_sdobatch_throughput(void);
+void test_sdobatch_simNetwork(void);
+
+// stub control functions
+void stub_reset(UINT latencyCycles_p);
+void stub_processCycle(void);
+UINT stub_getCycleCount(void);
+UINT stub_getRunningCount(void);
+UINT stub_getDefinedConCount(void);
+UINT stub_getMaxDefinedConCount(void);
+UINT stub_getMaxRunningCount(void);
+UINT stub_getOrderErrorCount(void);
+void stub_setAbortIndex(UINT index_p, UINT32 abortCode_p);
+void stub_setCfmBusyNode(UINT nodeId_p);
+UINT32 stub_getWrittenValue(UINT nodeId_p);
+tEplKernel stub_attachNetwork(const char* pszSegment_p, UINT nodeCount_p, UINT32 latencyNs_p);
+void stub_detachNetwork(void);
+void stub_processNetwork(void);
+UINT stub_getResponseDropCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_test_sdobatch_H_ */
@@ -0,0 +1,679 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for SDO batch module
+
+This file contains the unit test functions for the SDO batch module. The tests
+run the module on top of a simulated SDO command layer which finishes every
+transfer a fixed number of cycles after it was started.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <EplSdoAc.h>
+#include <user/EplSdoComu.h>
+#include <user/sdobatchu.h>
+
+#include "test-sdobatch.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NODE_COUNT             150         ///< Number of nodes of the large batches
+#define TEST_OBJECT_COUNT           30          ///< Number of objects per node of the throughput test
+#define TEST_MAX_ITEMS              (TEST_NODE_COUNT * TEST_OBJECT_COUNT)
+#define TEST_MAX_CYCLES             100000
+#define TEST_INDEX                  0x2000
+#define TEST_APP_INDEX              0x1000
+
+#define TEST_SIM_NODE_COUNT         16          ///< Number of responders on the simulated network
+#define TEST_SIM_OBJECT_COUNT       20          ///< Number of objects per responder
+#define TEST_SIM_ITEMS              (TEST_SIM_NODE_COUNT * TEST_SIM_OBJECT_COUNT)
+#define TEST_SIM_LATENCY_NS         100000      ///< Link latency of the simulated network
+#define TEST_SIM_TIMEOUT_NS         10000000000ULL
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void         initTest(UINT latencyCycles_p);
+static void         setupItem(tSdoBatchItem* pItem_p, UINT nodeId_p, UINT subindex_p,
+                              tSdoAccessType accessType_p);
+static void         setupBatch(tSdoBatch* pBatch_p, tSdoBatchItem* pItems_p, UINT itemCount_p);
+static UINT         runBatch(tSdoBatch* pBatch_p);
+static UINT64       runNetworkBatch(tSdoBatch* pBatch_p);
+static BOOL         checkReadData(const tSdoBatchItem* pItem_p);
+static tEplKernel   cbItemFinished(tSdoBatchItem* pItem_p);
+static tEplKernel   cbFinished(tSdoBatch* pBatch_p);
+static tEplKernel   cbAppSdoFinished(tSdoComFinished* pSdoComFinished_p);
+static UINT64       getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSdoBatchItem    aItem_l[TEST_MAX_ITEMS];
+static UINT32           aData_l[TEST_MAX_ITEMS];
+static UINT             itemEventCount_l;
+static UINT             finishedEventCount_l;
+static tSdoBatch*       pFinishedBatch_l;
+static UINT             appFinishedCount_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test remote items
+
+The test reads several objects from three nodes. The nodes must be served in
+parallel while the items of every node are transferred one after the other
+in the order of the batch.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_remoteItems(void)
+{
+    tSdoBatch   batch;
+    UINT        i;
+
+    initTest(1);
+
+    // items of the nodes are interleaved in the batch
+    for (i = 0; i < 12; i++)
+        setupItem(&aItem_l[i], (i % 3) + 1, (i / 3) + 1, kSdoAccessTypeRead);
+    setupBatch(&batch, aItem_l, 12);
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    CU_ASSERT_EQUAL(stub_getRunningCount(), 3);
+
+    CU_ASSERT_EQUAL(runBatch(&batch), 4);
+    CU_ASSERT_EQUAL(batch.finishedCount, 12);
+    CU_ASSERT_EQUAL(batch.errorCount, 0);
+    CU_ASSERT_EQUAL(itemEventCount_l, 12);
+    CU_ASSERT_EQUAL(finishedEventCount_l, 1);
+    CU_ASSERT_PTR_EQUAL(pFinishedBatch_l, &batch);
+    CU_ASSERT_EQUAL(stub_getOrderErrorCount(), 0);
+    CU_ASSERT_EQUAL(stub_getDefinedConCount(), 0);
+
+    for (i = 0; i < 12; i++)
+    {
+        CU_ASSERT_EQUAL(aItem_l[i].sdoComConState, kEplSdoComTransferFinished);
+        CU_ASSERT_EQUAL(aItem_l[i].size, sizeof(UINT32));
+        CU_ASSERT(checkReadData(&aItem_l[i]));
+    }
+
+    // a finished batch can be started again
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    CU_ASSERT_EQUAL(runBatch(&batch), 4);
+    CU_ASSERT_EQUAL(finishedEventCount_l, 2);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test local items
+
+The test checks that items addressing the local node are executed immediately
+and are not reported by events.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_localItems(void)
+{
+    tSdoBatch   batch;
+
+    initTest(1);
+
+    setupItem(&aItem_l[0], 0, 1, kSdoAccessTypeRead);
+    setupItem(&aItem_l[1], STUB_LOCAL_NODE_ID, 2, kSdoAccessTypeWrite);
+    aData_l[1] = 0x5A;
+    setupBatch(&batch, aItem_l, 2);
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplSuccessful);
+    CU_ASSERT_EQUAL(batch.finishedCount, 2);
+    CU_ASSERT_EQUAL(batch.errorCount, 0);
+    CU_ASSERT_FALSE(batch.fActive);
+    CU_ASSERT_EQUAL(itemEventCount_l, 0);
+    CU_ASSERT_EQUAL(finishedEventCount_l, 0);
+    CU_ASSERT_EQUAL(aItem_l[0].size, 1);
+    CU_ASSERT_EQUAL(*(UINT8*)aItem_l[0].pData, (UINT8)(STUB_LOCAL_NODE_ID + TEST_INDEX + 1));
+    CU_ASSERT_EQUAL(stub_getWrittenValue(STUB_LOCAL_NODE_ID), 0x5A);
+    CU_ASSERT_EQUAL(stub_getRunningCount(), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test failed items
+
+The test checks the parameter validation and that aborted transfers and
+transfers which could not be started are reported as failed items.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_errors(void)
+{
+    tSdoBatch   batch;
+
+    initTest(1);
+
+    CU_ASSERT_EQUAL(sdobatchu_start(NULL), kEplApiInvalidParam);
+    setupItem(&aItem_l[0], 1, 1, kSdoAccessTypeRead);
+    setupBatch(&batch, aItem_l, 0);
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiInvalidParam);
+    setupBatch(&batch, aItem_l, 1);
+    aItem_l[0].index = 0;
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiInvalidParam);
+    aItem_l[0].index = TEST_INDEX;
+    aItem_l[0].nodeId = EPL_NMT_MAX_NODE_ID + 1;
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiInvalidParam);
+    CU_ASSERT_EQUAL(stub_getRunningCount(), 0);
+
+    // first item is aborted by the target, third item addresses a node which
+    // is configured by the CFM
+    setupItem(&aItem_l[0], 1, 1, kSdoAccessTypeRead);
+    aItem_l[0].index = TEST_INDEX - 1;
+    setupItem(&aItem_l[1], 1, 2, kSdoAccessTypeWrite);
+    setupItem(&aItem_l[2], 7, 1, kSdoAccessTypeRead);
+    setupBatch(&batch, aItem_l, 3);
+    stub_setAbortIndex(TEST_INDEX - 1, EPL_SDOAC_OBJECT_NOT_EXIST);
+    stub_setCfmBusyNode(7);
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    CU_ASSERT_EQUAL(aItem_l[2].ret, kEplApiSdoBusyIntern);
+    CU_ASSERT_EQUAL(itemEventCount_l, 1);
+
+    // an active batch cannot be started twice
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiInvalidParam);
+
+    CU_ASSERT_EQUAL(runBatch(&batch), 2);
+    CU_ASSERT_EQUAL(batch.finishedCount, 3);
+    CU_ASSERT_EQUAL(batch.errorCount, 2);
+    CU_ASSERT_EQUAL(finishedEventCount_l, 1);
+    CU_ASSERT_EQUAL(aItem_l[0].sdoComConState, kEplSdoComTransferRxAborted);
+    CU_ASSERT_EQUAL(aItem_l[0].abortCode, EPL_SDOAC_OBJECT_NOT_EXIST);
+    CU_ASSERT_EQUAL(aItem_l[1].sdoComConState, kEplSdoComTransferFinished);
+    CU_ASSERT_EQUAL(stub_getWrittenValue(1), aData_l[1] & 0xFF);
+    CU_ASSERT_EQUAL(stub_getDefinedConCount(), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test abort of a batch
+
+The test aborts a batch while transfers are running and further items are
+queued. All items must be finished immediately and the batch must be reported
+as finished.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_abort(void)
+{
+    tSdoBatch   batch;
+    UINT        i;
+
+    initTest(3);
+
+    for (i = 0; i < 10; i++)
+        setupItem(&aItem_l[i], (i / 5) + 1, (i % 5) + 1, kSdoAccessTypeRead);
+    setupBatch(&batch, aItem_l, 10);
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    stub_processCycle();
+    CU_ASSERT_EQUAL(stub_getRunningCount(), 2);
+
+    CU_ASSERT_EQUAL(sdobatchu_abort(&batch), kEplSuccessful);
+    CU_ASSERT_FALSE(batch.fActive);
+    CU_ASSERT_EQUAL(batch.finishedCount, 10);
+    CU_ASSERT_EQUAL(batch.errorCount, 10);
+    CU_ASSERT_EQUAL(itemEventCount_l, 10);
+    CU_ASSERT_EQUAL(finishedEventCount_l, 1);
+    CU_ASSERT_EQUAL(stub_getRunningCount(), 0);
+    CU_ASSERT_EQUAL(stub_getDefinedConCount(), 0);
+
+    for (i = 0; i < 10; i++)
+    {
+        CU_ASSERT_EQUAL(aItem_l[i].sdoComConState, kEplSdoComTransferTxAborted);
+        CU_ASSERT_EQUAL(aItem_l[i].abortCode, EPL_SDOAC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL);
+    }
+
+    // aborting a finished batch has no effect
+    CU_ASSERT_EQUAL(sdobatchu_abort(&batch), kEplSuccessful);
+    CU_ASSERT_EQUAL(finishedEventCount_l, 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test busy application connection
+
+The test starts a batch for a node whose SDO connection is used by a transfer
+of the application. The batch must wait until the transfer of the application
+is finished and must not close the connection of the application.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_busyConnection(void)
+{
+    tSdoBatch                   batch;
+    tSdoComConHdl               appConHdl;
+    tSdoComTransParamByIndex    transParam;
+    UINT32                      appData;
+
+    initTest(2);
+
+    CU_ASSERT_EQUAL_FATAL(EplSdoComDefineCon(&appConHdl, 4, kSdoTypeAsnd), kEplSuccessful);
+    transParam.sdoComConHdl = appConHdl;
+    transParam.index = TEST_APP_INDEX;
+    transParam.subindex = 1;
+    transParam.pData = &appData;
+    transParam.dataSize = sizeof(appData);
+    transParam.timeout = 0;
+    transParam.sdoAccessType = kSdoAccessTypeRead;
+    transParam.pfnSdoFinishedCb = cbAppSdoFinished;
+    transParam.pUserArg = NULL;
+    CU_ASSERT_EQUAL_FATAL(EplSdoComInitTransferByIndex(&transParam), kEplSuccessful);
+
+    setupItem(&aItem_l[0], 4, 1, kSdoAccessTypeRead);
+    setupItem(&aItem_l[1], 4, 2, kSdoAccessTypeRead);
+    setupBatch(&batch, aItem_l, 2);
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    CU_ASSERT_EQUAL(stub_getRunningCount(), 1);
+    CU_ASSERT_EQUAL(batch.finishedCount, 0);
+
+    CU_ASSERT_EQUAL(runBatch(&batch), 6);
+    CU_ASSERT_EQUAL(appFinishedCount_l, 1);
+    CU_ASSERT_EQUAL(batch.errorCount, 0);
+    CU_ASSERT_EQUAL(stub_getOrderErrorCount(), 0);
+    CU_ASSERT(checkReadData(&aItem_l[1]));
+
+    // the connection of the application is still defined
+    CU_ASSERT_EQUAL(stub_getDefinedConCount(), 1);
+    CU_ASSERT_EQUAL(EplSdoComUndefineCon(appConHdl), kEplSuccessful);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test batch with more nodes than SDO connections
+
+The test starts a batch for more nodes than SDO connections are available.
+Nodes which do not get a connection must wait until another node has finished
+its queue.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_connectionLimit(void)
+{
+    tSdoBatch   batch;
+    UINT        i;
+
+    initTest(1);
+
+    for (i = 0; i < TEST_NODE_COUNT * 2; i++)
+        setupItem(&aItem_l[i], (i % TEST_NODE_COUNT) + 1, (i / TEST_NODE_COUNT) + 1, kSdoAccessTypeWrite);
+    setupBatch(&batch, aItem_l, TEST_NODE_COUNT * 2);
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    CU_ASSERT_EQUAL(stub_getRunningCount(), EPL_MAX_SDO_COM_CON);
+
+    runBatch(&batch);
+    CU_ASSERT_FALSE(batch.fActive);
+    CU_ASSERT_EQUAL(batch.finishedCount, TEST_NODE_COUNT * 2);
+    CU_ASSERT_EQUAL(batch.errorCount, 0);
+    CU_ASSERT_EQUAL(stub_getMaxDefinedConCount(), EPL_MAX_SDO_COM_CON);
+    CU_ASSERT_EQUAL(stub_getDefinedConCount(), 0);
+    CU_ASSERT_EQUAL(stub_getOrderErrorCount(), 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test throughput of batched transfers
+
+The test reads a number of objects from many nodes once as a single batch and
+once object by object, as an application using oplk_readObject() has to do it.
+The batch must need only a fraction of the simulated cycles.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_throughput(void)
+{
+    tSdoBatch   batch;
+    UINT        i;
+    UINT        batchedCycles;
+    UINT        serializedCycles;
+
+    initTest(2);
+
+    for (i = 0; i < TEST_MAX_ITEMS; i++)
+        setupItem(&aItem_l[i], (i % TEST_NODE_COUNT) + 1, (i / TEST_NODE_COUNT) + 1, kSdoAccessTypeRead);
+    setupBatch(&batch, aItem_l, TEST_MAX_ITEMS);
+    batch.fItemEvents = FALSE;
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    batchedCycles = runBatch(&batch);
+    CU_ASSERT_FALSE(batch.fActive);
+    CU_ASSERT_EQUAL(batch.errorCount, 0);
+    CU_ASSERT_EQUAL(itemEventCount_l, 0);
+    CU_ASSERT_EQUAL(stub_getMaxRunningCount(), EPL_MAX_SDO_COM_CON);
+
+    initTest(2);
+
+    serializedCycles = 0;
+    for (i = 0; i < TEST_MAX_ITEMS; i++)
+    {
+        setupBatch(&batch, &aItem_l[i], 1);
+        CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+        serializedCycles += runBatch(&batch);
+        CU_ASSERT_EQUAL(batch.errorCount, 0);
+    }
+
+    CU_ASSERT_EQUAL(serializedCycles, TEST_MAX_ITEMS * 2);
+    CU_ASSERT(batchedCycles * 10 < serializedCycles);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test throughput over a simulated network
+
+The test reads the same objects from responders on a simulated network segment
+once as a single batch and once item by item. The requests and responses are
+transferred as ASnd SDO frames with the configured link latency. The measured
+throughput is printed.
+*/
+//------------------------------------------------------------------------------
+void test_sdobatch_simNetwork(void)
+{
+    char        aSegment[32];
+    tSdoBatch   batch;
+    UINT        i;
+    UINT        dataErrors;
+    UINT64      batchedTime;
+    UINT64      serializedTime;
+
+    snprintf(aSegment, sizeof(aSegment), "sdobatch%d", (int)getpid());
+    CU_ASSERT_EQUAL_FATAL(stub_attachNetwork(aSegment, TEST_SIM_NODE_COUNT, TEST_SIM_LATENCY_NS),
+                          kEplSuccessful);
+
+    initTest(0);
+
+    for (i = 0; i < TEST_SIM_ITEMS; i++)
+    {
+        setupItem(&aItem_l[i], (i % TEST_SIM_NODE_COUNT) + 1, (i / TEST_SIM_NODE_COUNT) + 1,
+                  kSdoAccessTypeRead);
+    }
+    setupBatch(&batch, aItem_l, TEST_SIM_ITEMS);
+    batch.fItemEvents = FALSE;
+
+    CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+    batchedTime = runNetworkBatch(&batch);
+    CU_ASSERT_FALSE(batch.fActive);
+    CU_ASSERT_EQUAL(batch.errorCount, 0);
+    CU_ASSERT_EQUAL(stub_getMaxRunningCount(), TEST_SIM_NODE_COUNT);
+
+    dataErrors = 0;
+    for (i = 0; i < TEST_SIM_ITEMS; i++)
+    {
+        if (!checkReadData(&aItem_l[i]))
+            dataErrors++;
+    }
+    CU_ASSERT_EQUAL(dataErrors, 0);
+
+    initTest(0);
+
+    serializedTime = 0;
+    for (i = 0; i < TEST_SIM_ITEMS; i++)
+    {
+        EPL_MEMSET(aItem_l[i].pData, 0, aItem_l[i].size);
+        setupBatch(&batch, &aItem_l[i], 1);
+        CU_ASSERT_EQUAL(sdobatchu_start(&batch), kEplApiTaskDeferred);
+        serializedTime += runNetworkBatch(&batch);
+        CU_ASSERT_EQUAL(batch.errorCount, 0);
+        CU_ASSERT(checkReadData(&aItem_l[i]));
+    }
+
+    CU_ASSERT_EQUAL(stub_getResponseDropCount(), 0);
+    stub_detachNetwork();
+
+    printf("\n    %u nodes x %u objects, %u us latency: batched %.0f items/s, serialized %.0f items/s\n",
+           TEST_SIM_NODE_COUNT, TEST_SIM_OBJECT_COUNT, TEST_SIM_LATENCY_NS / 1000,
+           (TEST_SIM_ITEMS * 1e9) / (batchedTime + 1),
+           (TEST_SIM_ITEMS * 1e9) / (serializedTime + 1));
+
+    CU_ASSERT(batchedTime * 4 < serializedTime);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize test
+
+The function resets the stubs, the event counters and the SDO batch module.
+
+\param  latencyCycles_p     Number of cycles a simulated transfer takes.
+*/
+//------------------------------------------------------------------------------
+static void initTest(UINT latencyCycles_p)
+{
+    sdobatchu_exit();
+    stub_reset(latencyCycles_p);
+    sdobatchu_init(cbItemFinished, cbFinished);
+
+    itemEventCount_l = 0;
+    finishedEventCount_l = 0;
+    pFinishedBatch_l = NULL;
+    appFinishedCount_l = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up a batch item
+
+\param  pItem_p             Pointer to the item.
+\param  nodeId_p            Node ID of the item.
+\param  subindex_p          Sub-index of the item.
+\param  accessType_p        Access type of the item.
+*/
+//------------------------------------------------------------------------------
+static void setupItem(tSdoBatchItem* pItem_p, UINT nodeId_p, UINT subindex_p,
+                      tSdoAccessType accessType_p)
+{
+    UINT32*     pData = &aData_l[pItem_p - aItem_l];
+
+    EPL_MEMSET(pItem_p, 0, sizeof(tSdoBatchItem));
+    *pData = nodeId_p + subindex_p;
+    pItem_p->nodeId = nodeId_p;
+    pItem_p->index = TEST_INDEX;
+    pItem_p->subindex = subindex_p;
+    pItem_p->pData = pData;
+    pItem_p->size = sizeof(UINT32);
+    pItem_p->sdoAccessType = accessType_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up a batch
+
+\param  pBatch_p            Pointer to the batch.
+\param  pItems_p            Pointer to the items of the batch.
+\param  itemCount_p         Number of items.
+*/
+//------------------------------------------------------------------------------
+static void setupBatch(tSdoBatch* pBatch_p, tSdoBatchItem* pItems_p, UINT itemCount_p)
+{
+    EPL_MEMSET(pBatch_p, 0, sizeof(tSdoBatch));
+    pBatch_p->pItems = pItems_p;
+    pBatch_p->itemCount = itemCount_p;
+    pBatch_p->sdoType = kSdoTypeAsnd;
+    pBatch_p->fItemEvents = TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run simulated cycles until a batch is finished
+
+\param  pBatch_p            Pointer to the batch.
+
+\return The function returns the number of simulated cycles.
+*/
+//------------------------------------------------------------------------------
+static UINT runBatch(tSdoBatch* pBatch_p)
+{
+    UINT    startCycle = stub_getCycleCount();
+
+    while (pBatch_p->fActive && ((stub_getCycleCount() - startCycle) < TEST_MAX_CYCLES))
+        stub_processCycle();
+
+    return stub_getCycleCount() - startCycle;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the simulated network until a batch is finished
+
+\param  pBatch_p            Pointer to the batch.
+
+\return The function returns the time the batch took in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 runNetworkBatch(tSdoBatch* pBatch_p)
+{
+    UINT64  startTime = getTimeNs();
+
+    while (pBatch_p->fActive && ((getTimeNs() - startTime) < TEST_SIM_TIMEOUT_NS))
+        stub_processNetwork();
+
+    return getTimeNs() - startTime;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check data of a read item
+
+\param  pItem_p             Pointer to the item.
+
+\return The function returns TRUE if the data matches the simulated object.
+*/
+//------------------------------------------------------------------------------
+static BOOL checkReadData(const tSdoBatchItem* pItem_p)
+{
+    const UINT8*    pData = (const UINT8*)pItem_p->pData;
+    UINT            i;
+
+    for (i = 0; i < pItem_p->size; i++)
+    {
+        if (pData[i] != (UINT8)(pItem_p->nodeId + pItem_p->index + pItem_p->subindex + i))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Callback function for finished items
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbItemFinished(tSdoBatchItem* pItem_p)
+{
+    CU_ASSERT_PTR_NOT_NULL(pItem_p->pBatch);
+    itemEventCount_l++;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Callback function for finished batches
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbFinished(tSdoBatch* pBatch_p)
+{
+    CU_ASSERT_EQUAL(pBatch_p->finishedCount, pBatch_p->itemCount);
+    finishedEventCount_l++;
+    pFinishedBatch_l = pBatch_p;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Callback function for transfers of the application
+
+The function resumes waiting batches like the SDO callback function of the API
+does.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbAppSdoFinished(tSdoComFinished* pSdoComFinished_p)
+{
+    UNUSED_PARAMETER(pSdoComFinished_p);
+
+    appFinishedCount_l++;
+    return sdobatchu_resume();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
@@ -0,0 +1,216 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for SDO command layer unit tests
+
+This file contains all stubs needed by the unit tests of the SDO command layer.
+The timers of the sequence layer are never started, so no retransmission
+happens on the loopback interface. The IdentResponse of the peer contains the
+AsyncMTU which is set by the test, the ASnd transport is not available and
+the OD callback functions of the other stack modules accept every access.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <EplInc.h>
+#include <user/EplTimeru.h>
+#include <user/identu.h>
+#include <user/sdoasnd.h>
+#include <obd.h>
+#include <user/pdou.h>
+#include <user/errhndu.h>
+#include <user/ctrlu.h>
+#include <user/cfmu.h>
+
+#include "test-sdocomu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEplIdentResponse    identResponse_l;
+static UINT                 peerMtu_l = 0;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+void stub_setPeerMtu(UINT mtu_p)
+{
+    peerMtu_l = mtu_p;
+}
+
+tEplKernel identu_getIdentResponse(UINT nodeId_p, tEplIdentResponse** ppIdentResponse_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+
+    if (peerMtu_l == 0)
+    {   // IdentResponse of peer not yet received
+        *ppIdentResponse_p = NULL;
+        return kEplSuccessful;
+    }
+
+    EPL_MEMSET(&identResponse_l, 0, sizeof(identResponse_l));
+    AmiSetWordToLe(&identResponse_l.m_le_wMtu, (WORD)peerMtu_l);
+    *ppIdentResponse_p = &identResponse_l;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplTimeruSetTimerMs(tEplTimerHdl* pTimerHdl_p, unsigned long ulTimeMs_p,
+                                      tEplTimerArg Argument_p)
+{
+    UNUSED_PARAMETER(ulTimeMs_p);
+    UNUSED_PARAMETER(Argument_p);
+    *pTimerHdl_p = 0;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplTimeruModifyTimerMs(tEplTimerHdl* pTimerHdl_p, unsigned long ulTimeMs_p,
+                                         tEplTimerArg Argument_p)
+{
+    UNUSED_PARAMETER(ulTimeMs_p);
+    UNUSED_PARAMETER(Argument_p);
+    *pTimerHdl_p = 0;
+    return kEplSuccessful;
+}
+
+tEplKernel PUBLIC EplTimeruDeleteTimer(tEplTimerHdl* pTimerHdl_p)
+{
+    *pTimerHdl_p = 0;
+    return kEplSuccessful;
+}
+
+tEplKernel sdoasnd_init(tSequLayerReceiveCb pfnReceiveCb_p)
+{
+    UNUSED_PARAMETER(pfnReceiveCb_p);
+    return kEplSuccessful;
+}
+
+tEplKernel sdoasnd_addInstance(tSequLayerReceiveCb pfnReceiveCb_p)
+{
+    UNUSED_PARAMETER(pfnReceiveCb_p);
+    return kEplSuccessful;
+}
+
+tEplKernel sdoasnd_delInstance(void)
+{
+    return kEplSuccessful;
+}
+
+tEplKernel sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
+{
+    UNUSED_PARAMETER(pSdoConHandle_p);
+    UNUSED_PARAMETER(targetNodeId_p);
+    return kEplSdoSeqNoFreeHandle;
+}
+
+tEplKernel sdoasnd_sendData(tSdoConHdl sdoConHandle_p, tEplFrame* pSrcData_p, UINT32 dataSize_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    UNUSED_PARAMETER(pSrcData_p);
+    UNUSED_PARAMETER(dataSize_p);
+    return kEplSdoSeqInvalidHdl;
+}
+
+tEplKernel sdoasnd_deleteCon(tSdoConHdl sdoConHandle_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    return kEplSuccessful;
+}
+
+tEplKernel pdou_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel ctrlu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel errhndu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel errhndu_mnCnLossPresCbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    return kEplSuccessful;
+}
+
+tEplKernel cfmu_cbObdAccess(tObdCbParam MEM* pParam_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    return kEplSuccessful;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
@@ -0,0 +1,540 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for SDO command layer
+
+This file contains the unit test functions for the SDO command layer. The SDO
+server runs in a child process with the object dictionary of the MN and
+provides the ConciseDCF domain object 0x1F22/1 with a size of 1 MB. The SDO client in the test process
+writes to and reads back the domain via UDP on the loopback interface. The
+tests check that segmented transfers are correct for all segment sizes and
+compare the throughput of the default segment size with the segment size
+derived from the AsyncMTU of the peer.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <obd.h>
+#include <sdo.h>
+#include <EplSdoAc.h>
+#include <user/EplSdoComu.h>
+#include <user/sdoudp.h>
+
+#include "test-sdocomu.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_DOMAIN_INDEX           0x1F22      // CFM_ConciseDcfList_ADOM
+#define TEST_DOMAIN_SUBINDEX        0x01
+#define TEST_DOMAIN_SIZE            (1024 * 1024)
+#define TEST_SERVER_NODE_ID         2
+#define TEST_SERVER_IP_ADDR         (0x7F000000 | TEST_SERVER_NODE_ID)  // 127.0.0.2
+#define TEST_CLIENT_IP_ADDR         0x7F000001                          // 127.0.0.1
+#define TEST_CLIENT_PORT            (EPL_C_SDO_EPL_PORT + 1)
+#define TEST_TRANSFER_TIMEOUT_MS    30000
+#define TEST_CONNECT_TIMEOUT_MS     1000
+#define TEST_CONNECT_RETRIES        5
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tEplKernel initStack(ULONG ipAddr_p, UINT port_p);
+static void exitStack(void);
+static void runServer(int syncFd_p, int readyFd_p);
+static tEplKernel connectServer(void);
+static tEplKernel transferDomain(tSdoAccessType accessType_p, BYTE* pData_p, UINT size_p);
+static tEplKernel transfer(UINT index_p, UINT subindex_p, tSdoAccessType accessType_p,
+                           BYTE* pData_p, UINT size_p, UINT timeoutMs_p);
+static tEplKernel cbTransferFinished(tSdoComFinished* pSdoComFinished_p);
+static void fillPattern(BYTE* pData_p, UINT size_p, UINT seed_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdInitParam            initParam_l;
+static pid_t                    serverPid_l = -1;
+static int                      serverSyncFd_l = -1;
+static tSdoComConHdl            sdoComConHdl_l;
+static volatile BOOL            fTransferFinished_l;
+static tSdoComFinished          transferResult_l;
+static BYTE                     aDomain_l[TEST_DOMAIN_SIZE];
+static BYTE                     aWriteData_l[TEST_DOMAIN_SIZE];
+static BYTE                     aReadData_l[TEST_DOMAIN_SIZE];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start SDO server
+
+The function forks the SDO server process and initializes the SDO client in
+the test process. The client moves its socket to the port TEST_CLIENT_PORT
+before the server is allowed to bind the default SDO port. The connection to
+the server is established once and used by all tests.
+
+\return The function returns 0 if the server is ready, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+int test_sdocomu_initServer(void)
+{
+    int                 aSyncPipe[2];
+    int                 aReadyPipe[2];
+    char                sync = 0;
+
+    if ((pipe(aSyncPipe) != 0) || (pipe(aReadyPipe) != 0))
+        return -1;
+
+    serverPid_l = fork();
+    if (serverPid_l < 0)
+        return -1;
+
+    if (serverPid_l == 0)
+    {
+        close(aSyncPipe[1]);
+        close(aReadyPipe[0]);
+        runServer(aSyncPipe[0], aReadyPipe[1]);
+        _exit(0);
+    }
+
+    close(aSyncPipe[0]);
+    close(aReadyPipe[1]);
+    serverSyncFd_l = aSyncPipe[1];
+
+    if (initStack(TEST_CLIENT_IP_ADDR, TEST_CLIENT_PORT) != kEplSuccessful)
+        return -1;
+
+    if ((write(serverSyncFd_l, &sync, 1) != 1) ||
+        (read(aReadyPipe[0], &sync, 1) != 1))
+    {
+        close(aReadyPipe[0]);
+        return -1;
+    }
+
+    close(aReadyPipe[0]);
+    return (connectServer() == kEplSuccessful) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stop SDO server
+
+The function shuts down the SDO client and terminates the SDO server process.
+*/
+//------------------------------------------------------------------------------
+void test_sdocomu_exitServer(void)
+{
+    if (serverSyncFd_l >= 0)
+    {
+        close(serverSyncFd_l);
+        serverSyncFd_l = -1;
+    }
+
+    if (serverPid_l > 0)
+    {
+        EplSdoComUndefineCon(sdoComConHdl_l);
+        waitpid(serverPid_l, NULL, 0);
+        serverPid_l = -1;
+        exitStack();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test segmented domain write via UDP
+
+The function writes the domain of the server with the default segment size
+(AsyncMTU of peer unknown), with the maximum segment size (AsyncMTU of peer
+1500) and with a segment size limited by a smaller AsyncMTU of the peer. The
+domain is read back after each write and compared with the written data.
+*/
+//------------------------------------------------------------------------------
+void test_sdocomu_domainWriteUdp(void)
+{
+    static const UINT   aPeerMtu[] = {0, EPL_C_DLL_MAX_ASYNC_MTU, 600};
+    UINT                i;
+
+    for (i = 0; i < tabentries(aPeerMtu); i++)
+    {
+        stub_setPeerMtu(aPeerMtu[i]);
+        fillPattern(aWriteData_l, TEST_DOMAIN_SIZE, i + 1);
+        EPL_MEMSET(aReadData_l, 0, TEST_DOMAIN_SIZE);
+
+        CU_ASSERT_EQUAL(transferDomain(kSdoAccessTypeWrite, aWriteData_l, TEST_DOMAIN_SIZE),
+                        kEplSuccessful);
+        CU_ASSERT_EQUAL(transferDomain(kSdoAccessTypeRead, aReadData_l, TEST_DOMAIN_SIZE),
+                        kEplSuccessful);
+        CU_ASSERT_EQUAL(memcmp(aReadData_l, aWriteData_l, TEST_DOMAIN_SIZE), 0);
+    }
+
+    stub_setPeerMtu(0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark 1 MB domain write via UDP
+
+The function measures the end-to-end throughput of writing 1 MB to the domain
+of the server with the default segment size and with the segment size derived
+from the AsyncMTU of the peer.
+*/
+//------------------------------------------------------------------------------
+void test_sdocomu_domainWriteUdpBenchmark(void)
+{
+    UINT64              startTime;
+    UINT64              defaultDuration;
+    UINT64              mtuDuration;
+
+    fillPattern(aWriteData_l, TEST_DOMAIN_SIZE, 0);
+
+    stub_setPeerMtu(0);
+    startTime = getTimeNs();
+    CU_ASSERT_EQUAL(transferDomain(kSdoAccessTypeWrite, aWriteData_l, TEST_DOMAIN_SIZE),
+                    kEplSuccessful);
+    defaultDuration = getTimeNs() - startTime;
+
+    stub_setPeerMtu(EPL_C_DLL_MAX_ASYNC_MTU);
+    startTime = getTimeNs();
+    CU_ASSERT_EQUAL(transferDomain(kSdoAccessTypeWrite, aWriteData_l, TEST_DOMAIN_SIZE),
+                    kEplSuccessful);
+    mtuDuration = getTimeNs() - startTime;
+
+    stub_setPeerMtu(0);
+
+    CU_ASSERT_TRUE(mtuDuration < defaultDuration);
+    printf("\n    write of %u bytes via UDP loopback\n", TEST_DOMAIN_SIZE);
+    printf("    %4u byte segments: %8.1f ms, %6.1f MB/s\n", SDO_DEFAULT_SEGMENT_SIZE,
+           defaultDuration / 1e6, TEST_DOMAIN_SIZE * 1e3 / (double)defaultDuration);
+    printf("    %4u byte segments: %8.1f ms, %6.1f MB/s\n",
+           min(EPL_C_DLL_MAX_ASYNC_MTU - SDO_SEGMENT_HEADER_SIZE, SDO_MAX_SEGMENT_SIZE),
+           mtuDuration / 1e6, TEST_DOMAIN_SIZE * 1e3 / (double)mtuDuration);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize SDO stack
+
+The function creates the object dictionary of the MN, initializes the SDO
+command layer and binds the UDP socket to the specified address.
+
+\param  ipAddr_p            Local IP address in host byte order.
+\param  port_p              Local UDP port (0 = default SDO port).
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel initStack(ULONG ipAddr_p, UINT port_p)
+{
+    tEplKernel          ret;
+
+    ret = obd_initObd(&initParam_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = obd_init(&initParam_l);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    ret = EplSdoComInit();
+    if (ret != kEplSuccessful)
+        return ret;
+
+    return sdoudp_config(ipAddr_p, port_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up SDO stack
+
+The function shuts down the SDO command layer and deletes the object
+dictionary.
+*/
+//------------------------------------------------------------------------------
+static void exitStack(void)
+{
+    EplSdoComDelInstance();
+    obd_deleteInstance();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run SDO server
+
+The function runs in the server process. It waits until the client has
+released the default SDO port, initializes the SDO stack, links the domain
+and serves SDO transfers until the client closes the sync pipe.
+
+\param  syncFd_p            Read end of the sync pipe.
+\param  readyFd_p           Write end of the ready pipe.
+*/
+//------------------------------------------------------------------------------
+static void runServer(int syncFd_p, int readyFd_p)
+{
+    tVarParam           varParam;
+    char                sync = 0;
+
+    if (read(syncFd_p, &sync, 1) != 1)
+        return;
+
+    if (initStack(TEST_SERVER_IP_ADDR, 0) != kEplSuccessful)
+        return;
+
+    varParam.validFlag = kVarValidAll;
+    varParam.index = TEST_DOMAIN_INDEX;
+    varParam.subindex = TEST_DOMAIN_SUBINDEX;
+    varParam.size = TEST_DOMAIN_SIZE;
+    varParam.pData = aDomain_l;
+    if (obd_defineVar(&varParam) != kEplSuccessful)
+    {
+        exitStack();
+        return;
+    }
+
+    if (write(readyFd_p, &sync, 1) == 1)
+    {
+        // transfers are processed by the UDP receive thread
+        while (read(syncFd_p, &sync, 1) > 0)
+            ;
+    }
+
+    exitStack();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Connect to SDO server
+
+The function defines the SDO connection to the server and reads the device
+type to establish the connection. The SDO connection is initialized from the
+test thread while the answers are processed by the UDP receive thread, so the
+first initialization may get lost. In this case the connection is defined
+again.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel connectServer(void)
+{
+    tEplKernel          ret = kEplSuccessful;
+    UINT32              deviceType;
+    UINT                retry;
+
+    for (retry = 0; retry < TEST_CONNECT_RETRIES; retry++)
+    {
+        ret = EplSdoComDefineCon(&sdoComConHdl_l, TEST_SERVER_NODE_ID, kSdoTypeUdp);
+        if (ret != kEplSuccessful)
+            return ret;
+
+        ret = transfer(0x1000, 0x00, kSdoAccessTypeRead, (BYTE*)&deviceType,
+                       sizeof(deviceType), TEST_CONNECT_TIMEOUT_MS);
+        if (ret == kEplSuccessful)
+            return ret;
+
+        EplSdoComUndefineCon(sdoComConHdl_l);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Transfer domain
+
+The function reads or writes the domain of the server.
+
+\param  accessType_p        SDO access type.
+\param  pData_p             Pointer to the data buffer.
+\param  size_p              Size of the data buffer.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel transferDomain(tSdoAccessType accessType_p, BYTE* pData_p, UINT size_p)
+{
+    return transfer(TEST_DOMAIN_INDEX, TEST_DOMAIN_SUBINDEX, accessType_p, pData_p,
+                    size_p, TEST_TRANSFER_TIMEOUT_MS);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Transfer object
+
+The function reads or writes an object of the server and waits until the
+transfer is finished.
+
+\param  index_p             Index of the object.
+\param  subindex_p          Sub-index of the object.
+\param  accessType_p        SDO access type.
+\param  pData_p             Pointer to the data buffer.
+\param  size_p              Size of the data buffer.
+\param  timeoutMs_p         Timeout of the transfer in milliseconds.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel transfer(UINT index_p, UINT subindex_p, tSdoAccessType accessType_p,
+                           BYTE* pData_p, UINT size_p, UINT timeoutMs_p)
+{
+    tEplKernel                  ret;
+    tSdoComTransParamByIndex    transParam;
+    struct timespec             sleepTime = {0, 1000000};
+    UINT                        waitTime;
+
+    EPL_MEMSET(&transParam, 0, sizeof(transParam));
+    transParam.sdoComConHdl = sdoComConHdl_l;
+    transParam.index = index_p;
+    transParam.subindex = subindex_p;
+    transParam.pData = pData_p;
+    transParam.dataSize = size_p;
+    transParam.sdoAccessType = accessType_p;
+    transParam.pfnSdoFinishedCb = cbTransferFinished;
+
+    fTransferFinished_l = FALSE;
+    ret = EplSdoComInitTransferByIndex(&transParam);
+    if (ret != kEplSuccessful)
+        return ret;
+
+    for (waitTime = 0; !fTransferFinished_l && (waitTime < timeoutMs_p); waitTime++)
+        nanosleep(&sleepTime, NULL);
+
+    if (!fTransferFinished_l)
+    {
+        EplSdoComSdoAbort(sdoComConHdl_l, EPL_SDOAC_TIME_OUT);
+        return kEplGeneralError;
+    }
+
+    if ((transferResult_l.sdoComConState != kEplSdoComTransferFinished) ||
+        (transferResult_l.abortCode != 0) ||
+        (transferResult_l.transferredBytes != size_p))
+        return kEplGeneralError;
+
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  SDO transfer finished callback
+
+The function is called by the SDO command layer in the context of the UDP
+receive thread if a transfer is finished.
+
+\param  pSdoComFinished_p   Result of the transfer.
+
+\return The function returns kEplSuccessful.
+*/
+//------------------------------------------------------------------------------
+static tEplKernel cbTransferFinished(tSdoComFinished* pSdoComFinished_p)
+{
+    transferResult_l = *pSdoComFinished_p;
+    __sync_synchronize();
+    fTransferFinished_l = TRUE;
+    return kEplSuccessful;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill buffer with test pattern
+
+\param  pData_p             Pointer to the buffer.
+\param  size_p              Size of the buffer.
+\param  seed_p              Seed of the pattern.
+*/
+//------------------------------------------------------------------------------
+static void fillPattern(BYTE* pData_p, UINT size_p, UINT seed_p)
+{
+    UINT                i;
+
+    for (i = 0; i < size_p; i++)
+        pData_p[i] = (BYTE)((i * 7) + (i >> 8) + seed_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get time in nanoseconds
+
+\return The function returns the monotonic time in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}
+
+/// \}
@@ -0,0 +1,646 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for shared memory ring library
+
+This file contains the unit test functions for the shared memory ring library.
+Besides the basic ring operations, the tests run the event ring and the
+asynchronous TX frame ring of the Linux kernel module against a userspace
+stand-in of the kernel module which uses the same ring code.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <event.h>
+#include <shmring.h>
+
+#include "test-shmring.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_RING_SIZE              0x10000     ///< Size of the rings of the stand-in tests
+#define TEST_SMALL_RING_SIZE        (sizeof(tShmRingHeader) + 256)
+#define TEST_EVENT_COUNT            100000
+#define TEST_MAX_EVENT_ARG          200
+#define TEST_PRODUCER_COUNT         4
+#define TEST_FRAMES_PER_PRODUCER    25000
+#define TEST_MAX_FRAME_SIZE         1500
+#define TEST_MIN_FRAME_SIZE         60
+#define TEST_WAIT_TIMEOUT_MS        500
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Stand-in for the kernel module
+
+The structure replaces the kernel module for the ring tests. The event ring is
+filled by a kernel thread and read by the user layer which waits for events
+like the PLK_CMD_WAIT_EVENT ioctl does. The async ring is filled by several
+user threads and processed synchronously in the signal function like the
+PLK_CMD_DLLCAL_ASYNCRING_SIGNAL ioctl does.
+*/
+typedef struct
+{
+    UINT64              aRingMem[TEST_RING_SIZE / sizeof(UINT64)];
+    tShmRingInstance    kernelRing;         ///< View of the kernel on the ring
+    tShmRingInstance    userRing;           ///< View of the user layer on the ring
+    pthread_mutex_t     mutex;              ///< Wait queue lock (event) or ioctl lock (async)
+    pthread_cond_t      cond;               ///< Wait queue of the event ring
+    pthread_mutex_t     producerMutex;      ///< Serializes the user producers of the async ring
+    UINT                waitCount;          ///< Number of wait calls of the user layer
+    UINT                signalCount;        ///< Number of signal calls of the user layer
+    UINT                aRxCount[TEST_PRODUCER_COUNT];
+    UINT                errorCount;
+} tKernelStandIn;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void     initStandIn(tKernelStandIn* pStandIn_p);
+static void     exitStandIn(tKernelStandIn* pStandIn_p);
+static UINT     getEventArgSize(UINT seq_p);
+static UINT     getFrameSize(UINT producer_p, UINT seq_p);
+static void*    eventProducerThread(void* pArg_p);
+static void     waitEvent(tKernelStandIn* pStandIn_p);
+static void*    asyncProducerThread(void* pArg_p);
+static void     signalAsyncRing(tKernelStandIn* pStandIn_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tKernelStandIn   standIn_l;
+static UINT64           aSmallRingMem_l[TEST_SMALL_RING_SIZE / sizeof(UINT64)];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test writing and reading entries
+
+The test writes entries through one instance of a ring and reads them through
+a second instance connected to the same memory.
+*/
+//------------------------------------------------------------------------------
+void test_shmring_readWrite(void)
+{
+    tShmRingInstance    producer;
+    tShmRingInstance    consumer;
+    BYTE                aData[64];
+    BYTE                aRead[64];
+    size_t              readSize;
+    void*               pEntry;
+    UINT                i;
+
+    for (i = 0; i < sizeof(aData); i++)
+        aData[i] = (BYTE)i;
+
+    CU_ASSERT_EQUAL(shmring_connect(&consumer, aSmallRingMem_l, sizeof(aSmallRingMem_l)), kShmRingCorrupted);
+    CU_ASSERT_EQUAL(shmring_init(&producer, aSmallRingMem_l, sizeof(tShmRingHeader)), kShmRingInvalidArg);
+    CU_ASSERT_EQUAL(shmring_init(&producer, aSmallRingMem_l, sizeof(aSmallRingMem_l)), kShmRingOk);
+    CU_ASSERT_EQUAL(shmring_connect(&consumer, aSmallRingMem_l, sizeof(aSmallRingMem_l)), kShmRingOk);
+    CU_ASSERT_EQUAL(consumer.dataSize, 256);
+
+    CU_ASSERT_TRUE(shmring_isEmpty(&consumer));
+    CU_ASSERT_EQUAL(shmring_readData(&consumer, aRead, sizeof(aRead), &readSize), kShmRingNoReadableData);
+
+    CU_ASSERT_EQUAL(shmring_writeData(&producer, aData, 13), kShmRingOk);
+    CU_ASSERT_EQUAL(shmring_writeMultipleData(&producer, aData, 4, aData + 4, 20), kShmRingOk);
+    CU_ASSERT_EQUAL(shmring_writeData(&producer, NULL, 0), kShmRingOk);
+    CU_ASSERT_FALSE(shmring_isEmpty(&consumer));
+
+    CU_ASSERT_EQUAL(shmring_readData(&consumer, aRead, 12, &readSize), kShmRingReadsizeTooSmall);
+    CU_ASSERT_EQUAL(shmring_readData(&consumer, aRead, sizeof(aRead), &readSize), kShmRingOk);
+    CU_ASSERT_EQUAL(readSize, 13);
+    CU_ASSERT_EQUAL(memcmp(aRead, aData, 13), 0);
+
+    CU_ASSERT_EQUAL(shmring_peekData(&consumer, &pEntry, &readSize), kShmRingOk);
+    CU_ASSERT_EQUAL(readSize, 24);
+    CU_ASSERT_EQUAL(memcmp(pEntry, aData, 24), 0);
+    shmring_releaseData(&consumer);
+
+    CU_ASSERT_EQUAL(shmring_readData(&consumer, aRead, sizeof(aRead), &readSize), kShmRingOk);
+    CU_ASSERT_EQUAL(readSize, 0);
+    CU_ASSERT_TRUE(shmring_isEmpty(&consumer));
+
+    shmring_writeData(&producer, aData, 1);
+    shmring_reset(&producer);
+    CU_ASSERT_TRUE(shmring_isEmpty(&consumer));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test wrap around
+
+The test writes entries of changing sizes into a small ring. The entries which
+do not fit into the remaining space at the end of the data area must be stored
+at the beginning without being split.
+*/
+//------------------------------------------------------------------------------
+void test_shmring_wrap(void)
+{
+    tShmRingInstance    ring;
+    BYTE                aData[100];
+    BYTE                aRead[100];
+    size_t              readSize;
+    void*               pEntry;
+    UINT                i;
+    UINT                size;
+
+    CU_ASSERT_EQUAL_FATAL(shmring_init(&ring, aSmallRingMem_l, sizeof(aSmallRingMem_l)), kShmRingOk);
+
+    for (i = 0; i < 1000; i++)
+    {
+        size = 1 + ((i * 37) % sizeof(aData));
+        memset(aData, (BYTE)i, size);
+
+        CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, size), kShmRingOk);
+        if ((i % 2) == 0)
+        {
+            CU_ASSERT_EQUAL(shmring_peekData(&ring, &pEntry, &readSize), kShmRingOk);
+            CU_ASSERT_EQUAL(readSize, size);
+            CU_ASSERT_PTR_NOT_NULL(pEntry);
+            CU_ASSERT((BYTE*)pEntry + readSize <= ring.pData + ring.dataSize);
+            CU_ASSERT_EQUAL(memcmp(pEntry, aData, size), 0);
+            shmring_releaseData(&ring);
+        }
+        else
+        {
+            CU_ASSERT_EQUAL(shmring_readData(&ring, aRead, sizeof(aRead), &readSize), kShmRingOk);
+            CU_ASSERT_EQUAL(readSize, size);
+            CU_ASSERT_EQUAL(memcmp(aRead, aData, size), 0);
+        }
+        CU_ASSERT_TRUE(shmring_isEmpty(&ring));
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test full ring
+
+The test fills a ring until it is full and checks that entries which never fit
+into the ring are rejected.
+*/
+//------------------------------------------------------------------------------
+void test_shmring_full(void)
+{
+    tShmRingInstance    ring;
+    BYTE                aData[256];
+    size_t              readSize;
+    UINT                count = 0;
+
+    memset(aData, 0xA5, sizeof(aData));
+    CU_ASSERT_EQUAL_FATAL(shmring_init(&ring, aSmallRingMem_l, sizeof(aSmallRingMem_l)), kShmRingOk);
+
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, 256), kShmRingExceedDataSizeLimit);
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, 245), kShmRingExceedDataSizeLimit);
+
+    // entries with 28 bytes of data occupy 32 bytes, one block stays free
+    while (shmring_writeData(&ring, aData, 28) == kShmRingOk)
+        count++;
+    CU_ASSERT_EQUAL(count, 7);
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, 28), kShmRingBufferFull);
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, 20), kShmRingOk);
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, NULL, 0), kShmRingBufferFull);
+
+    // a wrapped entry also occupies the skipped space at the end of the data area
+    CU_ASSERT_EQUAL(shmring_readData(&ring, aData, sizeof(aData), &readSize), kShmRingOk);
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, 28), kShmRingBufferFull);
+    CU_ASSERT_EQUAL(shmring_readData(&ring, aData, sizeof(aData), &readSize), kShmRingOk);
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, 28), kShmRingOk);
+    CU_ASSERT_EQUAL(shmring_writeData(&ring, aData, 28), kShmRingBufferFull);
+
+    count = 0;
+    while (shmring_readData(&ring, aData, sizeof(aData), &readSize) == kShmRingOk)
+        count++;
+    CU_ASSERT_EQUAL(count, 7);
+    CU_ASSERT_TRUE(shmring_isEmpty(&ring));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test coalescing of consumer signals
+
+The test checks that only the first producer after the consumer cleared the
+signal pending flag has to signal the consumer.
+*/
+//------------------------------------------------------------------------------
+void test_shmring_signal(void)
+{
+    tShmRingInstance    ring;
+
+    CU_ASSERT_EQUAL_FATAL(shmring_init(&ring, aSmallRingMem_l, sizeof(aSmallRingMem_l)), kShmRingOk);
+
+    CU_ASSERT_TRUE(shmring_setSignalPending(&ring));
+    CU_ASSERT_FALSE(shmring_setSignalPending(&ring));
+    CU_ASSERT_FALSE(shmring_setSignalPending(&ring));
+    shmring_clearSignalPending(&ring);
+    CU_ASSERT_TRUE(shmring_setSignalPending(&ring));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test event ring
+
+A kernel stand-in thread posts events with arguments of changing sizes into
+the event ring while the user layer reads them in the same way as the event
+thread of the user event CAL module. The user layer only waits if the ring is
+empty.
+*/
+//------------------------------------------------------------------------------
+void test_shmring_eventRing(void)
+{
+    pthread_t       producer;
+    tEplEvent*      pEvent;
+    BYTE            aEventBuf[sizeof(tEplEvent) + TEST_MAX_EVENT_ARG];
+    tShmRingError   ringError;
+    size_t          readSize;
+    UINT            seq = 0;
+    UINT            argSize;
+    UINT            i;
+
+    initStandIn(&standIn_l);
+    CU_ASSERT_EQUAL_FATAL(pthread_create(&producer, NULL, eventProducerThread, &standIn_l), 0);
+
+    pEvent = (tEplEvent*)aEventBuf;
+    while (seq < TEST_EVENT_COUNT)
+    {
+        ringError = shmring_readData(&standIn_l.userRing, aEventBuf, sizeof(aEventBuf), &readSize);
+        if (ringError == kShmRingNoReadableData)
+        {
+            waitEvent(&standIn_l);
+            continue;
+        }
+
+        if (ringError != kShmRingOk)
+        {
+            standIn_l.errorCount++;
+            break;
+        }
+
+        argSize = getEventArgSize(seq);
+        if ((pEvent->m_uiSize != argSize) || (readSize != sizeof(tEplEvent) + argSize) ||
+            (pEvent->m_EventType != (tEplEventType)(seq & 0xFF)))
+            standIn_l.errorCount++;
+
+        pEvent->m_pArg = aEventBuf + sizeof(tEplEvent);
+        for (i = 0; i < argSize; i++)
+        {
+            if (((BYTE*)pEvent->m_pArg)[i] != (BYTE)(seq + i))
+            {
+                standIn_l.errorCount++;
+                break;
+            }
+        }
+        seq++;
+    }
+
+    pthread_join(producer, NULL);
+
+    CU_ASSERT_EQUAL(seq, TEST_EVENT_COUNT);
+    CU_ASSERT_EQUAL(standIn_l.errorCount, 0);
+    CU_ASSERT_TRUE(shmring_isEmpty(&standIn_l.userRing));
+    // the user layer must not wait for every single event
+    CU_ASSERT(standIn_l.waitCount < TEST_EVENT_COUNT);
+
+    exitStandIn(&standIn_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test async ring
+
+Several user threads write frames into the async ring and signal the kernel
+stand-in only if the signal pending flag was not already set. The kernel
+stand-in processes all frames in the signal call. After all producers have
+finished, no frame may be left in the ring.
+*/
+//------------------------------------------------------------------------------
+void test_shmring_asyncRing(void)
+{
+    pthread_t       aProducer[TEST_PRODUCER_COUNT];
+    UINT            i;
+
+    initStandIn(&standIn_l);
+
+    for (i = 0; i < TEST_PRODUCER_COUNT; i++)
+    {
+        CU_ASSERT_EQUAL_FATAL(pthread_create(&aProducer[i], NULL, asyncProducerThread,
+                                             (void*)(size_t)i), 0);
+    }
+
+    for (i = 0; i < TEST_PRODUCER_COUNT; i++)
+        pthread_join(aProducer[i], NULL);
+
+    CU_ASSERT_EQUAL(standIn_l.errorCount, 0);
+    CU_ASSERT_TRUE(shmring_isEmpty(&standIn_l.kernelRing));
+    for (i = 0; i < TEST_PRODUCER_COUNT; i++)
+        CU_ASSERT_EQUAL(standIn_l.aRxCount[i], TEST_FRAMES_PER_PRODUCER);
+    CU_ASSERT(standIn_l.signalCount <= TEST_PRODUCER_COUNT * TEST_FRAMES_PER_PRODUCER);
+
+    exitStandIn(&standIn_l);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the kernel stand-in
+
+The function initializes the ring in the memory of the kernel stand-in and
+connects the user view to it.
+
+\param  pStandIn_p          Pointer to the kernel stand-in.
+*/
+//------------------------------------------------------------------------------
+static void initStandIn(tKernelStandIn* pStandIn_p)
+{
+    memset(pStandIn_p, 0, sizeof(tKernelStandIn));
+    pthread_mutex_init(&pStandIn_p->mutex, NULL);
+    pthread_cond_init(&pStandIn_p->cond, NULL);
+    pthread_mutex_init(&pStandIn_p->producerMutex, NULL);
+
+    shmring_init(&pStandIn_p->kernelRing, pStandIn_p->aRingMem, sizeof(pStandIn_p->aRingMem));
+    shmring_connect(&pStandIn_p->userRing, pStandIn_p->aRingMem, sizeof(pStandIn_p->aRingMem));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cleanup the kernel stand-in
+
+\param  pStandIn_p          Pointer to the kernel stand-in.
+*/
+//------------------------------------------------------------------------------
+static void exitStandIn(tKernelStandIn* pStandIn_p)
+{
+    pthread_mutex_destroy(&pStandIn_p->producerMutex);
+    pthread_cond_destroy(&pStandIn_p->cond);
+    pthread_mutex_destroy(&pStandIn_p->mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the argument size of an event
+
+\param  seq_p               Sequence number of the event.
+
+\return The function returns the argument size of the event.
+*/
+//------------------------------------------------------------------------------
+static UINT getEventArgSize(UINT seq_p)
+{
+    return (seq_p * 7) % (TEST_MAX_EVENT_ARG + 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the size of a frame
+
+\param  producer_p          Number of the producer of the frame.
+\param  seq_p               Sequence number of the frame.
+
+\return The function returns the size of the frame.
+*/
+//------------------------------------------------------------------------------
+static UINT getFrameSize(UINT producer_p, UINT seq_p)
+{
+    return TEST_MIN_FRAME_SIZE +
+           ((seq_p * 13 + producer_p * 101) % (TEST_MAX_FRAME_SIZE - TEST_MIN_FRAME_SIZE + 1));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Event producer thread of the kernel stand-in
+
+The thread posts events in the same way as the kernel event CAL module. If the
+ring is full, it retries after a short delay.
+
+\param  pArg_p              Pointer to the kernel stand-in.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* eventProducerThread(void* pArg_p)
+{
+    tKernelStandIn*     pStandIn = (tKernelStandIn*)pArg_p;
+    tEplEvent           event;
+    BYTE                aArg[TEST_MAX_EVENT_ARG];
+    struct timespec     delay = {0, 10000};
+    tShmRingError       ringError;
+    UINT                seq;
+    UINT                i;
+
+    for (seq = 0; seq < TEST_EVENT_COUNT; seq++)
+    {
+        memset(&event, 0, sizeof(event));
+        event.m_EventType = (tEplEventType)(seq & 0xFF);
+        event.m_uiSize = getEventArgSize(seq);
+        for (i = 0; i < event.m_uiSize; i++)
+            aArg[i] = (BYTE)(seq + i);
+        event.m_pArg = aArg;
+
+        while ((ringError = shmring_writeMultipleData(&pStandIn->kernelRing, &event, sizeof(tEplEvent),
+                                                      event.m_pArg, event.m_uiSize)) == kShmRingBufferFull)
+            nanosleep(&delay, NULL);
+
+        if (ringError != kShmRingOk)
+        {
+            pStandIn->errorCount++;
+            break;
+        }
+
+        // wake up the user layer like wake_up_interruptible()
+        pthread_mutex_lock(&pStandIn->mutex);
+        pthread_cond_signal(&pStandIn->cond);
+        pthread_mutex_unlock(&pStandIn->mutex);
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for events
+
+The function implements the wait ioctl of the kernel stand-in. Like
+wait_event_interruptible_timeout() it evaluates the ring state under the lock
+of the wait queue, so a wake up can't get lost.
+
+\param  pStandIn_p          Pointer to the kernel stand-in.
+*/
+//------------------------------------------------------------------------------
+static void waitEvent(tKernelStandIn* pStandIn_p)
+{
+    struct timespec     timeout;
+
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_nsec += TEST_WAIT_TIMEOUT_MS * 1000000L;
+    timeout.tv_sec += timeout.tv_nsec / 1000000000L;
+    timeout.tv_nsec %= 1000000000L;
+
+    pthread_mutex_lock(&pStandIn_p->mutex);
+    pStandIn_p->waitCount++;
+    while (shmring_isEmpty(&pStandIn_p->kernelRing))
+    {
+        if (pthread_cond_timedwait(&pStandIn_p->cond, &pStandIn_p->mutex, &timeout) != 0)
+            break;
+    }
+    pthread_mutex_unlock(&pStandIn_p->mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Async frame producer thread
+
+The thread sends frames in the same way as the user DLL CAL module.
+
+\param  pArg_p              Number of the producer.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* asyncProducerThread(void* pArg_p)
+{
+    UINT                producer = (UINT)(size_t)pArg_p;
+    BYTE                aFrame[TEST_MAX_FRAME_SIZE];
+    struct timespec     delay = {0, 10000};
+    tShmRingError       ringError;
+    UINT                seq;
+    UINT                size;
+
+    for (seq = 0; seq < TEST_FRAMES_PER_PRODUCER; seq++)
+    {
+        size = getFrameSize(producer, seq);
+        memset(aFrame, (BYTE)seq, size);
+        aFrame[0] = (BYTE)producer;
+        memcpy(&aFrame[4], &seq, sizeof(seq));
+
+        do
+        {
+            pthread_mutex_lock(&standIn_l.producerMutex);
+            ringError = shmring_writeData(&standIn_l.userRing, aFrame, size);
+            pthread_mutex_unlock(&standIn_l.producerMutex);
+            if (ringError == kShmRingBufferFull)
+                nanosleep(&delay, NULL);
+        } while (ringError == kShmRingBufferFull);
+
+        if (ringError != kShmRingOk)
+        {
+            standIn_l.errorCount++;
+            break;
+        }
+
+        if (shmring_setSignalPending(&standIn_l.userRing))
+            signalAsyncRing(&standIn_l);
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the async ring
+
+The function implements the signal ioctl of the kernel stand-in. It processes
+all frames of the ring in the context of the calling thread and checks that
+the frames of every producer are received in order.
+
+\param  pStandIn_p          Pointer to the kernel stand-in.
+*/
+//------------------------------------------------------------------------------
+static void signalAsyncRing(tKernelStandIn* pStandIn_p)
+{
+    BYTE*       pFrame;
+    size_t      size;
+    UINT        producer;
+    UINT        seq;
+
+    pthread_mutex_lock(&pStandIn_p->mutex);
+    pStandIn_p->signalCount++;
+
+    shmring_clearSignalPending(&pStandIn_p->kernelRing);
+    while (shmring_peekData(&pStandIn_p->kernelRing, (void**)&pFrame, &size) == kShmRingOk)
+    {
+        producer = pFrame[0];
+        memcpy(&seq, &pFrame[4], sizeof(seq));
+        if ((producer >= TEST_PRODUCER_COUNT) || (seq != pStandIn_p->aRxCount[producer]) ||
+            (size != getFrameSize(producer, seq)) || (pFrame[size - 1] != (BYTE)seq))
+        {
+            pStandIn_p->errorCount++;
+        }
+        else
+        {
+            pStandIn_p->aRxCount[producer]++;
+        }
+        shmring_releaseData(&pStandIn_p->kernelRing);
+    }
+
+    pthread_mutex_unlock(&pStandIn_p->mutex);
+}
+
+/// \}
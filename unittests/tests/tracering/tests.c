@@ -0,0 +1,410 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for trace ring library
+
+This file contains the unit test functions for the trace ring library. They
+check the formatting of recorded messages, the handling of several threads
+and full rings and measure the duration of trace().
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2013, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <time.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <CUnit/CUnit.h>
+
+#include <EplInc.h>
+#include <trace-ring.h>
+
+#include "test-tracering.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_THREAD_COUNT           4
+#define TEST_THREAD_MESSAGES        100         // fits into the ring of a thread
+#define TEST_BENCH_BATCH            200
+#define TEST_BENCH_ROUNDS           500
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void startCapture(void);
+static char* stopCapture(void);
+static void* traceThread(void* pArg_p);
+static UINT64 getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static FILE*                pCapture_l = NULL;
+static char*                pCaptureBuffer_l = NULL;
+static size_t               captureSize_l = 0;
+static pthread_barrier_t    threadBarrier_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test formatting of recorded messages
+
+The function records messages with different conversion specifications and
+checks that the reader formats them like printf().
+*/
+//------------------------------------------------------------------------------
+void test_tracering_format(void)
+{
+    char*       pszOutput;
+    char        szExpected[512];
+    void*       pPointer = &pszOutput;
+
+    startCapture();
+    trace("plain text\n");
+    trace("int %d %i %u %x %X %o %c|\n", -5, 42, 3000000000U, 0xBEEF, 0xCAFE, 8, 'z');
+    trace("long %ld %lu %lld %llx %hd %hhu|\n", -70000L, 80000UL, -1234567890123LL,
+          0x123456789ABCULL, (short)-3, (unsigned char)200);
+    trace("size %zu %zd %jd %td|\n", (size_t)1234, (ssize_t)-17, (intmax_t)-99, (ptrdiff_t)-5);
+    trace("float %f %.2f %e %g %10.3Lf|\n", 1.5, 3.14159, 12345.678, 0.0001, (long double)2.25);
+    trace("width %5d|%-5d|%05d|%*d|%.*s|%%|\n", 12, 34, 56, 6, 78, 3, "abcdef");
+    trace("str %s %10s %-6s %s|\n", "hello", "right", "left", (char*)NULL);
+    trace("ptr %p|\n", pPointer);
+    trace("args %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
+          1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14);
+    tracering_flush();
+    pszOutput = stopCapture();
+
+    snprintf(szExpected, sizeof(szExpected),
+             "plain text\n"
+             "int -5 42 3000000000 beef CAFE 10 z|\n"
+             "long -70000 80000 -1234567890123 123456789abc -3 200|\n"
+             "size 1234 -17 -99 -5|\n"
+             "float 1.500000 3.14 1.234568e+04 0.0001      2.250|\n"
+             "width    12|34   |00056|    78|abc|%%|\n"
+             "str hello      right left   (null)|\n"
+             "ptr %p|\n"
+             "args 1 2 3 4 5 6 7 8 9 10 11 12 %%d %%d\n", pPointer);
+    CU_ASSERT_STRING_EQUAL(pszOutput, szExpected);
+    free(pszOutput);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test string arguments are copied
+
+The function records a string argument, changes the string before the ring is
+drained and checks that the original string is printed. It also checks that
+long strings are truncated.
+*/
+//------------------------------------------------------------------------------
+void test_tracering_stringCopy(void)
+{
+    char*       pszOutput;
+    char        szString[16];
+    char        szLong[TRACE_RING_STRING_SIZE * 2];
+
+    strcpy(szString, "before");
+    memset(szLong, 'x', sizeof(szLong) - 1);
+    szLong[sizeof(szLong) - 1] = '\0';
+
+    startCapture();
+    trace("%s\n", szString);
+    strcpy(szString, "after");
+    trace("%s|%s|%s\n", szLong, "a", "b");
+    tracering_flush();
+    pszOutput = stopCapture();
+
+    CU_ASSERT_EQUAL(strncmp(pszOutput, "before\n", 7), 0);
+    // the long string fills the string area, the following strings are empty
+    CU_ASSERT_EQUAL(strspn(pszOutput + 7, "x"), TRACE_RING_STRING_SIZE - 1);
+    CU_ASSERT_STRING_EQUAL(pszOutput + 7 + TRACE_RING_STRING_SIZE - 1, "||\n");
+    free(pszOutput);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test messages of several threads
+
+Several threads record messages concurrently and terminate. The test checks
+that all messages are printed and that the messages of each thread keep their
+order.
+*/
+//------------------------------------------------------------------------------
+void test_tracering_threadOrder(void)
+{
+    pthread_t   aThread[TEST_THREAD_COUNT];
+    UINT        aNextMessage[TEST_THREAD_COUNT];
+    char*       pszOutput;
+    char*       pszLine;
+    char*       pszSave = NULL;
+    UINT        threadIndex;
+    UINT        message;
+    UINT        lineCount = 0;
+    BOOL        fOrdered = TRUE;
+    ULONG       dropCount;
+
+    dropCount = tracering_getDropCount();
+    memset(aNextMessage, 0, sizeof(aNextMessage));
+    pthread_barrier_init(&threadBarrier_l, NULL, TEST_THREAD_COUNT);
+
+    startCapture();
+    for (threadIndex = 0; threadIndex < TEST_THREAD_COUNT; threadIndex++)
+    {
+        pthread_create(&aThread[threadIndex], NULL, traceThread, (void*)(size_t)threadIndex);
+    }
+    for (threadIndex = 0; threadIndex < TEST_THREAD_COUNT; threadIndex++)
+    {
+        pthread_join(aThread[threadIndex], NULL);
+    }
+    tracering_flush();
+    pszOutput = stopCapture();
+    pthread_barrier_destroy(&threadBarrier_l);
+
+    for (pszLine = strtok_r(pszOutput, "\n", &pszSave); pszLine != NULL;
+         pszLine = strtok_r(NULL, "\n", &pszSave))
+    {
+        if ((sscanf(pszLine, "thread %u message %u", &threadIndex, &message) != 2) ||
+            (threadIndex >= TEST_THREAD_COUNT) || (message != aNextMessage[threadIndex]))
+        {
+            fOrdered = FALSE;
+            break;
+        }
+        aNextMessage[threadIndex]++;
+        lineCount++;
+    }
+
+    CU_ASSERT_TRUE(fOrdered);
+    CU_ASSERT_EQUAL(lineCount, TEST_THREAD_COUNT * TEST_THREAD_MESSAGES);
+    CU_ASSERT_EQUAL(tracering_getDropCount(), dropCount);
+    free(pszOutput);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test dropping messages if the ring is full
+
+The function records more messages than fit into the ring. It checks that the
+surplus messages are dropped and reported.
+*/
+//------------------------------------------------------------------------------
+void test_tracering_overflow(void)
+{
+    char*       pszOutput;
+    char        szExpected[64];
+    ULONG       dropCount;
+    UINT        i;
+
+    dropCount = tracering_getDropCount();
+
+    startCapture();
+    for (i = 0; i < TRACE_RING_ENTRY_COUNT + 10; i++)
+    {
+        trace("message %u\n", i);
+    }
+    CU_ASSERT_EQUAL(tracering_getDropCount(), dropCount + 10);
+
+    tracering_flush();
+    pszOutput = stopCapture();
+
+    snprintf(szExpected, sizeof(szExpected), "message %u\ntrace: 10 messages dropped\n",
+             TRACE_RING_ENTRY_COUNT - 1);
+    CU_ASSERT_EQUAL(strncmp(pszOutput, "message 0\n", 10), 0);
+    CU_ASSERT_PTR_NOT_NULL(strstr(pszOutput, szExpected));
+
+    // the ring is usable again
+    startCapture();
+    trace("next\n");
+    tracering_flush();
+    free(pszOutput);
+    pszOutput = stopCapture();
+    CU_ASSERT_STRING_EQUAL(pszOutput, "next\n");
+    free(pszOutput);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark recording of trace messages
+
+The function measures the duration of trace() with a typical message of the
+stack and compares it with the duration of formatting the message with
+fprintf() into a file.
+*/
+//------------------------------------------------------------------------------
+void test_tracering_benchmark(void)
+{
+    FILE*       pNull;
+    UINT        round;
+    UINT        i;
+    UINT64      traceTime = 0;
+    UINT64      printTime = 0;
+    UINT64      startTime;
+
+    pNull = fopen("/dev/null", "w");
+    CU_ASSERT_PTR_NOT_NULL(pNull);
+    if (pNull == NULL)
+        return;
+
+    tracering_setOutput(pNull);
+    for (round = 0; round < TEST_BENCH_ROUNDS; round++)
+    {
+        startTime = getTimeNs();
+        for (i = 0; i < TEST_BENCH_BATCH; i++)
+        {
+            trace("%s(): node %u event 0x%X state %s\n", __func__, i, 0x1234, "PreOp1");
+        }
+        traceTime += getTimeNs() - startTime;
+        tracering_flush();
+
+        startTime = getTimeNs();
+        for (i = 0; i < TEST_BENCH_BATCH; i++)
+        {
+            fprintf(pNull, "%s(): node %u event 0x%X state %s\n", __func__, i, 0x1234, "PreOp1");
+            fflush(pNull);
+        }
+        printTime += getTimeNs() - startTime;
+    }
+    tracering_setOutput(stderr);
+    fclose(pNull);
+
+    printf("\n    trace() %.1f ns/call, fprintf() %.1f ns/call\n",
+           (double)traceTime / (TEST_BENCH_ROUNDS * TEST_BENCH_BATCH),
+           (double)printTime / (TEST_BENCH_ROUNDS * TEST_BENCH_BATCH));
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start capturing the trace output
+
+The function redirects the output of the trace ring library into a memory
+stream.
+*/
+//------------------------------------------------------------------------------
+static void startCapture(void)
+{
+    pCapture_l = open_memstream(&pCaptureBuffer_l, &captureSize_l);
+    CU_ASSERT_PTR_NOT_NULL(pCapture_l);
+    tracering_setOutput(pCapture_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stop capturing the trace output
+
+\return The function returns the captured output, it must be freed by the
+        caller.
+*/
+//------------------------------------------------------------------------------
+static char* stopCapture(void)
+{
+    tracering_setOutput(stderr);
+    fclose(pCapture_l);
+    pCapture_l = NULL;
+
+    return pCaptureBuffer_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Thread recording trace messages
+
+The thread waits until all threads are started and records its messages.
+
+\param  pArg_p              Index of the thread.
+
+\return The function returns always NULL.
+*/
+//------------------------------------------------------------------------------
+static void* traceThread(void* pArg_p)
+{
+    UINT        threadIndex = (UINT)(size_t)pArg_p;
+    UINT        message;
+
+    pthread_barrier_wait(&threadBarrier_l);
+    for (message = 0; message < TEST_THREAD_MESSAGES; message++)
+    {
+        trace("thread %u message %u\n", threadIndex, message);
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the current CLOCK_MONOTONIC time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec     curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + curTime.tv_nsec;
+}